@@ -0,0 +1,55 @@
+# Compiles every <name>.json pattern in PATTERN_DIR into OUTPUT, a C++ source
+# holding the cells as constexpr arrays and the table embeddedPatterns()
+# returns (see include/core/PatternLibrary.h). Run at build time:
+#   cmake -DPATTERN_DIR=<dir> -DOUTPUT=<file> -P EmbedPatterns.cmake
+# OUTPUT is only rewritten when it changes, so unchanged patterns rebuild nothing.
+
+file(GLOB pattern_files "${PATTERN_DIR}/*.json")
+list(SORT pattern_files)
+
+set(arrays "")
+set(entries "")
+set(index 0)
+foreach(pattern_file IN LISTS pattern_files)
+    get_filename_component(name "${pattern_file}" NAME_WE)
+    file(READ "${pattern_file}" text)
+    string(JSON cell_count ERROR_VARIABLE json_error LENGTH "${text}" cells)
+    if(json_error)
+        message(FATAL_ERROR "Malformed pattern ${pattern_file}: ${json_error}")
+    endif()
+    if(cell_count EQUAL 0)
+        continue()
+    endif()
+
+    set(cells "")
+    math(EXPR last "${cell_count} - 1")
+    foreach(cell RANGE ${last})
+        string(JSON x GET "${text}" cells ${cell} x)
+        string(JSON y GET "${text}" cells ${cell} y)
+        string(APPEND cells "    {${x}, ${y}},\n")
+    endforeach()
+    string(APPEND arrays "constexpr Position kPattern${index}[] = {\n${cells}};\n\n")
+    string(APPEND entries "    {\"${name}\", kPattern${index}},\n")
+    math(EXPR index "${index} + 1")
+endforeach()
+
+# An empty corpus still links; C++ has no zero-length arrays
+if(index EQUAL 0)
+    set(table "")
+    set(result "{}")
+else()
+    set(table "namespace {\n\n${arrays}constexpr EmbeddedPattern kPatterns[] = {\n${entries}};\n\n} // namespace\n\n")
+    set(result "kPatterns")
+endif()
+
+set(source "// Generated by cmake/EmbedPatterns.cmake from the patterns/ corpus; do not edit
+#include \"core/PatternLibrary.h\"
+
+${table}std::span<const EmbeddedPattern> embeddedPatterns() {
+    return ${result};
+}
+")
+
+file(WRITE "${OUTPUT}.tmp" "${source}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different "${OUTPUT}.tmp" "${OUTPUT}")
+file(REMOVE "${OUTPUT}.tmp")
@@ -0,0 +1,109 @@
+#pragma once
+
+// C interface of the game_of_life_unity shared library, for P/Invoke.
+//
+// Board data is never copied across the boundary. gol_acquire_frame() pins an
+// immutable frame owned by the library and returns pointers into it, which
+// C# can wrap in a NativeArray or ReadOnlySpan as they are; the frame stays
+// valid, and unchanged, until gol_release_frame() however the simulation moves
+// on. Frames are only built when one is acquired after a change, and released
+// frames are reused, so a steady frame loop keeps a fixed set of buffers.
+//
+// Every function may be called from any thread; calls on one simulation are
+// serialized. Flags are ints (0 or 1) rather than bool to keep marshaling
+// trivial. Failing functions return a negative GolResult, or NULL, and
+// gol_get_last_error() explains why.
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(GOL_API_EXPORTS)
+#define GOL_API __declspec(dllexport)
+#else
+#define GOL_API __declspec(dllimport)
+#endif
+#else
+#define GOL_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GOL_API_VERSION 1
+
+typedef enum GolResult {
+    GOL_OK = 0,
+    GOL_ERROR_INVALID_ARGUMENT = -1,
+    GOL_ERROR_INTERNAL = -2,
+    GOL_ERROR_MEMORY_LIMIT = -3 // The board is over performance.memory_limit_mb; reset or clear cells
+} GolResult;
+
+typedef struct GolSimulation GolSimulation;
+
+// Same layout as Unity's int2 and Vector2Int
+typedef struct GolCell {
+    int32_t x;
+    int32_t y;
+} GolCell;
+
+typedef struct GolFrame {
+    // Every step or edit bumps the version; equal versions mean identical frames
+    uint64_t version;
+    uint64_t generation;
+
+    // Live cells in increasing x, then y
+    const GolCell* cells;
+    uint32_t cellCount;
+
+    // Cells alive here but not in the frame of version deltaBase, and the
+    // reverse. A client holding that frame applies these instead of reading
+    // cells; deltaBase is 0 for the first frame.
+    uint64_t deltaBase;
+    const GolCell* born;
+    uint32_t bornCount;
+    const GolCell* died;
+    uint32_t diedCount;
+
+    // With gol_set_bitmap_enabled: one bit per grid cell, rows of
+    // bitmapWordsPerRow 64-bit words. Cell (x, y) is bit x % 64 of word
+    // y * bitmapWordsPerRow + x / 64. NULL otherwise.
+    const uint64_t* bitmap;
+    uint32_t bitmapWordsPerRow;
+    int32_t gridWidth;
+    int32_t gridHeight;
+} GolFrame;
+
+GOL_API uint32_t gol_get_api_version(void);
+
+// Message of the last failure on the calling thread; valid until its next failure
+GOL_API const char* gol_get_last_error(void);
+
+// Settings as in config/default.json; NULL or "" for the defaults. Returns
+// NULL if the JSON or the settings are invalid.
+GOL_API GolSimulation* gol_create(const char* configJson);
+
+// Frames still pinned become invalid
+GOL_API void gol_destroy(GolSimulation* simulation);
+
+// Refused with GOL_ERROR_MEMORY_LIMIT while the board is over its memory limit
+GOL_API GolResult gol_step(GolSimulation* simulation, uint32_t steps);
+GOL_API GolResult gol_reset(GolSimulation* simulation); // Empty board at generation 0
+
+// Sets count cells alive (alive = 1) or dead (alive = 0) in one call
+GOL_API GolResult gol_set_cells(GolSimulation* simulation, const GolCell* cells, uint32_t count, int alive);
+GOL_API int gol_is_cell_alive(GolSimulation* simulation, int32_t x, int32_t y);
+
+GOL_API uint64_t gol_get_generation(GolSimulation* simulation);
+GOL_API uint64_t gol_get_cell_count(GolSimulation* simulation);
+
+// Adds the grid bitmap to frames built from now on (off by default)
+GOL_API GolResult gol_set_bitmap_enabled(GolSimulation* simulation, int enabled);
+
+// Pins the current frame. Each acquire needs its own release.
+GOL_API const GolFrame* gol_acquire_frame(GolSimulation* simulation);
+GOL_API void gol_release_frame(GolSimulation* simulation, const GolFrame* frame);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,6 +8,7 @@
 enum class InputEvent {
     StartPause,
     Step,
+    StepBack,
     Reset,
     Quit,
     MoveUp,
@@ -12,13 +12,20 @@ struct RenderConfig {
     bool showBorder{true};
     bool showStats{true};
     bool showControls{true};
-    bool clearScreen{true};
+    bool clearScreen{true}; // Clear the terminal before each full redraw
     std::int32_t viewportX{0};
     std::int32_t viewportY{0};
     std::int32_t viewportWidth{80};
     std::int32_t viewportHeight{24};
+    // Each character covers 2^scaleLog2 cells a side. Above 0 the grid is an
+    // overview shaded by block density from the controller's population
+    // pyramid, at one lookup per character whatever the scale.
+    std::uint32_t scaleLog2{0};
 };
 
+// Frames are composed off-screen, one string per terminal line. Only lines
+// that differ from what is on screen are written, with cursor positioning,
+// in a single write per frame.
 class ConsoleRenderer {
 public:
     explicit ConsoleRenderer(const RenderConfig& config = RenderConfig{});
@@ -27,7 +34,7 @@ public:
     void render(const SimulationController& controller);
     void renderFrame(const SimulationController& controller, 
                     std::int32_t startX, std::int32_t startY,
-                    std::int32_t width, std::int32_t height);
+                    std::int32_t width, std::int32_t height); // Grid only
     
     // Configuration
     void setRenderConfig(const RenderConfig& config) { config_ = config; }
@@ -36,21 +43,40 @@ public:
     // Viewport control
     void setViewport(std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height);
     void centerViewport(std::int32_t centerX, std::int32_t centerY);
-    void moveViewport(std::int32_t deltaX, std::int32_t deltaY);
+    void moveViewport(std::int32_t deltaX, std::int32_t deltaY); // By characters, so by blocks when zoomed out
+    void zoomIn();  // Halves the cells per character, keeping the center
+    void zoomOut(); // Doubles them, up to PopulationPyramid::kMaxScaleLog2
     
     // Utility methods
-    void clearScreen();
+    void clearScreen(); // Also forgets the shown frame, so the next frame is drawn in full
     void moveCursor(std::int32_t x, std::int32_t y);
     std::pair<std::int32_t, std::int32_t> getTerminalSize();
 
 private:
     RenderConfig config_;
     
-    // Rendering helpers
+    // Frame composition: lines of the frame being built and of the frame on screen
+    std::vector<std::string> frame_;
+    std::vector<std::string> shownFrame_;
+    std::size_t frameLines_{0};
+    std::size_t shownLines_{0};
+    std::vector<Position> viewportCells_; // Bulk query result, reused across frames
+    std::string output_;                  // Bytes of one frame's single write
+    
+    // Rendering helpers - each appends lines to the frame being composed
     void renderGrid(const SimulationController& controller);
+    void rasterize(const SimulationController& controller,
+                   std::int32_t startX, std::int32_t startY,
+                   std::int32_t width, std::int32_t height);
     void renderStats(const SimulationStats& stats);
     void renderControls();
-    void renderBorder(std::int32_t width, std::int32_t height);
+    void renderBorder(std::int32_t width);
+    void setScale(std::uint32_t scaleLog2);
+    void shadeOverview(const PopulationPyramid& population, std::int32_t startX, std::int32_t startY,
+                       std::size_t firstRow, std::size_t margin,
+                       std::int32_t width, std::int32_t height);
+    std::string& nextLine();
+    void presentFrame();
     
     // String formatting helpers
     std::string formatStats(const SimulationStats& stats);
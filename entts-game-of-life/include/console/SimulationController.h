@@ -1,9 +1,15 @@
 #pragma once
 
-#include "core/GameOfLifeSimulation.h"
+#include "core/LifeEngine.h"
 #include "core/GameConfig.h"
+#include "core/CheckpointWriter.h"
+#include "core/CycleDetector.h"
+#include "core/HistoryJournal.h"
+#include "core/Metrics.h"
+#include "core/PopulationPyramid.h"
 #include <chrono>
 #include <memory>
+#include <span>
 #include <vector>
 #include <functional>
 
@@ -19,7 +25,28 @@ struct SimulationStats {
     std::size_t livingCells{0};
     double actualFps{0.0};
     std::chrono::milliseconds lastStepTime{0};
-    bool isStable{false};
+    bool isStable{false};             // Reached an exact cycle: still life, oscillator or spaceship
+    std::uint64_t cyclePeriod{0};     // Period of that cycle, 0 until one is found
+    std::int32_t cycleDx{0};          // Displacement per period, for spaceships
+    std::int32_t cycleDy{0};
+    std::size_t memoryBytes{0};       // LifeEngine::getMemoryUsage()
+    bool memoryLimitReached{false};   // Steps are refused until the board shrinks or the limit rises
+    std::uint64_t frameGenerations{0}; // Generations the last stepFrame() advanced
+};
+
+// Cells born and died in one step, for views that redraw only what changed
+struct CellChanges {
+    std::uint64_t generation{0}; // Generation the changes lead to
+    std::vector<std::pair<std::int32_t, std::int32_t>> born;
+    std::vector<std::pair<std::int32_t, std::int32_t>> died;
+};
+
+// Outcome of a batch headless run
+struct HeadlessRunResult {
+    std::uint64_t generations{0};          // Generations actually stepped
+    std::chrono::nanoseconds elapsed{0};
+    double generationsPerSecond{0.0};
+    bool stoppedEarly{false};              // Died out, settled or hit the memory limit before the requested count
 };
 
 class SimulationController {
@@ -30,7 +57,16 @@ public:
     void start();
     void pause();
     void stop();
-    void step();
+    void step(); // Refused, and a running simulation paused, while over the memory limit
+    // Advances several generations in one call, which lets tiled storage keep
+    // each tile in cache across them. The last changes span all of them.
+    void step(std::uint64_t generations);
+    // One running frame: batches of the config's generations per frame, each
+    // one step(generations), repeated while the last batch would still fit
+    // in the frame step budget. Stops early when a step pauses the
+    // simulation. The last changes cover the last batch. Returns the
+    // generations advanced.
+    std::uint64_t stepFrame();
     void reset();
     
     // State queries
@@ -38,19 +74,84 @@ public:
     const SimulationStats& getStats() const { return stats_; }
     const GameConfig& getConfig() const { return simulation_->getConfig(); }
     
-    // Configuration
+    // Configuration. Pattern files may be JSON, RLE (.rle) or macrocell (.mc),
+    // chosen by extension.
     void setConfig(const GameConfig& config);
     void loadPattern(const std::string& patternFile);
     void setDefaultPattern(const std::string& patternFile);
     
+    // Engine hot-swap. switchEngine() builds the engine the config selects;
+    // setEngine() installs any LifeEngine, taking the config from it. The
+    // living cells and generation carry over (cells outside the new grid are
+    // dropped), and the state, timing and default pattern are kept.
+    void switchEngine(const GameConfig& config);
+    void setEngine(std::unique_ptr<LifeEngine> engine);
+    
+    // With adaptive storage configured, steps first move the board between
+    // sparse and dense storage when its density crosses the thresholds (see
+    // GameConfig::setAdaptiveStorage). getConfig() reports the engine in use.
+    
+    // Binary board snapshots (see core/SnapshotFile.h). Loading takes the grid
+    // size, wrap mode and generation from the file, keeps this controller's
+    // storage engine, and makes the loaded cells the default pattern that
+    // reset() restores. A grid saved with a non-zero origin is shifted so its
+    // corner lands on (0, 0).
+    void saveSnapshot(const std::string& path) const;
+    void loadSnapshot(const std::string& path);
+    
+    // Background checkpoints (see core/CheckpointWriter.h): the board is
+    // copied as it stands and written to a snapshot file on the writer
+    // thread, synced and renamed into place, while stepping carries on.
+    // With a checkpoint interval configured, steps and headless batches
+    // checkpoint to the config's path on every multiple of it they cross.
+    void checkpoint(const std::string& path);
+    void waitForCheckpoints(); // Blocks until every checkpoint asked for is written or failed
+    CheckpointStats getCheckpointStats() const { return checkpointWriter_.getStats(); }
+    
+    // Step history (see core/HistoryJournal.h), kept within the config's
+    // history budget. stepBack() and seek() move the board between journaled
+    // steps by toggling the cells that changed, pausing a running simulation;
+    // the next step from a rewound board drops the history after it. seek()
+    // past the newest step steps forward the rest, lands on the earlier step
+    // for a generation inside a multi-generation step, and stops at the
+    // oldest step kept. Headless batches are not journaled; the history
+    // restarts at their last generation, as it does on reset and load.
+    bool stepBack(); // False with nothing older kept
+    std::uint64_t seek(std::uint64_t generation); // Returns the generation reached
+    const HistoryJournal& getHistory() const { return history_; }
+    
     // Headless operation (for testing and Unity integration)
     void runHeadless(std::uint64_t maxGenerations = 1000);
+    
+    // Steps back-to-back with no frame timing, for offline sweeps. Stats,
+    // step changes and the step callback are refreshed every sampleInterval
+    // generations and after the last one. Stops early once the grid dies out
+    // or stops changing, or when it is stable and auto-pause is configured.
+    // The controller state is left alone and the grid keeps its final generation.
+    HeadlessRunResult runHeadlessBatch(std::uint64_t generations, std::uint64_t sampleInterval = 1000);
     void setStepCallback(std::function<void(const SimulationStats&)> callback);
     
     // Cell queries (for view layer)
     bool isCellAlive(std::int32_t x, std::int32_t y) const;
     std::size_t getLivingCellCount() const;
     std::vector<std::pair<std::int32_t, std::int32_t>> getLivingCells() const;
+    const CellChanges& getLastStepChanges() const { return lastChanges_; } // Reused across steps
+    
+    // Living cells inside the inclusive bounds, in one bulk query. Replaces the
+    // contents of out, reusing its capacity.
+    void getLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY, std::int32_t maxY,
+                                std::vector<Position>& out) const;
+    
+    // Live counts of power-of-two blocks, for zoomed-out views (see
+    // core/PopulationPyramid.h). Steps, edits and history moves keep it up to
+    // date from their births and deaths; headless batches rebuild it at the end.
+    const PopulationPyramid& getPopulationPyramid() const { return population_; }
+    
+    // Step, render and query latencies, births and deaths, for export with
+    // writePrometheusMetrics() or metricsToJson(); safe to read from another
+    // thread. The controller times steps and queries; the view reports frames.
+    const SimulationMetrics& getMetrics() const { return metrics_; }
+    void recordRenderTime(std::chrono::nanoseconds duration) { metrics_.renderNanos.record(duration); }
     
     // Cell manipulation (for testing and initial setup)
     void setCellAlive(std::int32_t x, std::int32_t y);
@@ -61,9 +162,11 @@ public:
     void updateTiming();
 
 private:
-    std::unique_ptr<GameOfLifeSimulation> simulation_;
+    std::unique_ptr<LifeEngine> simulation_;
     SimulationState state_{SimulationState::Stopped};
     SimulationStats stats_;
+    CellChanges lastChanges_;
+    mutable SimulationMetrics metrics_; // Const queries record their latency
     
     // Timing management
     std::chrono::steady_clock::time_point lastUpdate_;
@@ -71,18 +174,33 @@ private:
     std::chrono::steady_clock::time_point lastFpsCalculation_;
     std::uint64_t frameCount_{0};
     
-    // Stability detection
-    std::vector<std::size_t> populationHistory_;
-    std::size_t stableDetectionWindow_{10};
+    // Stability detection. Steps feed their births and deaths to the detector;
+    // edits mark it stale and it is rebuilt from the living cells before the next step.
+    CycleDetector cycleDetector_;
+    bool cycleDetectorStale_{true};
+    
+    HistoryJournal history_;
+    PopulationPyramid population_;
+    
+    CheckpointWriter checkpointWriter_;
+    std::uint64_t lastCheckpointGeneration_{0};
     
     // Callbacks
     std::function<void(const SimulationStats&)> stepCallback_;
     
     // Pattern management
-    std::vector<std::pair<std::int32_t, std::int32_t>> defaultPattern_;
+    std::vector<Position> defaultPattern_;
     
     // Helper methods
+    bool adaptStorage(); // Returns true if the board moved to another engine
     void updateStats();
+    void updateChanges();
+    void rebuildCycleDetector();
+    void restartHistory();
+    void rebuildPopulation();
+    void recordHistory(std::span<const Position> born, std::span<const Position> died);
+    void applyHistoryMove(const HistoryMove& move);
+    void checkpointIfDue();
     void checkStability();
     void calculateFps();
 };
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "GameConfig.h"
+#include "components/Position.h"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+// Standard workloads for comparing storage engines, and the flecs build
+// against this one. Both builds define the same workloads the same way: the
+// shared patterns/*.json corpus and seeded random soups, on boards whose
+// cells run from (0, 0) to (width - 1, height - 1) without wrapping.
+
+struct BenchmarkWorkload {
+    std::string name;
+    std::int32_t width = 0;
+    std::int32_t height = 0;
+    std::vector<Position> cells;
+    std::uint64_t generations = 0;
+};
+
+struct BenchmarkResult {
+    std::string engine;
+    std::string workload;
+    std::uint64_t generations = 0;
+    std::uint64_t medianNanosPerStep = 0; // Over the repetitions
+    std::uint64_t minNanosPerStep = 0;
+    std::size_t finalCells = 0;
+    std::size_t memoryBytes = 0; // Engine-reported, after the last step
+};
+
+struct BenchmarkRegression {
+    std::string key; // "<engine>/<workload>"
+    std::uint64_t baselineNanosPerStep = 0;
+    std::uint64_t currentNanosPerStep = 0;
+};
+
+// Each cell alive with probability density, drawn row by row from
+// std::mt19937(seed) as rng() < density * 2^32 so every standard library
+// produces the same soup
+std::vector<Position> makeSoup(std::int32_t width, std::int32_t height, double density, std::uint32_t seed);
+
+// Every pattern in patternDirectory (sorted by name) centred on a 256x256
+// board, then soups of density 0.1, 0.25 and 0.5 on 64, 256 and 1024 square
+// boards. quick drops the 1024 boards.
+std::vector<BenchmarkWorkload> makeStandardWorkloads(const std::string& patternDirectory, bool quick = false);
+
+// Steps a fresh engine through the workload repetitions times; loading the
+// cells is not timed
+BenchmarkResult runBenchmark(const GameConfig& baseConfig, StorageEngine engine, const BenchmarkWorkload& workload,
+                             std::uint32_t repetitions);
+
+// {"timestamp", "baseline_type": "benchmark", "validator", "benchmarks":
+// {"<engine>/<workload>": {...}}}, in the shape of the meta/memory baselines
+nlohmann::json benchmarkResultsToJson(std::span<const BenchmarkResult> results, const std::string& validator);
+
+// Benchmarks whose median step time in current is more than tolerance
+// (0.1 = 10%) above baseline. Keys missing from either side are skipped.
+std::vector<BenchmarkRegression> findRegressions(const nlohmann::json& baseline, const nlohmann::json& current,
+                                                 double tolerance);
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "components/Position.h"
+#include "DenseKernels.h"
+#include "LifeRule.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// How a board of an ensemble ended
+enum class BoardOutcome {
+    DiedOut,         // No living cell left
+    StillLife,       // A generation equal to the one before it
+    Oscillator,      // A generation equal to the one two before it
+    GenerationLimit, // Still changing when the limit was reached
+    Retired          // Ended early by retireBoard()
+};
+
+// Final state of one board, collected once it has ended
+struct BoardResult {
+    std::uint64_t id{0};
+    BoardOutcome outcome{BoardOutcome::Retired};
+    std::uint32_t generations{0}; // Generations stepped before it ended
+    std::size_t initialCells{0};
+    std::size_t finalCells{0};
+    std::vector<Position> cells; // Final living cells, when the ensemble records them
+};
+
+// Many independent small boards of one size, stepped together for soup
+// statistics. Each board row is a single 64-bit word, and the words of all
+// boards for one row sit side by side, so the dense row kernel steps a row
+// of every board per call, several boards per SIMD instruction.
+//
+// Column x of a board is bit x + 1; bits 0 and width + 1 are ghost columns,
+// zero for bounded boards and copies of the opposite edge when wrapping, and
+// rows 0 and height + 1 are ghost rows in the same way. The kernel's carries
+// between neighboring words only ever land in ghost bits, which are rewritten
+// after every generation, so boards never see each other.
+//
+// Boards are checked every generation and end once they die out, settle into
+// a still life or period-2 oscillator, or reach the generation limit. Ended
+// boards give up their lane to the last running one, which keeps the running
+// boards in lanes [0, running) with no gaps to step over.
+class BoardEnsemble {
+public:
+    static constexpr std::int32_t kMaxWidth = 62; // Two ghost columns per 64-bit word
+
+    // Throws std::invalid_argument for a size outside 1..kMaxWidth by at least 1 row
+    BoardEnsemble(std::int32_t width, std::int32_t height, bool wrapEdges, const LifeRule& rule = {});
+
+    // Adds a board holding the given cells, in board coordinates; cells off the
+    // board are ignored. Returns the id its result is reported under.
+    std::uint64_t addBoard(const std::vector<Position>& cells);
+
+    // Adds a board with each cell alive with the given probability, drawn from seed
+    std::uint64_t addRandomBoard(double density, std::uint32_t seed);
+
+    // Ends a running board now, reporting it as Retired; false if it is not running
+    bool retireBoard(std::uint64_t id);
+
+    // Steps every running board, ending those that die out or settle
+    void step(std::uint32_t generations = 1);
+
+    // Boards still changing after this many generations end (0 = no limit)
+    void setGenerationLimit(std::uint32_t generations) { generationLimit_ = generations; }
+    std::uint32_t getGenerationLimit() const { return generationLimit_; }
+
+    // Whether results carry the final living cells of their board (off by default)
+    void setRecordFinalCells(bool record) { recordFinalCells_ = record; }
+    bool getRecordFinalCells() const { return recordFinalCells_; }
+
+    // Results of the boards that ended since the last call, appended to out in
+    // the order they ended
+    void collectResults(std::vector<BoardResult>& out);
+
+    // State queries
+    std::int32_t getWidth() const { return width_; }
+    std::int32_t getHeight() const { return height_; }
+    std::size_t getRunningCount() const { return lanes_.size(); }
+    bool isRunning(std::uint64_t id) const { return findLane(id) != kNoLane; }
+
+    // Living cells of a running board, appended to out
+    void collectBoardCells(std::uint64_t id, std::vector<Position>& out) const;
+
+    // Bytes held by the generation buffers and bookkeeping
+    std::size_t getMemoryUsage() const;
+
+private:
+    struct Lane {
+        std::uint64_t id;
+        std::uint32_t generation;
+        std::size_t initialCells;
+    };
+
+    static constexpr std::size_t kNoLane = static_cast<std::size_t>(-1);
+
+    std::size_t findLane(std::uint64_t id) const;
+    std::size_t addLane(); // Empty in all three generations
+    void reserveLanes(std::size_t lanes);
+
+    // Word of a row and lane in a generation buffer; rows count the ghost rows
+    std::uint64_t& word(std::vector<std::uint64_t>& buffer, std::int32_t row, std::size_t lane) {
+        return buffer[static_cast<std::size_t>(row) * stride_ + lane + 1];
+    }
+    std::uint64_t word(const std::vector<std::uint64_t>& buffer, std::int32_t row, std::size_t lane) const {
+        return buffer[static_cast<std::size_t>(row) * stride_ + lane + 1];
+    }
+
+    void stepGeneration();
+    void fillGhosts(std::vector<std::uint64_t>& buffer);
+    std::size_t countCells(std::size_t lane) const;
+    void appendLaneCells(std::size_t lane, std::vector<Position>& out) const;
+    void endLane(std::size_t lane, BoardOutcome outcome);
+
+    std::int32_t width_;
+    std::int32_t height_;
+    bool wrapEdges_;
+    std::uint64_t cellMask_; // Bits 1..width
+    DenseKernel kernel_;
+    LifeRule rule_;
+    bool conwayRule_;
+
+    // Generations n (current_), n - 1 and n - 2; a step overwrites the oldest.
+    // Each is height + 2 rows of stride_ words: a guard word, one per lane, a guard word.
+    std::vector<std::uint64_t> current_;
+    std::vector<std::uint64_t> previous_;
+    std::vector<std::uint64_t> older_;
+    std::size_t stride_{2};
+
+    std::vector<Lane> lanes_; // Per running board, in lane order
+
+    // Per-lane flags of the generation just stepped: any cell alive, any
+    // difference from the last generation, and from the one before it
+    std::vector<std::uint64_t> alive_;
+    std::vector<std::uint64_t> changed_;
+    std::vector<std::uint64_t> changedTwo_;
+
+    std::vector<BoardResult> results_;
+    std::uint64_t nextId_{0};
+    std::uint32_t generationLimit_{0};
+    bool recordFinalCells_{false};
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "components/Position.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compact set of cell flips: the packed_cells payload of a StreamSimulation
+// update (proto/game_of_life.proto). An update lists the cells whose state
+// differs from the client's previous frame, so the client XORs them into its
+// copy and born and died cells need no flag of their own; a keyframe is the
+// same against an empty board.
+//
+// The plane is cut into 8x8 tiles, and the payload holds one record per tile
+// with a flip, in increasing tile row, then tile column:
+//
+//   zig-zag varint   tile row minus the previous record's (the first counts from 0)
+//   zig-zag varint   tile column minus the previous record's (likewise)
+//   u8               row mask: bit r set if row r of the tile has a flip
+//   u8 per set bit   that row's column mask, lowest row first; bit c is column c
+//
+// Tile coordinates are y >> 3 and x >> 3, so negative cells work too. A lone
+// cell costs about four bytes and a full tile eleven, where a repeated Cell
+// spends around ten bytes on every cell. Varints are unsigned LEB128, as in
+// SnapshotFile.
+
+// Appends the flips to out. The two lists may come in any order; a cell
+// listed twice flips back and is left out.
+void encodeCellFlips(std::span<const Position> born, std::span<const Position> died, std::string& out);
+
+// Flipped cells in tile order. Throws std::runtime_error on a malformed payload.
+std::vector<Position> decodeCellFlips(std::string_view data);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "components/Position.h"
+#include "CoordinateMap.h"
+#include "DenseKernels.h"
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Unbounded plane of bit-packed 64x64 chunks, allocated only where there are
+// living cells. Any 32-bit position is valid; nothing wraps or falls off an
+// edge, so memory follows the active area instead of a bounding box.
+//
+// Chunks are found through a CoordinateMap keyed by chunk coordinate (the
+// cell coordinate shifted right by 6, packed into one 64-bit key). A step
+// visits every chunk plus each missing neighbor its border cells could give
+// birth in, runs the dense kernel over a halo gathered from the up to eight
+// chunks around it, and keeps only the chunks that still hold a living cell:
+// a chunk is freed the generation it becomes empty.
+class ChunkedPlane {
+public:
+    static constexpr std::int32_t kChunkSize = 64;
+
+    explicit ChunkedPlane(const LifeRule& rule = {});
+
+    // Cell access
+    void setCell(std::int32_t x, std::int32_t y, bool alive);
+    bool getCell(std::int32_t x, std::int32_t y) const;
+    std::uint8_t countNeighbors(std::int32_t x, std::int32_t y) const;
+
+    // Simulation
+    bool step(); // Returns true if any cell changed
+    void clear();
+
+    // State queries
+    std::size_t getLivingCellCount() const { return population_; }
+    std::size_t getChunkCount() const { return chunks_.size(); }
+    void collectLivingCells(std::vector<Position>& out) const;
+    std::size_t getMemoryUsage() const; // Bytes held by both generations, their indexes and step scratch
+
+    // Living cells inside the inclusive bounds, appended to out
+    void collectLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY, std::int32_t maxY,
+                                    std::vector<Position>& out) const;
+
+    // Cells born and died in the last step, appended to the output buffers.
+    // Only meaningful right after a step; edits since then are not tracked.
+    void collectChanges(std::vector<Position>& born, std::vector<Position>& died) const;
+
+private:
+    using Rows = std::array<std::uint64_t, kChunkSize>;
+
+    struct Chunk {
+        Position coord; // Chunk coordinate; cell (x, y) lives in chunk (x >> 6, y >> 6)
+        Rows rows;
+    };
+
+    // Chunk coordinates whose cells all have 32-bit coordinates
+    static constexpr std::int32_t kMinChunk = INT32_MIN / kChunkSize;
+    static constexpr std::int32_t kMaxChunk = INT32_MAX / kChunkSize;
+
+    static Position chunkOf(std::int32_t x, std::int32_t y) { return Position(x >> 6, y >> 6); }
+
+    static const Rows* findRows(const std::vector<Chunk>& chunks, const CoordinateMap<std::uint32_t>& index,
+                                Position coord);
+    void addCandidates(const Chunk& chunk);
+    // Appends the chunk's next generation to previous_ if it has living cells; true if it changed
+    bool stepChunk(Position coord, std::size_t& population);
+
+    DenseKernel kernel_;
+    LifeRule rule_;
+    bool conwayRule_; // B3/S23 takes the kernel's dedicated stepRow
+
+    // Current generation, and the previous one once a step has run. A step
+    // writes the next generation over the previous one and swaps the two.
+    std::vector<Chunk> chunks_;
+    CoordinateMap<std::uint32_t> index_; // Chunk coordinate -> slot in chunks_
+    std::vector<Chunk> previous_;
+    CoordinateMap<std::uint32_t> previousIndex_;
+    std::size_t population_{0};
+
+    std::vector<Position> candidates_; // Step scratch: chunk coordinates to step, sorted
+};
@@ -0,0 +1,230 @@
+#pragma once
+
+#include "components/Position.h"
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Flat open-addressing hash map keyed by cell position.
+//
+// Entries live in one power-of-two slot array and are found by linear
+// probing from the mixed 64-bit packed coordinate (see Position::packed()),
+// so a lookup touches one or two cache lines instead of chasing a node list.
+// Erasing shifts the following entries of the probe run back, which keeps
+// lookups tombstone-free. Any insert or erase invalidates iterators.
+template <typename Value>
+class CoordinateMap {
+public:
+    using value_type = std::pair<Position, Value>;
+
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = CoordinateMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+        using MapPtr = std::conditional_t<Const, const CoordinateMap*, CoordinateMap*>;
+
+        Iterator() = default;
+        Iterator(MapPtr map, std::size_t slot) : map_(map), slot_(slot) { skipEmpty(); }
+
+        // Mutable iterators convert to const ones
+        operator Iterator<true>() const requires (!Const) { return Iterator<true>(map_, slot_); }
+
+        reference operator*() const { return map_->slots_[slot_]; }
+        pointer operator->() const { return &map_->slots_[slot_]; }
+
+        Iterator& operator++() {
+            ++slot_;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return slot_ == other.slot_; }
+        bool operator!=(const Iterator& other) const { return slot_ != other.slot_; }
+
+    private:
+        friend class CoordinateMap;
+
+        void skipEmpty() {
+            while (slot_ < map_->used_.size() && map_->used_[slot_] == 0) {
+                ++slot_;
+            }
+        }
+
+        MapPtr map_{nullptr};
+        std::size_t slot_{0};
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    CoordinateMap() = default;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, used_.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, used_.size()); }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::size_t capacity() const { return slots_.size(); }
+    std::size_t getMemoryUsage() const { return slots_.capacity() * sizeof(value_type) + used_.capacity(); }
+
+    iterator find(const Position& pos) {
+        std::size_t slot = findSlot(pos);
+        return slot == kNotFound ? end() : iterator(this, slot);
+    }
+
+    const_iterator find(const Position& pos) const {
+        std::size_t slot = findSlot(pos);
+        return slot == kNotFound ? end() : const_iterator(this, slot);
+    }
+
+    bool contains(const Position& pos) const { return findSlot(pos) != kNotFound; }
+
+    // Inserts a default-constructed value if the position is missing
+    Value& operator[](const Position& pos) {
+        return slots_[insertSlot(pos)].second;
+    }
+
+    // Returns false (and leaves the value alone) if the position is present
+    bool insert(const Position& pos, const Value& value) {
+        std::size_t before = size_;
+        std::size_t slot = insertSlot(pos);
+        if (size_ == before) {
+            return false;
+        }
+        slots_[slot].second = value;
+        return true;
+    }
+
+    std::size_t erase(const Position& pos) {
+        std::size_t slot = findSlot(pos);
+        if (slot == kNotFound) {
+            return 0;
+        }
+        eraseSlot(slot);
+        return 1;
+    }
+
+    void erase(const_iterator it) { eraseSlot(it.slot_); }
+    void erase(iterator it) { eraseSlot(it.slot_); }
+
+    // Keeps the slot array so refilling to a similar size does not rehash
+    void clear() {
+        for (std::size_t slot = 0; slot < slots_.size(); ++slot) {
+            if (used_[slot] != 0) {
+                slots_[slot] = value_type();
+                used_[slot] = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+    // Grows the slot array so that count entries fit without rehashing
+    void reserve(std::size_t count) {
+        std::size_t needed = kMinCapacity;
+        while (needed * kMaxLoadNum < count * kMaxLoadDen) {
+            needed *= 2;
+        }
+        if (needed > slots_.size()) {
+            rehash(needed);
+        }
+    }
+
+private:
+    static constexpr std::size_t kNotFound = ~std::size_t{0};
+    static constexpr std::size_t kMinCapacity = 16;
+
+    // Maximum load factor of 1/2. Most neighbor lookups miss, and a miss
+    // under linear probing scans the whole run, which grows fast past 1/2.
+    static constexpr std::size_t kMaxLoadNum = 1;
+    static constexpr std::size_t kMaxLoadDen = 2;
+
+    std::size_t homeSlot(const Position& pos) const {
+        return static_cast<std::size_t>(mixCoordinateKey(pos.packed())) & (slots_.size() - 1);
+    }
+
+    std::size_t findSlot(const Position& pos) const {
+        if (size_ == 0) {
+            return kNotFound;
+        }
+
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t slot = homeSlot(pos);; slot = (slot + 1) & mask) {
+            if (used_[slot] == 0) {
+                return kNotFound;
+            }
+            if (slots_[slot].first == pos) {
+                return slot;
+            }
+        }
+    }
+
+    std::size_t insertSlot(const Position& pos) {
+        if ((size_ + 1) * kMaxLoadDen > slots_.size() * kMaxLoadNum) {
+            rehash(slots_.empty() ? kMinCapacity : slots_.size() * 2);
+        }
+
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t slot = homeSlot(pos);; slot = (slot + 1) & mask) {
+            if (used_[slot] == 0) {
+                slots_[slot].first = pos;
+                used_[slot] = 1;
+                ++size_;
+                return slot;
+            }
+            if (slots_[slot].first == pos) {
+                return slot;
+            }
+        }
+    }
+
+    void eraseSlot(std::size_t hole) {
+        const std::size_t mask = slots_.size() - 1;
+
+        // Backward-shift deletion: pull later entries of the run into the hole
+        // unless that would move them in front of their home slot
+        for (std::size_t slot = (hole + 1) & mask; used_[slot] != 0; slot = (slot + 1) & mask) {
+            std::size_t home = homeSlot(slots_[slot].first);
+            if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+                slots_[hole] = std::move(slots_[slot]);
+                hole = slot;
+            }
+        }
+
+        slots_[hole] = value_type();
+        used_[hole] = 0;
+        --size_;
+    }
+
+    void rehash(std::size_t capacity) {
+        std::vector<value_type> oldSlots(capacity);
+        std::vector<std::uint8_t> oldUsed(capacity, 0);
+        oldSlots.swap(slots_);
+        oldUsed.swap(used_);
+
+        const std::size_t mask = capacity - 1;
+        for (std::size_t i = 0; i < oldSlots.size(); ++i) {
+            if (oldUsed[i] == 0) {
+                continue;
+            }
+            std::size_t slot = homeSlot(oldSlots[i].first);
+            while (used_[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            slots_[slot] = std::move(oldSlots[i]);
+            used_[slot] = 1;
+        }
+    }
+
+    std::vector<value_type> slots_;
+    std::vector<std::uint8_t> used_; // 1 for occupied slots
+    std::size_t size_{0};
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "GameConfig.h"
+#include "LifeEngine.h"
+#include "components/Position.h"
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Dense board kept resident on a CUDA device, for boards too large for the
+// CPU engines to step at interactive rates (16k x 16k and up). Built only
+// with -DBUILD_CUDA_ENGINE=ON, as the game_of_life_cuda library; it plugs in
+// through SimulationController::setEngine() and defines GOL_CUDA_ENGINE for
+// code that links it. The config's storage engine setting is ignored.
+//
+// The layout matches DenseGrid: one bit per cell, rows packed into 64-bit
+// words. Two generations live on the device and each step is one kernel
+// launch with a thread per word, so step() and advance() never copy the board
+// back; advance() queues its steps without waiting, reading back only the
+// per-generation change flags once per kAdvanceBatch generations.
+//
+// Queries copy back only what they ask for: a region query the words under
+// its rectangle, getBornCells()/getDiedCells() the changed cells compacted on
+// the device (on first use after a step), getLivingCellCount() one counter.
+// Cell edits are queued on the host and applied in one kernel before the
+// next step or query.
+//
+// Throws std::runtime_error when there is no CUDA device or a CUDA call fails.
+class CudaLifeEngine : public LifeEngine {
+public:
+    // Generations queued per change-flag readback in advance()
+    static constexpr std::uint64_t kAdvanceBatch = 256;
+
+    explicit CudaLifeEngine(const GameConfig& config = GameConfig{});
+    ~CudaLifeEngine() override;
+
+    CudaLifeEngine(const CudaLifeEngine&) = delete;
+    CudaLifeEngine& operator=(const CudaLifeEngine&) = delete;
+
+    // Whether a CUDA device is available to construct one on
+    static bool isAvailable();
+
+    // Cell manipulation. Positions wrap on a wrapped grid and are ignored off a bounded one.
+    void setCellAlive(std::int32_t x, std::int32_t y) override;
+    void setCellsAlive(std::span<const Position> cells) override;
+    void setCellDead(std::int32_t x, std::int32_t y) override;
+    bool isCellAlive(std::int32_t x, std::int32_t y) const override;
+
+    // Simulation control
+    bool step() override;
+    void reset() override;
+    std::uint64_t advance(std::uint64_t steps) override;
+
+    // State queries
+    std::size_t getLivingCellCount() const override;
+    std::uint64_t getGenerationCount() const override { return generationCount_; }
+    void setGenerationCount(std::uint64_t generation) override { generationCount_ = generation; }
+    std::vector<Position> getLivingPositions() const override; // Copies the whole board back
+    std::size_t getMemoryUsage() const override;               // Device generations and scratch plus host buffers
+
+    // Bounds are in viewport coordinates, so a wrapped grid shows its wrapped copies
+    void collectLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY, std::int32_t maxY,
+                                    std::vector<Position>& out) const override;
+
+    // Only meaningful right after a step or advance(); edits since then are not tracked
+    const std::vector<Position>& getBornCells() const override;
+    const std::vector<Position>& getDiedCells() const override;
+
+    // Configuration. setConfig() reallocates the board and clears it.
+    const GameConfig& getConfig() const override { return config_; }
+    void setConfig(const GameConfig& config) override;
+
+private:
+    struct CellEdit {
+        std::int32_t x;
+        std::int32_t y;
+        std::uint32_t alive;
+    };
+
+    void allocate();
+    void release();
+    void flushEdits() const;
+    void queueEdit(std::int32_t x, std::int32_t y, bool alive);
+    bool normalize(std::int32_t& x, std::int32_t& y) const;
+    void launchSteps(std::uint64_t steps);
+    void copyRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY, std::int32_t maxY, std::int64_t offsetX,
+                    std::int64_t offsetY, std::vector<Position>& out) const;
+    void collectChanges() const;
+
+    GameConfig config_;
+    std::size_t wordsPerRow_{0};
+    std::uint64_t generationCount_{0};
+
+    // Device buffers; current_ and previous_ swap every generation
+    std::uint64_t* current_{nullptr};
+    std::uint64_t* previous_{nullptr};
+    std::uint32_t* changeFlags_{nullptr}; // One per generation of a launch batch
+    std::uint64_t* counter_{nullptr};     // Population and compaction counters
+    mutable Position* changeCells_{nullptr};
+    mutable std::size_t changeCapacity_{0};
+    mutable CellEdit* deviceEdits_{nullptr};
+    mutable std::size_t deviceEditCapacity_{0};
+
+    // Host side: queued edits, cached answers and copy-back buffers
+    mutable std::vector<CellEdit> edits_;
+    mutable std::size_t population_{0};
+    mutable bool populationStale_{false};
+    bool lastStepChanged_{false};
+    mutable bool changesStale_{false}; // previous_ holds the generation before current_, not yet compared
+    mutable std::vector<Position> bornCells_;
+    mutable std::vector<Position> diedCells_;
+    mutable std::vector<std::uint64_t> hostWords_;
+    std::vector<std::uint32_t> hostFlags_;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "components/Position.h"
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+
+// Exact cycle detection from an incrementally maintained hash of the live set.
+//
+// Each live cell adds A^x * B^y (mod 2^64) to the set hash, so a birth or
+// death updates it in O(1), and moving the whole set by (dx, dy) multiplies
+// the hash by A^dx * B^dy. Dividing out the powers of the floored centroid
+// leaves a shape hash that is the same wherever the pattern sits, and a table
+// from shape hash to the latest generation it was seen finds still lifes,
+// oscillators and spaceships in O(1) per generation. Matches are exact up to
+// 64-bit hash collisions.
+class CycleDetector {
+public:
+    static constexpr std::uint64_t kDefaultMaxPeriod = 1024;
+
+    struct Cycle {
+        std::uint64_t period{0};          // 1 for a still life
+        std::int32_t dx{0};               // Displacement per period; non-zero for spaceships
+        std::int32_t dy{0};
+        std::uint64_t startGeneration{0}; // Earlier generation the current state repeats
+    };
+
+    explicit CycleDetector(std::uint64_t maxPeriod = kDefaultMaxPeriod);
+
+    // Live set updates, from births and deaths or a full rebuild
+    void add(const Position& pos);
+    void remove(const Position& pos);
+
+    // Forgets the live set and the recorded generations
+    void clear();
+
+    // Records the live set as the state of a generation. Returns the cycle if
+    // the same shape was recorded within the last maxPeriod generations.
+    std::optional<Cycle> record(std::uint64_t generation);
+
+    std::size_t size() const { return static_cast<std::size_t>(count_); }
+    std::uint64_t getMaxPeriod() const { return maxPeriod_; }
+
+private:
+    struct Sighting {
+        std::uint64_t generation;
+        std::int64_t centroidX;
+        std::int64_t centroidY;
+        std::uint64_t count;
+    };
+
+    static std::uint64_t cellHash(const Position& pos);
+
+    std::uint64_t maxPeriod_;
+    std::uint64_t hash_{0};
+    std::int64_t sumX_{0};
+    std::int64_t sumY_{0};
+    std::uint64_t count_{0};
+
+    std::unordered_map<std::uint64_t, Sighting> sightings_;             // Shape hash -> latest sighting
+    std::deque<std::pair<std::uint64_t, std::uint64_t>> history_;       // (shape hash, generation), oldest first
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "components/Position.h"
+#include "DenseKernels.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Bit-packed cell storage: one bit per grid cell, rows packed into 64-bit words.
+// Coordinates passed in must already be inside the grid (see normalizePosition()).
+//
+// Each row has a zero guard word on both sides and the grid has a guard row
+// above and below, so the row kernel never branches on edges. Wrapped grids
+// copy the opposite rows into the guard rows before each step and recompute
+// the first and last column afterwards.
+class DenseGrid {
+public:
+    DenseGrid(std::int32_t width, std::int32_t height, bool wrapEdges, const LifeRule& rule = {});
+
+    // Cell access
+    void setCell(std::int32_t x, std::int32_t y, bool alive);
+    bool getCell(std::int32_t x, std::int32_t y) const;
+
+    // Counts neighbors of any position, with the same wrap/bounds rules as the sparse engine
+    std::uint8_t countNeighbors(std::int32_t x, std::int32_t y) const;
+
+    // Simulation
+    bool step(); // Returns true if any cell changed
+    void clear();
+
+    // Kernel selection (defaults to the best kernel for the running CPU)
+    void setKernel(const DenseKernel& kernel) { kernel_ = kernel; }
+    const char* getKernelName() const { return kernel_.name; }
+
+    // State queries
+    std::size_t getLivingCellCount() const { return population_; }
+    void collectLivingCells(std::vector<Position>& out) const;
+    std::size_t getMemoryUsage() const; // Bytes held by both generations
+
+    // Cells born and died in the last step, appended to the output buffers.
+    // Only meaningful right after a step; edits since then are not tracked.
+    void collectChanges(std::vector<Position>& born, std::vector<Position>& died) const;
+
+    // Layout queries
+    std::int32_t getWidth() const { return width_; }
+    std::int32_t getHeight() const { return height_; }
+    std::size_t getWordsPerRow() const { return wordsPerRow_; }
+    const std::uint64_t* rowData(std::int32_t y) const { return rowPtr(cells_, y); }
+
+private:
+    // Row pointers skip the guard row and leading guard word; rows -1 and
+    // height_ address the guard rows
+    const std::uint64_t* rowPtr(const std::vector<std::uint64_t>& buffer, std::int32_t y) const {
+        return buffer.data() + static_cast<std::size_t>(y + 1) * stride_ + 1;
+    }
+    std::uint64_t* rowPtr(std::vector<std::uint64_t>& buffer, std::int32_t y) const {
+        return buffer.data() + static_cast<std::size_t>(y + 1) * stride_ + 1;
+    }
+
+    void patchWrappedColumn(std::int32_t x);
+    void recountPopulation();
+
+    std::int32_t width_;
+    std::int32_t height_;
+    bool wrapEdges_;
+    std::size_t wordsPerRow_;
+    std::size_t stride_;          // wordsPerRow_ plus two guard words
+    std::uint64_t lastWordMask_;  // Valid bits of the last word in each row
+    DenseKernel kernel_;
+    LifeRule rule_;
+    bool conwayRule_; // B3/S23 takes the kernel's dedicated stepRow
+
+    // Current and next generation, bit (x & 63) of word (x >> 6) in each row
+    std::vector<std::uint64_t> cells_;
+    std::vector<std::uint64_t> next_;
+    std::size_t population_{0};
+};
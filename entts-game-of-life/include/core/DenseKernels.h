@@ -0,0 +1,35 @@
+#pragma once
+
+#include "LifeRule.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Word-parallel row kernel for bit-packed grids.
+//
+// Computes the next generation of `words` 64-bit words of one row from the
+// row itself and the rows above and below. Each input pointer must be
+// readable at index -1 and index `words` (guard words), which supply the
+// neighbor bits that cross the first and last word of the row.
+using DenseRowKernelFn = void (*)(const std::uint64_t* above, const std::uint64_t* row, const std::uint64_t* below,
+                                  std::uint64_t* out, std::size_t words);
+
+// The same for any B/S rule; the common rules have their own instantiations
+using DenseRuleRowKernelFn = void (*)(const std::uint64_t* above, const std::uint64_t* row,
+                                      const std::uint64_t* below, std::uint64_t* out, std::size_t words,
+                                      const LifeRule& rule);
+
+struct DenseKernel {
+    const char* name;
+    DenseRowKernelFn stepRow; // B3/S23
+    DenseRuleRowKernelFn stepRowRule;
+};
+
+// Best kernel supported by the running CPU (detected once)
+const DenseKernel& selectDenseKernel();
+
+// All kernels compiled in and supported by the running CPU, scalar first
+std::vector<DenseKernel> availableDenseKernels();
+
+// Lookup by name ("scalar", "sse2", "avx2", "neon"); nullptr if unavailable
+const DenseKernel* findDenseKernel(const char* name);
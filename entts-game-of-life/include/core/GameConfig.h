@@ -1,9 +1,25 @@
 #pragma once
 
+#include "LifeRule.h"
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <string>
 #include <cstdint>
 
+// Cell storage used by GameOfLifeSimulation
+enum class StorageEngine {
+    Sparse, // One entity per living cell (default)
+    Dense,  // One bit per grid cell, rows packed into 64-bit words
+    HashLife, // Memoized quadtree on an unbounded plane; grid size and wrap_edges are ignored
+    Tiled,  // Bit-packed 64x64 tiles stepped in parallel on worker_threads threads
+    Packed, // Sorted array of packed coordinates; entities exist only when asked for
+    Chunked // 64x64 bit chunks allocated where cells live, on an unbounded plane; grid size and wrap_edges are ignored
+};
+
+// Names used for storage_engine in config files: "sparse", "dense", "hashlife", "tiled", "packed", "chunked"
+const char* storageEngineName(StorageEngine engine);
+std::optional<StorageEngine> storageEngineFromName(const std::string& name);
+
 class GameConfig {
 public:
     GameConfig();
@@ -28,16 +44,78 @@ public:
     void setStableDetectionCycles(std::int32_t cycles) { stableDetectionCycles_ = cycles; }
     void setStepDelayMs(std::int32_t delay) { stepDelayMs_ = delay; }
     
+    // Periodic checkpoints: the console controller writes a snapshot file to
+    // the checkpoint path every this many generations, on a background
+    // thread (see core/CheckpointWriter.h). 0 = none.
+    const std::string& getCheckpointPath() const { return checkpointPath_; }
+    std::int32_t getCheckpointInterval() const { return checkpointInterval_; }
+    
+    void setCheckpointPath(const std::string& path) { checkpointPath_ = path; }
+    void setCheckpointInterval(std::int32_t generations) { checkpointInterval_ = generations; }
+    
+    // Generations a running frame advances, in one multi-generation step so
+    // tiled and HashLife storage take them together. With a frame step
+    // budget, a frame repeats such batches while they fit in it, so the
+    // frame rate holds while throughput rises. 0 ms = one batch per frame.
+    std::int32_t getGenerationsPerFrame() const { return generationsPerFrame_; }
+    std::int32_t getFrameStepBudgetMs() const { return frameStepBudgetMs_; }
+    
+    void setGenerationsPerFrame(std::int32_t generations) { generationsPerFrame_ = generations; }
+    void setFrameStepBudgetMs(std::int32_t budgetMs) { frameStepBudgetMs_ = budgetMs; }
+    
+    // Birth/survival rule, "rule" in config files as a rulestring ("B36/S23")
+    const LifeRule& getRule() const { return rule_; }
+    void setRule(const LifeRule& rule) { rule_ = rule; }
+    
     // Performance settings
     std::int32_t getTargetFps() const { return targetFps_; }
     std::int32_t getMemoryLimitMb() const { return memoryLimitMb_; }
     bool getEnableSpatialOptimization() const { return enableSpatialOptimization_; }
     std::int32_t getBatchSize() const { return batchSize_; }
+    StorageEngine getStorageEngine() const { return storageEngine_; }
+    std::int32_t getHashLifeStepLog2() const { return hashLifeStepLog2_; }
+    std::int32_t getWorkerThreads() const { return workerThreads_; }
+    bool getNumaPlacement() const { return numaPlacement_; }
+    bool getPinWorkerThreads() const { return pinWorkerThreads_; }
+    std::int32_t getNumaNodeLimit() const { return numaNodeLimit_; }
+    bool getAdaptiveStorage() const { return adaptiveStorage_; }
+    double getDenseDensityThreshold() const { return denseDensityThreshold_; }
+    double getSparseDensityThreshold() const { return sparseDensityThreshold_; }
+    std::int32_t getCellSortInterval() const { return cellSortInterval_; }
+    std::int32_t getHistoryBudgetMb() const { return historyBudgetMb_; }
     
     void setTargetFps(std::int32_t fps) { targetFps_ = fps; }
     void setMemoryLimitMb(std::int32_t limitMb) { memoryLimitMb_ = limitMb; }
     void setEnableSpatialOptimization(bool enable) { enableSpatialOptimization_ = enable; }
     void setBatchSize(std::int32_t size) { batchSize_ = size; }
+    void setStorageEngine(StorageEngine engine) { storageEngine_ = engine; }
+    void setHashLifeStepLog2(std::int32_t stepLog2) { hashLifeStepLog2_ = stepLog2; } // 2^stepLog2 generations per step
+    void setWorkerThreads(std::int32_t threads) { workerThreads_ = threads; } // 0 = one per hardware thread
+    
+    // Tiled storage on NUMA hosts: with placement on, worker threads are
+    // spread over the nodes, each tile's memory is placed on the node of the
+    // worker that owns it, and idle workers steal from their own node first.
+    // Pinning binds each worker thread to one CPU of its node. A node limit
+    // keeps workers and tiles on the first that many nodes (0 = all).
+    void setNumaPlacement(bool placement) { numaPlacement_ = placement; }
+    void setPinWorkerThreads(bool pin) { pinWorkerThreads_ = pin; }
+    void setNumaNodeLimit(std::int32_t nodes) { numaNodeLimit_ = nodes; }
+    
+    // Adaptive storage: the controller moves a sparse board to dense storage
+    // once living cells cover the dense threshold of the grid, and back below
+    // the sparse threshold. The gap between the two keeps it from flapping.
+    void setAdaptiveStorage(bool adaptive) { adaptiveStorage_ = adaptive; }
+    void setDenseDensityThreshold(double density) { denseDensityThreshold_ = density; }
+    void setSparseDensityThreshold(double density) { sparseDensityThreshold_ = density; }
+    
+    // Sparse storage re-sorts its cell entities into Z-order (Morton) every
+    // this many generations, so iteration walks spatially adjacent cells
+    // through adjacent component memory. 0 = never.
+    void setCellSortInterval(std::int32_t generations) { cellSortInterval_ = generations; }
+    
+    // Bytes the console controller's step history may hold for stepBack()
+    // and seek() (see core/HistoryJournal.h). 0 = no history.
+    void setHistoryBudgetMb(std::int32_t budgetMb) { historyBudgetMb_ = budgetMb; }
     
     // JSON serialization
     nlohmann::json toJson() const;
@@ -61,12 +139,28 @@ private:
     bool autoPauseOnStable_{true};
     std::int32_t stableDetectionCycles_{10};
     std::int32_t stepDelayMs_{100};
+    LifeRule rule_{};
+    std::string checkpointPath_;
+    std::int32_t checkpointInterval_{0};
+    std::int32_t generationsPerFrame_{1};
+    std::int32_t frameStepBudgetMs_{0};
     
     // Performance settings
     std::int32_t targetFps_{60};
     std::int32_t memoryLimitMb_{100};
     bool enableSpatialOptimization_{true};
     std::int32_t batchSize_{1000};
+    StorageEngine storageEngine_{StorageEngine::Sparse};
+    std::int32_t hashLifeStepLog2_{0};
+    std::int32_t workerThreads_{0};
+    bool numaPlacement_{false};
+    bool pinWorkerThreads_{false};
+    std::int32_t numaNodeLimit_{0};
+    bool adaptiveStorage_{false};
+    double denseDensityThreshold_{0.0002};
+    double sparseDensityThreshold_{0.0001};
+    std::int32_t cellSortInterval_{64};
+    std::int32_t historyBudgetMb_{16};
     
     void setDefaults();
 };
\ No newline at end of file
@@ -1,52 +1,149 @@
 #pragma once
 
 #include "GameConfig.h"
+#include "LifeEngine.h"
 #include "components/Position.h"
 #include "components/Cell.h"
+#include "DenseGrid.h"
+#include "TiledGrid.h"
+#include "PackedLiveSet.h"
+#include "HashLifeUniverse.h"
+#include "ChunkedPlane.h"
+#include "CoordinateMap.h"
 #include <entt/entt.hpp>
-#include <unordered_map>
 #include <array>
 #include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
 
-class GameOfLifeSimulation {
+class GameOfLifeSimulation : public LifeEngine {
 public:
     explicit GameOfLifeSimulation(const GameConfig& config = GameConfig{});
     
     // Cell manipulation
-    void setCellAlive(std::int32_t x, std::int32_t y);
-    void setCellDead(std::int32_t x, std::int32_t y);
-    bool isCellAlive(std::int32_t x, std::int32_t y) const;
+    void setCellAlive(std::int32_t x, std::int32_t y) override;
+    
+    // Bulk insertion for pattern loading. Positions that are invalid, already
+    // alive or repeated are skipped; sparse storage creates the rest as one
+    // batch of entities with the spatial index sized once.
+    void setCellsAlive(std::span<const Position> cells) override;
+    void setCellDead(std::int32_t x, std::int32_t y) override;
+    bool isCellAlive(std::int32_t x, std::int32_t y) const override;
     
     // Simulation control
-    bool step(); // Returns true if changes occurred
-    void reset();
+    bool step() override; // Returns true if changes occurred
+    void reset() override;
+    
+    // Tiled storage advances TiledGrid::kBlockGenerations generations per
+    // pass over memory, so a settled board is noticed at the end of a block
+    // rather than the step it settled in; the changes cover the last block.
+    // A board that repeats over a block skips the blocks left, keeping its phase.
+    std::uint64_t advance(std::uint64_t steps) override;
     
     // State queries
-    std::size_t getLivingCellCount() const;
+    std::size_t getLivingCellCount() const override;
     std::uint8_t getNeighborCount(std::int32_t x, std::int32_t y) const;
-    std::uint64_t getGenerationCount() const { return generationCount_; }
+    std::uint64_t getGenerationCount() const override { return generationCount_; }
+    void setGenerationCount(std::uint64_t generation) override { generationCount_ = generation; } // For restoring a saved board
+    std::vector<Position> getLivingPositions() const override;
+    std::size_t getMemoryUsage() const override; // Registry, spatial index, storage engine and step scratch
+    
+    // Living cells inside the inclusive bounds, appended to out. Bounds are in
+    // viewport coordinates, so a wrapped grid shows its wrapped copies.
+    void collectLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY, std::int32_t maxY,
+                                    std::vector<Position>& out) const override;
+    
+    // Cells born and died in the last step; the buffers are reused across steps
+    const std::vector<Position>& getBornCells() const override { return bornCells_; }
+    const std::vector<Position>& getDiedCells() const override { return diedCells_; }
+    std::size_t getLastBirthCount() const { return bornCells_.size(); }
+    std::size_t getLastDeathCount() const { return diedCells_.size(); }
     
-    // Entity access (for testing)
+    // Storage queries - dense, tiled, packed, HashLife and chunked storage keep no per-cell entities
+    bool usesDenseStorage() const { return denseGrid_ != nullptr; }
+    bool usesTiledStorage() const { return tiledGrid_ != nullptr; }
+    bool usesPackedStorage() const { return packedCells_ != nullptr; }
+    bool usesHashLife() const { return hashLife_ != nullptr; }
+    bool usesChunkedStorage() const { return chunkedPlane_ != nullptr; }
+    std::uint64_t getGenerationsPerStep() const { return hashLife_ ? hashLife_->getGenerationsPerStep() : 1; }
+    
+    // Entity access (for testing). Packed storage creates the entity of a
+    // living cell on first request; it stays valid until the board changes.
+    // Dead cells have no entity here, dormant ones included.
     entt::entity getEntityAt(std::int32_t x, std::int32_t y) const;
-    const entt::registry& getRegistry() const { return registry_; }
+    
+    // Sparse entities of cells that died and are waiting to be reused
+    std::size_t getDormantCellCount() const { return dormantCount_; }
+    
+    // A dying sparse cell keeps its entity as dormant (Cell::alive false, still
+    // indexed at its position) for this many generations. A birth at the same
+    // position revives it in place, so oscillators up to this period stop
+    // creating and destroying entities; once expired, a birth elsewhere may
+    // take the entity over, and compaction every this many generations
+    // destroys the expired ones left.
+    static constexpr std::uint32_t kDormantGenerations = 8;
+    
+    const entt::registry& getRegistry() const { return packedCells_ ? materializedRegistry_ : registry_; }
     
     // Configuration
-    const GameConfig& getConfig() const { return config_; }
-    void setConfig(const GameConfig& config);
+    const GameConfig& getConfig() const override { return config_; }
+    void setConfig(const GameConfig& config) override;
 
 private:
+    // Sparse index entry; alive mirrors the entity's Cell so lookups need not touch the registry
+    struct IndexedCell {
+        entt::entity entity{entt::null};
+        std::uint32_t diedAt{0}; // Low bits of the generation a dormant cell died in
+        bool alive{true};
+    };
+    
+    // Dormant cell in order of death; stale once its position is revived or reused
+    struct DormantCell {
+        Position pos;
+        std::uint32_t diedAt;
+    };
+    
     GameConfig config_;
     entt::registry registry_;
-    std::unordered_map<Position, entt::entity> spatialIndex_;
+    CoordinateMap<IndexedCell> spatialIndex_; // Living and dormant sparse cells
+    std::vector<DormantCell> dormantCells_;
+    std::size_t dormantHead_{0}; // Entries before it have been consumed
+    std::size_t dormantCount_{0};
+    std::unique_ptr<DenseGrid> denseGrid_; // Set when the config selects dense storage
+    std::unique_ptr<TiledGrid> tiledGrid_; // Set when the config selects tiled storage
+    std::unique_ptr<PackedLiveSet> packedCells_; // Set when the config selects packed storage
+    std::unique_ptr<HashLifeUniverse> hashLife_; // Set when the config selects HashLife
+    std::unique_ptr<ChunkedPlane> chunkedPlane_; // Set when the config selects chunked storage
     std::uint64_t generationCount_{0};
+    std::vector<Position> bornCells_; // Cleared (capacity kept) at the start of each step
+    std::vector<Position> diedCells_;
+    
+    // Sparse step scratch, reused across steps
+    std::vector<entt::entity> dyingCells_;
+    CoordinateMap<std::uint8_t> neighborCounts_; // Live neighbors of every position next to a living cell
+    
+    // Entities handed out by getEntityAt() for packed storage
+    mutable entt::registry materializedRegistry_;
+    mutable CoordinateMap<entt::entity> materializedIndex_;
     
     // Helper methods
+    void createStorage();
+    void clearMaterializedEntities();
     bool isValidPosition(std::int32_t x, std::int32_t y) const;
+    bool isSparseCellAlive(const Position& pos) const;
+    void reviveCell(IndexedCell& indexed);
+    bool isCurrentDormant(const DormantCell& dormant) const;
+    entt::entity takeExpiredEntity();
     Position normalizePosition(std::int32_t x, std::int32_t y) const;
     std::uint8_t calculateNeighborCount(std::int32_t x, std::int32_t y) const;
-    void updateNeighborCounts();
-    void applyConwayRules();
+    
+    // Sparse step, instantiated per topology (core/Topology.h)
+    template <typename Topology> std::uint8_t countNeighbors(const Topology& topology, Position pos) const;
+    template <typename Topology> void updateNeighborCounts(const Topology& topology);
+    template <typename Topology> void applyRules(const Topology& topology);
     void cleanupDeadCells();
+    void sortCells();
     
     // Neighbor position offsets
     static constexpr std::array<std::pair<std::int32_t, std::int32_t>, 8> neighborOffsets{{
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "components/Position.h"
+#include "LifeRule.h"
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+// HashLife: the plane is a quadtree of canonical (hash-consed) nodes, and the
+// future of every node is memoized, so repeated structure - gun streams,
+// oscillators, escaped gliders - is computed once and reused.
+//
+// The universe is unbounded and centred on (0, 0). Each step() advances
+// 2^stepLog2 generations; with stepLog2 = 0 it behaves like the other engines.
+class HashLifeUniverse {
+public:
+    static constexpr std::uint32_t kMaxStepLog2 = 48;
+
+    // maxNodes bounds the node store; past it the store is rebuilt from the
+    // live pattern and the memoized results are dropped (0 = no limit).
+    // The rule is only read by the memoized 4x4 base case, so it is not
+    // specialized at compile time like the other engines' loops.
+    explicit HashLifeUniverse(std::size_t maxNodes = 0, const LifeRule& rule = {});
+
+    HashLifeUniverse(const HashLifeUniverse&) = delete;
+    HashLifeUniverse& operator=(const HashLifeUniverse&) = delete;
+
+    // Cell access
+    void setCell(std::int64_t x, std::int64_t y, bool alive);
+    bool getCell(std::int64_t x, std::int64_t y) const;
+    std::uint8_t countNeighbors(std::int64_t x, std::int64_t y) const;
+
+    // Step size
+    void setStepLog2(std::uint32_t stepLog2); // Throws std::out_of_range above kMaxStepLog2
+    std::uint32_t getStepLog2() const { return stepLog2_; }
+    std::uint64_t getGenerationsPerStep() const { return std::uint64_t{1} << stepLog2_; }
+
+    // Simulation
+    bool step(); // Advances 2^stepLog2 generations; returns true if any cell changed
+    void advance(std::uint64_t generations); // Any generation count, as a sum of powers of two
+    void clear();
+
+    // State queries
+    std::uint64_t getGeneration() const { return generation_; }
+    std::uint64_t getLivingCellCount() const { return root_->population; }
+    void collectLivingCells(std::vector<Position>& out) const; // Cells outside the int32 range are skipped
+    void collectLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY, std::int32_t maxY,
+                                    std::vector<Position>& out) const; // Inclusive bounds
+
+    // Cells born and died in the last step or advance, appended to the output
+    // buffers; cells outside the int32 range are skipped
+    void collectChanges(std::vector<Position>& born, std::vector<Position>& died) const;
+
+    // Memory queries
+    std::size_t getNodeCount() const { return nodes_.size(); }
+    std::size_t getMemoryUsage() const; // Bytes held by the node store and its hash table
+    static constexpr std::size_t bytesPerNode() { return sizeof(Node) + 4 * sizeof(void*); }
+
+private:
+    struct Node {
+        const Node* nw{nullptr};
+        const Node* ne{nullptr};
+        const Node* sw{nullptr};
+        const Node* se{nullptr};
+        std::uint64_t population{0};
+        std::uint32_t level{0}; // Side length is 2^level; leaves are single cells
+
+        // Centre of this node 2^nextStepLog2 generations ahead
+        mutable const Node* next{nullptr};
+        mutable std::uint32_t nextStepLog2{0};
+    };
+
+    using NodeKey = std::array<const Node*, 4>;
+
+    struct NodeKeyHash {
+        std::size_t operator()(const NodeKey& key) const noexcept {
+            std::size_t hash = 0;
+            for (const Node* child : key) {
+                hash = hash * 0x9E3779B97F4A7C15ull + reinterpret_cast<std::uintptr_t>(child);
+            }
+            return hash ^ (hash >> 29);
+        }
+    };
+
+    // Node construction
+    const Node* makeNode(const Node* nw, const Node* ne, const Node* sw, const Node* se);
+    const Node* emptyNode(std::uint32_t level);
+    const Node* expand(const Node* node);
+    const Node* centre(const Node* node);
+    const Node* setCell(const Node* node, std::int64_t x, std::int64_t y, bool alive);
+
+    // Evolution
+    const Node* nextGeneration(const Node* node);
+    const Node* stepLevel2(const Node* node);
+    bool patternIsCentred() const;
+    void collectGarbage();
+
+    // Queries
+    bool contains(std::int64_t x, std::int64_t y) const;
+    void collectLivingCells(const Node* node, std::int64_t x, std::int64_t y, std::int64_t minX, std::int64_t maxX,
+                            std::int64_t minY, std::int64_t maxY, std::vector<Position>& out) const;
+    void collectChanges(const Node* before, const Node* after, std::int64_t x, std::int64_t y,
+                        std::vector<Position>& born, std::vector<Position>& died) const;
+
+    Node deadLeaf_;
+    Node aliveLeaf_;
+
+    std::deque<Node> nodes_; // Stable addresses for canonical nodes
+    std::unordered_map<NodeKey, const Node*, NodeKeyHash> canonical_;
+    std::vector<const Node*> emptyNodes_; // Indexed by level
+
+    const Node* root_{nullptr};
+
+    // Roots before and after the last step (or advance), at the same level
+    // and both centred on (0, 0), so their difference is the step's changes
+    const Node* changesBefore_{nullptr};
+    const Node* changesAfter_{nullptr};
+    bool advancing_{false}; // Keeps changesBefore_ at the start of an advance
+
+    std::uint32_t stepLog2_{0};
+    std::uint64_t generation_{0};
+    std::size_t maxNodes_;
+    LifeRule rule_;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "GameConfig.h"
+#include "components/Position.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// Simulation interface driven by SimulationController. GameOfLifeSimulation
+// implements it for every StorageEngine; other implementations plug in
+// through SimulationController::setEngine() without a controller of their own.
+class LifeEngine {
+public:
+    virtual ~LifeEngine() = default;
+
+    // Cell manipulation. Positions outside the engine's domain are ignored.
+    virtual void setCellAlive(std::int32_t x, std::int32_t y) = 0;
+    virtual void setCellsAlive(std::span<const Position> cells) = 0;
+    virtual void setCellDead(std::int32_t x, std::int32_t y) = 0;
+    virtual bool isCellAlive(std::int32_t x, std::int32_t y) const = 0;
+
+    // Simulation control
+    virtual bool step() = 0; // Returns true if changes occurred
+    virtual void reset() = 0; // Also gives back memory held past the memory limit
+
+    // Runs up to steps steps, stopping after one that changes nothing.
+    // Returns the steps taken; the changes report the last of them.
+    virtual std::uint64_t advance(std::uint64_t steps) {
+        std::uint64_t taken = 0;
+        while (taken < steps) {
+            ++taken;
+            if (!step()) {
+                break;
+            }
+        }
+        return taken;
+    }
+
+    // State queries
+    virtual std::size_t getLivingCellCount() const = 0;
+    virtual std::uint64_t getGenerationCount() const = 0;
+    virtual void setGenerationCount(std::uint64_t generation) = 0;
+    virtual std::vector<Position> getLivingPositions() const = 0;
+
+    // Bytes held by the board, its indexes and the step scratch buffers,
+    // counted from container capacities; cheap enough to ask every step
+    virtual std::size_t getMemoryUsage() const = 0;
+
+    // Living cells inside the inclusive bounds, appended to out
+    virtual void collectLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY,
+                                            std::int32_t maxY, std::vector<Position>& out) const = 0;
+
+    // Cells born and died in the last step
+    virtual const std::vector<Position>& getBornCells() const = 0;
+    virtual const std::vector<Position>& getDiedCells() const = 0;
+
+    // Configuration
+    virtual const GameConfig& getConfig() const = 0;
+    virtual void setConfig(const GameConfig& config) = 0;
+};
+
+// Builds the engine the configuration selects
+std::unique_ptr<LifeEngine> createLifeEngine(const GameConfig& config);
+
+// For a run of steps that advance() ended early on a settled board: moves
+// the generation on by the steps it skipped, each as long as the ones taken
+// since startGeneration, stopping at the largest generation instead of
+// wrapping. Nothing changes when every step was taken.
+void skipSettledSteps(LifeEngine& engine, std::uint64_t startGeneration, std::uint64_t taken, std::uint64_t steps);
+
+// Whether the engine holds more than its config's memoryLimitMb (0 = no
+// limit). Callers refuse further steps while it does: a board growing without
+// bound then stops at the limit instead of taking the whole process down.
+bool exceedsMemoryLimit(const LifeEngine& engine);
+
+// Thrown by steps refused because the engine is over its memory limit
+class MemoryLimitError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
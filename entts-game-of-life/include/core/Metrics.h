@@ -0,0 +1,119 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+
+// Latency histogram in the style of HdrHistogram. Values below kSubBuckets are
+// counted exactly; above that, each power of two is split into kSubBuckets
+// equal buckets, so a quantile lands within 1/kSubBuckets (about 3%) of the
+// true value however long the tail. Recording is a few relaxed atomic adds
+// and safe from any thread, also while another one reads.
+class LatencyHistogram {
+public:
+    static constexpr std::uint32_t kSubBucketBits = 5;
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+    static constexpr std::size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    void record(std::uint64_t nanos) noexcept;
+    void record(std::chrono::nanoseconds duration) noexcept;
+
+    std::uint64_t getCount() const noexcept { return count_.load(std::memory_order_relaxed); }
+    std::uint64_t getSum() const noexcept { return sum_.load(std::memory_order_relaxed); }
+    std::uint64_t getMax() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+    // Upper bound of the values at or below quantile (0 to 1); 0 when empty
+    std::uint64_t getQuantile(double quantile) const noexcept;
+
+    void reset() noexcept;
+
+private:
+    static std::size_t bucketOf(std::uint64_t value) noexcept;
+    static std::uint64_t bucketUpperBound(std::size_t bucket) noexcept;
+
+    std::array<std::atomic<std::uint64_t>, kBucketCount> counts_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+// What one simulation reports. Every field may be updated and read from any
+// thread, so exporters read them while the simulation runs.
+struct SimulationMetrics {
+    LatencyHistogram stepNanos;   // Per generation
+    LatencyHistogram renderNanos; // Per frame drawn
+    LatencyHistogram queryNanos;  // Per board read by a view or client
+
+    std::atomic<std::uint64_t> births{0};
+    std::atomic<std::uint64_t> deaths{0};
+    std::atomic<std::uint64_t> lockWaits{0}; // Lock acquisitions that found the lock taken
+    std::atomic<std::uint64_t> lockWaitNanos{0};
+
+    std::atomic<std::uint64_t> livingCells{0};
+
+    void recordChanges(std::size_t born, std::size_t died) noexcept {
+        births.fetch_add(born, std::memory_order_relaxed);
+        deaths.fetch_add(died, std::memory_order_relaxed);
+    }
+
+    nlohmann::json toJson() const;
+};
+
+// Locks mutex, counting the wait in metrics when another thread holds it
+std::unique_lock<std::mutex> lockCounted(std::mutex& mutex, SimulationMetrics& metrics);
+
+// Resident set size of this process; 0 where it cannot be read
+std::uint64_t getResidentMemoryBytes();
+
+// Metrics of several simulations, each under its label
+using LabelledMetrics = std::pair<std::string, const SimulationMetrics*>;
+
+// Prometheus text exposition. Simulations are told apart by a simulation
+// label; latencies are summaries in seconds with quantiles 0.5 to 0.999.
+void writePrometheusMetrics(std::ostream& out, std::span<const LabelledMetrics> simulations);
+
+// {"process": {...}, "simulations": {"<label>": SimulationMetrics::toJson()}}
+nlohmann::json metricsToJson(std::span<const LabelledMetrics> simulations);
+
+// Rewrites a file with the output of write every interval, and once more on
+// destruction. Each write goes to a temporary file renamed over the old one,
+// so readers such as the node_exporter textfile collector never see a partial
+// file. Failures are reported on std::cerr and retried next interval.
+class MetricsFileWriter {
+public:
+    MetricsFileWriter(std::string path, std::chrono::milliseconds interval,
+                      std::function<void(std::ostream&)> write);
+    ~MetricsFileWriter();
+
+    MetricsFileWriter(const MetricsFileWriter&) = delete;
+    MetricsFileWriter& operator=(const MetricsFileWriter&) = delete;
+
+    void writeNow();
+
+    // Prometheus text for *.prom paths, JSON otherwise
+    static bool isPrometheusPath(const std::string& path);
+
+private:
+    void run();
+
+    std::string path_;
+    std::chrono::milliseconds interval_;
+    std::function<void(std::ostream&)> write_;
+
+    std::mutex mutex_;
+    std::condition_variable stopRequested_;
+    bool stopping_{false};
+    std::mutex writeMutex_;
+    std::thread thread_;
+};
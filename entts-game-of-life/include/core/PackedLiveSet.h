@@ -0,0 +1,70 @@
+#pragma once
+
+#include "components/Position.h"
+#include "LifeRule.h"
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Live set kept as one sorted array of packed coordinates (Position::packed(),
+// x in the high half) with no per-cell entities - 8 bytes per living cell.
+// Coordinates passed in must already be inside the grid (see normalizePosition()).
+//
+// A step writes the key of every neighbor of every living cell into a scratch
+// array and radix-sorts it, so each run of equal keys is one position's
+// neighbor count. Merging those runs with the live array applies the rules in
+// a single pass and produces the next live array already sorted.
+class PackedLiveSet {
+public:
+    PackedLiveSet(std::int32_t width, std::int32_t height, bool wrapEdges, const LifeRule& rule = {});
+
+    // Cell access. Single edits shift the array; load patterns with setCellsAlive().
+    void setCell(std::int32_t x, std::int32_t y, bool alive);
+    void setCellsAlive(std::span<const Position> cells);
+    bool getCell(std::int32_t x, std::int32_t y) const;
+
+    // Counts neighbors of any position, with the same wrap/bounds rules as the sparse engine
+    std::uint8_t countNeighbors(std::int32_t x, std::int32_t y) const;
+
+    // Simulation
+    bool step(); // Returns true if any cell changed
+    void clear();
+
+    // State queries
+    std::size_t getLivingCellCount() const { return cells_.size(); }
+    void collectLivingCells(std::vector<Position>& out) const;
+    std::size_t getMemoryUsage() const; // Bytes held by the live arrays and step scratch
+
+    // Living cells inside the inclusive bounds, in grid coordinates (no
+    // wrapped copies), appended to out
+    void collectLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY, std::int32_t maxY,
+                                    std::vector<Position>& out) const;
+
+    // Cells born and died in the last step, appended to the output buffers.
+    // Only meaningful right after a step; edits since then are not tracked.
+    void collectChanges(std::vector<Position>& born, std::vector<Position>& died) const;
+
+private:
+    static std::uint64_t key(std::int32_t x, std::int32_t y) { return Position(x, y).packed(); }
+    static Position position(std::uint64_t key) {
+        return Position(static_cast<std::int32_t>(key >> 32), static_cast<std::int32_t>(key & 0xFFFFFFFFu));
+    }
+
+    // LSD radix sort on bytes, skipping bytes every key shares
+    void sortKeys(std::vector<std::uint64_t>& keys);
+
+    std::int32_t width_;
+    std::int32_t height_;
+    bool wrapEdges_;
+    LifeRule rule_;
+
+    std::vector<std::uint64_t> cells_;       // Sorted keys of the living cells
+    std::vector<std::uint64_t> next_;        // Next generation, swapped in after a step
+
+    // Step scratch, reused so a warmed-up step allocates nothing
+    std::vector<std::uint64_t> neighbors_;   // One key per (living cell, neighbor) pair
+    std::vector<std::uint64_t> sortScratch_;
+    std::vector<Position> born_;
+    std::vector<Position> died_;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "LifeRule.h"
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <string>
+
+// Streaming readers for the pattern formats the Life community distributes.
+// Both decode as they read and report live cells as horizontal runs, so a
+// large pattern is never held as text or as a cell list by the reader.
+// Malformed input throws std::runtime_error.
+
+enum class PatternFormat {
+    Json,       // {"cells": [{"x": .., "y": ..}, ...]}
+    Rle,        // .rle run-length encoding
+    Macrocell   // .mc quadtree (Golly)
+};
+
+// Picks the format from the file extension; anything unrecognized is JSON
+PatternFormat patternFormatFromPath(const std::string& path);
+
+using PatternRunCallback = std::function<void(std::int32_t x, std::int32_t y, std::uint32_t length)>;
+
+// Extended RLE: optional "#" lines ("#P x y" / "#R x y" move the top-left
+// corner, which is otherwise (0, 0)), a "x = .., y = .., rule = .." header,
+// then <count><tag> items up to "!". y grows downward. A header rule other
+// than rule is rejected; a file without one is read as it is.
+void readRlePattern(std::istream& in, const PatternRunCallback& fn, const LifeRule& rule = kConwayRule);
+
+// Macrocell: "[M2]" header, "#" lines, then one node per line - either an
+// 8x8 leaf drawn with '.', '*' and '$', or "level nw ne sw se" with 1-based
+// references to earlier nodes (0 is empty). The last node is the root,
+// centred on the origin as Golly places it. A "#R" rule line is checked
+// against rule like the RLE header.
+void readMacrocellPattern(std::istream& in, const PatternRunCallback& fn, const LifeRule& rule = kConwayRule);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "components/Position.h"
+#include "core/CoordinateMap.h"
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Live cell counts of aligned square blocks at every power-of-two size, for
+// zoomed-out views of boards far larger than the screen.
+//
+// Level s counts the blocks of 2^s cells a side, for s from 1 to
+// kMaxScaleLog2. Every block links to the block holding it a level up, so a
+// birth or death finds its 2x2 block in one lookup and then adds or takes
+// one at each level above by following the links. Blocks that empty are
+// recycled. countBlock() answers any level in one lookup, so an overview
+// costs one lookup per character whatever its scale.
+class PopulationPyramid {
+public:
+    static constexpr std::uint32_t kMaxScaleLog2 = 20;
+
+    // Cells must be added while dead and removed while alive
+    void add(const Position& pos);
+    void remove(const Position& pos);
+    void apply(std::span<const Position> born, std::span<const Position> died);
+
+    void rebuild(std::span<const Position> cells);
+    void clear(); // Keeps the block storage for refilling
+
+    std::uint64_t size() const { return size_; }
+    std::size_t getMemoryUsage() const;
+
+    // Live cells of the block 2^scaleLog2 cells a side whose corner is cell
+    // (blockX << scaleLog2, blockY << scaleLog2); scaleLog2 from 1 to kMaxScaleLog2
+    std::uint32_t countBlock(std::uint32_t scaleLog2, std::int32_t blockX, std::int32_t blockY) const;
+
+private:
+    static constexpr std::uint32_t kNoBlock = UINT32_MAX;
+
+    struct Block {
+        std::uint32_t count{0};
+        std::uint32_t parent{kNoBlock}; // Slot of the block holding this one, a level up
+    };
+
+    // Slot of the block at scaleLog2 and block coordinate, created with its ancestors if missing
+    std::uint32_t acquireBlock(std::uint32_t scaleLog2, const Position& blockPos);
+
+    std::vector<Block> blocks_;
+    std::vector<std::uint32_t> freeBlocks_;
+    std::array<CoordinateMap<std::uint32_t>, kMaxScaleLog2> levels_; // Occupied blocks of level s at [s - 1]
+    std::uint64_t size_{0};
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "GameConfig.h"
+#include "CoordinateMap.h"
+#include "LifeEngine.h"
+#include "Metrics.h"
+#include "components/Position.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// What one stream still owes its client. Steps and edits fold their changes
+// in as they happen, so however many generations pass between two reads the
+// client gets one net delta, and a cell that dies and comes back in between
+// is never sent. Once the delta outgrows its limit it is dropped in favour of
+// a keyframe, the whole board, so a client that falls far behind holds no
+// backlog. Guarded by the session's lock.
+class StreamSubscription {
+public:
+    explicit StreamSubscription(std::size_t maxPendingCells) : maxPendingCells_(maxPendingCells) {}
+
+private:
+    friend class SimulationSession;
+
+    void record(const Position& pos, bool alive);
+
+    CoordinateMap<bool> pending_; // Cells whose state differs from the client's copy, with their state now
+    std::size_t maxPendingCells_;
+    bool keyframe_{true};         // The client's copy is missing or was given up on
+    std::uint64_t sentGeneration_{0};
+};
+
+// One board served over the network. Every method locks the session, so RPCs
+// and streams touching the same board are serialized while different boards
+// run in parallel. Cells outside the width x height grid are ignored, also on
+// engines whose domain is unbounded.
+class SimulationSession {
+public:
+    struct Snapshot {
+        std::uint64_t generation{0};
+        std::int32_t width{0};
+        std::int32_t height{0};
+        std::vector<Position> cells;
+    };
+
+    struct StepResult {
+        std::uint64_t generation{0};
+        std::size_t liveCells{0};
+        std::size_t changedCells{0}; // Cells whose state differs from before the request
+    };
+
+    struct StreamUpdate {
+        std::uint64_t generation{0};
+        std::size_t liveCells{0};
+        std::vector<Position> born; // Alive now, dead in the client's copy (every live cell in a keyframe)
+        std::vector<Position> died;
+        bool keyframe{false};       // Replaces the client's copy instead of patching it
+        bool ended{false};          // The board is empty or stopped changing
+    };
+
+    // Pending changes a subscription may hold before it falls back to a keyframe
+    static constexpr std::size_t kDefaultMaxPendingCells = 4096;
+
+    SimulationSession(std::string id, std::unique_ptr<LifeEngine> engine);
+
+    SimulationSession(const SimulationSession&) = delete;
+    SimulationSession& operator=(const SimulationSession&) = delete;
+
+    const std::string& getId() const { return id_; }
+
+    Snapshot snapshot() const;
+
+    // Sets the generation if given, and replaces the board with cells if given
+    Snapshot update(std::optional<std::uint64_t> generation, std::optional<std::span<const Position>> cells);
+
+    // Adds cells moved by offset; returns how many were not already alive
+    std::size_t addPattern(std::span<const Position> cells, Position offset);
+
+    // Runs steps generations in one go; intermediate boards are never reported.
+    // Throws MemoryLimitError while the board is over its memory limit; one
+    // that reaches the limit part way stops early, at the generation returned.
+    StepResult step(std::uint64_t steps);
+
+    // A stream's view of the board. The session feeds it every change until
+    // the returned subscription is released; its first update is a keyframe.
+    std::shared_ptr<StreamSubscription> subscribe(std::size_t maxPendingCells = kDefaultMaxPendingCells);
+
+    // Whether the board or generation moved on since the subscription's last update
+    bool hasUpdate(const StreamSubscription& subscription) const;
+
+    // Everything the subscription has collected since its last update, sorted
+    StreamUpdate takeUpdate(StreamSubscription& subscription);
+
+    // Step and board-read latencies, changes and lock waits of this board
+    const SimulationMetrics& getMetrics() const { return metrics_; }
+
+private:
+    Snapshot snapshotLocked() const;
+    bool inGrid(const Position& pos) const;
+    std::vector<Position> sortedCells() const;
+    void publish(std::span<const Position> born, std::span<const Position> died);
+    void publishKeyframe();
+
+    mutable std::mutex mutex_;
+    mutable SimulationMetrics metrics_;
+    std::string id_;
+    std::unique_ptr<LifeEngine> engine_;
+    bool settled_{false}; // The last step changed nothing
+    std::vector<std::weak_ptr<StreamSubscription>> subscribers_;
+};
+
+// Sessions by id, created from a base configuration with the requested grid
+// size. Named initial patterns are read from <patternDirectory>/<name>.json
+// through the PatternCache, or else taken from the embedded patterns/ corpus
+// (see PatternLibrary.h), so a server needs no pattern files to start.
+class SimulationStore {
+public:
+    static constexpr std::int32_t kMaxGridDimension = 1000; // Same limit as the Bevy server
+
+    explicit SimulationStore(GameConfig baseConfig, std::string patternDirectory = "patterns");
+
+    // Throws std::invalid_argument for a bad grid size or an unknown pattern
+    std::shared_ptr<SimulationSession> create(std::int32_t width, std::int32_t height,
+                                              const std::string& initialPattern = "");
+
+    std::shared_ptr<SimulationSession> find(const std::string& id) const; // nullptr if unknown
+    bool erase(const std::string& id);
+    std::size_t size() const;
+
+    // Every session, in no particular order
+    std::vector<std::shared_ptr<SimulationSession>> list() const;
+
+    const GameConfig& getBaseConfig() const { return baseConfig_; }
+
+private:
+    std::vector<Position> readNamedPattern(const std::string& name) const;
+    std::string nextId();
+
+    GameConfig baseConfig_;
+    std::string patternDirectory_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<SimulationSession>> sessions_;
+    std::mt19937_64 idGenerator_;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "components/Position.h"
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Binary board checkpoint: a 64-byte little-endian header followed by the
+// live cells as run-length-encoded rows.
+//
+//   offset  field
+//        0  magic "GOLS"
+//        4  u32 version (kSnapshotVersion)
+//        8  u64 generation
+//       16  i32 grid min x, i32 grid min y
+//       24  u32 grid width, u32 grid height
+//       32  u32 flags (bit 0: wrap edges)
+//       36  i32 cell bounds min x, i32 cell bounds min y
+//       44  u32 non-empty row count
+//       48  u64 cell count
+//       56  u64 payload bytes
+//
+// The payload holds one record per non-empty row, in increasing y. Every
+// number is an unsigned LEB128 varint:
+//
+//   row gap    y minus the previous row's y (the first row counts from bounds min y)
+//   run count
+//   per run:   gap from the end of the previous run (the first counts from
+//              bounds min x), then run length
+//
+// Rows and runs only cost space where there are cells, so a sparse board on
+// a huge plane stays small.
+struct SnapshotInfo {
+    std::uint64_t generation{0};
+    std::int32_t gridMinX{0};
+    std::int32_t gridMinY{0};
+    std::uint32_t gridWidth{0};
+    std::uint32_t gridHeight{0};
+    bool wrapEdges{false};
+    std::uint64_t cellCount{0};
+};
+
+constexpr std::uint32_t kSnapshotVersion = 1;
+
+// Writes the cells, sorting them into row order first. Throws
+// std::runtime_error if the file cannot be written.
+void writeSnapshotFile(const std::string& path, const SnapshotInfo& info, std::vector<Position>& cells);
+
+// Same file, written to path + ".partial", flushed to disk (fsync) and
+// renamed over path, so a crash at any point leaves the previous file or the
+// new one whole - for checkpoints.
+void writeSnapshotFileSynced(const std::string& path, const SnapshotInfo& info, std::vector<Position>& cells);
+
+// Memory-maps a snapshot file and decodes it in place. The constructor
+// validates the header and throws std::runtime_error on any problem; the
+// payload is checked while it is decoded.
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const std::string& path);
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    const SnapshotInfo& getInfo() const { return info_; }
+
+    // Calls fn(x, y, length) for every horizontal run of live cells, in row order
+    void readRuns(const std::function<void(std::int32_t x, std::int32_t y, std::uint32_t length)>& fn) const;
+
+private:
+    void unmap();
+
+    SnapshotInfo info_;
+    const std::uint8_t* data_{nullptr};
+    std::size_t size_{0};
+    std::int32_t boundsMinX_{0};
+    std::int32_t boundsMinY_{0};
+    std::uint32_t rowCount_{0};
+    std::uint64_t payloadBytes_{0};
+
+#ifdef _WIN32
+    void* fileHandle_{nullptr};
+    void* mappingHandle_{nullptr};
+#endif
+};
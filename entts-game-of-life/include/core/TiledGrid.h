@@ -0,0 +1,123 @@
+#pragma once
+
+#include "components/Position.h"
+#include "DenseKernels.h"
+#include "WorkStealingPool.h"
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Bit-packed grid split into fixed 64x64 tiles that are stepped in parallel.
+// Coordinates passed in must already be inside the grid (see normalizePosition()).
+//
+// Each tile is 64 rows of one 64-bit word. A tile step gathers a halo - the
+// row above and below plus the bordering word of each row on both sides -
+// from its neighbors into a private buffer, so workers only ever read the
+// current generation and write their own tile of the next one.
+//
+// step(generations) blocks in time as well: each worker copies a whole row
+// of tiles plus kBlockGenerations rows above and below into a buffer small
+// enough to stay in cache, advances it that many generations there, and
+// writes back only the tile rows. The halo shrinks by one row a generation,
+// so the tile rows come out exact, and board memory is swept once per block
+// instead of once per generation.
+//
+// Tiles are owned in contiguous runs: the worker that steps a tile is the
+// one that zeroed it when the grid was built, and with a NUMA placement the
+// tile's pages are placed on that worker's node, so workers read local
+// memory except at the edges of their run.
+class TiledGrid {
+public:
+    static constexpr std::int32_t kTileSize = 64;
+    static constexpr std::int32_t kBlockGenerations = 8; // Generations per pass of step(generations)
+
+    // threads counts the calling thread (0 = one per hardware thread)
+    TiledGrid(std::int32_t width, std::int32_t height, bool wrapEdges, std::uint32_t threads,
+              const LifeRule& rule = {}, WorkerPlacement placement = {});
+
+    // Cell access
+    void setCell(std::int32_t x, std::int32_t y, bool alive);
+    bool getCell(std::int32_t x, std::int32_t y) const;
+
+    // Whole rows as getTilesX() words each, bit (x & 63) of word (x >> 6):
+    // copyRows appends rows [y, y + rows) to out, setRows overwrites them
+    // from words. Used to move slab edges between PartitionedBoard nodes.
+    void copyRows(std::int32_t y, std::int32_t rows, std::vector<std::uint64_t>& out) const;
+    void setRows(std::int32_t y, std::int32_t rows, std::span<const std::uint64_t> words);
+
+    // Counts neighbors of any position, with the same wrap/bounds rules as the sparse engine
+    std::uint8_t countNeighbors(std::int32_t x, std::int32_t y) const;
+
+    // Simulation
+    bool step(); // Returns true if any cell changed
+    
+    // Advances the given number of generations, kBlockGenerations per pass
+    // over memory. Returns true if the board differs from before; the
+    // changes then cover all of them. Wrapped grids whose width is not a
+    // multiple of 64 step one generation at a time.
+    bool step(std::uint32_t generations);
+    void clear();
+
+    // State queries
+    std::size_t getLivingCellCount() const { return population_; }
+    void collectLivingCells(std::vector<Position>& out) const;
+    std::size_t getMemoryUsage() const; // Bytes held by both generations and the per-tile state
+
+    // Cells born and died in the last step, appended to the output buffers.
+    // Only meaningful right after a step; edits since then are not tracked.
+    void collectChanges(std::vector<Position>& born, std::vector<Position>& died) const;
+
+    // Layout and threading queries
+    std::int32_t getTilesX() const { return tilesX_; }
+    std::int32_t getTilesY() const { return tilesY_; }
+    std::uint32_t getThreadCount() const { return pool_.getThreadCount(); }
+    std::uint32_t getNodeCount() const { return pool_.getTopology().getNodeCount(); }
+    std::uint64_t getStealCount() const { return pool_.getStealCount(); }
+    std::uint64_t getRemoteStealCount() const { return pool_.getRemoteStealCount(); }
+
+    // True if the tile changed in the last step
+    bool tileChanged(std::int32_t tileX, std::int32_t tileY) const { return changed_[tileIndex(tileX, tileY)] != 0; }
+
+private:
+    using Tile = std::array<std::uint64_t, kTileSize>;
+    using TileBuffer = std::vector<Tile, PlacementAllocator<Tile>>;
+
+    std::size_t tileIndex(std::int32_t tileX, std::int32_t tileY) const {
+        return static_cast<std::size_t>(tileY) * static_cast<std::size_t>(tilesX_) + static_cast<std::size_t>(tileX);
+    }
+
+    // Word of the current generation holding columns [64 * word, 64 * word + 63] of a row.
+    // Rows outside the grid wrap or read as zero; words outside the grid read as zero.
+    std::uint64_t haloWord(std::int32_t word, std::int32_t y) const;
+
+    void stepTile(std::size_t index);
+    void stepTileRow(std::int32_t tileY, std::int32_t generations);
+    bool collectStepResult(); // Swaps in next_ and sums the per-tile results
+    void patchWrappedColumn(std::int32_t x);
+    
+    // Sizes tiles to the grid, each tile placed on its owner's node and
+    // zeroed by its owner
+    void placeTiles(TileBuffer& tiles);
+
+    std::int32_t width_;
+    std::int32_t height_;
+    bool wrapEdges_;
+    std::int32_t tilesX_;
+    std::int32_t tilesY_;
+    std::uint64_t lastWordMask_;  // Valid bits of the last tile column
+    DenseKernel kernel_;
+    LifeRule rule_;
+    bool conwayRule_; // B3/S23 takes the kernel's dedicated stepRow
+
+    // Current and next generation, tiles in row-major order
+    TileBuffer cells_;
+    TileBuffer next_;
+    std::vector<std::uint8_t> changed_;      // Per tile, written by its own worker
+    std::vector<std::size_t> tileCounts_;    // Per-tile population of next_
+    TileBuffer passStart_;                   // Board before a step(generations) of several passes
+    std::size_t population_{0};
+
+    WorkStealingPool pool_;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "components/Position.h"
+#include <cstdint>
+
+// Grid topologies the per-cell step loops are instantiated for. A loop picks
+// its topology once per step (withTopology()), then visits neighbors through
+// forEachNeighbor(): cells off the border take the eight offsets as they
+// are, with no bounds test or wrap, and only border cells pay for either.
+// Wrapping compares against the edges instead of using %, since a neighbor
+// is never more than one cell past them.
+//
+// Positions passed in must be inside the grid. The unbounded planes
+// (HashLife, ChunkedPlane) never go through these loops.
+
+// Cells past the edges are dead
+struct BoundedTopology {
+    std::int32_t width;
+    std::int32_t height;
+
+    // Neighbor of a border cell; false if it falls off the grid
+    bool borderNeighbor(std::int32_t x, std::int32_t y, Position& out) const {
+        if (x < 0 || x >= width || y < 0 || y >= height) {
+            return false;
+        }
+        out = Position(x, y);
+        return true;
+    }
+};
+
+// Opposite edges are joined
+struct TorusTopology {
+    std::int32_t width;
+    std::int32_t height;
+
+    bool borderNeighbor(std::int32_t x, std::int32_t y, Position& out) const {
+        out = Position(x < 0 ? x + width : (x >= width ? x - width : x),
+                       y < 0 ? y + height : (y >= height ? y - height : y));
+        return true;
+    }
+};
+
+// Calls fn with the topology of a width x height grid
+template <typename Fn>
+decltype(auto) withTopology(std::int32_t width, std::int32_t height, bool wrapEdges, Fn&& fn) {
+    if (wrapEdges) {
+        return fn(TorusTopology{width, height});
+    }
+    return fn(BoundedTopology{width, height});
+}
+
+// Calls fn with each of the (up to) eight neighbors of an in-grid position
+template <typename Topology, typename Fn>
+inline void forEachNeighbor(const Topology& topology, Position pos, Fn&& fn) {
+    constexpr std::int32_t kOffsets[8][2] = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+
+    // Grids under three cells across have no interior; their border path wraps like % would
+    if (pos.x > 0 && pos.x < topology.width - 1 && pos.y > 0 && pos.y < topology.height - 1) {
+        for (const auto& offset : kOffsets) {
+            fn(Position(pos.x + offset[0], pos.y + offset[1]));
+        }
+        return;
+    }
+    for (const auto& offset : kOffsets) {
+        Position neighbor;
+        if (topology.borderNeighbor(pos.x + offset[0], pos.y + offset[1], neighbor)) {
+            fn(neighbor);
+        }
+    }
+}
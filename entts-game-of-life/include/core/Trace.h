@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+// Scoped-timer tracing for finding where a slow frame went.
+//
+// GOL_TRACE_SCOPE("name") times the enclosing scope, and
+// GOL_TRACE_THREAD_NAME labels the calling thread. Each thread appends its
+// spans to a ring buffer of its own, so recording takes no lock and only the
+// newest kEventsPerThread spans per thread are kept. writeChromeTrace() dumps
+// every thread's buffer as Chrome trace JSON, which chrome://tracing and
+// ui.perfetto.dev both open.
+//
+// The macros compile to nothing unless the build sets GOL_PROFILING_ENABLED
+// (cmake -DENABLE_PROFILING=ON); in such a build, spans are only recorded
+// while setEnabled(true).
+class Trace {
+public:
+    static constexpr std::size_t kEventsPerThread = std::size_t{1} << 14;
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled() noexcept;
+
+    // Nanoseconds on the trace clock
+    static std::uint64_t now() noexcept;
+
+    // name must outlive the trace; scopes pass string literals
+    static void record(const char* name, std::uint64_t startNs, std::uint64_t endNs) noexcept;
+
+    // Label for the calling thread in dumps
+    static void setThreadName(const std::string& name);
+
+    // Forgets every span recorded so far
+    static void clear();
+
+    static void writeChromeTrace(std::ostream& out);
+    // Throws std::runtime_error if the file cannot be written
+    static void writeChromeTrace(const std::string& path);
+};
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) noexcept
+        : name_(Trace::isEnabled() ? name : nullptr), start_(name_ ? Trace::now() : 0) {}
+    ~TraceScope() {
+        if (name_) {
+            Trace::record(name_, start_, Trace::now());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    std::uint64_t start_;
+};
+
+#define GOL_TRACE_CONCAT_INNER(a, b) a##b
+#define GOL_TRACE_CONCAT(a, b) GOL_TRACE_CONCAT_INNER(a, b)
+
+#ifdef GOL_PROFILING_ENABLED
+#define GOL_TRACE_SCOPE(name) TraceScope GOL_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define GOL_TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+#else
+#define GOL_TRACE_SCOPE(name) static_cast<void>(0)
+#define GOL_TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "NumaTopology.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// How a pool's workers are laid out over NUMA nodes
+struct WorkerPlacement {
+    NumaTopology topology;   // The default single node leaves placement to the OS
+    bool pinThreads{false};  // Pin each spawned worker to one CPU of its node
+};
+
+// Fixed-size thread pool for data-parallel loops.
+//
+// parallelFor() deals the task indices in contiguous blocks, one queue per
+// worker, so a worker gets the same block every batch of the same size and
+// can own the memory behind it. Each worker drains its own queue from the
+// front and, once empty, steals from the back of the others, so uneven tiles
+// balance out without a shared queue. The calling thread takes part as
+// worker 0.
+//
+// Workers are spread over the placement's nodes in contiguous groups, so
+// each node owns one contiguous range of every batch. A worker steals from
+// the workers of its own node before it reaches across to another.
+class WorkStealingPool {
+public:
+    // threads counts the calling thread (0 = one per hardware thread).
+    // The calling thread is never pinned; the pool does not own it.
+    explicit WorkStealingPool(std::uint32_t threads = 0, WorkerPlacement placement = {});
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    std::uint32_t getThreadCount() const { return static_cast<std::uint32_t>(queues_.size()); }
+
+    // Runs task(i) for every i in [0, count) and returns when all are done.
+    // task must be safe to call concurrently for different indices.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    // As above, but task i starts in the queue of worker owner(i), for
+    // batches whose indices do not line up with the memory they touch
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& task,
+                     const std::function<std::uint32_t(std::size_t)>& owner);
+
+    // Runs task(worker) once on every worker's own thread; nothing is
+    // stolen. Used to first-touch the memory each worker owns.
+    void forEachWorker(const std::function<void(std::size_t)>& task);
+
+    // Worker whose queue index starts in when parallelFor() deals count tasks
+    std::uint32_t getOwner(std::size_t index, std::size_t count) const {
+        return static_cast<std::uint32_t>(index * queues_.size() / count);
+    }
+
+    // Node (an index into getTopology()) a worker belongs to
+    std::uint32_t getWorkerNode(std::size_t worker) const { return workerNodes_[worker]; }
+    const NumaTopology& getTopology() const { return placement_.topology; }
+
+    // Tasks taken from another worker's queue since construction; the remote
+    // ones came from a worker on another node
+    std::uint64_t getStealCount() const { return steals_.load(std::memory_order_relaxed); }
+    std::uint64_t getRemoteStealCount() const { return remoteSteals_.load(std::memory_order_relaxed); }
+
+private:
+    // Pending tasks are items[head, size). The vector is cleared rather than
+    // shrunk once drained, so batches after the first allocate nothing.
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<std::size_t> items;
+        std::size_t head{0};
+    };
+
+    void runBatch(std::size_t count, const std::function<void(std::size_t)>& task,
+                  const std::function<std::uint32_t(std::size_t)>* owner, bool stealing);
+    void workerLoop(std::size_t worker);
+    bool takeTask(std::size_t worker, std::size_t& index);
+    void runTasks(std::size_t worker);
+
+    WorkerPlacement placement_;
+    std::vector<std::uint32_t> workerNodes_;
+    std::vector<std::uint32_t> workerCpus_; // CPU each spawned worker is pinned to, if pinning
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    // Batch hand-off between parallelFor() and the workers
+    std::mutex batchMutex_;
+    std::condition_variable batchStarted_;
+    std::condition_variable batchFinished_;
+    const std::function<void(std::size_t)>* task_{nullptr};
+    std::uint64_t batch_{0};
+    std::atomic<std::size_t> remaining_{0};
+    std::atomic<bool> stealing_{true};
+    bool stopping_{false};
+
+    std::atomic<std::uint64_t> steals_{0};
+    std::atomic<std::uint64_t> remoteSteals_{0};
+};
@@ -21,16 +21,49 @@ struct Position {
         }
         return y <=> other.y;
     }
+    
+    // Both coordinates in one 64-bit key, x in the high half
+    constexpr std::uint64_t packed() const noexcept {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+    
+    // Z-order (Morton) key: the bits of x and y interleaved, x in the even
+    // bits. Sign bits are flipped so the order runs from negative to positive.
+    constexpr std::uint64_t morton() const noexcept {
+        return spreadBits(static_cast<std::uint32_t>(x) ^ 0x80000000u) |
+               (spreadBits(static_cast<std::uint32_t>(y) ^ 0x80000000u) << 1);
+    }
+    
+private:
+    // Moves bit i of value to bit 2i
+    static constexpr std::uint64_t spreadBits(std::uint32_t value) noexcept {
+        std::uint64_t bits = value;
+        bits = (bits | (bits << 16)) & 0x0000ffff0000ffffull;
+        bits = (bits | (bits << 8)) & 0x00ff00ff00ff00ffull;
+        bits = (bits | (bits << 4)) & 0x0f0f0f0f0f0f0f0full;
+        bits = (bits | (bits << 2)) & 0x3333333333333333ull;
+        bits = (bits | (bits << 1)) & 0x5555555555555555ull;
+        return bits;
+    }
 };
 
+// splitmix64 finalizer: every input bit affects every output bit, so packed
+// coordinates of diagonal or negative-valued patterns still spread evenly
+constexpr std::uint64_t mixCoordinateKey(std::uint64_t key) noexcept {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return key;
+}
+
 // Hash specialization for Position to use in unordered containers
 namespace std {
     template<>
     struct hash<Position> {
         std::size_t operator()(const Position& pos) const noexcept {
-            // Simple hash combining x and y coordinates
-            return std::hash<std::int32_t>{}(pos.x) ^ 
-                   (std::hash<std::int32_t>{}(pos.y) << 1);
+            return static_cast<std::size_t>(mixCoordinateKey(pos.packed()));
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "core/GameConfig.h"
+#include "core/SimulationStore.h"
+#include "game_of_life.grpc.pb.h"
+#include <grpcpp/alarm.h>
+#include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// Asynchronous gRPC front end for GameOfLifeService (proto/game_of_life.proto).
+// Worker threads share one completion queue and each RPC in flight is a small
+// state machine driven by its completion events, so a slow stream never holds
+// a thread: stream ticks wait on a grpc::Alarm rather than sleeping.
+class GameOfLifeServer {
+public:
+    static constexpr const char* kDefaultAddress = "0.0.0.0:50052";
+    static constexpr std::int32_t kDefaultStreamIntervalMs = 1000;
+
+    explicit GameOfLifeServer(GameConfig baseConfig, std::string patternDirectory = "patterns");
+    ~GameOfLifeServer();
+
+    GameOfLifeServer(const GameOfLifeServer&) = delete;
+    GameOfLifeServer& operator=(const GameOfLifeServer&) = delete;
+
+    // Binds the address and starts the workers (0 = one per hardware thread).
+    // Throws std::runtime_error if the server cannot start.
+    void start(const std::string& address = kDefaultAddress, unsigned workerThreads = 0);
+
+    // Cancels outstanding RPCs and stops the workers; safe to call more than once
+    void shutdown();
+
+    SimulationStore& getStore() { return store_; }
+
+private:
+    class Call;
+    template <typename Request, typename Response>
+    class UnaryCall;
+    class StreamCall;
+
+    void serve();
+    void listen();
+
+    // Unary handlers, run on a worker thread
+    grpc::Status getStatus(const game_of_life::StatusRequest& request, game_of_life::StatusResponse& response);
+    grpc::Status createSimulation(const game_of_life::CreateSimulationRequest& request,
+                                  game_of_life::SimulationResponse& response);
+    grpc::Status getSimulation(const game_of_life::GetSimulationRequest& request,
+                               game_of_life::SimulationResponse& response);
+    grpc::Status updateSimulation(const game_of_life::UpdateSimulationRequest& request,
+                                  game_of_life::SimulationResponse& response);
+    grpc::Status deleteSimulation(const game_of_life::DeleteSimulationRequest& request,
+                                  game_of_life::DeleteResponse& response);
+    grpc::Status stepSimulation(const game_of_life::StepSimulationRequest& request,
+                                game_of_life::StepResponse& response);
+    grpc::Status loadPattern(const game_of_life::LoadPatternRequest& request,
+                             game_of_life::LoadPatternResponse& response);
+
+    SimulationStore store_;
+    std::chrono::steady_clock::time_point startTime_;
+
+    game_of_life::GameOfLifeService::AsyncService service_;
+    std::unique_ptr<grpc::ServerCompletionQueue> queue_;
+    std::unique_ptr<grpc::Server> server_;
+    std::vector<std::thread> workers_;
+
+    // Held shared while a worker handles an event, so no call starts a new
+    // operation once shutdown has begun draining the queue
+    std::shared_mutex shutdownMutex_;
+    bool shuttingDown_{false};
+    std::once_flag shutdownOnce_;
+
+    // Running streams, whose alarms are cancelled at shutdown
+    std::mutex streamsMutex_;
+    std::unordered_set<StreamCall*> streams_;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "core/PartitionedBoard.h"
+#include "game_of_life.grpc.pb.h"
+#include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// HaloTransport between processes over HaloExchangeService
+// (proto/game_of_life.proto). Every rank serves the service at its own
+// address: halos sent to it land in a HaloMailbox, and rank 0 also holds the
+// ReductionBarrier the other ranks reach through Reduce. Sends wait for a
+// peer that has not started listening yet, up to the timeout.
+class GrpcHaloTransport : public HaloTransport {
+public:
+    static constexpr std::chrono::milliseconds kDefaultTimeout{60000};
+
+    // peers[i] is the address of rank i; this rank listens on peers[rank]
+    // unless listenAddress is given (e.g. "0.0.0.0:port" behind NAT). Throws
+    // std::invalid_argument for a rank out of range and std::runtime_error
+    // if the server cannot start.
+    GrpcHaloTransport(std::uint32_t rank, std::vector<std::string> peers,
+                      std::chrono::milliseconds timeout = kDefaultTimeout, const std::string& listenAddress = "");
+    ~GrpcHaloTransport() override;
+
+    GrpcHaloTransport(const GrpcHaloTransport&) = delete;
+    GrpcHaloTransport& operator=(const GrpcHaloTransport&) = delete;
+
+    std::uint32_t getRank() const override { return rank_; }
+    std::uint32_t getRankCount() const override { return static_cast<std::uint32_t>(peers_.size()); }
+
+    // Throw std::runtime_error when a peer fails or times out
+    void send(std::uint32_t rank, HaloMessage message) override;
+    HaloMessage receive(std::uint32_t fromRank, bool downward, std::uint64_t round) override;
+    HaloReduction allReduce(std::uint64_t round, const HaloReduction& local) override;
+
+private:
+    class Service;
+
+    game_of_life::HaloExchangeService::Stub& getStub(std::uint32_t rank);
+    void setDeadline(grpc::ClientContext& context) const;
+
+    std::uint32_t rank_;
+    std::vector<std::string> peers_;
+    std::chrono::milliseconds timeout_;
+    HaloMailbox mailbox_;
+    ReductionBarrier barrier_; // Used on rank 0 only
+    std::unique_ptr<Service> service_;
+    std::unique_ptr<grpc::Server> server_;
+    std::vector<std::unique_ptr<game_of_life::HaloExchangeService::Stub>> stubs_; // Made on first use
+};
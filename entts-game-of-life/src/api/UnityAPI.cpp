@@ -0,0 +1,296 @@
+#include "api/UnityAPI.h"
+#include "core/GameConfig.h"
+#include "core/LifeEngine.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static_assert(sizeof(GolCell) == sizeof(Position) && offsetof(GolCell, y) == offsetof(Position, y),
+              "Position is handed out as GolCell");
+
+namespace {
+
+thread_local std::string lastError;
+
+// A frame with the buffers its pointers refer to
+struct Frame : GolFrame {
+    std::vector<Position> cells;
+    std::vector<Position> born;
+    std::vector<Position> died;
+    std::vector<std::uint64_t> bitmap;
+    std::uint32_t pins{0};
+};
+
+const GolCell* asCells(const std::vector<Position>& cells) {
+    return cells.empty() ? nullptr : reinterpret_cast<const GolCell*>(cells.data());
+}
+
+GolResult fail(GolResult result, const std::string& message) {
+    lastError = message;
+    return result;
+}
+
+// Runs fn, turning exceptions into error codes so none crosses the C boundary
+template <typename Fn>
+GolResult guarded(GolSimulation* simulation, Fn&& fn) {
+    if (!simulation) {
+        return fail(GOL_ERROR_INVALID_ARGUMENT, "Simulation handle is null");
+    }
+    try {
+        return fn();
+    } catch (const std::bad_alloc&) {
+        return fail(GOL_ERROR_INTERNAL, "Out of memory");
+    } catch (const std::exception& e) {
+        return fail(GOL_ERROR_INTERNAL, e.what());
+    }
+}
+
+} // namespace
+
+struct GolSimulation {
+    explicit GolSimulation(const GameConfig& config) : engine(createLifeEngine(config)) {}
+
+    // Called with mutex held
+    Frame& currentFrame() {
+        if (latest && latest->version == version) {
+            return *latest;
+        }
+
+        // Reuse a released frame, so steady acquire/release cycles allocate nothing
+        Frame* frame = nullptr;
+        for (auto& candidate : frames) {
+            if (candidate.get() != latest && candidate->pins == 0) {
+                frame = candidate.get();
+                break;
+            }
+        }
+        if (!frame) {
+            frames.push_back(std::make_unique<Frame>());
+            frame = frames.back().get();
+        }
+        build(*frame);
+        latest = frame;
+        return *frame;
+    }
+
+    void build(Frame& frame) {
+        frame.born.clear();
+        frame.died.clear();
+        if (latest && latest->version == stepBase && version == stepBase + 1) {
+            // A single step since the latest frame: the engine reports its
+            // changes, and merging them into the latest cells keeps the order
+            // without walking the engine or sorting the board
+            frame.born.assign(engine->getBornCells().begin(), engine->getBornCells().end());
+            frame.died.assign(engine->getDiedCells().begin(), engine->getDiedCells().end());
+            std::sort(frame.born.begin(), frame.born.end());
+            std::sort(frame.died.begin(), frame.died.end());
+            survivors.clear();
+            std::set_difference(latest->cells.begin(), latest->cells.end(), frame.died.begin(), frame.died.end(),
+                                std::back_inserter(survivors));
+            frame.cells.clear();
+            std::merge(survivors.begin(), survivors.end(), frame.born.begin(), frame.born.end(),
+                       std::back_inserter(frame.cells));
+        } else {
+            frame.cells = engine->getLivingPositions();
+            std::sort(frame.cells.begin(), frame.cells.end());
+            if (latest) {
+                std::set_difference(frame.cells.begin(), frame.cells.end(), latest->cells.begin(),
+                                    latest->cells.end(), std::back_inserter(frame.born));
+                std::set_difference(latest->cells.begin(), latest->cells.end(), frame.cells.begin(),
+                                    frame.cells.end(), std::back_inserter(frame.died));
+            }
+        }
+
+        const auto& config = engine->getConfig();
+        const std::int32_t width = config.getGridWidth();
+        const std::int32_t height = config.getGridHeight();
+        const auto wordsPerRow = static_cast<std::uint32_t>((width + 63) / 64);
+        if (bitmapEnabled) {
+            frame.bitmap.assign(static_cast<std::size_t>(wordsPerRow) * static_cast<std::size_t>(height), 0);
+            for (const auto& pos : frame.cells) {
+                if (pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height) {
+                    frame.bitmap[static_cast<std::size_t>(pos.y) * wordsPerRow + static_cast<std::size_t>(pos.x / 64)] |=
+                        std::uint64_t{1} << (pos.x % 64);
+                }
+            }
+        } else {
+            frame.bitmap.clear();
+        }
+
+        frame.version = version;
+        frame.generation = engine->getGenerationCount();
+        frame.GolFrame::cells = asCells(frame.cells);
+        frame.cellCount = static_cast<std::uint32_t>(frame.cells.size());
+        frame.deltaBase = latest ? latest->version : 0;
+        frame.GolFrame::born = asCells(frame.born);
+        frame.bornCount = static_cast<std::uint32_t>(frame.born.size());
+        frame.GolFrame::died = asCells(frame.died);
+        frame.diedCount = static_cast<std::uint32_t>(frame.died.size());
+        frame.GolFrame::bitmap = bitmapEnabled ? frame.bitmap.data() : nullptr;
+        frame.bitmapWordsPerRow = bitmapEnabled ? wordsPerRow : 0;
+        frame.gridWidth = width;
+        frame.gridHeight = height;
+    }
+
+    std::mutex mutex;
+    std::unique_ptr<LifeEngine> engine;
+    std::uint64_t version{1};
+    std::uint64_t stepBase{0}; // Version a single step left; the engine's changes lead from it to the next
+    bool bitmapEnabled{false};
+    std::vector<Position> survivors; // Scratch for build()
+
+    std::vector<std::unique_ptr<Frame>> frames;
+    Frame* latest{nullptr};
+};
+
+extern "C" {
+
+uint32_t gol_get_api_version(void) {
+    return GOL_API_VERSION;
+}
+
+const char* gol_get_last_error(void) {
+    return lastError.c_str();
+}
+
+GolSimulation* gol_create(const char* configJson) {
+    try {
+        GameConfig config;
+        if (configJson && *configJson) {
+            config.fromJson(nlohmann::json::parse(configJson));
+        }
+        if (!config.isValid()) {
+            lastError = "Invalid simulation configuration";
+            return nullptr;
+        }
+        return new GolSimulation(config);
+    } catch (const std::exception& e) {
+        lastError = e.what();
+        return nullptr;
+    }
+}
+
+void gol_destroy(GolSimulation* simulation) {
+    delete simulation;
+}
+
+GolResult gol_step(GolSimulation* simulation, uint32_t steps) {
+    return guarded(simulation, [&] {
+        std::scoped_lock lock(simulation->mutex);
+        auto& engine = *simulation->engine;
+        if (exceedsMemoryLimit(engine)) {
+            return fail(GOL_ERROR_MEMORY_LIMIT, "Simulation is over its memory limit");
+        }
+        const std::uint64_t startGeneration = engine.getGenerationCount();
+        const std::uint64_t taken = engine.advance(steps);
+        // A settled board stops advance() early; the generation still moves on
+        skipSettledSteps(engine, startGeneration, taken, steps);
+        if (steps > 0) {
+            if (steps == 1) {
+                simulation->stepBase = simulation->version;
+            }
+            ++simulation->version;
+        }
+        return GOL_OK;
+    });
+}
+
+GolResult gol_reset(GolSimulation* simulation) {
+    return guarded(simulation, [&] {
+        std::scoped_lock lock(simulation->mutex);
+        simulation->engine->reset();
+        ++simulation->version;
+        return GOL_OK;
+    });
+}
+
+GolResult gol_set_cells(GolSimulation* simulation, const GolCell* cells, uint32_t count, int alive) {
+    if (count > 0 && !cells) {
+        return fail(GOL_ERROR_INVALID_ARGUMENT, "Cell buffer is null");
+    }
+    return guarded(simulation, [&] {
+        std::scoped_lock lock(simulation->mutex);
+        auto& engine = *simulation->engine;
+        if (alive) {
+            std::vector<Position> positions;
+            positions.reserve(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                positions.emplace_back(cells[i].x, cells[i].y);
+            }
+            engine.setCellsAlive(positions);
+        } else {
+            for (uint32_t i = 0; i < count; ++i) {
+                engine.setCellDead(cells[i].x, cells[i].y);
+            }
+        }
+        ++simulation->version;
+        return GOL_OK;
+    });
+}
+
+int gol_is_cell_alive(GolSimulation* simulation, int32_t x, int32_t y) {
+    if (!simulation) {
+        return 0;
+    }
+    std::scoped_lock lock(simulation->mutex);
+    return simulation->engine->isCellAlive(x, y) ? 1 : 0;
+}
+
+uint64_t gol_get_generation(GolSimulation* simulation) {
+    if (!simulation) {
+        return 0;
+    }
+    std::scoped_lock lock(simulation->mutex);
+    return simulation->engine->getGenerationCount();
+}
+
+uint64_t gol_get_cell_count(GolSimulation* simulation) {
+    if (!simulation) {
+        return 0;
+    }
+    std::scoped_lock lock(simulation->mutex);
+    return simulation->engine->getLivingCellCount();
+}
+
+GolResult gol_set_bitmap_enabled(GolSimulation* simulation, int enabled) {
+    return guarded(simulation, [&] {
+        std::scoped_lock lock(simulation->mutex);
+        if (simulation->bitmapEnabled != (enabled != 0)) {
+            simulation->bitmapEnabled = enabled != 0;
+            ++simulation->version;
+        }
+        return GOL_OK;
+    });
+}
+
+const GolFrame* gol_acquire_frame(GolSimulation* simulation) {
+    const GolFrame* frame = nullptr;
+    const GolResult result = guarded(simulation, [&] {
+        std::scoped_lock lock(simulation->mutex);
+        Frame& current = simulation->currentFrame();
+        ++current.pins;
+        frame = &current;
+        return GOL_OK;
+    });
+    return result == GOL_OK ? frame : nullptr;
+}
+
+void gol_release_frame(GolSimulation* simulation, const GolFrame* frame) {
+    if (!simulation || !frame) {
+        return;
+    }
+    std::scoped_lock lock(simulation->mutex);
+    auto* released = const_cast<Frame*>(static_cast<const Frame*>(frame));
+    if (released->pins > 0) {
+        --released->pins;
+    }
+}
+
+} // extern "C"
@@ -84,6 +84,8 @@ void ConsoleInput::initializeKeyMap() {
     // Step controls
     keyMap_['>'] = InputEvent::Step;     // Right arrow alternative
     keyMap_['.'] = InputEvent::Step;     // Period key (easier to type)
+    keyMap_['<'] = InputEvent::StepBack; // Back through the step history
+    keyMap_[','] = InputEvent::StepBack;
     
     // Arrow keys 
     keyMap_[72] = InputEvent::MoveUp;    // Up arrow (Windows)
@@ -1,8 +1,10 @@
 #include "console/ConsoleRenderer.h"
+#include "core/Trace.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <string_view>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -13,15 +15,28 @@
 #include <termios.h>
 #endif
 
+namespace {
+
+// Overview shading, sparsest first; blocks half alive or more get the last
+constexpr std::string_view kDensityRamp = ".:-=+*#%@";
+
+} // namespace
+
 ConsoleRenderer::ConsoleRenderer(const RenderConfig& config) 
     : config_(config) {
+#ifdef _WIN32
+    // Frames are drawn with ANSI cursor sequences
+    HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(output, &mode)) {
+        SetConsoleMode(output, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+#endif
 }
 
 void ConsoleRenderer::render(const SimulationController& controller) {
-    if (config_.clearScreen) {
-        clearScreen();
-    }
-    
+    GOL_TRACE_SCOPE("ConsoleRenderer::render");
+    frameLines_ = 0;
     renderGrid(controller);
     
     if (config_.showStats) {
@@ -32,39 +47,127 @@ void ConsoleRenderer::render(const SimulationController& controller) {
         renderControls();
     }
     
-    std::cout.flush();
+    presentFrame();
 }
 
 void ConsoleRenderer::renderFrame(const SimulationController& controller,
                                  std::int32_t startX, std::int32_t startY,
                                  std::int32_t width, std::int32_t height) {
+    frameLines_ = 0;
+    rasterize(controller, startX, startY, width, height);
+    presentFrame();
+}
+
+void ConsoleRenderer::rasterize(const SimulationController& controller,
+                                std::int32_t startX, std::int32_t startY,
+                                std::int32_t width, std::int32_t height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    
+    // One bulk query for the whole viewport instead of a lookup per character
+    if (config_.scaleLog2 == 0) {
+        controller.getLivingCellsInRegion(startX, startX + width - 1, startY, startY + height - 1, viewportCells_);
+    }
     
-    // Render border if enabled
     if (config_.showBorder) {
-        renderBorder(width + 2, height + 2);
-        moveCursor(1, 1);
+        renderBorder(width + 2);
     }
     
-    // Render grid content
+    const std::size_t firstRow = frameLines_;
+    const std::size_t margin = config_.showBorder ? 1 : 0;
     for (std::int32_t y = 0; y < height; ++y) {
-        for (std::int32_t x = 0; x < width; ++x) {
-            std::int32_t worldX = startX + x;
-            std::int32_t worldY = startY + y;
-            
-            bool alive = controller.isCellAlive(worldX, worldY);
-            char cellChar = alive ? config_.aliveChar : config_.deadChar;
-            std::cout << cellChar;
+        std::string& line = nextLine();
+        line.assign(static_cast<std::size_t>(width) + 2 * margin, config_.deadChar);
+        if (config_.showBorder) {
+            line.front() = config_.borderChar;
+            line.back() = config_.borderChar;
         }
-        
-        if (y < height - 1) {
-            std::cout << '\n';
-            if (config_.showBorder) {
-                std::cout << config_.borderChar;
+    }
+    
+    if (config_.scaleLog2 > 0) {
+        shadeOverview(controller.getPopulationPyramid(), startX, startY, firstRow, margin, width, height);
+    } else {
+        for (const auto& pos : viewportCells_) {
+            auto row = static_cast<std::size_t>(pos.y - startY);
+            auto col = static_cast<std::size_t>(pos.x - startX);
+            frame_[firstRow + row][margin + col] = config_.aliveChar;
+        }
+    }
+    
+    if (config_.showBorder) {
+        renderBorder(width + 2);
+    }
+}
+
+void ConsoleRenderer::shadeOverview(const PopulationPyramid& population, std::int32_t startX, std::int32_t startY,
+                                    std::size_t firstRow, std::size_t margin,
+                                    std::int32_t width, std::int32_t height) {
+    GOL_TRACE_SCOPE("ConsoleRenderer::shadeOverview");
+    const std::uint32_t scale = config_.scaleLog2;
+    const std::uint64_t blockArea = std::uint64_t{1} << (2 * scale);
+    const std::int32_t firstBlockX = startX >> scale;
+    const std::int32_t firstBlockY = startY >> scale;
+    
+    for (std::int32_t row = 0; row < height; ++row) {
+        std::string& line = frame_[firstRow + static_cast<std::size_t>(row)];
+        for (std::int32_t col = 0; col < width; ++col) {
+            const std::uint64_t count = population.countBlock(scale, firstBlockX + col, firstBlockY + row);
+            if (count > 0) {
+                const std::uint64_t shade = std::min<std::uint64_t>(kDensityRamp.size() - 1,
+                                                                    count * 2 * kDensityRamp.size() / blockArea);
+                line[margin + static_cast<std::size_t>(col)] = kDensityRamp[shade];
             }
         }
     }
 }
 
+std::string& ConsoleRenderer::nextLine() {
+    // Line strings are reused from frame to frame, keeping their capacity
+    if (frameLines_ == frame_.size()) {
+        frame_.emplace_back();
+    }
+    std::string& line = frame_[frameLines_++];
+    line.clear();
+    return line;
+}
+
+void ConsoleRenderer::presentFrame() {
+    output_.clear();
+    
+    // Nothing of ours is on screen yet, so everything is redrawn
+    if (shownLines_ == 0 && config_.clearScreen) {
+        output_ += "\033[2J";
+    }
+    
+    for (std::size_t row = 0; row < frameLines_; ++row) {
+        if (row < shownLines_ && frame_[row] == shownFrame_[row]) {
+            continue;
+        }
+        // Move to the start of the line, write it, and erase what is left of the old one
+        output_ += "\033[";
+        output_ += std::to_string(row + 1);
+        output_ += ";1H";
+        output_ += frame_[row];
+        output_ += "\033[K";
+    }
+    
+    // Erase lines left over from a taller frame
+    for (std::size_t row = frameLines_; row < shownLines_; ++row) {
+        output_ += "\033[";
+        output_ += std::to_string(row + 1);
+        output_ += ";1H\033[K";
+    }
+    
+    if (!output_.empty()) {
+        std::cout.write(output_.data(), static_cast<std::streamsize>(output_.size()));
+        std::cout.flush();
+    }
+    
+    std::swap(frame_, shownFrame_);
+    shownLines_ = frameLines_;
+}
+
 void ConsoleRenderer::setViewport(std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height) {
     config_.viewportX = x;
     config_.viewportY = y;
@@ -73,21 +176,38 @@ void ConsoleRenderer::setViewport(std::int32_t x, std::int32_t y, std::int32_t w
 }
 
 void ConsoleRenderer::centerViewport(std::int32_t centerX, std::int32_t centerY) {
-    config_.viewportX = centerX - config_.viewportWidth / 2;
-    config_.viewportY = centerY - config_.viewportHeight / 2;
+    config_.viewportX = static_cast<std::int32_t>(centerX - (std::int64_t{config_.viewportWidth} << config_.scaleLog2) / 2);
+    config_.viewportY = static_cast<std::int32_t>(centerY - (std::int64_t{config_.viewportHeight} << config_.scaleLog2) / 2);
 }
 
 void ConsoleRenderer::moveViewport(std::int32_t deltaX, std::int32_t deltaY) {
-    config_.viewportX += deltaX;
-    config_.viewportY += deltaY;
+    config_.viewportX += static_cast<std::int32_t>(std::int64_t{deltaX} << config_.scaleLog2);
+    config_.viewportY += static_cast<std::int32_t>(std::int64_t{deltaY} << config_.scaleLog2);
+}
+
+void ConsoleRenderer::zoomIn() {
+    if (config_.scaleLog2 > 0) {
+        setScale(config_.scaleLog2 - 1);
+    }
+}
+
+void ConsoleRenderer::zoomOut() {
+    if (config_.scaleLog2 < PopulationPyramid::kMaxScaleLog2) {
+        setScale(config_.scaleLog2 + 1);
+    }
+}
+
+void ConsoleRenderer::setScale(std::uint32_t scaleLog2) {
+    // The viewport corner is in cells; keep the cell under the center where it is
+    const std::int64_t centerX = config_.viewportX + (std::int64_t{config_.viewportWidth} << config_.scaleLog2) / 2;
+    const std::int64_t centerY = config_.viewportY + (std::int64_t{config_.viewportHeight} << config_.scaleLog2) / 2;
+    config_.scaleLog2 = scaleLog2;
+    centerViewport(static_cast<std::int32_t>(centerX), static_cast<std::int32_t>(centerY));
 }
 
 void ConsoleRenderer::clearScreen() {
-#ifdef _WIN32
-    system("cls");
-#else
-    system("clear");
-#endif
+    std::cout << "\033[2J\033[H" << std::flush;
+    shownLines_ = 0;
 }
 
 void ConsoleRenderer::moveCursor(std::int32_t x, std::int32_t y) {
@@ -122,28 +242,27 @@ void ConsoleRenderer::renderGrid(const SimulationController& controller) {
     if (config_.showStats) gridHeight -= 3;
     if (config_.showControls) gridHeight -= 3;
     
-    renderFrame(controller, 
-               config_.viewportX, config_.viewportY,
-               config_.viewportWidth, gridHeight);
+    rasterize(controller, 
+              config_.viewportX, config_.viewportY,
+              config_.viewportWidth, gridHeight);
 }
 
 void ConsoleRenderer::renderStats(const SimulationStats& stats) {
-    std::cout << "\n" << repeatChar('=', config_.viewportWidth) << "\n";
-    std::cout << formatStats(stats) << "\n";
+    nextLine().assign(static_cast<std::size_t>(config_.viewportWidth), '=');
+    std::string& line = nextLine();
+    line = formatStats(stats);
+    if (config_.scaleLog2 > 0) {
+        line += " | Scale: 1:" + std::to_string(std::uint64_t{1} << config_.scaleLog2);
+    }
 }
 
 void ConsoleRenderer::renderControls() {
-    std::cout << repeatChar('-', config_.viewportWidth) << "\n";
-    std::cout << "Controls: [SPACE] Start/Pause | [>/.] Step | [R] Reset | [Q] Quit | [W/A/S/D] Move viewport | [L] Load Pattern\n";
+    nextLine().assign(static_cast<std::size_t>(config_.viewportWidth), '-');
+    nextLine() = "Controls: [SPACE] Start/Pause | [>/.] Step | [</,] Step Back | [R] Reset | [Q] Quit | [W/A/S/D] Move viewport | [+/-] Zoom | [L] Load Pattern";
 }
 
-void ConsoleRenderer::renderBorder(std::int32_t width, std::int32_t height) {
-    // Top border
-    std::cout << repeatChar(config_.borderChar, width) << "\n";
-    
-    // Side borders will be rendered by renderFrame
-    
-    // Bottom border will be rendered after grid content
+void ConsoleRenderer::renderBorder(std::int32_t width) {
+    nextLine().assign(static_cast<std::size_t>(width), config_.borderChar);
 }
 
 std::string ConsoleRenderer::formatStats(const SimulationStats& stats) {
@@ -151,11 +270,18 @@ std::string ConsoleRenderer::formatStats(const SimulationStats& stats) {
     oss << "Gen: " << std::setw(6) << stats.generation
         << " | Cells: " << std::setw(6) << stats.livingCells
         << " | FPS: " << std::fixed << std::setprecision(1) << stats.actualFps
-        << " | Step: " << stats.lastStepTime.count() << "ms";
+        << " | Step: " << stats.lastStepTime.count() << "ms"
+        << " | Mem: " << stats.memoryBytes / 1024 << "KB";
     
+    if (stats.frameGenerations > 1) {
+        oss << " | Gens/frame: " << stats.frameGenerations;
+    }
     if (stats.isStable) {
         oss << " | STABLE";
     }
+    if (stats.memoryLimitReached) {
+        oss << " | MEMORY LIMIT";
+    }
     
     return oss.str();
 }
@@ -1,19 +1,52 @@
 #include "console/SimulationController.h"
-#include <nlohmann/json.hpp>
-#include <fstream>
+#include "core/SnapshotFile.h"
+#include "core/PatternLibrary.h"
+#include "core/Trace.h"
+#include <iterator>
 #include <algorithm>
+#include <limits>
 #include <thread>
 
-using json = nlohmann::json;
+namespace {
+
+SnapshotInfo snapshotInfo(const GameConfig& config, std::uint64_t generation) {
+    SnapshotInfo info;
+    info.generation = generation;
+    info.gridWidth = static_cast<std::uint32_t>(config.getGridWidth());
+    info.gridHeight = static_cast<std::uint32_t>(config.getGridHeight());
+    info.wrapEdges = config.getWrapEdges();
+    return info;
+}
+
+std::size_t historyBudgetBytes(const GameConfig& config) {
+    return static_cast<std::size_t>(std::max(config.getHistoryBudgetMb(), 0)) << 20;
+}
+
+// Where the engine keeps a cell: wrapped grids fold coordinates onto the
+// grid, and the unbounded planes keep them as they are
+Position storedPosition(const GameConfig& config, std::int32_t x, std::int32_t y) {
+    const StorageEngine engine = config.getStorageEngine();
+    if (!config.getWrapEdges() || engine == StorageEngine::HashLife || engine == StorageEngine::Chunked) {
+        return {x, y};
+    }
+    const std::int64_t width = config.getGridWidth();
+    const std::int64_t height = config.getGridHeight();
+    return {static_cast<std::int32_t>(((x % width) + width) % width),
+            static_cast<std::int32_t>(((y % height) + height) % height)};
+}
+
+} // namespace
 
 SimulationController::SimulationController(const GameConfig& config) 
-    : simulation_(std::make_unique<GameOfLifeSimulation>(config)) {
+    : simulation_(createLifeEngine(config))
+    , history_(historyBudgetBytes(config)) {
     
     setTargetFps(config.getTargetFps());
     lastUpdate_ = std::chrono::steady_clock::now();
     lastFpsCalculation_ = lastUpdate_;
     
-    populationHistory_.reserve(stableDetectionWindow_);
+    restartHistory();
+    rebuildPopulation();
     updateStats();
 }
 
@@ -38,11 +71,26 @@ void SimulationController::stop() {
 }
 
 void SimulationController::step() {
+    GOL_TRACE_SCOPE("SimulationController::step");
+    if (exceedsMemoryLimit(*simulation_)) {
+        stats_.memoryLimitReached = true;
+        if (state_ == SimulationState::Running) {
+            pause();
+        }
+        return;
+    }
     auto stepStart = std::chrono::steady_clock::now();
     
+    adaptStorage();
+    rebuildCycleDetector();
     bool hasChanges = simulation_->step();
+    updateChanges();
+    recordHistory(simulation_->getBornCells(), simulation_->getDiedCells());
+    population_.apply(simulation_->getBornCells(), simulation_->getDiedCells());
+    checkpointIfDue();
     updateStats();
     checkStability();
+    metrics_.recordChanges(lastChanges_.born.size(), lastChanges_.died.size());
     
     // Auto-pause if no changes occurred (simulation is static)
     if (!hasChanges && state_ == SimulationState::Running) {
@@ -51,6 +99,7 @@ void SimulationController::step() {
     
     auto stepEnd = std::chrono::steady_clock::now();
     stats_.lastStepTime = std::chrono::duration_cast<std::chrono::milliseconds>(stepEnd - stepStart);
+    metrics_.stepNanos.record(stepEnd - stepStart);
     
     if (stepCallback_) {
         stepCallback_(stats_);
@@ -61,84 +110,272 @@ void SimulationController::step() {
     lastUpdate_ = stepEnd;
 }
 
+void SimulationController::step(std::uint64_t generations) {
+    if (generations <= 1) {
+        if (generations == 1) {
+            step();
+        }
+        return;
+    }
+    GOL_TRACE_SCOPE("SimulationController::stepGenerations");
+    if (exceedsMemoryLimit(*simulation_)) {
+        stats_.memoryLimitReached = true;
+        if (state_ == SimulationState::Running) {
+            pause();
+        }
+        return;
+    }
+    auto stepStart = std::chrono::steady_clock::now();
+    
+    adaptStorage();
+    
+    // The engine's changes only cover its last step, so compare whole boards
+    auto before = simulation_->getLivingPositions();
+    std::sort(before.begin(), before.end());
+    const std::uint64_t startGeneration = simulation_->getGenerationCount();
+    const std::uint64_t taken = simulation_->advance(generations);
+    const bool settled = taken < generations;
+    // A settled board stops advance() early; the generation still moves on
+    skipSettledSteps(*simulation_, startGeneration, taken, generations);
+    auto after = simulation_->getLivingPositions();
+    std::sort(after.begin(), after.end());
+    
+    lastChanges_.generation = simulation_->getGenerationCount();
+    lastChanges_.born.clear();
+    lastChanges_.died.clear();
+    std::vector<Position> born;
+    std::vector<Position> died;
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(born));
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(died));
+    for (const auto& pos : born) {
+        lastChanges_.born.emplace_back(pos.x, pos.y);
+    }
+    for (const auto& pos : died) {
+        lastChanges_.died.emplace_back(pos.x, pos.y);
+    }
+    recordHistory(born, died);
+    population_.apply(born, died);
+    checkpointIfDue();
+    
+    // The detector never saw the generations in between
+    cycleDetectorStale_ = true;
+    updateStats();
+    stats_.isStable = settled;
+    stats_.cyclePeriod = settled ? 1 : 0;
+    stats_.cycleDx = 0;
+    stats_.cycleDy = 0;
+    metrics_.recordChanges(lastChanges_.born.size(), lastChanges_.died.size());
+    
+    if (settled && state_ == SimulationState::Running) {
+        pause();
+    }
+    
+    auto stepEnd = std::chrono::steady_clock::now();
+    stats_.lastStepTime = std::chrono::duration_cast<std::chrono::milliseconds>(stepEnd - stepStart);
+    metrics_.stepNanos.record((stepEnd - stepStart) / generations);
+    
+    if (stepCallback_) {
+        stepCallback_(stats_);
+    }
+    
+    ++frameCount_;
+    lastUpdate_ = stepEnd;
+}
+
+std::uint64_t SimulationController::stepFrame() {
+    GOL_TRACE_SCOPE("SimulationController::stepFrame");
+    const auto& config = simulation_->getConfig();
+    const auto batch = static_cast<std::uint64_t>(std::max(config.getGenerationsPerFrame(), 1));
+    const std::chrono::nanoseconds budget = std::chrono::milliseconds(std::max(config.getFrameStepBudgetMs(), 0));
+    const SimulationState entryState = state_;
+    const std::uint64_t startGeneration = simulation_->getGenerationCount();
+    const std::uint64_t startFrames = frameCount_;
+    
+    const auto frameStart = std::chrono::steady_clock::now();
+    auto batchStart = frameStart;
+    while (true) {
+        step(batch);
+        const auto now = std::chrono::steady_clock::now();
+        if (budget.count() == 0 || (now - frameStart) + (now - batchStart) > budget || state_ != entryState ||
+            stats_.memoryLimitReached) {
+            break;
+        }
+        batchStart = now;
+    }
+    
+    // One frame however many batches it took, timed from its start so the
+    // budget comes out of the frame time rather than adding to it
+    frameCount_ = startFrames + 1;
+    lastUpdate_ = frameStart;
+    stats_.frameGenerations = simulation_->getGenerationCount() - startGeneration;
+    return stats_.frameGenerations;
+}
+
 void SimulationController::reset() {
     simulation_->reset();
     stats_ = SimulationStats{};
-    populationHistory_.clear();
+    lastChanges_.generation = 0;
+    lastChanges_.born.clear();
+    lastChanges_.died.clear();
+    cycleDetectorStale_ = true;
     frameCount_ = 0;
     
     // Restore default pattern if one is set
-    for (const auto& [x, y] : defaultPattern_) {
-        simulation_->setCellAlive(x, y);
-    }
+    simulation_->setCellsAlive(defaultPattern_);
     
+    lastCheckpointGeneration_ = simulation_->getGenerationCount();
+    restartHistory();
+    rebuildPopulation();
     updateStats();
 }
 
 void SimulationController::setConfig(const GameConfig& config) {
     simulation_->setConfig(config);
     setTargetFps(config.getTargetFps());
-    stableDetectionWindow_ = config.getStableDetectionCycles();
+    history_.setByteBudget(historyBudgetBytes(config));
     reset();
 }
 
-void SimulationController::loadPattern(const std::string& patternFile) {
-    std::ifstream file(patternFile);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open pattern file: " + patternFile);
-    }
+void SimulationController::switchEngine(const GameConfig& config) {
+    setEngine(createLifeEngine(config));
+}
+
+void SimulationController::setEngine(std::unique_ptr<LifeEngine> engine) {
+    auto cells = simulation_->getLivingPositions();
+    engine->reset();
+    engine->setCellsAlive(cells);
+    engine->setGenerationCount(simulation_->getGenerationCount());
+    simulation_ = std::move(engine);
+    
+    // The last step's changes belong to the old engine
+    setTargetFps(simulation_->getConfig().getTargetFps());
+    lastChanges_.born.clear();
+    lastChanges_.died.clear();
+    cycleDetectorStale_ = true;
     
-    json patternJson;
-    file >> patternJson;
-    file.close();
+    // The history still holds unless cells fell off the new grid
+    history_.setByteBudget(historyBudgetBytes(simulation_->getConfig()));
+    if (simulation_->getLivingCellCount() != cells.size()) {
+        restartHistory();
+        rebuildPopulation();
+    }
+    updateStats();
+}
+
+void SimulationController::loadPattern(const std::string& patternFile) {
+    // Parsed once per version of the file, process-wide; loading copies the cells
+    const auto cells = PatternCache::instance().load(patternFile, simulation_->getConfig().getRule());
     
     // Reset simulation before loading pattern
     reset();
     
-    // Load pattern data
-    if (patternJson.contains("cells")) {
-        for (const auto& cell : patternJson["cells"]) {
-            if (cell.contains("x") && cell.contains("y")) {
-                std::int32_t x = cell["x"];
-                std::int32_t y = cell["y"];
-                simulation_->setCellAlive(x, y);
-            }
-        }
-    }
-    
+    simulation_->setCellsAlive(*cells);
+    restartHistory();
+    rebuildPopulation();
     updateStats();
 }
 
 void SimulationController::setDefaultPattern(const std::string& patternFile) {
-    std::ifstream file(patternFile);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open default pattern file: " + patternFile);
-    }
+    defaultPattern_ = *PatternCache::instance().load(patternFile, simulation_->getConfig().getRule());
+}
+
+void SimulationController::saveSnapshot(const std::string& path) const {
+    const auto info = snapshotInfo(simulation_->getConfig(), simulation_->getGenerationCount());
+    auto cells = simulation_->getLivingPositions();
+    writeSnapshotFile(path, info, cells);
+}
+
+void SimulationController::checkpoint(const std::string& path) {
+    GOL_TRACE_SCOPE("SimulationController::checkpoint");
+    const auto info = snapshotInfo(simulation_->getConfig(), simulation_->getGenerationCount());
     
-    json patternJson;
-    file >> patternJson;
-    file.close();
+    // The engines keep no immutable board to share, so the freeze is one
+    // copy of the living cells; sorting, encoding and the disk stay off this thread
+    checkpointWriter_.submit(path, info, [cells = simulation_->getLivingPositions()](std::vector<Position>& out) mutable {
+        out = std::move(cells);
+    });
+    lastCheckpointGeneration_ = info.generation;
+}
+
+void SimulationController::waitForCheckpoints() {
+    checkpointWriter_.waitIdle();
+}
+
+void SimulationController::loadSnapshot(const std::string& path) {
+    SnapshotReader reader(path);
+    const SnapshotInfo& info = reader.getInfo();
     
-    // Clear existing default pattern
-    defaultPattern_.clear();
+    constexpr auto kMaxExtent = static_cast<std::uint32_t>(std::numeric_limits<std::int32_t>::max());
+    if (info.gridWidth == 0 || info.gridHeight == 0 || info.gridWidth > kMaxExtent || info.gridHeight > kMaxExtent) {
+        throw std::runtime_error("Snapshot holds an unsupported grid: " + path);
+    }
     
-    // Store pattern data
-    if (patternJson.contains("cells")) {
-        for (const auto& cell : patternJson["cells"]) {
-            if (cell.contains("x") && cell.contains("y")) {
-                std::int32_t x = cell["x"];
-                std::int32_t y = cell["y"];
-                defaultPattern_.emplace_back(x, y);
-            }
+    // Decode before touching the simulation so a corrupt file leaves it as it was
+    const std::int64_t offsetX = -std::int64_t{info.gridMinX};
+    const std::int64_t offsetY = -std::int64_t{info.gridMinY};
+    std::vector<Position> cells;
+    cells.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(info.cellCount, std::uint64_t{1} << 24)));
+    reader.readRuns([&](std::int32_t x, std::int32_t y, std::uint32_t length) {
+        for (std::uint32_t i = 0; i < length; ++i) {
+            cells.emplace_back(static_cast<std::int32_t>(x + offsetX + i), static_cast<std::int32_t>(y + offsetY));
         }
-    }
+    });
+    
+    GameConfig config = simulation_->getConfig();
+    config.setGridWidth(static_cast<std::int32_t>(info.gridWidth));
+    config.setGridHeight(static_cast<std::int32_t>(info.gridHeight));
+    config.setWrapEdges(info.wrapEdges);
+    
+    defaultPattern_ = std::move(cells);
+    simulation_->setConfig(config);
+    reset();
+    simulation_->setGenerationCount(info.generation);
+    lastChanges_.generation = info.generation;
+    lastCheckpointGeneration_ = info.generation;
+    restartHistory();
+    updateStats();
 }
 
 void SimulationController::setCellAlive(std::int32_t x, std::int32_t y) {
+    const bool wasAlive = simulation_->isCellAlive(x, y);
     simulation_->setCellAlive(x, y);
+    if (!wasAlive && simulation_->isCellAlive(x, y)) {
+        const Position flip = storedPosition(simulation_->getConfig(), x, y);
+        history_.recordEdit(std::span<const Position>(&flip, 1));
+        population_.add(flip);
+    }
+    cycleDetectorStale_ = true;
     updateStats();
 }
 
+bool SimulationController::stepBack() {
+    const auto move = history_.stepBack();
+    if (!move) {
+        return false;
+    }
+    if (state_ == SimulationState::Running) {
+        pause();
+    }
+    applyHistoryMove(*move);
+    return true;
+}
+
+std::uint64_t SimulationController::seek(std::uint64_t generation) {
+    if (state_ == SimulationState::Running) {
+        pause();
+    }
+    if (const auto move = history_.seek(generation)) {
+        applyHistoryMove(*move);
+    }
+    
+    // Only past the newest step is there anything left to simulate
+    const std::uint64_t current = simulation_->getGenerationCount();
+    if (generation > current && !history_.isRewound()) {
+        step(generation - current);
+    }
+    return simulation_->getGenerationCount();
+}
+
 void SimulationController::runHeadless(std::uint64_t maxGenerations) {
     start();
     
@@ -157,15 +394,78 @@ void SimulationController::runHeadless(std::uint64_t maxGenerations) {
                 pause();
                 break;
             }
+        } else {
+            // Small sleep to prevent busy waiting until the next frame is due
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
-        
-        // Small sleep to prevent busy waiting
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
     
     stop();
 }
 
+HeadlessRunResult SimulationController::runHeadlessBatch(std::uint64_t generations, std::uint64_t sampleInterval) {
+    HeadlessRunResult result;
+    const bool stopWhenStable = simulation_->getConfig().getAutoPauseOnStable();
+    sampleInterval = std::max<std::uint64_t>(sampleInterval, 1);
+    
+    rebuildCycleDetector();
+    
+    const auto runStart = std::chrono::steady_clock::now();
+    auto sampleStart = runStart;
+    std::uint64_t sampleGenerations = 0;
+    
+    while (result.generations < generations) {
+        if (exceedsMemoryLimit(*simulation_)) {
+            stats_.memoryLimitReached = true;
+            result.stoppedEarly = true;
+            break;
+        }
+        const auto stepStart = std::chrono::steady_clock::now();
+        adaptStorage();
+        bool hasChanges = simulation_->step();
+        metrics_.stepNanos.record(std::chrono::steady_clock::now() - stepStart);
+        metrics_.recordChanges(simulation_->getBornCells().size(), simulation_->getDiedCells().size());
+        ++result.generations;
+        ++sampleGenerations;
+        checkpointIfDue();
+        
+        stats_.livingCells = simulation_->getLivingCellCount();
+        metrics_.livingCells.store(stats_.livingCells, std::memory_order_relaxed);
+        checkStability();
+        
+        bool finished = !hasChanges || stats_.livingCells == 0 || (stats_.isStable && stopWhenStable);
+        if (finished || sampleGenerations == sampleInterval || result.generations == generations) {
+            auto now = std::chrono::steady_clock::now();
+            auto sampleTime = std::chrono::duration<double>(now - sampleStart).count();
+            
+            updateChanges();
+            updateStats();
+            stats_.actualFps = sampleTime > 0.0 ? static_cast<double>(sampleGenerations) / sampleTime : 0.0;
+            stats_.lastStepTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                (now - sampleStart) / sampleGenerations);
+            
+            if (stepCallback_) {
+                stepCallback_(stats_);
+            }
+            
+            sampleStart = now;
+            sampleGenerations = 0;
+        }
+        
+        if (finished) {
+            result.stoppedEarly = result.generations < generations;
+            break;
+        }
+    }
+    
+    restartHistory();
+    rebuildPopulation();
+    result.elapsed = std::chrono::steady_clock::now() - runStart;
+    auto seconds = std::chrono::duration<double>(result.elapsed).count();
+    result.generationsPerSecond = seconds > 0.0 ? static_cast<double>(result.generations) / seconds : 0.0;
+    return result;
+}
+
 void SimulationController::setStepCallback(std::function<void(const SimulationStats&)> callback) {
     stepCallback_ = std::move(callback);
 }
@@ -179,24 +479,26 @@ std::size_t SimulationController::getLivingCellCount() const {
 }
 
 std::vector<std::pair<std::int32_t, std::int32_t>> SimulationController::getLivingCells() const {
+    const auto start = std::chrono::steady_clock::now();
     std::vector<std::pair<std::int32_t, std::int32_t>> cells;
     cells.reserve(simulation_->getLivingCellCount());
     
-    const auto& registry = simulation_->getRegistry();
-    auto view = registry.view<Position, Cell>();
-    
-    for (auto entity : view) {
-        const auto& pos = view.get<Position>(entity);
-        const auto& cell = view.get<Cell>(entity);
-        
-        if (cell.alive) {
-            cells.emplace_back(pos.x, pos.y);
-        }
+    for (const auto& pos : simulation_->getLivingPositions()) {
+        cells.emplace_back(pos.x, pos.y);
     }
     
+    metrics_.queryNanos.record(std::chrono::steady_clock::now() - start);
     return cells;
 }
 
+void SimulationController::getLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY,
+                                                  std::int32_t maxY, std::vector<Position>& out) const {
+    const auto start = std::chrono::steady_clock::now();
+    out.clear();
+    simulation_->collectLivingCellsInRegion(minX, maxX, minY, maxY, out);
+    metrics_.queryNanos.record(std::chrono::steady_clock::now() - start);
+}
+
 void SimulationController::setTargetFps(std::int32_t fps) {
     if (fps > 0) {
         targetFrameTime_ = std::chrono::milliseconds(1000 / fps);
@@ -228,28 +530,160 @@ void SimulationController::updateTiming() {
     }
 }
 
+bool SimulationController::adaptStorage() {
+    const auto& config = simulation_->getConfig();
+    const StorageEngine engine = config.getStorageEngine();
+    if (!config.getAdaptiveStorage() || (engine != StorageEngine::Sparse && engine != StorageEngine::Dense)) {
+        return false;
+    }
+    
+    // Sparse steps cost per living cell, dense steps per grid cell
+    const double area = static_cast<double>(config.getGridWidth()) * static_cast<double>(config.getGridHeight());
+    const double density = static_cast<double>(simulation_->getLivingCellCount()) / area;
+    StorageEngine target = engine;
+    if (engine == StorageEngine::Sparse && density >= config.getDenseDensityThreshold()) {
+        target = StorageEngine::Dense;
+    } else if (engine == StorageEngine::Dense && density <= config.getSparseDensityThreshold()) {
+        target = StorageEngine::Sparse;
+    }
+    if (target == engine) {
+        return false;
+    }
+    
+    GameConfig next = config;
+    next.setStorageEngine(target);
+    
+    // Same grid, same cells, so the cycle history still holds
+    const bool stale = cycleDetectorStale_;
+    switchEngine(next);
+    cycleDetectorStale_ = stale;
+    return true;
+}
+
 void SimulationController::updateStats() {
     stats_.generation = simulation_->getGenerationCount();
     stats_.livingCells = simulation_->getLivingCellCount();
+    stats_.memoryBytes = simulation_->getMemoryUsage();
+    stats_.memoryLimitReached = exceedsMemoryLimit(*simulation_);
+    metrics_.livingCells.store(stats_.livingCells, std::memory_order_relaxed);
 }
 
-void SimulationController::checkStability() {
-    populationHistory_.push_back(stats_.livingCells);
+void SimulationController::updateChanges() {
+    // Refill the same buffers every step so a running view allocates nothing
+    lastChanges_.generation = simulation_->getGenerationCount();
+    lastChanges_.born.clear();
+    lastChanges_.died.clear();
+    for (const auto& pos : simulation_->getBornCells()) {
+        lastChanges_.born.emplace_back(pos.x, pos.y);
+    }
+    for (const auto& pos : simulation_->getDiedCells()) {
+        lastChanges_.died.emplace_back(pos.x, pos.y);
+    }
+}
+
+void SimulationController::restartHistory() {
+    if (history_.isEnabled()) {
+        history_.restart(simulation_->getGenerationCount(), simulation_->getLivingPositions());
+    }
+}
+
+void SimulationController::rebuildPopulation() {
+    population_.rebuild(simulation_->getLivingPositions());
+}
+
+void SimulationController::checkpointIfDue() {
+    const auto interval = getConfig().getCheckpointInterval();
+    if (interval <= 0 || getConfig().getCheckpointPath().empty()) {
+        return;
+    }
+    const auto every = static_cast<std::uint64_t>(interval);
+    const auto generation = simulation_->getGenerationCount();
+    if (generation / every != lastCheckpointGeneration_ / every) {
+        checkpoint(getConfig().getCheckpointPath());
+    }
+}
+
+void SimulationController::recordHistory(std::span<const Position> born, std::span<const Position> died) {
+    history_.recordStep(simulation_->getGenerationCount(), born, died);
+    if (history_.keyframeDue()) {
+        history_.recordKeyframe(simulation_->getLivingPositions());
+    }
+}
+
+void SimulationController::applyHistoryMove(const HistoryMove& move) {
+    lastChanges_.born.clear();
+    lastChanges_.died.clear();
+    if (move.fromEmpty) {
+        // A keyframe rebuilds the board; compare whole boards for the changes
+        auto before = simulation_->getLivingPositions();
+        std::sort(before.begin(), before.end());
+        simulation_->reset();
+        simulation_->setCellsAlive(move.flips);
+        population_.rebuild(move.flips);
+        std::vector<Position> changed;
+        std::set_difference(move.flips.begin(), move.flips.end(), before.begin(), before.end(),
+                            std::back_inserter(changed));
+        for (const auto& pos : changed) {
+            lastChanges_.born.emplace_back(pos.x, pos.y);
+        }
+        changed.clear();
+        std::set_difference(before.begin(), before.end(), move.flips.begin(), move.flips.end(),
+                            std::back_inserter(changed));
+        for (const auto& pos : changed) {
+            lastChanges_.died.emplace_back(pos.x, pos.y);
+        }
+    } else {
+        for (const auto& pos : move.flips) {
+            if (simulation_->isCellAlive(pos.x, pos.y)) {
+                simulation_->setCellDead(pos.x, pos.y);
+                population_.remove(pos);
+                lastChanges_.died.emplace_back(pos.x, pos.y);
+            } else {
+                simulation_->setCellAlive(pos.x, pos.y);
+                population_.add(pos);
+                lastChanges_.born.emplace_back(pos.x, pos.y);
+            }
+        }
+    }
+    simulation_->setGenerationCount(move.generation);
+    lastChanges_.generation = move.generation;
     
-    // Keep only the last N entries
-    if (populationHistory_.size() > stableDetectionWindow_) {
-        populationHistory_.erase(populationHistory_.begin());
+    // The detector's cycle ran forward in time
+    cycleDetectorStale_ = true;
+    updateStats();
+    stats_.isStable = false;
+    stats_.cyclePeriod = 0;
+    stats_.cycleDx = 0;
+    stats_.cycleDy = 0;
+}
+
+void SimulationController::rebuildCycleDetector() {
+    // The detector must hold the pre-step living cells for the births and deaths to apply
+    if (!cycleDetectorStale_) {
+        return;
     }
     
-    // Check for stability (population hasn't changed)
-    if (populationHistory_.size() >= stableDetectionWindow_) {
-        bool stable = std::all_of(populationHistory_.begin(), populationHistory_.end(),
-            [this](std::size_t pop) { return pop == populationHistory_[0]; });
-        
-        stats_.isStable = stable;
-    } else {
-        stats_.isStable = false;
+    cycleDetector_.clear();
+    for (const auto& pos : simulation_->getLivingPositions()) {
+        cycleDetector_.add(pos);
     }
+    cycleDetector_.record(simulation_->getGenerationCount());
+    cycleDetectorStale_ = false;
+}
+
+void SimulationController::checkStability() {
+    for (const auto& pos : simulation_->getBornCells()) {
+        cycleDetector_.add(pos);
+    }
+    for (const auto& pos : simulation_->getDiedCells()) {
+        cycleDetector_.remove(pos);
+    }
+    
+    auto cycle = cycleDetector_.record(simulation_->getGenerationCount());
+    stats_.isStable = cycle.has_value();
+    stats_.cyclePeriod = cycle ? cycle->period : 0;
+    stats_.cycleDx = cycle ? cycle->dx : 0;
+    stats_.cycleDy = cycle ? cycle->dy : 0;
 }
 
 void SimulationController::calculateFps() {
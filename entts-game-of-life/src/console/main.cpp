@@ -2,11 +2,97 @@
 #include "console/ConsoleRenderer.h"
 #include "console/ConsoleInput.h"
 #include "core/GameConfig.h"
+#include "core/Metrics.h"
+#include "core/SoupCensus.h"
+#include "core/Trace.h"
+#ifdef GOL_CUDA_ENGINE
+#include "core/CudaLifeEngine.h"
+#endif
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <chrono>
 
+namespace {
+
+constexpr std::chrono::seconds kMetricsInterval{5};
+constexpr const char* kPatternDirectory = "../patterns";
+constexpr std::size_t kCensusRows = 40;
+
+// Keeps path refreshed with the controller's metrics while it runs
+std::unique_ptr<MetricsFileWriter> startMetricsFile(const std::string& path, const SimulationController& controller) {
+    if (path.empty()) {
+        return nullptr;
+    }
+    const bool prometheus = MetricsFileWriter::isPrometheusPath(path);
+    return std::make_unique<MetricsFileWriter>(path, kMetricsInterval, [&controller, prometheus](std::ostream& out) {
+        const LabelledMetrics simulations[] = {{"console", &controller.getMetrics()}};
+        if (prometheus) {
+            writePrometheusMetrics(out, simulations);
+        } else {
+            out << metricsToJson(simulations).dump(2) << "\n";
+        }
+    });
+}
+
+// --gpu: keep the board on the CUDA device, carrying its cells over
+void useGpuEngine(SimulationController& controller) {
+#ifdef GOL_CUDA_ENGINE
+    controller.setEngine(std::make_unique<CudaLifeEngine>(controller.getConfig()));
+#else
+    (void)controller;
+    throw std::runtime_error("--gpu needs the CUDA engine; rebuild with -DBUILD_CUDA_ENGINE=ON");
+#endif
+}
+
+// --checkpoint, --checkpoint-every and --resume
+struct CheckpointOptions {
+    std::string file;         // Written every interval and once more at exit
+    std::int32_t interval{0}; // Generations between checkpoints, 0 = only at exit
+    std::string resumeFile;   // Snapshot to start from instead of the default pattern
+};
+
+void applyCheckpointOptions(GameConfig& config, const CheckpointOptions& options) {
+    if (!options.file.empty()) {
+        config.setCheckpointPath(options.file);
+        config.setCheckpointInterval(options.interval);
+    }
+}
+
+// Starts from the resume snapshot if there is one, else the default pattern
+void loadStartingBoard(SimulationController& controller, const CheckpointOptions& options) {
+    if (!options.resumeFile.empty()) {
+        controller.loadSnapshot(options.resumeFile);
+        std::cout << "Resumed from " << options.resumeFile << " at generation " << controller.getStats().generation << "\n";
+        return;
+    }
+    controller.setDefaultPattern("config/glider.json");
+    controller.loadPattern("config/glider.json");
+}
+
+// The last checkpoint at exit, waiting for it and any still being written
+void finishCheckpoints(SimulationController& controller) {
+    const std::string& path = controller.getConfig().getCheckpointPath();
+    if (!path.empty()) {
+        controller.checkpoint(path);
+    }
+    controller.waitForCheckpoints();
+    const auto stats = controller.getCheckpointStats();
+    if (stats.written > 0) {
+        std::cout << "Wrote " << stats.written << " checkpoints to " << path << ", the last at generation "
+                  << stats.lastGeneration << "\n";
+    }
+    if (stats.failed > 0) {
+        std::cout << stats.failed << " checkpoints failed: " << stats.lastError << "\n";
+    }
+}
+
+} // namespace
+
 class ConsoleApplication {
 public:
     ConsoleApplication() 
@@ -18,13 +104,24 @@ public:
         setupViewport();
     }
     
+    // Metrics are written there every few seconds while running (see startMetricsFile)
+    void setMetricsFile(std::string path) { metricsFile_ = std::move(path); }
+    
+    void useGpu() { useGpuEngine(controller_); }
+    
+    void setCheckpoints(const CheckpointOptions& options) {
+        GameConfig config = controller_.getConfig();
+        applyCheckpointOptions(config, options);
+        controller_.setConfig(config);
+        checkpoints_ = options;
+    }
+    
     void run() {
         std::cout << "Game of Life Console Application\n";
         std::cout << "Loading default pattern...\n";
         
         try {
-            controller_.setDefaultPattern("config/glider.json");
-            controller_.loadPattern("config/glider.json");
+            loadStartingBoard(controller_, checkpoints_);
         } catch (const std::exception& e) {
             std::cout << "Could not load default pattern: " << e.what() << "\n";
             std::cout << "Starting with empty grid.\n";
@@ -33,6 +130,7 @@ public:
         std::cout << "Press any key to begin...\n";
         input_.getChar();
         
+        auto metrics = startMetricsFile(metricsFile_, controller_);
         mainLoop();
         cleanup();
     }
@@ -43,6 +141,8 @@ private:
     ConsoleInput input_;
     bool running_{true};
     bool needsRender_{true}; // Force initial render
+    std::string metricsFile_;
+    CheckpointOptions checkpoints_;
     
     void mainLoop() {
         while (running_ && input_.getState().running) {
@@ -51,14 +151,16 @@ private:
             
             // Update simulation if running
             if (controller_.shouldUpdate()) {
-                controller_.step();
+                controller_.stepFrame();
                 controller_.updateTiming();
                 needsRender_ = true; // Mark for render after simulation step
             }
             
             // Render frame only when needed
             if (needsRender_) {
+                const auto renderStart = std::chrono::steady_clock::now();
                 renderer_.render(controller_);
+                controller_.recordRenderTime(std::chrono::steady_clock::now() - renderStart);
                 needsRender_ = false;
             }
             
@@ -102,6 +204,11 @@ private:
                 needsRender_ = true;
                 break;
                 
+            case InputEvent::StepBack:
+                controller_.stepBack(); // Pauses a running simulation
+                needsRender_ = true;
+                break;
+                
             case InputEvent::Reset:
                 controller_.reset();
                 needsRender_ = true;
@@ -119,6 +226,16 @@ private:
                 needsRender_ = true;
                 break;
                 
+            case InputEvent::ZoomIn:
+                renderer_.zoomIn();
+                needsRender_ = true;
+                break;
+                
+            case InputEvent::ZoomOut:
+                renderer_.zoomOut();
+                needsRender_ = true;
+                break;
+                
             case InputEvent::CenterView:
                 renderer_.centerViewport(0, 0);
                 needsRender_ = true;
@@ -195,6 +312,7 @@ private:
         std::cout << "Final stats:\n";
         std::cout << "Generation: " << controller_.getStats().generation << "\n";
         std::cout << "Living cells: " << controller_.getStats().livingCells << "\n";
+        finishCheckpoints(controller_);
     }
     
     GameConfig loadDefaultConfig() {
@@ -223,11 +341,164 @@ private:
     }
 };
 
-int main() {
+// Headless sweep: steps the default pattern with no display or frame timing
+// and reports throughput
+int runBatch(std::uint64_t generations, std::uint64_t sampleInterval, const std::string& metricsFile, bool gpu,
+             const CheckpointOptions& checkpoints) {
+    GameConfig config;
     try {
-        ConsoleApplication app;
-        app.run();
-        return 0;
+        config.loadFromFile("config/default.json");
+    } catch (const std::exception& e) {
+        std::cout << "Could not load config file, using defaults: " << e.what() << "\n";
+    }
+    applyCheckpointOptions(config, checkpoints);
+    
+    SimulationController controller(config);
+    if (gpu) {
+        useGpuEngine(controller);
+    }
+    try {
+        loadStartingBoard(controller, checkpoints);
+    } catch (const std::exception& e) {
+        std::cout << "Could not load default pattern: " << e.what() << "\n";
+    }
+    
+    controller.setStepCallback([](const SimulationStats& stats) {
+        std::cout << "Generation " << stats.generation << ": " << stats.livingCells << " cells, "
+                  << stats.actualFps << " gen/s\n";
+    });
+    
+    auto metrics = startMetricsFile(metricsFile, controller);
+    auto result = controller.runHeadlessBatch(generations, sampleInterval);
+    std::cout << "Stepped " << result.generations << " generations in "
+              << std::chrono::duration<double>(result.elapsed).count() << " s ("
+              << result.generationsPerSecond << " gen/s)"
+              << (result.stoppedEarly ? ", stopped early" : "") << "\n";
+    if (controller.getStats().memoryLimitReached) {
+        std::cout << "Stopped at the memory limit of " << controller.getConfig().getMemoryLimitMb() << " MB\n";
+    }
+    finishCheckpoints(controller);
+    return 0;
+}
+
+// Soup census: seeded soups run to stability on every core, with their ash
+// tallied by object
+int runCensus(std::uint64_t soups, std::uint32_t seed) {
+    GameConfig config;
+    try {
+        config.loadFromFile("config/default.json");
+    } catch (const std::exception& e) {
+        std::cout << "Could not load config file, using defaults: " << e.what() << "\n";
+    }
+    
+    ObjectCatalog catalog(config.getRule());
+    try {
+        catalog.loadPatternDirectory(kPatternDirectory);
+    } catch (const std::exception& e) {
+        std::cout << "Could not load patterns, naming the built-in objects only: " << e.what() << "\n";
+    }
+    
+    SoupCensusConfig census;
+    census.soups = soups;
+    census.seed = seed;
+    census.rule = config.getRule();
+    const auto result = runSoupCensus(census, catalog);
+    
+    const double seconds = std::chrono::duration<double>(result.elapsed).count();
+    std::cout << "Census of " << result.soups << " " << census.soupSize << "x" << census.soupSize
+              << " soups from seed " << seed << " in " << seconds << " s ("
+              << static_cast<double>(result.soups) / seconds << " soups/s, "
+              << static_cast<double>(result.boardGenerations) / seconds << " board-gen/s)\n";
+    std::cout << result.settled << " settled, " << result.diedOut << " died out, " << result.unsettled
+              << " still changing after " << census.generationLimit << " generations\n";
+    
+    std::uint64_t objects = 0;
+    for (const auto& object : result.objects) {
+        objects += object.count;
+    }
+    std::cout << objects << " objects of " << result.objects.size() << " kinds:\n";
+    for (std::size_t i = 0; i < std::min(result.objects.size(), kCensusRows); ++i) {
+        const auto& object = result.objects[i];
+        std::cout << std::setw(12) << object.count << "  ";
+        if (object.name.empty()) {
+            std::cout << "unnamed " << object.cells.size() << "-cell object " << std::hex
+                      << objectHash(object.cells) << std::dec << "\n";
+        } else {
+            std::cout << object.name << "\n";
+        }
+    }
+    if (result.objects.size() > kCensusRows) {
+        std::cout << "  ... and " << result.objects.size() - kCensusRows << " rarer kinds\n";
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        // Leading options: --trace <file> writes Chrome trace JSON at exit;
+        // --metrics <file> keeps Prometheus text (*.prom) or JSON metrics there;
+        // --gpu runs the board on the CUDA engine; --checkpoint <file> writes
+        // the board there at exit, and every --checkpoint-every <generations>;
+        // --resume <file> starts from a snapshot instead of the default pattern
+        std::string traceFile;
+        std::string metricsFile;
+        CheckpointOptions checkpoints;
+        bool gpu = false;
+        while (argc >= 2) {
+            const std::string option = argv[1];
+            if (option == "--gpu") {
+                gpu = true;
+                argv += 1;
+                argc -= 1;
+            } else if (argc >= 3 && (option == "--trace" || option == "--metrics")) {
+                (option == "--trace" ? traceFile : metricsFile) = argv[2];
+                argv += 2;
+                argc -= 2;
+            } else if (argc >= 3 && (option == "--checkpoint" || option == "--resume")) {
+                (option == "--checkpoint" ? checkpoints.file : checkpoints.resumeFile) = argv[2];
+                argv += 2;
+                argc -= 2;
+            } else if (argc >= 3 && option == "--checkpoint-every") {
+                checkpoints.interval = std::stoi(argv[2]);
+                argv += 2;
+                argc -= 2;
+            } else {
+                break;
+            }
+        }
+        if (checkpoints.interval < 0 || (checkpoints.interval > 0 && checkpoints.file.empty())) {
+            throw std::runtime_error("--checkpoint-every needs a positive interval and a --checkpoint file");
+        }
+        if (!traceFile.empty()) {
+#ifndef GOL_PROFILING_ENABLED
+            std::cout << "Tracing is compiled out; rebuild with -DENABLE_PROFILING=ON\n";
+#endif
+            Trace::setEnabled(true);
+        }
+        
+        int result = 0;
+        // --batch <generations> [sampleInterval]
+        if (argc >= 3 && std::string(argv[1]) == "--batch") {
+            result = runBatch(std::stoull(argv[2]), argc >= 4 ? std::stoull(argv[3]) : 1000, metricsFile, gpu,
+                              checkpoints);
+        } else if (argc >= 3 && std::string(argv[1]) == "--census") {
+            // --census <soups> [seed]
+            result = runCensus(std::stoull(argv[2]), argc >= 4 ? static_cast<std::uint32_t>(std::stoul(argv[3])) : 1);
+        } else {
+            ConsoleApplication app;
+            app.setMetricsFile(metricsFile);
+            app.setCheckpoints(checkpoints);
+            if (gpu) {
+                app.useGpu();
+            }
+            app.run();
+        }
+        
+        if (!traceFile.empty()) {
+            Trace::writeChromeTrace(traceFile);
+            std::cout << "Wrote trace to " << traceFile << "\n";
+        }
+        return result;
     } catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
         return 1;
@@ -0,0 +1,138 @@
+#include "core/CellEncoding.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::int32_t kTileShift = 3;
+constexpr std::int32_t kTileMask = (1 << kTileShift) - 1;
+
+// Tile rows and columns of the 32-bit plane
+constexpr std::int64_t kMinTile = std::numeric_limits<std::int32_t>::min() >> kTileShift;
+constexpr std::int64_t kMaxTile = std::numeric_limits<std::int32_t>::max() >> kTileShift;
+
+std::uint64_t zigZag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unZigZag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+void putVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(static_cast<std::uint8_t>(value | 0x80)));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(static_cast<std::uint8_t>(value)));
+}
+
+std::uint64_t getVarint(const std::uint8_t*& in, const std::uint8_t* end) {
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (in == end) {
+            throw std::runtime_error("Packed cells are truncated");
+        }
+        std::uint8_t byte = *in++;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Packed cells hold an oversized number");
+}
+
+std::int64_t checkedTile(std::int64_t previous, std::uint64_t encodedDelta) {
+    // previous is a valid tile, so the sum cannot overflow once the delta is in range
+    const std::int64_t delta = unZigZag(encodedDelta);
+    if (delta < kMinTile - kMaxTile || delta > kMaxTile - kMinTile || previous + delta < kMinTile ||
+        previous + delta > kMaxTile) {
+        throw std::runtime_error("Packed cell lies outside the 32-bit plane");
+    }
+    return previous + delta;
+}
+
+} // namespace
+
+void encodeCellFlips(std::span<const Position> born, std::span<const Position> died, std::string& out) {
+    std::vector<Position> flips;
+    flips.reserve(born.size() + died.size());
+    flips.insert(flips.end(), born.begin(), born.end());
+    flips.insert(flips.end(), died.begin(), died.end());
+    std::sort(flips.begin(), flips.end(), [](const Position& a, const Position& b) {
+        const std::int32_t rowA = a.y >> kTileShift;
+        const std::int32_t rowB = b.y >> kTileShift;
+        return rowA != rowB ? rowA < rowB : (a.x >> kTileShift) < (b.x >> kTileShift);
+    });
+
+    std::int64_t previousRow = 0;
+    std::int64_t previousColumn = 0;
+    for (std::size_t i = 0; i < flips.size();) {
+        const std::int32_t row = flips[i].y >> kTileShift;
+        const std::int32_t column = flips[i].x >> kTileShift;
+
+        std::uint8_t rows[kTileMask + 1] = {};
+        for (; i < flips.size() && (flips[i].y >> kTileShift) == row && (flips[i].x >> kTileShift) == column; ++i) {
+            rows[flips[i].y & kTileMask] ^= static_cast<std::uint8_t>(1u << (flips[i].x & kTileMask));
+        }
+
+        std::uint8_t rowMask = 0;
+        for (std::int32_t r = 0; r <= kTileMask; ++r) {
+            if (rows[r] != 0) {
+                rowMask |= static_cast<std::uint8_t>(1u << r);
+            }
+        }
+        if (rowMask == 0) {
+            continue; // Every flip in the tile cancelled out
+        }
+
+        putVarint(out, zigZag(row - previousRow));
+        putVarint(out, zigZag(column - previousColumn));
+        previousRow = row;
+        previousColumn = column;
+        out.push_back(static_cast<char>(rowMask));
+        for (std::int32_t r = 0; r <= kTileMask; ++r) {
+            if (rows[r] != 0) {
+                out.push_back(static_cast<char>(rows[r]));
+            }
+        }
+    }
+}
+
+std::vector<Position> decodeCellFlips(std::string_view data) {
+    const auto* in = reinterpret_cast<const std::uint8_t*>(data.data());
+    const auto* end = in + data.size();
+
+    std::vector<Position> flips;
+    std::int64_t row = 0;
+    std::int64_t column = 0;
+    while (in != end) {
+        row = checkedTile(row, getVarint(in, end));
+        column = checkedTile(column, getVarint(in, end));
+        if (in == end) {
+            throw std::runtime_error("Packed cells are truncated");
+        }
+        const std::uint8_t rowMask = *in++;
+        if (rowMask == 0) {
+            throw std::runtime_error("Packed cells hold an empty tile");
+        }
+
+        for (std::int32_t r = 0; r <= kTileMask; ++r) {
+            if ((rowMask & (1u << r)) == 0) {
+                continue;
+            }
+            if (in == end) {
+                throw std::runtime_error("Packed cells are truncated");
+            }
+            const std::uint8_t columns = *in++;
+            for (std::int32_t c = 0; c <= kTileMask; ++c) {
+                if ((columns & (1u << c)) != 0) {
+                    flips.emplace_back(static_cast<std::int32_t>(column * (kTileMask + 1) + c),
+                                       static_cast<std::int32_t>(row * (kTileMask + 1) + r));
+                }
+            }
+        }
+    }
+    return flips;
+}
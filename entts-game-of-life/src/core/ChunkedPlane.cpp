@@ -0,0 +1,268 @@
+#include "core/ChunkedPlane.h"
+#include "core/Trace.h"
+#include <algorithm>
+#include <bit>
+
+ChunkedPlane::ChunkedPlane(const LifeRule& rule)
+    : kernel_(selectDenseKernel())
+    , rule_(rule)
+    , conwayRule_(rule == kConwayRule) {
+}
+
+void ChunkedPlane::setCell(std::int32_t x, std::int32_t y, bool alive) {
+    const Position coord = chunkOf(x, y);
+    std::uint32_t slot;
+    auto it = index_.find(coord);
+    if (it != index_.end()) {
+        slot = it->second;
+    } else if (alive) {
+        slot = static_cast<std::uint32_t>(chunks_.size());
+        index_[coord] = slot;
+        chunks_.push_back(Chunk{coord, Rows{}});
+    } else {
+        return;
+    }
+
+    std::uint64_t& word = chunks_[slot].rows[static_cast<std::size_t>(y & 63)];
+    const std::uint64_t mask = std::uint64_t{1} << (x & 63);
+    const bool wasAlive = (word & mask) != 0;
+
+    // A chunk left empty here is dropped by the next step
+    if (alive && !wasAlive) {
+        word |= mask;
+        ++population_;
+    } else if (!alive && wasAlive) {
+        word &= ~mask;
+        --population_;
+    }
+}
+
+bool ChunkedPlane::getCell(std::int32_t x, std::int32_t y) const {
+    const Rows* rows = findRows(chunks_, index_, chunkOf(x, y));
+    return rows != nullptr && (((*rows)[static_cast<std::size_t>(y & 63)] >> (x & 63)) & 1u) != 0;
+}
+
+std::uint8_t ChunkedPlane::countNeighbors(std::int32_t x, std::int32_t y) const {
+    std::uint8_t count = 0;
+
+    for (std::int64_t dy = -1; dy <= 1; ++dy) {
+        for (std::int64_t dx = -1; dx <= 1; ++dx) {
+            const std::int64_t neighborX = x + dx;
+            const std::int64_t neighborY = y + dy;
+            if ((dx == 0 && dy == 0) || neighborX < INT32_MIN || neighborX > INT32_MAX || neighborY < INT32_MIN ||
+                neighborY > INT32_MAX) {
+                continue;
+            }
+            if (getCell(static_cast<std::int32_t>(neighborX), static_cast<std::int32_t>(neighborY))) {
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+bool ChunkedPlane::step() {
+    GOL_TRACE_SCOPE("ChunkedPlane::step");
+    candidates_.clear();
+    for (const auto& chunk : chunks_) {
+        addCandidates(chunk);
+    }
+    std::sort(candidates_.begin(), candidates_.end());
+    candidates_.erase(std::unique(candidates_.begin(), candidates_.end()), candidates_.end());
+
+    // The spare generation is overwritten; once the plane has shrunk to a
+    // quarter of what it held, let its buffers go rather than keep the peak
+    if (previous_.capacity() > 4 * candidates_.size()) {
+        previous_ = std::vector<Chunk>{};
+        previousIndex_ = CoordinateMap<std::uint32_t>{};
+    }
+    previous_.clear();
+    previousIndex_.clear();
+
+    bool changed = false;
+    std::size_t population = 0;
+    for (const Position& coord : candidates_) {
+        changed = stepChunk(coord, population) || changed;
+    }
+
+    chunks_.swap(previous_);
+    std::swap(index_, previousIndex_);
+    population_ = population;
+    return changed;
+}
+
+void ChunkedPlane::clear() {
+    chunks_.clear();
+    index_.clear();
+    previous_.clear();
+    previousIndex_.clear();
+    population_ = 0;
+}
+
+std::size_t ChunkedPlane::getMemoryUsage() const {
+    return (chunks_.capacity() + previous_.capacity()) * sizeof(Chunk) + index_.getMemoryUsage() +
+           previousIndex_.getMemoryUsage() + candidates_.capacity() * sizeof(Position);
+}
+
+void ChunkedPlane::collectLivingCells(std::vector<Position>& out) const {
+    for (const auto& chunk : chunks_) {
+        for (std::int32_t r = 0; r < kChunkSize; ++r) {
+            std::uint64_t bits = chunk.rows[static_cast<std::size_t>(r)];
+            while (bits != 0) {
+                auto bit = static_cast<std::int32_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                out.emplace_back(chunk.coord.x * kChunkSize + bit, chunk.coord.y * kChunkSize + r);
+            }
+        }
+    }
+}
+
+void ChunkedPlane::collectLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY,
+                                              std::int32_t maxY, std::vector<Position>& out) const {
+    const Position low = chunkOf(minX, minY);
+    const Position high = chunkOf(maxX, maxY);
+
+    for (const auto& chunk : chunks_) {
+        if (chunk.coord.x < low.x || chunk.coord.x > high.x || chunk.coord.y < low.y || chunk.coord.y > high.y) {
+            continue;
+        }
+
+        // Bits of the chunk's columns inside [minX, maxX]
+        const std::int32_t firstX = chunk.coord.x * kChunkSize;
+        std::uint64_t columns = ~std::uint64_t{0};
+        if (chunk.coord.x == low.x) {
+            columns &= ~std::uint64_t{0} << (minX & 63);
+        }
+        if (chunk.coord.x == high.x) {
+            columns &= ~std::uint64_t{0} >> (63 - (maxX & 63));
+        }
+
+        const std::int32_t firstRow = chunk.coord.y == low.y ? (minY & 63) : 0;
+        const std::int32_t lastRow = chunk.coord.y == high.y ? (maxY & 63) : kChunkSize - 1;
+        for (std::int32_t r = firstRow; r <= lastRow; ++r) {
+            std::uint64_t bits = chunk.rows[static_cast<std::size_t>(r)] & columns;
+            while (bits != 0) {
+                auto bit = static_cast<std::int32_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                out.emplace_back(firstX + bit, chunk.coord.y * kChunkSize + r);
+            }
+        }
+    }
+}
+
+void ChunkedPlane::collectChanges(std::vector<Position>& born, std::vector<Position>& died) const {
+    static const Rows kEmpty{};
+    auto compare = [&](Position coord, const Rows& current, const Rows& previous) {
+        for (std::int32_t r = 0; r < kChunkSize; ++r) {
+            const std::uint64_t now = current[static_cast<std::size_t>(r)];
+            std::uint64_t bits = now ^ previous[static_cast<std::size_t>(r)];
+            while (bits != 0) {
+                auto bit = static_cast<std::int32_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                auto& out = ((now >> bit) & 1u) != 0 ? born : died;
+                out.emplace_back(coord.x * kChunkSize + bit, coord.y * kChunkSize + r);
+            }
+        }
+    };
+
+    // Chunks the previous generation lacks were all dead, and every cell of
+    // a chunk freed by the step died
+    for (const auto& chunk : chunks_) {
+        const Rows* previous = findRows(previous_, previousIndex_, chunk.coord);
+        compare(chunk.coord, chunk.rows, previous != nullptr ? *previous : kEmpty);
+    }
+    for (const auto& chunk : previous_) {
+        if (!index_.contains(chunk.coord)) {
+            compare(chunk.coord, kEmpty, chunk.rows);
+        }
+    }
+}
+
+const ChunkedPlane::Rows* ChunkedPlane::findRows(const std::vector<Chunk>& chunks,
+                                                 const CoordinateMap<std::uint32_t>& index, Position coord) {
+    auto it = index.find(coord);
+    return it != index.end() ? &chunks[it->second].rows : nullptr;
+}
+
+void ChunkedPlane::addCandidates(const Chunk& chunk) {
+    std::uint64_t any = 0;
+    for (std::uint64_t row : chunk.rows) {
+        any |= row;
+    }
+    if (any == 0) {
+        return; // Emptied by setCell(); nothing can be born around it
+    }
+    candidates_.push_back(chunk.coord);
+
+    // Neighbor chunks a border cell of this one touches: the top row reaches
+    // the chunk above, bit 0 of any row the chunk to the left, and so on
+    const std::uint64_t top = chunk.rows.front();
+    const std::uint64_t bottom = chunk.rows.back();
+    const bool reaches[3][3] = {
+        {(top & 1u) != 0, top != 0, (top >> 63) != 0},
+        {(any & 1u) != 0, false, (any >> 63) != 0},
+        {(bottom & 1u) != 0, bottom != 0, (bottom >> 63) != 0},
+    };
+    for (std::int32_t dy = -1; dy <= 1; ++dy) {
+        for (std::int32_t dx = -1; dx <= 1; ++dx) {
+            const std::int64_t x = std::int64_t{chunk.coord.x} + dx;
+            const std::int64_t y = std::int64_t{chunk.coord.y} + dy;
+            // Past the 32-bit coordinate range cells are always dead
+            if (!reaches[dy + 1][dx + 1] || x < kMinChunk || x > kMaxChunk || y < kMinChunk || y > kMaxChunk) {
+                continue;
+            }
+            candidates_.emplace_back(static_cast<std::int32_t>(x), static_cast<std::int32_t>(y));
+        }
+    }
+}
+
+bool ChunkedPlane::stepChunk(Position coord, std::size_t& population) {
+    // The up to nine chunks the halo reads, row-major around this one; missing ones are dead
+    const Rows* around[3][3];
+    for (std::int32_t dy = -1; dy <= 1; ++dy) {
+        for (std::int32_t dx = -1; dx <= 1; ++dx) {
+            const std::int64_t x = std::int64_t{coord.x} + dx;
+            const std::int64_t y = std::int64_t{coord.y} + dy;
+            around[dy + 1][dx + 1] = x < kMinChunk || x > kMaxChunk || y < kMinChunk || y > kMaxChunk
+                                         ? nullptr
+                                         : findRows(chunks_, index_, Position(static_cast<std::int32_t>(x),
+                                                                              static_cast<std::int32_t>(y)));
+        }
+    }
+
+    // Halo exchange as in TiledGrid: this chunk's rows plus one row above and
+    // below, each with the bordering words of the chunks to either side
+    std::uint64_t halo[kChunkSize + 2][3];
+    for (std::int32_t r = -1; r <= kChunkSize; ++r) {
+        const std::int32_t band = r < 0 ? 0 : (r < kChunkSize ? 1 : 2);
+        const auto row = static_cast<std::size_t>((r + kChunkSize) % kChunkSize);
+        for (std::int32_t column = 0; column < 3; ++column) {
+            const Rows* rows = around[band][column];
+            halo[r + 1][column] = rows != nullptr ? (*rows)[row] : 0;
+        }
+    }
+
+    Rows out;
+    std::uint64_t any = 0;
+    for (std::int32_t r = 0; r < kChunkSize; ++r) {
+        std::uint64_t& word = out[static_cast<std::size_t>(r)];
+        if (conwayRule_) {
+            kernel_.stepRow(&halo[r][1], &halo[r + 1][1], &halo[r + 2][1], &word, 1);
+        } else {
+            kernel_.stepRowRule(&halo[r][1], &halo[r + 1][1], &halo[r + 2][1], &word, 1, rule_);
+        }
+        any |= word;
+    }
+
+    const Rows* current = around[1][1];
+    const bool changed = current != nullptr ? out != *current : any != 0;
+    if (any != 0) {
+        previousIndex_[coord] = static_cast<std::uint32_t>(previous_.size());
+        previous_.push_back(Chunk{coord, out});
+        for (std::uint64_t word : out) {
+            population += static_cast<std::size_t>(std::popcount(word));
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,594 @@
+#include "core/CudaLifeEngine.h"
+#include "core/LifeRule.h"
+#include "core/Trace.h"
+#include <cuda_runtime.h>
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr std::uint32_t kBlockWords = 32; // Step threads per block along a row
+constexpr std::uint32_t kBlockRows = 8;
+constexpr std::uint32_t kReduceThreads = 256;
+constexpr std::uint32_t kMaxReduceBlocks = 1024;
+constexpr std::size_t kInitialChangeCapacity = 4096;
+
+void check(cudaError_t status, const char* what) {
+    if (status != cudaSuccess) {
+        throw std::runtime_error(std::string("CUDA ") + what + ": " + cudaGetErrorString(status));
+    }
+}
+
+// Word wx of a row with its west and east neighbor bits, as in the dense row
+// kernel; rows off a bounded grid are null and read as dead. The last word's
+// bits past the width are always clear, so on a wrapped grid its east
+// neighbor bit at the last column is column 0, and word 0's west neighbor
+// bit is the last column.
+struct RowWords {
+    std::uint64_t west;
+    std::uint64_t center;
+    std::uint64_t east;
+};
+
+__device__ RowWords loadRow(const std::uint64_t* row, std::size_t wx, std::size_t wordsPerRow, std::uint32_t lastBit,
+                            bool wrapEdges) {
+    if (row == nullptr) {
+        return {0, 0, 0};
+    }
+    const std::uint64_t center = row[wx];
+    std::uint64_t westBit = 0;
+    if (wx > 0) {
+        westBit = row[wx - 1] >> 63;
+    } else if (wrapEdges) {
+        westBit = (row[wordsPerRow - 1] >> lastBit) & 1u;
+    }
+    std::uint64_t east = center >> 1;
+    if (wx + 1 < wordsPerRow) {
+        east |= row[wx + 1] << 63;
+    } else if (wrapEdges) {
+        east |= (row[0] & 1u) << lastBit;
+    }
+    return {(center << 1) | westBit, center, east};
+}
+
+__device__ std::uint64_t fullAdd(std::uint64_t a, std::uint64_t b, std::uint64_t c, std::uint64_t& carry) {
+    const std::uint64_t ab = a ^ b;
+    carry = (a & b) | (c & ab);
+    return ab ^ c;
+}
+
+// One word of the next generation per thread. A generation whose predecessor
+// changed nothing is skipped: both buffers already hold the settled board.
+template <bool Conway>
+__global__ void stepKernel(const std::uint64_t* in, std::uint64_t* out, std::int32_t height, std::size_t wordsPerRow,
+                           std::uint32_t lastBit, std::uint64_t lastWordMask, bool wrapEdges, std::uint16_t birth,
+                           std::uint16_t survival, const std::uint32_t* previousChanged, std::uint32_t* changed) {
+    if (previousChanged != nullptr && *previousChanged == 0) {
+        return;
+    }
+    const std::size_t wx = static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    const std::int32_t y = static_cast<std::int32_t>(blockIdx.y * blockDim.y + threadIdx.y);
+    if (wx >= wordsPerRow || y >= height) {
+        return;
+    }
+
+    auto rowPtr = [&](std::int32_t row) -> const std::uint64_t* {
+        if (row < 0 || row >= height) {
+            if (!wrapEdges) {
+                return nullptr;
+            }
+            row = row < 0 ? row + height : row - height;
+        }
+        return in + static_cast<std::size_t>(row) * wordsPerRow;
+    };
+    const RowWords above = loadRow(rowPtr(y - 1), wx, wordsPerRow, lastBit, wrapEdges);
+    const RowWords row = loadRow(rowPtr(y), wx, wordsPerRow, lastBit, wrapEdges);
+    const RowWords below = loadRow(rowPtr(y + 1), wx, wordsPerRow, lastBit, wrapEdges);
+
+    // The dense kernel's adder tree: count = ones + 2 * twos + 4 * (foursA + foursB)
+    std::uint64_t carryAbove, carryBelow, carryOnes, foursA;
+    const std::uint64_t sumAbove = fullAdd(above.west, above.center, above.east, carryAbove);
+    const std::uint64_t sumBelow = fullAdd(below.west, below.center, below.east, carryBelow);
+    const std::uint64_t sumRow = row.west ^ row.east;
+    const std::uint64_t carryRow = row.west & row.east;
+    const std::uint64_t ones = fullAdd(sumAbove, sumBelow, sumRow, carryOnes);
+    const std::uint64_t partialTwos = fullAdd(carryAbove, carryBelow, carryRow, foursA);
+    const std::uint64_t twos = partialTwos ^ carryOnes;
+    const std::uint64_t foursB = partialTwos & carryOnes;
+
+    std::uint64_t next;
+    if constexpr (Conway) {
+        next = ~(foursA | foursB) & twos & (ones | row.center);
+    } else {
+        // The count's four bits, 8 being the only count with the top one set
+        const std::uint64_t planes[4] = {ones, twos, foursA ^ foursB, foursA & foursB};
+        std::uint64_t survive = 0;
+        std::uint64_t born = 0;
+        for (std::uint32_t n = 0; n <= 8; ++n) {
+            const bool survives = ((survival >> n) & 1u) != 0;
+            const bool births = ((birth >> n) & 1u) != 0;
+            if (!survives && !births) {
+                continue;
+            }
+            std::uint64_t match = ~std::uint64_t{0};
+            for (std::uint32_t plane = 0; plane < 4; ++plane) {
+                match &= ((n >> plane) & 1u) != 0 ? planes[plane] : ~planes[plane];
+            }
+            survive |= survives ? match : 0;
+            born |= births ? match : 0;
+        }
+        next = (row.center & survive) | (~row.center & born);
+    }
+    if (wx + 1 == wordsPerRow) {
+        next &= lastWordMask;
+    }
+
+    out[static_cast<std::size_t>(y) * wordsPerRow + wx] = next;
+    if (next != row.center) {
+        *changed = 1;
+    }
+}
+
+__global__ void countKernel(const std::uint64_t* cells, std::size_t words, unsigned long long* count) {
+    __shared__ unsigned long long partial[kReduceThreads];
+    unsigned long long sum = 0;
+    for (std::size_t i = static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x; i < words;
+         i += static_cast<std::size_t>(gridDim.x) * blockDim.x) {
+        sum += static_cast<unsigned long long>(__popcll(cells[i]));
+    }
+    partial[threadIdx.x] = sum;
+    __syncthreads();
+    for (std::uint32_t stride = blockDim.x / 2; stride > 0; stride /= 2) {
+        if (threadIdx.x < stride) {
+            partial[threadIdx.x] += partial[threadIdx.x + stride];
+        }
+        __syncthreads();
+    }
+    if (threadIdx.x == 0) {
+        atomicAdd(count, partial[0]);
+    }
+}
+
+// Appends the cells born and died between previous and current, born to
+// cells[0, capacity) and died to cells[capacity, 2 * capacity). Counts keep
+// growing past the capacity, so the host can see how much room a retry needs.
+__global__ void changesKernel(const std::uint64_t* previous, const std::uint64_t* current, std::size_t words,
+                              std::size_t wordsPerRow, Position* cells, std::size_t capacity,
+                              unsigned long long* counts) {
+    for (std::size_t i = static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x; i < words;
+         i += static_cast<std::size_t>(gridDim.x) * blockDim.x) {
+        const std::uint64_t kinds[2] = {current[i] & ~previous[i], previous[i] & ~current[i]};
+        for (std::uint32_t kind = 0; kind < 2; ++kind) {
+            std::uint64_t bits = kinds[kind];
+            if (bits == 0) {
+                continue;
+            }
+            auto slot = atomicAdd(&counts[kind], static_cast<unsigned long long>(__popcll(bits)));
+            const auto y = static_cast<std::int32_t>(i / wordsPerRow);
+            const auto baseX = static_cast<std::int32_t>((i % wordsPerRow) * 64);
+            for (; bits != 0 && slot < capacity; bits &= bits - 1, ++slot) {
+                cells[kind * capacity + slot] = Position(baseX + __ffsll(static_cast<long long>(bits)) - 1, y);
+            }
+        }
+    }
+}
+
+struct DeviceCellEdit {
+    std::int32_t x;
+    std::int32_t y;
+    std::uint32_t alive;
+};
+
+// Edits are deduplicated on the host, so no two touch the same cell
+__global__ void editKernel(std::uint64_t* cells, std::size_t wordsPerRow, const DeviceCellEdit* edits,
+                           std::size_t count) {
+    const std::size_t i = static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (i >= count) {
+        return;
+    }
+    const auto& edit = edits[i];
+    auto* word = reinterpret_cast<unsigned long long*>(
+        cells + static_cast<std::size_t>(edit.y) * wordsPerRow + static_cast<std::size_t>(edit.x >> 6));
+    const unsigned long long bit = 1ull << (edit.x & 63);
+    if (edit.alive != 0) {
+        atomicOr(word, bit);
+    } else {
+        atomicAnd(word, ~bit);
+    }
+}
+
+std::uint32_t reduceBlocks(std::size_t items) {
+    return static_cast<std::uint32_t>(
+        std::clamp<std::size_t>((items + kReduceThreads - 1) / kReduceThreads, 1, kMaxReduceBlocks));
+}
+
+} // namespace
+
+CudaLifeEngine::CudaLifeEngine(const GameConfig& config)
+    : config_(config) {
+    if (!isAvailable()) {
+        throw std::runtime_error("CudaLifeEngine: no CUDA device available");
+    }
+    allocate();
+    reset();
+}
+
+CudaLifeEngine::~CudaLifeEngine() {
+    release();
+}
+
+bool CudaLifeEngine::isAvailable() {
+    int devices = 0;
+    return cudaGetDeviceCount(&devices) == cudaSuccess && devices > 0;
+}
+
+void CudaLifeEngine::allocate() {
+    if (config_.getGridWidth() <= 0 || config_.getGridHeight() <= 0) {
+        throw std::invalid_argument("CudaLifeEngine: grid size must be positive");
+    }
+    wordsPerRow_ = (static_cast<std::size_t>(config_.getGridWidth()) + 63) / 64;
+    const std::size_t bytes = wordsPerRow_ * static_cast<std::size_t>(config_.getGridHeight()) * sizeof(std::uint64_t);
+    try {
+        check(cudaMalloc(&current_, bytes), "allocating the board");
+        check(cudaMalloc(&previous_, bytes), "allocating the board");
+        check(cudaMalloc(&changeFlags_, kAdvanceBatch * sizeof(std::uint32_t)), "allocating change flags");
+        check(cudaMalloc(&counter_, 3 * sizeof(std::uint64_t)), "allocating counters");
+    } catch (...) {
+        release();
+        throw;
+    }
+    hostFlags_.resize(kAdvanceBatch);
+}
+
+void CudaLifeEngine::release() {
+    // Frees what is held; errors are ignored since this runs from the destructor
+    for (void* buffer : {static_cast<void*>(current_), static_cast<void*>(previous_), static_cast<void*>(changeFlags_),
+                         static_cast<void*>(counter_), static_cast<void*>(changeCells_),
+                         static_cast<void*>(deviceEdits_)}) {
+        if (buffer != nullptr) {
+            cudaFree(buffer);
+        }
+    }
+    current_ = previous_ = nullptr;
+    changeFlags_ = nullptr;
+    counter_ = nullptr;
+    changeCells_ = nullptr;
+    changeCapacity_ = 0;
+    deviceEdits_ = nullptr;
+    deviceEditCapacity_ = 0;
+}
+
+bool CudaLifeEngine::normalize(std::int32_t& x, std::int32_t& y) const {
+    const std::int32_t width = config_.getGridWidth();
+    const std::int32_t height = config_.getGridHeight();
+    if (config_.getWrapEdges()) {
+        x = ((x % width) + width) % width;
+        y = ((y % height) + height) % height;
+        return true;
+    }
+    return x >= 0 && x < width && y >= 0 && y < height;
+}
+
+void CudaLifeEngine::queueEdit(std::int32_t x, std::int32_t y, bool alive) {
+    if (!normalize(x, y)) {
+        return;
+    }
+    edits_.push_back({x, y, alive ? 1u : 0u});
+    populationStale_ = true;
+
+    // The board no longer follows from the last step
+    changesStale_ = false;
+    bornCells_.clear();
+    diedCells_.clear();
+}
+
+void CudaLifeEngine::setCellAlive(std::int32_t x, std::int32_t y) {
+    queueEdit(x, y, true);
+}
+
+void CudaLifeEngine::setCellsAlive(std::span<const Position> cells) {
+    edits_.reserve(edits_.size() + cells.size());
+    for (const auto& pos : cells) {
+        queueEdit(pos.x, pos.y, true);
+    }
+}
+
+void CudaLifeEngine::setCellDead(std::int32_t x, std::int32_t y) {
+    queueEdit(x, y, false);
+}
+
+void CudaLifeEngine::flushEdits() const {
+    if (edits_.empty()) {
+        return;
+    }
+
+    // The last edit of each cell wins
+    std::stable_sort(edits_.begin(), edits_.end(), [](const CellEdit& a, const CellEdit& b) {
+        return a.y != b.y ? a.y < b.y : a.x < b.x;
+    });
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < edits_.size(); ++i) {
+        if (i + 1 < edits_.size() && edits_[i + 1].x == edits_[i].x && edits_[i + 1].y == edits_[i].y) {
+            continue;
+        }
+        edits_[kept++] = edits_[i];
+    }
+    edits_.resize(kept);
+
+    if (deviceEditCapacity_ < kept) {
+        if (deviceEdits_ != nullptr) {
+            check(cudaFree(deviceEdits_), "freeing edits");
+            deviceEdits_ = nullptr;
+            deviceEditCapacity_ = 0;
+        }
+        check(cudaMalloc(&deviceEdits_, kept * sizeof(CellEdit)), "allocating edits");
+        deviceEditCapacity_ = kept;
+    }
+    check(cudaMemcpy(deviceEdits_, edits_.data(), kept * sizeof(CellEdit), cudaMemcpyHostToDevice), "uploading edits");
+    static_assert(sizeof(CellEdit) == sizeof(DeviceCellEdit));
+    editKernel<<<static_cast<std::uint32_t>((kept + kReduceThreads - 1) / kReduceThreads), kReduceThreads>>>(
+        current_, wordsPerRow_, reinterpret_cast<const DeviceCellEdit*>(deviceEdits_), kept);
+    check(cudaGetLastError(), "applying edits");
+    edits_.clear();
+}
+
+bool CudaLifeEngine::isCellAlive(std::int32_t x, std::int32_t y) const {
+    if (!normalize(x, y)) {
+        return false;
+    }
+    flushEdits();
+    std::uint64_t word = 0;
+    check(cudaMemcpy(&word, current_ + static_cast<std::size_t>(y) * wordsPerRow_ + static_cast<std::size_t>(x >> 6),
+                     sizeof(word), cudaMemcpyDeviceToHost),
+          "reading a cell");
+    return ((word >> (x & 63)) & 1u) != 0;
+}
+
+bool CudaLifeEngine::step() {
+    advance(1);
+    return lastStepChanged_;
+}
+
+std::uint64_t CudaLifeEngine::advance(std::uint64_t steps) {
+    GOL_TRACE_SCOPE("CudaLifeEngine::advance");
+    if (steps == 0) {
+        return 0;
+    }
+    flushEdits();
+
+    std::uint64_t taken = 0;
+    lastStepChanged_ = true;
+    while (taken < steps && lastStepChanged_) {
+        const std::uint64_t batch = std::min(kAdvanceBatch, steps - taken);
+        launchSteps(batch);
+        check(cudaMemcpy(hostFlags_.data(), changeFlags_, batch * sizeof(std::uint32_t), cudaMemcpyDeviceToHost),
+              "reading change flags");
+
+        // The generations after the first unchanged one were skipped on the device
+        const auto end = hostFlags_.begin() + static_cast<std::ptrdiff_t>(batch);
+        const auto settled = std::find(hostFlags_.begin(), end, 0u);
+        lastStepChanged_ = settled == end;
+        taken += static_cast<std::uint64_t>(settled - hostFlags_.begin()) + (lastStepChanged_ ? 0 : 1);
+    }
+
+    generationCount_ += taken;
+    changesStale_ = true;
+    populationStale_ = true;
+    return taken;
+}
+
+void CudaLifeEngine::launchSteps(std::uint64_t steps) {
+    const std::int32_t height = config_.getGridHeight();
+    const std::uint32_t lastBit = static_cast<std::uint32_t>(config_.getGridWidth() - 1) & 63u;
+    const std::uint64_t lastWordMask = lastBit == 63 ? ~std::uint64_t{0} : (std::uint64_t{2} << lastBit) - 1;
+    const LifeRule& rule = config_.getRule();
+    const bool conway = rule == kConwayRule;
+    const dim3 block(kBlockWords, kBlockRows);
+    const dim3 grid(static_cast<std::uint32_t>((wordsPerRow_ + kBlockWords - 1) / kBlockWords),
+                    static_cast<std::uint32_t>((static_cast<std::uint32_t>(height) + kBlockRows - 1) / kBlockRows));
+
+    check(cudaMemsetAsync(changeFlags_, 0, steps * sizeof(std::uint32_t)), "clearing change flags");
+    for (std::uint64_t generation = 0; generation < steps; ++generation) {
+        const std::uint32_t* previousChanged = generation > 0 ? changeFlags_ + generation - 1 : nullptr;
+        if (conway) {
+            stepKernel<true><<<grid, block>>>(current_, previous_, height, wordsPerRow_,
+                                               lastBit, lastWordMask, config_.getWrapEdges(), rule.birth,
+                                               rule.survival, previousChanged, changeFlags_ + generation);
+        } else {
+            stepKernel<false><<<grid, block>>>(current_, previous_, height, wordsPerRow_, lastBit, lastWordMask,
+                                                config_.getWrapEdges(), rule.birth, rule.survival, previousChanged,
+                                                changeFlags_ + generation);
+        }
+        std::swap(current_, previous_);
+    }
+    check(cudaGetLastError(), "launching steps");
+}
+
+void CudaLifeEngine::reset() {
+    edits_.clear();
+    const std::size_t bytes = wordsPerRow_ * static_cast<std::size_t>(config_.getGridHeight()) * sizeof(std::uint64_t);
+    check(cudaMemset(current_, 0, bytes), "clearing the board");
+    check(cudaMemset(previous_, 0, bytes), "clearing the board");
+    generationCount_ = 0;
+    population_ = 0;
+    populationStale_ = false;
+    lastStepChanged_ = false;
+    changesStale_ = false;
+    bornCells_.clear();
+    diedCells_.clear();
+
+    // Scratch grown past the memory limit is given back
+    if (exceedsMemoryLimit(*this)) {
+        for (void* buffer : {static_cast<void*>(changeCells_), static_cast<void*>(deviceEdits_)}) {
+            if (buffer != nullptr) {
+                check(cudaFree(buffer), "freeing scratch");
+            }
+        }
+        changeCells_ = nullptr;
+        changeCapacity_ = 0;
+        deviceEdits_ = nullptr;
+        deviceEditCapacity_ = 0;
+        edits_ = {};
+        bornCells_ = {};
+        diedCells_ = {};
+        hostWords_ = {};
+    }
+}
+
+std::size_t CudaLifeEngine::getLivingCellCount() const {
+    flushEdits();
+    if (populationStale_) {
+        const std::size_t words = wordsPerRow_ * static_cast<std::size_t>(config_.getGridHeight());
+        auto* count = reinterpret_cast<unsigned long long*>(counter_);
+        check(cudaMemset(count, 0, sizeof(unsigned long long)), "clearing the population");
+        countKernel<<<reduceBlocks(words), kReduceThreads>>>(current_, words, count);
+        check(cudaGetLastError(), "counting the population");
+        unsigned long long population = 0;
+        check(cudaMemcpy(&population, count, sizeof(population), cudaMemcpyDeviceToHost), "reading the population");
+        population_ = static_cast<std::size_t>(population);
+        populationStale_ = false;
+    }
+    return population_;
+}
+
+std::vector<Position> CudaLifeEngine::getLivingPositions() const {
+    flushEdits();
+    std::vector<Position> positions;
+    copyRegion(0, config_.getGridWidth() - 1, 0, config_.getGridHeight() - 1, 0, 0, positions);
+    return positions;
+}
+
+std::size_t CudaLifeEngine::getMemoryUsage() const {
+    return 2 * wordsPerRow_ * static_cast<std::size_t>(std::max(config_.getGridHeight(), 0)) * sizeof(std::uint64_t) +
+           kAdvanceBatch * sizeof(std::uint32_t) + 3 * sizeof(std::uint64_t) + 2 * changeCapacity_ * sizeof(Position) +
+           deviceEditCapacity_ * sizeof(CellEdit) + edits_.capacity() * sizeof(CellEdit) +
+           (bornCells_.capacity() + diedCells_.capacity()) * sizeof(Position) +
+           hostWords_.capacity() * sizeof(std::uint64_t) + hostFlags_.capacity() * sizeof(std::uint32_t);
+}
+
+void CudaLifeEngine::collectLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY,
+                                                std::int32_t maxY, std::vector<Position>& out) const {
+    if (minX > maxX || minY > maxY) {
+        return;
+    }
+    flushEdits();
+    const std::int64_t width = config_.getGridWidth();
+    const std::int64_t height = config_.getGridHeight();
+    if (!config_.getWrapEdges()) {
+        if (maxX >= 0 && maxY >= 0 && minX < width && minY < height) {
+            copyRegion(std::max(minX, 0), static_cast<std::int32_t>(std::min<std::int64_t>(maxX, width - 1)),
+                       std::max(minY, 0), static_cast<std::int32_t>(std::min<std::int64_t>(maxY, height - 1)), 0, 0,
+                       out);
+        }
+        return;
+    }
+
+    // One copy per wrapped copy of the board the region overlaps
+    auto floorDiv = [](std::int64_t value, std::int64_t divisor) {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    };
+    for (std::int64_t tileY = floorDiv(minY, height); tileY <= floorDiv(maxY, height); ++tileY) {
+        for (std::int64_t tileX = floorDiv(minX, width); tileX <= floorDiv(maxX, width); ++tileX) {
+            const std::int64_t offsetX = tileX * width;
+            const std::int64_t offsetY = tileY * height;
+            copyRegion(static_cast<std::int32_t>(std::max<std::int64_t>(minX - offsetX, 0)),
+                       static_cast<std::int32_t>(std::min<std::int64_t>(maxX - offsetX, width - 1)),
+                       static_cast<std::int32_t>(std::max<std::int64_t>(minY - offsetY, 0)),
+                       static_cast<std::int32_t>(std::min<std::int64_t>(maxY - offsetY, height - 1)), offsetX, offsetY,
+                       out);
+        }
+    }
+}
+
+void CudaLifeEngine::copyRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY, std::int32_t maxY,
+                                std::int64_t offsetX, std::int64_t offsetY, std::vector<Position>& out) const {
+    const auto firstWord = static_cast<std::size_t>(minX >> 6);
+    const auto words = static_cast<std::size_t>(maxX >> 6) - firstWord + 1;
+    const auto rows = static_cast<std::size_t>(maxY - minY + 1);
+    hostWords_.resize(words * rows);
+    check(cudaMemcpy2D(hostWords_.data(), words * sizeof(std::uint64_t),
+                       current_ + static_cast<std::size_t>(minY) * wordsPerRow_ + firstWord,
+                       wordsPerRow_ * sizeof(std::uint64_t), words * sizeof(std::uint64_t), rows,
+                       cudaMemcpyDeviceToHost),
+          "copying a region");
+
+    for (std::size_t row = 0; row < rows; ++row) {
+        const auto y = static_cast<std::int32_t>(minY + static_cast<std::int64_t>(row) + offsetY);
+        for (std::size_t word = 0; word < words; ++word) {
+            const std::int64_t baseX = static_cast<std::int64_t>(firstWord + word) * 64;
+            std::uint64_t bits = hostWords_[row * words + word];
+            if (baseX < minX) {
+                bits &= ~std::uint64_t{0} << (minX - baseX);
+            }
+            if (baseX + 63 > maxX) {
+                bits &= ~std::uint64_t{0} >> (baseX + 63 - maxX);
+            }
+            for (; bits != 0; bits &= bits - 1) {
+                out.emplace_back(static_cast<std::int32_t>(baseX + std::countr_zero(bits) + offsetX), y);
+            }
+        }
+    }
+}
+
+const std::vector<Position>& CudaLifeEngine::getBornCells() const {
+    collectChanges();
+    return bornCells_;
+}
+
+const std::vector<Position>& CudaLifeEngine::getDiedCells() const {
+    collectChanges();
+    return diedCells_;
+}
+
+void CudaLifeEngine::collectChanges() const {
+    if (!changesStale_) {
+        return;
+    }
+    changesStale_ = false;
+
+    const std::size_t words = wordsPerRow_ * static_cast<std::size_t>(config_.getGridHeight());
+    auto* counts = reinterpret_cast<unsigned long long*>(counter_) + 1;
+    unsigned long long found[2] = {0, 0};
+    for (;;) {
+        if (changeCapacity_ == 0) {
+            check(cudaMalloc(&changeCells_, 2 * kInitialChangeCapacity * sizeof(Position)), "allocating changes");
+            changeCapacity_ = kInitialChangeCapacity;
+        }
+        check(cudaMemset(counts, 0, 2 * sizeof(unsigned long long)), "clearing change counts");
+        changesKernel<<<reduceBlocks(words), kReduceThreads>>>(previous_, current_, words, wordsPerRow_, changeCells_,
+                                                               changeCapacity_, counts);
+        check(cudaGetLastError(), "collecting changes");
+        check(cudaMemcpy(found, counts, sizeof(found), cudaMemcpyDeviceToHost), "reading change counts");
+        const auto needed = static_cast<std::size_t>(std::max(found[0], found[1]));
+        if (needed <= changeCapacity_) {
+            break;
+        }
+
+        // Too many to hold: grow to fit and collect again
+        check(cudaFree(changeCells_), "freeing changes");
+        changeCells_ = nullptr;
+        changeCapacity_ = 0;
+        check(cudaMalloc(&changeCells_, 2 * needed * sizeof(Position)), "allocating changes");
+        changeCapacity_ = needed;
+    }
+
+    // Slots are handed out in no fixed order; sort so results repeat
+    bornCells_.resize(static_cast<std::size_t>(found[0]));
+    diedCells_.resize(static_cast<std::size_t>(found[1]));
+    check(cudaMemcpy(bornCells_.data(), changeCells_, bornCells_.size() * sizeof(Position), cudaMemcpyDeviceToHost),
+          "reading born cells");
+    check(cudaMemcpy(diedCells_.data(), changeCells_ + changeCapacity_, diedCells_.size() * sizeof(Position),
+                     cudaMemcpyDeviceToHost),
+          "reading died cells");
+    std::sort(bornCells_.begin(), bornCells_.end());
+    std::sort(diedCells_.begin(), diedCells_.end());
+}
+
+void CudaLifeEngine::setConfig(const GameConfig& config) {
+    config_ = config;
+    release();
+    allocate();
+    reset();
+}
@@ -0,0 +1,127 @@
+#include "core/CycleDetector.h"
+#include <array>
+
+namespace {
+
+// Odd, so both bases are invertible mod 2^64
+constexpr std::uint64_t kBaseX = 0x9E3779B97F4A7C15ull;
+constexpr std::uint64_t kBaseY = 0xC2B2AE3D27D4EB4Full;
+
+// Mixed into the shape hash so sets of different sizes rarely share a slot
+constexpr std::uint64_t kCountMix = 0x2545F4914F6CDD1Dull;
+
+constexpr std::uint64_t inverse(std::uint64_t odd) {
+    // Newton iteration; every round doubles the number of correct low bits
+    std::uint64_t x = odd;
+    for (int i = 0; i < 6; ++i) {
+        x *= 2 - odd * x;
+    }
+    return x;
+}
+
+static_assert(kBaseX * inverse(kBaseX) == 1, "inverse() must give the multiplicative inverse");
+
+// base^(2^k) and base^-(2^k), enough for any int32 coordinate
+struct PowerTable {
+    std::array<std::uint64_t, 32> up{};
+    std::array<std::uint64_t, 32> down{};
+
+    constexpr explicit PowerTable(std::uint64_t base) {
+        std::uint64_t forward = base;
+        std::uint64_t backward = inverse(base);
+        for (std::size_t k = 0; k < up.size(); ++k) {
+            up[k] = forward;
+            down[k] = backward;
+            forward *= forward;
+            backward *= backward;
+        }
+    }
+
+    constexpr std::uint64_t power(std::int64_t exponent) const {
+        const auto& table = exponent < 0 ? down : up;
+        auto magnitude = static_cast<std::uint64_t>(exponent < 0 ? -exponent : exponent);
+        std::uint64_t result = 1;
+        for (std::size_t k = 0; magnitude != 0 && k < table.size(); ++k, magnitude >>= 1) {
+            if (magnitude & 1u) {
+                result *= table[k];
+            }
+        }
+        return result;
+    }
+};
+
+constexpr PowerTable kPowersX(kBaseX);
+constexpr PowerTable kPowersY(kBaseY);
+
+std::int64_t floorDiv(std::int64_t value, std::uint64_t divisor) {
+    auto d = static_cast<std::int64_t>(divisor);
+    std::int64_t quotient = value / d;
+    return (value % d != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+} // namespace
+
+CycleDetector::CycleDetector(std::uint64_t maxPeriod)
+    : maxPeriod_(maxPeriod) {
+}
+
+std::uint64_t CycleDetector::cellHash(const Position& pos) {
+    return kPowersX.power(pos.x) * kPowersY.power(pos.y);
+}
+
+void CycleDetector::add(const Position& pos) {
+    hash_ += cellHash(pos);
+    sumX_ += pos.x;
+    sumY_ += pos.y;
+    ++count_;
+}
+
+void CycleDetector::remove(const Position& pos) {
+    hash_ -= cellHash(pos);
+    sumX_ -= pos.x;
+    sumY_ -= pos.y;
+    --count_;
+}
+
+void CycleDetector::clear() {
+    hash_ = 0;
+    sumX_ = 0;
+    sumY_ = 0;
+    count_ = 0;
+    sightings_.clear();
+    history_.clear();
+}
+
+std::optional<CycleDetector::Cycle> CycleDetector::record(std::uint64_t generation) {
+    // Normalize to the floored centroid, which moves exactly with a translation
+    std::int64_t centroidX = 0;
+    std::int64_t centroidY = 0;
+    std::uint64_t shape = 0;
+    if (count_ > 0) {
+        centroidX = floorDiv(sumX_, count_);
+        centroidY = floorDiv(sumY_, count_);
+        shape = hash_ * kPowersX.power(-centroidX) * kPowersY.power(-centroidY);
+    }
+    shape ^= count_ * kCountMix;
+
+    // Drop sightings too old to close a cycle of at most maxPeriod_
+    while (!history_.empty() && generation - history_.front().second > maxPeriod_) {
+        auto it = sightings_.find(history_.front().first);
+        if (it != sightings_.end() && it->second.generation == history_.front().second) {
+            sightings_.erase(it);
+        }
+        history_.pop_front();
+    }
+
+    std::optional<Cycle> cycle;
+    auto it = sightings_.find(shape);
+    if (it != sightings_.end() && it->second.count == count_ && it->second.generation < generation) {
+        const Sighting& earlier = it->second;
+        cycle = Cycle{generation - earlier.generation, static_cast<std::int32_t>(centroidX - earlier.centroidX),
+                      static_cast<std::int32_t>(centroidY - earlier.centroidY), earlier.generation};
+    }
+
+    sightings_[shape] = Sighting{generation, centroidX, centroidY, count_};
+    history_.emplace_back(shape, generation);
+    return cycle;
+}
@@ -0,0 +1,179 @@
+#include "core/DenseGrid.h"
+#include "core/Topology.h"
+#include "core/Trace.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+DenseGrid::DenseGrid(std::int32_t width, std::int32_t height, bool wrapEdges, const LifeRule& rule)
+    : width_(width)
+    , height_(height)
+    , wrapEdges_(wrapEdges)
+    , wordsPerRow_((static_cast<std::size_t>(width) + 63) / 64)
+    , stride_(wordsPerRow_ + 2)
+    , lastWordMask_((width & 63) != 0 ? ~std::uint64_t{0} >> (64 - (width & 63)) : ~std::uint64_t{0})
+    , kernel_(selectDenseKernel())
+    , rule_(rule)
+    , conwayRule_(rule == kConwayRule) {
+
+    // Guard rows above and below the grid
+    cells_.assign(stride_ * (static_cast<std::size_t>(height_) + 2), 0);
+    next_.assign(cells_.size(), 0);
+}
+
+void DenseGrid::setCell(std::int32_t x, std::int32_t y, bool alive) {
+    std::uint64_t& word = rowPtr(cells_, y)[x >> 6];
+    std::uint64_t mask = std::uint64_t{1} << (x & 63);
+    bool wasAlive = (word & mask) != 0;
+
+    if (alive && !wasAlive) {
+        word |= mask;
+        ++population_;
+    } else if (!alive && wasAlive) {
+        word &= ~mask;
+        --population_;
+    }
+}
+
+bool DenseGrid::getCell(std::int32_t x, std::int32_t y) const {
+    return (rowPtr(cells_, y)[x >> 6] >> (x & 63)) & 1u;
+}
+
+std::uint8_t DenseGrid::countNeighbors(std::int32_t x, std::int32_t y) const {
+    std::uint8_t count = 0;
+
+    for (std::int32_t dy = -1; dy <= 1; ++dy) {
+        for (std::int32_t dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) {
+                continue;
+            }
+
+            std::int32_t neighborX = x + dx;
+            std::int32_t neighborY = y + dy;
+
+            if (wrapEdges_) {
+                neighborX = ((neighborX % width_) + width_) % width_;
+                neighborY = ((neighborY % height_) + height_) % height_;
+            } else if (neighborX < 0 || neighborX >= width_ || neighborY < 0 || neighborY >= height_) {
+                continue;
+            }
+
+            if (getCell(neighborX, neighborY)) {
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+bool DenseGrid::step() {
+    GOL_TRACE_SCOPE("DenseGrid::step");
+    const std::size_t rowBytes = wordsPerRow_ * sizeof(std::uint64_t);
+
+    // Guard rows hold the wrapped neighbor rows, or stay zero for bounded grids
+    if (wrapEdges_) {
+        std::memcpy(rowPtr(cells_, -1), rowPtr(cells_, height_ - 1), rowBytes);
+        std::memcpy(rowPtr(cells_, height_), rowPtr(cells_, 0), rowBytes);
+    }
+
+    for (std::int32_t y = 0; y < height_; ++y) {
+        std::uint64_t* out = rowPtr(next_, y);
+        if (conwayRule_) {
+            kernel_.stepRow(rowPtr(cells_, y - 1), rowPtr(cells_, y), rowPtr(cells_, y + 1), out, wordsPerRow_);
+        } else {
+            kernel_.stepRowRule(rowPtr(cells_, y - 1), rowPtr(cells_, y), rowPtr(cells_, y + 1), out, wordsPerRow_, rule_);
+        }
+
+        // Births just past the right edge would otherwise leak into the padding bits
+        out[wordsPerRow_ - 1] &= lastWordMask_;
+    }
+
+    // The kernel sees zeros beyond the first and last column; redo those with wrapping
+    if (wrapEdges_) {
+        patchWrappedColumn(0);
+        if (width_ > 1) {
+            patchWrappedColumn(width_ - 1);
+        }
+    }
+
+    bool changed = false;
+    for (std::int32_t y = 0; y < height_ && !changed; ++y) {
+        changed = std::memcmp(rowPtr(cells_, y), rowPtr(next_, y), rowBytes) != 0;
+    }
+
+    cells_.swap(next_);
+    recountPopulation();
+    return changed;
+}
+
+void DenseGrid::patchWrappedColumn(std::int32_t x) {
+    const TorusTopology torus{width_, height_};
+    std::uint64_t mask = std::uint64_t{1} << (x & 63);
+
+    for (std::int32_t y = 0; y < height_; ++y) {
+        std::uint32_t neighbors = 0;
+        forEachNeighbor(torus, Position(x, y), [&](Position n) { neighbors += getCell(n.x, n.y) ? 1u : 0u; });
+        std::uint64_t& word = rowPtr(next_, y)[x >> 6];
+
+        if (rule_.nextState(getCell(x, y), neighbors)) {
+            word |= mask;
+        } else {
+            word &= ~mask;
+        }
+    }
+}
+
+void DenseGrid::clear() {
+    std::fill(cells_.begin(), cells_.end(), 0);
+    population_ = 0;
+}
+
+std::size_t DenseGrid::getMemoryUsage() const {
+    return (cells_.capacity() + next_.capacity()) * sizeof(std::uint64_t);
+}
+
+void DenseGrid::collectLivingCells(std::vector<Position>& out) const {
+    for (std::int32_t y = 0; y < height_; ++y) {
+        const std::uint64_t* words = rowData(y);
+
+        for (std::size_t w = 0; w < wordsPerRow_; ++w) {
+            std::uint64_t bits = words[w];
+            while (bits != 0) {
+                auto bit = static_cast<std::int32_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                out.emplace_back(static_cast<std::int32_t>(w * 64) + bit, y);
+            }
+        }
+    }
+}
+
+void DenseGrid::collectChanges(std::vector<Position>& born, std::vector<Position>& died) const {
+    // After the swap the spare buffer holds the previous generation
+    for (std::int32_t y = 0; y < height_; ++y) {
+        const std::uint64_t* current = rowPtr(cells_, y);
+        const std::uint64_t* previous = rowPtr(next_, y);
+
+        for (std::size_t w = 0; w < wordsPerRow_; ++w) {
+            std::uint64_t bits = current[w] ^ previous[w];
+            while (bits != 0) {
+                auto bit = static_cast<std::int32_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                auto& out = ((current[w] >> bit) & 1u) != 0 ? born : died;
+                out.emplace_back(static_cast<std::int32_t>(w * 64) + bit, y);
+            }
+        }
+    }
+}
+
+void DenseGrid::recountPopulation() {
+    // Guard rows may hold stale wrapped copies, so only count the grid rows
+    std::size_t count = 0;
+    for (std::int32_t y = 0; y < height_; ++y) {
+        const std::uint64_t* words = rowPtr(cells_, y);
+        for (std::size_t w = 0; w < wordsPerRow_; ++w) {
+            count += static_cast<std::size_t>(std::popcount(words[w]));
+        }
+    }
+    population_ = count;
+}
@@ -0,0 +1,146 @@
+#include "core/DenseKernels.h"
+#include "DenseKernelImpl.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define GAME_OF_LIFE_X86 1
+    #include <emmintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64) || (defined(__ARM_NEON) && defined(__arm__))
+    #define GAME_OF_LIFE_NEON 1
+    #include <arm_neon.h>
+#endif
+
+#ifdef GAME_OF_LIFE_AVX2_KERNEL
+// Defined in DenseKernelsAvx2.cpp, which is compiled with AVX2 enabled
+void stepRowAvx2(const std::uint64_t* above, const std::uint64_t* row, const std::uint64_t* below, std::uint64_t* out, std::size_t words);
+void stepRowRuleAvx2(const std::uint64_t* above, const std::uint64_t* row, const std::uint64_t* below, std::uint64_t* out, std::size_t words,
+                     const LifeRule& rule);
+#endif
+
+namespace {
+
+void stepRowScalar(const std::uint64_t* above, const std::uint64_t* row, const std::uint64_t* below, std::uint64_t* out, std::size_t words) {
+    dense_kernel_detail::stepRow<dense_kernel_detail::ScalarOps>(above, row, below, out, words);
+}
+
+void stepRowRuleScalar(const std::uint64_t* above, const std::uint64_t* row, const std::uint64_t* below, std::uint64_t* out, std::size_t words,
+                    const LifeRule& rule) {
+    dense_kernel_detail::stepRowAnyRule<dense_kernel_detail::ScalarOps>(above, row, below, out, words, rule);
+}
+
+#ifdef GAME_OF_LIFE_X86
+struct Sse2Ops {
+    using V = __m128i;
+    static constexpr std::size_t LANES = 2;
+
+    static V load(const std::uint64_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(std::uint64_t* p, V v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static V bitXor(V a, V b) { return _mm_xor_si128(a, b); }
+    static V bitAnd(V a, V b) { return _mm_and_si128(a, b); }
+    static V bitOr(V a, V b) { return _mm_or_si128(a, b); }
+    static V andNot(V a, V b) { return _mm_andnot_si128(a, b); }
+    static V shiftLeft1(V a) { return _mm_slli_epi64(a, 1); }
+    static V shiftRight1(V a) { return _mm_srli_epi64(a, 1); }
+    static V shiftLeft63(V a) { return _mm_slli_epi64(a, 63); }
+    static V shiftRight63(V a) { return _mm_srli_epi64(a, 63); }
+};
+
+void stepRowSse2(const std::uint64_t* above, const std::uint64_t* row, const std::uint64_t* below, std::uint64_t* out, std::size_t words) {
+    dense_kernel_detail::stepRow<Sse2Ops>(above, row, below, out, words);
+}
+
+void stepRowRuleSse2(const std::uint64_t* above, const std::uint64_t* row, const std::uint64_t* below, std::uint64_t* out, std::size_t words,
+                    const LifeRule& rule) {
+    dense_kernel_detail::stepRowAnyRule<Sse2Ops>(above, row, below, out, words, rule);
+}
+
+#ifdef GAME_OF_LIFE_AVX2_KERNEL
+bool cpuSupportsAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif // GAME_OF_LIFE_AVX2_KERNEL
+#endif // GAME_OF_LIFE_X86
+
+#ifdef GAME_OF_LIFE_NEON
+struct NeonOps {
+    using V = uint64x2_t;
+    static constexpr std::size_t LANES = 2;
+
+    static V load(const std::uint64_t* p) { return vld1q_u64(p); }
+    static void store(std::uint64_t* p, V v) { vst1q_u64(p, v); }
+    static V bitXor(V a, V b) { return veorq_u64(a, b); }
+    static V bitAnd(V a, V b) { return vandq_u64(a, b); }
+    static V bitOr(V a, V b) { return vorrq_u64(a, b); }
+    static V andNot(V a, V b) { return vbicq_u64(b, a); } // b & ~a
+    static V shiftLeft1(V a) { return vshlq_n_u64(a, 1); }
+    static V shiftRight1(V a) { return vshrq_n_u64(a, 1); }
+    static V shiftLeft63(V a) { return vshlq_n_u64(a, 63); }
+    static V shiftRight63(V a) { return vshrq_n_u64(a, 63); }
+};
+
+void stepRowNeon(const std::uint64_t* above, const std::uint64_t* row, const std::uint64_t* below, std::uint64_t* out, std::size_t words) {
+    dense_kernel_detail::stepRow<NeonOps>(above, row, below, out, words);
+}
+
+void stepRowRuleNeon(const std::uint64_t* above, const std::uint64_t* row, const std::uint64_t* below, std::uint64_t* out, std::size_t words,
+                    const LifeRule& rule) {
+    dense_kernel_detail::stepRowAnyRule<NeonOps>(above, row, below, out, words, rule);
+}
+#endif // GAME_OF_LIFE_NEON
+
+} // namespace
+
+std::vector<DenseKernel> availableDenseKernels() {
+    std::vector<DenseKernel> kernels;
+    kernels.push_back({"scalar", &stepRowScalar, &stepRowRuleScalar});
+
+#ifdef GAME_OF_LIFE_X86
+    kernels.push_back({"sse2", &stepRowSse2, &stepRowRuleSse2});
+#ifdef GAME_OF_LIFE_AVX2_KERNEL
+    if (cpuSupportsAvx2()) {
+        kernels.push_back({"avx2", &stepRowAvx2, &stepRowRuleAvx2});
+    }
+#endif
+#endif
+
+#ifdef GAME_OF_LIFE_NEON
+    kernels.push_back({"neon", &stepRowNeon, &stepRowRuleNeon});
+#endif
+
+    return kernels;
+}
+
+const DenseKernel& selectDenseKernel() {
+    // Kernels are listed from least to most capable
+    static const DenseKernel best = availableDenseKernels().back();
+    return best;
+}
+
+const DenseKernel* findDenseKernel(const char* name) {
+    static const std::vector<DenseKernel> kernels = availableDenseKernels();
+    for (const auto& kernel : kernels) {
+        if (std::strcmp(kernel.name, name) == 0) {
+            return &kernel;
+        }
+    }
+    return nullptr;
+}
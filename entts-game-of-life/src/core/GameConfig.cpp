@@ -2,6 +2,27 @@
 #include <fstream>
 #include <stdexcept>
 
+const char* storageEngineName(StorageEngine engine) {
+    switch (engine) {
+        case StorageEngine::Dense: return "dense";
+        case StorageEngine::HashLife: return "hashlife";
+        case StorageEngine::Tiled: return "tiled";
+        case StorageEngine::Packed: return "packed";
+        case StorageEngine::Chunked: return "chunked";
+        default: return "sparse";
+    }
+}
+
+std::optional<StorageEngine> storageEngineFromName(const std::string& name) {
+    for (StorageEngine engine : {StorageEngine::Sparse, StorageEngine::Dense, StorageEngine::HashLife,
+                                 StorageEngine::Tiled, StorageEngine::Packed, StorageEngine::Chunked}) {
+        if (name == storageEngineName(engine)) {
+            return engine;
+        }
+    }
+    return std::nullopt;
+}
+
 GameConfig::GameConfig() {
     setDefaults();
 }
@@ -17,11 +38,27 @@ nlohmann::json GameConfig::toJson() const {
     json["simulation"]["auto_pause_on_stable"] = autoPauseOnStable_;
     json["simulation"]["stable_detection_cycles"] = stableDetectionCycles_;
     json["simulation"]["step_delay_ms"] = stepDelayMs_;
+    json["simulation"]["rule"] = rule_.toString();
+    json["simulation"]["checkpoint_path"] = checkpointPath_;
+    json["simulation"]["checkpoint_interval"] = checkpointInterval_;
+    json["simulation"]["generations_per_frame"] = generationsPerFrame_;
+    json["simulation"]["frame_step_budget_ms"] = frameStepBudgetMs_;
     
     json["performance"]["target_fps"] = targetFps_;
     json["performance"]["memory_limit_mb"] = memoryLimitMb_;
     json["performance"]["enable_spatial_optimization"] = enableSpatialOptimization_;
     json["performance"]["batch_size"] = batchSize_;
+    json["performance"]["storage_engine"] = storageEngineName(storageEngine_);
+    json["performance"]["hashlife_step_log2"] = hashLifeStepLog2_;
+    json["performance"]["worker_threads"] = workerThreads_;
+    json["performance"]["numa_placement"] = numaPlacement_;
+    json["performance"]["pin_worker_threads"] = pinWorkerThreads_;
+    json["performance"]["numa_node_limit"] = numaNodeLimit_;
+    json["performance"]["adaptive_storage"] = adaptiveStorage_;
+    json["performance"]["dense_density_threshold"] = denseDensityThreshold_;
+    json["performance"]["sparse_density_threshold"] = sparseDensityThreshold_;
+    json["performance"]["cell_sort_interval"] = cellSortInterval_;
+    json["performance"]["history_budget_mb"] = historyBudgetMb_;
     
     return json;
 }
@@ -56,6 +93,26 @@ void GameConfig::fromJson(const nlohmann::json& json) {
         if (simulation.contains("step_delay_ms")) {
             stepDelayMs_ = simulation["step_delay_ms"];
         }
+        if (simulation.contains("rule")) {
+            const std::string text = simulation["rule"];
+            const auto rule = LifeRule::parse(text);
+            if (!rule) {
+                throw std::runtime_error("Invalid rule: " + text);
+            }
+            rule_ = *rule;
+        }
+        if (simulation.contains("checkpoint_path")) {
+            checkpointPath_ = simulation["checkpoint_path"];
+        }
+        if (simulation.contains("checkpoint_interval")) {
+            checkpointInterval_ = simulation["checkpoint_interval"];
+        }
+        if (simulation.contains("generations_per_frame")) {
+            generationsPerFrame_ = simulation["generations_per_frame"];
+        }
+        if (simulation.contains("frame_step_budget_ms")) {
+            frameStepBudgetMs_ = simulation["frame_step_budget_ms"];
+        }
     }
     
     // Performance settings
@@ -73,6 +130,42 @@ void GameConfig::fromJson(const nlohmann::json& json) {
         if (performance.contains("batch_size")) {
             batchSize_ = performance["batch_size"];
         }
+        if (performance.contains("storage_engine")) {
+            // Unknown engine names keep the current setting
+            if (const auto engine = storageEngineFromName(performance["storage_engine"].get<std::string>())) {
+                storageEngine_ = *engine;
+            }
+        }
+        if (performance.contains("hashlife_step_log2")) {
+            hashLifeStepLog2_ = performance["hashlife_step_log2"];
+        }
+        if (performance.contains("worker_threads")) {
+            workerThreads_ = performance["worker_threads"];
+        }
+        if (performance.contains("numa_placement")) {
+            numaPlacement_ = performance["numa_placement"];
+        }
+        if (performance.contains("pin_worker_threads")) {
+            pinWorkerThreads_ = performance["pin_worker_threads"];
+        }
+        if (performance.contains("numa_node_limit")) {
+            numaNodeLimit_ = performance["numa_node_limit"];
+        }
+        if (performance.contains("adaptive_storage")) {
+            adaptiveStorage_ = performance["adaptive_storage"];
+        }
+        if (performance.contains("dense_density_threshold")) {
+            denseDensityThreshold_ = performance["dense_density_threshold"];
+        }
+        if (performance.contains("sparse_density_threshold")) {
+            sparseDensityThreshold_ = performance["sparse_density_threshold"];
+        }
+        if (performance.contains("cell_sort_interval")) {
+            cellSortInterval_ = performance["cell_sort_interval"];
+        }
+        if (performance.contains("history_budget_mb")) {
+            historyBudgetMb_ = performance["history_budget_mb"];
+        }
     }
 }
 
@@ -115,6 +208,12 @@ bool GameConfig::isValid() const {
     if (stepDelayMs_ < 0) {
         return false;
     }
+    if (checkpointInterval_ < 0 || (checkpointInterval_ > 0 && checkpointPath_.empty())) {
+        return false;
+    }
+    if (generationsPerFrame_ <= 0 || frameStepBudgetMs_ < 0) {
+        return false;
+    }
     
     // Performance validation
     if (targetFps_ <= 0) {
@@ -126,6 +225,22 @@ bool GameConfig::isValid() const {
     if (batchSize_ <= 0) {
         return false;
     }
+    if (hashLifeStepLog2_ < 0 || hashLifeStepLog2_ > 48) {
+        return false;
+    }
+    if (workerThreads_ < 0 || numaNodeLimit_ < 0) {
+        return false;
+    }
+    if (cellSortInterval_ < 0) {
+        return false;
+    }
+    if (historyBudgetMb_ < 0) {
+        return false;
+    }
+    if (sparseDensityThreshold_ < 0.0 || sparseDensityThreshold_ >= denseDensityThreshold_ ||
+        denseDensityThreshold_ > 1.0) {
+        return false;
+    }
     
     return true;
 }
@@ -139,9 +254,25 @@ void GameConfig::setDefaults() {
     autoPauseOnStable_ = true;
     stableDetectionCycles_ = 10;
     stepDelayMs_ = 100;
+    rule_ = LifeRule{};
+    checkpointPath_.clear();
+    checkpointInterval_ = 0;
+    generationsPerFrame_ = 1;
+    frameStepBudgetMs_ = 0;
     
     targetFps_ = 60;
     memoryLimitMb_ = 100;
     enableSpatialOptimization_ = true;
     batchSize_ = 1000;
+    storageEngine_ = StorageEngine::Sparse;
+    hashLifeStepLog2_ = 0;
+    workerThreads_ = 0;
+    numaPlacement_ = false;
+    pinWorkerThreads_ = false;
+    numaNodeLimit_ = 0;
+    adaptiveStorage_ = false;
+    denseDensityThreshold_ = 0.0002;
+    sparseDensityThreshold_ = 0.0001;
+    cellSortInterval_ = 64;
+    historyBudgetMb_ = 16;
 }
\ No newline at end of file
@@ -1,25 +1,92 @@
 #include "core/GameOfLifeSimulation.h"
+#include "core/Topology.h"
+#include "core/Trace.h"
 #include <algorithm>
+#include <limits>
+#include <utility>
 #include <vector>
-#include <unordered_set>
 
 GameOfLifeSimulation::GameOfLifeSimulation(const GameConfig& config) 
     : config_(config) {
+    createStorage();
 }
 
+std::unique_ptr<LifeEngine> createLifeEngine(const GameConfig& config) {
+    // Every storage engine lives behind GameOfLifeSimulation today
+    return std::make_unique<GameOfLifeSimulation>(config);
+}
+
+void skipSettledSteps(LifeEngine& engine, std::uint64_t startGeneration, std::uint64_t taken, std::uint64_t steps) {
+    if (taken == 0 || taken >= steps) {
+        return;
+    }
+    const std::uint64_t generation = engine.getGenerationCount();
+    const std::uint64_t perStep = (generation - startGeneration) / taken;
+    const std::uint64_t skipped = steps - taken;
+    const std::uint64_t room = std::numeric_limits<std::uint64_t>::max() - generation;
+    engine.setGenerationCount(perStep != 0 && skipped > room / perStep ? std::numeric_limits<std::uint64_t>::max()
+                                                                       : generation + skipped * perStep);
+}
+
+bool exceedsMemoryLimit(const LifeEngine& engine) {
+    const auto limitMb = static_cast<std::size_t>(std::max(engine.getConfig().getMemoryLimitMb(), 0));
+    return limitMb > 0 && engine.getMemoryUsage() > limitMb * 1024 * 1024;
+}
+
+namespace {
+
+// Packed components and entities plus the sparse entity-to-index pages
+template <typename Storage>
+std::size_t storageBytes(const Storage* storage, std::size_t componentSize) {
+    if (!storage) {
+        return 0;
+    }
+    return storage->capacity() * (componentSize + sizeof(entt::entity)) + storage->extent() * sizeof(entt::entity);
+}
+
+std::size_t registryBytes(const entt::registry& registry) {
+    return storageBytes(registry.storage<entt::entity>(), 0) +
+           storageBytes(registry.storage<Position>(), sizeof(Position)) +
+           storageBytes(registry.storage<Cell>(), sizeof(Cell));
+}
+
+} // namespace
+
 void GameOfLifeSimulation::setCellAlive(std::int32_t x, std::int32_t y) {
+    if (hashLife_) {
+        hashLife_->setCell(x, y, true);
+        return;
+    }
+    if (chunkedPlane_) {
+        chunkedPlane_->setCell(x, y, true);
+        return;
+    }
+    
     if (!isValidPosition(x, y)) {
         return;
     }
     
     Position pos = normalizePosition(x, y);
     
+    if (denseGrid_) {
+        denseGrid_->setCell(pos.x, pos.y, true);
+        return;
+    }
+    if (tiledGrid_) {
+        tiledGrid_->setCell(pos.x, pos.y, true);
+        return;
+    }
+    if (packedCells_) {
+        packedCells_->setCell(pos.x, pos.y, true);
+        clearMaterializedEntities();
+        return;
+    }
+    
     // Check if entity already exists at this position
     auto it = spatialIndex_.find(pos);
     if (it != spatialIndex_.end()) {
         // Entity already exists, just ensure it's alive
-        auto& cell = registry_.get<Cell>(it->second);
-        cell.alive = true;
+        reviveCell(it->second);
         return;
     }
     
@@ -29,84 +96,547 @@ void GameOfLifeSimulation::setCellAlive(std::int32_t x, std::int32_t y) {
     registry_.emplace<Cell>(entity, true);
     
     // Add to spatial index
-    spatialIndex_[pos] = entity;
+    spatialIndex_[pos] = IndexedCell{entity};
+}
+
+void GameOfLifeSimulation::setCellsAlive(std::span<const Position> cells) {
+    if (hashLife_) {
+        for (const auto& pos : cells) {
+            hashLife_->setCell(pos.x, pos.y, true);
+        }
+        return;
+    }
+    if (chunkedPlane_) {
+        for (const auto& pos : cells) {
+            chunkedPlane_->setCell(pos.x, pos.y, true);
+        }
+        return;
+    }
+    
+    if (packedCells_) {
+        std::vector<Position> normalized;
+        normalized.reserve(cells.size());
+        for (const auto& cell : cells) {
+            if (isValidPosition(cell.x, cell.y)) {
+                normalized.push_back(normalizePosition(cell.x, cell.y));
+            }
+        }
+        packedCells_->setCellsAlive(normalized);
+        clearMaterializedEntities();
+        return;
+    }
+    
+    if (denseGrid_ || tiledGrid_) {
+        // No entities to create; cells go straight into the grid
+        for (const auto& cell : cells) {
+            if (!isValidPosition(cell.x, cell.y)) {
+                continue;
+            }
+            Position pos = normalizePosition(cell.x, cell.y);
+            if (denseGrid_) {
+                denseGrid_->setCell(pos.x, pos.y, true);
+            } else {
+                tiledGrid_->setCell(pos.x, pos.y, true);
+            }
+        }
+        return;
+    }
+    
+    // Keep each new position once; dormant cells are revived in place
+    std::vector<Position> fresh;
+    fresh.reserve(cells.size());
+    for (const auto& cell : cells) {
+        if (!isValidPosition(cell.x, cell.y)) {
+            continue;
+        }
+        Position pos = normalizePosition(cell.x, cell.y);
+        auto it = spatialIndex_.find(pos);
+        if (it == spatialIndex_.end()) {
+            fresh.push_back(pos);
+        } else {
+            reviveCell(it->second);
+        }
+    }
+    std::sort(fresh.begin(), fresh.end());
+    fresh.erase(std::unique(fresh.begin(), fresh.end()), fresh.end());
+    
+    spatialIndex_.reserve(spatialIndex_.size() + fresh.size());
+    
+    std::vector<entt::entity> entities(fresh.size());
+    registry_.create(entities.begin(), entities.end());
+    registry_.insert<Position>(entities.begin(), entities.end(), fresh.begin());
+    registry_.insert<Cell>(entities.begin(), entities.end(), Cell{true});
+    
+    for (std::size_t i = 0; i < fresh.size(); ++i) {
+        spatialIndex_[fresh[i]] = IndexedCell{entities[i]};
+    }
 }
 
 void GameOfLifeSimulation::setCellDead(std::int32_t x, std::int32_t y) {
+    if (hashLife_) {
+        hashLife_->setCell(x, y, false);
+        return;
+    }
+    if (chunkedPlane_) {
+        chunkedPlane_->setCell(x, y, false);
+        return;
+    }
+    
+    if (denseGrid_) {
+        if (isValidPosition(x, y)) {
+            Position pos = normalizePosition(x, y);
+            denseGrid_->setCell(pos.x, pos.y, false);
+        }
+        return;
+    }
+    if (tiledGrid_) {
+        if (isValidPosition(x, y)) {
+            Position pos = normalizePosition(x, y);
+            tiledGrid_->setCell(pos.x, pos.y, false);
+        }
+        return;
+    }
+    if (packedCells_) {
+        if (isValidPosition(x, y)) {
+            Position pos = normalizePosition(x, y);
+            packedCells_->setCell(pos.x, pos.y, false);
+            clearMaterializedEntities();
+        }
+        return;
+    }
+    
     Position pos = normalizePosition(x, y);
     
     auto it = spatialIndex_.find(pos);
     if (it != spatialIndex_.end()) {
-        // Remove from registry and spatial index
-        registry_.destroy(it->second);
+        // Remove from registry and spatial index; a dormant entry's queue slot goes stale
+        if (!it->second.alive) {
+            --dormantCount_;
+        }
+        registry_.destroy(it->second.entity);
         spatialIndex_.erase(it);
     }
 }
 
 bool GameOfLifeSimulation::isCellAlive(std::int32_t x, std::int32_t y) const {
-    Position pos = normalizePosition(x, y);
+    if (hashLife_) {
+        return hashLife_->getCell(x, y);
+    }
+    if (chunkedPlane_) {
+        return chunkedPlane_->getCell(x, y);
+    }
     
-    auto it = spatialIndex_.find(pos);
-    if (it == spatialIndex_.end()) {
-        return false;
+    if (denseGrid_) {
+        if (!isValidPosition(x, y)) {
+            return false;
+        }
+        Position pos = normalizePosition(x, y);
+        return denseGrid_->getCell(pos.x, pos.y);
+    }
+    if (tiledGrid_) {
+        if (!isValidPosition(x, y)) {
+            return false;
+        }
+        Position pos = normalizePosition(x, y);
+        return tiledGrid_->getCell(pos.x, pos.y);
+    }
+    if (packedCells_) {
+        if (!isValidPosition(x, y)) {
+            return false;
+        }
+        Position pos = normalizePosition(x, y);
+        return packedCells_->getCell(pos.x, pos.y);
     }
     
-    const auto& cell = registry_.get<Cell>(it->second);
-    return cell.alive;
+    return isSparseCellAlive(normalizePosition(x, y));
 }
 
 bool GameOfLifeSimulation::step() {
-    // Store state before changes
-    auto previousCellCount = spatialIndex_.size();
-    auto previousCells = spatialIndex_; // Copy for comparison
+    GOL_TRACE_SCOPE("GameOfLifeSimulation::step");
+    bornCells_.clear();
+    diedCells_.clear();
+    
+    if (hashLife_) {
+        bool changed = hashLife_->step();
+        hashLife_->collectChanges(bornCells_, diedCells_);
+        generationCount_ += hashLife_->getGenerationsPerStep();
+        return changed;
+    }
     
-    updateNeighborCounts();
-    applyConwayRules();
+    if (denseGrid_) {
+        bool changed = denseGrid_->step();
+        denseGrid_->collectChanges(bornCells_, diedCells_);
+        ++generationCount_;
+        return changed;
+    }
+    if (tiledGrid_) {
+        bool changed = tiledGrid_->step();
+        tiledGrid_->collectChanges(bornCells_, diedCells_);
+        ++generationCount_;
+        return changed;
+    }
+    if (chunkedPlane_) {
+        bool changed = chunkedPlane_->step();
+        chunkedPlane_->collectChanges(bornCells_, diedCells_);
+        ++generationCount_;
+        return changed;
+    }
+    if (packedCells_) {
+        bool changed = packedCells_->step();
+        packedCells_->collectChanges(bornCells_, diedCells_);
+        if (changed) {
+            clearMaterializedEntities();
+        }
+        ++generationCount_;
+        return changed;
+    }
+    
+    // The topology is fixed for the whole step, so the neighbor loops below
+    // are instantiated without a wrap test per neighbor
+    withTopology(config_.getGridWidth(), config_.getGridHeight(), config_.getWrapEdges(),
+                 [this](const auto& topology) {
+                     updateNeighborCounts(topology);
+                     applyRules(topology);
+                 });
     cleanupDeadCells();
     ++generationCount_;
     
-    // Check if any changes occurred
-    if (spatialIndex_.size() != previousCellCount) {
-        return true; // Cell count changed
+    const auto sortInterval = static_cast<std::uint64_t>(config_.getCellSortInterval());
+    if (sortInterval != 0 && generationCount_ % sortInterval == 0) {
+        sortCells();
     }
     
-    // Check if cell positions changed
-    for (const auto& [pos, entity] : spatialIndex_) {
-        if (previousCells.find(pos) == previousCells.end()) {
-            return true; // New cell position
-        }
+    return !bornCells_.empty() || !diedCells_.empty();
+}
+
+std::uint64_t GameOfLifeSimulation::advance(std::uint64_t steps) {
+    constexpr auto kBlock = static_cast<std::uint64_t>(TiledGrid::kBlockGenerations);
+    if (!tiledGrid_ || steps < kBlock) {
+        return LifeEngine::advance(steps);
     }
     
-    return false; // No changes
+    std::uint64_t taken = 0;
+    while (steps - taken >= kBlock) {
+        bornCells_.clear();
+        diedCells_.clear();
+        const bool changed = tiledGrid_->step(static_cast<std::uint32_t>(kBlock));
+        tiledGrid_->collectChanges(bornCells_, diedCells_);
+        generationCount_ += kBlock;
+        taken += kBlock;
+        if (changed || taken == steps) {
+            continue;
+        }
+        
+        // Unchanged over a block: the board repeats with a period dividing it.
+        // A still life was one when the block began, so stop one step into
+        // it; an oscillator keeps its phase across any number of whole blocks.
+        ++taken;
+        if (!step()) {
+            generationCount_ -= kBlock;
+            return taken - kBlock;
+        }
+        const std::uint64_t skipped = (steps - taken) / kBlock * kBlock;
+        generationCount_ += skipped;
+        taken += skipped;
+        break;
+    }
+    return taken + LifeEngine::advance(steps - taken);
 }
 
 void GameOfLifeSimulation::reset() {
     registry_.clear();
     spatialIndex_.clear();
+    dormantCells_.clear();
+    dormantHead_ = 0;
+    dormantCount_ = 0;
+    bornCells_.clear();
+    diedCells_.clear();
+    if (denseGrid_) {
+        denseGrid_->clear();
+    }
+    if (tiledGrid_) {
+        tiledGrid_->clear();
+    }
+    if (packedCells_) {
+        packedCells_->clear();
+    }
+    if (chunkedPlane_) {
+        chunkedPlane_->clear();
+    }
+    clearMaterializedEntities();
+    if (hashLife_) {
+        hashLife_->clear();
+    }
     generationCount_ = 0;
+    
+    // Buffers keep their capacity for the next run, unless that alone is
+    // over the memory limit: then start afresh so the board can step again
+    if (exceedsMemoryLimit(*this)) {
+        registry_ = entt::registry{};
+        spatialIndex_ = CoordinateMap<IndexedCell>{};
+        dormantCells_ = {};
+        neighborCounts_ = CoordinateMap<std::uint8_t>{};
+        bornCells_ = {};
+        diedCells_ = {};
+        dyingCells_ = {};
+        createStorage();
+    }
 }
 
 std::size_t GameOfLifeSimulation::getLivingCellCount() const {
-    return spatialIndex_.size();
+    if (hashLife_) {
+        return static_cast<std::size_t>(hashLife_->getLivingCellCount());
+    }
+    if (tiledGrid_) {
+        return tiledGrid_->getLivingCellCount();
+    }
+    if (packedCells_) {
+        return packedCells_->getLivingCellCount();
+    }
+    if (chunkedPlane_) {
+        return chunkedPlane_->getLivingCellCount();
+    }
+    return denseGrid_ ? denseGrid_->getLivingCellCount() : spatialIndex_.size() - dormantCount_;
+}
+
+std::size_t GameOfLifeSimulation::getMemoryUsage() const {
+    std::size_t bytes = registryBytes(registry_) + spatialIndex_.getMemoryUsage() + neighborCounts_.getMemoryUsage() +
+                        registryBytes(materializedRegistry_) + materializedIndex_.getMemoryUsage() +
+                        (bornCells_.capacity() + diedCells_.capacity()) * sizeof(Position) +
+                        dyingCells_.capacity() * sizeof(entt::entity) + dormantCells_.capacity() * sizeof(DormantCell);
+    if (denseGrid_) {
+        bytes += denseGrid_->getMemoryUsage();
+    }
+    if (tiledGrid_) {
+        bytes += tiledGrid_->getMemoryUsage();
+    }
+    if (packedCells_) {
+        bytes += packedCells_->getMemoryUsage();
+    }
+    if (chunkedPlane_) {
+        bytes += chunkedPlane_->getMemoryUsage();
+    }
+    if (hashLife_) {
+        bytes += hashLife_->getMemoryUsage();
+    }
+    return bytes;
 }
 
 std::uint8_t GameOfLifeSimulation::getNeighborCount(std::int32_t x, std::int32_t y) const {
+    if (hashLife_) {
+        return hashLife_->countNeighbors(x, y);
+    }
+    if (denseGrid_) {
+        return denseGrid_->countNeighbors(x, y);
+    }
+    if (tiledGrid_) {
+        return tiledGrid_->countNeighbors(x, y);
+    }
+    if (packedCells_) {
+        return packedCells_->countNeighbors(x, y);
+    }
+    if (chunkedPlane_) {
+        return chunkedPlane_->countNeighbors(x, y);
+    }
     return calculateNeighborCount(x, y);
 }
 
+std::vector<Position> GameOfLifeSimulation::getLivingPositions() const {
+    std::vector<Position> positions;
+    positions.reserve(getLivingCellCount());
+    
+    if (denseGrid_) {
+        denseGrid_->collectLivingCells(positions);
+        return positions;
+    }
+    if (tiledGrid_) {
+        tiledGrid_->collectLivingCells(positions);
+        return positions;
+    }
+    if (packedCells_) {
+        packedCells_->collectLivingCells(positions);
+        return positions;
+    }
+    if (hashLife_) {
+        hashLife_->collectLivingCells(positions);
+        return positions;
+    }
+    if (chunkedPlane_) {
+        chunkedPlane_->collectLivingCells(positions);
+        return positions;
+    }
+    
+    auto view = registry_.view<Position, Cell>();
+    for (auto entity : view) {
+        if (view.get<Cell>(entity).alive) {
+            positions.push_back(view.get<Position>(entity));
+        }
+    }
+    return positions;
+}
+
+void GameOfLifeSimulation::collectLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY,
+                                                      std::int32_t maxY, std::vector<Position>& out) const {
+    if (minX > maxX || minY > maxY) {
+        return;
+    }
+    if (hashLife_) {
+        hashLife_->collectLivingCellsInRegion(minX, maxX, minY, maxY, out);
+        return;
+    }
+    if (chunkedPlane_) {
+        chunkedPlane_->collectLivingCellsInRegion(minX, maxX, minY, maxY, out);
+        return;
+    }
+    if (packedCells_) {
+        if (!config_.getWrapEdges()) {
+            packedCells_->collectLivingCellsInRegion(minX, maxX, minY, maxY, out);
+            return;
+        }
+        
+        // Query the grid once per wrapped copy the region overlaps, shifting
+        // the results into viewport coordinates
+        const std::int64_t width = config_.getGridWidth();
+        const std::int64_t height = config_.getGridHeight();
+        auto floorDiv = [](std::int64_t value, std::int64_t divisor) {
+            return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+        };
+        for (std::int64_t tileY = floorDiv(minY, height); tileY <= floorDiv(maxY, height); ++tileY) {
+            for (std::int64_t tileX = floorDiv(minX, width); tileX <= floorDiv(maxX, width); ++tileX) {
+                const std::int64_t offsetX = tileX * width;
+                const std::int64_t offsetY = tileY * height;
+                const std::size_t first = out.size();
+                packedCells_->collectLivingCellsInRegion(
+                    static_cast<std::int32_t>(std::max<std::int64_t>(minX - offsetX, 0)),
+                    static_cast<std::int32_t>(std::min<std::int64_t>(maxX - offsetX, width - 1)),
+                    static_cast<std::int32_t>(std::max<std::int64_t>(minY - offsetY, 0)),
+                    static_cast<std::int32_t>(std::min<std::int64_t>(maxY - offsetY, height - 1)), out);
+                for (std::size_t i = first; i < out.size(); ++i) {
+                    out[i].x = static_cast<std::int32_t>(out[i].x + offsetX);
+                    out[i].y = static_cast<std::int32_t>(out[i].y + offsetY);
+                }
+            }
+        }
+        return;
+    }
+    
+    // Grids read one bit per position; sparse storage probes its index per
+    // position only while the region holds fewer positions than living cells
+    const auto area = static_cast<std::uint64_t>(std::int64_t{maxX} - minX + 1) *
+                      static_cast<std::uint64_t>(std::int64_t{maxY} - minY + 1);
+    if (denseGrid_ || tiledGrid_ || area <= getLivingCellCount()) {
+        for (std::int64_t y = minY; y <= maxY; ++y) {
+            for (std::int64_t x = minX; x <= maxX; ++x) {
+                if (isCellAlive(static_cast<std::int32_t>(x), static_cast<std::int32_t>(y))) {
+                    out.emplace_back(static_cast<std::int32_t>(x), static_cast<std::int32_t>(y));
+                }
+            }
+        }
+        return;
+    }
+    
+    // Larger regions: place every living cell, and each wrapped copy of it, in the region
+    const bool wrap = config_.getWrapEdges();
+    const std::int64_t width = config_.getGridWidth();
+    const std::int64_t height = config_.getGridHeight();
+    auto view = registry_.view<Position, Cell>();
+    for (auto entity : view) {
+        if (!view.get<Cell>(entity).alive) {
+            continue;
+        }
+        const auto& pos = view.get<Position>(entity);
+        if (!wrap) {
+            if (pos.x >= minX && pos.x <= maxX && pos.y >= minY && pos.y <= maxY) {
+                out.push_back(pos);
+            }
+            continue;
+        }
+        
+        const std::int64_t firstX = minX + (((pos.x - std::int64_t{minX}) % width) + width) % width;
+        const std::int64_t firstY = minY + (((pos.y - std::int64_t{minY}) % height) + height) % height;
+        for (std::int64_t y = firstY; y <= maxY; y += height) {
+            for (std::int64_t x = firstX; x <= maxX; x += width) {
+                out.emplace_back(static_cast<std::int32_t>(x), static_cast<std::int32_t>(y));
+            }
+        }
+    }
+}
+
 entt::entity GameOfLifeSimulation::getEntityAt(std::int32_t x, std::int32_t y) const {
+    if (packedCells_) {
+        if (!isCellAlive(x, y)) {
+            return entt::null;
+        }
+        Position pos = normalizePosition(x, y);
+        auto it = materializedIndex_.find(pos);
+        if (it != materializedIndex_.end()) {
+            return it->second;
+        }
+        
+        auto entity = materializedRegistry_.create();
+        materializedRegistry_.emplace<Position>(entity, pos);
+        materializedRegistry_.emplace<Cell>(entity, true, packedCells_->countNeighbors(pos.x, pos.y));
+        materializedIndex_[pos] = entity;
+        return entity;
+    }
+    
     Position pos = normalizePosition(x, y);
     
     auto it = spatialIndex_.find(pos);
-    return it != spatialIndex_.end() ? it->second : entt::null;
+    return it != spatialIndex_.end() && it->second.alive ? it->second.entity : entt::null;
 }
 
 void GameOfLifeSimulation::setConfig(const GameConfig& config) {
     config_ = config;
+    createStorage();
     // Reset simulation when config changes
     reset();
 }
 
+void GameOfLifeSimulation::createStorage() {
+    denseGrid_.reset();
+    tiledGrid_.reset();
+    packedCells_.reset();
+    hashLife_.reset();
+    chunkedPlane_.reset();
+    clearMaterializedEntities();
+    
+    if (config_.getStorageEngine() == StorageEngine::Dense) {
+        denseGrid_ = std::make_unique<DenseGrid>(config_.getGridWidth(), config_.getGridHeight(),
+                                                 config_.getWrapEdges(), config_.getRule());
+    } else if (config_.getStorageEngine() == StorageEngine::Tiled) {
+        WorkerPlacement placement;
+        if (config_.getNumaPlacement()) {
+            placement.topology =
+                NumaTopology::detect().limitedTo(static_cast<std::uint32_t>(config_.getNumaNodeLimit()));
+        }
+        placement.pinThreads = config_.getPinWorkerThreads();
+        tiledGrid_ = std::make_unique<TiledGrid>(config_.getGridWidth(), config_.getGridHeight(),
+                                                 config_.getWrapEdges(),
+                                                 static_cast<std::uint32_t>(config_.getWorkerThreads()),
+                                                 config_.getRule(), std::move(placement));
+    } else if (config_.getStorageEngine() == StorageEngine::Packed) {
+        packedCells_ = std::make_unique<PackedLiveSet>(config_.getGridWidth(), config_.getGridHeight(),
+                                                       config_.getWrapEdges(), config_.getRule());
+    } else if (config_.getStorageEngine() == StorageEngine::HashLife) {
+        // Half the memory limit bounds the node store (0 = unbounded), so
+        // collection keeps it clear of the limit steps are refused at
+        std::size_t maxNodes = static_cast<std::size_t>(config_.getMemoryLimitMb()) * 1024 * 1024 / 2 /
+                               HashLifeUniverse::bytesPerNode();
+        hashLife_ = std::make_unique<HashLifeUniverse>(maxNodes, config_.getRule());
+        hashLife_->setStepLog2(static_cast<std::uint32_t>(config_.getHashLifeStepLog2()));
+    } else if (config_.getStorageEngine() == StorageEngine::Chunked) {
+        chunkedPlane_ = std::make_unique<ChunkedPlane>(config_.getRule());
+    }
+}
+
+void GameOfLifeSimulation::clearMaterializedEntities() {
+    if (!materializedIndex_.empty()) {
+        materializedRegistry_.clear();
+        materializedIndex_.clear();
+    }
+}
+
 bool GameOfLifeSimulation::isValidPosition(std::int32_t x, std::int32_t y) const {
     if (config_.getWrapEdges()) {
         return true; // All positions are valid with wrapping
@@ -129,108 +659,186 @@ Position GameOfLifeSimulation::normalizePosition(std::int32_t x, std::int32_t y)
 }
 
 std::uint8_t GameOfLifeSimulation::calculateNeighborCount(std::int32_t x, std::int32_t y) const {
-    std::uint8_t count = 0;
-    
-    for (const auto& [dx, dy] : neighborOffsets) {
-        std::int32_t neighborX = x + dx;
-        std::int32_t neighborY = y + dy;
-        
-        if (config_.getWrapEdges()) {
-            // Normalize neighbor position with wrapping
-            Position neighborPos = normalizePosition(neighborX, neighborY);
-            if (spatialIndex_.find(neighborPos) != spatialIndex_.end()) {
+    if (!isValidPosition(x, y)) {
+        // Off a bounded grid: only the in-grid neighbors count
+        std::uint8_t count = 0;
+        for (const auto& [dx, dy] : neighborOffsets) {
+            if (isValidPosition(x + dx, y + dy) && isSparseCellAlive(Position(x + dx, y + dy))) {
                 ++count;
             }
-        } else {
-            // Check bounds for non-wrapping grid
-            if (neighborX >= 0 && neighborX < config_.getGridWidth() &&
-                neighborY >= 0 && neighborY < config_.getGridHeight()) {
-                Position neighborPos(neighborX, neighborY);
-                if (spatialIndex_.find(neighborPos) != spatialIndex_.end()) {
-                    ++count;
-                }
-            }
         }
+        return count;
     }
-    
+    return withTopology(config_.getGridWidth(), config_.getGridHeight(), config_.getWrapEdges(),
+                        [&](const auto& topology) { return countNeighbors(topology, normalizePosition(x, y)); });
+}
+
+template <typename Topology>
+std::uint8_t GameOfLifeSimulation::countNeighbors(const Topology& topology, Position pos) const {
+    std::uint8_t count = 0;
+    forEachNeighbor(topology, pos, [&](Position neighbor) {
+        if (isSparseCellAlive(neighbor)) {
+            ++count;
+        }
+    });
     return count;
 }
 
-void GameOfLifeSimulation::updateNeighborCounts() {
+template <typename Topology>
+void GameOfLifeSimulation::updateNeighborCounts(const Topology& topology) {
+    GOL_TRACE_SCOPE("GameOfLifeSimulation::updateNeighborCounts");
     // Update neighbor counts for all living cells
     auto view = registry_.view<Position, Cell>();
     for (auto entity : view) {
-        const auto& pos = view.get<Position>(entity);
         auto& cell = view.get<Cell>(entity);
-        cell.neighborCount = calculateNeighborCount(pos.x, pos.y);
+        if (cell.alive) {
+            cell.neighborCount = countNeighbors(topology, view.get<Position>(entity));
+        }
     }
 }
 
-void GameOfLifeSimulation::applyConwayRules() {
-    std::vector<Position> cellsToCreate;
-    std::vector<entt::entity> cellsToDestroy;
-    
-    // Check all cells that might be affected
-    std::unordered_set<Position> cellsToCheck;
-    
-    // Add all living cells and their neighbors to check list
-    auto view = registry_.view<Position, Cell>();
-    for (auto entity : view) {
-        const auto& pos = view.get<Position>(entity);
-        cellsToCheck.insert(pos);
-        
-        // Add all neighbor positions
-        for (const auto& [dx, dy] : neighborOffsets) {
-            std::int32_t neighborX = pos.x + dx;
-            std::int32_t neighborY = pos.y + dy;
-            if (isValidPosition(neighborX, neighborY)) {
-                Position neighborPos = normalizePosition(neighborX, neighborY);
-                cellsToCheck.insert(neighborPos);
+template <typename Topology>
+void GameOfLifeSimulation::applyRules(const Topology& topology) {
+    GOL_TRACE_SCOPE("GameOfLifeSimulation::applyRules");
+    // Scratch buffers are members, cleared with their capacity kept, so a
+    // warmed-up step allocates nothing
+    dyingCells_.clear();
+    neighborCounts_.clear();
+
+    withLifeRule(config_.getRule(), [&](const auto& rule) {
+        // Living cells decide on the counts updateNeighborCounts() just stored,
+        // and add one to each neighbor so dead positions get theirs in the same pass
+        auto view = registry_.view<Position, Cell>();
+        for (auto entity : view) {
+            const auto& cell = view.get<Cell>(entity);
+            if (!cell.alive) {
+                continue;
             }
+            const auto& pos = view.get<Position>(entity);
+
+            // Cell dies unless the rule's survival counts include its neighbors
+            if (!rule.nextState(true, cell.neighborCount)) {
+                dyingCells_.push_back(entity);
+            }
+
+            forEachNeighbor(topology, pos, [this](Position neighbor) { ++neighborCounts_[neighbor]; });
         }
-    }
-    
-    // Apply Conway's rules to each cell
-    for (const auto& pos : cellsToCheck) {
-        bool isCurrentlyAlive = (spatialIndex_.find(pos) != spatialIndex_.end());
-        std::uint8_t neighbors = calculateNeighborCount(pos.x, pos.y);
-        
-        if (isCurrentlyAlive) {
-            // Rules for living cells
-            if (neighbors < 2 || neighbors > 3) {
-                // Cell dies (underpopulation or overpopulation)
-                auto it = spatialIndex_.find(pos);
-                if (it != spatialIndex_.end()) {
-                    cellsToDestroy.push_back(it->second);
-                }
+
+        // Dead cell with a birth count of neighbors is born
+        for (const auto& [pos, neighbors] : neighborCounts_) {
+            if (rule.nextState(false, neighbors) && !isSparseCellAlive(pos)) {
+                bornCells_.push_back(pos);
             }
-            // Cells with 2 or 3 neighbors survive (no action needed)
+        }
+    });
+
+    // Apply changes, recording them so step() can report change without a
+    // snapshot. Dying cells keep their entity and index entry as dormant.
+    const auto generation = static_cast<std::uint32_t>(generationCount_);
+    for (auto entity : dyingCells_) {
+        const auto& pos = registry_.get<Position>(entity);
+        diedCells_.push_back(pos);
+        auto& indexed = spatialIndex_.find(pos)->second;
+        indexed.alive = false;
+        indexed.diedAt = generation;
+        registry_.get<Cell>(entity).alive = false;
+        dormantCells_.push_back(DormantCell{pos, generation});
+        ++dormantCount_;
+    }
+
+    // Births revive a dormant cell at their position, else take over an
+    // expired one, and only create an entity when there is neither
+    for (const auto& pos : bornCells_) {
+        auto it = spatialIndex_.find(pos);
+        if (it != spatialIndex_.end()) {
+            reviveCell(it->second);
+            continue;
+        }
+
+        auto entity = takeExpiredEntity();
+        if (entity == entt::null) {
+            entity = registry_.create();
+            registry_.emplace<Position>(entity, pos);
+            registry_.emplace<Cell>(entity, true);
         } else {
-            // Rules for dead cells
-            if (neighbors == 3) {
-                // Cell is born (reproduction)
-                cellsToCreate.push_back(pos);
+            registry_.get<Position>(entity) = pos;
+            registry_.get<Cell>(entity) = Cell{true};
+        }
+        spatialIndex_[pos] = IndexedCell{entity};
+    }
+}
+
+void GameOfLifeSimulation::cleanupDeadCells() {
+    // Periodic compaction: destroy the dormant entities no birth took in
+    // time, and drop the consumed and stale queue entries
+    if (generationCount_ % kDormantGenerations != 0) {
+        return;
+    }
+
+    const auto generation = static_cast<std::uint32_t>(generationCount_);
+    while (dormantHead_ < dormantCells_.size()) {
+        const auto& dormant = dormantCells_[dormantHead_];
+        if (isCurrentDormant(dormant)) {
+            if (generation - dormant.diedAt < kDormantGenerations) {
+                break; // Later entries died later still
             }
+            auto it = spatialIndex_.find(dormant.pos);
+            registry_.destroy(it->second.entity);
+            spatialIndex_.erase(it);
+            --dormantCount_;
         }
+        ++dormantHead_;
     }
-    
-    // Apply changes
-    for (auto entity : cellsToDestroy) {
-        const auto& pos = registry_.get<Position>(entity);
-        spatialIndex_.erase(pos);
-        registry_.destroy(entity);
+    dormantCells_.erase(dormantCells_.begin(), dormantCells_.begin() + static_cast<std::ptrdiff_t>(dormantHead_));
+    dormantHead_ = 0;
+}
+
+bool GameOfLifeSimulation::isSparseCellAlive(const Position& pos) const {
+    auto it = spatialIndex_.find(pos);
+    return it != spatialIndex_.end() && it->second.alive;
+}
+
+void GameOfLifeSimulation::reviveCell(IndexedCell& indexed) {
+    if (!indexed.alive) {
+        indexed.alive = true;
+        registry_.get<Cell>(indexed.entity).alive = true;
+        --dormantCount_;
     }
-    
-    for (const auto& pos : cellsToCreate) {
-        auto entity = registry_.create();
-        registry_.emplace<Position>(entity, pos);
-        registry_.emplace<Cell>(entity, true);
-        spatialIndex_[pos] = entity;
+}
+
+bool GameOfLifeSimulation::isCurrentDormant(const DormantCell& dormant) const {
+    auto it = spatialIndex_.find(dormant.pos);
+    return it != spatialIndex_.end() && !it->second.alive && it->second.diedAt == dormant.diedAt;
+}
+
+entt::entity GameOfLifeSimulation::takeExpiredEntity() {
+    const auto generation = static_cast<std::uint32_t>(generationCount_);
+    while (dormantHead_ < dormantCells_.size()) {
+        const DormantCell dormant = dormantCells_[dormantHead_];
+        if (!isCurrentDormant(dormant)) {
+            ++dormantHead_;
+            continue;
+        }
+        if (generation - dormant.diedAt < kDormantGenerations) {
+            return entt::null; // Even the oldest may still be revived in place
+        }
+
+        auto it = spatialIndex_.find(dormant.pos);
+        const auto entity = it->second.entity;
+        spatialIndex_.erase(it);
+        --dormantCount_;
+        ++dormantHead_;
+        return entity;
     }
+    return entt::null;
 }
 
-void GameOfLifeSimulation::cleanupDeadCells() {
-    // In this implementation, dead cells are immediately removed,
-    // so no cleanup is needed. This method is here for future optimization
-    // where we might keep dead cells for a while to avoid recreation costs.
+void GameOfLifeSimulation::sortCells() {
+    GOL_TRACE_SCOPE("GameOfLifeSimulation::sortCells");
+    // Births append to the pools and destroyed cells are swapped with the last
+    // one, so iteration order drifts away from space. Putting the pools back in Z-order makes the
+    // neighbors of a cell mostly its neighbors in Position and Cell storage
+    // too; Cell follows Position so the view reads both sequentially.
+    registry_.sort<Position>([](const Position& a, const Position& b) { return a.morton() < b.morton(); });
+    registry_.sort<Cell, Position>();
 }
\ No newline at end of file
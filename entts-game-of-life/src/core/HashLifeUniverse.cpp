@@ -0,0 +1,385 @@
+#include "core/HashLifeUniverse.h"
+#include "core/Trace.h"
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <stdexcept>
+
+namespace {
+
+// Roots beyond this level would overflow 64-bit coordinates
+constexpr std::uint32_t kMaxLevel = 62;
+
+} // namespace
+
+HashLifeUniverse::HashLifeUniverse(std::size_t maxNodes, const LifeRule& rule)
+    : maxNodes_(maxNodes)
+    , rule_(rule) {
+    aliveLeaf_.population = 1;
+    clear();
+}
+
+void HashLifeUniverse::setCell(std::int64_t x, std::int64_t y, bool alive) {
+    if (!contains(x, y)) {
+        if (!alive) {
+            return; // Already dead
+        }
+        while (!contains(x, y)) {
+            root_ = expand(root_);
+        }
+    }
+
+    std::int64_t half = std::int64_t{1} << (root_->level - 1);
+    root_ = setCell(root_, x + half, y + half, alive);
+}
+
+bool HashLifeUniverse::getCell(std::int64_t x, std::int64_t y) const {
+    if (!contains(x, y)) {
+        return false;
+    }
+
+    std::int64_t half = std::int64_t{1} << (root_->level - 1);
+    x += half;
+    y += half;
+
+    const Node* node = root_;
+    while (node->level > 0 && node->population != 0) {
+        half = std::int64_t{1} << (node->level - 1);
+        bool east = x >= half;
+        bool south = y >= half;
+        node = south ? (east ? node->se : node->sw) : (east ? node->ne : node->nw);
+        x -= east ? half : 0;
+        y -= south ? half : 0;
+    }
+
+    return node->population != 0;
+}
+
+std::uint8_t HashLifeUniverse::countNeighbors(std::int64_t x, std::int64_t y) const {
+    std::uint8_t count = 0;
+
+    for (std::int64_t dy = -1; dy <= 1; ++dy) {
+        for (std::int64_t dx = -1; dx <= 1; ++dx) {
+            if ((dx != 0 || dy != 0) && getCell(x + dx, y + dy)) {
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+void HashLifeUniverse::setStepLog2(std::uint32_t stepLog2) {
+    if (stepLog2 > kMaxStepLog2) {
+        throw std::out_of_range("HashLife step exponent must be at most " + std::to_string(kMaxStepLog2));
+    }
+    // Memoized results record their own step size, so nothing is invalidated here
+    stepLog2_ = stepLog2;
+    advancing_ = false;
+}
+
+bool HashLifeUniverse::step() {
+    GOL_TRACE_SCOPE("HashLifeUniverse::step");
+    if (maxNodes_ != 0 && nodes_.size() > maxNodes_) {
+        collectGarbage();
+    }
+
+    // The result is the centre half of the root, and the pattern can grow by
+    // one cell per generation, so it must start inside the centre quarter
+    while (root_->level < stepLog2_ + 3 || !patternIsCentred()) {
+        root_ = expand(root_);
+    }
+
+    const Node* before = root_;
+    root_ = nextGeneration(root_);
+    generation_ += getGenerationsPerStep();
+
+    // Canonical nodes make equal regions the same pointer
+    const Node* after = expand(root_);
+    if (!advancing_ || changesBefore_ == nullptr) {
+        changesBefore_ = before;
+    }
+    changesAfter_ = after;
+    while (changesBefore_->level < changesAfter_->level) {
+        changesBefore_ = expand(changesBefore_);
+    }
+    while (changesAfter_->level < changesBefore_->level) {
+        changesAfter_ = expand(changesAfter_);
+    }
+
+    return after != before;
+}
+
+void HashLifeUniverse::advance(std::uint64_t generations) {
+    const std::uint32_t stepLog2 = stepLog2_;
+    changesBefore_ = nullptr;
+    changesAfter_ = nullptr;
+    advancing_ = true;
+
+    for (std::uint32_t bit = 0; generations != 0; ++bit, generations >>= 1) {
+        if (generations & 1) {
+            stepLog2_ = bit;
+            step();
+        }
+    }
+
+    stepLog2_ = stepLog2;
+}
+
+void HashLifeUniverse::clear() {
+    nodes_.clear();
+    canonical_.clear();
+    emptyNodes_.clear();
+    root_ = emptyNode(3);
+    changesBefore_ = nullptr;
+    changesAfter_ = nullptr;
+    generation_ = 0;
+}
+
+std::size_t HashLifeUniverse::getMemoryUsage() const {
+    return nodes_.size() * bytesPerNode() + canonical_.bucket_count() * sizeof(void*) +
+           emptyNodes_.capacity() * sizeof(const Node*);
+}
+
+void HashLifeUniverse::collectLivingCells(std::vector<Position>& out) const {
+    collectLivingCellsInRegion(std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max(),
+                               std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max(), out);
+}
+
+void HashLifeUniverse::collectLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY,
+                                                  std::int32_t maxY, std::vector<Position>& out) const {
+    std::int64_t half = std::int64_t{1} << (root_->level - 1);
+    collectLivingCells(root_, -half, -half, minX, maxX, minY, maxY, out);
+}
+
+void HashLifeUniverse::collectChanges(std::vector<Position>& born, std::vector<Position>& died) const {
+    if (changesBefore_ == nullptr || changesBefore_ == changesAfter_) {
+        return;
+    }
+
+    std::int64_t half = std::int64_t{1} << (changesAfter_->level - 1);
+    collectChanges(changesBefore_, changesAfter_, -half, -half, born, died);
+}
+
+const HashLifeUniverse::Node* HashLifeUniverse::makeNode(const Node* nw, const Node* ne,
+                                                         const Node* sw, const Node* se) {
+    NodeKey key{nw, ne, sw, se};
+    auto it = canonical_.find(key);
+    if (it != canonical_.end()) {
+        return it->second;
+    }
+
+    Node& node = nodes_.emplace_back();
+    node.nw = nw;
+    node.ne = ne;
+    node.sw = sw;
+    node.se = se;
+    node.population = nw->population + ne->population + sw->population + se->population;
+    node.level = nw->level + 1;
+
+    canonical_.emplace(key, &node);
+    return &node;
+}
+
+const HashLifeUniverse::Node* HashLifeUniverse::emptyNode(std::uint32_t level) {
+    while (emptyNodes_.size() <= level) {
+        if (emptyNodes_.empty()) {
+            emptyNodes_.push_back(&deadLeaf_);
+        } else {
+            const Node* child = emptyNodes_.back();
+            emptyNodes_.push_back(makeNode(child, child, child, child));
+        }
+    }
+    return emptyNodes_[level];
+}
+
+const HashLifeUniverse::Node* HashLifeUniverse::expand(const Node* node) {
+    if (node->level >= kMaxLevel) {
+        throw std::overflow_error("HashLife pattern outgrew the 64-bit coordinate range");
+    }
+
+    // Same centre, one level up, with the node's quadrants around the middle
+    const Node* empty = emptyNode(node->level - 1);
+    return makeNode(makeNode(empty, empty, empty, node->nw),
+                    makeNode(empty, empty, node->ne, empty),
+                    makeNode(empty, node->sw, empty, empty),
+                    makeNode(node->se, empty, empty, empty));
+}
+
+const HashLifeUniverse::Node* HashLifeUniverse::centre(const Node* node) {
+    return makeNode(node->nw->se, node->ne->sw, node->sw->ne, node->se->nw);
+}
+
+const HashLifeUniverse::Node* HashLifeUniverse::setCell(const Node* node, std::int64_t x, std::int64_t y,
+                                                        bool alive) {
+    if (node->level == 0) {
+        return alive ? &aliveLeaf_ : &deadLeaf_;
+    }
+
+    std::int64_t half = std::int64_t{1} << (node->level - 1);
+    bool east = x >= half;
+    bool south = y >= half;
+    x -= east ? half : 0;
+    y -= south ? half : 0;
+
+    if (south) {
+        return east ? makeNode(node->nw, node->ne, node->sw, setCell(node->se, x, y, alive))
+                    : makeNode(node->nw, node->ne, setCell(node->sw, x, y, alive), node->se);
+    }
+    return east ? makeNode(node->nw, setCell(node->ne, x, y, alive), node->sw, node->se)
+                : makeNode(setCell(node->nw, x, y, alive), node->ne, node->sw, node->se);
+}
+
+const HashLifeUniverse::Node* HashLifeUniverse::nextGeneration(const Node* node) {
+    // A level-n node can be advanced at most 2^(n-2) generations
+    const std::uint32_t stepLog2 = std::min(stepLog2_, node->level - 2);
+    if (node->next != nullptr && node->nextStepLog2 == stepLog2) {
+        return node->next;
+    }
+
+    const Node* result = nullptr;
+    if (node->population == 0) {
+        result = emptyNode(node->level - 1);
+    } else if (node->level == 2) {
+        result = stepLevel2(node);
+    } else {
+        // Two half-steps at full speed; otherwise only the second stage advances
+        const bool fullSpeed = stepLog2 == node->level - 2;
+        auto firstStage = [&](const Node* part) { return fullSpeed ? nextGeneration(part) : centre(part); };
+
+        // Nine overlapping sub-squares, one level down
+        const Node* n00 = firstStage(node->nw);
+        const Node* n01 = firstStage(makeNode(node->nw->ne, node->ne->nw, node->nw->se, node->ne->sw));
+        const Node* n02 = firstStage(node->ne);
+        const Node* n10 = firstStage(makeNode(node->nw->sw, node->nw->se, node->sw->nw, node->sw->ne));
+        const Node* n11 = firstStage(centre(node));
+        const Node* n12 = firstStage(makeNode(node->ne->sw, node->ne->se, node->se->nw, node->se->ne));
+        const Node* n20 = firstStage(node->sw);
+        const Node* n21 = firstStage(makeNode(node->sw->ne, node->se->nw, node->sw->se, node->se->sw));
+        const Node* n22 = firstStage(node->se);
+
+        result = makeNode(nextGeneration(makeNode(n00, n01, n10, n11)),
+                          nextGeneration(makeNode(n01, n02, n11, n12)),
+                          nextGeneration(makeNode(n10, n11, n20, n21)),
+                          nextGeneration(makeNode(n11, n12, n21, n22)));
+    }
+
+    node->next = result;
+    node->nextStepLog2 = stepLog2;
+    return result;
+}
+
+const HashLifeUniverse::Node* HashLifeUniverse::stepLevel2(const Node* node) {
+    // 4x4 cells in, the centre 2x2 one generation later out
+    auto cellAt = [node](int x, int y) -> int {
+        const Node* quadrant = y < 2 ? (x < 2 ? node->nw : node->ne) : (x < 2 ? node->sw : node->se);
+        const Node* leaf = (y & 1) == 0 ? ((x & 1) == 0 ? quadrant->nw : quadrant->ne)
+                                        : ((x & 1) == 0 ? quadrant->sw : quadrant->se);
+        return static_cast<int>(leaf->population);
+    };
+
+    auto nextCell = [&](int x, int y) -> const Node* {
+        int neighbors = 0;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (dx != 0 || dy != 0) {
+                    neighbors += cellAt(x + dx, y + dy);
+                }
+            }
+        }
+        bool alive = rule_.nextState(cellAt(x, y) != 0, static_cast<std::uint32_t>(neighbors));
+        return alive ? &aliveLeaf_ : &deadLeaf_;
+    };
+
+    return makeNode(nextCell(1, 1), nextCell(2, 1), nextCell(1, 2), nextCell(2, 2));
+}
+
+bool HashLifeUniverse::patternIsCentred() const {
+    return root_->nw->population == root_->nw->se->se->population &&
+           root_->ne->population == root_->ne->sw->sw->population &&
+           root_->sw->population == root_->sw->ne->ne->population &&
+           root_->se->population == root_->se->nw->nw->population;
+}
+
+void HashLifeUniverse::collectGarbage() {
+    GOL_TRACE_SCOPE("HashLifeUniverse::collectGarbage");
+    // Rebuild the store with only the nodes reachable from the root
+    std::deque<Node> previous;
+    previous.swap(nodes_);
+    canonical_.clear();
+    emptyNodes_.clear();
+
+    std::unordered_map<const Node*, const Node*> moved;
+    auto copy = [&](auto& self, const Node* node) -> const Node* {
+        if (node->level == 0) {
+            return node;
+        }
+        auto it = moved.find(node);
+        if (it != moved.end()) {
+            return it->second;
+        }
+        const Node* copied = makeNode(self(self, node->nw), self(self, node->ne),
+                                      self(self, node->sw), self(self, node->se));
+        moved.emplace(node, copied);
+        return copied;
+    };
+
+    root_ = copy(copy, root_);
+    if (advancing_ && changesBefore_ != nullptr) {
+        changesBefore_ = copy(copy, changesBefore_); // Still needed by the advance in progress
+        changesAfter_ = copy(copy, changesAfter_);
+    } else {
+        changesBefore_ = nullptr; // Replaced by the step about to run
+        changesAfter_ = nullptr;
+    }
+}
+
+bool HashLifeUniverse::contains(std::int64_t x, std::int64_t y) const {
+    std::int64_t half = std::int64_t{1} << (root_->level - 1);
+    return x >= -half && x < half && y >= -half && y < half;
+}
+
+void HashLifeUniverse::collectLivingCells(const Node* node, std::int64_t x, std::int64_t y, std::int64_t minX,
+                                          std::int64_t maxX, std::int64_t minY, std::int64_t maxY,
+                                          std::vector<Position>& out) const {
+    // Skip empty subtrees and subtrees outside the region
+    std::int64_t size = std::int64_t{1} << node->level;
+    if (node->population == 0 || x > maxX || y > maxY || x + size - 1 < minX || y + size - 1 < minY) {
+        return;
+    }
+
+    if (node->level == 0) {
+        out.emplace_back(static_cast<std::int32_t>(x), static_cast<std::int32_t>(y));
+        return;
+    }
+
+    std::int64_t half = size / 2;
+    collectLivingCells(node->nw, x, y, minX, maxX, minY, maxY, out);
+    collectLivingCells(node->ne, x + half, y, minX, maxX, minY, maxY, out);
+    collectLivingCells(node->sw, x, y + half, minX, maxX, minY, maxY, out);
+    collectLivingCells(node->se, x + half, y + half, minX, maxX, minY, maxY, out);
+}
+
+void HashLifeUniverse::collectChanges(const Node* before, const Node* after, std::int64_t x, std::int64_t y,
+                                      std::vector<Position>& born, std::vector<Position>& died) const {
+    // Canonical nodes make unchanged subtrees the same pointer; skip those and
+    // subtrees outside the int32 range
+    constexpr std::int64_t minCoord = std::numeric_limits<std::int32_t>::min();
+    constexpr std::int64_t maxCoord = std::numeric_limits<std::int32_t>::max();
+    std::int64_t size = std::int64_t{1} << after->level;
+    if (before == after || x > maxCoord || y > maxCoord || x + size - 1 < minCoord || y + size - 1 < minCoord) {
+        return;
+    }
+
+    if (after->level == 0) {
+        auto& out = after->population != 0 ? born : died;
+        out.emplace_back(static_cast<std::int32_t>(x), static_cast<std::int32_t>(y));
+        return;
+    }
+
+    std::int64_t half = size / 2;
+    collectChanges(before->nw, after->nw, x, y, born, died);
+    collectChanges(before->ne, after->ne, x + half, y, born, died);
+    collectChanges(before->sw, after->sw, x, y + half, born, died);
+    collectChanges(before->se, after->se, x + half, y + half, born, died);
+}
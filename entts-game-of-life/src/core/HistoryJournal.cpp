@@ -0,0 +1,247 @@
+#include "core/HistoryJournal.h"
+#include "core/CellEncoding.h"
+#include <algorithm>
+
+namespace {
+
+// Toggles flips into an encoded set of cells
+std::string toggleEncoded(const std::string& encoded, std::span<const Position> flips) {
+    const auto cells = decodeCellFlips(encoded);
+    std::string out;
+    encodeCellFlips(cells, flips, out);
+    out.shrink_to_fit();
+    return out;
+}
+
+// Sorted, with cells listed an even number of times left out
+void cancelPairs(std::vector<Position>& cells) {
+    std::sort(cells.begin(), cells.end());
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < cells.size();) {
+        std::size_t same = i + 1;
+        while (same < cells.size() && cells[same] == cells[i]) {
+            ++same;
+        }
+        if ((same - i) % 2 != 0) {
+            cells[kept++] = cells[i];
+        }
+        i = same;
+    }
+    cells.resize(kept);
+}
+
+void appendDecoded(const std::string& encoded, std::vector<Position>& out) {
+    const auto cells = decodeCellFlips(encoded);
+    out.insert(out.end(), cells.begin(), cells.end());
+}
+
+} // namespace
+
+HistoryJournal::HistoryJournal(std::size_t byteBudget)
+    : byteBudget_(byteBudget) {}
+
+std::size_t HistoryJournal::entryBytes(const Entry& entry) {
+    return sizeof(Entry) + entry.flips.capacity() + entry.keyframe.capacity();
+}
+
+void HistoryJournal::setByteBudget(std::size_t bytes) {
+    byteBudget_ = bytes;
+    if (byteBudget_ == 0) {
+        clear();
+    } else {
+        evict();
+    }
+}
+
+void HistoryJournal::clear() {
+    entries_.clear();
+    cursor_ = 0;
+    keyframes_ = 0;
+    bytes_ = 0;
+}
+
+void HistoryJournal::restart(std::uint64_t generation, std::span<const Position> cells) {
+    clear();
+    if (!isEnabled()) {
+        return;
+    }
+    Entry entry;
+    entry.generation = generation;
+    encodeCellFlips(cells, {}, entry.keyframe);
+    entry.keyframe.shrink_to_fit();
+    entry.hasKeyframe = true;
+    keyframes_ = 1;
+    bytes_ = entryBytes(entry);
+    entries_.push_back(std::move(entry));
+}
+
+void HistoryJournal::recordStep(std::uint64_t generation, std::span<const Position> born,
+                                std::span<const Position> died) {
+    if (!isEnabled() || entries_.empty()) {
+        return;
+    }
+    truncateAfterCursor();
+    if (generation <= entries_.back().generation) {
+        std::vector<Position> flips(born.begin(), born.end());
+        flips.insert(flips.end(), died.begin(), died.end());
+        recordEdit(flips);
+        return;
+    }
+
+    Entry entry;
+    entry.generation = generation;
+    encodeCellFlips(born, died, entry.flips);
+    entry.flips.shrink_to_fit();
+    append(std::move(entry));
+}
+
+bool HistoryJournal::keyframeDue() const {
+    if (!isEnabled() || entries_.empty()) {
+        return false;
+    }
+    std::size_t since = 0;
+    for (auto it = entries_.rbegin(); it != entries_.rend() && !it->hasKeyframe; ++it) {
+        if (++since >= kKeyframeInterval) {
+            return true;
+        }
+    }
+    // One stretch has outgrown the budget; a keyframe lets its start go
+    return since > 0 && keyframes_ == 1 && bytes_ > byteBudget_;
+}
+
+void HistoryJournal::recordKeyframe(std::span<const Position> cells) {
+    if (!isEnabled() || entries_.empty()) {
+        return;
+    }
+    truncateAfterCursor();
+    Entry& entry = entries_.back();
+    bytes_ -= entryBytes(entry);
+    entry.keyframe.clear();
+    encodeCellFlips(cells, {}, entry.keyframe);
+    entry.keyframe.shrink_to_fit();
+    if (!entry.hasKeyframe) {
+        entry.hasKeyframe = true;
+        ++keyframes_;
+    }
+    bytes_ += entryBytes(entry);
+    evict();
+}
+
+void HistoryJournal::recordEdit(std::span<const Position> flips) {
+    if (!isEnabled() || entries_.empty() || flips.empty()) {
+        return;
+    }
+    truncateAfterCursor();
+    Entry& entry = entries_[cursor_];
+    bytes_ -= entryBytes(entry);
+    if (cursor_ > 0) {
+        entry.flips = toggleEncoded(entry.flips, flips);
+    }
+    if (entry.hasKeyframe) {
+        entry.keyframe = toggleEncoded(entry.keyframe, flips);
+    }
+    bytes_ += entryBytes(entry);
+    evict();
+}
+
+std::optional<HistoryMove> HistoryJournal::seek(std::uint64_t generation) {
+    if (entries_.empty()) {
+        return std::nullopt;
+    }
+    auto after = std::upper_bound(entries_.begin(), entries_.end(), generation,
+                                  [](std::uint64_t value, const Entry& entry) { return value < entry.generation; });
+    const auto index = static_cast<std::size_t>(std::max<std::ptrdiff_t>(after - entries_.begin() - 1, 0));
+    return moveTo(index);
+}
+
+std::optional<HistoryMove> HistoryJournal::stepBack() {
+    if (entries_.empty() || cursor_ == 0) {
+        return std::nullopt;
+    }
+    return moveTo(cursor_ - 1);
+}
+
+HistoryMove HistoryJournal::moveTo(std::size_t index) {
+    HistoryMove move;
+    move.generation = entries_[index].generation;
+    if (index == cursor_) {
+        return move;
+    }
+
+    // Entries are charged a byte each as well, so runs of empty steps still count
+    std::size_t keyframe = index;
+    while (!entries_[keyframe].hasKeyframe) {
+        --keyframe;
+    }
+    std::size_t keyframeCost = entries_[keyframe].keyframe.size();
+    for (std::size_t i = keyframe + 1; i <= index; ++i) {
+        keyframeCost += entries_[i].flips.size() + 1;
+    }
+
+    const std::size_t low = std::min(cursor_, index);
+    const std::size_t high = std::max(cursor_, index);
+    std::size_t flipCost = 0;
+    for (std::size_t i = low + 1; i <= high && flipCost <= keyframeCost; ++i) {
+        flipCost += entries_[i].flips.size() + 1;
+    }
+
+    if (flipCost <= keyframeCost) {
+        for (std::size_t i = low + 1; i <= high; ++i) {
+            appendDecoded(entries_[i].flips, move.flips);
+        }
+    } else {
+        move.fromEmpty = true;
+        appendDecoded(entries_[keyframe].keyframe, move.flips);
+        for (std::size_t i = keyframe + 1; i <= index; ++i) {
+            appendDecoded(entries_[i].flips, move.flips);
+        }
+    }
+    cancelPairs(move.flips);
+    cursor_ = index;
+    return move;
+}
+
+void HistoryJournal::truncateAfterCursor() {
+    while (entries_.size() > cursor_ + 1) {
+        bytes_ -= entryBytes(entries_.back());
+        if (entries_.back().hasKeyframe) {
+            --keyframes_;
+        }
+        entries_.pop_back();
+    }
+}
+
+void HistoryJournal::append(Entry entry) {
+    bytes_ += entryBytes(entry);
+    entries_.push_back(std::move(entry));
+    cursor_ = entries_.size() - 1;
+    evict();
+}
+
+void HistoryJournal::evict() {
+    while (bytes_ > byteBudget_ && keyframes_ > 1) {
+        // The oldest stretch goes whole, and never the current entry
+        std::size_t next = 1;
+        while (!entries_[next].hasKeyframe) {
+            ++next;
+        }
+        if (next > cursor_) {
+            return;
+        }
+        for (std::size_t i = 0; i < next; ++i) {
+            bytes_ -= entryBytes(entries_.front());
+            if (entries_.front().hasKeyframe) {
+                --keyframes_;
+            }
+            entries_.pop_front();
+        }
+        cursor_ -= next;
+
+        // The new oldest entry is never stepped into
+        Entry& oldest = entries_.front();
+        bytes_ -= entryBytes(oldest);
+        oldest.flips.clear();
+        oldest.flips.shrink_to_fit();
+        bytes_ += entryBytes(oldest);
+    }
+}
@@ -0,0 +1,78 @@
+#include "core/LifeRule.h"
+#include <cctype>
+
+namespace {
+
+// Neighbor counts 0 to 8 as a bit mask; nullopt on any other character
+std::optional<std::uint16_t> parseCounts(std::string_view digits) {
+    std::uint16_t mask = 0;
+    for (char c : digits) {
+        if (c < '0' || c > '8') {
+            return std::nullopt;
+        }
+        mask = static_cast<std::uint16_t>(mask | (1u << (c - '0')));
+    }
+    return mask;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+} // namespace
+
+std::string LifeRule::toString() const {
+    std::string text = "B";
+    for (std::uint32_t n = 0; n <= 8; ++n) {
+        if ((birth >> n) & 1u) {
+            text += static_cast<char>('0' + n);
+        }
+    }
+    text += "/S";
+    for (std::uint32_t n = 0; n <= 8; ++n) {
+        if ((survival >> n) & 1u) {
+            text += static_cast<char>('0' + n);
+        }
+    }
+    return text;
+}
+
+std::optional<LifeRule> LifeRule::parse(std::string_view text) {
+    text = trim(text);
+    const auto slash = text.find('/');
+    if (slash == std::string_view::npos) {
+        return std::nullopt;
+    }
+    std::string_view first = text.substr(0, slash);
+    std::string_view second = text.substr(slash + 1);
+
+    auto tag = [](std::string_view part) {
+        return part.empty() ? '\0' : static_cast<char>(std::toupper(static_cast<unsigned char>(part.front())));
+    };
+    std::string_view birthDigits;
+    std::string_view survivalDigits;
+    if (tag(first) == 'B' && tag(second) == 'S') {
+        birthDigits = first.substr(1);
+        survivalDigits = second.substr(1);
+    } else if (tag(first) == 'S' && tag(second) == 'B') {
+        survivalDigits = first.substr(1);
+        birthDigits = second.substr(1);
+    } else {
+        // Survival/birth without letters, as in "23/3"
+        survivalDigits = first;
+        birthDigits = second;
+    }
+
+    const auto birth = parseCounts(birthDigits);
+    const auto survival = parseCounts(survivalDigits);
+    if (!birth || !survival || (*birth & 1u) != 0) {
+        return std::nullopt;
+    }
+    return LifeRule{*birth, *survival};
+}
@@ -0,0 +1,144 @@
+#include "core/NumaTopology.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// CPU list in the kernel's format, such as "0-3,8-11"
+std::vector<std::uint32_t> parseCpuList(const std::string& text) {
+    std::vector<std::uint32_t> cpus;
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t end = text.find(',', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        const std::string range = text.substr(start, end - start);
+        const std::size_t dash = range.find('-');
+        try {
+            const auto first = static_cast<std::uint32_t>(std::stoul(range.substr(0, dash)));
+            const auto last = dash == std::string::npos ? first : static_cast<std::uint32_t>(std::stoul(range.substr(dash + 1)));
+            for (std::uint32_t cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            // Blank or malformed entries (an empty node lists "\n") add nothing
+        }
+        start = end + 1;
+    }
+    return cpus;
+}
+
+} // namespace
+
+NumaTopology::NumaTopology() {
+    NumaNode node;
+    const std::uint32_t cpus = std::max(1u, std::thread::hardware_concurrency());
+    for (std::uint32_t cpu = 0; cpu < cpus; ++cpu) {
+        node.cpus.push_back(cpu);
+    }
+    nodes_.push_back(std::move(node));
+}
+
+NumaTopology::NumaTopology(std::vector<NumaNode> nodes) {
+    for (auto& node : nodes) {
+        if (!node.cpus.empty()) {
+            nodes_.push_back(std::move(node));
+        }
+    }
+    if (nodes_.empty()) {
+        *this = NumaTopology();
+    }
+}
+
+NumaTopology NumaTopology::detect() {
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    const bool haveMask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    std::vector<NumaNode> nodes;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+            !std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string text;
+        std::getline(file, text);
+
+        NumaNode node;
+        node.id = static_cast<std::uint32_t>(std::stoul(name.substr(4)));
+        for (std::uint32_t cpu : parseCpuList(text)) {
+            if (!haveMask || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        nodes.push_back(std::move(node));
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+    return NumaTopology(std::move(nodes));
+#else
+    return NumaTopology();
+#endif
+}
+
+NumaTopology NumaTopology::limitedTo(std::uint32_t nodes) const {
+    if (nodes == 0 || nodes >= nodes_.size()) {
+        return *this;
+    }
+    return NumaTopology(std::vector<NumaNode>(nodes_.begin(), nodes_.begin() + nodes));
+}
+
+bool pinCurrentThread(std::uint32_t cpu) {
+#if defined(__linux__)
+    if (cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+bool placeMemoryOnNode(void* address, std::size_t bytes, std::uint32_t node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    constexpr std::size_t kBitsPerWord = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(node / kBitsPerWord + 1, 0);
+    mask[node / kBitsPerWord] = 1ul << (node % kBitsPerWord);
+    // The kernel reads one bit fewer than maxnode says
+    return syscall(SYS_mbind, address, bytes, MPOL_PREFERRED, mask.data(), mask.size() * kBitsPerWord + 1, 0) == 0;
+#else
+    (void)address;
+    (void)bytes;
+    (void)node;
+    return false;
+#endif
+}
+
+std::size_t getMemoryPageSize() {
+#if defined(__linux__)
+    const long size = sysconf(_SC_PAGESIZE);
+    if (size > 0) {
+        return static_cast<std::size_t>(size);
+    }
+#endif
+    return 4096;
+}
@@ -0,0 +1,219 @@
+#include "core/PackedLiveSet.h"
+#include "core/Topology.h"
+#include "core/Trace.h"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+// Below this many keys a comparison sort beats clearing the byte histograms
+constexpr std::size_t kRadixSortThreshold = 256;
+
+} // namespace
+
+PackedLiveSet::PackedLiveSet(std::int32_t width, std::int32_t height, bool wrapEdges, const LifeRule& rule)
+    : width_(width), height_(height), wrapEdges_(wrapEdges), rule_(rule) {}
+
+void PackedLiveSet::setCell(std::int32_t x, std::int32_t y, bool alive) {
+    const std::uint64_t k = key(x, y);
+    auto it = std::lower_bound(cells_.begin(), cells_.end(), k);
+    const bool present = it != cells_.end() && *it == k;
+
+    if (alive && !present) {
+        cells_.insert(it, k);
+    } else if (!alive && present) {
+        cells_.erase(it);
+    }
+}
+
+void PackedLiveSet::setCellsAlive(std::span<const Position> cells) {
+    cells_.reserve(cells_.size() + cells.size());
+    for (const auto& pos : cells) {
+        cells_.push_back(key(pos.x, pos.y));
+    }
+    sortKeys(cells_);
+    cells_.erase(std::unique(cells_.begin(), cells_.end()), cells_.end());
+}
+
+bool PackedLiveSet::getCell(std::int32_t x, std::int32_t y) const {
+    return std::binary_search(cells_.begin(), cells_.end(), key(x, y));
+}
+
+std::uint8_t PackedLiveSet::countNeighbors(std::int32_t x, std::int32_t y) const {
+    std::uint8_t count = 0;
+
+    for (std::int32_t dy = -1; dy <= 1; ++dy) {
+        for (std::int32_t dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) {
+                continue;
+            }
+
+            std::int32_t neighborX = x + dx;
+            std::int32_t neighborY = y + dy;
+
+            if (wrapEdges_) {
+                neighborX = ((neighborX % width_) + width_) % width_;
+                neighborY = ((neighborY % height_) + height_) % height_;
+            } else if (neighborX < 0 || neighborX >= width_ || neighborY < 0 || neighborY >= height_) {
+                continue;
+            }
+
+            if (getCell(neighborX, neighborY)) {
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+bool PackedLiveSet::step() {
+    GOL_TRACE_SCOPE("PackedLiveSet::step");
+    born_.clear();
+    died_.clear();
+    neighbors_.clear();
+    neighbors_.reserve(cells_.size() * 8);
+
+    withTopology(width_, height_, wrapEdges_, [this](const auto& topology) {
+        for (std::uint64_t cell : cells_) {
+            forEachNeighbor(topology, position(cell),
+                            [this](Position neighbor) { neighbors_.push_back(neighbor.packed()); });
+        }
+    });
+
+    sortKeys(neighbors_);
+
+    // Walk the neighbor runs and the live array together; both are sorted
+    next_.clear();
+    next_.reserve(cells_.size() + cells_.size() / 2);
+    withLifeRule(rule_, [this](const auto& rule) {
+        // Living cells with no living neighbor never appear in the runs
+        auto lonely = [this, &rule](std::uint64_t k) {
+            if (rule.nextState(true, 0)) {
+                next_.push_back(k);
+            } else {
+                died_.push_back(position(k));
+            }
+        };
+
+        std::size_t live = 0;
+        for (std::size_t i = 0; i < neighbors_.size();) {
+            const std::uint64_t k = neighbors_[i];
+            std::size_t end = i + 1;
+            while (end < neighbors_.size() && neighbors_[end] == k) {
+                ++end;
+            }
+            const auto count = static_cast<std::uint32_t>(end - i);
+            i = end;
+
+            while (live < cells_.size() && cells_[live] < k) {
+                lonely(cells_[live++]);
+            }
+            const bool alive = live < cells_.size() && cells_[live] == k;
+            if (alive) {
+                ++live;
+            }
+
+            if (rule.nextState(alive, count)) {
+                next_.push_back(k);
+                if (!alive) {
+                    born_.push_back(position(k));
+                }
+            } else if (alive) {
+                died_.push_back(position(k));
+            }
+        }
+        while (live < cells_.size()) {
+            lonely(cells_[live++]);
+        }
+    });
+
+    cells_.swap(next_);
+    return !born_.empty() || !died_.empty();
+}
+
+void PackedLiveSet::clear() {
+    cells_.clear();
+    born_.clear();
+    died_.clear();
+}
+
+std::size_t PackedLiveSet::getMemoryUsage() const {
+    return (cells_.capacity() + next_.capacity() + neighbors_.capacity() + sortScratch_.capacity()) *
+               sizeof(std::uint64_t) +
+           (born_.capacity() + died_.capacity()) * sizeof(Position);
+}
+
+void PackedLiveSet::collectLivingCells(std::vector<Position>& out) const {
+    out.reserve(out.size() + cells_.size());
+    for (std::uint64_t cell : cells_) {
+        out.push_back(position(cell));
+    }
+}
+
+void PackedLiveSet::collectLivingCellsInRegion(std::int32_t minX, std::int32_t maxX, std::int32_t minY,
+                                               std::int32_t maxY, std::vector<Position>& out) const {
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, width_ - 1);
+    maxY = std::min(maxY, height_ - 1);
+    if (minX > maxX || minY > maxY) {
+        return;
+    }
+
+    // Keys sort by column, so each column of the region is one contiguous range
+    auto it = std::lower_bound(cells_.begin(), cells_.end(), key(minX, minY));
+    const auto last = std::upper_bound(it, cells_.end(), key(maxX, maxY));
+    const bool scan = static_cast<std::size_t>(last - it) <= static_cast<std::size_t>(maxX - minX + 1);
+
+    while (it != last) {
+        const Position pos = position(*it);
+        if (pos.y < minY) {
+            it = scan ? it + 1 : std::lower_bound(it, last, key(pos.x, minY));
+        } else if (pos.y > maxY) {
+            it = scan || pos.x == maxX ? it + 1 : std::lower_bound(it, last, key(pos.x + 1, minY));
+        } else {
+            out.push_back(pos);
+            ++it;
+        }
+    }
+}
+
+void PackedLiveSet::collectChanges(std::vector<Position>& born, std::vector<Position>& died) const {
+    born.insert(born.end(), born_.begin(), born_.end());
+    died.insert(died.end(), died_.begin(), died_.end());
+}
+
+void PackedLiveSet::sortKeys(std::vector<std::uint64_t>& keys) {
+    if (keys.size() < kRadixSortThreshold) {
+        std::sort(keys.begin(), keys.end());
+        return;
+    }
+
+    std::array<std::array<std::size_t, 256>, 8> counts{};
+    for (std::uint64_t k : keys) {
+        for (std::size_t byte = 0; byte < 8; ++byte) {
+            ++counts[byte][(k >> (8 * byte)) & 0xFF];
+        }
+    }
+
+    sortScratch_.resize(keys.size());
+    for (std::size_t byte = 0; byte < 8; ++byte) {
+        auto& count = counts[byte];
+        const std::size_t digit = (keys[0] >> (8 * byte)) & 0xFF;
+        if (count[digit] == keys.size()) {
+            continue; // Every key shares this byte; the pass would not move anything
+        }
+
+        std::size_t offset = 0;
+        for (auto& bucket : count) {
+            const std::size_t size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+        for (std::uint64_t k : keys) {
+            sortScratch_[count[(k >> (8 * byte)) & 0xFF]++] = k;
+        }
+        keys.swap(sortScratch_);
+    }
+}
@@ -0,0 +1,291 @@
+#include "core/PartitionedBoard.h"
+#include "core/Trace.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr std::int32_t kSummaryRows = TiledGrid::kTileSize; // Rows copied out per summary chunk
+
+SlabBounds checkedSlab(const GameConfig& config, const HaloTransport& transport, std::int32_t haloDepth) {
+    if (haloDepth < 1) {
+        throw std::invalid_argument("PartitionedBoard: halo depth must be at least 1");
+    }
+    const std::uint32_t ranks = transport.getRankCount();
+    if (ranks == 0 || transport.getRank() >= ranks || static_cast<std::int64_t>(ranks) > config.getGridHeight()) {
+        throw std::invalid_argument("PartitionedBoard: " + std::to_string(ranks) + " ranks for " +
+                                    std::to_string(config.getGridHeight()) + " rows");
+    }
+    const SlabBounds slab = slabBounds(config.getGridHeight(), ranks, transport.getRank());
+    if (ranks > 1 && slabBounds(config.getGridHeight(), ranks, ranks - 1).rows < haloDepth) {
+        throw std::invalid_argument("PartitionedBoard: slabs are thinner than the halo depth");
+    }
+    return slab;
+}
+
+// The neighbor's halo is needed across every slab edge except the grid's own bounded edges
+bool hasNeighborAbove(const GameConfig& config, const HaloTransport& transport) {
+    return transport.getRankCount() > 1 && (transport.getRank() > 0 || config.getWrapEdges());
+}
+
+bool hasNeighborBelow(const GameConfig& config, const HaloTransport& transport) {
+    return transport.getRankCount() > 1 && (transport.getRank() + 1 < transport.getRankCount() || config.getWrapEdges());
+}
+
+} // namespace
+
+SlabBounds slabBounds(std::int32_t height, std::uint32_t ranks, std::uint32_t rank) {
+    const std::int64_t base = height / static_cast<std::int64_t>(ranks);
+    const std::int64_t extra = height % static_cast<std::int64_t>(ranks);
+    const std::int64_t first = base * rank + std::min<std::int64_t>(rank, extra);
+    return {static_cast<std::int32_t>(first), static_cast<std::int32_t>(base + (rank < extra ? 1 : 0))};
+}
+
+HaloMailbox::HaloMailbox(std::chrono::milliseconds timeout)
+    : timeout_(timeout) {}
+
+void HaloMailbox::deliver(HaloMessage message) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Key key{message.round, message.fromRank, message.downward};
+        messages_[key] = std::move(message);
+    }
+    arrived_.notify_all();
+}
+
+HaloMessage HaloMailbox::receive(std::uint32_t fromRank, bool downward, std::uint64_t round) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const Key key{round, fromRank, downward};
+    auto ready = [&] { return messages_.count(key) != 0; };
+    if (timeout_.count() == 0) {
+        arrived_.wait(lock, ready);
+    } else if (!arrived_.wait_for(lock, timeout_, ready)) {
+        throw std::runtime_error("No halo from rank " + std::to_string(fromRank) + " for round " +
+                                 std::to_string(round));
+    }
+    auto node = messages_.extract(key);
+    return std::move(node.mapped());
+}
+
+ReductionBarrier::ReductionBarrier(std::uint32_t ranks, std::chrono::milliseconds timeout)
+    : ranks_(ranks)
+    , timeout_(timeout) {}
+
+HaloReduction ReductionBarrier::contribute(std::uint64_t round, const HaloReduction& local) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Round& entry = rounds_[round];
+    entry.total.livingCells += local.livingCells;
+    entry.total.changed = entry.total.changed || local.changed;
+    if (++entry.arrived == ranks_) {
+        complete_.notify_all();
+    }
+
+    auto ready = [&] { return entry.arrived == ranks_; };
+    if (timeout_.count() == 0) {
+        complete_.wait(lock, ready);
+    } else if (!complete_.wait_for(lock, timeout_, ready)) {
+        throw std::runtime_error("Reduction round " + std::to_string(round) + " is missing ranks");
+    }
+
+    // map nodes stay put, so entry is still this round's; the last rank out removes it
+    const HaloReduction total = entry.total;
+    if (++entry.left == ranks_) {
+        rounds_.erase(round);
+    }
+    return total;
+}
+
+class InProcessHaloNetwork::Endpoint : public HaloTransport {
+public:
+    Endpoint(InProcessHaloNetwork& network, std::uint32_t rank)
+        : network_(network)
+        , rank_(rank) {}
+
+    std::uint32_t getRank() const override { return rank_; }
+    std::uint32_t getRankCount() const override { return static_cast<std::uint32_t>(network_.mailboxes_.size()); }
+
+    void send(std::uint32_t rank, HaloMessage message) override {
+        network_.mailboxes_.at(rank)->deliver(std::move(message));
+    }
+
+    HaloMessage receive(std::uint32_t fromRank, bool downward, std::uint64_t round) override {
+        return network_.mailboxes_[rank_]->receive(fromRank, downward, round);
+    }
+
+    HaloReduction allReduce(std::uint64_t round, const HaloReduction& local) override {
+        return network_.barrier_.contribute(round, local);
+    }
+
+private:
+    InProcessHaloNetwork& network_;
+    std::uint32_t rank_;
+};
+
+InProcessHaloNetwork::InProcessHaloNetwork(std::uint32_t ranks)
+    : barrier_(ranks) {
+    for (std::uint32_t rank = 0; rank < ranks; ++rank) {
+        mailboxes_.push_back(std::make_unique<HaloMailbox>());
+        endpoints_.push_back(std::make_unique<Endpoint>(*this, rank));
+    }
+}
+
+InProcessHaloNetwork::~InProcessHaloNetwork() = default;
+
+HaloTransport& InProcessHaloNetwork::getTransport(std::uint32_t rank) {
+    return *endpoints_.at(rank);
+}
+
+PartitionedBoard::PartitionedBoard(const GameConfig& config, HaloTransport& transport, std::int32_t haloDepth)
+    : config_(config)
+    , transport_(transport)
+    , slab_(checkedSlab(config, transport, haloDepth))
+    , haloDepth_(haloDepth)
+    , haloAbove_(hasNeighborAbove(config, transport) ? haloDepth : 0)
+    , haloBelow_(hasNeighborBelow(config, transport) ? haloDepth : 0)
+    , rankAbove_((transport.getRank() + transport.getRankCount() - 1) % transport.getRankCount())
+    , rankBelow_((transport.getRank() + 1) % transport.getRankCount())
+    // The local grid wraps with the global one for the columns; its rows
+    // wrapping from one halo into the other only touches rows gone stale
+    , grid_(config.getGridWidth(), haloAbove_ + slab_.rows + haloBelow_, config.getWrapEdges(),
+            static_cast<std::uint32_t>(std::max(config.getWorkerThreads(), 0)), config.getRule()) {}
+
+bool PartitionedBoard::toSlab(std::int32_t x, std::int32_t& y) const {
+    if (x < 0 || x >= config_.getGridWidth() || y < slab_.firstRow || y >= slab_.firstRow + slab_.rows) {
+        return false;
+    }
+    y = y - slab_.firstRow + haloAbove_;
+    return true;
+}
+
+void PartitionedBoard::setCellAlive(std::int32_t x, std::int32_t y) {
+    if (config_.getWrapEdges()) {
+        x = ((x % config_.getGridWidth()) + config_.getGridWidth()) % config_.getGridWidth();
+        y = ((y % config_.getGridHeight()) + config_.getGridHeight()) % config_.getGridHeight();
+    }
+    if (toSlab(x, y)) {
+        grid_.setCell(x, y, true);
+    }
+}
+
+void PartitionedBoard::setCellsAlive(std::span<const Position> cells) {
+    for (const auto& pos : cells) {
+        setCellAlive(pos.x, pos.y);
+    }
+}
+
+void PartitionedBoard::setCellDead(std::int32_t x, std::int32_t y) {
+    if (config_.getWrapEdges()) {
+        x = ((x % config_.getGridWidth()) + config_.getGridWidth()) % config_.getGridWidth();
+        y = ((y % config_.getGridHeight()) + config_.getGridHeight()) % config_.getGridHeight();
+    }
+    if (toSlab(x, y)) {
+        grid_.setCell(x, y, false);
+    }
+}
+
+bool PartitionedBoard::isCellAlive(std::int32_t x, std::int32_t y) const {
+    if (config_.getWrapEdges()) {
+        x = ((x % config_.getGridWidth()) + config_.getGridWidth()) % config_.getGridWidth();
+        y = ((y % config_.getGridHeight()) + config_.getGridHeight()) % config_.getGridHeight();
+    }
+    return toSlab(x, y) && grid_.getCell(x, y);
+}
+
+void PartitionedBoard::exchangeHalos() {
+    const std::uint64_t round = round_++;
+    const std::uint32_t rank = transport_.getRank();
+    const auto rowWords = static_cast<std::size_t>(grid_.getTilesX());
+
+    // Every send goes out before any receive, so no rank waits on one still waiting itself
+    if (haloAbove_ > 0) {
+        HaloMessage up{round, rank, false, {}};
+        grid_.copyRows(haloAbove_, haloDepth_, up.words);
+        transport_.send(rankAbove_, std::move(up));
+    }
+    if (haloBelow_ > 0) {
+        HaloMessage down{round, rank, true, {}};
+        grid_.copyRows(haloAbove_ + slab_.rows - haloDepth_, haloDepth_, down.words);
+        transport_.send(rankBelow_, std::move(down));
+    }
+
+    auto install = [&](const HaloMessage& message, std::int32_t firstRow) {
+        if (message.words.size() != static_cast<std::size_t>(haloDepth_) * rowWords) {
+            throw std::runtime_error("Halo from rank " + std::to_string(message.fromRank) + " has " +
+                                     std::to_string(message.words.size()) + " words, expected " +
+                                     std::to_string(static_cast<std::size_t>(haloDepth_) * rowWords));
+        }
+        grid_.setRows(firstRow, haloDepth_, message.words);
+    };
+    if (haloAbove_ > 0) {
+        install(transport_.receive(rankAbove_, true, round), 0);
+    }
+    if (haloBelow_ > 0) {
+        install(transport_.receive(rankBelow_, false, round), haloAbove_ + slab_.rows);
+    }
+}
+
+PartitionedBoard::SlabSummary PartitionedBoard::summarize() const {
+    // Each word mixed with its index, so moving cells changes the hash
+    SlabSummary summary;
+    std::uint64_t index = 0;
+    for (std::int32_t row = 0; row < slab_.rows; row += kSummaryRows) {
+        rows_.clear();
+        grid_.copyRows(haloAbove_ + row, std::min(kSummaryRows, slab_.rows - row), rows_);
+        for (const std::uint64_t word : rows_) {
+            summary.hash += mixCoordinateKey(word ^ (index++ * 0x9e3779b97f4a7c15ull));
+            summary.livingCells += static_cast<std::uint64_t>(std::popcount(word));
+        }
+    }
+    return summary;
+}
+
+PartitionStepResult PartitionedBoard::advance(std::uint64_t generations) {
+    GOL_TRACE_SCOPE("PartitionedBoard::advance");
+    PartitionStepResult result;
+    SlabSummary before = summarize();
+    while (result.generations < generations) {
+        const auto block = static_cast<std::uint32_t>(
+            std::min<std::uint64_t>(generations - result.generations, static_cast<std::uint64_t>(haloDepth_)));
+        exchangeHalos();
+        grid_.step(block);
+        generation_ += block;
+        result.generations += block;
+
+        const SlabSummary after = summarize();
+        const HaloReduction total =
+            transport_.allReduce(round_++, {after.livingCells, after.hash != before.hash});
+        before = after;
+        result.livingCells = total.livingCells;
+        result.changed = total.changed;
+        if (!total.changed) {
+            break;
+        }
+    }
+    return result;
+}
+
+std::size_t PartitionedBoard::getSlabLivingCellCount() const {
+    return static_cast<std::size_t>(summarize().livingCells);
+}
+
+void PartitionedBoard::collectLivingCells(std::vector<Position>& out) const {
+    const auto rowWords = static_cast<std::size_t>(grid_.getTilesX());
+    for (std::int32_t row = 0; row < slab_.rows; row += kSummaryRows) {
+        const std::int32_t rows = std::min(kSummaryRows, slab_.rows - row);
+        rows_.clear();
+        grid_.copyRows(haloAbove_ + row, rows, rows_);
+        for (std::size_t i = 0; i < rows_.size(); ++i) {
+            const auto y = slab_.firstRow + row + static_cast<std::int32_t>(i / rowWords);
+            const auto baseX = static_cast<std::int32_t>((i % rowWords) * 64);
+            for (std::uint64_t bits = rows_[i]; bits != 0; bits &= bits - 1) {
+                out.emplace_back(baseX + std::countr_zero(bits), y);
+            }
+        }
+    }
+}
+
+std::size_t PartitionedBoard::getMemoryUsage() const {
+    return grid_.getMemoryUsage() + rows_.capacity() * sizeof(std::uint64_t);
+}
@@ -0,0 +1,291 @@
+#include "core/PatternReader.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr std::int64_t kMaxCoordinate = std::numeric_limits<std::int32_t>::max();
+constexpr std::int64_t kMinCoordinate = std::numeric_limits<std::int32_t>::min();
+constexpr std::uint32_t kMaxMacrocellLevel = 62;
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    if (text.size() < suffix.size()) {
+        return false;
+    }
+    return std::equal(suffix.rbegin(), suffix.rend(), text.rbegin(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    });
+}
+
+void stripCarriageReturn(std::string& line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+}
+
+// Accepts any spelling of the rule the pattern is read for; a pattern drawn
+// for another rule would not behave as its author meant
+void checkRule(const std::string& text, const LifeRule& rule) {
+    if (text.find_first_not_of(" \t") == std::string::npos) {
+        return;
+    }
+    const auto parsed = LifeRule::parse(text);
+    if (!parsed) {
+        throw std::runtime_error("Unsupported pattern rule: " + text);
+    }
+    if (*parsed != rule) {
+        throw std::runtime_error("Pattern rule " + parsed->toString() + " does not match the simulation's " +
+                                 rule.toString());
+    }
+}
+
+// Reports runs, joining ones that continue each other
+class RunEmitter {
+public:
+    explicit RunEmitter(const PatternRunCallback& fn) : fn_(fn) {}
+
+    void add(std::int64_t x, std::int64_t y, std::int64_t length) {
+        if (x < kMinCoordinate || y < kMinCoordinate || y > kMaxCoordinate || x + length - 1 > kMaxCoordinate) {
+            throw std::runtime_error("Pattern cell lies outside the 32-bit plane");
+        }
+        if (length_ > 0 && y == y_ && x == x_ + length_ && length_ + length <= std::numeric_limits<std::uint32_t>::max()) {
+            length_ += length;
+            return;
+        }
+        flush();
+        x_ = x;
+        y_ = y;
+        length_ = length;
+    }
+
+    void flush() {
+        if (length_ > 0) {
+            fn_(static_cast<std::int32_t>(x_), static_cast<std::int32_t>(y_), static_cast<std::uint32_t>(length_));
+            length_ = 0;
+        }
+    }
+
+private:
+    const PatternRunCallback& fn_;
+    std::int64_t x_{0};
+    std::int64_t y_{0};
+    std::int64_t length_{0};
+};
+
+// A macrocell node: an 8x8 leaf bitmap, a level-1 block of cell states, or
+// four references to earlier nodes
+struct MacrocellNode {
+    std::uint32_t level{0};
+    std::array<std::uint32_t, 4> children{};  // nw, ne, sw, se
+    std::uint64_t leafBits{0};                // Bit row * 8 + column, for 8x8 leaves
+    bool isLeaf{false};
+};
+
+void emitMacrocell(const std::vector<MacrocellNode>& nodes, std::uint32_t index, std::int64_t x, std::int64_t y,
+                   RunEmitter& emitter) {
+    const auto& node = nodes[index];
+
+    if (node.isLeaf) {
+        for (std::int64_t row = 0; row < 8; ++row) {
+            const auto bits = static_cast<std::uint32_t>((node.leafBits >> (row * 8)) & 0xFF);
+            for (std::int64_t column = 0; column < 8;) {
+                if ((bits >> column & 1u) == 0) {
+                    column++;
+                    continue;
+                }
+                std::int64_t end = column + 1;
+                while (end < 8 && (bits >> end & 1u) != 0) {
+                    end++;
+                }
+                emitter.add(x + column, y + row, end - column);
+                column = end;
+            }
+        }
+        return;
+    }
+
+    if (node.level == 1) {
+        // Children are cell states; any non-zero state is alive
+        for (std::int64_t quadrant = 0; quadrant < 4; ++quadrant) {
+            if (node.children[static_cast<std::size_t>(quadrant)] != 0) {
+                emitter.add(x + (quadrant & 1), y + (quadrant >> 1), 1);
+            }
+        }
+        return;
+    }
+
+    const std::int64_t half = std::int64_t{1} << (node.level - 1);
+    for (std::int64_t quadrant = 0; quadrant < 4; ++quadrant) {
+        std::uint32_t child = node.children[static_cast<std::size_t>(quadrant)];
+        if (child != 0) {
+            emitMacrocell(nodes, child, x + (quadrant & 1) * half, y + (quadrant >> 1) * half, emitter);
+        }
+    }
+}
+
+} // namespace
+
+PatternFormat patternFormatFromPath(const std::string& path) {
+    if (endsWith(path, ".rle")) {
+        return PatternFormat::Rle;
+    }
+    if (endsWith(path, ".mc")) {
+        return PatternFormat::Macrocell;
+    }
+    return PatternFormat::Json;
+}
+
+void readRlePattern(std::istream& in, const PatternRunCallback& fn, const LifeRule& rule) {
+    std::int64_t originX = 0;
+    std::int64_t originY = 0;
+    bool haveHeader = false;
+
+    std::string line;
+    while (!haveHeader && std::getline(in, line)) {
+        stripCarriageReturn(line);
+        if (line.empty()) {
+            continue;
+        }
+        if (line[0] == '#') {
+            if (line.size() > 1 && (line[1] == 'P' || line[1] == 'R')) {
+                std::istringstream fields(line.substr(2));
+                if (!(fields >> originX >> originY)) {
+                    throw std::runtime_error("Malformed RLE position line: " + line);
+                }
+            }
+            continue;
+        }
+        if (line.find('=') == std::string::npos) {
+            throw std::runtime_error("RLE pattern has no header line");
+        }
+
+        auto ruleKey = line.find("rule");
+        if (ruleKey != std::string::npos) {
+            auto valueStart = line.find('=', ruleKey);
+            auto valueEnd = line.find(',', ruleKey);
+            if (valueStart != std::string::npos) {
+                checkRule(line.substr(valueStart + 1, valueEnd == std::string::npos
+                    ? std::string::npos : valueEnd - valueStart - 1), rule);
+            }
+        }
+        haveHeader = true;
+    }
+    if (!haveHeader) {
+        throw std::runtime_error("RLE pattern has no header line");
+    }
+
+    RunEmitter emitter(fn);
+    std::int64_t x = 0;
+    std::int64_t y = 0;
+    std::int64_t count = 0;
+
+    char c;
+    while (in.get(c)) {
+        if (c >= '0' && c <= '9') {
+            count = count * 10 + (c - '0');
+            if (count > kMaxCoordinate) {
+                throw std::runtime_error("RLE run count is too large");
+            }
+            continue;
+        }
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            continue;
+        }
+
+        const std::int64_t repeat = count > 0 ? count : 1;
+        count = 0;
+
+        if (c == 'b' || c == '.') {
+            x += repeat;
+        } else if (c == '$') {
+            y += repeat;
+            x = 0;
+        } else if (c == '!') {
+            break;
+        } else if (std::isalpha(static_cast<unsigned char>(c))) {
+            // 'o' in two-state files; multi-state letters are taken as alive
+            emitter.add(originX + x, originY + y, repeat);
+            x += repeat;
+        } else {
+            throw std::runtime_error(std::string("Unexpected character in RLE pattern: ") + c);
+        }
+    }
+
+    emitter.flush();
+}
+
+void readMacrocellPattern(std::istream& in, const PatternRunCallback& fn, const LifeRule& rule) {
+    std::string line;
+    if (!std::getline(in, line) || line.compare(0, 4, "[M2]") != 0) {
+        throw std::runtime_error("Macrocell pattern must start with [M2]");
+    }
+
+    // Index 0 stands for an empty node of any level
+    std::vector<MacrocellNode> nodes(1);
+
+    while (std::getline(in, line)) {
+        stripCarriageReturn(line);
+        if (line.empty()) {
+            continue;
+        }
+        if (line[0] == '#') {
+            if (line.size() > 1 && line[1] == 'R') {
+                checkRule(line.substr(2), rule);
+            }
+            continue;
+        }
+
+        MacrocellNode node;
+        if (line[0] == '.' || line[0] == '*' || line[0] == '$') {
+            node.level = 3;
+            node.isLeaf = true;
+            std::uint32_t row = 0;
+            std::uint32_t column = 0;
+            for (char c : line) {
+                if (c == '$') {
+                    row++;
+                    column = 0;
+                    continue;
+                }
+                if ((c != '.' && c != '*') || row >= 8 || column >= 8) {
+                    throw std::runtime_error("Malformed macrocell leaf: " + line);
+                }
+                if (c == '*') {
+                    node.leafBits |= std::uint64_t{1} << (row * 8 + column);
+                }
+                column++;
+            }
+        } else {
+            std::istringstream fields(line);
+            if (!(fields >> node.level >> node.children[0] >> node.children[1] >> node.children[2] >> node.children[3])) {
+                throw std::runtime_error("Malformed macrocell node: " + line);
+            }
+            if (node.level == 0 || node.level > kMaxMacrocellLevel) {
+                throw std::runtime_error("Unsupported macrocell node level: " + line);
+            }
+            if (node.level > 1) {
+                for (std::uint32_t child : node.children) {
+                    if (child >= nodes.size() || (child != 0 && nodes[child].level != node.level - 1)) {
+                        throw std::runtime_error("Macrocell node refers to an invalid child: " + line);
+                    }
+                }
+            }
+        }
+        nodes.push_back(node);
+    }
+
+    if (nodes.size() == 1) {
+        return;
+    }
+
+    RunEmitter emitter(fn);
+    const auto root = static_cast<std::uint32_t>(nodes.size() - 1);
+    const std::int64_t half = std::int64_t{1} << (nodes[root].level - 1);
+    emitMacrocell(nodes, root, -half, -half, emitter);
+    emitter.flush();
+}
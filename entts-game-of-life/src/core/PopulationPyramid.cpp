@@ -0,0 +1,111 @@
+#include "core/PopulationPyramid.h"
+#include "core/Trace.h"
+
+namespace {
+
+// Floor division by 2^shift, so negative cells land in the block to their left
+Position blockOf(const Position& pos, std::uint32_t shift) {
+    return {pos.x >> shift, pos.y >> shift};
+}
+
+} // namespace
+
+void PopulationPyramid::add(const Position& pos) {
+    const Position blockPos = blockOf(pos, 1);
+    auto it = levels_[0].find(blockPos);
+    std::uint32_t slot = it != levels_[0].end() ? it->second : acquireBlock(1, blockPos);
+    for (; slot != kNoBlock; slot = blocks_[slot].parent) {
+        blocks_[slot].count++;
+    }
+    size_++;
+}
+
+void PopulationPyramid::remove(const Position& pos) {
+    Position blockPos = blockOf(pos, 1);
+    auto it = levels_[0].find(blockPos);
+    if (it == levels_[0].end()) {
+        return;
+    }
+
+    std::uint32_t slot = it->second;
+    for (std::uint32_t level = 0; slot != kNoBlock; ++level) {
+        Block& block = blocks_[slot];
+        const std::uint32_t parent = block.parent;
+        if (--block.count == 0) {
+            levels_[level].erase(blockPos);
+            freeBlocks_.push_back(slot);
+        }
+        slot = parent;
+        blockPos = blockOf(blockPos, 1);
+    }
+    size_--;
+}
+
+void PopulationPyramid::apply(std::span<const Position> born, std::span<const Position> died) {
+    for (const auto& pos : died) {
+        remove(pos);
+    }
+    for (const auto& pos : born) {
+        add(pos);
+    }
+}
+
+void PopulationPyramid::rebuild(std::span<const Position> cells) {
+    GOL_TRACE_SCOPE("PopulationPyramid::rebuild");
+    clear();
+    for (const auto& pos : cells) {
+        add(pos);
+    }
+}
+
+void PopulationPyramid::clear() {
+    freeBlocks_.clear();
+    for (std::uint32_t slot = 0; slot < blocks_.size(); ++slot) {
+        freeBlocks_.push_back(slot);
+    }
+    for (auto& level : levels_) {
+        level.clear();
+    }
+    size_ = 0;
+}
+
+std::size_t PopulationPyramid::getMemoryUsage() const {
+    std::size_t bytes = blocks_.capacity() * sizeof(Block) + freeBlocks_.capacity() * sizeof(std::uint32_t) +
+                        sizeof(*this);
+    for (const auto& level : levels_) {
+        bytes += level.getMemoryUsage();
+    }
+    return bytes;
+}
+
+std::uint32_t PopulationPyramid::countBlock(std::uint32_t scaleLog2, std::int32_t blockX, std::int32_t blockY) const {
+    if (scaleLog2 == 0 || scaleLog2 > kMaxScaleLog2) {
+        return 0;
+    }
+    const auto& level = levels_[scaleLog2 - 1];
+    auto it = level.find(Position{blockX, blockY});
+    return it != level.end() ? blocks_[it->second].count : 0;
+}
+
+std::uint32_t PopulationPyramid::acquireBlock(std::uint32_t scaleLog2, const Position& blockPos) {
+    auto& level = levels_[scaleLog2 - 1];
+    auto it = level.find(blockPos);
+    if (it != level.end()) {
+        return it->second;
+    }
+
+    // Linked up the pyramid before this level's storage can move
+    const std::uint32_t parent = scaleLog2 < kMaxScaleLog2 ? acquireBlock(scaleLog2 + 1, blockOf(blockPos, 1))
+                                                           : kNoBlock;
+    std::uint32_t slot = 0;
+    if (freeBlocks_.empty()) {
+        slot = static_cast<std::uint32_t>(blocks_.size());
+        blocks_.emplace_back();
+    } else {
+        slot = freeBlocks_.back();
+        freeBlocks_.pop_back();
+    }
+    blocks_[slot] = Block{0, parent};
+    level.insert(blockPos, slot);
+    return slot;
+}
@@ -0,0 +1,354 @@
+#include "core/SimulationStore.h"
+#include "core/PatternLibrary.h"
+#include "core/Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+// Latency samples one step request adds at most, so a huge step count cannot stall the request
+constexpr std::uint64_t kMaxStepSamples = 1024;
+
+// Generations a multi-step request runs between memory limit checks
+constexpr std::uint64_t kMemoryCheckSteps = 64;
+
+// Cells alive only in after (born) and only in before (died); both lists sorted
+void diffBoards(const std::vector<Position>& before, const std::vector<Position>& after, std::vector<Position>& born,
+                std::vector<Position>& died) {
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(born));
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(died));
+}
+
+bool isPatternName(const std::string& name) {
+    return !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+    });
+}
+
+} // namespace
+
+void StreamSubscription::record(const Position& pos, bool alive) {
+    // Every change flips the cell, so one already pending is back the way the client has it
+    if (keyframe_ || pending_.erase(pos) > 0) {
+        return;
+    }
+    if (pending_.size() >= maxPendingCells_) {
+        pending_.clear();
+        keyframe_ = true;
+        return;
+    }
+    pending_.insert(pos, alive);
+}
+
+SimulationSession::SimulationSession(std::string id, std::unique_ptr<LifeEngine> engine)
+    : id_(std::move(id))
+    , engine_(std::move(engine)) {
+}
+
+SimulationSession::Snapshot SimulationSession::snapshot() const {
+    const auto start = std::chrono::steady_clock::now();
+    auto lock = lockCounted(mutex_, metrics_);
+    auto snapshot = snapshotLocked();
+    metrics_.queryNanos.record(std::chrono::steady_clock::now() - start);
+    return snapshot;
+}
+
+SimulationSession::Snapshot SimulationSession::update(std::optional<std::uint64_t> generation,
+                                                      std::optional<std::span<const Position>> cells) {
+    auto lock = lockCounted(mutex_, metrics_);
+    if (cells) {
+        const std::uint64_t current = engine_->getGenerationCount();
+        std::vector<Position> board;
+        board.reserve(cells->size());
+        std::copy_if(cells->begin(), cells->end(), std::back_inserter(board),
+                     [this](const Position& pos) { return inGrid(pos); });
+        engine_->reset();
+        engine_->setCellsAlive(board);
+        engine_->setGenerationCount(current);
+        settled_ = false;
+        publishKeyframe();
+    }
+    if (generation) {
+        engine_->setGenerationCount(*generation);
+    }
+    return snapshotLocked();
+}
+
+std::size_t SimulationSession::addPattern(std::span<const Position> cells, Position offset) {
+    auto lock = lockCounted(mutex_, metrics_);
+    std::vector<Position> added;
+    added.reserve(cells.size());
+    for (const auto& cell : cells) {
+        const Position pos(cell.x + offset.x, cell.y + offset.y);
+        if (inGrid(pos) && !engine_->isCellAlive(pos.x, pos.y)) {
+            added.push_back(pos);
+        }
+    }
+    std::sort(added.begin(), added.end());
+    added.erase(std::unique(added.begin(), added.end()), added.end());
+
+    if (!added.empty()) {
+        engine_->setCellsAlive(added);
+        settled_ = false;
+        publish(added, {});
+    }
+    return added.size();
+}
+
+SimulationSession::StepResult SimulationSession::step(std::uint64_t steps) {
+    GOL_TRACE_SCOPE("SimulationSession::step");
+    auto lock = lockCounted(mutex_, metrics_);
+    steps = std::max<std::uint64_t>(steps, 1);
+    if (exceedsMemoryLimit(*engine_)) {
+        throw MemoryLimitError("Simulation is over its memory limit of " +
+                               std::to_string(engine_->getConfig().getMemoryLimitMb()) + " MB");
+    }
+    const auto start = std::chrono::steady_clock::now();
+
+    StepResult result;
+    std::uint64_t taken = 1;
+    if (steps == 1) {
+        settled_ = !engine_->step();
+        publish(engine_->getBornCells(), engine_->getDiedCells());
+        result.changedCells = engine_->getBornCells().size() + engine_->getDiedCells().size();
+        metrics_.recordChanges(engine_->getBornCells().size(), engine_->getDiedCells().size());
+    } else {
+        // The engine's changes only cover its last step, so compare whole boards
+        const auto before = sortedCells();
+        const std::uint64_t startGeneration = engine_->getGenerationCount();
+
+        // In chunks, so a growing board stops near the memory limit
+        taken = 0;
+        bool settled = false;
+        while (taken < steps && !exceedsMemoryLimit(*engine_)) {
+            const std::uint64_t chunk = std::min(steps - taken, kMemoryCheckSteps);
+            const std::uint64_t chunkTaken = engine_->advance(chunk);
+            taken += chunkTaken;
+            if (chunkTaken < chunk) {
+                settled = true;
+                break;
+            }
+        }
+        if (settled) {
+            // A settled board stops advance() early; the generation still moves on
+            skipSettledSteps(*engine_, startGeneration, taken, steps);
+            taken = steps;
+        }
+        settled_ = settled;
+
+        std::vector<Position> born;
+        std::vector<Position> died;
+        diffBoards(before, sortedCells(), born, died);
+        publish(born, died);
+        result.changedCells = born.size() + died.size();
+        metrics_.recordChanges(born.size(), died.size());
+    }
+
+    // Several steps in one request count as that many samples of their mean
+    const auto perStep = (std::chrono::steady_clock::now() - start) / taken;
+    for (std::uint64_t i = 0; i < std::min(taken, kMaxStepSamples); ++i) {
+        metrics_.stepNanos.record(perStep);
+    }
+
+    result.generation = engine_->getGenerationCount();
+    result.liveCells = engine_->getLivingCellCount();
+    metrics_.livingCells.store(result.liveCells, std::memory_order_relaxed);
+    return result;
+}
+
+std::shared_ptr<StreamSubscription> SimulationSession::subscribe(std::size_t maxPendingCells) {
+    auto lock = lockCounted(mutex_, metrics_);
+    auto subscription = std::make_shared<StreamSubscription>(maxPendingCells);
+    subscribers_.push_back(subscription);
+    return subscription;
+}
+
+bool SimulationSession::hasUpdate(const StreamSubscription& subscription) const {
+    auto lock = lockCounted(mutex_, metrics_);
+    return subscription.keyframe_ || !subscription.pending_.empty() ||
+           subscription.sentGeneration_ != engine_->getGenerationCount();
+}
+
+SimulationSession::StreamUpdate SimulationSession::takeUpdate(StreamSubscription& subscription) {
+    const auto start = std::chrono::steady_clock::now();
+    auto lock = lockCounted(mutex_, metrics_);
+    StreamUpdate update;
+    // Also when the board itself is the smaller message
+    update.keyframe = subscription.keyframe_ || subscription.pending_.size() > engine_->getLivingCellCount();
+
+    if (update.keyframe) {
+        update.born = sortedCells();
+    } else {
+        for (const auto& [pos, alive] : subscription.pending_) {
+            (alive ? update.born : update.died).push_back(pos);
+        }
+        std::sort(update.born.begin(), update.born.end());
+        std::sort(update.died.begin(), update.died.end());
+    }
+    subscription.pending_.clear();
+    subscription.keyframe_ = false;
+    subscription.sentGeneration_ = engine_->getGenerationCount();
+
+    update.generation = engine_->getGenerationCount();
+    update.liveCells = engine_->getLivingCellCount();
+    update.ended = update.liveCells == 0 || settled_;
+    metrics_.queryNanos.record(std::chrono::steady_clock::now() - start);
+    return update;
+}
+
+SimulationSession::Snapshot SimulationSession::snapshotLocked() const {
+    const auto& config = engine_->getConfig();
+    return {engine_->getGenerationCount(), config.getGridWidth(), config.getGridHeight(), sortedCells()};
+}
+
+bool SimulationSession::inGrid(const Position& pos) const {
+    const auto& config = engine_->getConfig();
+    return pos.x >= 0 && pos.x < config.getGridWidth() && pos.y >= 0 && pos.y < config.getGridHeight();
+}
+
+std::vector<Position> SimulationSession::sortedCells() const {
+    auto cells = engine_->getLivingPositions();
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+void SimulationSession::publish(std::span<const Position> born, std::span<const Position> died) {
+    // Called with mutex_ held; released subscriptions are dropped on the way
+    std::erase_if(subscribers_, [&](const std::weak_ptr<StreamSubscription>& weak) {
+        auto subscription = weak.lock();
+        if (!subscription) {
+            return true;
+        }
+        for (const auto& pos : born) {
+            subscription->record(pos, true);
+        }
+        for (const auto& pos : died) {
+            subscription->record(pos, false);
+        }
+        return false;
+    });
+}
+
+void SimulationSession::publishKeyframe() {
+    // Called with mutex_ held, when the board is replaced wholesale
+    std::erase_if(subscribers_, [](const std::weak_ptr<StreamSubscription>& weak) {
+        auto subscription = weak.lock();
+        if (!subscription) {
+            return true;
+        }
+        subscription->pending_.clear();
+        subscription->keyframe_ = true;
+        return false;
+    });
+}
+
+SimulationStore::SimulationStore(GameConfig baseConfig, std::string patternDirectory)
+    : baseConfig_(std::move(baseConfig))
+    , patternDirectory_(std::move(patternDirectory))
+    , idGenerator_(std::random_device{}()) {
+}
+
+std::shared_ptr<SimulationSession> SimulationStore::create(std::int32_t width, std::int32_t height,
+                                                           const std::string& initialPattern) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Width and height must be positive");
+    }
+    if (width > kMaxGridDimension || height > kMaxGridDimension) {
+        throw std::invalid_argument("Grid size too large (max " + std::to_string(kMaxGridDimension) + "x" +
+                                    std::to_string(kMaxGridDimension) + ")");
+    }
+
+    GameConfig config = baseConfig_;
+    config.setGridWidth(width);
+    config.setGridHeight(height);
+    if (!config.isValid()) {
+        throw std::invalid_argument("Invalid simulation configuration");
+    }
+
+    // Read the pattern before taking the lock; a bad name creates nothing
+    std::vector<Position> pattern;
+    if (!initialPattern.empty()) {
+        pattern = readNamedPattern(initialPattern);
+    }
+
+    std::unique_lock lock(mutex_);
+    auto session = std::make_shared<SimulationSession>(nextId(), createLifeEngine(config));
+    sessions_.emplace(session->getId(), session);
+    lock.unlock();
+
+    if (!pattern.empty()) {
+        // Centred on the grid
+        const auto [minX, maxX] = std::minmax_element(pattern.begin(), pattern.end(),
+            [](const Position& a, const Position& b) { return a.x < b.x; });
+        const auto [minY, maxY] = std::minmax_element(pattern.begin(), pattern.end(),
+            [](const Position& a, const Position& b) { return a.y < b.y; });
+        const Position offset((width - (maxX->x - minX->x + 1)) / 2 - minX->x,
+                              (height - (maxY->y - minY->y + 1)) / 2 - minY->y);
+        session->addPattern(pattern, offset);
+    }
+    return session;
+}
+
+std::shared_ptr<SimulationSession> SimulationStore::find(const std::string& id) const {
+    std::scoped_lock lock(mutex_);
+    auto it = sessions_.find(id);
+    return it == sessions_.end() ? nullptr : it->second;
+}
+
+bool SimulationStore::erase(const std::string& id) {
+    std::scoped_lock lock(mutex_);
+    return sessions_.erase(id) > 0;
+}
+
+std::size_t SimulationStore::size() const {
+    std::scoped_lock lock(mutex_);
+    return sessions_.size();
+}
+
+std::vector<std::shared_ptr<SimulationSession>> SimulationStore::list() const {
+    std::scoped_lock lock(mutex_);
+    std::vector<std::shared_ptr<SimulationSession>> sessions;
+    sessions.reserve(sessions_.size());
+    for (const auto& [id, session] : sessions_) {
+        sessions.push_back(session);
+    }
+    return sessions;
+}
+
+std::vector<Position> SimulationStore::readNamedPattern(const std::string& name) const {
+    // Names, not paths, so a client cannot read arbitrary files
+    if (!isPatternName(name)) {
+        throw std::invalid_argument("Invalid pattern name: " + name);
+    }
+
+    // A file in the pattern directory is parsed once per version of it, by the
+    // process-wide cache; without one the compiled-in corpus answers
+    const std::string path = patternDirectory_ + "/" + name + ".json";
+    std::error_code error;
+    if (std::filesystem::is_regular_file(path, error)) {
+        try {
+            return *PatternCache::instance().load(path);
+        } catch (const std::exception& e) {
+            throw std::invalid_argument("Malformed pattern " + name + ": " + e.what());
+        }
+    }
+    if (const EmbeddedPattern* pattern = findEmbeddedPattern(name)) {
+        return std::vector<Position>(pattern->cells.begin(), pattern->cells.end());
+    }
+    throw std::invalid_argument("Unknown pattern: " + name);
+}
+
+std::string SimulationStore::nextId() {
+    // Random (version 4) UUID, the id format the Bevy server hands out
+    const std::uint64_t high = (idGenerator_() & ~0xF000ull) | 0x4000ull;
+    const std::uint64_t low = (idGenerator_() & ~(0xC000ull << 48)) | (0x8000ull << 48);
+    char id[37];
+    std::snprintf(id, sizeof(id), "%08x-%04x-%04x-%04x-%012llx", static_cast<unsigned>(high >> 32),
+                  static_cast<unsigned>((high >> 16) & 0xFFFF), static_cast<unsigned>(high & 0xFFFF),
+                  static_cast<unsigned>(low >> 48), static_cast<unsigned long long>(low & 0xFFFFFFFFFFFFull));
+    return id;
+}
@@ -0,0 +1,377 @@
+#include "core/SnapshotFile.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kHeaderSize = 64;
+constexpr char kMagic[4] = {'G', 'O', 'L', 'S'};
+constexpr std::uint32_t kFlagWrapEdges = 1u;
+
+void putU32(std::uint8_t* out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+void putU64(std::uint8_t* out, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+std::uint32_t getU32(const std::uint8_t* in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+std::uint64_t getU64(const std::uint8_t* in) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+void putVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint64_t getVarint(const std::uint8_t*& in, const std::uint8_t* end) {
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (in == end) {
+            throw std::runtime_error("Snapshot payload is truncated");
+        }
+        std::uint8_t byte = *in++;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Snapshot payload holds an oversized number");
+}
+
+std::int32_t checkedCoordinate(std::int64_t value) {
+    if (value > std::numeric_limits<std::int32_t>::max()) {
+        throw std::runtime_error("Snapshot cell lies outside the 32-bit plane");
+    }
+    return static_cast<std::int32_t>(value);
+}
+
+// Header and payload, as they go in the file
+std::vector<std::uint8_t> encodeSnapshot(const SnapshotInfo& info, std::vector<Position>& cells) {
+    std::sort(cells.begin(), cells.end(), [](const Position& a, const Position& b) {
+        return a.y != b.y ? a.y < b.y : a.x < b.x;
+    });
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+    std::int32_t boundsMinX = 0;
+    std::int32_t boundsMinY = 0;
+    if (!cells.empty()) {
+        boundsMinY = cells.front().y;
+        boundsMinX = std::min_element(cells.begin(), cells.end(), [](const Position& a, const Position& b) {
+            return a.x < b.x;
+        })->x;
+    }
+
+    // The payload goes after room for the header, which needs its size
+    std::vector<std::uint8_t> bytes(kHeaderSize);
+    bytes.reserve(kHeaderSize + cells.size() * 2 + 16);
+    std::uint32_t rowCount = 0;
+    std::int64_t previousY = boundsMinY;
+
+    for (std::size_t rowBegin = 0; rowBegin < cells.size();) {
+        const std::int32_t y = cells[rowBegin].y;
+        std::size_t rowEnd = rowBegin + 1;
+        std::size_t runs = 1;
+        for (; rowEnd < cells.size() && cells[rowEnd].y == y; ++rowEnd) {
+            if (cells[rowEnd].x != cells[rowEnd - 1].x + 1) {
+                runs++;
+            }
+        }
+
+        putVarint(bytes, static_cast<std::uint64_t>(std::int64_t{y} - previousY));
+        putVarint(bytes, runs);
+        previousY = y;
+        rowCount++;
+
+        std::int64_t runEnd = boundsMinX;
+        for (std::size_t i = rowBegin; i < rowEnd;) {
+            std::size_t j = i + 1;
+            while (j < rowEnd && cells[j].x == cells[j - 1].x + 1) {
+                ++j;
+            }
+            putVarint(bytes, static_cast<std::uint64_t>(std::int64_t{cells[i].x} - runEnd));
+            putVarint(bytes, j - i);
+            runEnd = std::int64_t{cells[i].x} + static_cast<std::int64_t>(j - i);
+            i = j;
+        }
+
+        rowBegin = rowEnd;
+    }
+
+    std::uint8_t* header = bytes.data();
+    std::memcpy(header, kMagic, sizeof(kMagic));
+    putU32(header + 4, kSnapshotVersion);
+    putU64(header + 8, info.generation);
+    putU32(header + 16, static_cast<std::uint32_t>(info.gridMinX));
+    putU32(header + 20, static_cast<std::uint32_t>(info.gridMinY));
+    putU32(header + 24, info.gridWidth);
+    putU32(header + 28, info.gridHeight);
+    putU32(header + 32, info.wrapEdges ? kFlagWrapEdges : 0u);
+    putU32(header + 36, static_cast<std::uint32_t>(boundsMinX));
+    putU32(header + 40, static_cast<std::uint32_t>(boundsMinY));
+    putU32(header + 44, rowCount);
+    putU64(header + 48, cells.size());
+    putU64(header + 56, bytes.size() - kHeaderSize);
+    return bytes;
+}
+
+#ifdef _WIN32
+void writeSynced(const std::string& path, const std::vector<std::uint8_t>& bytes) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open snapshot file for writing: " + path);
+    }
+    std::size_t written = 0;
+    bool ok = true;
+    while (ok && written < bytes.size()) {
+        DWORD chunk = 0;
+        const auto want = static_cast<DWORD>(std::min<std::size_t>(bytes.size() - written, 1u << 30));
+        ok = WriteFile(file, bytes.data() + written, want, &chunk, nullptr) != 0;
+        written += chunk;
+    }
+    ok = ok && FlushFileBuffers(file) != 0;
+    CloseHandle(file);
+    if (!ok) {
+        throw std::runtime_error("Could not write snapshot file: " + path);
+    }
+}
+
+void replaceFile(const std::string& from, const std::string& to) {
+    if (!MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        throw std::runtime_error("Could not replace snapshot file: " + to);
+    }
+}
+#else
+void writeSynced(const std::string& path, const std::vector<std::uint8_t>& bytes) {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open snapshot file for writing: " + path);
+    }
+    std::size_t written = 0;
+    bool ok = true;
+    while (ok && written < bytes.size()) {
+        const ssize_t chunk = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (chunk > 0) {
+            written += static_cast<std::size_t>(chunk);
+        } else {
+            ok = chunk < 0 && errno == EINTR;
+        }
+    }
+    ok = ok && ::fsync(fd) == 0;
+    ::close(fd);
+    if (!ok) {
+        throw std::runtime_error("Could not write snapshot file: " + path);
+    }
+}
+
+void replaceFile(const std::string& from, const std::string& to) {
+    if (::rename(from.c_str(), to.c_str()) != 0) {
+        throw std::runtime_error("Could not replace snapshot file: " + to);
+    }
+
+    // The rename itself only survives a crash once the directory is synced
+    const auto slash = to.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : to.substr(0, slash);
+    const int fd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+#endif
+
+} // namespace
+
+void writeSnapshotFile(const std::string& path, const SnapshotInfo& info, std::vector<Position>& cells) {
+    const auto bytes = encodeSnapshot(info, cells);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open snapshot file for writing: " + path);
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file.good()) {
+        throw std::runtime_error("Could not write snapshot file: " + path);
+    }
+}
+
+void writeSnapshotFileSynced(const std::string& path, const SnapshotInfo& info, std::vector<Position>& cells) {
+    const auto bytes = encodeSnapshot(info, cells);
+    const std::string partial = path + ".partial";
+    try {
+        writeSynced(partial, bytes);
+        replaceFile(partial, path);
+    } catch (...) {
+        std::remove(partial.c_str());
+        throw;
+    }
+}
+
+SnapshotReader::SnapshotReader(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open snapshot file: " + path);
+    }
+    fileHandle_ = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || static_cast<std::uint64_t>(fileSize.QuadPart) < kHeaderSize) {
+        unmap();
+        throw std::runtime_error("Not a snapshot file: " + path);
+    }
+    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+
+    mappingHandle_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle_ != nullptr) {
+        data_ = static_cast<const std::uint8_t*>(MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (data_ == nullptr) {
+        unmap();
+        throw std::runtime_error("Could not map snapshot file: " + path);
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open snapshot file: " + path);
+    }
+
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(kHeaderSize)) {
+        ::close(fd);
+        throw std::runtime_error("Not a snapshot file: " + path);
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+
+    // The mapping keeps the file alive once the descriptor is closed
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        size_ = 0;
+        throw std::runtime_error("Could not map snapshot file: " + path);
+    }
+    ::madvise(mapped, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const std::uint8_t*>(mapped);
+#endif
+
+    if (std::memcmp(data_, kMagic, sizeof(kMagic)) != 0) {
+        unmap();
+        throw std::runtime_error("Not a snapshot file: " + path);
+    }
+    if (getU32(data_ + 4) != kSnapshotVersion) {
+        unmap();
+        throw std::runtime_error("Unsupported snapshot version in " + path);
+    }
+
+    info_.generation = getU64(data_ + 8);
+    info_.gridMinX = static_cast<std::int32_t>(getU32(data_ + 16));
+    info_.gridMinY = static_cast<std::int32_t>(getU32(data_ + 20));
+    info_.gridWidth = getU32(data_ + 24);
+    info_.gridHeight = getU32(data_ + 28);
+    info_.wrapEdges = (getU32(data_ + 32) & kFlagWrapEdges) != 0;
+    boundsMinX_ = static_cast<std::int32_t>(getU32(data_ + 36));
+    boundsMinY_ = static_cast<std::int32_t>(getU32(data_ + 40));
+    rowCount_ = getU32(data_ + 44);
+    info_.cellCount = getU64(data_ + 48);
+    payloadBytes_ = getU64(data_ + 56);
+
+    if (payloadBytes_ > size_ - kHeaderSize) {
+        unmap();
+        throw std::runtime_error("Snapshot file is truncated: " + path);
+    }
+}
+
+SnapshotReader::~SnapshotReader() {
+    unmap();
+}
+
+void SnapshotReader::unmap() {
+#ifdef _WIN32
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mappingHandle_ != nullptr) {
+        CloseHandle(mappingHandle_);
+    }
+    if (fileHandle_ != nullptr) {
+        CloseHandle(fileHandle_);
+    }
+    mappingHandle_ = nullptr;
+    fileHandle_ = nullptr;
+#else
+    if (data_ != nullptr) {
+        ::munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+void SnapshotReader::readRuns(const std::function<void(std::int32_t x, std::int32_t y, std::uint32_t length)>& fn) const {
+    const std::uint8_t* in = data_ + kHeaderSize;
+    const std::uint8_t* end = in + payloadBytes_;
+    std::uint64_t cells = 0;
+    std::int64_t y = boundsMinY_;
+
+    for (std::uint32_t row = 0; row < rowCount_; ++row) {
+        y += static_cast<std::int64_t>(getVarint(in, end) & 0xFFFFFFFFu);
+        const std::int32_t rowY = checkedCoordinate(y);
+        const std::uint64_t runs = getVarint(in, end);
+
+        std::int64_t runEnd = boundsMinX_;
+        for (std::uint64_t run = 0; run < runs; ++run) {
+            const std::int64_t x = runEnd + static_cast<std::int64_t>(getVarint(in, end) & 0xFFFFFFFFu);
+            const std::uint64_t length = getVarint(in, end);
+            if (length == 0 || length > std::numeric_limits<std::uint32_t>::max()) {
+                throw std::runtime_error("Snapshot payload holds an invalid run");
+            }
+            runEnd = x + static_cast<std::int64_t>(length);
+            checkedCoordinate(runEnd - 1);
+
+            fn(checkedCoordinate(x), rowY, static_cast<std::uint32_t>(length));
+            cells += length;
+        }
+    }
+
+    if (cells != info_.cellCount || in != end) {
+        throw std::runtime_error("Snapshot payload does not match its header");
+    }
+}
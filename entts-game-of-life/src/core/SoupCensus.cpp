@@ -0,0 +1,453 @@
+#include "core/SoupCensus.h"
+#include "core/Benchmark.h"
+#include "core/ChunkedPlane.h"
+#include "core/Trace.h"
+#include "core/WorkStealingPool.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Cells at most this far apart in x and in y may be one object
+constexpr std::int32_t kObjectReach = 2;
+
+// Pieces that evolve the same apart as together for this many generations
+// are separate objects; settled ash repeats within two
+constexpr int kInteractionGenerations = 2;
+
+using ShapeTally = std::unordered_map<std::vector<Position>, std::uint64_t, ObjectShapeHash>;
+
+struct NamedShape {
+    const char* name;
+    std::vector<Position> cells;
+    std::uint32_t period;
+};
+
+// The objects soups most often leave behind
+const std::vector<NamedShape>& builtinShapes() {
+    static const std::vector<NamedShape> shapes{
+        {"Block", {{0, 0}, {1, 0}, {0, 1}, {1, 1}}, 1},
+        {"Beehive", {{1, 0}, {2, 0}, {0, 1}, {3, 1}, {1, 2}, {2, 2}}, 1},
+        {"Loaf", {{1, 0}, {2, 0}, {0, 1}, {3, 1}, {1, 2}, {3, 2}, {2, 3}}, 1},
+        {"Boat", {{0, 0}, {1, 0}, {0, 1}, {2, 1}, {1, 2}}, 1},
+        {"Ship", {{0, 0}, {1, 0}, {0, 1}, {2, 1}, {1, 2}, {2, 2}}, 1},
+        {"Tub", {{1, 0}, {0, 1}, {2, 1}, {1, 2}}, 1},
+        {"Pond", {{1, 0}, {2, 0}, {0, 1}, {3, 1}, {0, 2}, {3, 2}, {1, 3}, {2, 3}}, 1},
+        {"Long boat", {{0, 0}, {1, 0}, {0, 1}, {2, 1}, {1, 2}, {3, 2}, {2, 3}}, 1},
+        {"Barge", {{1, 0}, {0, 1}, {2, 1}, {1, 2}, {3, 2}, {2, 3}}, 1},
+        {"Eater 1", {{0, 0}, {1, 0}, {0, 1}, {1, 2}, {2, 2}, {3, 2}, {3, 3}}, 1},
+        {"Blinker", {{0, 0}, {1, 0}, {2, 0}}, 2},
+        {"Glider", {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}}, 4},
+    };
+    return shapes;
+}
+
+// One generation of a few cells on the open plane, sorted
+std::vector<Position> stepCells(std::span<const Position> cells, const LifeRule& rule) {
+    // Every cell marks itself and its eight neighbors; a sorted run of marks
+    // for one position gives its state and neighbor count
+    std::vector<std::pair<Position, bool>> marks; // (position, is the cell itself)
+    marks.reserve(cells.size() * 9);
+    for (const auto& pos : cells) {
+        for (std::int32_t dy = -1; dy <= 1; ++dy) {
+            for (std::int32_t dx = -1; dx <= 1; ++dx) {
+                marks.emplace_back(Position(pos.x + dx, pos.y + dy), dx == 0 && dy == 0);
+            }
+        }
+    }
+    std::sort(marks.begin(), marks.end());
+
+    std::vector<Position> next;
+    for (std::size_t i = 0; i < marks.size();) {
+        const Position pos = marks[i].first;
+        bool alive = false;
+        std::uint32_t neighbors = 0;
+        for (; i < marks.size() && marks[i].first == pos; ++i) {
+            alive |= marks[i].second;
+            neighbors += marks[i].second ? 0u : 1u;
+        }
+        if (rule.nextState(alive, neighbors)) {
+            next.push_back(pos);
+        }
+    }
+    return next;
+}
+
+// Whether two pieces of ash change each other's evolution
+bool piecesInteract(const std::vector<Position>& a, const std::vector<Position>& b, const LifeRule& rule) {
+    std::vector<Position> alone = a;
+    std::vector<Position> other = b;
+    std::vector<Position> together = a;
+    together.insert(together.end(), b.begin(), b.end());
+    std::vector<Position> apart;
+    for (int generation = 0; generation < kInteractionGenerations; ++generation) {
+        alone = stepCells(alone, rule);
+        other = stepCells(other, rule);
+        together = stepCells(together, rule);
+        apart.clear();
+        std::merge(alone.begin(), alone.end(), other.begin(), other.end(), std::back_inserter(apart));
+        if (apart != together) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Splits unwrapped cells into the pieces whose cells touch
+std::vector<std::vector<Position>> touchingPieces(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    std::vector<bool> taken(cells.size(), false);
+    std::vector<std::vector<Position>> pieces;
+    std::vector<std::size_t> pending;
+    for (std::size_t first = 0; first < cells.size(); ++first) {
+        if (taken[first]) {
+            continue;
+        }
+        taken[first] = true;
+        auto& piece = pieces.emplace_back();
+        pending.assign(1, first);
+        while (!pending.empty()) {
+            const Position pos = cells[pending.back()];
+            pending.pop_back();
+            piece.push_back(pos);
+            for (std::int32_t dy = -1; dy <= 1; ++dy) {
+                for (std::int32_t dx = -1; dx <= 1; ++dx) {
+                    const auto it = std::lower_bound(cells.begin(), cells.end(), Position(pos.x + dx, pos.y + dy));
+                    const auto index = static_cast<std::size_t>(it - cells.begin());
+                    if (it != cells.end() && *it == Position(pos.x + dx, pos.y + dy) && !taken[index]) {
+                        taken[index] = true;
+                        pending.push_back(index);
+                    }
+                }
+            }
+        }
+        std::sort(piece.begin(), piece.end());
+    }
+    return pieces;
+}
+
+// Joins the touching pieces of a group into the objects that interact
+void separateGroup(std::vector<Position> group, const LifeRule& rule, std::vector<std::vector<Position>>& objects) {
+    auto pieces = touchingPieces(std::move(group));
+    if (pieces.size() == 1) {
+        objects.push_back(std::move(pieces.front()));
+        return;
+    }
+
+    struct Bounds {
+        std::int32_t minX, maxX, minY, maxY;
+    };
+    std::vector<Bounds> bounds;
+    for (const auto& piece : pieces) {
+        Bounds box{piece.front().x, piece.back().x, piece.front().y, piece.front().y};
+        for (const auto& pos : piece) {
+            box.minY = std::min(box.minY, pos.y);
+            box.maxY = std::max(box.maxY, pos.y);
+        }
+        bounds.push_back(box);
+    }
+
+    std::vector<std::size_t> parent(pieces.size());
+    for (std::size_t i = 0; i < parent.size(); ++i) {
+        parent[i] = i;
+    }
+    const auto root = [&parent](std::size_t i) {
+        while (parent[i] != i) {
+            i = parent[i] = parent[parent[i]];
+        }
+        return i;
+    };
+    for (std::size_t i = 0; i < pieces.size(); ++i) {
+        for (std::size_t j = i + 1; j < pieces.size(); ++j) {
+            const bool near = bounds[i].minX - kObjectReach <= bounds[j].maxX &&
+                              bounds[j].minX - kObjectReach <= bounds[i].maxX &&
+                              bounds[i].minY - kObjectReach <= bounds[j].maxY &&
+                              bounds[j].minY - kObjectReach <= bounds[i].maxY;
+            if (near && root(i) != root(j) && piecesInteract(pieces[i], pieces[j], rule)) {
+                parent[root(i)] = root(j);
+            }
+        }
+    }
+
+    std::vector<std::size_t> objectOf(pieces.size(), pieces.size());
+    for (std::size_t i = 0; i < pieces.size(); ++i) {
+        auto& slot = objectOf[root(i)];
+        if (slot == pieces.size()) {
+            slot = objects.size();
+            objects.emplace_back();
+        }
+        objects[slot].insert(objects[slot].end(), pieces[i].begin(), pieces[i].end());
+    }
+}
+
+void mergeTally(ShapeTally& into, const ShapeTally& from) {
+    for (const auto& [shape, count] : from) {
+        into[shape] += count;
+    }
+}
+
+} // namespace
+
+std::vector<Position> canonicalObjectCells(std::span<const Position> cells) {
+    std::vector<Position> best;
+    std::vector<Position> candidate;
+    candidate.reserve(cells.size());
+    for (int transform = 0; transform < 8; ++transform) {
+        // Bit 0 mirrors x, bit 1 mirrors y, bit 2 swaps the axes
+        candidate.clear();
+        std::int32_t minX = std::numeric_limits<std::int32_t>::max();
+        std::int32_t minY = std::numeric_limits<std::int32_t>::max();
+        for (const auto& pos : cells) {
+            std::int32_t x = (transform & 1) ? -pos.x : pos.x;
+            std::int32_t y = (transform & 2) ? -pos.y : pos.y;
+            if (transform & 4) {
+                std::swap(x, y);
+            }
+            candidate.emplace_back(x, y);
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+        }
+        for (auto& pos : candidate) {
+            pos = Position(pos.x - minX, pos.y - minY);
+        }
+        std::sort(candidate.begin(), candidate.end());
+        if (transform == 0 || candidate < best) {
+            best.swap(candidate);
+        }
+    }
+    return best;
+}
+
+std::uint64_t objectHash(std::span<const Position> canonical) {
+    std::uint64_t hash = canonical.size();
+    for (const auto& pos : canonical) {
+        hash = mixCoordinateKey(hash ^ pos.packed());
+    }
+    return hash;
+}
+
+std::vector<std::vector<Position>> splitObjects(std::span<const Position> cells, std::int32_t width,
+                                                std::int32_t height, bool wrapEdges, const LifeRule& rule) {
+    // Grid of indexes into cells, -1 where no cell is alive or one was already taken
+    const auto boardCell = [width](std::int32_t x, std::int32_t y) {
+        return static_cast<std::size_t>(y) * static_cast<std::size_t>(width) + static_cast<std::size_t>(x);
+    };
+    std::vector<std::int32_t> board(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), -1);
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        const auto& pos = cells[i];
+        if (pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height) {
+            board[boardCell(pos.x, pos.y)] = static_cast<std::int32_t>(i);
+        }
+    }
+
+    std::vector<std::vector<Position>> objects;
+    std::vector<Position> group;
+    std::vector<Position> pending; // Unwrapped coordinates still to spread from
+    for (const auto& start : cells) {
+        if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height ||
+            board[boardCell(start.x, start.y)] < 0) {
+            continue;
+        }
+        board[boardCell(start.x, start.y)] = -1;
+        group.clear();
+        pending.assign(1, start);
+        while (!pending.empty()) {
+            const Position pos = pending.back();
+            pending.pop_back();
+            group.push_back(pos);
+            for (std::int32_t dy = -kObjectReach; dy <= kObjectReach; ++dy) {
+                for (std::int32_t dx = -kObjectReach; dx <= kObjectReach; ++dx) {
+                    std::int32_t x = pos.x + dx;
+                    std::int32_t y = pos.y + dy;
+                    if (wrapEdges) {
+                        x = ((x % width) + width) % width;
+                        y = ((y % height) + height) % height;
+                    } else if (x < 0 || x >= width || y < 0 || y >= height) {
+                        continue;
+                    }
+                    auto& slot = board[boardCell(x, y)];
+                    if (slot >= 0) {
+                        slot = -1;
+                        pending.emplace_back(pos.x + dx, pos.y + dy);
+                    }
+                }
+            }
+        }
+        separateGroup(group, rule, objects);
+    }
+    return objects;
+}
+
+ObjectCatalog::ObjectCatalog(const LifeRule& rule)
+    : rule_(rule) {
+    for (const auto& shape : builtinShapes()) {
+        addPattern(shape.name, shape.cells, shape.period);
+    }
+}
+
+bool ObjectCatalog::addPattern(const std::string& name, std::span<const Position> cells, std::uint32_t period) {
+    if (cells.empty() || period == 0) {
+        return false;
+    }
+
+    ChunkedPlane plane(rule_);
+    for (const auto& pos : cells) {
+        plane.setCell(pos.x, pos.y, true);
+    }
+    std::vector<std::vector<Position>> phases;
+    std::vector<Position> living;
+    for (std::uint32_t generation = 0; generation < period; ++generation) {
+        living.clear();
+        plane.collectLivingCells(living);
+        phases.push_back(canonicalObjectCells(living));
+        plane.step();
+    }
+    living.clear();
+    plane.collectLivingCells(living);
+    if (canonicalObjectCells(living) != phases.front()) {
+        return false;
+    }
+
+    const KnownObject known{name, phases.front()};
+    for (auto& phase : phases) {
+        names_[std::move(phase)] = known;
+    }
+    return true;
+}
+
+std::size_t ObjectCatalog::loadPatternDirectory(const std::string& directory) {
+    std::vector<std::filesystem::path> patterns;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") {
+            patterns.push_back(entry.path());
+        }
+    }
+    std::sort(patterns.begin(), patterns.end());
+
+    std::size_t registered = 0;
+    for (const auto& path : patterns) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open pattern file: " + path.string());
+        }
+        const auto json = nlohmann::json::parse(file);
+        std::vector<Position> cells;
+        for (const auto& cell : json.value("cells", nlohmann::json::array())) {
+            cells.emplace_back(cell["x"].get<std::int32_t>(), cell["y"].get<std::int32_t>());
+        }
+        if (addPattern(json.value("name", path.stem().string()), cells, json.value("period", 1u))) {
+            ++registered;
+        }
+    }
+    return registered;
+}
+
+const KnownObject* ObjectCatalog::find(const std::vector<Position>& canonical) const {
+    const auto it = names_.find(canonical);
+    return it == names_.end() ? nullptr : &it->second;
+}
+
+std::string ObjectCatalog::nameOf(const std::vector<Position>& canonical) const {
+    const KnownObject* known = find(canonical);
+    return known ? known->name : std::string();
+}
+
+SoupCensusResult runSoupCensus(const SoupCensusConfig& config, const ObjectCatalog& catalog) {
+    GOL_TRACE_SCOPE("runSoupCensus");
+    if (config.soupSize < 1 || config.soupSize > config.boardSize) {
+        throw std::invalid_argument("Census soups must fit on the board");
+    }
+    if (config.generationLimit == 0) {
+        throw std::invalid_argument("Census soups need a generation limit; some never settle");
+    }
+    // Checks the board size before any worker starts
+    BoardEnsemble(config.boardSize, config.boardSize, config.wrapEdges, config.rule);
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t perEnsemble = std::max(config.soupsPerEnsemble, 1u);
+    const std::size_t ensembles = static_cast<std::size_t>((config.soups + perEnsemble - 1) / perEnsemble);
+    const std::int32_t offset = (config.boardSize - config.soupSize) / 2;
+
+    SoupCensusResult result;
+    ShapeTally tally;
+    std::mutex resultMutex;
+
+    WorkStealingPool pool(config.threads);
+    pool.parallelFor(ensembles, [&](std::size_t index) {
+        BoardEnsemble ensemble(config.boardSize, config.boardSize, config.wrapEdges, config.rule);
+        ensemble.setGenerationLimit(config.generationLimit);
+        ensemble.setRecordFinalCells(true);
+
+        const std::uint64_t first = index * perEnsemble;
+        const std::uint64_t last = std::min(config.soups, first + perEnsemble);
+        for (std::uint64_t soup = first; soup < last; ++soup) {
+            auto cells = makeSoup(config.soupSize, config.soupSize, config.density,
+                                  config.seed + static_cast<std::uint32_t>(soup));
+            for (auto& pos : cells) {
+                pos = Position(pos.x + offset, pos.y + offset);
+            }
+            ensemble.addBoard(cells);
+        }
+        // Every board ends by the limit
+        ensemble.step(config.generationLimit);
+
+        std::vector<BoardResult> boards;
+        ensemble.collectResults(boards);
+        SoupCensusResult counts;
+        ShapeTally shapes;
+        for (const auto& board : boards) {
+            ++counts.soups;
+            counts.boardGenerations += board.generations;
+            switch (board.outcome) {
+                case BoardOutcome::DiedOut: ++counts.diedOut; break;
+                case BoardOutcome::GenerationLimit: ++counts.unsettled; break;
+                default: ++counts.settled; break;
+            }
+            for (const auto& object : splitObjects(board.cells, config.boardSize, config.boardSize, config.wrapEdges, config.rule)) {
+                ++shapes[canonicalObjectCells(object)];
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(resultMutex);
+        result.soups += counts.soups;
+        result.diedOut += counts.diedOut;
+        result.settled += counts.settled;
+        result.unsettled += counts.unsettled;
+        result.boardGenerations += counts.boardGenerations;
+        mergeTally(tally, shapes);
+    });
+
+    // Phases of one known object are tallied together
+    std::unordered_map<std::vector<Position>, CensusObject, ObjectShapeHash> objects;
+    for (const auto& [shape, count] : tally) {
+        const KnownObject* known = catalog.find(shape);
+        auto& object = objects[known ? known->cells : shape];
+        if (object.count == 0) {
+            object.cells = known ? known->cells : shape;
+            object.name = known ? known->name : std::string();
+        }
+        object.count += count;
+    }
+    result.objects.reserve(objects.size());
+    for (auto& [shape, object] : objects) {
+        result.objects.push_back(std::move(object));
+    }
+    std::sort(result.objects.begin(), result.objects.end(), [](const CensusObject& a, const CensusObject& b) {
+        if (a.count != b.count) {
+            return a.count > b.count;
+        }
+        if (a.name.empty() != b.name.empty()) {
+            return b.name.empty();
+        }
+        return a.name != b.name ? a.name < b.name : a.cells < b.cells;
+    });
+    result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return result;
+}
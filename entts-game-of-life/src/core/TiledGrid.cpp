@@ -0,0 +1,408 @@
+#include "core/TiledGrid.h"
+#include "core/Topology.h"
+#include "core/Trace.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+TiledGrid::TiledGrid(std::int32_t width, std::int32_t height, bool wrapEdges, std::uint32_t threads,
+                     const LifeRule& rule, WorkerPlacement placement)
+    : width_(width)
+    , height_(height)
+    , wrapEdges_(wrapEdges)
+    , tilesX_((width + kTileSize - 1) / kTileSize)
+    , tilesY_((height + kTileSize - 1) / kTileSize)
+    , lastWordMask_((width & 63) != 0 ? ~std::uint64_t{0} >> (64 - (width & 63)) : ~std::uint64_t{0})
+    , kernel_(selectDenseKernel())
+    , rule_(rule)
+    , conwayRule_(rule == kConwayRule)
+    , pool_(threads, std::move(placement)) {
+
+    std::size_t tiles = static_cast<std::size_t>(tilesX_) * static_cast<std::size_t>(tilesY_);
+    placeTiles(cells_);
+    placeTiles(next_);
+    changed_.assign(tiles, 0);
+    tileCounts_.assign(tiles, 0);
+}
+
+void TiledGrid::setCell(std::int32_t x, std::int32_t y, bool alive) {
+    std::uint64_t& word = cells_[tileIndex(x / kTileSize, y / kTileSize)][static_cast<std::size_t>(y % kTileSize)];
+    std::uint64_t mask = std::uint64_t{1} << (x % kTileSize);
+    bool wasAlive = (word & mask) != 0;
+
+    if (alive && !wasAlive) {
+        word |= mask;
+        ++population_;
+    } else if (!alive && wasAlive) {
+        word &= ~mask;
+        --population_;
+    }
+}
+
+bool TiledGrid::getCell(std::int32_t x, std::int32_t y) const {
+    return (cells_[tileIndex(x / kTileSize, y / kTileSize)][static_cast<std::size_t>(y % kTileSize)] >>
+            (x % kTileSize)) & 1u;
+}
+
+void TiledGrid::copyRows(std::int32_t y, std::int32_t rows, std::vector<std::uint64_t>& out) const {
+    out.reserve(out.size() + static_cast<std::size_t>(rows) * static_cast<std::size_t>(tilesX_));
+    for (std::int32_t row = y; row < y + rows; ++row) {
+        for (std::int32_t word = 0; word < tilesX_; ++word) {
+            out.push_back(cells_[tileIndex(word, row / kTileSize)][static_cast<std::size_t>(row % kTileSize)]);
+        }
+    }
+}
+
+void TiledGrid::setRows(std::int32_t y, std::int32_t rows, std::span<const std::uint64_t> words) {
+    std::size_t next = 0;
+    for (std::int32_t row = y; row < y + rows; ++row) {
+        for (std::int32_t word = 0; word < tilesX_; ++word) {
+            std::uint64_t& cell = cells_[tileIndex(word, row / kTileSize)][static_cast<std::size_t>(row % kTileSize)];
+            const std::uint64_t value = words[next++] & (word == tilesX_ - 1 ? lastWordMask_ : ~std::uint64_t{0});
+            population_ = population_ - static_cast<std::size_t>(std::popcount(cell)) +
+                          static_cast<std::size_t>(std::popcount(value));
+            cell = value;
+        }
+    }
+}
+
+std::uint8_t TiledGrid::countNeighbors(std::int32_t x, std::int32_t y) const {
+    std::uint8_t count = 0;
+
+    for (std::int32_t dy = -1; dy <= 1; ++dy) {
+        for (std::int32_t dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) {
+                continue;
+            }
+
+            std::int32_t neighborX = x + dx;
+            std::int32_t neighborY = y + dy;
+
+            if (wrapEdges_) {
+                neighborX = ((neighborX % width_) + width_) % width_;
+                neighborY = ((neighborY % height_) + height_) % height_;
+            } else if (neighborX < 0 || neighborX >= width_ || neighborY < 0 || neighborY >= height_) {
+                continue;
+            }
+
+            if (getCell(neighborX, neighborY)) {
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+bool TiledGrid::step() {
+    GOL_TRACE_SCOPE("TiledGrid::step");
+    pool_.parallelFor(cells_.size(), [this](std::size_t index) { stepTile(index); });
+
+    // Halo words beyond the first and last column read as zero; redo those with wrapping
+    if (wrapEdges_) {
+        patchWrappedColumn(0);
+        if (width_ > 1) {
+            patchWrappedColumn(width_ - 1);
+        }
+    }
+
+    return collectStepResult();
+}
+
+bool TiledGrid::step(std::uint32_t generations) {
+    GOL_TRACE_SCOPE("TiledGrid::stepGenerations");
+    if (generations <= 1) {
+        return generations == 1 && step();
+    }
+
+    // Blocking needs whole words across a wrapped edge; other wrapped widths
+    // rely on the bit-by-bit column patch of step()
+    const bool blocked = !wrapEdges_ || width_ % kTileSize == 0;
+    const bool severalPasses = !blocked || generations > static_cast<std::uint32_t>(kBlockGenerations);
+    if (severalPasses) {
+        if (passStart_.size() != cells_.size()) {
+            placeTiles(passStart_);
+        }
+        std::copy(cells_.begin(), cells_.end(), passStart_.begin());
+    }
+
+    bool changed = false;
+    for (std::uint32_t done = 0; done < generations;) {
+        if (!blocked) {
+            step();
+            ++done;
+            continue;
+        }
+        const auto pass = static_cast<std::int32_t>(
+            std::min(generations - done, static_cast<std::uint32_t>(kBlockGenerations)));
+        // A row of tiles goes to the owner of its first tile
+        pool_.parallelFor(
+            static_cast<std::size_t>(tilesY_),
+            [this, pass](std::size_t tileY) { stepTileRow(static_cast<std::int32_t>(tileY), pass); },
+            [this](std::size_t tileY) { return pool_.getOwner(tileY * static_cast<std::size_t>(tilesX_), cells_.size()); });
+        changed = collectStepResult();
+        done += static_cast<std::uint32_t>(pass);
+    }
+    if (!severalPasses) {
+        return changed;
+    }
+
+    // The spare buffer goes back to the board before the first pass, so the
+    // changes span every generation
+    next_.swap(passStart_);
+    changed = false;
+    for (std::size_t index = 0; index < cells_.size(); ++index) {
+        changed_[index] = cells_[index] != next_[index] ? 1 : 0;
+        changed = changed || changed_[index] != 0;
+    }
+    return changed;
+}
+
+void TiledGrid::clear() {
+    std::fill(cells_.begin(), cells_.end(), Tile{});
+    std::fill(changed_.begin(), changed_.end(), std::uint8_t{0});
+    population_ = 0;
+}
+
+std::size_t TiledGrid::getMemoryUsage() const {
+    return (cells_.capacity() + next_.capacity() + passStart_.capacity()) * sizeof(Tile) + changed_.capacity() +
+           tileCounts_.capacity() * sizeof(std::size_t);
+}
+
+void TiledGrid::collectLivingCells(std::vector<Position>& out) const {
+    for (std::int32_t y = 0; y < height_; ++y) {
+        for (std::int32_t word = 0; word < tilesX_; ++word) {
+            std::uint64_t bits = haloWord(word, y);
+            while (bits != 0) {
+                auto bit = static_cast<std::int32_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                out.emplace_back(word * kTileSize + bit, y);
+            }
+        }
+    }
+}
+
+void TiledGrid::collectChanges(std::vector<Position>& born, std::vector<Position>& died) const {
+    // Every tile is stepped, so the spare buffer holds the previous generation;
+    // only tiles flagged as changed can differ from it
+    for (std::size_t index = 0; index < cells_.size(); ++index) {
+        if (changed_[index] == 0) {
+            continue;
+        }
+
+        const auto tileX = static_cast<std::int32_t>(index % static_cast<std::size_t>(tilesX_));
+        const auto firstRow = static_cast<std::int32_t>(index / static_cast<std::size_t>(tilesX_)) * kTileSize;
+        for (std::int32_t r = 0; r < kTileSize; ++r) {
+            const std::uint64_t current = cells_[index][static_cast<std::size_t>(r)];
+            std::uint64_t bits = current ^ next_[index][static_cast<std::size_t>(r)];
+            while (bits != 0) {
+                auto bit = static_cast<std::int32_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                auto& out = ((current >> bit) & 1u) != 0 ? born : died;
+                out.emplace_back(tileX * kTileSize + bit, firstRow + r);
+            }
+        }
+    }
+}
+
+std::uint64_t TiledGrid::haloWord(std::int32_t word, std::int32_t y) const {
+    if (y < 0 || y >= height_) {
+        if (!wrapEdges_) {
+            return 0;
+        }
+        y = ((y % height_) + height_) % height_;
+    }
+    if (word < 0 || word >= tilesX_) {
+        return 0;
+    }
+
+    return cells_[tileIndex(word, y / kTileSize)][static_cast<std::size_t>(y % kTileSize)];
+}
+
+void TiledGrid::stepTile(std::size_t index) {
+    GOL_TRACE_SCOPE("TiledGrid::stepTile");
+    const auto tileX = static_cast<std::int32_t>(index % static_cast<std::size_t>(tilesX_));
+    const auto firstRow = static_cast<std::int32_t>(index / static_cast<std::size_t>(tilesX_)) * kTileSize;
+
+    // Halo exchange: this tile's rows plus one row above and below, each with
+    // the bordering words of the left and right neighbors as kernel guard words.
+    // Rows past the bottom of the grid wrap like any other neighbor row.
+    std::uint64_t halo[kTileSize + 2][3];
+    for (std::int32_t r = -1; r <= kTileSize; ++r) {
+        auto& haloRow = halo[r + 1];
+        haloRow[0] = haloWord(tileX - 1, firstRow + r);
+        haloRow[1] = haloWord(tileX, firstRow + r);
+        haloRow[2] = haloWord(tileX + 1, firstRow + r);
+    }
+
+    const std::uint64_t mask = tileX == tilesX_ - 1 ? lastWordMask_ : ~std::uint64_t{0};
+    Tile& out = next_[index];
+    std::size_t count = 0;
+
+    for (std::int32_t r = 0; r < kTileSize; ++r) {
+        if (firstRow + r >= height_) {
+            out[static_cast<std::size_t>(r)] = 0; // Padding rows of the last tile row
+            continue;
+        }
+        std::uint64_t& word = out[static_cast<std::size_t>(r)];
+        if (conwayRule_) {
+            kernel_.stepRow(&halo[r][1], &halo[r + 1][1], &halo[r + 2][1], &word, 1);
+        } else {
+            kernel_.stepRowRule(&halo[r][1], &halo[r + 1][1], &halo[r + 2][1], &word, 1, rule_);
+        }
+        word &= mask;
+        count += static_cast<std::size_t>(std::popcount(word));
+    }
+
+    changed_[index] = out != cells_[index] ? 1 : 0;
+    tileCounts_[index] = count;
+}
+
+void TiledGrid::stepTileRow(std::int32_t tileY, std::int32_t generations) {
+    GOL_TRACE_SCOPE("TiledGrid::stepTileRow");
+    const std::int32_t firstRow = tileY * kTileSize;
+    const std::int32_t rows = kTileSize + 2 * generations;
+    const auto words = static_cast<std::size_t>(tilesX_);
+    const std::size_t stride = words + 2; // A guard word on either side
+
+    // Per worker thread, so a warmed-up pass allocates nothing. Two
+    // generations of a 4096-cell-wide row of tiles take about 80 KB.
+    thread_local std::vector<std::uint64_t> buffers;
+    buffers.resize(2 * static_cast<std::size_t>(rows) * stride);
+    std::uint64_t* current = buffers.data();
+    std::uint64_t* next = current + static_cast<std::size_t>(rows) * stride;
+
+    // Row i of the buffer is board row firstRow - generations + i; rows
+    // outside the grid wrap or stay dead like every other halo row
+    auto rowAt = [&](std::uint64_t* buffer, std::int32_t i) { return buffer + static_cast<std::size_t>(i) * stride; };
+    auto outside = [&](std::int32_t i) {
+        const std::int32_t y = firstRow - generations + i;
+        return !wrapEdges_ && (y < 0 || y >= height_);
+    };
+    auto setGuards = [&](std::uint64_t* row) {
+        // Wrapped grids are a whole number of words wide here
+        row[0] = wrapEdges_ ? row[words] : 0;
+        row[words + 1] = wrapEdges_ ? row[1] : 0;
+    };
+
+    for (std::int32_t i = 0; i < rows; ++i) {
+        std::uint64_t* row = rowAt(current, i);
+        for (std::size_t word = 0; word < words; ++word) {
+            row[word + 1] = haloWord(static_cast<std::int32_t>(word), firstRow - generations + i);
+        }
+        setGuards(row);
+    }
+
+    // Generation g is exact on rows [g, rows - g)
+    for (std::int32_t g = 1; g <= generations; ++g) {
+        for (std::int32_t i = g; i < rows - g; ++i) {
+            std::uint64_t* out = rowAt(next, i);
+            if (outside(i)) {
+                std::fill(out, out + stride, std::uint64_t{0});
+                continue;
+            }
+            const std::uint64_t* above = rowAt(current, i - 1) + 1;
+            const std::uint64_t* row = rowAt(current, i) + 1;
+            const std::uint64_t* below = rowAt(current, i + 1) + 1;
+            if (conwayRule_) {
+                kernel_.stepRow(above, row, below, out + 1, words);
+            } else {
+                kernel_.stepRowRule(above, row, below, out + 1, words, rule_);
+            }
+            out[words] &= lastWordMask_;
+            setGuards(out);
+        }
+        std::swap(current, next);
+    }
+
+    for (std::int32_t tileX = 0; tileX < tilesX_; ++tileX) {
+        const std::size_t index = tileIndex(tileX, tileY);
+        Tile& out = next_[index];
+        std::size_t count = 0;
+        for (std::int32_t r = 0; r < kTileSize; ++r) {
+            // Padding rows of the last tile row stay empty
+            const std::uint64_t word =
+                firstRow + r < height_ ? rowAt(current, generations + r)[static_cast<std::size_t>(tileX) + 1] : 0;
+            out[static_cast<std::size_t>(r)] = word;
+            count += static_cast<std::size_t>(std::popcount(word));
+        }
+        changed_[index] = out != cells_[index] ? 1 : 0;
+        tileCounts_[index] = count;
+    }
+}
+
+bool TiledGrid::collectStepResult() {
+    cells_.swap(next_);
+
+    bool changed = false;
+    std::size_t count = 0;
+    for (std::size_t index = 0; index < cells_.size(); ++index) {
+        changed = changed || changed_[index] != 0;
+        count += tileCounts_[index];
+    }
+    population_ = count;
+    return changed;
+}
+
+void TiledGrid::patchWrappedColumn(std::int32_t x) {
+    const TorusTopology torus{width_, height_};
+    const std::uint64_t mask = std::uint64_t{1} << (x % kTileSize);
+    const std::int32_t tileX = x / kTileSize;
+
+    for (std::int32_t y = 0; y < height_; ++y) {
+        std::uint32_t neighbors = 0;
+        forEachNeighbor(torus, Position(x, y), [&](Position n) { neighbors += getCell(n.x, n.y) ? 1u : 0u; });
+        std::size_t index = tileIndex(tileX, y / kTileSize);
+        std::uint64_t& word = next_[index][static_cast<std::size_t>(y % kTileSize)];
+        bool wasAlive = (word & mask) != 0;
+        bool nowAlive = rule_.nextState(getCell(x, y), neighbors);
+
+        if (nowAlive != wasAlive) {
+            word ^= mask;
+            tileCounts_[index] = nowAlive ? tileCounts_[index] + 1 : tileCounts_[index] - 1;
+        }
+    }
+
+    for (std::int32_t tileY = 0; tileY < tilesY_; ++tileY) {
+        std::size_t index = tileIndex(tileX, tileY);
+        changed_[index] = next_[index] != cells_[index] ? 1 : 0;
+    }
+}
+
+void TiledGrid::placeTiles(TileBuffer& tiles) {
+    const std::size_t count = static_cast<std::size_t>(tilesX_) * static_cast<std::size_t>(tilesY_);
+    tiles.resize(count); // Default-initialized, so no page is touched yet
+
+    // Tiles [firstTile(w), firstTile(w + 1)) are worker w's, the ones
+    // parallelFor() deals it, and each node's workers own one run of them.
+    // A page straddling two nodes' runs goes to the later node.
+    const std::uint32_t threads = pool_.getThreadCount();
+    auto firstTile = [&](std::size_t worker) { return (worker * count + threads - 1) / threads; };
+    const NumaTopology& topology = pool_.getTopology();
+    const std::size_t page = getMemoryPageSize();
+    auto* base = reinterpret_cast<std::byte*>(tiles.data());
+    if (topology.getNodeCount() > 1 && reinterpret_cast<std::uintptr_t>(base) % page == 0) {
+        std::size_t runStart = 0;
+        for (std::uint32_t worker = 1; worker <= threads; ++worker) {
+            const std::uint32_t node = pool_.getWorkerNode(worker - 1);
+            if (worker < threads && pool_.getWorkerNode(worker) == node) {
+                continue;
+            }
+            const std::size_t runEnd = firstTile(worker);
+            const std::size_t begin = runStart * sizeof(Tile) / page * page;
+            const std::size_t end = runEnd * sizeof(Tile) / page * page;
+            if (end > begin) {
+                placeMemoryOnNode(base + begin, end - begin, topology.getNode(node).id);
+            }
+            runStart = runEnd;
+        }
+    }
+
+    // First touch by the owner puts the pages on its node even where they
+    // could not be placed above
+    pool_.forEachWorker([&](std::size_t worker) {
+        std::fill(tiles.begin() + static_cast<std::ptrdiff_t>(firstTile(worker)),
+                  tiles.begin() + static_cast<std::ptrdiff_t>(firstTile(worker + 1)), Tile{});
+    });
+}
@@ -0,0 +1,219 @@
+#include "core/Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// One spare slot, since a dump skips the one a write may be in the middle of
+constexpr std::size_t kSlots = Trace::kEventsPerThread + 1;
+
+// Slots are atomics so a dump may read a buffer its thread is still writing
+struct Slot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<std::uint64_t> start{0};
+    std::atomic<std::uint64_t> duration{0};
+};
+
+// Written only by its thread; spans [floor, head) are kept, at most the last
+// kEventsPerThread of them
+struct ThreadBuffer {
+    explicit ThreadBuffer(std::uint32_t id) : id(id), slots(new Slot[kSlots]) {}
+
+    const std::uint32_t id;
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<std::uint64_t> head{0};
+    std::atomic<std::uint64_t> floor{0};
+    std::atomic<bool> exited{false};
+    std::string name; // Guarded by Registry::mutex
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::uint32_t nextId{1};
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+std::atomic<bool> enabled{false};
+
+// Keeps the buffer in the registry once its thread exits, so the thread's
+// spans still show up in dumps until the next clear()
+struct ThreadBufferHandle {
+    ThreadBufferHandle() {
+        auto& reg = registry();
+        std::scoped_lock lock(reg.mutex);
+        buffer = std::make_shared<ThreadBuffer>(reg.nextId++);
+        reg.buffers.push_back(buffer);
+    }
+    ~ThreadBufferHandle() { buffer->exited.store(true, std::memory_order_relaxed); }
+
+    std::shared_ptr<ThreadBuffer> buffer;
+};
+
+ThreadBuffer& threadBuffer() {
+    thread_local ThreadBufferHandle handle;
+    return *handle.buffer;
+}
+
+struct Span {
+    const char* name;
+    std::uint64_t start;
+    std::uint64_t duration;
+};
+
+// Copies the buffer's kept spans, dropping any its thread overwrote meanwhile
+std::vector<Span> readSpans(const ThreadBuffer& buffer) {
+    const std::uint64_t head = buffer.head.load(std::memory_order_acquire);
+    const std::uint64_t oldest = head > Trace::kEventsPerThread ? head - Trace::kEventsPerThread : 0;
+    const std::uint64_t first = std::max(buffer.floor.load(std::memory_order_relaxed), oldest);
+
+    std::vector<Span> spans;
+    spans.reserve(static_cast<std::size_t>(head - first));
+    for (std::uint64_t i = first; i < head; ++i) {
+        const Slot& slot = buffer.slots[i % kSlots];
+        spans.push_back({slot.name.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed),
+                         slot.duration.load(std::memory_order_relaxed)});
+    }
+
+    // A write in progress may be touching the slot of index newHead - kSlots
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const std::uint64_t newHead = buffer.head.load(std::memory_order_relaxed);
+    if (newHead + 1 > first + kSlots) {
+        const auto stale =
+            static_cast<std::size_t>(std::min<std::uint64_t>(newHead + 1 - kSlots - first, spans.size()));
+        spans.erase(spans.begin(), spans.begin() + static_cast<std::ptrdiff_t>(stale));
+    }
+    return spans;
+}
+
+void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(*c)));
+            out << escaped;
+        } else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+// Chrome trace timestamps are microseconds; keep nanosecond precision
+void writeMicros(std::ostream& out, std::uint64_t nanos) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03u", static_cast<unsigned long long>(nanos / 1000),
+                  static_cast<unsigned>(nanos % 1000));
+    out << text;
+}
+
+} // namespace
+
+void Trace::setEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool Trace::isEnabled() noexcept {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Trace::now() noexcept {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Trace::record(const char* name, std::uint64_t startNs, std::uint64_t endNs) noexcept {
+    ThreadBuffer* buffer;
+    try {
+        buffer = &threadBuffer();
+    } catch (...) {
+        return; // No buffer for this thread; the span is lost
+    }
+    const std::uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    Slot& slot = buffer->slots[head % kSlots];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(startNs, std::memory_order_relaxed);
+    slot.duration.store(endNs - startNs, std::memory_order_relaxed);
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Trace::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::scoped_lock lock(registry().mutex);
+    buffer.name = name;
+}
+
+void Trace::clear() {
+    auto& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    std::erase_if(reg.buffers, [](const auto& buffer) { return buffer->exited.load(std::memory_order_relaxed); });
+    for (auto& buffer : reg.buffers) {
+        buffer->floor.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+void Trace::writeChromeTrace(std::ostream& out) {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::vector<std::string> names;
+    {
+        auto& reg = registry();
+        std::scoped_lock lock(reg.mutex);
+        buffers = reg.buffers;
+        for (const auto& buffer : buffers) {
+            names.push_back(buffer->name.empty() ? "thread " + std::to_string(buffer->id) : buffer->name);
+        }
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separate = [&] {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+    for (std::size_t b = 0; b < buffers.size(); ++b) {
+        const auto& buffer = *buffers[b];
+        separate();
+        out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer.id << ",\"args\":{\"name\":";
+        writeJsonString(out, names[b].c_str());
+        out << "}}";
+
+        for (const Span& span : readSpans(buffer)) {
+            separate();
+            out << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.id << ",\"name\":";
+            writeJsonString(out, span.name);
+            out << ",\"ts\":";
+            writeMicros(out, span.start);
+            out << ",\"dur\":";
+            writeMicros(out, span.duration);
+            out << "}";
+        }
+    }
+    out << "\n]}\n";
+}
+
+void Trace::writeChromeTrace(const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Cannot open trace file: " + path);
+    }
+    writeChromeTrace(out);
+    if (!out) {
+        throw std::runtime_error("Failed writing trace file: " + path);
+    }
+}
@@ -0,0 +1,131 @@
+#include "server/GrpcHaloTransport.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+class GrpcHaloTransport::Service final : public game_of_life::HaloExchangeService::Service {
+public:
+    explicit Service(GrpcHaloTransport& owner) : owner_(owner) {}
+
+    grpc::Status SendHalo(grpc::ServerContext*, const game_of_life::HaloRows* request,
+                          game_of_life::HaloAck*) override {
+        if (request->from_rank() >= owner_.getRankCount()) {
+            return {grpc::StatusCode::INVALID_ARGUMENT, "Unknown rank"};
+        }
+        owner_.mailbox_.deliver({request->round(), request->from_rank(), request->downward(),
+                                 std::vector<std::uint64_t>(request->words().begin(), request->words().end())});
+        return grpc::Status::OK;
+    }
+
+    // Holds a server thread until the round completes
+    grpc::Status Reduce(grpc::ServerContext*, const game_of_life::ReductionContribution* request,
+                        game_of_life::ReductionTotal* response) override {
+        if (owner_.rank_ != 0) {
+            return {grpc::StatusCode::FAILED_PRECONDITION, "Reductions are served by rank 0"};
+        }
+        try {
+            const auto total = owner_.barrier_.contribute(request->round(), {request->living_cells(), request->changed()});
+            response->set_living_cells(total.livingCells);
+            response->set_changed(total.changed);
+        } catch (const std::runtime_error& e) {
+            return {grpc::StatusCode::DEADLINE_EXCEEDED, e.what()};
+        }
+        return grpc::Status::OK;
+    }
+
+private:
+    GrpcHaloTransport& owner_;
+};
+
+GrpcHaloTransport::GrpcHaloTransport(std::uint32_t rank, std::vector<std::string> peers,
+                                     std::chrono::milliseconds timeout, const std::string& listenAddress)
+    : rank_(rank)
+    , peers_(std::move(peers))
+    , timeout_(timeout)
+    , mailbox_(timeout)
+    , barrier_(static_cast<std::uint32_t>(std::max<std::size_t>(peers_.size(), 1)), timeout)
+    , service_(std::make_unique<Service>(*this))
+    , stubs_(peers_.size()) {
+    if (rank_ >= peers_.size()) {
+        throw std::invalid_argument("Rank " + std::to_string(rank_) + " is not among the peers");
+    }
+
+    // A wide board's halo outgrows the default 4 MB message limit
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(listenAddress.empty() ? peers_[rank_] : listenAddress, grpc::InsecureServerCredentials());
+    builder.SetMaxReceiveMessageSize(std::numeric_limits<int>::max());
+    builder.RegisterService(service_.get());
+    server_ = builder.BuildAndStart();
+    if (!server_) {
+        throw std::runtime_error("Could not start halo exchange on " + peers_[rank_]);
+    }
+}
+
+GrpcHaloTransport::~GrpcHaloTransport() {
+    // Waits for the calls in flight, so rank 0 answers the last reduction
+    server_->Shutdown();
+}
+
+game_of_life::HaloExchangeService::Stub& GrpcHaloTransport::getStub(std::uint32_t rank) {
+    if (rank >= stubs_.size()) {
+        throw std::invalid_argument("Rank " + std::to_string(rank) + " is not among the peers");
+    }
+    auto& stub = stubs_[rank];
+    if (!stub) {
+        grpc::ChannelArguments arguments;
+        arguments.SetMaxSendMessageSize(std::numeric_limits<int>::max());
+        arguments.SetMaxReceiveMessageSize(std::numeric_limits<int>::max());
+        stub = game_of_life::HaloExchangeService::NewStub(
+            grpc::CreateCustomChannel(peers_[rank], grpc::InsecureChannelCredentials(), arguments));
+    }
+    return *stub;
+}
+
+void GrpcHaloTransport::setDeadline(grpc::ClientContext& context) const {
+    // Peers start in any order; wait for them rather than failing fast
+    context.set_wait_for_ready(true);
+    if (timeout_.count() > 0) {
+        context.set_deadline(std::chrono::system_clock::now() + timeout_);
+    }
+}
+
+void GrpcHaloTransport::send(std::uint32_t rank, HaloMessage message) {
+    game_of_life::HaloRows request;
+    request.set_round(message.round);
+    request.set_from_rank(message.fromRank);
+    request.set_downward(message.downward);
+    request.mutable_words()->Add(message.words.begin(), message.words.end());
+
+    grpc::ClientContext context;
+    setDeadline(context);
+    game_of_life::HaloAck response;
+    const auto status = getStub(rank).SendHalo(&context, request, &response);
+    if (!status.ok()) {
+        throw std::runtime_error("Halo to rank " + std::to_string(rank) + " failed: " + status.error_message());
+    }
+}
+
+HaloMessage GrpcHaloTransport::receive(std::uint32_t fromRank, bool downward, std::uint64_t round) {
+    return mailbox_.receive(fromRank, downward, round);
+}
+
+HaloReduction GrpcHaloTransport::allReduce(std::uint64_t round, const HaloReduction& local) {
+    if (rank_ == 0) {
+        return barrier_.contribute(round, local);
+    }
+
+    game_of_life::ReductionContribution request;
+    request.set_round(round);
+    request.set_rank(rank_);
+    request.set_living_cells(local.livingCells);
+    request.set_changed(local.changed);
+
+    grpc::ClientContext context;
+    setDeadline(context);
+    game_of_life::ReductionTotal response;
+    const auto status = getStub(0).Reduce(&context, request, &response);
+    if (!status.ok()) {
+        throw std::runtime_error("Reduction on rank 0 failed: " + status.error_message());
+    }
+    return {response.living_cells(), response.changed()};
+}
@@ -0,0 +1,143 @@
+#include "server/GrpcHaloTransport.h"
+#include "core/GameConfig.h"
+#include "core/PartitionedBoard.h"
+#include "core/PatternReader.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// One rank of a board too large for one host: start a node per rank, each
+// with the same config, pattern and peer list
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program
+              << " --rank r --peers host:port,host:port,... [--listen host:port] [--config file]"
+                 " [--pattern file] [--generations n] [--halo k] [--timeout-ms ms]\n"
+              << "  --peers lists every rank's address in rank order; the grid in --config is the whole board\n"
+              << "  --pattern is an RLE (.rle) or macrocell (.mc) file; each node keeps its own slab's cells\n"
+              << "  --halo swaps k rows with each neighbor every k generations (default 1)\n";
+}
+
+std::vector<std::string> splitPeers(const std::string& list) {
+    std::vector<std::string> peers;
+    std::stringstream stream(list);
+    std::string peer;
+    while (std::getline(stream, peer, ',')) {
+        if (!peer.empty()) {
+            peers.push_back(peer);
+        }
+    }
+    return peers;
+}
+
+void loadPattern(const std::string& patternFile, PartitionedBoard& board) {
+    const PatternFormat format = patternFormatFromPath(patternFile);
+    if (format == PatternFormat::Json) {
+        throw std::runtime_error("Nodes read RLE (.rle) or macrocell (.mc) patterns: " + patternFile);
+    }
+    std::ifstream file(patternFile, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open pattern file: " + patternFile);
+    }
+
+    // Runs outside this slab are dropped as they are read
+    auto addRun = [&board](std::int32_t x, std::int32_t y, std::uint32_t length) {
+        for (std::uint32_t i = 0; i < length; ++i) {
+            board.setCellAlive(x + static_cast<std::int32_t>(i), y);
+        }
+    };
+    if (format == PatternFormat::Rle) {
+        readRlePattern(file, addRun, board.getConfig().getRule());
+    } else {
+        readMacrocellPattern(file, addRun, board.getConfig().getRule());
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        std::int64_t rank = -1;
+        std::vector<std::string> peers;
+        std::string listenAddress;
+        std::string configFile = "config/default.json";
+        std::string patternFile;
+        std::uint64_t generations = 100;
+        std::int32_t haloDepth = 1;
+        auto timeout = GrpcHaloTransport::kDefaultTimeout;
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            }
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            if (arg == "--rank") {
+                rank = std::stoll(argv[++i]);
+            } else if (arg == "--peers") {
+                peers = splitPeers(argv[++i]);
+            } else if (arg == "--listen") {
+                listenAddress = argv[++i];
+            } else if (arg == "--config") {
+                configFile = argv[++i];
+            } else if (arg == "--pattern") {
+                patternFile = argv[++i];
+            } else if (arg == "--generations") {
+                generations = std::stoull(argv[++i]);
+            } else if (arg == "--halo") {
+                haloDepth = std::stoi(argv[++i]);
+            } else if (arg == "--timeout-ms") {
+                timeout = std::chrono::milliseconds{std::stoll(argv[++i])};
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        if (rank < 0 || peers.empty()) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        GameConfig config;
+        try {
+            config.loadFromFile(configFile);
+        } catch (const std::exception& e) {
+            std::cout << "Could not load config file, using defaults: " << e.what() << "\n";
+        }
+
+        GrpcHaloTransport transport(static_cast<std::uint32_t>(rank), peers, timeout, listenAddress);
+        PartitionedBoard board(config, transport, haloDepth);
+        if (!patternFile.empty()) {
+            loadPattern(patternFile, board);
+        }
+        const auto slab = board.getSlab();
+        std::cout << "Rank " << rank << " of " << peers.size() << ": rows " << slab.firstRow << "-"
+                  << slab.firstRow + slab.rows - 1 << " of " << config.getGridWidth() << "x"
+                  << config.getGridHeight() << ", " << board.getSlabLivingCellCount() << " cells, "
+                  << board.getMemoryUsage() / 1024 << " KB\n";
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto result = board.advance(generations);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (rank == 0) {
+            std::cout << "Generations: " << result.generations << (result.changed ? "" : " (settled)") << "\n"
+                      << "Living cells: " << result.livingCells << "\n"
+                      << "Elapsed: " << seconds << " s ("
+                      << (seconds > 0.0 ? static_cast<double>(result.generations) / seconds : 0.0) << " gen/s)\n";
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+}
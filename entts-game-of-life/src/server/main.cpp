@@ -0,0 +1,149 @@
+#include "server/GameOfLifeServer.h"
+#include "core/GameConfig.h"
+#include "core/Metrics.h"
+#include "core/Trace.h"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::chrono::seconds kMetricsInterval{5};
+
+std::atomic<bool> stopRequested{false};
+std::atomic<bool> traceRequested{false};
+
+void requestStop(int) {
+    stopRequested = true;
+}
+
+void requestTrace(int) {
+    traceRequested = true;
+}
+
+void writeTrace(const std::string& traceFile) {
+    try {
+        Trace::writeChromeTrace(traceFile);
+        std::cout << "Wrote trace to " << traceFile << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+    }
+}
+
+// Every live simulation, labelled by its id
+void writeMetrics(std::ostream& out, const SimulationStore& store, bool prometheus) {
+    const auto sessions = store.list();
+    std::vector<LabelledMetrics> simulations;
+    simulations.reserve(sessions.size());
+    for (const auto& session : sessions) {
+        simulations.emplace_back(session->getId(), &session->getMetrics());
+    }
+    if (prometheus) {
+        writePrometheusMetrics(out, simulations);
+    } else {
+        out << metricsToJson(simulations).dump(2) << "\n";
+    }
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program
+              << " [--address host:port] [--config file] [--patterns dir] [--threads n] [--trace file] [--metrics file]\n"
+              << "  --trace writes Chrome trace JSON on SIGUSR1 and at exit (needs -DENABLE_PROFILING=ON)\n"
+              << "  --metrics rewrites Prometheus text (*.prom) or JSON there every few seconds\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        std::string address = GameOfLifeServer::kDefaultAddress;
+        std::string configFile = "config/default.json";
+        std::string patternDirectory = "../patterns";
+        unsigned threads = 0;
+        std::string traceFile;
+        std::string metricsFile;
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            }
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            if (arg == "--address") {
+                address = argv[++i];
+            } else if (arg == "--config") {
+                configFile = argv[++i];
+            } else if (arg == "--patterns") {
+                patternDirectory = argv[++i];
+            } else if (arg == "--threads") {
+                threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            } else if (arg == "--trace") {
+                traceFile = argv[++i];
+            } else if (arg == "--metrics") {
+                metricsFile = argv[++i];
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+
+        // Grid size comes from each CreateSimulation; the rest from the config
+        GameConfig config;
+        try {
+            config.loadFromFile(configFile);
+        } catch (const std::exception& e) {
+            std::cout << "Could not load config file, using defaults: " << e.what() << "\n";
+        }
+
+        if (!traceFile.empty()) {
+#ifndef GOL_PROFILING_ENABLED
+            std::cout << "Tracing is compiled out; rebuild with -DENABLE_PROFILING=ON\n";
+#endif
+            Trace::setEnabled(true);
+        }
+
+        GameOfLifeServer server(config, patternDirectory);
+        server.start(address, threads);
+        std::cout << "Game of Life gRPC server (EnTT) listening on " << address << "\n";
+
+        std::unique_ptr<MetricsFileWriter> metrics;
+        if (!metricsFile.empty()) {
+            const bool prometheus = MetricsFileWriter::isPrometheusPath(metricsFile);
+            metrics = std::make_unique<MetricsFileWriter>(
+                metricsFile, kMetricsInterval,
+                [&server, prometheus](std::ostream& out) { writeMetrics(out, server.getStore(), prometheus); });
+        }
+
+        std::signal(SIGINT, requestStop);
+        std::signal(SIGTERM, requestStop);
+#ifdef SIGUSR1
+        std::signal(SIGUSR1, requestTrace);
+#endif
+        while (!stopRequested) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            if (traceRequested.exchange(false) && !traceFile.empty()) {
+                writeTrace(traceFile);
+            }
+        }
+
+        std::cout << "Shutting down\n";
+        server.shutdown();
+        metrics.reset();
+        if (!traceFile.empty()) {
+            writeTrace(traceFile);
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/GameOfLifeSimulation.h"
+#include "core/GameConfig.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts every operator new in the test binary
+namespace {
+std::atomic<std::uint64_t> allocationCount{0};
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size != 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+// Two engines are left out. Sparse births away from recent deaths create
+// registry entities, whose storage EnTT manages (oscillators are covered
+// below); HashLife nodes are its memo and grow with every new pattern state
+// by design.
+TEST_CASE("Steps allocate nothing after warm-up", "[Allocations]") {
+    for (StorageEngine engine : {StorageEngine::Dense, StorageEngine::Tiled, StorageEngine::Packed}) {
+        INFO("engine " << static_cast<int>(engine));
+        GameConfig config;
+        config.setGridWidth(192); // Three tiles across
+        config.setGridHeight(64);
+        config.setWrapEdges(true);
+        config.setStorageEngine(engine);
+        config.setWorkerThreads(2); // Tiled steps go through the worker pool
+        GameOfLifeSimulation simulation(config);
+
+        // A glider keeps births and deaths moving across the grid; the
+        // blinkers, clear of its diagonal, keep a steady churn in one place
+        for (const auto& pos : {Position(1, 0), Position(2, 1), Position(0, 2), Position(1, 2), Position(2, 2)}) {
+            simulation.setCellAlive(pos.x, pos.y);
+        }
+        for (std::int32_t i = 0; i < 4; ++i) {
+            simulation.setCellAlive(30 + 6 * i, 10);
+            simulation.setCellAlive(31 + 6 * i, 10);
+            simulation.setCellAlive(32 + 6 * i, 10);
+        }
+
+        // Long enough for the glider to cross into the next tile
+        for (int i = 0; i < 300; ++i) {
+            simulation.step();
+        }
+
+        auto before = allocationCount.load();
+        for (int i = 0; i < 100; ++i) {
+            simulation.step();
+        }
+        REQUIRE(allocationCount.load() - before == 0);
+        REQUIRE(simulation.getLivingCellCount() == 17);
+    }
+}
+
+TEST_CASE("Sparse oscillators allocate nothing after warm-up", "[Allocations]") {
+    // Their cells die and are born back in place, reviving pooled entities
+    GameOfLifeSimulation simulation;
+    for (std::int32_t i = 0; i < 4; ++i) {
+        simulation.setCellAlive(30 + 6 * i, 10);
+        simulation.setCellAlive(31 + 6 * i, 10);
+        simulation.setCellAlive(32 + 6 * i, 10);
+    }
+    for (int i = 0; i < 2 * GameOfLifeSimulation::kDormantGenerations; ++i) {
+        simulation.step();
+    }
+
+    auto before = allocationCount.load();
+    for (int i = 0; i < 100; ++i) {
+        simulation.step();
+    }
+    REQUIRE(allocationCount.load() - before == 0);
+    REQUIRE(simulation.getLivingCellCount() == 12);
+}
@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/BoardEnsemble.h"
+#include "core/GameOfLifeSimulation.h"
+#include "core/GameConfig.h"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> boardCells(const BoardEnsemble& ensemble, std::uint64_t id) {
+    std::vector<Position> cells;
+    ensemble.collectBoardCells(id, cells);
+    return sorted(cells);
+}
+
+const BoardResult& resultOf(const std::vector<BoardResult>& results, std::uint64_t id) {
+    return *std::find_if(results.begin(), results.end(), [id](const BoardResult& r) { return r.id == id; });
+}
+
+} // namespace
+
+TEST_CASE("Ensemble boards match dense storage", "[BoardEnsemble]") {
+    struct Scenario {
+        std::int32_t width;
+        std::int32_t height;
+        bool wrap;
+        LifeRule rule;
+    };
+
+    // The widest board fills the word up to its last ghost bit
+    const std::vector<Scenario> scenarios{{32, 24, false, kConwayRule}, {32, 24, true, kConwayRule},
+                                          {62, 9, true, kConwayRule},   {7, 40, false, kConwayRule},
+                                          {20, 20, true, kHighLifeRule}};
+
+    for (const auto& scenario : scenarios) {
+        INFO("board " << scenario.width << "x" << scenario.height << " wrap " << scenario.wrap << " rule "
+                      << scenario.rule.toString());
+        BoardEnsemble ensemble(scenario.width, scenario.height, scenario.wrap, scenario.rule);
+
+        GameConfig config;
+        config.setGridWidth(scenario.width);
+        config.setGridHeight(scenario.height);
+        config.setWrapEdges(scenario.wrap);
+        config.setStorageEngine(StorageEngine::Dense);
+        config.setRule(scenario.rule);
+
+        // Enough boards to use every SIMD width and leave a scalar tail
+        std::vector<std::pair<std::uint64_t, std::unique_ptr<GameOfLifeSimulation>>> boards;
+        for (std::uint32_t seed = 0; seed < 37; ++seed) {
+            const auto id = ensemble.addRandomBoard(0.35, seed);
+            auto reference = std::make_unique<GameOfLifeSimulation>(config);
+            for (const auto& pos : boardCells(ensemble, id)) {
+                reference->setCellAlive(pos.x, pos.y);
+            }
+            boards.emplace_back(id, std::move(reference));
+        }
+
+        for (int generation = 0; generation < 60; ++generation) {
+            ensemble.step();
+            for (auto& [id, reference] : boards) {
+                if (!reference) {
+                    continue;
+                }
+                reference->step();
+                if (!ensemble.isRunning(id)) {
+                    reference.reset(); // Ended; its outcome is checked below
+                    continue;
+                }
+                REQUIRE(boardCells(ensemble, id) == sorted(reference->getLivingPositions()));
+            }
+        }
+
+        std::vector<BoardResult> results;
+        ensemble.collectResults(results);
+        REQUIRE(results.size() + ensemble.getRunningCount() == boards.size());
+        for (const auto& result : results) {
+            REQUIRE(result.generations <= 60);
+            REQUIRE((result.outcome == BoardOutcome::DiedOut) == (result.finalCells == 0));
+        }
+    }
+}
+
+TEST_CASE("Ensemble boards end with their outcome", "[BoardEnsemble]") {
+    BoardEnsemble ensemble(16, 16, true);
+    ensemble.setGenerationLimit(10);
+
+    const auto blinker = ensemble.addBoard({{5, 4}, {5, 5}, {5, 6}});
+    const auto block = ensemble.addBoard({{2, 2}, {3, 2}, {2, 3}, {3, 3}});
+    const auto lone = ensemble.addBoard({{8, 8}, {-1, 3}, {16, 0}}); // Two are off the board
+    const auto glider = ensemble.addBoard({{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}});
+    const auto retired = ensemble.addBoard({{0, 0}, {1, 0}, {2, 0}});
+    REQUIRE(ensemble.getRunningCount() == 5);
+
+    SECTION("Each board reports how it ended") {
+        REQUIRE(ensemble.retireBoard(retired));
+        REQUIRE_FALSE(ensemble.retireBoard(retired));
+
+        ensemble.setRecordFinalCells(true);
+        ensemble.step(20);
+        REQUIRE(ensemble.getRunningCount() == 0);
+
+        std::vector<BoardResult> results;
+        ensemble.collectResults(results);
+        REQUIRE(results.size() == 5);
+
+        REQUIRE(resultOf(results, retired).outcome == BoardOutcome::Retired);
+        REQUIRE(resultOf(results, retired).generations == 0);
+
+        REQUIRE(resultOf(results, block).outcome == BoardOutcome::StillLife);
+        REQUIRE(resultOf(results, block).generations == 1);
+        REQUIRE(resultOf(results, block).finalCells == 4);
+        REQUIRE(sorted(resultOf(results, block).cells) == sorted({{2, 2}, {3, 2}, {2, 3}, {3, 3}}));
+        REQUIRE(resultOf(results, retired).cells.empty()); // Retired before recording was turned on
+
+        REQUIRE(resultOf(results, lone).outcome == BoardOutcome::DiedOut);
+        REQUIRE(resultOf(results, lone).initialCells == 1);
+        REQUIRE(resultOf(results, lone).finalCells == 0);
+
+        REQUIRE(resultOf(results, blinker).outcome == BoardOutcome::Oscillator);
+        REQUIRE(resultOf(results, blinker).generations == 2);
+
+        REQUIRE(resultOf(results, glider).outcome == BoardOutcome::GenerationLimit);
+        REQUIRE(resultOf(results, glider).generations == 10);
+        REQUIRE(resultOf(results, glider).finalCells == 5);
+
+        // Results are handed out once
+        results.clear();
+        ensemble.collectResults(results);
+        REQUIRE(results.empty());
+    }
+
+    SECTION("Boards moved into freed lanes keep their cells") {
+        ensemble.setGenerationLimit(0);
+        ensemble.step(3);
+        REQUIRE(ensemble.getRunningCount() == 1);
+        REQUIRE(ensemble.isRunning(glider));
+
+        // A glider moves one cell diagonally every four generations, across the wrapped edges
+        ensemble.step(4 * 16 - 3);
+        REQUIRE(boardCells(ensemble, glider) == sorted({{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}}));
+
+        // Lanes freed by ended boards are reused, and start empty
+        const auto added = ensemble.addBoard({{5, 4}, {5, 5}, {5, 6}});
+        REQUIRE(ensemble.getRunningCount() == 2);
+        ensemble.step();
+        REQUIRE(boardCells(ensemble, added) == sorted({{4, 5}, {5, 5}, {6, 5}}));
+        ensemble.step();
+        REQUIRE_FALSE(ensemble.isRunning(added)); // Period 2 is seen once it has run two generations
+        REQUIRE(ensemble.isRunning(glider));
+    }
+}
+
+TEST_CASE("Ensemble board sizes are checked", "[BoardEnsemble]") {
+    REQUIRE_THROWS_AS(BoardEnsemble(0, 8, false), std::invalid_argument);
+    REQUIRE_THROWS_AS(BoardEnsemble(BoardEnsemble::kMaxWidth + 1, 8, false), std::invalid_argument);
+    REQUIRE_THROWS_AS(BoardEnsemble(8, 0, true), std::invalid_argument);
+    REQUIRE_NOTHROW(BoardEnsemble(BoardEnsemble::kMaxWidth, 1, true));
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/CellEncoding.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+} // namespace
+
+TEST_CASE("Cell flips survive a round trip", "[CellEncoding]") {
+    std::mt19937 rng(26);
+    std::uniform_int_distribution<std::int32_t> coordinate(-300, 300);
+    std::set<Position> unique;
+    while (unique.size() < 2000) {
+        unique.insert(Position(coordinate(rng), coordinate(rng)));
+    }
+    // The far corners of the plane as well
+    unique.insert(Position(std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max()));
+    unique.insert(Position(std::numeric_limits<std::int32_t>::max(), std::numeric_limits<std::int32_t>::min()));
+
+    const std::vector<Position> all(unique.begin(), unique.end());
+    const std::vector<Position> born(all.begin(), all.begin() + 1000);
+    const std::vector<Position> died(all.begin() + 1000, all.end());
+
+    std::string packed;
+    encodeCellFlips(born, died, packed);
+    REQUIRE(sorted(decodeCellFlips(packed)) == all);
+
+    std::string empty;
+    encodeCellFlips({}, {}, empty);
+    REQUIRE(empty.empty());
+    REQUIRE(decodeCellFlips(empty).empty());
+}
+
+TEST_CASE("Cell flips pack dense tiles into a few bytes", "[CellEncoding]") {
+    // A solid 64x64 square is 64 full tiles
+    std::vector<Position> square;
+    for (std::int32_t y = 0; y < 64; ++y) {
+        for (std::int32_t x = 0; x < 64; ++x) {
+            square.emplace_back(x, y);
+        }
+    }
+    std::string packed;
+    encodeCellFlips(square, {}, packed);
+    REQUIRE(packed.size() <= 64 * 11);
+    REQUIRE(sorted(decodeCellFlips(packed)) == sorted(square));
+
+    // A lone cell stays small too
+    std::string single;
+    const std::vector<Position> cell{{-5, 3}};
+    encodeCellFlips(cell, {}, single);
+    REQUIRE(single.size() <= 4);
+    REQUIRE(decodeCellFlips(single) == cell);
+}
+
+TEST_CASE("Cell flips listed twice cancel out", "[CellEncoding]") {
+    const std::vector<Position> born{{1, 1}, {2, 2}, {20, 20}};
+    const std::vector<Position> died{{2, 2}, {20, 20}};
+    std::string packed;
+    encodeCellFlips(born, died, packed);
+    REQUIRE(decodeCellFlips(packed) == std::vector<Position>{{1, 1}});
+
+    // Applied to the previous frame, the flips give the next one
+    std::set<Position> frame{{0, 0}, {5, 5}};
+    const std::vector<Position> next{{0, 0}, {6, 5}};
+    std::string delta;
+    encodeCellFlips(std::vector<Position>{{6, 5}}, std::vector<Position>{{5, 5}}, delta);
+    for (const auto& pos : decodeCellFlips(delta)) {
+        if (!frame.erase(pos)) {
+            frame.insert(pos);
+        }
+    }
+    REQUIRE(std::vector<Position>(frame.begin(), frame.end()) == next);
+}
+
+TEST_CASE("Malformed packed cells are rejected", "[CellEncoding]") {
+    std::string packed;
+    encodeCellFlips(std::vector<Position>{{3, 3}, {4, 12}}, {}, packed);
+
+    REQUIRE_THROWS_AS(decodeCellFlips(std::string_view(packed).substr(0, packed.size() - 1)), std::runtime_error);
+    REQUIRE_THROWS_AS(decodeCellFlips(std::string("\x02\x02\x00", 3)), std::runtime_error);          // Empty tile
+    REQUIRE_THROWS_AS(decodeCellFlips(std::string("\xfe\xff\xff\xff\x0f\x00\x01\x01")), std::runtime_error); // Off the plane
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/CheckpointWriter.h"
+#include "core/SnapshotFile.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<Position> readCells(const std::string& path) {
+    SnapshotReader reader(path);
+    std::vector<Position> cells;
+    reader.readRuns([&cells](std::int32_t x, std::int32_t y, std::uint32_t length) {
+        for (std::uint32_t i = 0; i < length; ++i) {
+            cells.emplace_back(x + static_cast<std::int32_t>(i), y);
+        }
+    });
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+} // namespace
+
+TEST_CASE("Checkpoint writer writes in the background", "[CheckpointWriter]") {
+    const std::string path = tempPath("entt_gol_checkpoint_writer.gols");
+    CheckpointWriter writer;
+
+    // The first job holds the writer thread until released, so the next ones queue up
+    std::atomic<bool> release{false};
+    SnapshotInfo info;
+    info.gridWidth = 32;
+    info.gridHeight = 32;
+    writer.submit(path, info, [&release](std::vector<Position>& out) {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        out.emplace_back(1, 1);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // Taken up by the writer
+
+    for (std::uint64_t generation = 1; generation <= 3; ++generation) {
+        info.generation = generation;
+        writer.submit(path, info, [generation](std::vector<Position>& out) {
+            out.emplace_back(static_cast<std::int32_t>(generation), 2);
+        });
+    }
+    REQUIRE(writer.getStats().written == 0);
+    release = true;
+    writer.waitIdle();
+
+    // Only the newest of the queued three was written after the first
+    auto stats = writer.getStats();
+    REQUIRE(stats.written == 2);
+    REQUIRE(stats.superseded == 2);
+    REQUIRE(stats.failed == 0);
+    REQUIRE(stats.lastGeneration == 3);
+    REQUIRE(SnapshotReader(path).getInfo().generation == 3);
+    REQUIRE(readCells(path) == std::vector<Position>{{3, 2}});
+
+    // Failures are counted and the writer carries on
+    writer.submit(tempPath("entt_gol_missing_dir/board.gols"), info, [](std::vector<Position>&) {});
+    writer.submit(path, info, [](std::vector<Position>& out) { out.emplace_back(0, 0); });
+    writer.waitIdle();
+    stats = writer.getStats();
+    REQUIRE(stats.failed == 1);
+    REQUIRE_FALSE(stats.lastError.empty());
+    REQUIRE(stats.written == 3);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Checkpoint writer drains its queue on destruction", "[CheckpointWriter]") {
+    const std::string path = tempPath("entt_gol_checkpoint_drain.gols");
+    std::filesystem::remove(path);
+    {
+        CheckpointWriter writer;
+        SnapshotInfo info;
+        info.generation = 5;
+        info.gridWidth = 8;
+        info.gridHeight = 8;
+        writer.submit(path, info, [](std::vector<Position>& out) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            out = {{1, 0}, {2, 0}, {3, 0}};
+        });
+    }
+    REQUIRE(SnapshotReader(path).getInfo().generation == 5);
+    REQUIRE(readCells(path) == std::vector<Position>{{1, 0}, {2, 0}, {3, 0}});
+
+    std::filesystem::remove(path);
+}
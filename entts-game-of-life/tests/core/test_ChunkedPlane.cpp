@@ -0,0 +1,168 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/ChunkedPlane.h"
+#include "core/GameConfig.h"
+#include "core/GameOfLifeSimulation.h"
+#include "core/HashLifeUniverse.h"
+#include "core/LifeEngine.h"
+#include <algorithm>
+#include <climits>
+#include <random>
+#include <vector>
+
+namespace {
+
+const std::vector<Position> glider = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> livingCells(const ChunkedPlane& plane) {
+    std::vector<Position> cells;
+    plane.collectLivingCells(cells);
+    return sorted(cells);
+}
+
+GameConfig chunkedConfig() {
+    GameConfig config;
+    config.setStorageEngine(StorageEngine::Chunked);
+    config.setAdaptiveStorage(false);
+    return config;
+}
+
+} // namespace
+
+TEST_CASE("Chunked storage is selected by name", "[ChunkedPlane]") {
+    REQUIRE(storageEngineFromName("chunked") == StorageEngine::Chunked);
+    REQUIRE(std::string(storageEngineName(StorageEngine::Chunked)) == "chunked");
+
+    GameOfLifeSimulation simulation(chunkedConfig());
+    REQUIRE(simulation.usesChunkedStorage());
+}
+
+TEST_CASE("Chunked plane cells live anywhere on the 32-bit plane", "[ChunkedPlane]") {
+    ChunkedPlane plane;
+    plane.setCell(0, 0, true);
+    plane.setCell(-1, -1, true);
+    plane.setCell(-1000000, 7, true);
+    plane.setCell(2000000000, -2000000000, true);
+    plane.setCell(2000000000, -2000000000, true);
+
+    REQUIRE(plane.getLivingCellCount() == 4);
+    REQUIRE(plane.getChunkCount() == 4);
+    REQUIRE(plane.getCell(-1, -1));
+    REQUIRE(plane.getCell(2000000000, -2000000000));
+    REQUIRE_FALSE(plane.getCell(1, 0));
+    REQUIRE(plane.countNeighbors(0, -1) == 2);
+
+    plane.setCell(-1, -1, false);
+    REQUIRE(plane.getLivingCellCount() == 3);
+    REQUIRE(livingCells(plane) ==
+            sorted({{0, 0}, {-1000000, 7}, {2000000000, -2000000000}}));
+
+    std::vector<Position> region;
+    plane.collectLivingCellsInRegion(-1000000, 0, 0, 7, region);
+    REQUIRE(sorted(region) == std::vector<Position>{{-1000000, 7}, {0, 0}});
+}
+
+TEST_CASE("Chunked plane steps like HashLife across chunk borders", "[ChunkedPlane]") {
+    // A soup straddling the origin covers negative chunks and every chunk edge
+    std::mt19937 rng(34);
+    std::vector<Position> soup;
+    for (std::int32_t y = -70; y < 70; ++y) {
+        for (std::int32_t x = -70; x < 70; ++x) {
+            if (rng() % 3 == 0) {
+                soup.emplace_back(x, y);
+            }
+        }
+    }
+
+    for (const auto& rule : {kConwayRule, kHighLifeRule, *LifeRule::parse("B36/S125")}) {
+        GameConfig config = chunkedConfig();
+        config.setRule(rule);
+        auto chunked = createLifeEngine(config);
+        config.setStorageEngine(StorageEngine::HashLife);
+        auto reference = createLifeEngine(config);
+        chunked->setCellsAlive(soup);
+        reference->setCellsAlive(soup);
+
+        for (int generation = 0; generation < 30; ++generation) {
+            INFO(rule.toString() << " generation " << generation);
+            REQUIRE(chunked->step() == reference->step());
+            REQUIRE(sorted(chunked->getLivingPositions()) == sorted(reference->getLivingPositions()));
+            REQUIRE(sorted(chunked->getBornCells()) == sorted(reference->getBornCells()));
+            REQUIRE(sorted(chunked->getDiedCells()) == sorted(reference->getDiedCells()));
+            REQUIRE(chunked->getLivingCellCount() == reference->getLivingCellCount());
+        }
+    }
+}
+
+TEST_CASE("Gliders fly past the configured grid", "[ChunkedPlane]") {
+    // A 100x100 grid would stop the glider at its edge; the chunked plane ignores it
+    GameOfLifeSimulation simulation(chunkedConfig());
+    simulation.setCellsAlive(glider);
+    for (int generation = 0; generation < 4000; ++generation) {
+        simulation.step();
+    }
+
+    // A glider moves one cell diagonally every four generations
+    std::vector<Position> expected;
+    for (const auto& pos : glider) {
+        expected.emplace_back(pos.x + 1000, pos.y + 1000);
+    }
+    REQUIRE(sorted(simulation.getLivingPositions()) == sorted(expected));
+
+    // Only the chunks around the glider are held, never the path behind it
+    std::vector<Position> reversed;
+    for (const auto& pos : glider) {
+        reversed.emplace_back(-pos.x, -pos.y);
+    }
+    ChunkedPlane plane;
+    for (const auto& pos : reversed) {
+        plane.setCell(pos.x, pos.y, true);
+    }
+    for (int generation = 0; generation < 4000; ++generation) {
+        plane.step();
+        REQUIRE(plane.getChunkCount() <= 4);
+    }
+    REQUIRE(plane.getLivingCellCount() == 5);
+    REQUIRE(plane.getCell(-1001, -1000));
+}
+
+TEST_CASE("Chunks are freed once they empty", "[ChunkedPlane]") {
+    ChunkedPlane plane;
+    // Lone cells in the middle of 64 chunks: all die, and nothing spills over
+    for (std::int32_t chunk = 0; chunk < 64; ++chunk) {
+        plane.setCell(chunk * 64 + 32, 32, true);
+    }
+    REQUIRE(plane.getChunkCount() == 64);
+    const std::size_t peak = plane.getMemoryUsage();
+
+    REQUIRE(plane.step());
+    REQUIRE(plane.getChunkCount() == 0);
+    std::vector<Position> born;
+    std::vector<Position> died;
+    plane.collectChanges(born, died);
+    REQUIRE(born.empty());
+    REQUIRE(died.size() == 64);
+
+    // The next step lets go of the generation buffers that held them
+    REQUIRE_FALSE(plane.step());
+    REQUIRE(plane.getMemoryUsage() < peak / 4);
+}
+
+TEST_CASE("Cells past the 32-bit coordinate range stay dead", "[ChunkedPlane]") {
+    ChunkedPlane plane;
+    // Vertical blinker on the last column: the cell it would put past it is never born
+    for (std::int32_t y = 0; y < 3; ++y) {
+        plane.setCell(INT32_MAX, y, true);
+    }
+    plane.step();
+    REQUIRE(livingCells(plane) == std::vector<Position>{{INT32_MAX - 1, 1}, {INT32_MAX, 1}});
+
+    for (std::int32_t x = 0; x < 3; ++x) {
+        plane.setCell(INT32_MIN + x, INT32_MIN, true);
+    }
+    REQUIRE(plane.countNeighbors(INT32_MIN, INT32_MIN) == 1);
+}
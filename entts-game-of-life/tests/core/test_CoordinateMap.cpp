@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/CoordinateMap.h"
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+
+TEST_CASE("CoordinateMap basic operations", "[CoordinateMap]") {
+    CoordinateMap<int> map;
+    REQUIRE(map.empty());
+    REQUIRE(map.find(Position(0, 0)) == map.end());
+
+    SECTION("Insert, find and overwrite") {
+        map[Position(1, 2)] = 10;
+        map[Position(-1, -2)] = 20;
+        REQUIRE(map.size() == 2);
+        REQUIRE(map.find(Position(1, 2))->second == 10);
+        REQUIRE(map.find(Position(-1, -2))->second == 20);
+        REQUIRE_FALSE(map.contains(Position(2, 1)));
+
+        map[Position(1, 2)] = 30;
+        REQUIRE(map.size() == 2);
+        REQUIRE(map.find(Position(1, 2))->second == 30);
+
+        REQUIRE_FALSE(map.insert(Position(1, 2), 40));
+        REQUIRE(map.insert(Position(5, 5), 50));
+        REQUIRE(map.find(Position(1, 2))->second == 30);
+    }
+
+    SECTION("Extreme coordinates stay distinct") {
+        map[Position(std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max())] = 1;
+        map[Position(std::numeric_limits<std::int32_t>::max(), std::numeric_limits<std::int32_t>::min())] = 2;
+        map[Position(-1, 0)] = 3;
+        map[Position(0, -1)] = 4;
+        REQUIRE(map.size() == 4);
+        REQUIRE(map.find(Position(std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max()))->second == 1);
+        REQUIRE(map.find(Position(std::numeric_limits<std::int32_t>::max(), std::numeric_limits<std::int32_t>::min()))->second == 2);
+        REQUIRE(map.find(Position(-1, 0))->second == 3);
+        REQUIRE(map.find(Position(0, -1))->second == 4);
+    }
+
+    SECTION("Erase by key and by iterator") {
+        map[Position(3, 3)] = 1;
+        map[Position(4, 4)] = 2;
+        REQUIRE(map.erase(Position(3, 3)) == 1);
+        REQUIRE(map.erase(Position(3, 3)) == 0);
+
+        map.erase(map.find(Position(4, 4)));
+        REQUIRE(map.empty());
+    }
+
+    SECTION("Clear keeps the slot array") {
+        for (std::int32_t i = 0; i < 100; ++i) {
+            map[Position(i, -i)] = i;
+        }
+        std::size_t capacity = map.capacity();
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(map.capacity() == capacity);
+        REQUIRE_FALSE(map.contains(Position(5, -5)));
+    }
+}
+
+TEST_CASE("CoordinateMap matches an ordered map", "[CoordinateMap]") {
+    // Random inserts and erases in a small window force long probe runs and
+    // many backward shifts
+    CoordinateMap<int> map;
+    std::map<Position, int> reference;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::int32_t> coord(-40, 40);
+
+    for (int op = 0; op < 20000; ++op) {
+        Position pos(coord(rng), coord(rng));
+        if (rng() % 3 == 0) {
+            REQUIRE(map.erase(pos) == reference.erase(pos));
+        } else {
+            map[pos] = op;
+            reference[pos] = op;
+        }
+    }
+
+    REQUIRE(map.size() == reference.size());
+    for (const auto& [pos, value] : reference) {
+        auto it = map.find(pos);
+        REQUIRE(it != map.end());
+        REQUIRE(it->second == value);
+    }
+
+    // Iteration visits every entry exactly once
+    std::set<Position> visited;
+    for (const auto& [pos, value] : map) {
+        REQUIRE(visited.insert(pos).second);
+        REQUIRE(reference.at(pos) == value);
+    }
+    REQUIRE(visited.size() == reference.size());
+}
+
+TEST_CASE("Position hash spreads diagonal patterns", "[CoordinateMap]") {
+    // A long diagonal, as left by a glider stream, must not pile onto a few buckets
+    constexpr std::size_t kBuckets = 1024;
+    std::set<std::size_t> buckets;
+    for (std::int32_t i = -512; i < 512; ++i) {
+        buckets.insert(std::hash<Position>{}(Position(i, i)) % kBuckets);
+    }
+    REQUIRE(buckets.size() > kBuckets / 2);
+}
+
+TEST_CASE("Position Morton key follows Z-order", "[CoordinateMap]") {
+    // Each 2x2 block is visited x-first, then the blocks in the same Z
+    const std::vector<Position> zOrder = {{0, 0}, {1, 0}, {0, 1}, {1, 1}, {2, 0}, {3, 0}, {2, 1}, {3, 1},
+                                          {0, 2}, {1, 2}, {0, 3}, {1, 3}, {2, 2}, {3, 2}, {2, 3}, {3, 3}};
+    for (std::size_t i = 1; i < zOrder.size(); ++i) {
+        REQUIRE(zOrder[i - 1].morton() < zOrder[i].morton());
+    }
+    
+    // Negative coordinates come first, and the extremes stay distinct
+    REQUIRE(Position(-1, -1).morton() < Position(0, 0).morton());
+    REQUIRE(Position(-1, 0).morton() < Position(0, 0).morton());
+    constexpr auto kMin = std::numeric_limits<std::int32_t>::min();
+    constexpr auto kMax = std::numeric_limits<std::int32_t>::max();
+    REQUIRE(Position(kMin, kMin).morton() == 0);
+    REQUIRE(Position(kMax, kMax).morton() == ~std::uint64_t{0});
+}
@@ -0,0 +1,158 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/CudaLifeEngine.h"
+#include "core/GameOfLifeSimulation.h"
+#include "core/GameConfig.h"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+// Built into core_tests only with -DBUILD_CUDA_ENGINE=ON; hosts without a
+// device pass these with a warning
+
+namespace {
+
+GameConfig makeConfig(std::int32_t width, std::int32_t height, bool wrap, const LifeRule& rule = kConwayRule) {
+    GameConfig config;
+    config.setGridWidth(width);
+    config.setGridHeight(height);
+    config.setWrapEdges(wrap);
+    config.setStorageEngine(StorageEngine::Dense);
+    config.setRule(rule);
+    return config;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> randomCells(std::int32_t width, std::int32_t height, double density, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution alive(density);
+    std::vector<Position> cells;
+    for (std::int32_t y = 0; y < height; ++y) {
+        for (std::int32_t x = 0; x < width; ++x) {
+            if (alive(rng)) {
+                cells.emplace_back(x, y);
+            }
+        }
+    }
+    return cells;
+}
+
+bool deviceMissing() {
+    if (CudaLifeEngine::isAvailable()) {
+        return false;
+    }
+    WARN("No CUDA device; skipping");
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("CUDA engine matches dense storage", "[CudaLifeEngine]") {
+    if (deviceMissing()) {
+        return;
+    }
+
+    struct Scenario {
+        std::int32_t width;
+        std::int32_t height;
+        bool wrap;
+        LifeRule rule;
+    };
+
+    // Widths on and off a word boundary, one word and several
+    const std::vector<Scenario> scenarios{{64, 40, true, kConwayRule},   {64, 40, false, kConwayRule},
+                                          {150, 33, true, kConwayRule},  {150, 33, false, kConwayRule},
+                                          {37, 50, true, kHighLifeRule}, {200, 20, false, kDayAndNightRule}};
+
+    for (const auto& scenario : scenarios) {
+        INFO("board " << scenario.width << "x" << scenario.height << " wrap " << scenario.wrap << " rule "
+                      << scenario.rule.toString());
+        const auto config = makeConfig(scenario.width, scenario.height, scenario.wrap, scenario.rule);
+        CudaLifeEngine gpu(config);
+        GameOfLifeSimulation dense(config);
+
+        const auto cells = randomCells(scenario.width, scenario.height, 0.35, 7);
+        gpu.setCellsAlive(cells);
+        dense.setCellsAlive(cells);
+        REQUIRE(gpu.getLivingCellCount() == dense.getLivingCellCount());
+
+        for (int generation = 0; generation < 40; ++generation) {
+            REQUIRE(gpu.step() == dense.step());
+            REQUIRE(gpu.getLivingCellCount() == dense.getLivingCellCount());
+            REQUIRE(sorted(gpu.getBornCells()) == sorted(dense.getBornCells()));
+            REQUIRE(sorted(gpu.getDiedCells()) == sorted(dense.getDiedCells()));
+        }
+        REQUIRE(sorted(gpu.getLivingPositions()) == sorted(dense.getLivingPositions()));
+
+        // Many generations in one call stay on the device
+        REQUIRE(gpu.advance(300) == dense.advance(300));
+        REQUIRE(gpu.getGenerationCount() == dense.getGenerationCount());
+        REQUIRE(sorted(gpu.getLivingPositions()) == sorted(dense.getLivingPositions()));
+    }
+}
+
+TEST_CASE("CUDA engine queries copy back regions and edits", "[CudaLifeEngine]") {
+    if (deviceMissing()) {
+        return;
+    }
+
+    SECTION("Region queries match dense storage, wrapped copies included") {
+        for (bool wrap : {false, true}) {
+            const auto config = makeConfig(130, 70, wrap);
+            CudaLifeEngine gpu(config);
+            GameOfLifeSimulation dense(config);
+            const auto cells = randomCells(130, 70, 0.3, 11);
+            gpu.setCellsAlive(cells);
+            dense.setCellsAlive(cells);
+            gpu.advance(5);
+            dense.advance(5);
+
+            for (const auto& [minX, maxX, minY, maxY] : std::vector<std::array<std::int32_t, 4>>{
+                     {0, 129, 0, 69}, {60, 70, 10, 12}, {-20, 140, -5, 80}, {127, 129, 69, 69}, {200, 300, 0, 5}}) {
+                std::vector<Position> fromGpu;
+                std::vector<Position> fromDense;
+                gpu.collectLivingCellsInRegion(minX, maxX, minY, maxY, fromGpu);
+                dense.collectLivingCellsInRegion(minX, maxX, minY, maxY, fromDense);
+                REQUIRE(sorted(fromGpu) == sorted(fromDense));
+            }
+        }
+    }
+
+    SECTION("Edits apply in order and wrap like the grid") {
+        CudaLifeEngine gpu(makeConfig(100, 100, true));
+        gpu.setCellAlive(5, 5);
+        gpu.setCellDead(5, 5);
+        gpu.setCellAlive(-1, 100); // (99, 0)
+        gpu.setCellAlive(99, 0);
+        REQUIRE(gpu.getLivingCellCount() == 1);
+        REQUIRE(gpu.isCellAlive(99, 0));
+        REQUIRE(gpu.isCellAlive(-1, 0));
+        REQUIRE_FALSE(gpu.isCellAlive(5, 5));
+
+        CudaLifeEngine bounded(makeConfig(10, 10, false));
+        bounded.setCellAlive(10, 3);
+        bounded.setCellAlive(-1, 3);
+        REQUIRE(bounded.getLivingCellCount() == 0);
+    }
+
+    SECTION("A settled board stops advance early") {
+        CudaLifeEngine gpu(makeConfig(300, 300, false));
+        gpu.setCellsAlive(std::vector<Position>{{10, 10}, {11, 10}, {10, 11}, {11, 11}});
+        REQUIRE(gpu.advance(CudaLifeEngine::kAdvanceBatch * 3) == 1);
+        REQUIRE(gpu.getGenerationCount() == 1);
+        REQUIRE_FALSE(gpu.step());
+        REQUIRE(gpu.getBornCells().empty());
+
+        // A blinker never settles, so every step is taken
+        gpu.reset();
+        gpu.setCellsAlive(std::vector<Position>{{4, 5}, {5, 5}, {6, 5}});
+        REQUIRE(gpu.advance(CudaLifeEngine::kAdvanceBatch + 3) == CudaLifeEngine::kAdvanceBatch + 3);
+        REQUIRE(sorted(gpu.getLivingPositions()) == sorted({{5, 4}, {5, 5}, {5, 6}}));
+        REQUIRE(gpu.getBornCells() == sorted({{5, 4}, {5, 6}}));
+        REQUIRE(gpu.getDiedCells() == sorted({{4, 5}, {6, 5}}));
+    }
+}
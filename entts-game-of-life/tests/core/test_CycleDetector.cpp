@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/CycleDetector.h"
+#include "core/GameOfLifeSimulation.h"
+#include "core/GameConfig.h"
+#include <optional>
+#include <vector>
+
+namespace {
+
+GameConfig makeConfig(StorageEngine engine) {
+    GameConfig config;
+    config.setGridWidth(60);
+    config.setGridHeight(60);
+    config.setStorageEngine(engine);
+    return config;
+}
+
+// Steps the simulation, feeding its changes to the detector, until a cycle is found
+std::optional<CycleDetector::Cycle> runUntilCycle(GameOfLifeSimulation& simulation, CycleDetector& detector,
+                                                  int maxGenerations) {
+    for (const auto& pos : simulation.getLivingPositions()) {
+        detector.add(pos);
+    }
+    detector.record(simulation.getGenerationCount());
+
+    for (int i = 0; i < maxGenerations; ++i) {
+        simulation.step();
+        for (const auto& pos : simulation.getBornCells()) {
+            detector.add(pos);
+        }
+        for (const auto& pos : simulation.getDiedCells()) {
+            detector.remove(pos);
+        }
+        if (auto cycle = detector.record(simulation.getGenerationCount())) {
+            return cycle;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+TEST_CASE("Cycle detector hashes shapes independently of position", "[CycleDetector]") {
+    const std::vector<Position> glider = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+
+    CycleDetector detector;
+    for (const auto& pos : glider) {
+        detector.add(pos);
+    }
+    REQUIRE_FALSE(detector.record(0).has_value());
+
+    // Same shape moved by (-7, 12)
+    for (const auto& pos : glider) {
+        detector.remove(pos);
+    }
+    for (const auto& pos : glider) {
+        detector.add(Position(pos.x - 7, pos.y + 12));
+    }
+    auto cycle = detector.record(3);
+    REQUIRE(cycle.has_value());
+    REQUIRE(cycle->period == 3);
+    REQUIRE(cycle->dx == -7);
+    REQUIRE(cycle->dy == 12);
+    REQUIRE(cycle->startGeneration == 0);
+
+    // One cell more is a different shape
+    detector.add(Position(40, 40));
+    REQUIRE_FALSE(detector.record(4).has_value());
+    REQUIRE(detector.size() == glider.size() + 1);
+
+    detector.clear();
+    REQUIRE(detector.size() == 0);
+    REQUIRE_FALSE(detector.record(5).has_value());
+}
+
+TEST_CASE("Cycle detector finds exact cycles on every engine", "[CycleDetector]") {
+    struct Case {
+        const char* name;
+        std::vector<Position> cells;
+        std::uint64_t period;
+        std::int32_t dx;
+        std::int32_t dy;
+    };
+    const std::vector<Case> cases = {
+        {"block", {{20, 20}, {21, 20}, {20, 21}, {21, 21}}, 1, 0, 0},
+        {"blinker", {{19, 20}, {20, 20}, {21, 20}}, 2, 0, 0},
+        {"glider", {{21, 20}, {22, 21}, {20, 22}, {21, 22}, {22, 22}}, 4, 1, 1},
+    };
+
+    for (StorageEngine engine : {StorageEngine::Sparse, StorageEngine::Dense, StorageEngine::Tiled,
+                                 StorageEngine::HashLife}) {
+        for (const auto& pattern : cases) {
+            INFO("engine " << static_cast<int>(engine) << ", " << pattern.name);
+            GameOfLifeSimulation simulation(makeConfig(engine));
+            for (const auto& pos : pattern.cells) {
+                simulation.setCellAlive(pos.x, pos.y);
+            }
+
+            CycleDetector detector;
+            auto cycle = runUntilCycle(simulation, detector, 10);
+            REQUIRE(cycle.has_value());
+            REQUIRE(cycle->period == pattern.period);
+            REQUIRE(cycle->dx == pattern.dx);
+            REQUIRE(cycle->dy == pattern.dy);
+
+            // Found the first time the state repeats
+            REQUIRE(simulation.getGenerationCount() == pattern.period);
+        }
+
+        // The R-pentomino holds a steady population at times but takes over a
+        // thousand generations to settle
+        INFO("engine " << static_cast<int>(engine) << ", R-pentomino");
+        GameOfLifeSimulation simulation(makeConfig(engine));
+        for (const auto& pos : {Position(21, 20), Position(22, 20), Position(20, 21), Position(21, 21),
+                                Position(21, 22)}) {
+            simulation.setCellAlive(pos.x, pos.y);
+        }
+        CycleDetector detector;
+        REQUIRE_FALSE(runUntilCycle(simulation, detector, 40).has_value());
+    }
+}
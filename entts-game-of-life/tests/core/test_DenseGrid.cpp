@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/GameOfLifeSimulation.h"
+#include "core/DenseGrid.h"
+#include "core/GameConfig.h"
+#include <algorithm>
+#include <random>
+
+namespace {
+
+GameConfig makeConfig(std::int32_t width, std::int32_t height, bool wrap, StorageEngine engine) {
+    GameConfig config;
+    config.setGridWidth(width);
+    config.setGridHeight(height);
+    config.setWrapEdges(wrap);
+    config.setStorageEngine(engine);
+    return config;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+} // namespace
+
+TEST_CASE("DenseGrid cell storage", "[DenseGrid]") {
+    DenseGrid grid(130, 4, false);
+
+    SECTION("Cells are packed one bit per cell") {
+        REQUIRE(grid.getWordsPerRow() == 3);
+
+        grid.setCell(0, 0, true);
+        grid.setCell(63, 0, true);
+        grid.setCell(64, 0, true);
+        grid.setCell(129, 3, true);
+
+        REQUIRE(grid.getLivingCellCount() == 4);
+        REQUIRE(grid.rowData(0)[0] == ((std::uint64_t{1} << 63) | 1u));
+        REQUIRE(grid.rowData(0)[1] == 1u);
+        REQUIRE(grid.getCell(129, 3));
+    }
+
+    SECTION("Setting a cell twice keeps one cell") {
+        grid.setCell(5, 2, true);
+        grid.setCell(5, 2, true);
+        REQUIRE(grid.getLivingCellCount() == 1);
+
+        grid.setCell(5, 2, false);
+        REQUIRE(grid.getLivingCellCount() == 0);
+        REQUIRE_FALSE(grid.getCell(5, 2));
+    }
+
+    SECTION("Neighbors across word boundaries are counted") {
+        grid.setCell(63, 1, true);
+        grid.setCell(64, 1, true);
+        grid.setCell(65, 2, true);
+
+        REQUIRE(grid.countNeighbors(64, 2) == 3);
+        REQUIRE(grid.countNeighbors(63, 2) == 2);
+    }
+}
+
+TEST_CASE("Dense storage through GameOfLifeSimulation", "[DenseGrid]") {
+    GameOfLifeSimulation simulation(makeConfig(20, 20, false, StorageEngine::Dense));
+    REQUIRE(simulation.usesDenseStorage());
+
+    SECTION("Bounded mode rejects cells outside the grid") {
+        simulation.setCellAlive(-1, 0);
+        simulation.setCellAlive(20, 5);
+        simulation.setCellAlive(19, 19);
+
+        REQUIRE(simulation.getLivingCellCount() == 1);
+        REQUIRE_FALSE(simulation.isCellAlive(20, 5));
+        REQUIRE(simulation.getEntityAt(19, 19) == entt::entity{entt::null});
+    }
+
+    SECTION("Blinker oscillates and still lifes report no change") {
+        simulation.setCellAlive(1, 0);
+        simulation.setCellAlive(1, 1);
+        simulation.setCellAlive(1, 2);
+
+        REQUIRE(simulation.step());
+        REQUIRE(simulation.isCellAlive(0, 1));
+        REQUIRE(simulation.isCellAlive(2, 1));
+        REQUIRE_FALSE(simulation.isCellAlive(1, 0));
+
+        simulation.reset();
+        simulation.setCellAlive(5, 5);
+        simulation.setCellAlive(5, 6);
+        simulation.setCellAlive(6, 5);
+        simulation.setCellAlive(6, 6);
+
+        REQUIRE_FALSE(simulation.step());
+        REQUIRE(simulation.getLivingCellCount() == 4);
+        REQUIRE(simulation.getGenerationCount() == 1);
+    }
+
+    SECTION("Wrapped mode normalizes coordinates") {
+        simulation.setConfig(makeConfig(20, 20, true, StorageEngine::Dense));
+
+        simulation.setCellAlive(-1, -1);
+        REQUIRE(simulation.isCellAlive(19, 19));
+        REQUIRE(simulation.isCellAlive(39, -21));
+
+        simulation.setCellDead(19, -1);
+        REQUIRE(simulation.getLivingCellCount() == 0);
+    }
+
+    SECTION("Switching back to sparse storage restores entities") {
+        simulation.setConfig(makeConfig(20, 20, false, StorageEngine::Sparse));
+        REQUIRE_FALSE(simulation.usesDenseStorage());
+
+        simulation.setCellAlive(3, 3);
+        REQUIRE(simulation.getEntityAt(3, 3) != entt::entity{entt::null});
+    }
+}
+
+TEST_CASE("Dense storage matches sparse storage", "[DenseGrid]") {
+    struct Scenario {
+        std::int32_t width;
+        std::int32_t height;
+        bool wrap;
+    };
+
+    // Includes widths that are not a multiple of 64 and tiny wrapped grids
+    for (const auto& scenario : {Scenario{40, 30, false}, Scenario{70, 20, true},
+                                 Scenario{3, 3, true}, Scenario{129, 9, false}}) {
+        GameOfLifeSimulation sparse(makeConfig(scenario.width, scenario.height, scenario.wrap, StorageEngine::Sparse));
+        GameOfLifeSimulation dense(makeConfig(scenario.width, scenario.height, scenario.wrap, StorageEngine::Dense));
+
+        std::mt19937 rng(static_cast<std::uint32_t>(scenario.width * 31 + scenario.height));
+        std::bernoulli_distribution alive(0.35);
+        for (std::int32_t y = 0; y < scenario.height; ++y) {
+            for (std::int32_t x = 0; x < scenario.width; ++x) {
+                if (alive(rng)) {
+                    sparse.setCellAlive(x, y);
+                    dense.setCellAlive(x, y);
+                }
+            }
+        }
+
+        for (int generation = 0; generation < 25; ++generation) {
+            REQUIRE(dense.step() == sparse.step());
+            REQUIRE(dense.getLivingCellCount() == sparse.getLivingCellCount());
+            REQUIRE(sorted(dense.getLivingPositions()) == sorted(sparse.getLivingPositions()));
+        }
+    }
+}
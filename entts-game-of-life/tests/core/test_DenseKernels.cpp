@@ -0,0 +1,187 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/GameOfLifeSimulation.h"
+#include "core/DenseGrid.h"
+#include "core/DenseKernels.h"
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace {
+
+bool bitAt(const std::vector<std::uint64_t>& row, std::int64_t x) {
+    // Guard word at index 0, data from index 1
+    return (row[static_cast<std::size_t>(x >> 6) + 1] >> (x & 63)) & 1u;
+}
+
+// Per-cell reference for one row of guarded words
+std::vector<std::uint64_t> referenceRow(const std::vector<std::uint64_t>& above, const std::vector<std::uint64_t>& row,
+                                        const std::vector<std::uint64_t>& below, std::size_t words) {
+    std::vector<std::uint64_t> out(words, 0);
+    const std::vector<std::uint64_t>* rows[3] = {&above, &row, &below};
+
+    for (std::int64_t x = 0; x < static_cast<std::int64_t>(words * 64); ++x) {
+        int neighbors = 0;
+        for (int r = 0; r < 3; ++r) {
+            for (std::int64_t dx = -1; dx <= 1; ++dx) {
+                if (r == 1 && dx == 0) continue;
+                neighbors += bitAt(*rows[r], x + dx) ? 1 : 0;
+            }
+        }
+        if (neighbors == 3 || (neighbors == 2 && bitAt(row, x))) {
+            out[static_cast<std::size_t>(x >> 6)] |= std::uint64_t{1} << (x & 63);
+        }
+    }
+    return out;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+// Steps the same cells through the sparse engine and a grid forced onto `kernel`
+void requireMatchesSparse(const DenseKernel& kernel, std::int32_t width, std::int32_t height, bool wrap,
+                          const std::vector<Position>& cells, int generations) {
+    GameConfig config;
+    config.setGridWidth(width);
+    config.setGridHeight(height);
+    config.setWrapEdges(wrap);
+    GameOfLifeSimulation sparse(config);
+
+    DenseGrid dense(width, height, wrap);
+    dense.setKernel(kernel);
+
+    for (const auto& pos : cells) {
+        sparse.setCellAlive(pos.x, pos.y);
+        dense.setCell(pos.x, pos.y, true);
+    }
+
+    for (int generation = 0; generation < generations; ++generation) {
+        REQUIRE(dense.step() == sparse.step());
+
+        std::vector<Position> denseCells;
+        dense.collectLivingCells(denseCells);
+        REQUIRE(sorted(denseCells) == sorted(sparse.getLivingPositions()));
+    }
+}
+
+} // namespace
+
+TEST_CASE("Dense kernel dispatch", "[DenseKernels]") {
+    auto kernels = availableDenseKernels();
+
+    SECTION("Scalar kernel is always available") {
+        REQUIRE_FALSE(kernels.empty());
+        REQUIRE(std::string(kernels.front().name) == "scalar");
+        REQUIRE(findDenseKernel("scalar") != nullptr);
+        REQUIRE(findDenseKernel("no-such-kernel") == nullptr);
+    }
+
+    SECTION("Grids default to the most capable kernel") {
+        REQUIRE(std::string(selectDenseKernel().name) == kernels.back().name);
+
+        DenseGrid grid(8, 8, false);
+        REQUIRE(std::string(grid.getKernelName()) == selectDenseKernel().name);
+    }
+}
+
+TEST_CASE("Dense kernels match a per-cell reference", "[DenseKernels]") {
+    std::mt19937_64 rng(2024);
+
+    for (const auto& kernel : availableDenseKernels()) {
+        SECTION(std::string("Kernel ") + kernel.name) {
+            // Word counts cover the vector body, the scalar tail, and both together
+            for (std::size_t words : {1u, 2u, 3u, 4u, 5u, 7u, 8u, 13u}) {
+                for (int trial = 0; trial < 20; ++trial) {
+                    std::vector<std::uint64_t> rows[3];
+                    for (auto& row : rows) {
+                        row.assign(words + 2, 0);
+                        for (std::size_t w = 1; w <= words; ++w) {
+                            // Mix dense and sparse words
+                            row[w] = (trial % 2 == 0) ? rng() : (rng() & rng() & rng());
+                        }
+                    }
+
+                    std::vector<std::uint64_t> out(words, 0);
+                    kernel.stepRow(rows[0].data() + 1, rows[1].data() + 1, rows[2].data() + 1, out.data(), words);
+
+                    REQUIRE(out == referenceRow(rows[0], rows[1], rows[2], words));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Dense kernels follow Conway's rules", "[DenseKernels]") {
+    // The cell layouts of test_GameOfLifeRules.cpp, on the default 100x100 grid
+    const std::vector<std::vector<Position>> ruleCases = {
+        {{1, 1}, {0, 1}, {2, 1}},                 // Survives with 2 neighbors
+        {{1, 1}, {0, 1}, {2, 1}, {1, 0}},         // Survives with 3 neighbors
+        {{1, 1}, {0, 1}},                         // Underpopulation
+        {{1, 1}},                                 // Isolated cell
+        {{1, 1}, {0, 1}, {2, 1}, {1, 0}, {1, 2}}, // Overpopulation
+        {{0, 1}, {2, 1}, {1, 0}},                 // Reproduction
+        {{0, 1}, {2, 1}},                         // Dead cell with 2 neighbors
+        {{0, 1}, {2, 1}, {1, 0}, {1, 2}},         // Dead cell with 4 neighbors
+        {{1, 0}, {1, 1}, {1, 2}},                 // Blinker
+        {{1, 1}, {1, 2}, {2, 1}, {2, 2}},         // Block
+    };
+
+    for (const auto& kernel : availableDenseKernels()) {
+        SECTION(std::string("Kernel ") + kernel.name) {
+            for (const auto& cells : ruleCases) {
+                requireMatchesSparse(kernel, 100, 100, false, cells, 3);
+                requireMatchesSparse(kernel, 100, 100, true, cells, 3);
+            }
+
+            // Glider crossing both wrapped edges and the 64-bit word boundary
+            std::vector<Position> glider = {{61, 0}, {62, 1}, {60, 2}, {61, 2}, {62, 2}};
+            requireMatchesSparse(kernel, 70, 12, true, glider, 60);
+            requireMatchesSparse(kernel, 130, 12, false, glider, 20);
+        }
+    }
+}
+
+TEST_CASE("Dense kernels agree on a large bounded board", "[DenseKernels]") {
+    // Same size as flecs-game-of-life/examples/configs/performance_test.json
+    const std::int32_t size = 1000;
+    std::mt19937 rng(7);
+    std::bernoulli_distribution alive(0.3);
+
+    std::vector<Position> seed;
+    for (std::int32_t y = 0; y < size; ++y) {
+        for (std::int32_t x = 0; x < size; ++x) {
+            if (alive(rng)) {
+                seed.emplace_back(x, y);
+            }
+        }
+    }
+
+    // The scalar kernel is the reference for every vector kernel
+    DenseGrid reference(size, size, false);
+    reference.setKernel(*findDenseKernel("scalar"));
+    for (const auto& pos : seed) {
+        reference.setCell(pos.x, pos.y, true);
+    }
+    for (int generation = 0; generation < 5; ++generation) {
+        reference.step();
+    }
+    std::vector<Position> expected;
+    reference.collectLivingCells(expected);
+
+    for (const auto& kernel : availableDenseKernels()) {
+        DenseGrid grid(size, size, false);
+        grid.setKernel(kernel);
+        for (const auto& pos : seed) {
+            grid.setCell(pos.x, pos.y, true);
+        }
+        for (int generation = 0; generation < 5; ++generation) {
+            grid.step();
+        }
+
+        std::vector<Position> actual;
+        grid.collectLivingCells(actual);
+        INFO("Kernel " << kernel.name);
+        REQUIRE(actual == expected);
+    }
+}
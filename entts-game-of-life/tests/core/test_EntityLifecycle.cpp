@@ -3,6 +3,7 @@
 #include "core/components/Position.h"
 #include "core/components/Cell.h"
 #include <entt/entt.hpp>
+#include <vector>
 
 TEST_CASE("Entity creation and destruction", "[EntityLifecycle]") {
     GameOfLifeSimulation simulation;
@@ -43,6 +44,28 @@ TEST_CASE("Entity creation and destruction", "[EntityLifecycle]") {
         simulation.setCellDead(15, 15); // Cell doesn't exist
         REQUIRE(simulation.getLivingCellCount() == 0);
     }
+    
+    SECTION("Bulk insertion skips duplicates, live cells and invalid positions") {
+        simulation.setCellAlive(10, 10);
+        
+        const std::vector<Position> cells = {{10, 10}, {11, 10}, {12, 10}, {11, 10}, {0, 99}, {-1, 5}, {12, 10}};
+        simulation.setCellsAlive(cells);
+        
+        REQUIRE(simulation.getLivingCellCount() == 4);
+        for (const auto& pos : {Position(10, 10), Position(11, 10), Position(12, 10), Position(0, 99)}) {
+            auto entity = simulation.getEntityAt(pos.x, pos.y);
+            REQUIRE(entity != entt::null);
+            REQUIRE(simulation.getRegistry().get<Position>(entity) == pos);
+            REQUIRE(simulation.getRegistry().get<Cell>(entity).alive);
+        }
+        REQUIRE_FALSE(simulation.isCellAlive(-1, 5));
+        
+        // Bulk-created cells step like any others
+        simulation.step();
+        REQUIRE(simulation.isCellAlive(11, 9));
+        REQUIRE(simulation.isCellAlive(11, 11));
+        REQUIRE_FALSE(simulation.isCellAlive(0, 99));
+    }
 }
 
 TEST_CASE("Entity components validation", "[EntityLifecycle]") {
@@ -188,4 +211,83 @@ TEST_CASE("Entity position mapping", "[EntityLifecycle]") {
         REQUIRE(entity1 == entity2);
         REQUIRE(entity1 != entt::entity{entt::null});
     }
-}
\ No newline at end of file
+}
+namespace {
+
+std::size_t entityCount(const GameOfLifeSimulation& simulation) {
+    std::size_t count = 0;
+    simulation.getRegistry().view<Position>().each([&count](auto...) { count++; });
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("Dead cells are pooled for reuse", "[EntityLifecycle]") {
+    GameOfLifeSimulation simulation;
+    
+    SECTION("Oscillators revive their entities in place") {
+        // Blinker: the end cells die and are born back every other generation
+        simulation.setCellAlive(5, 4);
+        simulation.setCellAlive(5, 5);
+        simulation.setCellAlive(5, 6);
+        const auto top = simulation.getEntityAt(5, 4);
+        
+        simulation.step();
+        REQUIRE(simulation.getDormantCellCount() == 2);
+        REQUIRE(simulation.getEntityAt(5, 4) == entt::entity{entt::null});
+        REQUIRE(simulation.getRegistry().valid(top));
+        REQUIRE_FALSE(simulation.getRegistry().get<Cell>(top).alive);
+        const auto left = simulation.getEntityAt(4, 5);
+        
+        simulation.step();
+        REQUIRE(simulation.getEntityAt(5, 4) == top);
+        REQUIRE(simulation.getRegistry().get<Cell>(top).alive);
+        REQUIRE(simulation.getDormantCellCount() == 2);
+        
+        for (int i = 0; i < 40; ++i) {
+            simulation.step();
+        }
+        REQUIRE(simulation.getEntityAt(5, 4) == top);
+        REQUIRE(simulation.getDormantCellCount() == 2);
+        REQUIRE(entityCount(simulation) == 5);
+        simulation.step();
+        REQUIRE(simulation.getEntityAt(4, 5) == left);
+        REQUIRE(simulation.getLivingCellCount() == 3);
+        
+        // Setting a dormant cell alive revives it rather than adding an entity
+        simulation.setCellAlive(5, 4);
+        REQUIRE(simulation.getEntityAt(5, 4) == top);
+        REQUIRE(entityCount(simulation) == 5);
+    }
+    
+    SECTION("Expired dormant entities are taken over or destroyed") {
+        // A glider never comes back to a cell, so its dead cells expire
+        for (const auto& pos : {Position(1, 0), Position(2, 1), Position(0, 2), Position(1, 2), Position(2, 2)}) {
+            simulation.setCellAlive(pos.x, pos.y);
+        }
+        for (int i = 0; i < 200; ++i) {
+            simulation.step();
+            REQUIRE(simulation.getDormantCellCount() <= 4 * GameOfLifeSimulation::kDormantGenerations);
+        }
+        REQUIRE(simulation.getLivingCellCount() == 5);
+        REQUIRE(simulation.isCellAlive(51, 50));
+        REQUIRE(entityCount(simulation) ==
+                5 + simulation.getDormantCellCount());
+    }
+    
+    SECTION("Cells killed directly are destroyed, dormant or not") {
+        simulation.setCellAlive(10, 10);
+        simulation.step();
+        REQUIRE(simulation.getDormantCellCount() == 1);
+        
+        simulation.setCellDead(10, 10);
+        REQUIRE(simulation.getDormantCellCount() == 0);
+        REQUIRE(entityCount(simulation) == 0);
+        
+        simulation.setCellAlive(20, 20);
+        simulation.step();
+        simulation.reset();
+        REQUIRE(simulation.getDormantCellCount() == 0);
+        REQUIRE(simulation.getLivingCellCount() == 0);
+    }
+}
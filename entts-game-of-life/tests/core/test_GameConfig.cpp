@@ -152,4 +152,202 @@ TEST_CASE("GameConfig validation", "[GameConfig]") {
         config.setMemoryLimitMb(-1);
         REQUIRE_FALSE(config.isValid());
     }
-}
\ No newline at end of file
+}
+TEST_CASE("GameConfig storage engine selection", "[GameConfig]") {
+    GameConfig config;
+    REQUIRE(config.getStorageEngine() == StorageEngine::Sparse);
+    
+    SECTION("Storage engine round-trips through JSON") {
+        config.setStorageEngine(StorageEngine::Dense);
+        json j = config.toJson();
+        REQUIRE(j["performance"]["storage_engine"] == "dense");
+        
+        GameConfig restored;
+        restored.fromJson(j);
+        REQUIRE(restored.getStorageEngine() == StorageEngine::Dense);
+    }
+    
+    SECTION("Unknown engine names keep the current setting") {
+        json j = {{"performance", {{"storage_engine", "quadtree"}}}};
+        config.fromJson(j);
+        REQUIRE(config.getStorageEngine() == StorageEngine::Sparse);
+    }
+}
+
+TEST_CASE("GameConfig HashLife settings", "[GameConfig]") {
+    GameConfig config;
+    REQUIRE(config.getHashLifeStepLog2() == 0);
+    
+    SECTION("HashLife engine and step size round-trip through JSON") {
+        config.setStorageEngine(StorageEngine::HashLife);
+        config.setHashLifeStepLog2(10);
+        json j = config.toJson();
+        REQUIRE(j["performance"]["storage_engine"] == "hashlife");
+        REQUIRE(j["performance"]["hashlife_step_log2"] == 10);
+        
+        GameConfig restored;
+        restored.fromJson(j);
+        REQUIRE(restored.getStorageEngine() == StorageEngine::HashLife);
+        REQUIRE(restored.getHashLifeStepLog2() == 10);
+    }
+    
+    SECTION("Step exponent outside 0-48 fails validation") {
+        config.setHashLifeStepLog2(-1);
+        REQUIRE_FALSE(config.isValid());
+        
+        config.setHashLifeStepLog2(49);
+        REQUIRE_FALSE(config.isValid());
+    }
+}
+
+TEST_CASE("GameConfig tiled engine settings", "[GameConfig]") {
+    GameConfig config;
+    REQUIRE(config.getWorkerThreads() == 0);
+    
+    SECTION("Tiled engine and worker count round-trip through JSON") {
+        config.setStorageEngine(StorageEngine::Tiled);
+        config.setWorkerThreads(4);
+        json j = config.toJson();
+        REQUIRE(j["performance"]["storage_engine"] == "tiled");
+        REQUIRE(j["performance"]["worker_threads"] == 4);
+        
+        GameConfig restored;
+        restored.fromJson(j);
+        REQUIRE(restored.getStorageEngine() == StorageEngine::Tiled);
+        REQUIRE(restored.getWorkerThreads() == 4);
+    }
+    
+    SECTION("Negative worker count fails validation") {
+        config.setWorkerThreads(-1);
+        REQUIRE_FALSE(config.isValid());
+    }
+    
+    SECTION("NUMA placement settings round-trip through JSON") {
+        REQUIRE_FALSE(config.getNumaPlacement());
+        REQUIRE_FALSE(config.getPinWorkerThreads());
+        config.setNumaPlacement(true);
+        config.setPinWorkerThreads(true);
+        config.setNumaNodeLimit(1);
+        json j = config.toJson();
+        REQUIRE(j["performance"]["numa_placement"] == true);
+        REQUIRE(j["performance"]["numa_node_limit"] == 1);
+        
+        GameConfig restored;
+        restored.fromJson(j);
+        REQUIRE(restored.getNumaPlacement());
+        REQUIRE(restored.getPinWorkerThreads());
+        REQUIRE(restored.getNumaNodeLimit() == 1);
+        
+        restored.setNumaNodeLimit(-1);
+        REQUIRE_FALSE(restored.isValid());
+    }
+}
+
+TEST_CASE("GameConfig adaptive storage settings", "[GameConfig]") {
+    GameConfig config;
+    REQUIRE_FALSE(config.getAdaptiveStorage());
+    REQUIRE(config.getSparseDensityThreshold() < config.getDenseDensityThreshold());
+    
+    SECTION("Adaptive storage and thresholds round-trip through JSON") {
+        config.setAdaptiveStorage(true);
+        config.setDenseDensityThreshold(0.25);
+        config.setSparseDensityThreshold(0.125);
+        json j = config.toJson();
+        REQUIRE(j["performance"]["adaptive_storage"] == true);
+        
+        GameConfig restored;
+        restored.fromJson(j);
+        REQUIRE(restored.getAdaptiveStorage());
+        REQUIRE(restored.getDenseDensityThreshold() == 0.25);
+        REQUIRE(restored.getSparseDensityThreshold() == 0.125);
+    }
+    
+    SECTION("Thresholds without a gap fail validation") {
+        config.setSparseDensityThreshold(config.getDenseDensityThreshold());
+        REQUIRE_FALSE(config.isValid());
+        
+        config.setSparseDensityThreshold(-0.1);
+        REQUIRE_FALSE(config.isValid());
+        
+        config.setSparseDensityThreshold(0.5);
+        config.setDenseDensityThreshold(1.5);
+        REQUIRE_FALSE(config.isValid());
+    }
+}
+
+TEST_CASE("GameConfig cell sort interval", "[GameConfig]") {
+    GameConfig config;
+    REQUIRE(config.getCellSortInterval() == 64);
+    
+    SECTION("Interval round-trips through JSON") {
+        config.setCellSortInterval(0);
+        json j = config.toJson();
+        REQUIRE(j["performance"]["cell_sort_interval"] == 0);
+        
+        GameConfig restored;
+        restored.fromJson(j);
+        REQUIRE(restored.getCellSortInterval() == 0);
+    }
+    
+    SECTION("Negative interval fails validation") {
+        config.setCellSortInterval(-1);
+        REQUIRE_FALSE(config.isValid());
+    }
+}
+
+TEST_CASE("GameConfig checkpoint settings", "[GameConfig]") {
+    GameConfig config;
+    REQUIRE(config.getCheckpointPath().empty());
+    REQUIRE(config.getCheckpointInterval() == 0);
+    
+    SECTION("Settings round-trip through JSON") {
+        config.setCheckpointPath("run.gols");
+        config.setCheckpointInterval(500);
+        json j = config.toJson();
+        REQUIRE(j["simulation"]["checkpoint_path"] == "run.gols");
+        REQUIRE(j["simulation"]["checkpoint_interval"] == 500);
+        
+        GameConfig restored;
+        restored.fromJson(j);
+        REQUIRE(restored.getCheckpointPath() == "run.gols");
+        REQUIRE(restored.getCheckpointInterval() == 500);
+        REQUIRE(restored.isValid());
+    }
+    
+    SECTION("An interval needs a path and may not be negative") {
+        config.setCheckpointInterval(100);
+        REQUIRE_FALSE(config.isValid());
+        config.setCheckpointPath("run.gols");
+        REQUIRE(config.isValid());
+        config.setCheckpointInterval(-1);
+        REQUIRE_FALSE(config.isValid());
+    }
+}
+
+TEST_CASE("GameConfig frame stepping settings", "[GameConfig]") {
+    GameConfig config;
+    REQUIRE(config.getGenerationsPerFrame() == 1);
+    REQUIRE(config.getFrameStepBudgetMs() == 0);
+    
+    SECTION("Settings round-trip through JSON") {
+        config.setGenerationsPerFrame(32);
+        config.setFrameStepBudgetMs(12);
+        json j = config.toJson();
+        REQUIRE(j["simulation"]["generations_per_frame"] == 32);
+        REQUIRE(j["simulation"]["frame_step_budget_ms"] == 12);
+        
+        GameConfig restored;
+        restored.fromJson(j);
+        REQUIRE(restored.getGenerationsPerFrame() == 32);
+        REQUIRE(restored.getFrameStepBudgetMs() == 12);
+        REQUIRE(restored.isValid());
+    }
+    
+    SECTION("A frame advances at least one generation within a non-negative budget") {
+        config.setGenerationsPerFrame(0);
+        REQUIRE_FALSE(config.isValid());
+        config.setGenerationsPerFrame(4);
+        config.setFrameStepBudgetMs(-1);
+        REQUIRE_FALSE(config.isValid());
+    }
+}
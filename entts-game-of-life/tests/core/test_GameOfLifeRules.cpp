@@ -3,6 +3,9 @@
 #include "core/components/Position.h"
 #include "core/components/Cell.h"
 #include <entt/entt.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
 
 TEST_CASE("Conway's Game of Life Rules", "[GameOfLifeRules]") {
     GameOfLifeSimulation simulation;
@@ -142,6 +145,48 @@ TEST_CASE("Classic Game of Life Patterns", "[GameOfLifePatterns]") {
     }
 }
 
+TEST_CASE("Step reports births and deaths", "[GameOfLifeRules]") {
+    GameOfLifeSimulation simulation;
+    
+    SECTION("Blinker flips with two births and two deaths") {
+        simulation.setCellAlive(1, 0);
+        simulation.setCellAlive(1, 1);
+        simulation.setCellAlive(1, 2);
+        
+        REQUIRE(simulation.step());
+        REQUIRE(simulation.getLastBirthCount() == 2);
+        REQUIRE(simulation.getLastDeathCount() == 2);
+    }
+    
+    SECTION("Still life reports no change") {
+        simulation.setCellAlive(1, 1);
+        simulation.setCellAlive(1, 2);
+        simulation.setCellAlive(2, 1);
+        simulation.setCellAlive(2, 2);
+        
+        REQUIRE_FALSE(simulation.step());
+        REQUIRE(simulation.getLastBirthCount() == 0);
+        REQUIRE(simulation.getLastDeathCount() == 0);
+    }
+    
+    SECTION("Dying pattern reports deaths only") {
+        simulation.setCellAlive(5, 5);
+        simulation.setCellAlive(6, 5);
+        
+        REQUIRE(simulation.step());
+        REQUIRE(simulation.getLastBirthCount() == 0);
+        REQUIRE(simulation.getLastDeathCount() == 2);
+        REQUIRE(simulation.getLivingCellCount() == 0);
+    }
+    
+    SECTION("Reset clears the counts") {
+        simulation.setCellAlive(5, 5);
+        simulation.step();
+        simulation.reset();
+        REQUIRE(simulation.getLastDeathCount() == 0);
+    }
+}
+
 TEST_CASE("Neighbor counting accuracy", "[NeighborCounting]") {
     GameOfLifeSimulation simulation;
     
@@ -178,4 +223,37 @@ TEST_CASE("Neighbor counting accuracy", "[NeighborCounting]") {
         REQUIRE(simulation.getNeighborCount(0, 0) == 1);
         REQUIRE(simulation.getNeighborCount(2, 2) == 1);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Sorting cells into Z-order leaves the board unchanged", "[GameOfLifeRules]") {
+    GameConfig sortedConfig;
+    sortedConfig.setCellSortInterval(1); // Sort after every step
+    GameConfig unsortedConfig;
+    unsortedConfig.setCellSortInterval(0);
+    GameOfLifeSimulation sorted(sortedConfig);
+    GameOfLifeSimulation unsorted(unsortedConfig);
+    
+    std::mt19937 rng(36);
+    std::vector<Position> soup;
+    for (std::int32_t y = 0; y < 60; ++y) {
+        for (std::int32_t x = 0; x < 60; ++x) {
+            if (rng() % 3 == 0) {
+                soup.emplace_back(x, y);
+            }
+        }
+    }
+    sorted.setCellsAlive(soup);
+    unsorted.setCellsAlive(soup);
+    
+    auto positions = [](const GameOfLifeSimulation& simulation) {
+        auto cells = simulation.getLivingPositions();
+        std::sort(cells.begin(), cells.end());
+        return cells;
+    };
+    for (int generation = 0; generation < 50; ++generation) {
+        INFO("generation " << generation);
+        REQUIRE(sorted.step() == unsorted.step());
+        REQUIRE(positions(sorted) == positions(unsorted));
+        REQUIRE(sorted.getLastBirthCount() == unsorted.getLastBirthCount());
+    }
+}
@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include "core/GameOfLifeSimulation.h"
 #include "core/GameConfig.h"
+#include <algorithm>
+#include <vector>
 
 TEST_CASE("Grid boundary handling - non-wrapping", "[GridBoundaries]") {
     GameConfig config;
@@ -184,4 +186,50 @@ TEST_CASE("Large grid boundaries", "[GridBoundaries]") {
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
         REQUIRE(duration.count() < 100); // Should complete in under 100ms
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Region queries match per-cell lookups", "[GridBoundaries]") {
+    struct Region {
+        std::int32_t minX;
+        std::int32_t maxX;
+        std::int32_t minY;
+        std::int32_t maxY;
+    };
+
+    // Small regions take the probing path, large ones the scan; both extend past the grid
+    const std::vector<Region> regions{{-3, 4, 5, 9}, {-25, 60, -10, 45}, {10, 12, 0, 2}};
+
+    for (StorageEngine engine : {StorageEngine::Sparse, StorageEngine::Dense, StorageEngine::Tiled,
+                                 StorageEngine::HashLife}) {
+        for (bool wrap : {false, true}) {
+            GameConfig config;
+            config.setGridWidth(30);
+            config.setGridHeight(20);
+            config.setWrapEdges(wrap);
+            config.setStorageEngine(engine);
+            GameOfLifeSimulation simulation(config);
+
+            for (std::int32_t i = 0; i < 120; ++i) {
+                simulation.setCellAlive((i * 7) % 30, (i * 11) % 20);
+            }
+
+            for (const auto& region : regions) {
+                INFO("engine " << static_cast<int>(engine) << " wrap " << wrap << " region " << region.minX
+                               << ".." << region.maxX << " x " << region.minY << ".." << region.maxY);
+                std::vector<Position> expected;
+                for (std::int32_t y = region.minY; y <= region.maxY; ++y) {
+                    for (std::int32_t x = region.minX; x <= region.maxX; ++x) {
+                        if (simulation.isCellAlive(x, y)) {
+                            expected.emplace_back(x, y);
+                        }
+                    }
+                }
+
+                std::vector<Position> cells;
+                simulation.collectLivingCellsInRegion(region.minX, region.maxX, region.minY, region.maxY, cells);
+                std::sort(cells.begin(), cells.end());
+                std::sort(expected.begin(), expected.end());
+                REQUIRE(cells == expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,244 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/GameOfLifeSimulation.h"
+#include "core/HashLifeUniverse.h"
+#include "core/GameConfig.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+
+namespace {
+
+// config/gosper_gun.json
+const std::vector<Position> gosperGun = {
+    {5, 6}, {5, 7}, {6, 6}, {6, 7},
+    {15, 6}, {15, 7}, {15, 8}, {16, 5}, {16, 9}, {17, 4}, {17, 10}, {18, 4}, {18, 10},
+    {19, 7}, {20, 5}, {20, 9}, {21, 6}, {21, 7}, {21, 8}, {22, 7},
+    {25, 4}, {25, 5}, {25, 6}, {26, 4}, {26, 5}, {26, 6}, {27, 3}, {27, 7},
+    {29, 2}, {29, 3}, {29, 7}, {29, 8},
+    {39, 4}, {39, 5}, {40, 4}, {40, 5}};
+
+// patterns/acorn.json
+const std::vector<Position> acorn = {{1, 0}, {3, 1}, {0, 2}, {1, 2}, {4, 2}, {5, 2}, {6, 2}};
+
+const std::vector<Position> glider = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> livingCells(const HashLifeUniverse& universe) {
+    std::vector<Position> cells;
+    universe.collectLivingCells(cells);
+    return sorted(cells);
+}
+
+void place(HashLifeUniverse& universe, const std::vector<Position>& cells) {
+    for (const auto& pos : cells) {
+        universe.setCell(pos.x, pos.y, true);
+    }
+}
+
+} // namespace
+
+TEST_CASE("HashLife cell storage", "[HashLife]") {
+    HashLifeUniverse universe;
+
+    SECTION("The plane is unbounded in every direction") {
+        universe.setCell(0, 0, true);
+        universe.setCell(-1, -1, true);
+        universe.setCell(-1000000, 7, true);
+        universe.setCell(2000000000, -2000000000, true);
+
+        REQUIRE(universe.getLivingCellCount() == 4);
+        REQUIRE(universe.getCell(-1000000, 7));
+        REQUIRE(universe.getCell(2000000000, -2000000000));
+        REQUIRE_FALSE(universe.getCell(1, 0));
+        REQUIRE(livingCells(universe).size() == 4);
+    }
+
+    SECTION("Setting a cell twice keeps one cell") {
+        universe.setCell(3, -2, true);
+        universe.setCell(3, -2, true);
+        REQUIRE(universe.getLivingCellCount() == 1);
+
+        universe.setCell(3, -2, false);
+        universe.setCell(500, 500, false);
+        REQUIRE(universe.getLivingCellCount() == 0);
+    }
+
+    SECTION("Neighbors are counted across quadrant boundaries") {
+        universe.setCell(-1, -1, true);
+        universe.setCell(0, -1, true);
+        universe.setCell(-1, 0, true);
+
+        REQUIRE(universe.countNeighbors(0, 0) == 3);
+        REQUIRE(universe.countNeighbors(-1, -1) == 2);
+    }
+
+    SECTION("Step exponents above the maximum are rejected") {
+        REQUIRE_THROWS_AS(universe.setStepLog2(HashLifeUniverse::kMaxStepLog2 + 1), std::out_of_range);
+    }
+}
+
+TEST_CASE("HashLife matches sparse storage", "[HashLife]") {
+    // A soup in the middle of a large bounded grid never reaches the edges in 40 generations
+    GameConfig config;
+    config.setGridWidth(200);
+    config.setGridHeight(200);
+    GameOfLifeSimulation sparse(config);
+
+    config.setStorageEngine(StorageEngine::HashLife);
+    GameOfLifeSimulation hashLife(config);
+    REQUIRE(hashLife.usesHashLife());
+
+    std::mt19937 rng(11);
+    std::bernoulli_distribution alive(0.4);
+    for (std::int32_t y = 90; y < 110; ++y) {
+        for (std::int32_t x = 90; x < 110; ++x) {
+            if (alive(rng)) {
+                sparse.setCellAlive(x, y);
+                hashLife.setCellAlive(x, y);
+            }
+        }
+    }
+
+    for (int generation = 0; generation < 40; ++generation) {
+        REQUIRE(hashLife.step() == sparse.step());
+        REQUIRE(hashLife.getLivingCellCount() == sparse.getLivingCellCount());
+        REQUIRE(sorted(hashLife.getLivingPositions()) == sorted(sparse.getLivingPositions()));
+    }
+    REQUIRE(hashLife.getGenerationCount() == 40);
+    REQUIRE(hashLife.getNeighborCount(100, 100) == sparse.getNeighborCount(100, 100));
+}
+
+TEST_CASE("HashLife advances 2^k generations per step", "[HashLife]") {
+    SECTION("One large step equals many single steps") {
+        HashLifeUniverse single;
+        HashLifeUniverse batched;
+        place(single, acorn);
+        place(batched, acorn);
+
+        for (int generation = 0; generation < 256; ++generation) {
+            single.step();
+        }
+        batched.setStepLog2(8);
+        batched.step();
+
+        REQUIRE(batched.getGeneration() == 256);
+        REQUIRE(livingCells(batched) == livingCells(single));
+    }
+
+    SECTION("A glider travels one cell diagonally every four generations") {
+        HashLifeUniverse universe;
+        place(universe, glider);
+        universe.setStepLog2(20);
+
+        REQUIRE(universe.step());
+
+        std::vector<Position> expected;
+        for (const auto& pos : glider) {
+            expected.emplace_back(pos.x + (1 << 18), pos.y + (1 << 18));
+        }
+        REQUIRE(livingCells(universe) == sorted(expected));
+    }
+
+    SECTION("Still lifes report no change") {
+        HashLifeUniverse universe;
+        place(universe, {{0, 0}, {1, 0}, {0, 1}, {1, 1}});
+        universe.setStepLog2(12);
+
+        REQUIRE_FALSE(universe.step());
+        REQUIRE(universe.getLivingCellCount() == 4);
+    }
+
+    SECTION("The simulation counts every generation of a step") {
+        GameConfig config;
+        config.setStorageEngine(StorageEngine::HashLife);
+        config.setHashLifeStepLog2(6);
+        GameOfLifeSimulation simulation(config);
+        REQUIRE(simulation.getGenerationsPerStep() == 64);
+
+        for (const auto& pos : glider) {
+            simulation.setCellAlive(pos.x, pos.y);
+        }
+        simulation.step();
+        simulation.step();
+
+        REQUIRE(simulation.getGenerationCount() == 128);
+        REQUIRE(simulation.isCellAlive(1 + 32, 0 + 32));
+        REQUIRE(simulation.getLivingCellCount() == 5);
+    }
+}
+
+TEST_CASE("HashLife long-horizon runs", "[HashLife]") {
+    SECTION("Acorn stabilizes at generation 5206 with 633 cells") {
+        HashLifeUniverse universe;
+        place(universe, acorn);
+
+        universe.advance(5206);
+
+        REQUIRE(universe.getGeneration() == 5206);
+        REQUIRE(universe.getLivingCellCount() == 633);
+    }
+
+    SECTION("Diehard vanishes after 130 generations") {
+        HashLifeUniverse universe;
+        // patterns/diehard.json
+        place(universe, {{6, 0}, {0, 1}, {1, 1}, {1, 2}, {5, 2}, {6, 2}, {7, 2}});
+
+        universe.advance(129);
+        REQUIRE(universe.getLivingCellCount() > 0);
+        universe.advance(1);
+        REQUIRE(universe.getLivingCellCount() == 0);
+    }
+
+    SECTION("A million generations of the Gosper gun") {
+        HashLifeUniverse universe;
+        place(universe, gosperGun);
+        universe.setStepLog2(20);
+        universe.step();
+
+        // The gun fires one five-cell glider every 30 generations
+        std::uint64_t population = universe.getLivingCellCount();
+        universe.advance(30);
+        REQUIRE(universe.getLivingCellCount() == population + 5);
+        REQUIRE(universe.getGeneration() == (1u << 20) + 30);
+    }
+
+    SECTION("A small node limit rebuilds the store without changing the result") {
+        HashLifeUniverse reference;
+        HashLifeUniverse limited(2000);
+        place(reference, acorn);
+        place(limited, acorn);
+
+        for (int generation = 0; generation < 300; ++generation) {
+            reference.step();
+            limited.step();
+        }
+
+        REQUIRE(limited.getNodeCount() < reference.getNodeCount());
+        REQUIRE(livingCells(limited) == livingCells(reference));
+    }
+}
+
+TEST_CASE("HashLife reports the changes of an advance", "[HashLife]") {
+    // An advance spans several steps and, with a small node limit, several rebuilds
+    HashLifeUniverse universe(2000);
+    place(universe, acorn);
+    auto before = livingCells(universe);
+
+    universe.advance(1000);
+    auto after = livingCells(universe);
+
+    std::vector<Position> born;
+    std::vector<Position> died;
+    universe.collectChanges(born, died);
+
+    std::vector<Position> expectedBorn;
+    std::vector<Position> expectedDied;
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(expectedBorn));
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(expectedDied));
+    REQUIRE(sorted(born) == expectedBorn);
+    REQUIRE(sorted(died) == expectedDied);
+}
@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/HistoryJournal.h"
+#include "core/GameOfLifeSimulation.h"
+#include "core/GameConfig.h"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+GameConfig makeConfig(std::int32_t size) {
+    GameConfig config;
+    config.setGridWidth(size);
+    config.setGridHeight(size);
+    config.setWrapEdges(true);
+    config.setStorageEngine(StorageEngine::Dense);
+    return config;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+// Applies a move to a set of living cells
+void applyMove(const HistoryMove& move, std::set<Position>& board) {
+    if (move.fromEmpty) {
+        board.clear();
+    }
+    for (const auto& pos : move.flips) {
+        if (!board.erase(pos)) {
+            board.insert(pos);
+        }
+    }
+}
+
+std::vector<Position> cellsOf(const std::set<Position>& board) {
+    return {board.begin(), board.end()};
+}
+
+// Steps a random soup, journaling every step, and keeps the board of every generation
+struct Recording {
+    HistoryJournal journal;
+    std::vector<std::vector<Position>> boards;
+
+    Recording(std::size_t budget, int generations) : journal(budget) {
+        GameOfLifeSimulation simulation(makeConfig(48));
+        std::mt19937 rng(5);
+        std::bernoulli_distribution alive(0.3);
+        for (std::int32_t y = 0; y < 48; ++y) {
+            for (std::int32_t x = 0; x < 48; ++x) {
+                if (alive(rng)) {
+                    simulation.setCellAlive(x, y);
+                }
+            }
+        }
+        boards.push_back(sorted(simulation.getLivingPositions()));
+        journal.restart(0, boards.back());
+        for (int generation = 1; generation <= generations; ++generation) {
+            simulation.step();
+            journal.recordStep(simulation.getGenerationCount(), simulation.getBornCells(), simulation.getDiedCells());
+            boards.push_back(sorted(simulation.getLivingPositions()));
+            if (journal.keyframeDue()) {
+                journal.recordKeyframe(boards.back());
+            }
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("History journal steps back through every generation", "[HistoryJournal]") {
+    Recording recording(std::size_t{1} << 24, 300);
+    auto& journal = recording.journal;
+    REQUIRE(journal.getOldestGeneration() == 0);
+    REQUIRE(journal.getNewestGeneration() == 300);
+    REQUIRE(journal.getKeyframeCount() == 1 + 300 / HistoryJournal::kKeyframeInterval);
+
+    std::set<Position> board(recording.boards.back().begin(), recording.boards.back().end());
+    for (std::uint64_t generation = 300; generation > 0; --generation) {
+        const auto move = journal.stepBack();
+        REQUIRE(move);
+        REQUIRE(move->generation == generation - 1);
+        REQUIRE_FALSE(move->fromEmpty); // One step's flips are always cheaper than a keyframe
+        applyMove(*move, board);
+        REQUIRE(cellsOf(board) == recording.boards[generation - 1]);
+    }
+    REQUIRE_FALSE(journal.stepBack());
+    REQUIRE(journal.isRewound());
+}
+
+TEST_CASE("History journal seeks in both directions", "[HistoryJournal]") {
+    Recording recording(std::size_t{1} << 24, 300);
+    auto& journal = recording.journal;
+    std::set<Position> board(recording.boards.back().begin(), recording.boards.back().end());
+
+    // Far jumps start from a keyframe, near ones toggle the steps between
+    bool usedKeyframe = false;
+    for (std::uint64_t target : {5u, 250u, 251u, 129u, 300u, 0u, 300u, 140u}) {
+        const auto move = journal.seek(target);
+        REQUIRE(move);
+        REQUIRE(move->generation == target);
+        usedKeyframe = usedKeyframe || move->fromEmpty;
+        applyMove(*move, board);
+        REQUIRE(cellsOf(board) == recording.boards[target]);
+        REQUIRE(journal.getCurrentGeneration() == target);
+    }
+    REQUIRE(usedKeyframe);
+
+    // Past either end it stops at the entry there is
+    REQUIRE(journal.seek(1000)->generation == 300);
+    REQUIRE(journal.seek(0)->generation == 0);
+}
+
+TEST_CASE("History journal keeps to its byte budget", "[HistoryJournal]") {
+    Recording unbounded(std::size_t{1} << 24, 600);
+    const std::size_t budget = unbounded.journal.getByteCount() / 3;
+    Recording bounded(budget, 600);
+    auto& journal = bounded.journal;
+
+    REQUIRE(journal.getByteCount() <= budget);
+    REQUIRE(journal.getNewestGeneration() == 600);
+    REQUIRE(journal.getOldestGeneration() > 0);
+    REQUIRE(journal.getOldestGeneration() % HistoryJournal::kKeyframeInterval == 0); // A keyframe is oldest
+
+    // Every generation still kept comes back exactly
+    std::set<Position> board(bounded.boards.back().begin(), bounded.boards.back().end());
+    const auto oldest = journal.getOldestGeneration();
+    applyMove(*journal.seek(oldest), board);
+    REQUIRE(cellsOf(board) == bounded.boards[oldest]);
+    REQUIRE_FALSE(journal.stepBack());
+
+    // A budget too small for one stretch keeps just the newest steps
+    Recording tiny(1, 40);
+    REQUIRE(tiny.journal.getEntryCount() <= 2);
+    REQUIRE(tiny.journal.getNewestGeneration() == 40);
+
+    // No budget, no journal
+    Recording disabled(0, 10);
+    REQUIRE_FALSE(disabled.journal.isEnabled());
+    REQUIRE(disabled.journal.empty());
+    REQUIRE_FALSE(disabled.journal.seek(3));
+}
+
+TEST_CASE("History journal folds edits into the current step", "[HistoryJournal]") {
+    HistoryJournal journal(1 << 20);
+    const std::vector<Position> start{{1, 1}, {2, 1}};
+    journal.restart(10, start);
+    journal.recordStep(11, std::vector<Position>{{5, 5}}, std::vector<Position>{{1, 1}});
+    journal.recordStep(12, std::vector<Position>{{6, 6}}, {});
+
+    // Stepping back and editing drops the step after
+    std::set<Position> board{{2, 1}, {5, 5}, {6, 6}};
+    applyMove(*journal.stepBack(), board);
+    REQUIRE(cellsOf(board) == std::vector<Position>{{2, 1}, {5, 5}});
+    journal.recordEdit(std::vector<Position>{{9, 9}});
+    board.insert({9, 9});
+    REQUIRE(journal.getNewestGeneration() == 11);
+    REQUIRE_FALSE(journal.isRewound());
+
+    // The edit comes and goes with its step
+    applyMove(*journal.stepBack(), board);
+    REQUIRE(cellsOf(board) == start);
+    applyMove(*journal.seek(11), board);
+    REQUIRE(cellsOf(board) == sorted({{2, 1}, {5, 5}, {9, 9}}));
+
+    // Edits on a keyframe reach it too, so a jump from it sees them
+    applyMove(*journal.seek(10), board);
+    journal.recordEdit(std::vector<Position>{{2, 1}, {3, 3}});
+    board = std::set<Position>{{1, 1}, {3, 3}};
+    journal.recordStep(13, std::vector<Position>{{4, 4}}, {});
+    board.insert({4, 4});
+    applyMove(*journal.seek(10), board);
+    REQUIRE(cellsOf(board) == sorted({{1, 1}, {3, 3}}));
+}
@@ -0,0 +1,184 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/DenseKernels.h"
+#include "core/GameConfig.h"
+#include "core/LifeEngine.h"
+#include "core/LifeRule.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool bitAt(const std::vector<std::uint64_t>& row, std::int64_t x) {
+    // Guard word at index 0, data from index 1
+    return (row[static_cast<std::size_t>(x >> 6) + 1] >> (x & 63)) & 1u;
+}
+
+// Per-cell reference for one row of guarded words under any rule
+std::vector<std::uint64_t> referenceRow(const std::vector<std::uint64_t>& above, const std::vector<std::uint64_t>& row,
+                                        const std::vector<std::uint64_t>& below, std::size_t words,
+                                        const LifeRule& rule) {
+    std::vector<std::uint64_t> out(words, 0);
+    const std::vector<std::uint64_t>* rows[3] = {&above, &row, &below};
+
+    for (std::int64_t x = 0; x < static_cast<std::int64_t>(words * 64); ++x) {
+        std::uint32_t neighbors = 0;
+        for (int r = 0; r < 3; ++r) {
+            for (std::int64_t dx = -1; dx <= 1; ++dx) {
+                if (r == 1 && dx == 0) continue;
+                neighbors += bitAt(*rows[r], x + dx) ? 1 : 0;
+            }
+        }
+        if (rule.nextState(bitAt(row, x), neighbors)) {
+            out[static_cast<std::size_t>(x >> 6)] |= std::uint64_t{1} << (x & 63);
+        }
+    }
+    return out;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+// Specialized rules, and two only the run-time masks handle (one with S0)
+const std::vector<LifeRule> kTestRules = {kConwayRule, kHighLifeRule, kDayAndNightRule, kSeedsRule,
+                                          *LifeRule::parse("B36/S125"), *LifeRule::parse("B3/S012345678")};
+
+} // namespace
+
+TEST_CASE("Rulestrings parse in B/S and S/B notation", "[LifeRule]") {
+    REQUIRE(LifeRule::parse("B3/S23") == kConwayRule);
+    REQUIRE(LifeRule::parse("b3/s23") == kConwayRule);
+    REQUIRE(LifeRule::parse("S23/B3") == kConwayRule);
+    REQUIRE(LifeRule::parse("23/3") == kConwayRule);
+    REQUIRE(LifeRule::parse(" B36/S23 ") == kHighLifeRule);
+    REQUIRE(LifeRule::parse("B3678/S34678") == kDayAndNightRule);
+    REQUIRE(LifeRule::parse("B2/S") == kSeedsRule);
+
+    REQUIRE(kHighLifeRule.toString() == "B36/S23");
+    REQUIRE(kSeedsRule.toString() == "B2/S");
+    REQUIRE(LifeRule::parse("S8/B1")->toString() == "B1/S8");
+
+    REQUIRE_FALSE(LifeRule::parse(""));
+    REQUIRE_FALSE(LifeRule::parse("B3S23"));
+    REQUIRE_FALSE(LifeRule::parse("B9/S23"));
+    REQUIRE_FALSE(LifeRule::parse("B3/S2x"));
+    REQUIRE_FALSE(LifeRule::parse("B03/S23")); // B0 is unsupported
+}
+
+TEST_CASE("Config files carry the rule", "[LifeRule]") {
+    GameConfig config;
+    REQUIRE(config.getRule() == kConwayRule);
+
+    config.setRule(kHighLifeRule);
+    REQUIRE(config.toJson()["simulation"]["rule"] == "B36/S23");
+
+    GameConfig loaded;
+    loaded.fromJson(config.toJson());
+    REQUIRE(loaded.getRule() == kHighLifeRule);
+
+    auto json = config.toJson();
+    json["simulation"]["rule"] = "B0/S";
+    GameConfig invalid;
+    REQUIRE_THROWS_AS(invalid.fromJson(json), std::runtime_error);
+}
+
+TEST_CASE("Dense rule kernels match a per-cell reference", "[LifeRule]") {
+    std::mt19937_64 rng(2024);
+
+    for (const auto& kernel : availableDenseKernels()) {
+        for (const auto& rule : kTestRules) {
+            INFO(kernel.name << " " << rule.toString());
+            // Word counts cover the vector body, the scalar tail, and both together
+            for (std::size_t words : {1u, 3u, 4u, 5u}) {
+                for (int trial = 0; trial < 10; ++trial) {
+                    std::vector<std::uint64_t> rows[3];
+                    for (auto& row : rows) {
+                        row.assign(words + 2, 0);
+                        for (std::size_t w = 1; w <= words; ++w) {
+                            row[w] = (trial % 2 == 0) ? rng() : (rng() & rng() & rng());
+                        }
+                    }
+
+                    std::vector<std::uint64_t> out(words, 0);
+                    kernel.stepRowRule(rows[0].data() + 1, rows[1].data() + 1, rows[2].data() + 1, out.data(), words,
+                                       rule);
+                    REQUIRE(out == referenceRow(rows[0], rows[1], rows[2], words, rule));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Every engine follows the configured rule", "[LifeRule]") {
+    std::mt19937 rng(7);
+    std::vector<Position> soup;
+    for (std::int32_t y = 40; y < 60; ++y) {
+        for (std::int32_t x = 40; x < 60; ++x) {
+            if (rng() % 3 == 0) {
+                soup.emplace_back(x, y);
+            }
+        }
+    }
+
+    for (const auto& rule : kTestRules) {
+        for (bool wrap : {false, true}) {
+            GameConfig config;
+            config.setGridWidth(100);
+            config.setGridHeight(90);
+            config.setWrapEdges(wrap);
+            config.setRule(rule);
+            config.setAdaptiveStorage(false);
+
+            auto reference = createLifeEngine(config);
+            reference->setCellsAlive(soup);
+
+            std::vector<std::unique_ptr<LifeEngine>> engines;
+            // HashLife's and the chunked plane are unbounded, so they only join while nothing reaches an edge
+            for (StorageEngine engine : {StorageEngine::Dense, StorageEngine::Tiled, StorageEngine::Packed,
+                                         StorageEngine::HashLife, StorageEngine::Chunked}) {
+                config.setStorageEngine(engine);
+                engines.push_back(createLifeEngine(config));
+                engines.back()->setCellsAlive(soup);
+            }
+
+            for (int generation = 0; generation < 8; ++generation) {
+                const bool changed = reference->step();
+                const auto expected = sorted(reference->getLivingPositions());
+                for (const auto& engine : engines) {
+                    INFO(rule.toString() << " wrap " << wrap << " "
+                                         << storageEngineName(engine->getConfig().getStorageEngine()));
+                    REQUIRE(engine->step() == changed);
+                    REQUIRE(sorted(engine->getLivingPositions()) == expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Seeds and HighLife differ from Conway", "[LifeRule]") {
+    GameConfig config;
+    config.setRule(kSeedsRule);
+
+    // Under Seeds a domino dies and gives birth above and below itself
+    auto seeds = createLifeEngine(config);
+    seeds->setCellsAlive(std::vector<Position>{{10, 10}, {11, 10}});
+    seeds->step();
+    REQUIRE(sorted(seeds->getLivingPositions()) == std::vector<Position>{{10, 9}, {10, 11}, {11, 9}, {11, 11}});
+
+    // Six neighbors: a birth under HighLife only
+    const std::vector<Position> six = {{9, 9}, {10, 9}, {11, 9}, {9, 11}, {10, 11}, {11, 11}};
+    config.setRule(kHighLifeRule);
+    auto highLife = createLifeEngine(config);
+    highLife->setCellsAlive(six);
+    highLife->step();
+    REQUIRE(highLife->isCellAlive(10, 10));
+
+    config.setRule(kConwayRule);
+    auto conway = createLifeEngine(config);
+    conway->setCellsAlive(six);
+    conway->step();
+    REQUIRE_FALSE(conway->isCellAlive(10, 10));
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/Metrics.h"
+#include "core/SimulationStore.h"
+#include "core/GameConfig.h"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("LatencyHistogram quantiles stay within a bucket of the truth", "[Metrics]") {
+    LatencyHistogram histogram;
+    REQUIRE(histogram.getQuantile(0.99) == 0);
+
+    // 1us .. 1ms in 1us steps; the true p-quantile is p * 1000us
+    for (std::uint64_t i = 1; i <= 1000; ++i) {
+        histogram.record(i * 1000);
+    }
+    REQUIRE(histogram.getCount() == 1000);
+    REQUIRE(histogram.getMax() == 1'000'000);
+    REQUIRE(histogram.getSum() == 500'500'000);
+
+    for (double quantile : {0.5, 0.9, 0.99, 0.999}) {
+        const double truth = quantile * 1'000'000;
+        const auto value = static_cast<double>(histogram.getQuantile(quantile));
+        REQUIRE(value >= truth);
+        REQUIRE(value <= truth * (1.0 + 1.0 / LatencyHistogram::kSubBuckets));
+    }
+    REQUIRE(histogram.getQuantile(1.0) == 1'000'000);
+
+    // Small values are exact
+    histogram.reset();
+    histogram.record(std::chrono::nanoseconds(7));
+    REQUIRE(histogram.getQuantile(0.5) == 7);
+    REQUIRE(histogram.getCount() == 1);
+}
+
+TEST_CASE("Metrics export as Prometheus text and JSON", "[Metrics]") {
+    SimulationMetrics metrics;
+    metrics.stepNanos.record(std::chrono::microseconds(250));
+    metrics.recordChanges(5, 3);
+    metrics.livingCells = 42;
+
+    const LabelledMetrics simulations[] = {{"board \"a\"", &metrics}};
+    std::ostringstream out;
+    writePrometheusMetrics(out, simulations);
+    const std::string text = out.str();
+    REQUIRE(text.find("# TYPE gol_step_duration_seconds summary\n") != std::string::npos);
+    REQUIRE(text.find("gol_step_duration_seconds{simulation=\"board \\\"a\\\"\",quantile=\"0.999\"} 0.00025") !=
+            std::string::npos);
+    REQUIRE(text.find("gol_step_duration_seconds_count{simulation=\"board \\\"a\\\"\"} 1\n") != std::string::npos);
+    REQUIRE(text.find("gol_births_total{simulation=\"board \\\"a\\\"\"} 5\n") != std::string::npos);
+    REQUIRE(text.find("gol_deaths_total{simulation=\"board \\\"a\\\"\"} 3\n") != std::string::npos);
+    REQUIRE(text.find("gol_living_cells{simulation=\"board \\\"a\\\"\"} 42\n") != std::string::npos);
+    REQUIRE(text.find("process_resident_memory_bytes ") != std::string::npos);
+
+    const auto json = metricsToJson(simulations);
+    const auto& board = json["simulations"]["board \"a\""];
+    REQUIRE(board["step"]["count"] == 1);
+    REQUIRE(board["step"]["p99_ns"] == 250'000);
+    REQUIRE(board["births"] == 5);
+    REQUIRE(board["living_cells"] == 42);
+#if defined(__linux__)
+    REQUIRE(json["process"]["resident_memory_bytes"].get<std::uint64_t>() > 0);
+#endif
+}
+
+TEST_CASE("lockCounted counts only contended acquisitions", "[Metrics]") {
+    std::mutex mutex;
+    SimulationMetrics metrics;
+    { auto lock = lockCounted(mutex, metrics); }
+    REQUIRE(metrics.lockWaits == 0);
+
+    std::unique_lock held(mutex);
+    std::thread waiter([&] { auto lock = lockCounted(mutex, metrics); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    held.unlock();
+    waiter.join();
+    REQUIRE(metrics.lockWaits == 1);
+    REQUIRE(metrics.lockWaitNanos > 0);
+}
+
+TEST_CASE("SimulationSession records steps, changes and reads", "[Metrics]") {
+    SimulationStore store(GameConfig{}, ".");
+    auto session = store.create(16, 16, "");
+    const std::vector<Position> blinker{{1, 2}, {2, 2}, {3, 2}};
+    session->addPattern(blinker, Position(0, 0));
+
+    session->step(1);
+    session->step(3);
+    session->snapshot();
+
+    const auto& metrics = session->getMetrics();
+    REQUIRE(metrics.stepNanos.getCount() == 4);
+    REQUIRE(metrics.queryNanos.getCount() == 1);
+    // Each blinker flip is two births and two deaths; three flips net out to one
+    REQUIRE(metrics.births == 4);
+    REQUIRE(metrics.deaths == 4);
+    REQUIRE(metrics.livingCells == 3);
+    REQUIRE(store.list().size() == 1);
+}
+
+TEST_CASE("MetricsFileWriter replaces the file on each write", "[Metrics]") {
+    const auto path = (std::filesystem::temp_directory_path() / "entt_gol_metrics.prom").string();
+    std::filesystem::remove(path);
+    REQUIRE(MetricsFileWriter::isPrometheusPath(path));
+    REQUIRE_FALSE(MetricsFileWriter::isPrometheusPath("metrics.json"));
+
+    int writes = 0;
+    {
+        MetricsFileWriter writer(path, std::chrono::hours(1), [&writes](std::ostream& out) {
+            out << "gol_writes " << ++writes << "\n";
+        });
+        writer.writeNow();
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        REQUIRE(line == "gol_writes 1");
+    }
+    // Written once more on destruction
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    REQUIRE(line == "gol_writes 2");
+    REQUIRE_FALSE(std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,132 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/GameOfLifeSimulation.h"
+#include "core/PackedLiveSet.h"
+#include "core/GameConfig.h"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+namespace {
+
+GameConfig makeConfig(std::int32_t width, std::int32_t height, bool wrap, StorageEngine engine) {
+    GameConfig config;
+    config.setGridWidth(width);
+    config.setGridHeight(height);
+    config.setWrapEdges(wrap);
+    config.setStorageEngine(engine);
+    return config;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+} // namespace
+
+TEST_CASE("PackedLiveSet cell access", "[PackedLiveSet]") {
+    PackedLiveSet cells(100, 50, false);
+
+    const std::vector<Position> pattern{{3, 4}, {99, 49}, {0, 0}, {3, 4}, {50, 0}};
+    cells.setCellsAlive(pattern);
+    REQUIRE(cells.getLivingCellCount() == 4);
+    REQUIRE(cells.getCell(3, 4));
+    REQUIRE(cells.getCell(99, 49));
+    REQUIRE_FALSE(cells.getCell(4, 3));
+
+    cells.setCell(3, 4, false);
+    cells.setCell(3, 4, false);
+    cells.setCell(1, 1, true);
+    REQUIRE(cells.getLivingCellCount() == 4);
+    REQUIRE_FALSE(cells.getCell(3, 4));
+    REQUIRE(cells.countNeighbors(0, 1) == 2);
+
+    cells.clear();
+    REQUIRE(cells.getLivingCellCount() == 0);
+}
+
+TEST_CASE("Packed storage matches sparse storage", "[PackedLiveSet]") {
+    struct Scenario {
+        std::int32_t width;
+        std::int32_t height;
+        bool wrap;
+        double density;
+    };
+
+    // Edge wrapping both ways, one-column grids, and boards big enough for the radix sort
+    const std::vector<Scenario> scenarios{
+        {64, 48, false, 0.3}, {64, 48, true, 0.3}, {1, 30, true, 0.5}, {200, 3, false, 0.5}, {300, 300, true, 0.05}};
+
+    for (const auto& scenario : scenarios) {
+        INFO("grid " << scenario.width << "x" << scenario.height << " wrap " << scenario.wrap);
+
+        GameOfLifeSimulation sparse(makeConfig(scenario.width, scenario.height, scenario.wrap,
+                                               StorageEngine::Sparse));
+        GameOfLifeSimulation packed(makeConfig(scenario.width, scenario.height, scenario.wrap,
+                                               StorageEngine::Packed));
+        REQUIRE(packed.usesPackedStorage());
+
+        std::mt19937 rng(7);
+        std::bernoulli_distribution alive(scenario.density);
+        std::vector<Position> pattern;
+        for (std::int32_t y = 0; y < scenario.height; ++y) {
+            for (std::int32_t x = 0; x < scenario.width; ++x) {
+                if (alive(rng)) {
+                    pattern.emplace_back(x, y);
+                }
+            }
+        }
+        sparse.setCellsAlive(pattern);
+        packed.setCellsAlive(pattern);
+
+        for (int generation = 0; generation < 30; ++generation) {
+            REQUIRE(packed.step() == sparse.step());
+            REQUIRE(packed.getLivingCellCount() == sparse.getLivingCellCount());
+            REQUIRE(sorted(packed.getLivingPositions()) == sorted(sparse.getLivingPositions()));
+            REQUIRE(sorted(packed.getBornCells()) == sorted(sparse.getBornCells()));
+            REQUIRE(sorted(packed.getDiedCells()) == sorted(sparse.getDiedCells()));
+        }
+
+        // Viewport queries, including wrapped copies beyond the grid
+        for (const auto& [minX, maxX, minY, maxY] : {std::array<std::int32_t, 4>{-5, 20, -5, 20},
+                                                     std::array<std::int32_t, 4>{-130, 140, 2, 2},
+                                                     std::array<std::int32_t, 4>{0, 310, 0, 310},
+                                                     std::array<std::int32_t, 4>{10, 10, -700, 700}}) {
+            INFO("region " << minX << ".." << maxX << " x " << minY << ".." << maxY);
+            std::vector<Position> expected;
+            std::vector<Position> actual;
+            sparse.collectLivingCellsInRegion(minX, maxX, minY, maxY, expected);
+            packed.collectLivingCellsInRegion(minX, maxX, minY, maxY, actual);
+            REQUIRE(sorted(actual) == sorted(expected));
+        }
+    }
+}
+
+TEST_CASE("Packed storage creates entities on request", "[PackedLiveSet]") {
+    GameOfLifeSimulation simulation(makeConfig(20, 20, true, StorageEngine::Packed));
+    simulation.setCellAlive(5, 4);
+    simulation.setCellAlive(5, 5);
+    simulation.setCellAlive(5, 6);
+    std::size_t entityCount = 0;
+    simulation.getRegistry().view<Position>().each([&entityCount](auto...) { entityCount++; });
+    REQUIRE(entityCount == 0);
+
+    auto entity = simulation.getEntityAt(5, 5);
+    REQUIRE(entity != entt::entity{entt::null});
+    REQUIRE(simulation.getEntityAt(25, 25) == entity); // Wrapped lookup, same entity
+    REQUIRE(simulation.getEntityAt(6, 5) == entt::entity{entt::null});
+
+    const auto& registry = simulation.getRegistry();
+    REQUIRE(registry.get<Position>(entity) == Position(5, 5));
+    REQUIRE(registry.get<Cell>(entity) == Cell(true, 2));
+
+    // The blinker flips, so the handed-out entities go away
+    simulation.step();
+    REQUIRE_FALSE(simulation.getRegistry().valid(entity));
+    REQUIRE(simulation.getEntityAt(5, 4) == entt::entity{entt::null});
+    REQUIRE(simulation.getEntityAt(4, 5) != entt::entity{entt::null});
+
+    simulation.reset();
+    REQUIRE(simulation.getEntityAt(4, 5) == entt::entity{entt::null});
+}
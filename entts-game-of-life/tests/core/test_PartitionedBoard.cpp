@@ -0,0 +1,189 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/PartitionedBoard.h"
+#include "core/GameOfLifeSimulation.h"
+#include "core/GameConfig.h"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+GameConfig makeConfig(std::int32_t width, std::int32_t height, bool wrap, const LifeRule& rule = kConwayRule) {
+    GameConfig config;
+    config.setGridWidth(width);
+    config.setGridHeight(height);
+    config.setWrapEdges(wrap);
+    config.setStorageEngine(StorageEngine::Dense);
+    config.setWorkerThreads(1);
+    config.setRule(rule);
+    return config;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> randomCells(std::int32_t width, std::int32_t height, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution alive(0.35);
+    std::vector<Position> cells;
+    for (std::int32_t y = 0; y < height; ++y) {
+        for (std::int32_t x = 0; x < width; ++x) {
+            if (alive(rng)) {
+                cells.emplace_back(x, y);
+            }
+        }
+    }
+    return cells;
+}
+
+// Runs fn on a thread per rank, each with its own board
+std::vector<PartitionStepResult> runRanks(const GameConfig& config, std::uint32_t ranks, std::int32_t haloDepth,
+                                          const std::vector<Position>& cells, std::uint64_t generations,
+                                          std::vector<Position>& living) {
+    InProcessHaloNetwork network(ranks);
+    std::vector<std::unique_ptr<PartitionedBoard>> boards;
+    for (std::uint32_t rank = 0; rank < ranks; ++rank) {
+        boards.push_back(std::make_unique<PartitionedBoard>(config, network.getTransport(rank), haloDepth));
+        boards.back()->setCellsAlive(cells);
+    }
+
+    std::vector<PartitionStepResult> results(ranks);
+    std::vector<std::thread> threads;
+    for (std::uint32_t rank = 0; rank < ranks; ++rank) {
+        threads.emplace_back([&, rank] { results[rank] = boards[rank]->advance(generations); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    living.clear();
+    for (const auto& board : boards) {
+        board->collectLivingCells(living);
+    }
+    return results;
+}
+
+} // namespace
+
+TEST_CASE("Slabs split the rows evenly", "[PartitionedBoard]") {
+    REQUIRE(slabBounds(10, 1, 0).firstRow == 0);
+    REQUIRE(slabBounds(10, 1, 0).rows == 10);
+
+    // 10 rows over 4 ranks: 3, 3, 2, 2
+    std::int32_t next = 0;
+    for (std::uint32_t rank = 0; rank < 4; ++rank) {
+        const auto slab = slabBounds(10, 4, rank);
+        REQUIRE(slab.firstRow == next);
+        REQUIRE(slab.rows == (rank < 2 ? 3 : 2));
+        next += slab.rows;
+    }
+    REQUIRE(next == 10);
+}
+
+TEST_CASE("Partitioned boards match one board", "[PartitionedBoard]") {
+    struct Scenario {
+        std::int32_t width;
+        std::int32_t height;
+        bool wrap;
+        LifeRule rule;
+    };
+
+    // Whole-word and ragged widths; the ragged wrapped grid steps one generation at a time locally
+    const std::vector<Scenario> scenarios{{128, 60, true, kConwayRule},
+                                          {128, 60, false, kConwayRule},
+                                          {100, 45, true, kConwayRule},
+                                          {70, 40, false, kHighLifeRule}};
+
+    for (const auto& scenario : scenarios) {
+        const auto config = makeConfig(scenario.width, scenario.height, scenario.wrap, scenario.rule);
+        const auto cells = randomCells(scenario.width, scenario.height, 3);
+
+        GameOfLifeSimulation reference(config);
+        reference.setCellsAlive(cells);
+        reference.advance(30);
+        const auto expected = sorted(reference.getLivingPositions());
+
+        for (std::uint32_t ranks : {1u, 2u, 3u, 5u}) {
+            for (std::int32_t haloDepth : {1, 4, 8}) {
+                INFO("board " << scenario.width << "x" << scenario.height << " wrap " << scenario.wrap << ", "
+                              << ranks << " ranks, halo " << haloDepth);
+                std::vector<Position> living;
+                const auto results = runRanks(config, ranks, haloDepth, cells, 30, living);
+                REQUIRE(sorted(living) == expected);
+                for (const auto& result : results) {
+                    REQUIRE(result.generations == 30);
+                    REQUIRE(result.livingCells == expected.size());
+                    REQUIRE(result.changed);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Partitioned boards stop together once settled", "[PartitionedBoard]") {
+    const auto config = makeConfig(64, 48, false);
+
+    // A block straddling the first slab edge and a blinker on the last slab
+    const std::vector<Position> cells{{10, 15}, {11, 15}, {10, 16}, {11, 16}, {30, 40}, {31, 40}, {32, 40}};
+    std::vector<Position> living;
+
+    // Period 2 divides a block of 2 generations, so the first block changes nothing
+    auto results = runRanks(config, 3, 2, cells, 1000, living);
+    for (const auto& result : results) {
+        REQUIRE(result.generations == 2);
+        REQUIRE_FALSE(result.changed);
+        REQUIRE(result.livingCells == 7);
+    }
+    REQUIRE(sorted(living) == sorted(cells));
+
+    // With odd blocks the blinker keeps every rank going
+    results = runRanks(config, 3, 3, cells, 31, living);
+    for (const auto& result : results) {
+        REQUIRE(result.generations == 31);
+        REQUIRE(result.changed);
+    }
+    REQUIRE(sorted(living) == sorted({{10, 15}, {11, 15}, {10, 16}, {11, 16}, {31, 39}, {31, 40}, {31, 41}}));
+}
+
+TEST_CASE("Partitioned boards hold only their slab", "[PartitionedBoard]") {
+    const auto config = makeConfig(64, 20, true);
+    InProcessHaloNetwork network(2);
+    PartitionedBoard top(config, network.getTransport(0), 3);
+    PartitionedBoard bottom(config, network.getTransport(1), 3);
+    REQUIRE(top.getSlab().firstRow == 0);
+    REQUIRE(bottom.getSlab().firstRow == 10);
+
+    for (auto* board : {&top, &bottom}) {
+        board->setCellAlive(5, 2);
+        board->setCellAlive(-1, 25); // Wraps to (63, 5)
+        board->setCellAlive(7, 12);
+    }
+    REQUIRE(top.getSlabLivingCellCount() == 2);
+    REQUIRE(top.isCellAlive(63, 5));
+    REQUIRE_FALSE(top.isCellAlive(7, 12));
+    REQUIRE(bottom.getSlabLivingCellCount() == 1);
+    REQUIRE(bottom.isCellAlive(7, 12));
+
+    // Slabs thinner than the halo, or more ranks than rows, are refused
+    InProcessHaloNetwork crowded(8);
+    REQUIRE_THROWS_AS(PartitionedBoard(config, crowded.getTransport(0), 3), std::invalid_argument);
+    REQUIRE_THROWS_AS(PartitionedBoard(config, network.getTransport(0), 0), std::invalid_argument);
+    InProcessHaloNetwork tooMany(21);
+    REQUIRE_THROWS_AS(PartitionedBoard(config, tooMany.getTransport(0), 1), std::invalid_argument);
+}
+
+TEST_CASE("Halo mailboxes give up after their timeout", "[PartitionedBoard]") {
+    HaloMailbox mailbox(std::chrono::milliseconds{20});
+    mailbox.deliver({4, 1, true, {7, 8}});
+    REQUIRE(mailbox.receive(1, true, 4).words == std::vector<std::uint64_t>{7, 8});
+    REQUIRE_THROWS_AS(mailbox.receive(1, true, 4), std::runtime_error); // Received once
+    REQUIRE_THROWS_AS(mailbox.receive(2, false, 5), std::runtime_error);
+
+    ReductionBarrier barrier(2, std::chrono::milliseconds{20});
+    REQUIRE_THROWS_AS(barrier.contribute(0, {5, false}), std::runtime_error);
+}
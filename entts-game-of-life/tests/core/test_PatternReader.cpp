@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/PatternReader.h"
+#include "core/GameOfLifeSimulation.h"
+#include "core/GameConfig.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using PatternReaderFn = void (*)(std::istream&, const PatternRunCallback&, const LifeRule&);
+
+std::vector<Position> readCells(PatternReaderFn reader, const std::string& text, const LifeRule& rule = kConwayRule) {
+    std::istringstream in(text);
+    std::vector<Position> cells;
+    reader(in, [&cells](std::int32_t x, std::int32_t y, std::uint32_t length) {
+        for (std::uint32_t i = 0; i < length; ++i) {
+            cells.emplace_back(x + static_cast<std::int32_t>(i), y);
+        }
+    }, rule);
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+const std::vector<Position> kGlider = sorted({{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}});
+
+} // namespace
+
+TEST_CASE("Pattern formats follow the file extension", "[PatternReader]") {
+    REQUIRE(patternFormatFromPath("patterns/glider.json") == PatternFormat::Json);
+    REQUIRE(patternFormatFromPath("breeder.rle") == PatternFormat::Rle);
+    REQUIRE(patternFormatFromPath("BREEDER.RLE") == PatternFormat::Rle);
+    REQUIRE(patternFormatFromPath("metapixel.mc") == PatternFormat::Macrocell);
+    REQUIRE(patternFormatFromPath("notes.txt") == PatternFormat::Json);
+}
+
+TEST_CASE("RLE patterns decode", "[PatternReader]") {
+    REQUIRE(readCells(readRlePattern, "#N Glider\n#C A comment\nx = 3, y = 3, rule = B3/S23\nbob$2bo$3o!\n") == kGlider);
+
+    // CRLF line ends, items split across lines, blank rows and a trailing comment
+    REQUIRE(readCells(readRlePattern, "x = 4, y = 4\r\n2o\r\n2b2o2$\r\n3o!ignored") ==
+            sorted({{0, 0}, {1, 0}, {4, 0}, {5, 0}, {0, 2}, {1, 2}, {2, 2}}));
+
+    // #P moves the top-left corner
+    REQUIRE(readCells(readRlePattern, "#P -10 20\nx = 3, y = 1, rule = 23/3\n3o!") ==
+            sorted({{-10, 20}, {-9, 20}, {-8, 20}}));
+
+    // Long runs come through as one run
+    std::istringstream in("x = 1000, y = 1\n600o400o!");
+    std::vector<std::uint32_t> lengths;
+    readRlePattern(in, [&lengths](std::int32_t, std::int32_t, std::uint32_t length) { lengths.push_back(length); });
+    REQUIRE(lengths == std::vector<std::uint32_t>{1000});
+
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "bob$2bo$3o!"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "x = 3, y = 3, rule = B36/S23\n3o!"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "x = 3, y = 3\n3o%!"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "x = 1, y = 1\n2147483648o!"), std::runtime_error);
+}
+
+TEST_CASE("Macrocell patterns decode", "[PatternReader]") {
+    // An 8x8 leaf holding a glider in the south-east quadrant of a 16x16 root
+    REQUIRE(readCells(readMacrocellPattern, "[M2] (golly 4.2)\n#R B3/S23\n.*$..*$***$\n4 0 0 0 1\n") == kGlider);
+
+    // Shared subtrees are expanded at every reference
+    REQUIRE(readCells(readMacrocellPattern, "[M2]\n*$\n4 1 0 0 1\n5 0 2 2 0\n") ==
+            sorted({{0, -16}, {8, -8}, {-16, 0}, {-8, 8}}));
+
+    // Level-1 nodes hold cell states
+    REQUIRE(readCells(readMacrocellPattern, "[M2]\n1 1 0 0 1\n2 1 0 0 1\n") ==
+            sorted({{-2, -2}, {-1, -1}, {0, 0}, {1, 1}}));
+
+    REQUIRE(readCells(readMacrocellPattern, "[M2]\n").empty());
+
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, "x = 3, y = 3\n3o!"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, "[M2]\n*$\n4 2 0 0 0\n"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, "[M2]\n*$\n5 1 0 0 0\n"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, "[M2]\n*********$\n"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, "[M2]\n#R B36/S23\n*$\n"), std::runtime_error);
+}
+
+TEST_CASE("Patterns are read for the simulation's rule", "[PatternReader]") {
+    const std::string highLifeRle = "x = 3, y = 1, rule = b36/s23\n3o!";
+    const std::string highLifeMc = "[M2]\n#R 23/36\n1 1 1 0 0\n";
+    REQUIRE(readCells(readRlePattern, highLifeRle, kHighLifeRule) == sorted({{0, 0}, {1, 0}, {2, 0}}));
+    REQUIRE(readCells(readMacrocellPattern, highLifeMc, kHighLifeRule) == sorted({{-1, -1}, {0, -1}}));
+    REQUIRE_THROWS_AS(readCells(readRlePattern, highLifeRle), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, highLifeMc), std::runtime_error);
+
+    // Conway files do not run under another rule; files without one run under any
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "x = 3, y = 1, rule = B3/S23\n3o!", kHighLifeRule),
+                      std::runtime_error);
+    REQUIRE(readCells(readRlePattern, "x = 3, y = 1\n3o!", kSeedsRule).size() == 3);
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "x = 3, y = 1, rule = B3/S23/G4\n3o!"), std::runtime_error);
+}
+
+TEST_CASE("Decoded patterns load into every storage engine", "[PatternReader]") {
+    std::istringstream in("#P 10 10\nx = 3, y = 3, rule = B3/S23\nbob$2bo$3o!\n");
+    std::vector<Position> cells;
+    readRlePattern(in, [&cells](std::int32_t x, std::int32_t y, std::uint32_t length) {
+        for (std::uint32_t i = 0; i < length; ++i) {
+            cells.emplace_back(x + static_cast<std::int32_t>(i), y);
+        }
+    });
+
+    std::vector<Position> expected;
+    for (const auto& pos : kGlider) {
+        expected.emplace_back(pos.x + 10, pos.y + 10);
+    }
+
+    for (StorageEngine engine : {StorageEngine::Sparse, StorageEngine::Dense, StorageEngine::Tiled,
+                                 StorageEngine::HashLife}) {
+        GameConfig config;
+        config.setGridWidth(40);
+        config.setGridHeight(40);
+        config.setStorageEngine(engine);
+        GameOfLifeSimulation simulation(config);
+        simulation.setCellsAlive(cells);
+
+        INFO("engine " << static_cast<int>(engine));
+        REQUIRE(sorted(simulation.getLivingPositions()) == sorted(expected));
+    }
+}
@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/PopulationPyramid.h"
+#include <climits>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+// Every occupied block of the reference set matches, and so does an empty neighbour
+void requireCounts(const PopulationPyramid& pyramid, const std::set<Position>& cells) {
+    for (std::uint32_t scale = 1; scale <= PopulationPyramid::kMaxScaleLog2; ++scale) {
+        INFO("scale " << scale);
+        std::map<Position, std::uint32_t> expected;
+        for (const auto& pos : cells) {
+            expected[Position{pos.x >> scale, pos.y >> scale}]++;
+        }
+        for (const auto& [block, count] : expected) {
+            REQUIRE(pyramid.countBlock(scale, block.x, block.y) == count);
+            const Position below{block.x, block.y + 1};
+            if (block.y < (INT32_MAX >> scale) && expected.count(below) == 0) {
+                REQUIRE(pyramid.countBlock(scale, below.x, below.y) == 0);
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Population pyramid counts blocks at every scale", "[PopulationPyramid]") {
+    PopulationPyramid pyramid;
+    std::set<Position> reference;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<std::int32_t> coord(-4000, 4000);
+
+    // Clusters, so blocks fill and empty at every level
+    for (int op = 0; op < 30000; ++op) {
+        const Position pos{coord(rng) / 16 * 16 + static_cast<std::int32_t>(rng() % 8),
+                           coord(rng) / 16 * 16 + static_cast<std::int32_t>(rng() % 8)};
+        if (rng() % 3 == 0) {
+            if (reference.erase(pos) == 1) {
+                pyramid.remove(pos);
+            }
+        } else if (reference.insert(pos).second) {
+            pyramid.add(pos);
+        }
+    }
+    for (const Position pos : {Position{INT32_MIN, INT32_MIN}, Position{INT32_MAX, INT32_MAX}, Position{INT32_MIN, 3}}) {
+        reference.insert(pos);
+        pyramid.add(pos);
+    }
+    REQUIRE(pyramid.size() == reference.size());
+    requireCounts(pyramid, reference);
+
+    SECTION("A rebuild matches the incremental counts") {
+        const std::vector<Position> cells(reference.begin(), reference.end());
+        PopulationPyramid rebuilt;
+        rebuilt.rebuild(cells);
+        requireCounts(rebuilt, reference);
+    }
+
+    SECTION("Emptied blocks are recycled") {
+        for (const auto& pos : reference) {
+            pyramid.remove(pos);
+        }
+        REQUIRE(pyramid.size() == 0);
+        REQUIRE(pyramid.countBlock(PopulationPyramid::kMaxScaleLog2, 0, 0) == 0);
+        REQUIRE(pyramid.countBlock(PopulationPyramid::kMaxScaleLog2, -1, -1) == 0);
+
+        pyramid.add(Position{300, -300});
+        REQUIRE(pyramid.countBlock(8, 1, -2) == 1);
+        REQUIRE(pyramid.countBlock(1, 150, -150) == 1);
+        REQUIRE(pyramid.countBlock(0, 300, -300) == 0); // Single cells are the engine's
+    }
+
+    SECTION("Births and deaths apply together") {
+        const std::vector<Position> born = {{10, 10}, {11, 10}};
+        const std::vector<Position> died = {*reference.begin()};
+        pyramid.apply(born, died);
+        reference.erase(reference.begin());
+        reference.insert(born.begin(), born.end());
+        requireCounts(pyramid, reference);
+    }
+}
@@ -0,0 +1,164 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/SnapshotFile.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> readCells(const SnapshotReader& reader) {
+    std::vector<Position> cells;
+    reader.readRuns([&cells](std::int32_t x, std::int32_t y, std::uint32_t length) {
+        for (std::uint32_t i = 0; i < length; ++i) {
+            cells.emplace_back(x + static_cast<std::int32_t>(i), y);
+        }
+    });
+    return sorted(cells);
+}
+
+std::vector<char> readBytes(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void writeBytes(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+} // namespace
+
+TEST_CASE("Snapshot files round trip", "[SnapshotFile]") {
+    const std::string path = tempPath("entt_gol_round_trip.gols");
+
+    // Runs, gaps, negative coordinates and a far-away cell
+    std::vector<Position> cells = {
+        {-3, -2}, {-2, -2}, {-1, -2}, {5, -2},
+        {0, 0},
+        {-100000, 7}, {-99999, 7}, {40, 7}, {41, 7}, {42, 7},
+        {2000000000, -2000000000},
+    };
+    const auto expected = sorted(cells);
+
+    SnapshotInfo info;
+    info.generation = 12345678901ull;
+    info.gridMinX = -50;
+    info.gridMinY = -60;
+    info.gridWidth = 101;
+    info.gridHeight = 121;
+    info.wrapEdges = true;
+
+    std::vector<Position> shuffled(cells.rbegin(), cells.rend());
+    writeSnapshotFile(path, info, shuffled);
+
+    SnapshotReader reader(path);
+    const auto& read = reader.getInfo();
+    REQUIRE(read.generation == info.generation);
+    REQUIRE(read.gridMinX == -50);
+    REQUIRE(read.gridMinY == -60);
+    REQUIRE(read.gridWidth == 101);
+    REQUIRE(read.gridHeight == 121);
+    REQUIRE(read.wrapEdges);
+    REQUIRE(read.cellCount == cells.size());
+    REQUIRE(readCells(reader) == expected);
+
+    // Runs come back whole
+    std::vector<std::uint32_t> lengths;
+    reader.readRuns([&lengths](std::int32_t, std::int32_t, std::uint32_t length) { lengths.push_back(length); });
+    REQUIRE(lengths == std::vector<std::uint32_t>{1, 3, 1, 1, 2, 3});
+
+    // An empty board
+    std::vector<Position> none;
+    writeSnapshotFile(path, SnapshotInfo{}, none);
+    SnapshotReader empty(path);
+    REQUIRE(empty.getInfo().cellCount == 0);
+    REQUIRE(readCells(empty).empty());
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Snapshot files reject damaged input", "[SnapshotFile]") {
+    const std::string path = tempPath("entt_gol_damaged.gols");
+
+    REQUIRE_THROWS_AS(SnapshotReader(tempPath("entt_gol_missing.gols")), std::runtime_error);
+
+    std::vector<Position> cells = {{0, 0}, {1, 0}, {2, 0}, {0, 4}, {9, 4}};
+    writeSnapshotFile(path, SnapshotInfo{}, cells);
+    const auto bytes = readBytes(path);
+    REQUIRE(bytes.size() > 64);
+
+    SECTION("short header") {
+        writeBytes(path, std::vector<char>(bytes.begin(), bytes.begin() + 40));
+        REQUIRE_THROWS_AS(SnapshotReader(path), std::runtime_error);
+    }
+
+    SECTION("wrong magic") {
+        auto damaged = bytes;
+        damaged[0] = 'X';
+        writeBytes(path, damaged);
+        REQUIRE_THROWS_AS(SnapshotReader(path), std::runtime_error);
+    }
+
+    SECTION("unknown version") {
+        auto damaged = bytes;
+        damaged[4] = 99;
+        writeBytes(path, damaged);
+        REQUIRE_THROWS_AS(SnapshotReader(path), std::runtime_error);
+    }
+
+    SECTION("truncated payload") {
+        writeBytes(path, std::vector<char>(bytes.begin(), bytes.end() - 1));
+        REQUIRE_THROWS_AS(SnapshotReader(path), std::runtime_error);
+    }
+
+    SECTION("cell count disagrees with the payload") {
+        auto damaged = bytes;
+        damaged[48] = 6;
+        writeBytes(path, damaged);
+        SnapshotReader reader(path);
+        REQUIRE_THROWS_AS(readCells(reader), std::runtime_error);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Synced snapshot files replace the old one whole", "[SnapshotFile]") {
+    const std::string path = tempPath("entt_gol_synced.gols");
+    std::vector<Position> first = {{0, 0}, {1, 0}};
+    std::vector<Position> second = {{5, -3}, {6, -3}, {-2, 4}};
+    SnapshotInfo info;
+    info.gridWidth = 16;
+    info.gridHeight = 16;
+
+    // Byte for byte the file writeSnapshotFile makes, with nothing left beside it
+    writeSnapshotFile(path, info, first);
+    const auto plain = readBytes(path);
+    writeSnapshotFileSynced(path, info, first);
+    REQUIRE(readBytes(path) == plain);
+    REQUIRE_FALSE(std::filesystem::exists(path + ".partial"));
+
+    info.generation = 9;
+    writeSnapshotFileSynced(path, info, second);
+    SnapshotReader reader(path);
+    REQUIRE(reader.getInfo().generation == 9);
+    REQUIRE(readCells(reader) == sorted(second));
+
+    // A directory that does not exist fails before the old file is touched
+    REQUIRE_THROWS_AS(writeSnapshotFileSynced(tempPath("entt_gol_missing_dir/board.gols"), info, second),
+                      std::runtime_error);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,172 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/SoupCensus.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const std::vector<Position> kGlider{{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+const std::vector<Position> kBlock{{0, 0}, {0, 1}, {1, 0}, {1, 1}}; // Canonical: sorted by x, then y
+
+std::vector<Position> moved(const std::vector<Position>& cells, std::int32_t dx, std::int32_t dy) {
+    std::vector<Position> out;
+    for (const auto& pos : cells) {
+        out.emplace_back(pos.x + dx, pos.y + dy);
+    }
+    return out;
+}
+
+const CensusObject* findObject(const SoupCensusResult& result, const std::string& name) {
+    const auto it = std::find_if(result.objects.begin(), result.objects.end(),
+                                 [&name](const CensusObject& object) { return object.name == name; });
+    return it == result.objects.end() ? nullptr : &*it;
+}
+
+} // namespace
+
+TEST_CASE("Canonical objects ignore rotation, reflection and position", "[SoupCensus]") {
+    const auto canonical = canonicalObjectCells(kGlider);
+    REQUIRE(canonical.size() == kGlider.size());
+
+    // All eight orientations of a glider, anywhere on the plane
+    for (int transform = 0; transform < 8; ++transform) {
+        std::vector<Position> cells;
+        for (const auto& pos : kGlider) {
+            std::int32_t x = (transform & 1) ? -pos.x : pos.x;
+            std::int32_t y = (transform & 2) ? -pos.y : pos.y;
+            if (transform & 4) {
+                std::swap(x, y);
+            }
+            cells.emplace_back(x - 40 * transform, y + 7);
+        }
+        std::reverse(cells.begin(), cells.end());
+        REQUIRE(canonicalObjectCells(cells) == canonical);
+        REQUIRE(objectHash(canonicalObjectCells(cells)) == objectHash(canonical));
+    }
+
+    REQUIRE(canonicalObjectCells(moved(kBlock, -3, 9)) == kBlock);
+    REQUIRE(canonicalObjectCells(kBlock) != canonicalObjectCells(std::vector<Position>{{1, 0}, {0, 1}, {2, 1}, {1, 2}}));
+    REQUIRE(objectHash(kBlock) != objectHash(canonical));
+}
+
+TEST_CASE("Ash splits into objects", "[SoupCensus]") {
+    SECTION("Objects three cells apart are separate") {
+        auto cells = moved(kBlock, 2, 2);
+        const auto blinker = std::vector<Position>{{7, 2}, {7, 3}, {7, 4}};
+        cells.insert(cells.end(), blinker.begin(), blinker.end());
+        const auto objects = splitObjects(cells, 16, 16, false);
+        REQUIRE(objects.size() == 2);
+        REQUIRE(objects[0].size() + objects[1].size() == cells.size());
+    }
+
+    SECTION("Oscillator phases whose cells do not touch stay whole") {
+        // The toad's second phase is two triples two columns apart
+        const std::vector<Position> toad{{2, 0}, {0, 1}, {3, 1}, {0, 2}, {3, 2}, {1, 3}};
+        REQUIRE(splitObjects(moved(toad, 5, 5), 16, 16, false).size() == 1);
+    }
+
+    SECTION("Objects continue across wrapped edges") {
+        const std::vector<Position> corners{{0, 0}, {15, 0}, {0, 11}, {15, 11}};
+        const auto wrapped = splitObjects(corners, 16, 12, true);
+        REQUIRE(wrapped.size() == 1);
+        REQUIRE(canonicalObjectCells(wrapped[0]) == kBlock);
+
+        REQUIRE(splitObjects(corners, 16, 12, false).size() == 4);
+        REQUIRE(splitObjects(std::vector<Position>{{-1, 0}, {16, 3}}, 16, 12, true).empty()); // Off the board
+    }
+}
+
+TEST_CASE("Object catalog names every phase", "[SoupCensus]") {
+    ObjectCatalog catalog;
+    REQUIRE(catalog.nameOf(kBlock) == "Block");
+    REQUIRE(catalog.nameOf(canonicalObjectCells(std::vector<Position>{{4, 1}, {4, 2}, {4, 3}})) == "Blinker");
+    // The glider phase after one generation
+    REQUIRE(catalog.nameOf(canonicalObjectCells(std::vector<Position>{{0, 1}, {2, 1}, {1, 2}, {2, 2}, {1, 3}})) ==
+            "Glider");
+    REQUIRE(catalog.nameOf(canonicalObjectCells(std::vector<Position>{{0, 0}, {1, 0}})).empty());
+    REQUIRE(catalog.find(canonicalObjectCells(std::vector<Position>{{0, 1}, {2, 1}, {1, 2}, {2, 2}, {1, 3}}))->cells ==
+            canonicalObjectCells(kGlider));
+
+    SECTION("Only patterns that recur are registered") {
+        const std::vector<Position> beacon{{0, 0}, {1, 0}, {0, 1}, {3, 2}, {2, 3}, {3, 3}};
+        REQUIRE(catalog.addPattern("Beacon", beacon, 2));
+        REQUIRE(catalog.nameOf(canonicalObjectCells(std::vector<Position>{
+                    {0, 0}, {1, 0}, {0, 1}, {1, 1}, {2, 2}, {3, 2}, {2, 3}, {3, 3}})) == "Beacon");
+
+        const auto shapes = catalog.getShapeCount();
+        REQUIRE_FALSE(catalog.addPattern("R-pentomino", std::vector<Position>{{1, 0}, {2, 0}, {0, 1}, {1, 1}, {1, 2}}, 1));
+        REQUIRE_FALSE(catalog.addPattern("Beacon", beacon, 1)); // Period too short
+        REQUIRE(catalog.getShapeCount() == shapes);
+    }
+
+    SECTION("Pattern files add their names") {
+        const auto directory = std::filesystem::temp_directory_path() / "entt_gol_census_patterns";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        std::ofstream(directory / "tub.json") << R"({"name": "Tub", "period": 1,
+            "cells": [{"x": 1, "y": 0}, {"x": 0, "y": 1}, {"x": 2, "y": 1}, {"x": 1, "y": 2}]})";
+        std::ofstream(directory / "pair.json") << R"({"name": "Domino", "cells": [{"x": 0, "y": 0}, {"x": 1, "y": 0}]})";
+        std::ofstream(directory / "notes.txt") << "not a pattern";
+
+        REQUIRE(catalog.loadPatternDirectory(directory.string()) == 1);
+        REQUIRE(catalog.nameOf(canonicalObjectCells(std::vector<Position>{{1, 0}, {0, 1}, {2, 1}, {1, 2}})) == "Tub");
+        REQUIRE_THROWS(catalog.loadPatternDirectory((directory / "missing").string()));
+        std::filesystem::remove_all(directory);
+    }
+}
+
+TEST_CASE("Soup census tallies the ash of every soup", "[SoupCensus]") {
+    ObjectCatalog catalog;
+    SoupCensusConfig config;
+    config.soups = 70;
+    config.seed = 5;
+    config.boardSize = 40;
+    config.generationLimit = 1500;
+    config.soupsPerEnsemble = 16;
+    config.threads = 1;
+    const auto single = runSoupCensus(config, catalog);
+
+    REQUIRE(single.soups == 70);
+    REQUIRE(single.diedOut + single.settled + single.unsettled == 70);
+    REQUIRE(single.boardGenerations > 0);
+    REQUIRE(!single.objects.empty());
+
+    // Blocks and blinkers are the most common objects in Life soups
+    REQUIRE(single.objects.size() >= 2);
+    REQUIRE(std::set<std::string>{single.objects[0].name, single.objects[1].name} ==
+            std::set<std::string>{"Block", "Blinker"});
+
+    // Every phase of a glider is tallied as the one known glider
+    const auto* glider = findObject(single, "Glider");
+    REQUIRE(glider != nullptr);
+    REQUIRE(glider->cells == catalog.find(glider->cells)->cells);
+    REQUIRE(std::count_if(single.objects.begin(), single.objects.end(),
+                          [](const CensusObject& object) { return object.name == "Glider"; }) == 1);
+    for (std::size_t i = 1; i < single.objects.size(); ++i) {
+        REQUIRE(single.objects[i - 1].count >= single.objects[i].count);
+    }
+
+    // The tally does not depend on how soups are spread over workers
+    config.threads = 3;
+    const auto parallel = runSoupCensus(config, catalog);
+    REQUIRE(parallel.boardGenerations == single.boardGenerations);
+    REQUIRE(parallel.unsettled == single.unsettled);
+    REQUIRE(parallel.objects.size() == single.objects.size());
+    for (std::size_t i = 0; i < single.objects.size(); ++i) {
+        REQUIRE(parallel.objects[i].cells == single.objects[i].cells);
+        REQUIRE(parallel.objects[i].count == single.objects[i].count);
+    }
+
+    config.soupSize = 41;
+    REQUIRE_THROWS_AS(runSoupCensus(config, catalog), std::invalid_argument);
+    config.soupSize = 16;
+    config.generationLimit = 0;
+    REQUIRE_THROWS_AS(runSoupCensus(config, catalog), std::invalid_argument);
+    config.generationLimit = 100;
+    config.boardSize = BoardEnsemble::kMaxWidth + 1;
+    REQUIRE_THROWS_AS(runSoupCensus(config, catalog), std::invalid_argument);
+}
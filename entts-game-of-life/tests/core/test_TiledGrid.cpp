@@ -0,0 +1,340 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/GameOfLifeSimulation.h"
+#include "core/TiledGrid.h"
+#include "core/WorkStealingPool.h"
+#include "core/GameConfig.h"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+GameConfig makeConfig(std::int32_t width, std::int32_t height, bool wrap, StorageEngine engine,
+                      std::int32_t threads = 0) {
+    GameConfig config;
+    config.setGridWidth(width);
+    config.setGridHeight(height);
+    config.setWrapEdges(wrap);
+    config.setStorageEngine(engine);
+    config.setWorkerThreads(threads);
+    return config;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+} // namespace
+
+TEST_CASE("WorkStealingPool runs every task once", "[TiledGrid]") {
+    WorkStealingPool pool(4);
+    REQUIRE(pool.getThreadCount() == 4);
+
+    std::vector<std::atomic<int>> hits(1000);
+    for (int batch = 0; batch < 20; ++batch) {
+        pool.parallelFor(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); });
+    }
+
+    for (const auto& hit : hits) {
+        REQUIRE(hit.load() == 20);
+    }
+}
+
+TEST_CASE("WorkStealingPool steals from a blocked worker", "[TiledGrid]") {
+    WorkStealingPool pool(2);
+
+    // Worker 0 is stuck on task 0, so the other worker must drain its queue
+    std::atomic<int> done{0};
+    pool.parallelFor(64, [&](std::size_t i) {
+        if (i == 0) {
+            while (done.load() < 63) {
+                std::this_thread::yield();
+            }
+        } else {
+            done.fetch_add(1);
+        }
+    });
+
+    REQUIRE(done.load() == 63);
+    REQUIRE(pool.getStealCount() > 0);
+}
+
+TEST_CASE("WorkStealingPool steals within a node first", "[TiledGrid]") {
+    // Two nodes of two workers; every worker may run on CPU 0
+    WorkerPlacement placement;
+    placement.topology = NumaTopology({NumaNode{0, {0}}, NumaNode{1, {0}}});
+    WorkStealingPool pool(4, placement);
+    REQUIRE(pool.getWorkerNode(0) == 0);
+    REQUIRE(pool.getWorkerNode(1) == 0);
+    REQUIRE(pool.getWorkerNode(2) == 1);
+    REQUIRE(pool.getWorkerNode(3) == 1);
+    REQUIRE(pool.getOwner(7, 16) == 1);
+
+    std::vector<std::thread::id> threads(4);
+    pool.forEachWorker([&](std::size_t worker) { threads[worker] = std::this_thread::get_id(); });
+    REQUIRE(threads[0] == std::this_thread::get_id());
+    REQUIRE(std::set<std::thread::id>(threads.begin(), threads.end()).size() == 4);
+    REQUIRE(pool.getStealCount() == 0);
+
+    // Tasks 0-9 start on worker 0 and 10-19 on worker 3, whose first tasks
+    // hold them up, so workers 1 and 2 have to steal. Each thief's first
+    // task waits for the other's, so neither can empty both queues alone.
+    std::atomic<int> done{0};
+    std::atomic<int> thieves{0};
+    std::vector<std::size_t> firstStolen(4, 0);
+    pool.parallelFor(
+        20,
+        [&](std::size_t i) {
+            if (i == 0 || i == 10) {
+                while (done.load() < 18) {
+                    std::this_thread::yield();
+                }
+                return;
+            }
+            const auto worker = static_cast<std::size_t>(
+                std::find(threads.begin(), threads.end(), std::this_thread::get_id()) - threads.begin());
+            if ((worker == 1 || worker == 2) && firstStolen[worker] == 0) {
+                firstStolen[worker] = i;
+                thieves.fetch_add(1);
+                while (thieves.load() < 2) {
+                    std::this_thread::yield();
+                }
+            }
+            done.fetch_add(1);
+        },
+        [](std::size_t i) { return i < 10 ? 0u : 3u; });
+
+    REQUIRE(done.load() == 18);
+    REQUIRE(firstStolen[1] < 10);  // From worker 0, on node 0
+    REQUIRE(firstStolen[2] >= 10); // From worker 3, on node 1
+    REQUIRE(pool.getRemoteStealCount() <= pool.getStealCount());
+}
+
+TEST_CASE("TiledGrid tile layout", "[TiledGrid]") {
+    TiledGrid grid(200, 70, false, 1);
+    REQUIRE(grid.getTilesX() == 4);
+    REQUIRE(grid.getTilesY() == 2);
+
+    SECTION("Only tiles with activity are flagged as changed") {
+        // Blinker in tile (0, 0), block in tile (2, 1)
+        grid.setCell(10, 10, true);
+        grid.setCell(11, 10, true);
+        grid.setCell(12, 10, true);
+        grid.setCell(140, 66, true);
+        grid.setCell(141, 66, true);
+        grid.setCell(140, 67, true);
+        grid.setCell(141, 67, true);
+
+        REQUIRE(grid.step());
+        REQUIRE(grid.tileChanged(0, 0));
+        REQUIRE_FALSE(grid.tileChanged(2, 1));
+        REQUIRE(grid.getLivingCellCount() == 7);
+    }
+}
+
+TEST_CASE("TiledGrid matches dense storage", "[TiledGrid]") {
+    struct Scenario {
+        std::int32_t width;
+        std::int32_t height;
+        bool wrap;
+    };
+
+    // Partial tiles, wrapping across tile borders, and grids shorter than one tile
+    const std::vector<Scenario> scenarios{
+        {200, 150, false}, {200, 150, true}, {64, 64, true}, {130, 20, true}, {97, 3, false}};
+
+    for (const auto& scenario : scenarios) {
+        for (std::int32_t threads : {1, 2, 5}) {
+            INFO("grid " << scenario.width << "x" << scenario.height << " wrap " << scenario.wrap
+                         << " threads " << threads);
+
+            GameOfLifeSimulation dense(makeConfig(scenario.width, scenario.height, scenario.wrap,
+                                                  StorageEngine::Dense));
+            GameOfLifeSimulation tiled(makeConfig(scenario.width, scenario.height, scenario.wrap,
+                                                  StorageEngine::Tiled, threads));
+            REQUIRE(tiled.usesTiledStorage());
+
+            std::mt19937 rng(42);
+            std::uniform_int_distribution<std::int32_t> xs(0, scenario.width - 1);
+            std::uniform_int_distribution<std::int32_t> ys(0, scenario.height - 1);
+            for (std::int32_t i = 0; i < scenario.width * scenario.height / 4; ++i) {
+                std::int32_t x = xs(rng);
+                std::int32_t y = ys(rng);
+                dense.setCellAlive(x, y);
+                tiled.setCellAlive(x, y);
+            }
+
+            for (int generation = 0; generation < 20; ++generation) {
+                REQUIRE(tiled.step() == dense.step());
+                REQUIRE(tiled.getLivingCellCount() == dense.getLivingCellCount());
+                REQUIRE(sorted(tiled.getLivingPositions()) == sorted(dense.getLivingPositions()));
+            }
+        }
+    }
+}
+
+TEST_CASE("TiledGrid steps the same with a NUMA placement", "[TiledGrid]") {
+    // Three nodes, so the runs of tiles split at uneven points
+    WorkerPlacement placement;
+    placement.topology = NumaTopology({NumaNode{0, {0}}, NumaNode{1, {0}}, NumaNode{2, {0}}});
+    placement.pinThreads = true;
+    TiledGrid placed(300, 330, true, 5, {}, placement);
+    TiledGrid plain(300, 330, true, 1);
+    REQUIRE(placed.getNodeCount() == 3);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::int32_t> xs(0, 299);
+    std::uniform_int_distribution<std::int32_t> ys(0, 329);
+    for (int i = 0; i < 25000; ++i) {
+        const std::int32_t x = xs(rng);
+        const std::int32_t y = ys(rng);
+        placed.setCell(x, y, true);
+        plain.setCell(x, y, true);
+    }
+
+    for (std::uint32_t generations : {1u, 3u, 1u, 20u}) {
+        REQUIRE(placed.step(generations) == plain.step(generations));
+        std::vector<Position> placedCells;
+        std::vector<Position> plainCells;
+        placed.collectLivingCells(placedCells);
+        plain.collectLivingCells(plainCells);
+        REQUIRE(placedCells == plainCells);
+    }
+}
+
+TEST_CASE("Every engine reports the cells a step changed", "[TiledGrid]") {
+    for (StorageEngine engine : {StorageEngine::Sparse, StorageEngine::Dense, StorageEngine::Tiled,
+                                 StorageEngine::HashLife, StorageEngine::Packed}) {
+        INFO("engine " << static_cast<int>(engine));
+        GameOfLifeSimulation simulation(makeConfig(130, 90, true, engine, 2));
+
+        std::mt19937 rng(9);
+        std::bernoulli_distribution alive(0.3);
+        for (std::int32_t y = 0; y < 90; ++y) {
+            for (std::int32_t x = 0; x < 130; ++x) {
+                if (alive(rng)) {
+                    simulation.setCellAlive(x, y);
+                }
+            }
+        }
+
+        for (int generation = 0; generation < 20; ++generation) {
+            auto before = sorted(simulation.getLivingPositions());
+            simulation.step();
+            auto after = sorted(simulation.getLivingPositions());
+
+            std::vector<Position> born;
+            std::vector<Position> died;
+            std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(born));
+            std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(died));
+
+            REQUIRE(sorted(simulation.getBornCells()) == born);
+            REQUIRE(sorted(simulation.getDiedCells()) == died);
+            REQUIRE(simulation.getLastBirthCount() == born.size());
+        }
+    }
+}
+
+TEST_CASE("TiledGrid multi-generation steps match single steps", "[TiledGrid]") {
+    struct Scenario {
+        std::int32_t width;
+        std::int32_t height;
+        bool wrap;
+    };
+
+    // Word-aligned and ragged widths; the ragged wrapped grid takes the single-step path
+    const std::vector<Scenario> scenarios{
+        {128, 100, true}, {200, 150, false}, {130, 70, true}, {64, 20, true}, {97, 3, false}};
+
+    for (const auto& scenario : scenarios) {
+        for (const auto& rule : {kConwayRule, kHighLifeRule}) {
+            for (std::uint32_t generations : {2u, 8u, 21u}) {
+                INFO("grid " << scenario.width << "x" << scenario.height << " wrap " << scenario.wrap << " rule "
+                             << rule.toString() << " generations " << generations);
+                TiledGrid blocked(scenario.width, scenario.height, scenario.wrap, 3, rule);
+                TiledGrid single(scenario.width, scenario.height, scenario.wrap, 1, rule);
+
+                std::mt19937 rng(7);
+                std::bernoulli_distribution alive(0.35);
+                for (std::int32_t y = 0; y < scenario.height; ++y) {
+                    for (std::int32_t x = 0; x < scenario.width; ++x) {
+                        const bool cell = alive(rng);
+                        blocked.setCell(x, y, cell);
+                        single.setCell(x, y, cell);
+                    }
+                }
+
+                for (int round = 0; round < 3; ++round) {
+                    std::vector<Position> before;
+                    single.collectLivingCells(before);
+                    before = sorted(before);
+
+                    for (std::uint32_t i = 0; i < generations; ++i) {
+                        single.step();
+                    }
+                    std::vector<Position> after;
+                    single.collectLivingCells(after);
+                    after = sorted(after);
+
+                    REQUIRE(blocked.step(generations) == (before != after));
+                    std::vector<Position> cells;
+                    blocked.collectLivingCells(cells);
+                    REQUIRE(sorted(cells) == after);
+                    REQUIRE(blocked.getLivingCellCount() == single.getLivingCellCount());
+
+                    // Changes run from the board before the call to the one after it
+                    std::vector<Position> born;
+                    std::vector<Position> died;
+                    blocked.collectChanges(born, died);
+                    std::vector<Position> expectedBorn;
+                    std::vector<Position> expectedDied;
+                    std::set_difference(after.begin(), after.end(), before.begin(), before.end(),
+                                        std::back_inserter(expectedBorn));
+                    std::set_difference(before.begin(), before.end(), after.begin(), after.end(),
+                                        std::back_inserter(expectedDied));
+                    REQUIRE(sorted(born) == expectedBorn);
+                    REQUIRE(sorted(died) == expectedDied);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Tiled storage advances in blocks and keeps the phase", "[TiledGrid]") {
+    GameOfLifeSimulation tiled(makeConfig(128, 128, true, StorageEngine::Tiled, 2));
+    GameOfLifeSimulation dense(makeConfig(128, 128, true, StorageEngine::Dense));
+
+    SECTION("A running soup matches single steps") {
+        std::mt19937 rng(5);
+        std::bernoulli_distribution alive(0.3);
+        for (std::int32_t y = 0; y < 128; ++y) {
+            for (std::int32_t x = 0; x < 128; ++x) {
+                if (alive(rng)) {
+                    tiled.setCellAlive(x, y);
+                    dense.setCellAlive(x, y);
+                }
+            }
+        }
+        REQUIRE(tiled.advance(37) == dense.advance(37));
+        REQUIRE(tiled.getGenerationCount() == dense.getGenerationCount());
+        REQUIRE(sorted(tiled.getLivingPositions()) == sorted(dense.getLivingPositions()));
+    }
+
+    SECTION("An oscillator skips the remaining blocks in phase") {
+        // Odd step count: a blinker ends turned
+        for (const auto& [x, y] : {std::pair{10, 10}, {11, 10}, {12, 10}}) {
+            tiled.setCellAlive(x, y);
+            dense.setCellAlive(x, y);
+        }
+        REQUIRE(tiled.advance(1001) == 1001);
+        dense.advance(1001);
+        REQUIRE(tiled.getGenerationCount() == 1001);
+        REQUIRE(sorted(tiled.getLivingPositions()) == sorted(dense.getLivingPositions()));
+        REQUIRE(tiled.isCellAlive(11, 9));
+    }
+}
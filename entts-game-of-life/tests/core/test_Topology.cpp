@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/LifeEngine.h"
+#include "core/Topology.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename Topology>
+std::vector<Position> neighborsOf(const Topology& topology, Position pos) {
+    std::vector<Position> out;
+    forEachNeighbor(topology, pos, [&](Position neighbor) { out.push_back(neighbor); });
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+} // namespace
+
+TEST_CASE("Topologies visit the neighbors the grid edges allow", "[Topology]") {
+    const BoundedTopology bounded{10, 8};
+    const TorusTopology torus{10, 8};
+
+    // Interior cells take the same eight offsets either way
+    const std::vector<Position> interior = {{4, 3}, {4, 5}, {5, 3}, {5, 5}, {6, 3}, {6, 4}, {6, 5}, {4, 4}};
+    REQUIRE(neighborsOf(bounded, {5, 4}) == sorted(interior));
+    REQUIRE(neighborsOf(torus, {5, 4}) == sorted(interior));
+
+    REQUIRE(neighborsOf(bounded, {0, 0}) == std::vector<Position>{{0, 1}, {1, 0}, {1, 1}});
+    REQUIRE(neighborsOf(torus, {0, 0}) ==
+            sorted({{9, 7}, {9, 0}, {9, 1}, {0, 7}, {0, 1}, {1, 7}, {1, 0}, {1, 1}}));
+    REQUIRE(neighborsOf(bounded, {9, 4}).size() == 5);
+    REQUIRE(neighborsOf(torus, {9, 4}).front() == Position(0, 3));
+
+    // A one-cell torus is its own neighbor eight times, as with modulo wrapping
+    REQUIRE(neighborsOf(TorusTopology{1, 1}, {0, 0}) == std::vector<Position>(8, Position(0, 0)));
+}
+
+TEST_CASE("Sparse and packed steps agree with the dense grid on every topology", "[Topology]") {
+    std::mt19937 rng(11);
+    // Tiny boards have no interior at all; larger ones mix both paths
+    for (const auto& [width, height] : {std::pair{1, 1}, {2, 3}, {3, 3}, {17, 9}, {64, 40}}) {
+        std::vector<Position> cells;
+        for (std::int32_t y = 0; y < height; ++y) {
+            for (std::int32_t x = 0; x < width; ++x) {
+                if (rng() % 3 == 0) {
+                    cells.emplace_back(x, y);
+                }
+            }
+        }
+
+        for (bool wrap : {false, true}) {
+            GameConfig config;
+            config.setGridWidth(width);
+            config.setGridHeight(height);
+            config.setWrapEdges(wrap);
+            config.setAdaptiveStorage(false);
+
+            config.setStorageEngine(StorageEngine::Dense);
+            auto reference = createLifeEngine(config);
+            reference->setCellsAlive(cells);
+            std::vector<std::unique_ptr<LifeEngine>> engines;
+            for (StorageEngine engine : {StorageEngine::Sparse, StorageEngine::Packed}) {
+                config.setStorageEngine(engine);
+                engines.push_back(createLifeEngine(config));
+                engines.back()->setCellsAlive(cells);
+            }
+
+            for (int generation = 0; generation < 12; ++generation) {
+                const bool changed = reference->step();
+                const auto expected = sorted(reference->getLivingPositions());
+                for (const auto& engine : engines) {
+                    INFO(width << "x" << height << " wrap " << wrap << " "
+                                << storageEngineName(engine->getConfig().getStorageEngine()));
+                    REQUIRE(engine->step() == changed);
+                    REQUIRE(sorted(engine->getLivingPositions()) == expected);
+                }
+            }
+        }
+    }
+}
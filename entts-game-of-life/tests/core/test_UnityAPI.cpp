@@ -0,0 +1,214 @@
+#include <catch2/catch_test_macros.hpp>
+#include "api/UnityAPI.h"
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::set<std::pair<std::int32_t, std::int32_t>> frameCells(const GolFrame& frame) {
+    std::set<std::pair<std::int32_t, std::int32_t>> cells;
+    for (std::uint32_t i = 0; i < frame.cellCount; ++i) {
+        cells.emplace(frame.cells[i].x, frame.cells[i].y);
+    }
+    return cells;
+}
+
+} // namespace
+
+TEST_CASE("Unity frames expose the board in place", "[UnityAPI]") {
+    REQUIRE(gol_get_api_version() == GOL_API_VERSION);
+
+    GolSimulation* sim = gol_create(R"({"grid": {"width": 100, "height": 80}})");
+    REQUIRE(sim != nullptr);
+
+    const GolCell blinker[] = {{10, 11}, {11, 11}, {12, 11}};
+    REQUIRE(gol_set_cells(sim, blinker, 3, 1) == GOL_OK);
+    REQUIRE(gol_get_cell_count(sim) == 3);
+
+    const GolFrame* first = gol_acquire_frame(sim);
+    REQUIRE(first != nullptr);
+    REQUIRE(first->generation == 0);
+    REQUIRE(first->deltaBase == 0);
+    REQUIRE(first->cellCount == 3);
+    REQUIRE(first->bitmap == nullptr);
+
+    // Nothing changed, so the same frame comes back
+    const GolFrame* again = gol_acquire_frame(sim);
+    REQUIRE(again == first);
+    gol_release_frame(sim, again);
+
+    REQUIRE(gol_step(sim, 1) == GOL_OK);
+    const GolFrame* second = gol_acquire_frame(sim);
+    REQUIRE(second != first);
+    REQUIRE(second->generation == 1);
+    REQUIRE(second->version > first->version);
+    REQUIRE(frameCells(*second) == std::set<std::pair<std::int32_t, std::int32_t>>{{11, 10}, {11, 11}, {11, 12}});
+
+    // The delta turns the first frame into the second
+    REQUIRE(second->deltaBase == first->version);
+    REQUIRE(second->bornCount == 2);
+    REQUIRE(second->diedCount == 2);
+    auto cells = frameCells(*first);
+    for (std::uint32_t i = 0; i < second->diedCount; ++i) {
+        REQUIRE(cells.erase({second->died[i].x, second->died[i].y}) == 1);
+    }
+    for (std::uint32_t i = 0; i < second->bornCount; ++i) {
+        REQUIRE(cells.emplace(second->born[i].x, second->born[i].y).second);
+    }
+    REQUIRE(cells == frameCells(*second));
+
+    // A pinned frame is left alone as the simulation moves on
+    REQUIRE(first->cellCount == 3);
+    REQUIRE(first->cells[0].y == 11);
+    REQUIRE(first->cells[2].y == 11);
+
+    gol_release_frame(sim, first);
+    gol_release_frame(sim, second);
+    gol_destroy(sim);
+}
+
+TEST_CASE("Unity frame deltas hold across steps and edits", "[UnityAPI]") {
+    GolSimulation* sim = gol_create(R"({"grid": {"width": 64, "height": 48}})");
+    REQUIRE(sim != nullptr);
+
+    std::vector<GolCell> soup;
+    for (std::int32_t i = 0; i < 400; ++i) {
+        soup.push_back({(i * 37) % 40 + 12, (i * 23) % 30 + 9});
+    }
+    REQUIRE(gol_set_cells(sim, soup.data(), static_cast<std::uint32_t>(soup.size()), 1) == GOL_OK);
+
+    const GolFrame* previous = gol_acquire_frame(sim);
+    REQUIRE(previous != nullptr);
+    for (int round = 0; round < 30; ++round) {
+        // Single steps take the engine's changes; the rest rebuild the frame
+        if (round % 6 == 2) {
+            const GolCell edit[] = {{round, 5}, {round + 1, 5}, {round + 2, 5}};
+            REQUIRE(gol_set_cells(sim, edit, 3, 1) == GOL_OK);
+        }
+        REQUIRE(gol_step(sim, round % 7 == 4 ? 2 : 1) == GOL_OK);
+        const GolFrame* frame = gol_acquire_frame(sim);
+        REQUIRE(frame != nullptr);
+
+        std::set<std::pair<std::int32_t, std::int32_t>> alive;
+        for (std::int32_t y = 0; y < 48; ++y) {
+            for (std::int32_t x = 0; x < 64; ++x) {
+                if (gol_is_cell_alive(sim, x, y)) {
+                    alive.emplace(x, y);
+                }
+            }
+        }
+        REQUIRE(frameCells(*frame) == alive);
+        for (std::uint32_t i = 1; i < frame->cellCount; ++i) {
+            const auto& a = frame->cells[i - 1];
+            const auto& b = frame->cells[i];
+            REQUIRE((a.x < b.x || (a.x == b.x && a.y < b.y)));
+        }
+
+        REQUIRE(frame->deltaBase == previous->version);
+        auto cells = frameCells(*previous);
+        for (std::uint32_t i = 0; i < frame->diedCount; ++i) {
+            REQUIRE(cells.erase({frame->died[i].x, frame->died[i].y}) == 1);
+        }
+        for (std::uint32_t i = 0; i < frame->bornCount; ++i) {
+            REQUIRE(cells.emplace(frame->born[i].x, frame->born[i].y).second);
+        }
+        REQUIRE(cells == alive);
+
+        gol_release_frame(sim, previous);
+        previous = frame;
+    }
+    gol_release_frame(sim, previous);
+    gol_destroy(sim);
+}
+
+TEST_CASE("Unity frames reuse released buffers", "[UnityAPI]") {
+    GolSimulation* sim = gol_create(nullptr);
+    REQUIRE(sim != nullptr);
+    const GolCell glider[] = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    REQUIRE(gol_set_cells(sim, glider, 5, 1) == GOL_OK);
+
+    std::set<const GolFrame*> seen;
+    for (int i = 0; i < 20; ++i) {
+        const GolFrame* frame = gol_acquire_frame(sim);
+        REQUIRE(frame != nullptr);
+        REQUIRE(frame->cellCount == 5);
+        seen.insert(frame);
+        gol_release_frame(sim, frame);
+        REQUIRE(gol_step(sim, 1) == GOL_OK);
+    }
+    // The current frame and one being built
+    REQUIRE(seen.size() == 2);
+    gol_destroy(sim);
+}
+
+TEST_CASE("Unity bitmaps mark live grid cells", "[UnityAPI]") {
+    GolSimulation* sim = gol_create(R"({"grid": {"width": 130, "height": 4}})");
+    REQUIRE(sim != nullptr);
+    const GolCell cells[] = {{0, 0}, {63, 1}, {64, 1}, {129, 3}};
+    REQUIRE(gol_set_cells(sim, cells, 4, 1) == GOL_OK);
+    REQUIRE(gol_set_bitmap_enabled(sim, 1) == GOL_OK);
+
+    const GolFrame* frame = gol_acquire_frame(sim);
+    REQUIRE(frame != nullptr);
+    REQUIRE(frame->gridWidth == 130);
+    REQUIRE(frame->gridHeight == 4);
+    REQUIRE(frame->bitmapWordsPerRow == 3);
+    REQUIRE(frame->bitmap != nullptr);
+
+    std::uint32_t bits = 0;
+    for (std::uint32_t word = 0; word < frame->bitmapWordsPerRow * 4; ++word) {
+        for (std::uint64_t value = frame->bitmap[word]; value != 0; value &= value - 1) {
+            ++bits;
+        }
+    }
+    REQUIRE(bits == 4);
+    REQUIRE(frame->bitmap[0] == 1);
+    REQUIRE(frame->bitmap[3] == std::uint64_t{1} << 63);
+    REQUIRE(frame->bitmap[4] == 1);
+    REQUIRE(frame->bitmap[3 * 3 + 2] == std::uint64_t{1} << 1);
+
+    gol_release_frame(sim, frame);
+    REQUIRE(gol_set_cells(sim, cells, 4, 0) == GOL_OK);
+    REQUIRE(gol_get_cell_count(sim) == 0);
+    REQUIRE(gol_is_cell_alive(sim, 0, 0) == 0);
+    gol_destroy(sim);
+}
+
+TEST_CASE("Unity API failures become error codes", "[UnityAPI]") {
+    REQUIRE(gol_create("{not json") == nullptr);
+    REQUIRE(*gol_get_last_error() != '\0');
+    REQUIRE(gol_create(R"({"grid": {"width": -5}})") == nullptr);
+
+    REQUIRE(gol_step(nullptr, 1) == GOL_ERROR_INVALID_ARGUMENT);
+    REQUIRE(gol_acquire_frame(nullptr) == nullptr);
+
+    GolSimulation* sim = gol_create("");
+    REQUIRE(sim != nullptr);
+    REQUIRE(gol_set_cells(sim, nullptr, 3, 1) == GOL_ERROR_INVALID_ARGUMENT);
+    REQUIRE(gol_set_cells(sim, nullptr, 0, 1) == GOL_OK);
+
+    // Steps on a settled board still count
+    REQUIRE(gol_step(sim, 50) == GOL_OK);
+    REQUIRE(gol_get_generation(sim) == 50);
+    REQUIRE(gol_reset(sim) == GOL_OK);
+    gol_destroy(sim);
+
+    sim = gol_create(R"({"grid": {"width": 500, "height": 500}, "performance": {"memory_limit_mb": 1}})");
+    REQUIRE(sim != nullptr);
+    std::vector<GolCell> cells;
+    for (std::int32_t y = 0; y < 500; y += 2) {
+        for (std::int32_t x = 0; x < 500; x += 2) {
+            cells.push_back({x, y});
+        }
+    }
+    REQUIRE(gol_set_cells(sim, cells.data(), static_cast<std::uint32_t>(cells.size()), 1) == GOL_OK);
+    REQUIRE(gol_step(sim, 1) == GOL_ERROR_MEMORY_LIMIT);
+    REQUIRE(gol_get_generation(sim) == 0);
+    REQUIRE(gol_reset(sim) == GOL_OK);
+    REQUIRE(gol_step(sim, 50) == GOL_OK);
+    REQUIRE(gol_get_generation(sim) == 50);
+    REQUIRE(gol_reset(sim) == GOL_OK);
+    REQUIRE(gol_get_generation(sim) == 0);
+    gol_destroy(sim);
+}
@@ -1,7 +1,17 @@
 #include <catch2/catch_test_macros.hpp>
 #include "console/SimulationController.h"
 #include "core/GameConfig.h"
+#include "core/GameOfLifeSimulation.h"
+#include "core/SnapshotFile.h"
+#include <algorithm>
 #include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
 #include <vector>
 
 TEST_CASE("SimulationController headless operation", "[HeadlessController]") {
@@ -96,6 +106,638 @@ TEST_CASE("SimulationController headless operation", "[HeadlessController]") {
         
         REQUIRE(controller.getLivingCellCount() == 0);
     }
+    
+    SECTION("Step changes list born and died cells") {
+        GameConfig config;
+        config.setGridWidth(20);
+        config.setGridHeight(20);
+        
+        SimulationController controller(config);
+        controller.setCellAlive(5, 4);
+        controller.setCellAlive(5, 5);
+        controller.setCellAlive(5, 6);
+        controller.step();
+        
+        // Vertical blinker turns horizontal
+        const auto& changes = controller.getLastStepChanges();
+        using Cells = std::vector<std::pair<std::int32_t, std::int32_t>>;
+        REQUIRE(changes.generation == 1);
+        REQUIRE(changes.born.size() == 2);
+        REQUIRE(changes.died.size() == 2);
+        REQUIRE(std::is_permutation(changes.born.begin(), changes.born.end(), Cells{{4, 5}, {6, 5}}.begin()));
+        REQUIRE(std::is_permutation(changes.died.begin(), changes.died.end(), Cells{{5, 4}, {5, 6}}.begin()));
+        
+        controller.reset();
+        REQUIRE(controller.getLastStepChanges().born.empty());
+        REQUIRE(controller.getLastStepChanges().died.empty());
+    }
+    
+    SECTION("Batch run steps without frame timing and samples the callback") {
+        GameConfig config;
+        config.setGridWidth(20);
+        config.setGridHeight(20);
+        config.setTargetFps(1); // Would allow one step per second in a timed run
+        config.setAutoPauseOnStable(false);
+        
+        SimulationController controller(config);
+        controller.setCellAlive(5, 4);
+        controller.setCellAlive(5, 5);
+        controller.setCellAlive(5, 6);
+        
+        std::vector<std::uint64_t> sampledGenerations;
+        controller.setStepCallback([&sampledGenerations](const SimulationStats& stats) {
+            sampledGenerations.push_back(stats.generation);
+        });
+        
+        auto result = controller.runHeadlessBatch(25, 10);
+        
+        REQUIRE(result.generations == 25);
+        REQUIRE_FALSE(result.stoppedEarly);
+        REQUIRE(result.generationsPerSecond > 1.0);
+        REQUIRE(sampledGenerations == std::vector<std::uint64_t>{10, 20, 25});
+        REQUIRE(controller.getStats().generation == 25);
+        REQUIRE(controller.getStats().livingCells == 3);
+        REQUIRE(controller.getLastStepChanges().generation == 25);
+        REQUIRE(controller.getState() == SimulationState::Stopped);
+    }
+    
+    SECTION("Batch run stops once the grid dies out or settles") {
+        GameConfig config;
+        config.setGridWidth(20);
+        config.setGridHeight(20);
+        
+        SimulationController lonely(config);
+        lonely.setCellAlive(3, 3);
+        auto died = lonely.runHeadlessBatch(100);
+        REQUIRE(died.generations == 1);
+        REQUIRE(died.stoppedEarly);
+        REQUIRE(lonely.getStats().livingCells == 0);
+        
+        // A blinker is stable as soon as its first period closes
+        SimulationController blinker(config);
+        blinker.setCellAlive(5, 4);
+        blinker.setCellAlive(5, 5);
+        blinker.setCellAlive(5, 6);
+        auto settled = blinker.runHeadlessBatch(100);
+        REQUIRE(settled.generations == 2);
+        REQUIRE(settled.stoppedEarly);
+        REQUIRE(blinker.getStats().isStable);
+        REQUIRE(blinker.getStats().cyclePeriod == 2);
+        
+        // A glider never keeps still, but repeats itself one cell over every four generations
+        SimulationController glider(config);
+        glider.setCellAlive(2, 1);
+        glider.setCellAlive(3, 2);
+        glider.setCellAlive(1, 3);
+        glider.setCellAlive(2, 3);
+        glider.setCellAlive(3, 3);
+        auto moving = glider.runHeadlessBatch(100);
+        REQUIRE(moving.generations == 4);
+        REQUIRE(glider.getStats().cyclePeriod == 4);
+        REQUIRE(glider.getStats().cycleDx == 1);
+        REQUIRE(glider.getStats().cycleDy == 1);
+    }
+    
+    SECTION("Snapshots restore the board into any storage engine") {
+        const std::string path = (std::filesystem::temp_directory_path() / "entt_gol_controller.gols").string();
+        
+        GameConfig config;
+        config.setGridWidth(40);
+        config.setGridHeight(30);
+        config.setWrapEdges(true);
+        SimulationController source(config);
+        for (const auto& [x, y] : {std::pair{2, 1}, {3, 2}, {1, 3}, {2, 3}, {3, 3}, {20, 10}, {21, 10}, {22, 10}}) {
+            source.setCellAlive(x, y);
+        }
+        source.runHeadlessBatch(7);
+        source.saveSnapshot(path);
+        
+        auto saved = source.getLivingCells();
+        std::sort(saved.begin(), saved.end());
+        
+        for (StorageEngine engine : {StorageEngine::Sparse, StorageEngine::Dense, StorageEngine::Tiled,
+                                     StorageEngine::HashLife}) {
+            GameConfig other;
+            other.setStorageEngine(engine);
+            SimulationController target(other);
+            target.loadSnapshot(path);
+            
+            auto loaded = target.getLivingCells();
+            std::sort(loaded.begin(), loaded.end());
+            REQUIRE(target.getConfig().getStorageEngine() == engine);
+            REQUIRE(target.getConfig().getGridWidth() == 40);
+            REQUIRE(target.getConfig().getGridHeight() == 30);
+            REQUIRE(target.getConfig().getWrapEdges());
+            REQUIRE(target.getStats().generation == 7);
+            REQUIRE(loaded == saved);
+            
+            // The loaded board is what reset() restores
+            target.step();
+            target.reset();
+            loaded = target.getLivingCells();
+            std::sort(loaded.begin(), loaded.end());
+            REQUIRE(loaded == saved);
+        }
+        
+        // A board saved with its origin elsewhere lands with its corner on (0, 0)
+        SnapshotInfo shifted;
+        shifted.gridMinX = -10;
+        shifted.gridMinY = -5;
+        shifted.gridWidth = 21;
+        shifted.gridHeight = 11;
+        std::vector<Position> blinker = {{-1, 0}, {0, 0}, {1, 0}};
+        writeSnapshotFile(path, shifted, blinker);
+        
+        SimulationController target(config);
+        target.loadSnapshot(path);
+        auto loaded = target.getLivingCells();
+        std::sort(loaded.begin(), loaded.end());
+        REQUIRE(target.getConfig().getGridWidth() == 21);
+        REQUIRE(target.getConfig().getGridHeight() == 11);
+        REQUIRE_FALSE(target.getConfig().getWrapEdges());
+        REQUIRE(loaded == std::vector<std::pair<std::int32_t, std::int32_t>>{{9, 5}, {10, 5}, {11, 5}});
+        
+        std::filesystem::remove(path);
+    }
+    
+    SECTION("RLE and macrocell patterns load and reset") {
+        const auto directory = std::filesystem::temp_directory_path();
+        const std::string rlePath = (directory / "entt_gol_glider.rle").string();
+        const std::string mcPath = (directory / "entt_gol_glider.mc").string();
+        std::ofstream(rlePath) << "#N Glider\n#P 4 4\nx = 3, y = 3, rule = B3/S23\nbob$2bo$3o!\n";
+        std::ofstream(mcPath) << "[M2] (golly 4.2)\n.*$..*$***$\n4 0 0 0 1\n";
+        
+        const std::vector<std::pair<std::int32_t, std::int32_t>> glider = {{0, 2}, {1, 0}, {1, 2}, {2, 1}, {2, 2}};
+        
+        GameConfig config;
+        config.setGridWidth(30);
+        config.setGridHeight(30);
+        SimulationController controller(config);
+        
+        controller.loadPattern(mcPath);
+        auto cells = controller.getLivingCells();
+        std::sort(cells.begin(), cells.end());
+        REQUIRE(cells == glider);
+        
+        controller.setDefaultPattern(rlePath);
+        controller.loadPattern(rlePath);
+        controller.step();
+        controller.reset();
+        cells = controller.getLivingCells();
+        std::sort(cells.begin(), cells.end());
+        REQUIRE(cells.size() == glider.size());
+        for (std::size_t i = 0; i < glider.size(); ++i) {
+            REQUIRE(cells[i] == std::pair{glider[i].first + 4, glider[i].second + 4});
+        }
+        
+        std::filesystem::remove(rlePath);
+        std::filesystem::remove(mcPath);
+    }
+    
+    SECTION("Engines hot-swap without losing the board") {
+        GameConfig config;
+        config.setGridWidth(60);
+        config.setGridHeight(40);
+        config.setWrapEdges(true);
+        SimulationController reference(config);
+        SimulationController controller(config);
+        
+        // Glider and blinker, worked on by a different engine every step
+        for (const auto& [x, y] : {std::pair{2, 1}, {3, 2}, {1, 3}, {2, 3}, {3, 3}, {40, 20}, {41, 20}, {42, 20}}) {
+            reference.setCellAlive(x, y);
+            controller.setCellAlive(x, y);
+        }
+        
+        for (int round = 0; round < 3; ++round) {
+            for (StorageEngine engine : {StorageEngine::Dense, StorageEngine::Tiled, StorageEngine::Packed,
+                                         StorageEngine::HashLife, StorageEngine::Sparse}) {
+                INFO("round " << round << ", engine " << static_cast<int>(engine));
+                GameConfig next = config;
+                next.setStorageEngine(engine);
+                controller.switchEngine(next);
+                REQUIRE(controller.getConfig().getStorageEngine() == engine);
+                
+                reference.step();
+                controller.step();
+                REQUIRE(controller.getStats().generation == reference.getStats().generation);
+                
+                auto expected = reference.getLivingCells();
+                auto actual = controller.getLivingCells();
+                std::sort(expected.begin(), expected.end());
+                std::sort(actual.begin(), actual.end());
+                REQUIRE(actual == expected);
+            }
+        }
+        
+        // Any LifeEngine plugs in
+        struct CountingEngine : GameOfLifeSimulation {
+            CountingEngine(const GameConfig& config, int& steps) : GameOfLifeSimulation(config), steps_(steps) {}
+            bool step() override {
+                ++steps_;
+                return GameOfLifeSimulation::step();
+            }
+            int& steps_;
+        };
+        
+        int steps = 0;
+        controller.setEngine(std::make_unique<CountingEngine>(config, steps));
+        auto result = controller.runHeadlessBatch(4);
+        REQUIRE(result.generations == 4);
+        REQUIRE(steps == 4);
+        REQUIRE(controller.getLivingCellCount() == 8);
+    }
+    
+    SECTION("Adaptive storage follows the live density") {
+        GameConfig config;
+        config.setGridWidth(120);
+        config.setGridHeight(120);
+        config.setWrapEdges(true);
+        config.setAutoPauseOnStable(false);
+        SimulationController reference(config);
+        
+        // A 30% soup starts dense and thins out below 7% within a few hundred generations
+        config.setAdaptiveStorage(true);
+        config.setDenseDensityThreshold(0.15);
+        config.setSparseDensityThreshold(0.07);
+        SimulationController controller(config);
+        
+        std::mt19937 rng(5);
+        std::bernoulli_distribution alive(0.3);
+        for (std::int32_t y = 0; y < 120; ++y) {
+            for (std::int32_t x = 0; x < 120; ++x) {
+                if (alive(rng)) {
+                    reference.setCellAlive(x, y);
+                    controller.setCellAlive(x, y);
+                }
+            }
+        }
+        
+        std::vector<StorageEngine> engines;
+        for (int generation = 0; generation < 400; ++generation) {
+            reference.step();
+            controller.step();
+            
+            const StorageEngine engine = controller.getConfig().getStorageEngine();
+            if (engines.empty() || engines.back() != engine) {
+                engines.push_back(engine);
+            }
+            REQUIRE(controller.getLivingCellCount() == reference.getLivingCellCount());
+            REQUIRE(controller.getLastStepChanges().born.size() == reference.getLastStepChanges().born.size());
+        }
+        
+        // One move each way; the threshold gap keeps it from flapping
+        REQUIRE(engines == std::vector<StorageEngine>{StorageEngine::Dense, StorageEngine::Sparse});
+        REQUIRE(reference.getConfig().getStorageEngine() == StorageEngine::Sparse);
+        
+        auto expected = reference.getLivingCells();
+        auto actual = controller.getLivingCells();
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        REQUIRE(actual == expected);
+    }
+    
+    SECTION("Engines advance several steps at once") {
+        for (StorageEngine engine : {StorageEngine::Sparse, StorageEngine::Dense, StorageEngine::Tiled,
+                                     StorageEngine::Packed, StorageEngine::HashLife}) {
+            INFO("engine " << static_cast<int>(engine));
+            GameConfig config;
+            config.setStorageEngine(engine);
+            auto simulation = createLifeEngine(config);
+            
+            // Blinker keeps changing for every step asked for; a block stops the run at once
+            for (const auto& [x, y] : {std::pair{10, 10}, {11, 10}, {12, 10}}) {
+                simulation->setCellAlive(x, y);
+            }
+            REQUIRE(simulation->advance(5) == 5);
+            REQUIRE(simulation->getGenerationCount() == 5);
+            
+            simulation->reset();
+            for (const auto& [x, y] : {std::pair{10, 10}, {11, 10}, {10, 11}, {11, 11}}) {
+                simulation->setCellAlive(x, y);
+            }
+            REQUIRE(simulation->advance(10) == 1);
+            REQUIRE(simulation->getLivingCellCount() == 4);
+            
+            // The skipped steps still count, up to the last generation there is
+            const std::uint64_t settled = simulation->getGenerationCount();
+            skipSettledSteps(*simulation, settled - 1, 1, 10);
+            REQUIRE(simulation->getGenerationCount() == settled + 9);
+            const std::uint64_t nearEnd = std::numeric_limits<std::uint64_t>::max() - 5;
+            simulation->setGenerationCount(nearEnd);
+            skipSettledSteps(*simulation, nearEnd, simulation->advance(10), 10);
+            REQUIRE(simulation->getGenerationCount() == std::numeric_limits<std::uint64_t>::max());
+        }
+    }
+    
+    SECTION("Several generations step in one call") {
+        GameConfig config;
+        config.setGridWidth(64);
+        config.setGridHeight(64);
+        config.setStorageEngine(StorageEngine::Tiled);
+        
+        SimulationController controller(config);
+        controller.setCellAlive(5, 4);
+        controller.setCellAlive(5, 5);
+        controller.setCellAlive(5, 6);
+        controller.step(9);
+        
+        // Changes span the whole call: after an odd count the blinker is turned
+        const auto& changes = controller.getLastStepChanges();
+        using Cells = std::vector<std::pair<std::int32_t, std::int32_t>>;
+        REQUIRE(controller.getStats().generation == 9);
+        REQUIRE(changes.generation == 9);
+        REQUIRE(std::is_permutation(changes.born.begin(), changes.born.end(), Cells{{4, 5}, {6, 5}}.begin()));
+        REQUIRE(std::is_permutation(changes.died.begin(), changes.died.end(), Cells{{5, 4}, {5, 6}}.begin()));
+        
+        // A still life settles the call early; the generation still moves on
+        controller.reset();
+        for (const auto& [x, y] : {std::pair{10, 10}, {11, 10}, {10, 11}, {11, 11}}) {
+            controller.setCellAlive(x, y);
+        }
+        controller.step(20);
+        REQUIRE(controller.getStats().generation == 20);
+        REQUIRE(controller.getStats().isStable);
+        REQUIRE(controller.getLastStepChanges().born.empty());
+        
+        // Single steps pick the cycle history back up
+        controller.step();
+        REQUIRE(controller.getStats().generation == 21);
+    }
+    
+    SECTION("Engines report the memory their board holds") {
+        for (StorageEngine engine : {StorageEngine::Sparse, StorageEngine::Dense, StorageEngine::Tiled,
+                                     StorageEngine::Packed, StorageEngine::HashLife}) {
+            INFO("engine " << static_cast<int>(engine));
+            GameConfig config;
+            config.setGridWidth(200);
+            config.setGridHeight(200);
+            config.setStorageEngine(engine);
+            auto simulation = createLifeEngine(config);
+            const std::size_t empty = simulation->getMemoryUsage();
+            
+            std::vector<Position> cells;
+            for (std::int32_t y = 0; y < 200; y += 3) {
+                for (std::int32_t x = 0; x < 200; x += 2) {
+                    cells.emplace_back(x, y);
+                }
+            }
+            simulation->setCellsAlive(cells);
+            simulation->step();
+            REQUIRE(simulation->getMemoryUsage() > empty);
+            REQUIRE(simulation->getMemoryUsage() >= 200 * 200 / 8); // At least one bit per grid cell
+        }
+    }
+    
+    SECTION("Steps stop at the memory limit") {
+        GameConfig config;
+        config.setGridWidth(500);
+        config.setGridHeight(500);
+        config.setMemoryLimitMb(1);
+        SimulationController controller(config);
+        
+        // Far more than a megabyte of entities and index slots
+        for (std::int32_t y = 0; y < 500; y += 2) {
+            for (std::int32_t x = 0; x < 500; x += 2) {
+                controller.setCellAlive(x, y);
+            }
+        }
+        controller.start();
+        controller.step();
+        REQUIRE(controller.getStats().memoryLimitReached);
+        REQUIRE(controller.getStats().memoryBytes > 1024 * 1024);
+        REQUIRE(controller.getStats().generation == 0);
+        REQUIRE(controller.getState() == SimulationState::Paused);
+        
+        const auto result = controller.runHeadlessBatch(10);
+        REQUIRE(result.generations == 0);
+        REQUIRE(result.stoppedEarly);
+        
+        // A small board steps again
+        controller.reset();
+        controller.setCellAlive(10, 10);
+        controller.step();
+        REQUIRE(controller.getStats().generation == 1);
+        REQUIRE_FALSE(controller.getStats().memoryLimitReached);
+    }
+
+    SECTION("Stepping back and seeking restore earlier boards") {
+        GameConfig config;
+        config.setGridWidth(40);
+        config.setGridHeight(40);
+        config.setAutoPauseOnStable(false);
+        SimulationController controller(config);
+
+        std::mt19937 rng(9);
+        std::bernoulli_distribution alive(0.3);
+        for (std::int32_t y = 0; y < 40; ++y) {
+            for (std::int32_t x = 0; x < 40; ++x) {
+                if (alive(rng)) {
+                    controller.setCellAlive(x, y);
+                }
+            }
+        }
+
+        auto sortedCells = [&controller] {
+            auto cells = controller.getLivingCells();
+            std::sort(cells.begin(), cells.end());
+            return cells;
+        };
+        std::vector<std::vector<std::pair<std::int32_t, std::int32_t>>> boards{sortedCells()};
+        for (int generation = 1; generation <= 200; ++generation) {
+            controller.step();
+            boards.push_back(sortedCells());
+        }
+        controller.step(10); // One entry for all ten
+        boards.resize(211);
+        boards[210] = sortedCells();
+
+        REQUIRE(controller.stepBack());
+        REQUIRE(controller.getStats().generation == 200);
+        REQUIRE(sortedCells() == boards[200]);
+        REQUIRE(controller.getStats().livingCells == boards[200].size());
+        for (std::uint64_t target : {199u, 3u, 150u, 0u, 210u, 130u}) {
+            REQUIRE(controller.seek(target) == target);
+            REQUIRE(sortedCells() == boards[target]);
+        }
+        REQUIRE(controller.seek(205) == 200); // Inside the ten-step entry
+
+        // Seeking past the newest entry simulates the rest
+        controller.seek(210);
+        REQUIRE(controller.seek(215) == 215);
+        REQUIRE(controller.getHistory().getNewestGeneration() == 215);
+
+        // An edit after rewinding drops the entries after it
+        controller.seek(100);
+        controller.setCellAlive(0, 0);
+        auto edited = boards[100];
+        if (!std::binary_search(edited.begin(), edited.end(), std::make_pair(0, 0))) {
+            edited.insert(std::lower_bound(edited.begin(), edited.end(), std::make_pair(0, 0)), {0, 0});
+        }
+        REQUIRE(controller.getHistory().getNewestGeneration() == 100);
+        controller.step();
+        controller.stepBack();
+        REQUIRE(sortedCells() == edited);
+        REQUIRE(controller.seek(0) == 0);
+        REQUIRE(sortedCells() == boards[0]);
+
+        // A reset starts the journal over
+        controller.reset();
+        REQUIRE_FALSE(controller.stepBack());
+    }
+
+    SECTION("A history budget of zero keeps no journal") {
+        GameConfig config;
+        config.setGridWidth(20);
+        config.setGridHeight(20);
+        config.setHistoryBudgetMb(0);
+        SimulationController controller(config);
+        controller.setCellAlive(5, 5);
+        controller.setCellAlive(6, 5);
+        controller.setCellAlive(7, 5);
+        controller.step();
+        controller.step();
+        REQUIRE_FALSE(controller.stepBack());
+        REQUIRE(controller.getHistory().empty());
+        REQUIRE(controller.seek(0) == 2); // Already past it
+        REQUIRE(controller.seek(5) == 5);
+    }
+    
+    SECTION("The population pyramid follows steps, edits and history") {
+        GameConfig config;
+        config.setGridWidth(64);
+        config.setGridHeight(64);
+        config.setWrapEdges(true);
+        config.setStorageEngine(StorageEngine::Dense);
+        SimulationController controller(config);
+        std::mt19937 rng(9);
+        for (int i = 0; i < 900; ++i) {
+            controller.setCellAlive(static_cast<std::int32_t>(rng() % 40), static_cast<std::int32_t>(rng() % 40));
+        }
+        
+        // Every 8x8 and 32x32 block agrees with the engine's cells
+        auto requireCounts = [&controller] {
+            const auto& pyramid = controller.getPopulationPyramid();
+            REQUIRE(pyramid.size() == controller.getLivingCellCount());
+            for (std::uint32_t scale : {3u, 5u}) {
+                const std::int32_t blocks = 64 >> scale;
+                for (std::int32_t blockY = 0; blockY < blocks; ++blockY) {
+                    for (std::int32_t blockX = 0; blockX < blocks; ++blockX) {
+                        std::vector<Position> cells;
+                        const std::int32_t side = 1 << scale;
+                        controller.getLivingCellsInRegion(blockX * side, blockX * side + side - 1,
+                                                          blockY * side, blockY * side + side - 1, cells);
+                        REQUIRE(pyramid.countBlock(scale, blockX, blockY) == cells.size());
+                    }
+                }
+            }
+        };
+        requireCounts();
+        
+        for (int i = 0; i < 5; ++i) {
+            controller.step();
+        }
+        requireCounts();
+        controller.step(6);
+        requireCounts();
+        controller.stepBack();
+        requireCounts();
+        controller.seek(2);
+        requireCounts();
+        controller.runHeadlessBatch(20);
+        requireCounts();
+        controller.reset();
+        requireCounts();
+    }
+    
+    SECTION("Frames advance batches of generations within their budget") {
+        GameConfig config;
+        config.setGridWidth(32);
+        config.setGridHeight(32);
+        config.setWrapEdges(true);
+        config.setGenerationsPerFrame(4);
+        auto withGlider = [](const GameConfig& glider) {
+            auto controller = std::make_unique<SimulationController>(glider);
+            for (auto [x, y] : {std::pair{1, 0}, std::pair{2, 1}, std::pair{0, 2}, std::pair{1, 2}, std::pair{2, 2}}) {
+                controller->setCellAlive(x, y);
+            }
+            return controller;
+        };
+        
+        auto fixed = withGlider(config);
+        REQUIRE(fixed->stepFrame() == 4);
+        REQUIRE(fixed->getStats().generation == 4);
+        REQUIRE(fixed->getStats().frameGenerations == 4);
+        
+        // A glider on a torus never settles, so a budgeted frame takes batch after batch
+        config.setFrameStepBudgetMs(20);
+        auto budgeted = withGlider(config);
+        const auto taken = budgeted->stepFrame();
+        REQUIRE(taken > 4);
+        REQUIRE(taken % 4 == 0);
+        REQUIRE(budgeted->getStats().generation == taken);
+        REQUIRE(budgeted->getLivingCellCount() == 5);
+    }
+    
+    SECTION("Checkpoints are written every interval without stopping the run") {
+        const auto temp = std::filesystem::temp_directory_path();
+        const std::string path = (temp / "entt_gol_controller_checkpoint.gols").string();
+        const std::string manual = (temp / "entt_gol_controller_manual.gols").string();
+        std::filesystem::remove(path);
+        
+        GameConfig config;
+        config.setGridWidth(40);
+        config.setGridHeight(40);
+        config.setWrapEdges(true);
+        config.setCheckpointPath(path);
+        config.setCheckpointInterval(10);
+        config.setAutoPauseOnStable(false); // Batches keep stepping the glider
+        SimulationController controller(config);
+        for (const auto& [x, y] : {std::pair{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}}) {
+            controller.setCellAlive(x, y);
+        }
+        auto sortedCells = [](const SimulationController& from) {
+            auto cells = from.getLivingCells();
+            std::sort(cells.begin(), cells.end());
+            return cells;
+        };
+        
+        std::vector<std::vector<std::pair<std::int32_t, std::int32_t>>> boards;
+        for (int generation = 1; generation <= 25; ++generation) {
+            controller.step();
+            boards.push_back(sortedCells(controller));
+        }
+        controller.waitForCheckpoints();
+        auto stats = controller.getCheckpointStats();
+        REQUIRE(stats.written + stats.superseded == 2); // At 10 and 20
+        REQUIRE(stats.lastGeneration == 20);
+        
+        SimulationController resumed;
+        resumed.loadSnapshot(path);
+        REQUIRE(resumed.getStats().generation == 20);
+        REQUIRE(sortedCells(resumed) == boards[19]);
+        
+        // Several generations in one call, and headless batches, checkpoint where they cross
+        controller.step(7);
+        controller.waitForCheckpoints();
+        REQUIRE(controller.getCheckpointStats().lastGeneration == 32);
+        controller.runHeadlessBatch(10);
+        controller.waitForCheckpoints();
+        REQUIRE(controller.getCheckpointStats().lastGeneration == 40);
+        
+        // On demand, to another file, holding the board it was asked for
+        controller.checkpoint(manual);
+        const auto expected = sortedCells(controller);
+        controller.step();
+        controller.waitForCheckpoints();
+        resumed.loadSnapshot(manual);
+        REQUIRE(resumed.getStats().generation == 42);
+        REQUIRE(sortedCells(resumed) == expected);
+        REQUIRE(resumed.getConfig().getWrapEdges());
+        REQUIRE(controller.getCheckpointStats().failed == 0);
+        
+        std::filesystem::remove(path);
+        std::filesystem::remove(manual);
+    }
 }
 
 TEST_CASE("Model/View separation validation", "[ModelViewSeparation]") {
@@ -5,6 +5,9 @@
 #include "core/GameConfig.h"
 #include <memory>
 #include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
 
 TEST_CASE("Model-View separation validation", "[ModelViewSeparation]") {
     SECTION("Controller operates independently of view components") {
@@ -121,6 +124,49 @@ TEST_CASE("Model-View separation validation", "[ModelViewSeparation]") {
         
         controller.runHeadless(1);
         REQUIRE(callbackCalled == true);
+    }    
+    SECTION("Renderer redraws only the rows that changed") {
+        GameConfig config;
+        config.setGridWidth(20);
+        config.setGridHeight(20);
+        SimulationController controller(config);
+        controller.setCellAlive(5, 4);
+        controller.setCellAlive(5, 5);
+        controller.setCellAlive(5, 6);
+        
+        RenderConfig renderConfig;
+        renderConfig.showStats = false;
+        renderConfig.showControls = false;
+        renderConfig.showBorder = false;
+        renderConfig.viewportWidth = 20;
+        renderConfig.viewportHeight = 10;
+        ConsoleRenderer renderer(renderConfig);
+        
+        std::ostringstream captured;
+        auto* original = std::cout.rdbuf(captured.rdbuf());
+        
+        renderer.render(controller);
+        std::string firstFrame = captured.str();
+        captured.str("");
+        
+        // Nothing changed: nothing is written
+        renderer.render(controller);
+        std::string unchangedFrame = captured.str();
+        captured.str("");
+        
+        // The blinker turns: rows 4 and 6 lose their cell, row 5 gains two
+        controller.step();
+        renderer.render(controller);
+        std::string steppedFrame = captured.str();
+        
+        std::cout.rdbuf(original);
+        
+        REQUIRE(firstFrame.find("\033[2J") != std::string::npos);
+        REQUIRE(unchangedFrame.empty());
+        REQUIRE(steppedFrame.find("\033[5;1H") != std::string::npos);
+        REQUIRE(steppedFrame.find("\033[6;1H    ###") != std::string::npos);
+        REQUIRE(steppedFrame.find("\033[7;1H") != std::string::npos);
+        REQUIRE(steppedFrame.find("\033[1;1H") == std::string::npos);
     }
 }
 
@@ -4,6 +4,7 @@
 #include "core/GameConfig.h"
 #include <chrono>
 #include <fstream>
+#include <random>
 
 // Helper function to create patterns programmatically for testing
 void createGliderPattern(SimulationController& controller, std::int32_t x, std::int32_t y) {
@@ -24,9 +25,10 @@ void createRandomPattern(SimulationController& controller, std::int32_t density)
     const auto& config = controller.getConfig();
     
     // Create random pattern with given density percentage
+    std::mt19937 rng(42);
     for (std::int32_t x = 0; x < config.getGridWidth(); ++x) {
         for (std::int32_t y = 0; y < config.getGridHeight(); ++y) {
-            if (rand() % 100 < density) {
+            if (static_cast<std::int32_t>(rng() % 100) < density) {
                 // Would need method to set individual cells
                 // controller.setCellAlive(x, y);
             }
@@ -3,6 +3,7 @@
 #include "core/GameOfLifeSimulation.h"
 #include "core/GameConfig.h"
 #include <chrono>
+#include <random>
 
 TEST_CASE("Performance benchmarks", "[Performance]") {
     SECTION("Small grid performance (100x100)") {
@@ -13,9 +14,10 @@ TEST_CASE("Performance benchmarks", "[Performance]") {
         GameOfLifeSimulation simulation(config);
         
         // Create random pattern with ~10% density
+        std::mt19937 rng(42);
         for (int i = 0; i < 1000; ++i) {
-            int x = rand() % 100;
-            int y = rand() % 100;
+            int x = static_cast<int>(rng() % 100);
+            int y = static_cast<int>(rng() % 100);
             simulation.setCellAlive(x, y);
         }
         
@@ -33,9 +35,10 @@ TEST_CASE("Performance benchmarks", "[Performance]") {
         GameOfLifeSimulation simulation(config);
         
         // Create pattern with ~5% density
+        std::mt19937 rng(42);
         for (int i = 0; i < 12500; ++i) {
-            int x = rand() % 500;
-            int y = rand() % 500;
+            int x = static_cast<int>(rng() % 500);
+            int y = static_cast<int>(rng() % 500);
             simulation.setCellAlive(x, y);
         }
         
@@ -53,9 +56,10 @@ TEST_CASE("Performance benchmarks", "[Performance]") {
         GameOfLifeSimulation simulation(config);
         
         // Create sparse pattern with ~1% density
+        std::mt19937 rng(42);
         for (int i = 0; i < 10000; ++i) {
-            int x = rand() % 1000;
-            int y = rand() % 1000;
+            int x = static_cast<int>(rng() % 1000);
+            int y = static_cast<int>(rng() % 1000);
             simulation.setCellAlive(x, y);
         }
         
@@ -148,9 +152,10 @@ TEST_CASE("Performance requirements validation", "[Performance]") {
         GameOfLifeSimulation simulation(config);
         
         // Create moderate density pattern (~5%)
+        std::mt19937 rng(42);
         for (int i = 0; i < 12500; ++i) {
-            int x = rand() % 500;
-            int y = rand() % 500;
+            int x = static_cast<int>(rng() % 500);
+            int y = static_cast<int>(rng() % 500);
             simulation.setCellAlive(x, y);
         }
         
@@ -182,9 +187,10 @@ TEST_CASE("Performance requirements validation", "[Performance]") {
         GameOfLifeSimulation simulation(config);
         
         // Create pattern that should stay under memory limit
+        std::mt19937 rng(42);
         for (int i = 0; i < 50000; ++i) { // 5% density
-            int x = rand() % 1000;
-            int y = rand() % 1000;
+            int x = static_cast<int>(rng() % 1000);
+            int y = static_cast<int>(rng() % 1000);
             simulation.setCellAlive(x, y);
         }
         
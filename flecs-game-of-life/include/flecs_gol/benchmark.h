@@ -0,0 +1,67 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <flecs_gol/game_config.h>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace flecs_gol {
+
+// Standard workloads for comparing storage engines, and this build against
+// the EnTT one. Both builds define the workloads the same way: the shared
+// patterns/*.json corpus and seeded random soups, on boards whose cells run
+// from (0, 0) to (width - 1, height - 1) without wrapping.
+
+struct BenchmarkWorkload {
+    std::string name;
+    int32_t width = 0;
+    int32_t height = 0;
+    std::vector<Position> cells;
+    uint32_t generations = 0;
+};
+
+struct BenchmarkResult {
+    std::string engine;
+    std::string workload;
+    uint32_t generations = 0;
+    uint64_t medianNanosPerStep = 0; // Over the repetitions
+    uint64_t minNanosPerStep = 0;
+    size_t finalCells = 0;
+    size_t memoryBytes = 0; // Engine-reported, after the last step
+};
+
+struct BenchmarkRegression {
+    std::string key; // "<engine>/<workload>"
+    uint64_t baselineNanosPerStep = 0;
+    uint64_t currentNanosPerStep = 0;
+};
+
+// Each cell alive with probability density, drawn row by row from
+// std::mt19937(seed) as rng() < density * 2^32 so every standard library
+// produces the same soup
+std::vector<Position> makeSoup(int32_t width, int32_t height, double density, uint32_t seed);
+
+// Every pattern in patternDirectory (sorted by name) centred on a 256x256
+// board, then soups of density 0.1, 0.25 and 0.5 on 64, 256 and 1024 square
+// boards. quick drops the 1024 boards.
+std::vector<BenchmarkWorkload> makeStandardWorkloads(const std::string& patternDirectory, bool quick = false);
+
+// Steps a fresh engine through the workload repetitions times; loading the
+// cells is not timed
+BenchmarkResult runBenchmark(const GameConfig& baseConfig, EngineType engine, const BenchmarkWorkload& workload,
+                             uint32_t repetitions);
+
+// {"timestamp", "baseline_type": "benchmark", "validator", "benchmarks":
+// {"<engine>/<workload>": {...}}}, in the shape of the meta/memory baselines
+nlohmann::json benchmarkResultsToJson(std::span<const BenchmarkResult> results, const std::string& validator);
+
+// Benchmarks whose median step time in current is more than tolerance
+// (0.1 = 10%) above baseline. Keys missing from either side are skipped.
+std::vector<BenchmarkRegression> findRegressions(const nlohmann::json& baseline, const nlohmann::json& current,
+                                                 double tolerance);
+
+} // namespace flecs_gol
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <flecs_gol/snapshot_file.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace flecs_gol {
+
+struct CheckpointStats {
+    uint64_t written = 0;
+    uint64_t superseded = 0;    // Dropped for a newer checkpoint to the same file before it was written
+    uint64_t failed = 0;
+    uint64_t lastGeneration = 0;  // Of the last checkpoint written
+    std::chrono::nanoseconds lastWriteTime{0};  // Encoding, writing and syncing it
+    std::string lastError;
+};
+
+// Writes snapshot files (snapshot_file.h) on a thread of its own, each one
+// synced to disk and renamed into place. Callers hand over a frozen copy of
+// the board - typically a shared immutable snapshot - and carry on stepping;
+// the cells are pulled from it, sorted and encoded on the writer thread.
+//
+// Checkpoints are written in the order submitted. One still waiting when
+// another arrives for the same file is dropped for it, so a slow disk holds
+// at most one pending board per file. Failures are counted, not thrown.
+class CheckpointWriter {
+public:
+    // Fills out with the board's live cells, in any order; called on the writer thread
+    using CellSource = std::function<void(std::vector<Position>& out)>;
+
+    CheckpointWriter() = default;
+    ~CheckpointWriter();  // Writes what is still queued
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    void submit(const std::string& path, const SnapshotInfo& info, CellSource cells);
+
+    // Blocks until every checkpoint submitted so far is written or has failed
+    void waitIdle();
+
+    CheckpointStats getStats() const;
+
+private:
+    struct Job {
+        std::string path;
+        SnapshotInfo info;
+        CellSource cells;
+    };
+
+    void writerLoop();
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::deque<Job> queue_;
+    bool writing_ = false;
+    bool stopping_ = false;
+    CheckpointStats stats_;
+    std::thread thread_;  // Started by the first submit
+};
+
+} // namespace flecs_gol
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <flecs_gol/simulation_engine.h>
+#include <flecs_gol/coordinate_map.h>
+#include <flecs_gol/dense_kernels.h>
+#include <array>
+#include <limits>
+#include <vector>
+
+namespace flecs_gol {
+
+// Unbounded plane of bit-packed 64x64 chunks, allocated only where there are
+// live cells. Any 32-bit position is valid; grid boundaries and edge wrapping
+// are ignored, so memory follows the active area instead of a bounding box.
+//
+// Chunks are found through a CoordinateMap keyed by chunk coordinate (the
+// cell coordinate shifted right by 6, packed into one 64-bit key). A step
+// visits every chunk plus each missing neighbor its border cells could give
+// birth in, runs the dense kernel over a halo gathered from the up to eight
+// chunks around it, and keeps only the chunks that still hold a live cell:
+// a chunk is freed the generation it becomes empty.
+class ChunkedPlane : public SimulationEngine {
+public:
+    static constexpr int32_t CHUNK_SIZE = 64;
+
+    explicit ChunkedPlane(const LifeRule& rule = {});
+    ~ChunkedPlane() override = default;
+
+    // SimulationEngine interface
+    bool setCell(int32_t x, int32_t y, bool alive) override;
+    bool isCellAlive(int32_t x, int32_t y) const override;
+    uint8_t getNeighborCount(int32_t x, int32_t y) const override;
+
+    void step() override;
+    void clear() override;
+
+    uint32_t getCellCount() const override { return population_; }
+    size_t getMemoryUsage() const override;
+    bool getActiveBounds(int32_t& minX, int32_t& maxX, int32_t& minY, int32_t& maxY) const override;
+    void collectChanges(std::vector<Position>& born, std::vector<Position>& died) const override;
+
+    void collectLiveCells(std::vector<Position>& out) const override;
+    void collectCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                              std::vector<Position>& out) const override;
+
+    // Chunks currently allocated
+    size_t getChunkCount() const { return chunks_.size(); }
+
+private:
+    using Rows = std::array<uint64_t, CHUNK_SIZE>;
+
+    struct Chunk {
+        Position coord; // Chunk coordinate; cell (x, y) lives in chunk (x >> 6, y >> 6)
+        Rows rows;
+    };
+
+    // Chunk coordinates whose cells all have 32-bit coordinates
+    static constexpr int32_t MIN_CHUNK = std::numeric_limits<int32_t>::min() / CHUNK_SIZE;
+    static constexpr int32_t MAX_CHUNK = std::numeric_limits<int32_t>::max() / CHUNK_SIZE;
+
+    static Position chunkOf(int32_t x, int32_t y) { return Position(x >> 6, y >> 6); }
+
+    static const Rows* findRows(const std::vector<Chunk>& chunks, const CoordinateMap<uint32_t>& index,
+                                Position coord);
+    void addCandidates(const Chunk& chunk);
+    // Appends the chunk's next generation to previous_ if it has live cells; true if it changed
+    bool stepChunk(Position coord, uint32_t& population);
+    void markChanged(Position coord);
+
+    DenseKernel kernel_;
+    LifeRule rule_;
+    bool conwayRule_; // B3/S23 takes the kernel's dedicated stepRow
+
+    // Current generation, and the previous one once a step has run. A step
+    // writes the next generation over the previous one and swaps the two.
+    std::vector<Chunk> chunks_;
+    CoordinateMap<uint32_t> index_; // Chunk coordinate -> slot in chunks_
+    std::vector<Chunk> previous_;
+    CoordinateMap<uint32_t> previousIndex_;
+    uint32_t population_ = 0;
+
+    std::vector<Position> candidates_; // Step scratch: chunk coordinates to step, sorted
+
+    // Chunks changed by the last step or edited since, for getActiveBounds()
+    Position changedMin_;
+    Position changedMax_;
+    bool anyChanged_ = false;
+};
+
+} // namespace flecs_gol
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <functional>
 
 namespace flecs_gol {
 
@@ -9,8 +10,8 @@ struct Position {
     int32_t x;
     int32_t y;
     
-    Position() : x(0), y(0) {}
-    Position(int32_t x, int32_t y) : x(x), y(y) {}
+    constexpr Position() : x(0), y(0) {}
+    constexpr Position(int32_t x, int32_t y) : x(x), y(y) {}
     
     bool operator==(const Position& other) const {
         return x == other.x && y == other.y;
@@ -25,12 +26,49 @@ struct Position {
         return y < other.y;
     }
     
+    // Both coordinates in one 64-bit key, x in the high half
+    uint64_t packed() const {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+    
+    // Z-order (Morton) key: the bits of x and y interleaved, x in the even
+    // bits. Sign bits are flipped so the order runs from negative to positive.
+    uint64_t morton() const {
+        return spreadBits(static_cast<uint32_t>(x) ^ 0x80000000u) |
+               (spreadBits(static_cast<uint32_t>(y) ^ 0x80000000u) << 1);
+    }
+    
     // Hash function for spatial indexing
-    size_t hash() const {
-        return (static_cast<size_t>(x) << 32) | static_cast<size_t>(y);
+    size_t hash() const;
+
+private:
+    // Moves bit i of value to bit 2i
+    static uint64_t spreadBits(uint32_t value) {
+        uint64_t bits = value;
+        bits = (bits | (bits << 16)) & 0x0000ffff0000ffffull;
+        bits = (bits | (bits << 8)) & 0x00ff00ff00ff00ffull;
+        bits = (bits | (bits << 4)) & 0x0f0f0f0f0f0f0f0full;
+        bits = (bits | (bits << 2)) & 0x3333333333333333ull;
+        bits = (bits | (bits << 1)) & 0x5555555555555555ull;
+        return bits;
     }
 };
 
+// splitmix64 finalizer: every input bit affects every output bit, so packed
+// coordinates of diagonal or negative-valued patterns still spread evenly
+inline uint64_t mixCoordinateKey(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return key;
+}
+
+inline size_t Position::hash() const {
+    return static_cast<size_t>(mixCoordinateKey(packed()));
+}
+
 struct Cell {
     uint8_t neighborCount = 0;
     bool willLive = false;  // Computed during rule evaluation phase
@@ -42,16 +80,23 @@ struct Cell {
 // Optional component for cells that are about to be born
 struct BirthCandidate {
     uint8_t neighborCount = 0;
+    bool willBeBorn = false;  // Computed during rule evaluation phase
     
     BirthCandidate() = default;
-    BirthCandidate(uint8_t neighbors) : neighborCount(neighbors) {}
+    BirthCandidate(uint8_t neighbors) : neighborCount(neighbors), willBeBorn(false) {}
 };
 
+// Pipeline phase tags - each simulation system is registered under one phase
+struct NeighborCountPhase {};
+struct RuleEvaluationPhase {};
+struct LifecyclePhase {};
+
 // Grid metadata (singleton component)
 struct GridState {
     uint32_t generation = 0;
     uint32_t liveCellCount = 0;
     int32_t minX = 0, maxX = 0, minY = 0, maxY = 0; // Current bounds of active area
+    bool hasActiveArea = false; // False when the last step changed nothing
     
     GridState() = default;
 };
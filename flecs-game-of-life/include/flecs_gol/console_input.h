@@ -23,6 +23,7 @@ enum class InputEvent {
     // Simulation control
     PAUSE_RESUME,      // Space bar
     STEP,              // S key
+    STEP_BACK,         // , or < key
     RESET,             // R key
     QUIT,              // Q key or Escape
     
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <flecs_gol/simulation_controller.h>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -13,6 +14,10 @@ struct ViewportConfig {
     uint32_t width = 80;
     uint32_t height = 24;
     bool autoCenter = false; // Auto-center on cell activity
+    // Each character covers 2^scaleLog2 cells a side; above 0 the view is an
+    // overview shaded by block density, read from the snapshot's population
+    // pyramid (RegionIndex::countBlock) at one lookup per character
+    uint32_t scaleLog2 = 0;
     bool showBorder = true;
     bool showUI = true;
     
@@ -37,9 +42,9 @@ public:
     
     // Viewport control
     void setViewport(int32_t centerX, int32_t centerY);
-    void moveViewport(int32_t deltaX, int32_t deltaY);
-    void zoomIn();  // Decrease viewport size
-    void zoomOut(); // Increase viewport size
+    void moveViewport(int32_t deltaX, int32_t deltaY);  // By characters, so by blocks when zoomed out
+    void zoomIn();  // Halve the scale, then decrease viewport size
+    void zoomOut(); // Increase viewport size, then double the scale once it fills the terminal
     void resetViewport();
     void setAutoCenter(bool enabled);
     
@@ -59,14 +64,15 @@ public:
     
 private:
     // Internal rendering methods
-    void renderGrid(const std::vector<CellData>& cells);
+    void renderGrid(std::span<const Position> cells);
+    void renderOverview(const RegionIndex& cells);
     void renderBorder();
     void renderUI(const SimulationState& state);
     void renderHelp();
     
     // Viewport calculations
     std::pair<int32_t, int32_t> calculateBounds() const;
-    std::pair<int32_t, int32_t> findActivityCenter(const std::vector<CellData>& cells) const;
+    std::pair<int32_t, int32_t> findActivityCenter(std::span<const Position> cells) const;
     bool isInViewport(int32_t x, int32_t y) const;
     std::pair<uint32_t, uint32_t> worldToScreen(int32_t worldX, int32_t worldY) const;
     std::pair<int32_t, int32_t> screenToWorld(uint32_t screenX, uint32_t screenY) const;
@@ -90,6 +96,9 @@ private:
     std::vector<std::vector<char>> screenBuffer_;
     bool bufferInitialized_ = false;
     
+    // Viewport cells of the current frame, reused across frames
+    std::vector<Position> viewportCells_;
+    
     // Terminal state
     bool terminalInitialized_ = false;
     uint32_t terminalWidth_ = 80;
@@ -100,6 +109,9 @@ private:
     double renderFPS_ = 0.0;
     
     // Color codes for terminal output
+    // Overview shading, sparsest first; a block half alive or more gets the last
+    static constexpr const char* DENSITY_RAMP = ".:-=+*#%@";
+    
     static constexpr const char* COLOR_RESET = "\033[0m";
     static constexpr const char* COLOR_GREEN = "\033[32m";
     static constexpr const char* COLOR_BRIGHT_GREEN = "\033[92m";
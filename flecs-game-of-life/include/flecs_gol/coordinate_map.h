@@ -0,0 +1,234 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace flecs_gol {
+
+// Flat open-addressing hash map keyed by cell position.
+//
+// Entries live in one power-of-two slot array and are found by linear
+// probing from the mixed 64-bit packed coordinate (see Position::packed()),
+// so a lookup touches one or two cache lines instead of chasing a node list.
+// Erasing shifts the following entries of the probe run back, which keeps
+// lookups tombstone-free. Any insert or erase invalidates iterators.
+template <typename Value>
+class CoordinateMap {
+public:
+    using value_type = std::pair<Position, Value>;
+
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = CoordinateMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+        using MapPtr = std::conditional_t<Const, const CoordinateMap*, CoordinateMap*>;
+
+        Iterator() = default;
+        Iterator(MapPtr map, size_t slot) : map_(map), slot_(slot) { skipEmpty(); }
+
+        // Mutable iterators convert to const ones
+        operator Iterator<true>() const requires (!Const) { return Iterator<true>(map_, slot_); }
+
+        reference operator*() const { return map_->slots_[slot_]; }
+        pointer operator->() const { return &map_->slots_[slot_]; }
+
+        Iterator& operator++() {
+            ++slot_;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return slot_ == other.slot_; }
+        bool operator!=(const Iterator& other) const { return slot_ != other.slot_; }
+
+    private:
+        friend class CoordinateMap;
+
+        void skipEmpty() {
+            while (slot_ < map_->used_.size() && map_->used_[slot_] == 0) {
+                ++slot_;
+            }
+        }
+
+        MapPtr map_ = nullptr;
+        size_t slot_ = 0;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    CoordinateMap() = default;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, used_.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, used_.size()); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return slots_.size(); }
+    size_t getMemoryUsage() const { return slots_.capacity() * sizeof(value_type) + used_.capacity(); }
+
+    iterator find(const Position& pos) {
+        size_t slot = findSlot(pos);
+        return slot == NOT_FOUND ? end() : iterator(this, slot);
+    }
+
+    const_iterator find(const Position& pos) const {
+        size_t slot = findSlot(pos);
+        return slot == NOT_FOUND ? end() : const_iterator(this, slot);
+    }
+
+    bool contains(const Position& pos) const { return findSlot(pos) != NOT_FOUND; }
+
+    // Inserts a default-constructed value if the position is missing
+    Value& operator[](const Position& pos) {
+        return slots_[insertSlot(pos)].second;
+    }
+
+    // Returns false (and leaves the value alone) if the position is present
+    bool insert(const Position& pos, const Value& value) {
+        size_t before = size_;
+        size_t slot = insertSlot(pos);
+        if (size_ == before) {
+            return false;
+        }
+        slots_[slot].second = value;
+        return true;
+    }
+
+    size_t erase(const Position& pos) {
+        size_t slot = findSlot(pos);
+        if (slot == NOT_FOUND) {
+            return 0;
+        }
+        eraseSlot(slot);
+        return 1;
+    }
+
+    void erase(const_iterator it) { eraseSlot(it.slot_); }
+    void erase(iterator it) { eraseSlot(it.slot_); }
+
+    // Keeps the slot array so refilling to a similar size does not rehash
+    void clear() {
+        for (size_t slot = 0; slot < slots_.size(); ++slot) {
+            if (used_[slot] != 0) {
+                slots_[slot] = value_type();
+                used_[slot] = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+    // Grows the slot array so that count entries fit without rehashing
+    void reserve(size_t count) {
+        size_t needed = MIN_CAPACITY;
+        while (needed * MAX_LOAD_NUM < count * MAX_LOAD_DEN) {
+            needed *= 2;
+        }
+        if (needed > slots_.size()) {
+            rehash(needed);
+        }
+    }
+
+private:
+    static constexpr size_t NOT_FOUND = ~size_t{0};
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    // Maximum load factor of 1/2. Most neighbor lookups miss, and a miss
+    // under linear probing scans the whole run, which grows fast past 1/2.
+    static constexpr size_t MAX_LOAD_NUM = 1;
+    static constexpr size_t MAX_LOAD_DEN = 2;
+
+    size_t homeSlot(const Position& pos) const {
+        return static_cast<size_t>(mixCoordinateKey(pos.packed())) & (slots_.size() - 1);
+    }
+
+    size_t findSlot(const Position& pos) const {
+        if (size_ == 0) {
+            return NOT_FOUND;
+        }
+
+        const size_t mask = slots_.size() - 1;
+        for (size_t slot = homeSlot(pos);; slot = (slot + 1) & mask) {
+            if (used_[slot] == 0) {
+                return NOT_FOUND;
+            }
+            if (slots_[slot].first == pos) {
+                return slot;
+            }
+        }
+    }
+
+    size_t insertSlot(const Position& pos) {
+        if ((size_ + 1) * MAX_LOAD_DEN > slots_.size() * MAX_LOAD_NUM) {
+            rehash(slots_.empty() ? MIN_CAPACITY : slots_.size() * 2);
+        }
+
+        const size_t mask = slots_.size() - 1;
+        for (size_t slot = homeSlot(pos);; slot = (slot + 1) & mask) {
+            if (used_[slot] == 0) {
+                slots_[slot].first = pos;
+                used_[slot] = 1;
+                size_++;
+                return slot;
+            }
+            if (slots_[slot].first == pos) {
+                return slot;
+            }
+        }
+    }
+
+    void eraseSlot(size_t hole) {
+        const size_t mask = slots_.size() - 1;
+
+        // Backward-shift deletion: pull later entries of the run into the hole
+        // unless that would move them in front of their home slot
+        for (size_t slot = (hole + 1) & mask; used_[slot] != 0; slot = (slot + 1) & mask) {
+            size_t home = homeSlot(slots_[slot].first);
+            if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+                slots_[hole] = std::move(slots_[slot]);
+                hole = slot;
+            }
+        }
+
+        slots_[hole] = value_type();
+        used_[hole] = 0;
+        size_--;
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<value_type> oldSlots(capacity);
+        std::vector<uint8_t> oldUsed(capacity, 0);
+        oldSlots.swap(slots_);
+        oldUsed.swap(used_);
+
+        const size_t mask = capacity - 1;
+        for (size_t i = 0; i < oldSlots.size(); ++i) {
+            if (oldUsed[i] == 0) {
+                continue;
+            }
+            size_t slot = homeSlot(oldSlots[i].first);
+            while (used_[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            slots_[slot] = std::move(oldSlots[i]);
+            used_[slot] = 1;
+        }
+    }
+
+    std::vector<value_type> slots_;
+    std::vector<uint8_t> used_; // 1 for occupied slots
+    size_t size_ = 0;
+};
+
+} // namespace flecs_gol
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+
+namespace flecs_gol {
+
+// Exact cycle detection from an incrementally maintained hash of the live set.
+//
+// Each live cell adds A^x * B^y (mod 2^64) to the set hash, so a birth or
+// death updates it in O(1), and translating the whole set by (dx, dy)
+// multiplies the hash by A^dx * B^dy. Dividing out the powers of the floored
+// centroid - which moves by exactly (dx, dy) under a translation - leaves a
+// shape hash that does not depend on where the pattern sits. A table from
+// shape hash to the generation it was last seen then finds still lifes,
+// oscillators and spaceships in O(1) per generation. Matches are exact up to
+// 64-bit hash collisions.
+class CycleDetector {
+public:
+    static constexpr uint32_t DEFAULT_MAX_PERIOD = 1024;
+
+    struct Cycle {
+        uint32_t period = 0;         // 1 for a still life
+        int32_t dx = 0;              // Displacement per period; non-zero for spaceships
+        int32_t dy = 0;
+        uint32_t startGeneration = 0; // Earlier generation the current state repeats
+    };
+
+    explicit CycleDetector(uint32_t maxPeriod = DEFAULT_MAX_PERIOD);
+
+    // Live set updates, from births and deaths or a full rebuild
+    void add(const Position& pos);
+    void remove(const Position& pos);
+
+    // Forgets the live set and the recorded generations
+    void clear();
+
+    // Records the live set as the state of a generation. Returns the cycle if
+    // the same shape was recorded within the last maxPeriod generations.
+    std::optional<Cycle> record(uint32_t generation);
+
+    size_t size() const { return count_; }
+    uint32_t getMaxPeriod() const { return maxPeriod_; }
+    size_t getMemoryUsage() const;
+
+private:
+    struct Seen {
+        uint32_t generation;
+        int64_t centroidX;
+        int64_t centroidY;
+        uint64_t count;
+    };
+
+    static uint64_t cellHash(const Position& pos);
+
+    uint32_t maxPeriod_;
+    uint64_t hash_ = 0;
+    int64_t sumX_ = 0;
+    int64_t sumY_ = 0;
+    uint64_t count_ = 0;
+
+    std::unordered_map<uint64_t, Seen> seen_;               // Shape hash -> latest sighting
+    std::deque<std::pair<uint64_t, uint32_t>> history_;    // Recorded (shape hash, generation), oldest first
+};
+
+} // namespace flecs_gol
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <flecs_gol/simulation_engine.h>
+#include <flecs_gol/game_config.h>
+#include <flecs_gol/dense_kernels.h>
+#include <vector>
+
+namespace flecs_gol {
+
+// Bit-packed dense storage: one bit per cell, rows packed into 64-bit words.
+// Covers exactly the configured grid boundaries; honours edge wrapping.
+//
+// Rows are stored with one zero guard word on each side and the grid has a
+// guard row above and below, so the word-parallel kernel never branches on
+// edges. Wrapped grids refresh the guard rows before each step and patch the
+// first and last column afterwards.
+class DenseGrid : public SimulationEngine {
+public:
+    explicit DenseGrid(const GameConfig& config);
+    ~DenseGrid() override = default;
+
+    // SimulationEngine interface
+    bool setCell(int32_t x, int32_t y, bool alive) override;
+    bool isCellAlive(int32_t x, int32_t y) const override;
+    uint8_t getNeighborCount(int32_t x, int32_t y) const override;
+
+    void step() override;
+    void clear() override;
+
+    uint32_t getCellCount() const override { return population_; }
+    size_t getMemoryUsage() const override;
+    bool getActiveBounds(int32_t& minX, int32_t& maxX, int32_t& minY, int32_t& maxY) const override; // Whole grid
+    void collectChanges(std::vector<Position>& born, std::vector<Position>& died) const override;
+
+    void collectLiveCells(std::vector<Position>& out) const override;
+    void collectCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                              std::vector<Position>& out) const override;
+
+    // Kernel selection (defaults to the best kernel for the running CPU)
+    void setKernel(const DenseKernel& kernel) { kernel_ = kernel; }
+    const char* getKernelName() const { return kernel_.name; }
+
+    // Layout queries
+    uint32_t getWidth() const { return width_; }
+    uint32_t getHeight() const { return height_; }
+    size_t getWordsPerRow() const { return wordsPerRow_; }
+    const uint64_t* rowData(uint32_t row) const { return rowPtr(cells_, row); }
+
+private:
+    // Row pointers skip the guard row and the leading guard word; row -1 and
+    // row height_ address the guard rows
+    const uint64_t* rowPtr(const std::vector<uint64_t>& buffer, int64_t row) const {
+        return buffer.data() + static_cast<size_t>(row + 1) * stride_ + 1;
+    }
+    uint64_t* rowPtr(std::vector<uint64_t>& buffer, int64_t row) const {
+        return buffer.data() + static_cast<size_t>(row + 1) * stride_ + 1;
+    }
+
+    bool getBit(uint32_t col, uint32_t row) const {
+        return (rowPtr(cells_, row)[col >> 6] >> (col & 63)) & 1u;
+    }
+
+    uint8_t countNeighbors(int64_t col, int64_t row) const;
+    void patchWrappedColumn(uint32_t col);
+    void recountPopulation();
+
+    int32_t originX_;
+    int32_t originY_;
+    uint32_t width_;
+    uint32_t height_;
+    size_t wordsPerRow_;
+    size_t stride_;          // wordsPerRow_ plus two guard words
+    uint64_t lastWordMask_;  // Valid bits of the last word in each row
+    bool wrapEdges_;
+    DenseKernel kernel_;
+    LifeRule rule_;
+    bool conwayRule_; // B3/S23 takes the kernel's dedicated stepRow
+
+    // Current and next generation, row-major, bit (x & 63) of word (x >> 6)
+    std::vector<uint64_t> cells_;
+    std::vector<uint64_t> next_;
+    uint32_t population_ = 0;
+};
+
+} // namespace flecs_gol
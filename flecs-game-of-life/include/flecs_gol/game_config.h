@@ -1,5 +1,6 @@
 #pragma once
 
+#include <flecs_gol/life_rule.h>
 #include <cstdint>
 #include <string>
 #include <optional>
@@ -7,6 +8,18 @@
 
 namespace flecs_gol {
 
+// Storage engine used by GameOfLifeSimulation
+enum class EngineType {
+    Sparse,  // One FLECS entity per live cell (default)
+    Dense,   // One bit per cell inside the grid boundaries
+    Tiled,   // Dense bits in 64x64 tiles stepped in parallel on workerThreads
+    HashLife, // Memoized quadtree on an unbounded plane; grid boundaries are ignored
+    Chunked   // 64x64 bit chunks allocated where cells live, on an unbounded plane; grid boundaries are ignored
+};
+
+const char* engineTypeToString(EngineType type);
+std::optional<EngineType> engineTypeFromString(const std::string& name);
+
 class GameConfig {
 public:
     GameConfig();
@@ -31,9 +44,29 @@ public:
     void setTargetFPS(uint32_t fps) { targetFPS_ = fps; }
     uint32_t getTargetFPS() const { return targetFPS_; }
     
+    // Generations a running frame advances, in one step(n) so engines that
+    // take several at once (tiled, HashLife) get them together. With a frame
+    // step budget, a frame repeats such batches while they fit in it, so the
+    // frame rate holds while throughput rises (0 ms = one batch per frame).
+    void setGenerationsPerFrame(uint32_t generations) { generationsPerFrame_ = generations; }
+    uint32_t getGenerationsPerFrame() const { return generationsPerFrame_; }
+    void setFrameStepBudgetMs(uint32_t budgetMs) { frameStepBudgetMs_ = budgetMs; }
+    uint32_t getFrameStepBudgetMs() const { return frameStepBudgetMs_; }
+    
     void setMaxGenerations(uint32_t maxGen) { maxGenerations_ = maxGen; }
     uint32_t getMaxGenerations() const { return maxGenerations_; }
     
+    // Background checkpoints of the board to a snapshot file every this many
+    // generations (0 = none)
+    void setCheckpointPath(const std::string& path) { checkpointPath_ = path; }
+    const std::string& getCheckpointPath() const { return checkpointPath_; }
+    void setCheckpointInterval(uint32_t generations) { checkpointInterval_ = generations; }
+    uint32_t getCheckpointInterval() const { return checkpointInterval_; }
+    
+    // Birth/survival rule, "rule" in config files as a rulestring ("B36/S23")
+    void setRule(const LifeRule& rule) { rule_ = rule; }
+    const LifeRule& getRule() const { return rule_; }
+    
     // Performance settings
     void setMaxEntities(uint32_t maxEntities) { maxEntities_ = maxEntities; }
     uint32_t getMaxEntities() const { return maxEntities_; }
@@ -41,6 +74,49 @@ public:
     void setEnableProfiling(bool enable) { enableProfiling_ = enable; }
     bool getEnableProfiling() const { return enableProfiling_; }
     
+    // Worker threads for multi-threaded systems and the tiled engine (0 = one per hardware thread)
+    void setWorkerThreads(uint32_t threads) { workerThreads_ = threads; }
+    uint32_t getWorkerThreads() const { return workerThreads_; }
+    
+    // Tiled engine on NUMA hosts: with placement on, workers are spread over
+    // the nodes, each tile's memory is placed on the node of the worker that
+    // owns it, and idle workers steal from their own node first. Pinning binds
+    // each worker thread to one CPU of its node. A node limit keeps workers
+    // and tiles on the first that many nodes (0 = all).
+    void setNumaPlacement(bool placement) { numaPlacement_ = placement; }
+    bool getNumaPlacement() const { return numaPlacement_; }
+    void setPinWorkerThreads(bool pin) { pinWorkerThreads_ = pin; }
+    bool getPinWorkerThreads() const { return pinWorkerThreads_; }
+    void setNumaNodeLimit(uint32_t nodes) { numaNodeLimit_ = nodes; }
+    uint32_t getNumaNodeLimit() const { return numaNodeLimit_; }
+    
+    void setEngineType(EngineType type) { engineType_ = type; }
+    EngineType getEngineType() const { return engineType_; }
+    
+    // HashLife engine advances 2^hashLifeStepLog2 generations per step
+    void setHashLifeStepLog2(uint32_t stepLog2) { hashLifeStepLog2_ = stepLog2; }
+    uint32_t getHashLifeStepLog2() const { return hashLifeStepLog2_; }
+    
+    // Adaptive engine: the controller moves a sparse board to the dense engine
+    // once live cells cover the dense threshold of the grid, and back below the
+    // sparse threshold. The gap between the two keeps it from flapping.
+    void setAdaptiveEngine(bool adaptive) { adaptiveEngine_ = adaptive; }
+    bool getAdaptiveEngine() const { return adaptiveEngine_; }
+    void setDenseDensityThreshold(double density) { denseDensityThreshold_ = density; }
+    double getDenseDensityThreshold() const { return denseDensityThreshold_; }
+    void setSparseDensityThreshold(double density) { sparseDensityThreshold_ = density; }
+    double getSparseDensityThreshold() const { return sparseDensityThreshold_; }
+    
+    // Sparse engine re-sorts its cell table into Z-order (Morton) every this
+    // many generations, so systems walk spatially adjacent cells through
+    // adjacent component memory (0 = never)
+    void setCellSortInterval(uint32_t generations) { cellSortInterval_ = generations; }
+    uint32_t getCellSortInterval() const { return cellSortInterval_; }
+    
+    // Memory kept for the controller's step history (0 = no history)
+    void setHistoryBudgetMB(uint32_t budgetMB) { historyBudgetMB_ = budgetMB; }
+    uint32_t getHistoryBudgetMB() const { return historyBudgetMB_; }
+    
     // Validation
     bool validate() const;
     
@@ -62,11 +138,27 @@ private:
     
     // Simulation parameters
     uint32_t targetFPS_ = 10;
+    uint32_t generationsPerFrame_ = 1;
+    uint32_t frameStepBudgetMs_ = 0;
     uint32_t maxGenerations_ = 0; // 0 = unlimited
+    std::string checkpointPath_;
+    uint32_t checkpointInterval_ = 0;
+    LifeRule rule_{};
     
     // Performance settings
     uint32_t maxEntities_ = 1000000;
     bool enableProfiling_ = false;
+    uint32_t workerThreads_ = 0;
+    bool numaPlacement_ = false;
+    bool pinWorkerThreads_ = false;
+    uint32_t numaNodeLimit_ = 0;
+    EngineType engineType_ = EngineType::Sparse;
+    uint32_t hashLifeStepLog2_ = 0;
+    bool adaptiveEngine_ = false;
+    double denseDensityThreshold_ = 0.0002;
+    double sparseDensityThreshold_ = 0.0001;
+    uint32_t cellSortInterval_ = 64;
+    uint32_t historyBudgetMB_ = 16;
 };
 
 } // namespace flecs_gol
\ No newline at end of file
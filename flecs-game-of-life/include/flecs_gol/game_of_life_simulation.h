@@ -3,47 +3,89 @@
 #include <flecs.h>
 #include <flecs_gol/game_config.h>
 #include <flecs_gol/components.h>
+#include <flecs_gol/simulation_engine.h>
+#include <flecs_gol/life_engine.h>
+#include <flecs_gol/coordinate_map.h>
+#include <flecs_gol/region_index.h>
+#include <span>
 #include <vector>
-#include <unordered_map>
+#include <memory>
 #include <chrono>
 
 namespace flecs_gol {
 
-class GameOfLifeSimulation {
+class TiledGrid;
+
+class GameOfLifeSimulation : public LifeEngine {
 public:
     explicit GameOfLifeSimulation(const GameConfig& config);
-    ~GameOfLifeSimulation() = default;
+    ~GameOfLifeSimulation() override = default;
     
     // Entity management
     flecs::entity createCell(int32_t x, int32_t y);
-    void destroyCell(int32_t x, int32_t y);
-    bool isCellAlive(int32_t x, int32_t y) const;
+    void addCell(int32_t x, int32_t y) override { createCell(x, y); }
+    
+    // Bulk insertion for pattern loading. Positions that are invalid, already
+    // alive or repeated are skipped; the rest are created in one batch, with
+    // the indices sized once and the grid state updated once.
+    void createCells(std::span<const Position> cells) override;
+    void destroyCell(int32_t x, int32_t y) override;
+    bool isCellAlive(int32_t x, int32_t y) const override;
     flecs::entity getCellAt(int32_t x, int32_t y) const;
     
     // Simulation control
-    void step();
-    void reset();
-    void clear();
+    void step() override;
+    void reset() override;
+    void clear() override;
+    
+    // Tiled storage advances TiledGrid::BLOCK_GENERATIONS generations per
+    // pass over memory, so a settled board is noticed at the end of a block
+    // rather than the step it settled in; the changes cover the last block.
+    // A board that repeats over a block skips the blocks left, keeping its phase.
+    uint32_t advance(uint32_t steps) override;
     
     // State queries
-    uint32_t getCellCount() const;
-    uint32_t getGeneration() const;
-    size_t getMemoryUsage() const;
+    uint32_t getCellCount() const override;
+    uint32_t getGeneration() const override;
+    void setGeneration(uint32_t generation) override;  // For restoring a saved board
+    size_t getMemoryUsage() const override;
+    PerformanceMetrics getPerformanceMetrics() const;
+    GridState getGridState() const;
+    
+    // Cells born and died in the last step; the buffers are reused across steps
+    const std::vector<Position>& getBornCells() const override { return bornCells_; }
+    const std::vector<Position>& getDiedCells() const override { return diedCells_; }
     
     // Neighbor operations
     uint8_t getNeighborCount(int32_t x, int32_t y) const;
     void updateNeighborCounts();
     
-    // Query operations
+    // Position queries - valid for every storage engine
+    std::vector<Position> getLivePositions() const override;
+    std::vector<Position> getPositionsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY) const;
+    
+    // Region query into a reusable buffer; positions are appended to out.
+    // Sparse storage answers from the region index in time proportional to
+    // the region and the cells in it.
+    void collectPositionsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                                  std::vector<Position>& out) const override;
+    
+    // Replaces the contents of out with the live cells, reusing its storage.
+    // Sparse storage copies its region index wholesale.
+    void copyLiveCells(RegionIndex& out) const override;
+    
+    // Entity queries - only the sparse engine keeps one entity per cell
+    bool usesEntityStorage() const { return !engine_; }
     std::vector<flecs::entity> getAllCells() const;
     std::vector<flecs::entity> getCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY) const;
     std::vector<flecs::entity> getCellsWithNeighborCount(uint8_t count) const;
     
     // Configuration
-    const GameConfig& getConfig() const { return config_; }
+    const GameConfig& getConfig() const override { return config_; }
 
 private:
-    // Internal systems
+    // Internal systems - each runs the flecs pipeline of its phase
+    void registerSystems();
     void neighborCountSystem();
     void ruleEvaluationSystem();
     void lifecycleSystem();
@@ -52,15 +94,36 @@ private:
     // Utility methods
     bool isValidPosition(int32_t x, int32_t y) const;
     Position wrapPosition(int32_t x, int32_t y) const;
-    std::vector<Position> getNeighborPositions(int32_t x, int32_t y) const;
+    uint8_t countLiveNeighbors(const Position& pos) const; // Any position
+    template <typename Topology> uint8_t countLiveNeighbors(const Topology& topology, const Position& pos) const;
+    void markActive(const Position& pos);
+    void sortCells();
+    void publishEngineStep(uint32_t generations); // After engine_ has stepped
     void rebuildSpatialIndex();
     
     // Data members
     flecs::world world_;
     GameConfig config_;
     
+    // Alternative storage engine (null when cells are stored as entities)
+    std::unique_ptr<SimulationEngine> engine_;
+    TiledGrid* tiledGrid_ = nullptr; // engine_ when it is tiled, for multi-generation steps
+    
     // Spatial indexing for fast position lookups
-    std::unordered_map<Position, flecs::entity> spatialIndex_;
+    CoordinateMap<flecs::entity> spatialIndex_;
+    
+    // Live cells bucketed by chunk for region queries, kept in step with spatialIndex_
+    RegionIndex regionIndex_;
+    
+    // BirthCandidate entities by position, alive from neighbor counting until lifecycle
+    CoordinateMap<flecs::entity> candidateIndex_;
+    
+    // Bounds of this step's births and deaths, published to GridState by lifecycleSystem
+    GridState stepActivity_;
+    
+    // This step's births and deaths, cleared (capacity kept) at the start of each step
+    std::vector<Position> bornCells_;
+    std::vector<Position> diedCells_;
     
     // Singleton entities
     flecs::entity gridStateEntity_;
@@ -70,6 +133,14 @@ private:
     flecs::query<Position, Cell> liveCellQuery_;
     flecs::query<Position, BirthCandidate> birthCandidateQuery_;
     
+    // Sorts the cell table in place into Z-order on iteration; see sortCells()
+    flecs::query<const Position, const Cell> mortonOrderQuery_;
+    
+    // One pipeline per phase so each phase can be timed on its own
+    flecs::entity neighborCountPipeline_;
+    flecs::entity ruleEvaluationPipeline_;
+    flecs::entity lifecyclePipeline_;
+    
     // Performance tracking
     std::chrono::high_resolution_clock::time_point lastStepTime_;
     
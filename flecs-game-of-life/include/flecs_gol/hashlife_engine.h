@@ -0,0 +1,130 @@
+#pragma once
+
+#include <flecs_gol/simulation_engine.h>
+#include <flecs_gol/life_rule.h>
+#include <array>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace flecs_gol {
+
+// HashLife: the plane is a quadtree of canonical (hash-consed) nodes, and the
+// future of every node is memoized, so repeated structure - gun streams,
+// oscillators, escaped gliders - is computed once and reused.
+//
+// The plane is unbounded and centred on (0, 0); grid boundaries and edge
+// wrapping are ignored. Each step() advances 2^stepLog2 generations.
+class HashLifeEngine : public SimulationEngine {
+public:
+    static constexpr uint32_t MAX_STEP_LOG2 = 48;
+
+    // maxNodes bounds the node store; past it the store is rebuilt from the
+    // live pattern and the memoized results are dropped (0 = no limit).
+    // The rule is only read by the memoized 4x4 base case, so it is not
+    // specialized at compile time like the other engines' loops.
+    explicit HashLifeEngine(uint32_t stepLog2 = 0, size_t maxNodes = 0, const LifeRule& rule = {});
+    ~HashLifeEngine() override = default;
+
+    HashLifeEngine(const HashLifeEngine&) = delete;
+    HashLifeEngine& operator=(const HashLifeEngine&) = delete;
+
+    // SimulationEngine interface
+    bool setCell(int32_t x, int32_t y, bool alive) override;
+    bool isCellAlive(int32_t x, int32_t y) const override;
+    uint8_t getNeighborCount(int32_t x, int32_t y) const override;
+
+    void step() override;
+    void clear() override;
+    uint64_t getGenerationsPerStep() const override { return uint64_t{1} << stepLog2_; }
+
+    uint32_t getCellCount() const override { return static_cast<uint32_t>(root_->population); }
+    size_t getMemoryUsage() const override;
+    bool getActiveBounds(int32_t& minX, int32_t& maxX, int32_t& minY, int32_t& maxY) const override; // Whole plane
+    void collectChanges(std::vector<Position>& born, std::vector<Position>& died) const override;
+
+    void collectLiveCells(std::vector<Position>& out) const override;
+    void collectCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                              std::vector<Position>& out) const override;
+
+    // Step size - throws std::out_of_range above MAX_STEP_LOG2
+    void setStepLog2(uint32_t stepLog2);
+    uint32_t getStepLog2() const { return stepLog2_; }
+
+    // Advances any number of generations as a sum of power-of-two steps
+    void advance(uint64_t generations);
+
+    // State queries
+    bool lastStepChanged() const { return lastStepChanged_; }
+    uint64_t getPopulation() const { return root_->population; }
+    size_t getNodeCount() const { return nodes_.size(); }
+
+private:
+    struct Node {
+        const Node* nw = nullptr;
+        const Node* ne = nullptr;
+        const Node* sw = nullptr;
+        const Node* se = nullptr;
+        uint64_t population = 0;
+        uint32_t level = 0; // Side length is 2^level; leaves are single cells
+
+        // Centre of this node 2^nextStepLog2 generations ahead
+        mutable const Node* next = nullptr;
+        mutable uint32_t nextStepLog2 = 0;
+    };
+
+    using NodeKey = std::array<const Node*, 4>;
+
+    struct NodeKeyHash {
+        size_t operator()(const NodeKey& key) const noexcept {
+            size_t hash = 0;
+            for (const Node* child : key) {
+                hash = hash * 0x9E3779B97F4A7C15ull + reinterpret_cast<uintptr_t>(child);
+            }
+            return hash ^ (hash >> 29);
+        }
+    };
+
+    // Node construction
+    const Node* makeNode(const Node* nw, const Node* ne, const Node* sw, const Node* se);
+    const Node* emptyNode(uint32_t level);
+    const Node* expand(const Node* node);
+    const Node* centre(const Node* node);
+    const Node* setCell(const Node* node, int64_t x, int64_t y, bool alive);
+
+    // Evolution
+    const Node* nextGeneration(const Node* node);
+    const Node* stepLevel2(const Node* node);
+    bool patternIsCentred() const;
+    void collectGarbage();
+
+    // Queries
+    bool contains(int64_t x, int64_t y) const;
+    bool getCell(int64_t x, int64_t y) const;
+    void collectCells(const Node* node, int64_t x, int64_t y, int64_t minX, int64_t maxX,
+                      int64_t minY, int64_t maxY, std::vector<Position>& out) const;
+    void collectChanges(const Node* before, const Node* after, int64_t x, int64_t y,
+                        std::vector<Position>& born, std::vector<Position>& died) const;
+
+    Node deadLeaf_;
+    Node aliveLeaf_;
+
+    std::deque<Node> nodes_; // Stable addresses for canonical nodes
+    std::unordered_map<NodeKey, const Node*, NodeKeyHash> canonical_;
+    std::vector<const Node*> emptyNodes_; // Indexed by level
+
+    const Node* root_ = nullptr;
+
+    // Roots before and after the last step (or advance), at the same level
+    // and both centred on (0, 0), so their difference is the step's changes
+    const Node* changesBefore_ = nullptr;
+    const Node* changesAfter_ = nullptr;
+    bool advancing_ = false; // Keeps changesBefore_ at the start of an advance
+
+    uint32_t stepLog2_ = 0;
+    size_t maxNodes_;
+    LifeRule rule_;
+    bool lastStepChanged_ = false;
+};
+
+} // namespace flecs_gol
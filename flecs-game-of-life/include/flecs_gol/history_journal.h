@@ -0,0 +1,95 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace flecs_gol {
+
+// What takes a board from one journal entry to another
+struct HistoryMove {
+    uint32_t generation = 0;      // Generation of the entry reached
+    bool fromEmpty = false;       // Clear the board first; flips are then the whole board
+    std::vector<Position> flips;  // Cells to toggle, sorted, each at most once
+};
+
+// Bounded history of a board for stepping backwards. Every recorded step is
+// an entry holding the cells it flipped (born and died alike, in the 8x8
+// tile encoding of cell_encoding.h), and every KEYFRAME_INTERVAL entries one
+// also holds the whole board. Moving between entries toggles the flips in
+// between, or starts from the nearest keyframe when that is fewer bytes, so
+// a seek costs the changes crossed, never a re-simulation.
+//
+// Entries sit in a ring, oldest first. Once they outgrow the byte budget the
+// oldest keyframe and the entries up to the next one are dropped, so the
+// oldest entry is always a keyframe; a single stretch longer than the budget
+// is cut short by asking for an early keyframe (keyframeDue()). A budget of
+// zero disables the journal.
+class HistoryJournal {
+public:
+    static constexpr uint32_t KEYFRAME_INTERVAL = 128;
+
+    explicit HistoryJournal(size_t byteBudget = 0);
+
+    bool isEnabled() const { return byteBudget_ > 0; }
+    size_t getByteBudget() const { return byteBudget_; }
+    void setByteBudget(size_t bytes); // Drops old entries as needed; 0 clears the journal
+
+    // Forgets everything; the board at generation becomes the only entry, a keyframe
+    void restart(uint32_t generation, std::span<const Position> cells);
+    void clear();
+
+    // A step from the current entry to generation. Entries after the current
+    // one (left by stepping back) are dropped first. A step that leaves the
+    // generation where it was is folded in like an edit.
+    void recordStep(uint32_t generation, std::span<const Position> born, std::span<const Position> died);
+
+    // Whether the newest entry should get a keyframe, then recordKeyframe()
+    // with the board it leads to
+    bool keyframeDue() const;
+    void recordKeyframe(std::span<const Position> cells);
+
+    // Cells flipped by hand at the current entry; entries after it are dropped
+    void recordEdit(std::span<const Position> flips);
+
+    // Moves to the last entry at or before generation, or the oldest entry.
+    // Returns nothing for an empty journal.
+    std::optional<HistoryMove> seek(uint32_t generation);
+    std::optional<HistoryMove> stepBack(); // Nothing at the oldest entry
+
+    bool empty() const { return entries_.empty(); }
+    uint32_t getOldestGeneration() const { return entries_.empty() ? 0 : entries_.front().generation; }
+    uint32_t getNewestGeneration() const { return entries_.empty() ? 0 : entries_.back().generation; }
+    uint32_t getCurrentGeneration() const { return entries_.empty() ? 0 : entries_[cursor_].generation; }
+    bool isRewound() const { return cursor_ + 1 < entries_.size(); }
+    size_t getEntryCount() const { return entries_.size(); }
+    size_t getKeyframeCount() const { return keyframes_; }
+    size_t getByteCount() const { return bytes_; }
+
+private:
+    struct Entry {
+        uint32_t generation = 0;
+        std::string flips;     // From the entry before; unused for the oldest entry
+        std::string keyframe;  // The whole board, when hasKeyframe
+        bool hasKeyframe = false;
+    };
+
+    static size_t entryBytes(const Entry& entry);
+    void truncateAfterCursor();
+    void evict();
+    void append(Entry entry);
+    HistoryMove moveTo(size_t index);
+
+    size_t byteBudget_;
+    std::deque<Entry> entries_;
+    size_t cursor_ = 0;
+    size_t keyframes_ = 0;
+    size_t bytes_ = 0;
+};
+
+} // namespace flecs_gol
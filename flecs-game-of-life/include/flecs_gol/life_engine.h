@@ -0,0 +1,85 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <flecs_gol/game_config.h>
+#include <flecs_gol/region_index.h>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace flecs_gol {
+
+// Simulation interface driven by SimulationController. GameOfLifeSimulation
+// implements it for every EngineType; other implementations plug in through
+// SimulationController::setEngine() without a controller of their own.
+class LifeEngine {
+public:
+    virtual ~LifeEngine() = default;
+
+    // Cell editing. Positions outside the engine's domain are ignored.
+    virtual void addCell(int32_t x, int32_t y) = 0;
+    virtual void createCells(std::span<const Position> cells) = 0;
+    virtual void destroyCell(int32_t x, int32_t y) = 0;
+    virtual bool isCellAlive(int32_t x, int32_t y) const = 0;
+
+    // Simulation control. clear() removes the cells; reset() also rewinds the generation.
+    virtual void step() = 0;
+    virtual void reset() = 0;
+    virtual void clear() = 0;
+
+    // Runs up to steps steps, stopping after one that changes nothing.
+    // Returns the steps taken; the changes report the last of them.
+    virtual uint32_t advance(uint32_t steps) {
+        uint32_t taken = 0;
+        while (taken < steps) {
+            step();
+            ++taken;
+            if (getBornCells().empty() && getDiedCells().empty()) {
+                break;
+            }
+        }
+        return taken;
+    }
+
+    // State queries
+    virtual uint32_t getCellCount() const = 0;
+    virtual uint32_t getGeneration() const = 0;
+    virtual void setGeneration(uint32_t generation) = 0;
+    virtual size_t getMemoryUsage() const = 0;
+    virtual const GameConfig& getConfig() const = 0;
+
+    // Region queries - positions are appended to out; copyLiveCells() replaces its contents
+    virtual std::vector<Position> getLivePositions() const = 0;
+    virtual void collectPositionsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                                          std::vector<Position>& out) const = 0;
+    virtual void copyLiveCells(RegionIndex& out) const = 0;
+
+    // Cells born and died in the last step
+    virtual const std::vector<Position>& getBornCells() const = 0;
+    virtual const std::vector<Position>& getDiedCells() const = 0;
+};
+
+// Builds the engine the configuration selects
+std::unique_ptr<LifeEngine> createLifeEngine(const GameConfig& config);
+
+// For a run of steps that advance() ended early on a settled board: moves
+// the generation on by the steps it skipped, each as long as the ones taken
+// since startGeneration, stopping at the largest generation instead of
+// wrapping. Nothing changes when every step was taken.
+void skipSettledSteps(LifeEngine& engine, uint32_t startGeneration, uint32_t taken, uint32_t steps);
+
+// True once the live cells pass the configured maxEntities. Stepping stops
+// there (editing and clearing still work) so a runaway pattern cannot grow
+// until the process runs out of memory.
+bool exceedsEntityLimit(const LifeEngine& engine);
+
+// Thrown when a step is asked of an engine past its entity limit
+class EntityLimitError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+} // namespace flecs_gol
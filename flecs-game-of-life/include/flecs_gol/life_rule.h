@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace flecs_gol {
+
+// Life-like (outer totalistic) rule in B/S notation: bit n of birth is set
+// when a dead cell with n live neighbors comes alive, bit n of survival when
+// a live one with n stays alive. B0 rules are not supported; they would bring
+// the empty plane around every engine's cells to life.
+struct LifeRule {
+    uint16_t birth = 1u << 3;
+    uint16_t survival = (1u << 2) | (1u << 3);
+
+    constexpr bool nextState(bool alive, uint32_t neighbors) const {
+        return ((static_cast<uint32_t>(alive ? survival : birth) >> neighbors) & 1u) != 0;
+    }
+
+    // "B36/S23"
+    std::string toString() const;
+
+    // "B3/S23" in either order and either case, or the older "23/3"
+    // (survival/birth) form; nullopt for anything else, B0 rules included
+    static std::optional<LifeRule> parse(std::string_view text);
+
+    friend constexpr bool operator==(const LifeRule&, const LifeRule&) = default;
+};
+
+inline constexpr LifeRule CONWAY_RULE{};
+inline constexpr LifeRule HIGHLIFE_RULE{(1u << 3) | (1u << 6), (1u << 2) | (1u << 3)};
+inline constexpr LifeRule DAY_AND_NIGHT_RULE{(1u << 3) | (1u << 6) | (1u << 7) | (1u << 8),
+                                             (1u << 3) | (1u << 4) | (1u << 6) | (1u << 7) | (1u << 8)};
+inline constexpr LifeRule SEEDS_RULE{1u << 2, 0};
+
+// A rule known at compile time. Engines instantiate their step loops for
+// these, so the common rules compile to constant tests on the neighbor count.
+template <uint16_t Birth, uint16_t Survival>
+struct FixedLifeRule {
+    static constexpr uint16_t birth = Birth;
+    static constexpr uint16_t survival = Survival;
+
+    static constexpr bool nextState(bool alive, uint32_t neighbors) {
+        return ((static_cast<uint32_t>(alive ? Survival : Birth) >> neighbors) & 1u) != 0;
+    }
+};
+
+template <const LifeRule& Rule>
+using FixedLifeRuleOf = FixedLifeRule<Rule.birth, Rule.survival>;
+
+// Calls fn with the FixedLifeRule of Conway, HighLife, Day & Night or Seeds,
+// or with rule itself (read at run time) for any other. fn must return the
+// same type for every rule.
+template <typename Fn>
+decltype(auto) withLifeRule(const LifeRule& rule, Fn&& fn) {
+    if (rule == CONWAY_RULE) {
+        return fn(FixedLifeRuleOf<CONWAY_RULE>{});
+    }
+    if (rule == HIGHLIFE_RULE) {
+        return fn(FixedLifeRuleOf<HIGHLIFE_RULE>{});
+    }
+    if (rule == DAY_AND_NIGHT_RULE) {
+        return fn(FixedLifeRuleOf<DAY_AND_NIGHT_RULE>{});
+    }
+    if (rule == SEEDS_RULE) {
+        return fn(FixedLifeRuleOf<SEEDS_RULE>{});
+    }
+    return fn(rule);
+}
+
+} // namespace flecs_gol
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace flecs_gol {
+
+struct NumaNode {
+    uint32_t id = 0;            // The operating system's node number
+    std::vector<uint32_t> cpus; // CPUs of the node this process may run on
+};
+
+// NUMA nodes and their CPUs, for laying out worker threads and the memory
+// they own. The default is one node holding every hardware thread, which
+// makes NUMA-aware code behave exactly like code that is not.
+class NumaTopology {
+public:
+    NumaTopology();
+    explicit NumaTopology(std::vector<NumaNode> nodes); // Nodes without CPUs are dropped
+
+    // Nodes of /sys/devices/system/node on Linux, restricted to the CPUs in
+    // the process's affinity mask. Elsewhere, or if that cannot be read, the
+    // default single node.
+    static NumaTopology detect();
+
+    // The first nodes only, as if the process were bound to that many
+    // sockets (0 = all of them)
+    NumaTopology limitedTo(uint32_t nodes) const;
+
+    uint32_t getNodeCount() const { return static_cast<uint32_t>(nodes_.size()); }
+    const NumaNode& getNode(uint32_t node) const { return nodes_[node]; }
+
+private:
+    std::vector<NumaNode> nodes_;
+};
+
+// Pins the calling thread to one CPU. False where that is unsupported or refused.
+bool pinCurrentThread(uint32_t cpu);
+
+// Asks the kernel to back [address, address + bytes) with memory of the
+// node (an operating system node number) when its pages are first touched,
+// or of another node once that one is full. address must be page aligned.
+// False where unsupported; the pages then go to the node of whichever
+// thread touches them first.
+bool placeMemoryOnNode(void* address, size_t bytes, uint32_t node);
+
+size_t getMemoryPageSize();
+
+// Allocator for buffers placed page by page on NUMA nodes. Storage is page
+// aligned, so placing a range never moves a neighbouring allocation, and
+// elements are default-initialized, so a resize() touches no page before
+// the owners of its parts do.
+template <typename T>
+struct PlacementAllocator {
+    using value_type = T;
+    static constexpr size_t ALIGNMENT = 4096;
+
+    PlacementAllocator() = default;
+    template <typename U>
+    PlacementAllocator(const PlacementAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ALIGNMENT}));
+    }
+    void deallocate(T* pointer, size_t) noexcept { ::operator delete(pointer, std::align_val_t{ALIGNMENT}); }
+
+    template <typename U>
+    void construct(U* pointer) {
+        ::new (static_cast<void*>(pointer)) U;
+    }
+    template <typename U, typename... Args>
+    void construct(U* pointer, Args&&... args) {
+        ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    bool operator==(const PlacementAllocator<U>&) const noexcept { return true; }
+};
+
+} // namespace flecs_gol
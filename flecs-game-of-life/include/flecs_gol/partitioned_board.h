@@ -0,0 +1,190 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <flecs_gol/game_config.h>
+#include <flecs_gol/tiled_grid.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace flecs_gol {
+
+// Distributed boards: the GameConfig grid boundaries are the global domain,
+// split into horizontal slabs of whole rows, one per rank. Each rank holds
+// only its slab on a local TiledGrid, plus haloDepth rows of each neighbor's
+// slab. Every haloDepth generations the ranks swap their edge rows, step
+// that many generations locally (the halo goes stale one row a generation,
+// so the slab rows come out exact) and take a global reduction of the living
+// cells and whether any slab changed.
+//
+// Ranks talk through a HaloTransport: InProcessHaloNetwork for ranks on one
+// host, or the gRPC HaloExchangeService of proto/game_of_life.proto between
+// hosts (grpc_halo_transport.h).
+
+// Rows [firstRow, firstRow + rows) of the global domain, counted from its top
+struct SlabBounds {
+    int32_t firstRow{0};
+    int32_t rows{0};
+};
+
+// Slab of rank out of ranks: the height split as evenly as it goes, the
+// first ranks taking a row more
+SlabBounds slabBounds(int32_t height, uint32_t ranks, uint32_t rank);
+
+// Edge rows of a slab sent to a neighbor: downward to the rank below, which
+// takes them as its upper halo, otherwise to the rank above
+struct HaloMessage {
+    uint64_t round{0};
+    uint32_t fromRank{0};
+    bool downward{false};
+    std::vector<uint64_t> words; // Rows of TiledGrid words, top row first
+};
+
+struct HaloReduction {
+    uint64_t livingCells{0};
+    bool changed{false};
+};
+
+class HaloTransport {
+public:
+    virtual ~HaloTransport() = default;
+
+    virtual uint32_t getRank() const = 0;
+    virtual uint32_t getRankCount() const = 0;
+
+    // Hands message to rank; may return before rank receives it
+    virtual void send(uint32_t rank, HaloMessage message) = 0;
+
+    // Blocks until the message fromRank sent in round, in that direction, arrives
+    virtual HaloMessage receive(uint32_t fromRank, bool downward, uint64_t round) = 0;
+
+    // Collective, called once per round by every rank: the sum of the living
+    // cells and whether any rank changed
+    virtual HaloReduction allReduce(uint64_t round, const HaloReduction& local) = 0;
+};
+
+// Messages delivered to one rank, waiting to be received. A timeout of zero
+// waits forever; otherwise receive() throws std::runtime_error past it.
+class HaloMailbox {
+public:
+    explicit HaloMailbox(std::chrono::milliseconds timeout = std::chrono::milliseconds{0});
+
+    void deliver(HaloMessage message);
+    HaloMessage receive(uint32_t fromRank, bool downward, uint64_t round);
+
+private:
+    using Key = std::tuple<uint64_t, uint32_t, bool>; // Round, sender, direction
+
+    std::chrono::milliseconds timeout_;
+    std::mutex mutex_;
+    std::condition_variable arrived_;
+    std::map<Key, HaloMessage> messages_;
+};
+
+// Sums the contributions of every rank to a round, releasing them all once
+// the last arrives. Same timeout rule as HaloMailbox.
+class ReductionBarrier {
+public:
+    explicit ReductionBarrier(uint32_t ranks, std::chrono::milliseconds timeout = std::chrono::milliseconds{0});
+
+    HaloReduction contribute(uint64_t round, const HaloReduction& local);
+
+private:
+    struct Round {
+        HaloReduction total;
+        uint32_t arrived{0};
+        uint32_t left{0};
+    };
+
+    uint32_t ranks_;
+    std::chrono::milliseconds timeout_;
+    std::mutex mutex_;
+    std::condition_variable complete_;
+    std::map<uint64_t, Round> rounds_;
+};
+
+// Ranks in one process, each driven by its own thread
+class InProcessHaloNetwork {
+public:
+    explicit InProcessHaloNetwork(uint32_t ranks);
+    ~InProcessHaloNetwork();
+
+    HaloTransport& getTransport(uint32_t rank);
+
+private:
+    class Endpoint;
+
+    std::vector<std::unique_ptr<HaloMailbox>> mailboxes_;
+    ReductionBarrier barrier_;
+    std::vector<std::unique_ptr<Endpoint>> endpoints_;
+};
+
+struct PartitionStepResult {
+    uint64_t generations{0}; // Taken; fewer than asked once a block changes nothing
+    uint64_t livingCells{0}; // Over every slab
+    bool changed{false};     // Whether any slab changed in the last block
+};
+
+// One rank's slab of a distributed board
+class PartitionedBoard {
+public:
+    // config describes the global domain: grid boundaries, wrap, rule, and
+    // the worker threads of the local TiledGrid. Throws std::invalid_argument
+    // for a halo depth under 1, more ranks than rows, or a slab thinner than
+    // the halo.
+    PartitionedBoard(const GameConfig& config, HaloTransport& transport, int32_t haloDepth = 1);
+
+    const GameConfig& getConfig() const { return config_; }
+    SlabBounds getSlab() const { return slab_; }
+    int32_t getHaloDepth() const { return haloDepth_; }
+
+    // Cells in grid coordinates, wrapping like the grid; cells of other
+    // slabs are ignored, so every rank can be handed the whole pattern
+    void setCell(int32_t x, int32_t y, bool alive);
+    void createCells(std::span<const Position> cells);
+    bool isCellAlive(int32_t x, int32_t y) const; // False outside this slab
+
+    // Collective: every rank calls it with the same generations. Runs blocks
+    // of haloDepth generations, each a halo exchange, the local steps and a
+    // reduction, and stops after a block that left every slab as it was
+    // (a still life, or an oscillator whose period divides the block).
+    PartitionStepResult advance(uint64_t generations);
+
+    uint64_t getGeneration() const { return generation_; }
+    uint32_t getSlabCellCount() const;
+    void collectLiveCells(std::vector<Position>& out) const; // This slab's, in grid coordinates
+    size_t getMemoryUsage() const;                            // Local grid and exchange buffers
+
+private:
+    struct SlabSummary {
+        uint64_t hash{0};
+        uint64_t livingCells{0};
+    };
+
+    // Grid to local coordinates; false outside the slab
+    bool toSlab(int32_t& x, int32_t& y) const;
+    SlabSummary summarize() const;
+    void exchangeHalos();
+
+    GameConfig config_;
+    HaloTransport& transport_;
+    SlabBounds slab_;
+    int32_t haloDepth_;
+    int32_t haloAbove_; // Halo rows held above and below the slab; 0 at a bounded edge or with one rank
+    int32_t haloBelow_;
+    uint32_t rankAbove_;
+    uint32_t rankBelow_;
+    TiledGrid grid_;
+    uint64_t generation_ = 0;
+    uint64_t round_ = 0;
+    mutable std::vector<uint64_t> rows_; // Exchange and summary scratch
+};
+
+} // namespace flecs_gol
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <flecs_gol/life_rule.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace flecs_gol {
+
+// A pattern of the repository's patterns/ corpus, compiled into the binary at
+// build time (cmake/embed_patterns.cmake) so naming one costs a copy of its
+// cells instead of a file read and a JSON parse
+struct EmbeddedPattern {
+    std::string_view name;  // File name without .json, such as "glider-gun"
+    std::span<const Position> cells;
+};
+
+// Every embedded pattern, in file name order
+std::span<const EmbeddedPattern> embeddedPatterns();
+const EmbeddedPattern* findEmbeddedPattern(std::string_view name);  // nullptr if none
+
+// Live cells of a JSON, RLE (.rle) or macrocell (.mc) file, chosen by
+// extension. Throws std::runtime_error if it cannot be opened or names a rule
+// other than rule, and the readers' or nlohmann's exceptions if it is malformed.
+std::vector<Position> readPatternFile(const std::string& path, const LifeRule& rule = CONWAY_RULE);
+
+// Process-wide cache of parsed pattern files, keyed by path. Every lookup
+// checks the file's modification time and size, so an edited file is parsed
+// again and an unchanged one costs a stat. Files are parsed outside the lock,
+// and the cell lists handed out stay valid after the entry is replaced. An
+// entry is checked against one rule; asking for another parses the file again.
+class PatternCache {
+public:
+    static PatternCache& instance();
+
+    // Throws like readPatternFile(); a failed read leaves the cache as it was
+    std::shared_ptr<const std::vector<Position>> load(const std::string& path, const LifeRule& rule = CONWAY_RULE);
+
+    void clear();
+    size_t size() const;
+
+private:
+    struct Entry {
+        std::filesystem::file_time_type modified;
+        uintmax_t bytes = 0;
+        LifeRule rule;
+        std::shared_ptr<const std::vector<Position>> cells;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+} // namespace flecs_gol
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <flecs_gol/coordinate_map.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace flecs_gol {
+
+// Live cell positions bucketed into 64x64 chunks, one bit per cell.
+//
+// A region query visits only the chunks overlapping the region - or every
+// occupied chunk, if that is fewer - and walks their set bits, so its cost
+// follows the region size and the cells in it rather than the population.
+// Chunks are found through a CoordinateMap keyed by chunk coordinate; empty
+// chunks are recycled through a free list.
+//
+// Above the chunks sits a population pyramid: live counts of aligned square
+// blocks 128, 256 and so on up to 2^MAX_SCALE_LOG2 cells a side, one level
+// per doubling. Inserts and erases leave it alone; the first countBlock()
+// after a change rebuilds it from the chunk counts, at a cost that follows
+// the chunk count, so boards nobody views zoomed out never pay for it. After
+// that countBlock() answers any block size in one lookup. The rebuild is
+// locked, so readers sharing an index that no longer changes may all call it.
+class RegionIndex {
+public:
+    static constexpr int32_t CHUNK_SIZE = 64;
+    static constexpr uint32_t MAX_SCALE_LOG2 = 20;
+
+    // Returns false if the cell was already present (insert) or absent (erase)
+    bool insert(const Position& pos);
+    bool erase(const Position& pos);
+    bool contains(const Position& pos) const;
+
+    // Keeps the chunk storage for refilling
+    void clear();
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t getChunkCount() const { return chunkIndex_.size(); }
+    size_t getMemoryUsage() const;
+
+    // Positions inside the inclusive bounds, appended to out in chunk order
+    void collectRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY, std::vector<Position>& out) const;
+
+    // Live cells in the block of 2^scaleLog2 cells a side holding cells
+    // (blockX << scaleLog2, blockY << scaleLog2) onwards; scaleLog2 at most MAX_SCALE_LOG2
+    uint32_t countBlock(uint32_t scaleLog2, int32_t blockX, int32_t blockY) const;
+
+private:
+    static constexpr uint32_t CHUNK_LOG2 = 6;
+    static constexpr uint32_t BLOCK_LEVELS = MAX_SCALE_LOG2 - CHUNK_LOG2;  // Pyramid levels above the chunks
+
+    struct Chunk {
+        Position origin;                      // Chunk coordinate, in chunks
+        std::array<uint64_t, CHUNK_SIZE> rows; // Bit x of row y is cell (origin * 64 + (x, y))
+        uint32_t count = 0;
+    };
+
+    // Block counts by level (0 = 128 cells a side) and block coordinate.
+    // Copies take the counts along only if they are up to date.
+    struct Pyramid {
+        Pyramid() = default;
+        Pyramid(const Pyramid& other);
+        Pyramid& operator=(const Pyramid& other);
+
+        mutable std::mutex mutex;  // Held while building, and while copying from
+        std::atomic<bool> built{false};
+        std::array<CoordinateMap<uint32_t>, BLOCK_LEVELS> levels;
+    };
+
+    // Floor division, so negative coordinates land in the chunk to their left
+    static Position chunkOf(const Position& pos) { return Position(pos.x >> 6, pos.y >> 6); }
+
+    void buildPyramid() const;  // With pyramid_.mutex held
+
+    void collectChunk(const Chunk& chunk, int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                      std::vector<Position>& out) const;
+
+    std::vector<Chunk> chunks_;
+    std::vector<uint32_t> freeChunks_;    // Slots of chunks_ that hold no cells
+    CoordinateMap<uint32_t> chunkIndex_;  // Occupied chunks by chunk coordinate
+    mutable Pyramid pyramid_;
+    size_t size_ = 0;
+};
+
+} // namespace flecs_gol
@@ -1,30 +1,50 @@
 #pragma once
 
 #include <flecs_gol/game_of_life_simulation.h>
+#include <flecs_gol/life_engine.h>
+#include <flecs_gol/checkpoint_writer.h>
 #include <flecs_gol/game_config.h>
+#include <flecs_gol/region_index.h>
+#include <flecs_gol/cycle_detector.h>
+#include <flecs_gol/history_journal.h>
+#include <flecs_gol/metrics.h>
 #include <memory>
 #include <chrono>
 #include <functional>
 #include <thread>
 #include <atomic>
+#include <condition_variable>
 #include <mutex>
 #include <array>
+#include <deque>
+#include <future>
+#include <span>
 #include <unordered_map>
 
 namespace flecs_gol {
 
+class SimulationHost;
+
 // State information exposed by controller
 struct SimulationState {
     bool isRunning = false;
     bool isPaused = false;
     uint32_t generation = 0;
     uint32_t liveCellCount = 0;
-    double actualFPS = 0.0;
+    double actualFPS = 0.0;     // From the last frame's duration, to the nanosecond
+    uint64_t skippedFrames = 0; // Frames dropped because a step overran by a whole frame or more
+    uint32_t frameGenerations = 0; // Generations the last running frame advanced
     size_t memoryUsage = 0;
+    bool entityLimitReached = false;  // Steps are refused and running pauses until cells are removed
     
     // Performance metrics
     uint64_t lastStepTimeMicros = 0;
     uint64_t averageStepTimeMicros = 0;
+    
+    // Exact cycle reached, while pattern detection is enabled; period 0 until one is found
+    uint32_t cyclePeriod = 0;
+    int32_t cycleDx = 0;  // Displacement per period, for spaceships
+    int32_t cycleDy = 0;
 };
 
 // Cell data for view consumption
@@ -37,6 +57,23 @@ struct CellData {
     CellData(int32_t x, int32_t y) : x(x), y(y) {}
 };
 
+// Immutable copy of the grid, published by the controller after every change.
+// Readers share it without taking the simulation lock; a snapshot they hold
+// stays valid and unchanged while the simulation moves on.
+struct GridSnapshot {
+    uint32_t generation = 0;
+    RegionIndex cells;
+    std::vector<Position> born;  // Changes of the step that reached this generation
+    std::vector<Position> died;
+};
+
+// One queued cell change (see SimulationController::editCellsAsync)
+struct CellEdit {
+    int32_t x = 0;
+    int32_t y = 0;
+    bool alive = true;  // false removes the cell
+};
+
 // Callback types for event notifications
 using GenerationCallback = std::function<void(uint32_t generation)>;
 using StateChangeCallback = std::function<void(const SimulationState& state)>;
@@ -47,25 +84,87 @@ public:
     explicit SimulationController(const GameConfig& config);
     ~SimulationController();
     
-    // Simulation control - thread-safe
+    // Simulation control - thread-safe. start() runs the simulation on a
+    // thread of its own; start(host) steps it on the host's shared pool
+    // instead, which must outlive the run (until stop()).
     void start();
+    void start(SimulationHost& host);
     void pause();
     void resume();
     void stop();
-    void step();  // Single step when paused
+    void step();  // Single step when paused; does nothing past the entity limit
+    // Queues one step on the simulation thread, which wakes for it at once,
+    // and returns without waiting for it; steps here when no thread runs
+    void requestStep();
+    // Advances several generations in one call, which lets the tiled engine
+    // keep each tile in cache across them. The published changes span all of them.
+    void step(uint32_t generations);
     void reset();
     
-    // Configuration
+    // Step history (see history_journal.h), kept within the config's history
+    // budget. Both pause a running simulation and go back without
+    // re-simulating; seek() simulates only past the newest generation kept.
+    // Stepping or editing after going back drops the generations after.
+    // Loading, resetting and engine swaps that drop cells start it over.
+    bool stepBack();  // false with nothing older kept
+    uint32_t seek(uint32_t generation);  // Returns the generation reached
+    const HistoryJournal& getHistory() const { return history_; }  // Read while no step runs
+    
+    // Configuration. loadPattern reads JSON, RLE (.rle) or macrocell (.mc)
+    // files, chosen by extension.
     void loadPattern(const std::string& patternFile);
     void loadPatternFromJson(const nlohmann::json& patternJson);
+    
+    // Binary board snapshots (see snapshot_file.h). Loading takes the grid
+    // bounds, wrap mode and generation from the file, keeps this controller's
+    // engine type, and makes the loaded cells the reset state.
+    void saveSnapshot(const std::string& path) const;
+    void loadSnapshot(const std::string& path);
+    
+    // Background checkpoint to a snapshot file. The latest published grid is
+    // immutable, so it is handed to the writer thread as it is and stepping
+    // carries on while it is encoded, synced and renamed into place. With a
+    // checkpoint interval configured, steps crossing a multiple of it
+    // checkpoint to the configured path by themselves.
+    void checkpoint(const std::string& path);
+    void waitForCheckpoints();  // Until every checkpoint so far is on disk or failed
+    CheckpointStats getCheckpointStats() const { return checkpointWriter_.getStats(); }
+    // The frame settings wait for a step under way, so they must not be
+    // called from the generation callback. Generations per running frame and
+    // the frame's step budget take effect from the next frame (see
+    // GameConfig::setGenerationsPerFrame).
     void setTargetFPS(uint32_t fps);
+    void setGenerationsPerFrame(uint32_t generations);
+    void setFrameStepBudgetMs(uint32_t budgetMs);
     void setAutoStep(bool enabled);
     
-    // State queries - thread-safe, const access
+    // Engine hot-swap, safe while running. switchEngine() builds the engine the
+    // config selects; setEngine() installs any LifeEngine, taking the config
+    // from it. The live cells and generation carry over (cells outside the new
+    // grid are dropped) and the reset state is kept.
+    void switchEngine(const GameConfig& config);
+    void setEngine(std::unique_ptr<LifeEngine> engine);
+    
+    // With the adaptive engine configured, steps first move the board between
+    // the sparse and dense engines when its density crosses the thresholds
+    // (see GameConfig::setAdaptiveEngine). getConfig() reports the engine in use.
+    
+    // State queries - thread-safe, const access. The cell queries read the
+    // latest snapshot and never wait for a step in progress.
     SimulationState getState() const;
+    std::shared_ptr<const GridSnapshot> getSnapshot() const;
     std::vector<CellData> getCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY) const;
     std::vector<CellData> getAllCells() const;
-    const GameConfig& getConfig() const;
+    
+    // Positions of the live cells inside the bounds. Replaces the contents of
+    // out, reusing its capacity - the per-frame viewport query.
+    void getPositionsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                              std::vector<Position>& out) const;
+    GameConfig getConfig() const;  // A copy, since engine swaps replace it while running
+    
+    // Cells born (isNewBorn) and died (isDying) in the last step. Replaces the
+    // contents of out, reusing its capacity; returns the generation reached.
+    uint32_t getChangedCells(std::vector<CellData>& out) const;
     
     // Callbacks for events
     void setGenerationCallback(GenerationCallback callback);
@@ -78,39 +177,108 @@ public:
     void removeCell(int32_t x, int32_t y);
     void clearGrid();
     
+    // Asynchronous commands, for I/O threads that must not wait for a step in
+    // progress. They queue for the simulation thread or host and return at
+    // once; with neither running they are carried out here, like requestStep().
+    // Queued edits are applied between generations, all together under one
+    // acquisition of the simulation lock: before the next running frame's
+    // step, or straight away while paused. An edit future is ready once its
+    // cells are on the board and in the published snapshot. The cell queries
+    // need no such form - they read the snapshot without locking. Commands
+    // still queued when the simulation stops are carried out by stop().
+    std::future<void> addCellAsync(int32_t x, int32_t y);
+    std::future<void> removeCellAsync(int32_t x, int32_t y);
+    std::future<void> editCellsAsync(std::span<const CellEdit> edits);  // One future for a burst
+    // Queued like requestStep(); ready with the generation reached
+    std::future<uint32_t> stepAsync(uint32_t generations = 1);
+    
     // Pattern detection
     void enablePatternDetection(bool enabled);
     bool isPatternDetectionEnabled() const;
+    
+    // Step, render and query latencies, changes and lock waits. Steps and
+    // queries are recorded here; a renderer reports its frames.
+    const SimulationMetrics& getMetrics() const { return metrics_; }
+    void recordRenderTime(std::chrono::nanoseconds duration) { metrics_.renderNanos.record(duration); }
 
 private:
+    friend class SimulationHost;
+    
+    struct StepRequest {
+        uint32_t generations = 1;
+        std::promise<uint32_t> done;
+    };
+    
     // Internal simulation thread management
     void simulationLoop();
+    bool hostedStep(std::chrono::nanoseconds& interval);  // false when not due to run
+    void stepFrame();  // One running frame's generations
+    void wakeHost();
+    void runStepRequest(StepRequest& request);
+    void dispatchEdits();
+    void applyQueuedEdits();
+    std::vector<std::promise<void>> applyEdits();  // With simulationMutex_ held; returns the waiters
     void updateState();
     void notifyStateChange();
     void detectPatterns();
+    void resetCycleDetection();
+    void publishSnapshot();
+    void publishSnapshot(const std::vector<Position>& born, const std::vector<Position>& died);
+    void publishStep(const std::vector<Position>& born, const std::vector<Position>& died, bool fromPublished);
+    std::shared_ptr<GridSnapshot> takeSpareSnapshot();
+    void swapInSnapshot(std::shared_ptr<GridSnapshot> next);
+    void loadCells(std::vector<Position> cells);
+    void installEngine(std::unique_ptr<LifeEngine> engine);
+    void adaptEngine();
+    void restartHistory();
+    void recordHistory(std::span<const Position> born, std::span<const Position> died);
+    void applyHistoryMove(const HistoryMove& move);
+    void submitCheckpoint(const std::string& path);
+    void checkpointIfDue();
     
     // Thread-safe data access
     mutable std::mutex stateMutex_;
     mutable std::mutex simulationMutex_;
     
     // Core simulation
-    std::unique_ptr<GameOfLifeSimulation> simulation_;
-    GameConfig config_;
+    std::unique_ptr<LifeEngine> simulation_;
+    GameConfig config_;  // Written under both mutexes, so either one is enough to read it
     
-    // Controller state
+    // Latest published grid. The previous one is kept aside and refilled once
+    // no reader holds it any more, so publishing rarely allocates.
+    std::atomic<std::shared_ptr<const GridSnapshot>> snapshot_;
+    std::shared_ptr<GridSnapshot> publishedSnapshot_;
+    std::shared_ptr<GridSnapshot> spareSnapshot_;
+    bool spareFollows_ = false;  // The published snapshot is the spare plus its born and died
+    
+    // Controller state, read under stateMutex_. The step results are written
+    // with simulationMutex_ held as well, so code holding that may read them.
     SimulationState currentState_;
     bool shouldStop_ = false;
     bool autoStep_ = true;
+    std::deque<StepRequest> requestedSteps_;  // Queued by stepAsync() and requestStep()
+    
+    // Edits queued by the async commands. editMutex_ is only held to append
+    // or to take the whole queue, never across a step.
+    std::mutex editMutex_;
+    std::vector<CellEdit> queuedEdits_;
+    std::vector<CellEdit> applyingEdits_;  // Swapped with queuedEdits_, keeping both capacities
+    std::vector<std::promise<void>> editWaiters_;
+    std::atomic<bool> editsQueued_{false};  // Set and cleared under editMutex_
+    std::vector<Position> editFlips_;  // Under simulationMutex_
     
-    // Timing control
-    std::chrono::milliseconds targetFrameTime_;
-    std::chrono::high_resolution_clock::time_point lastFrameTime_;
-    std::chrono::high_resolution_clock::time_point startTime_;
+    // Timing control. The simulation thread waits on loopWake_, under
+    // stateMutex_, for its next frame deadline or for a command.
+    std::chrono::nanoseconds targetFrameTime_;
+    std::chrono::steady_clock::time_point lastFrameTime_;
+    std::chrono::steady_clock::time_point startTime_;
+    std::condition_variable loopWake_;
     
     // Performance tracking
     static constexpr size_t PERFORMANCE_HISTORY_SIZE = 60;
     std::array<uint64_t, PERFORMANCE_HISTORY_SIZE> stepTimes_;
     size_t stepTimeIndex_ = 0;
+    mutable SimulationMetrics metrics_;  // Also updated by const queries
     
     // Callbacks
     GenerationCallback generationCallback_;
@@ -118,17 +286,27 @@ private:
     PatternDetectedCallback patternDetectedCallback_;
     
     // Pattern management
-    nlohmann::json initialPattern_;
-    bool hasInitialPattern_ = false;
+    std::vector<Position> initialCells_;  // Restored by reset()
     
-    // Pattern detection
+    // Pattern detection. Steps feed their births and deaths to the detector;
+    // edits mark it stale and it is rebuilt from the live cells before the next step.
     bool patternDetectionEnabled_ = false;
-    std::vector<uint32_t> generationHistory_;
+    CycleDetector cycleDetector_;
+    bool cycleDetectorStale_ = true;
     std::unordered_map<std::string, uint32_t> detectedPatterns_;
     
+    // Generations to step back to, updated under simulationMutex_
+    HistoryJournal history_;
+    
+    // Checkpoints, submitted under simulationMutex_
+    CheckpointWriter checkpointWriter_;
+    uint32_t lastCheckpointGeneration_ = 0;  // Or where the board was last replaced
+    
     // Thread management
     std::thread simulationThread_;
     std::atomic<bool> threadRunning_{false};
+    SimulationHost* host_ = nullptr;  // Set while running on a host
+    uint64_t hostId_ = 0;
 };
 
 } // namespace flecs_gol
\ No newline at end of file
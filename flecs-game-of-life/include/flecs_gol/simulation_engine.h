@@ -0,0 +1,45 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace flecs_gol {
+
+// Storage engine interface for alternative cell representations.
+// GameOfLifeSimulation delegates to an engine when the configuration
+// selects something other than the sparse entity representation.
+class SimulationEngine {
+public:
+    virtual ~SimulationEngine() = default;
+
+    // Cell access - setCell returns false if the position is outside the engine's domain
+    virtual bool setCell(int32_t x, int32_t y, bool alive) = 0;
+    virtual bool isCellAlive(int32_t x, int32_t y) const = 0;
+    virtual uint8_t getNeighborCount(int32_t x, int32_t y) const = 0;
+
+    // Simulation control
+    virtual void step() = 0;
+    virtual void clear() = 0;
+    virtual uint64_t getGenerationsPerStep() const { return 1; }
+
+    // State queries
+    virtual uint32_t getCellCount() const = 0;
+    virtual size_t getMemoryUsage() const = 0;
+
+    // Bounding box of the cells that may have changed in the last step.
+    // Returns false if the last step changed nothing.
+    virtual bool getActiveBounds(int32_t& minX, int32_t& maxX, int32_t& minY, int32_t& maxY) const = 0;
+
+    // Cells born and died in the last step, appended to the output buffers.
+    // Only meaningful right after a step; edits since then are not tracked.
+    virtual void collectChanges(std::vector<Position>& born, std::vector<Position>& died) const = 0;
+
+    // Bulk queries - positions are appended to the output buffer
+    virtual void collectLiveCells(std::vector<Position>& out) const = 0;
+    virtual void collectCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                                      std::vector<Position>& out) const = 0;
+};
+
+} // namespace flecs_gol
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <flecs_gol/work_stealing_pool.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace flecs_gol {
+
+class SimulationController;
+
+// Runs the steps of many simulations on one fixed-size WorkStealingPool, in
+// place of a thread per SimulationController (see SimulationController::start(host)).
+//
+// A scheduler thread keeps the running simulations in a queue ordered by when
+// their next step is due; each simulation's target FPS sets its spacing. Each
+// simulation that comes due is handed to the pool as a task of its own, most
+// overdue first, and the scheduler goes straight back to the queue, so one
+// costly board holds up only itself. Paused simulations, and ones with
+// auto-step off, leave the queue and cost nothing until they are resumed.
+// A step that throws is logged to std::cerr and its simulation is stepped no
+// more until it is stopped and started again; the others carry on.
+class SimulationHost {
+public:
+    // threads counts the scheduler thread (0 = one per hardware thread). With
+    // one, the pool still starts a worker, as steps never run on the scheduler.
+    explicit SimulationHost(uint32_t threads = 0);
+    ~SimulationHost(); // Every controller must have been stopped
+
+    SimulationHost(const SimulationHost&) = delete;
+    SimulationHost& operator=(const SimulationHost&) = delete;
+
+    uint32_t getThreadCount() const { return pool_.getThreadCount(); }
+
+    size_t getSimulationCount() const; // Attached controllers
+    size_t getScheduledCount() const;  // Attached controllers waiting for a step
+    size_t getFailedCount() const;     // Attached controllers whose step threw
+    uint64_t getStepCount() const;     // Steps run since construction
+
+private:
+    friend class SimulationController;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Slot {
+        SimulationController* controller = nullptr;
+        bool scheduled = false; // In the queue
+        bool stepping = false;  // Handed to the pool
+        bool wakeRequested = false;
+        bool failed = false;    // A step threw; never scheduled again
+        Clock::time_point due;
+    };
+
+    struct Due {
+        Clock::time_point due;
+        uint64_t id;
+        bool operator>(const Due& other) const { return due != other.due ? due > other.due : id > other.id; }
+    };
+
+    // Called by SimulationController
+    uint64_t attach(SimulationController& controller);
+    void detach(uint64_t id); // Waits for a step in progress
+    void wake(uint64_t id);   // Schedules the next step now unless one is pending
+
+    void schedulerLoop();
+    void schedule(uint64_t id, Slot& slot, Clock::time_point due);
+    void runStep(uint64_t id, SimulationController* controller, Clock::time_point due);
+
+    WorkStealingPool pool_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable queueChanged_;
+    std::condition_variable stepFinished_;
+    std::unordered_map<uint64_t, Slot> slots_;
+    std::priority_queue<Due, std::vector<Due>, std::greater<Due>> queue_;
+    uint64_t nextId_ = 1;
+    uint64_t steps_ = 0;
+    size_t inFlight_ = 0;  // Steps handed to the pool and not yet finished
+    bool stopping_ = false;
+
+    std::thread scheduler_;
+};
+
+} // namespace flecs_gol
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <flecs_gol/coordinate_map.h>
+#include <flecs_gol/game_config.h>
+#include <flecs_gol/life_engine.h>
+#include <flecs_gol/metrics.h>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace flecs_gol {
+
+// What one stream still owes its client. Steps and edits fold their changes
+// in as they happen, so however many generations pass between two reads the
+// client gets one net delta, and a cell that dies and comes back in between
+// is never sent. Once the delta outgrows its limit it is dropped in favour of
+// a keyframe, the whole board, so a client that falls far behind holds no
+// backlog. Guarded by the session's lock.
+class StreamSubscription {
+public:
+    explicit StreamSubscription(size_t maxPendingCells) : maxPendingCells_(maxPendingCells) {}
+
+private:
+    friend class SimulationSession;
+
+    void record(const Position& pos, bool alive);
+
+    CoordinateMap<bool> pending_; // Cells whose state differs from the client's copy, with their state now
+    size_t maxPendingCells_;
+    bool keyframe_ = true;        // The client's copy is missing or was given up on
+    uint32_t sentGeneration_ = 0;
+};
+
+// One board served over the network, on a 0..width-1 x 0..height-1 grid.
+// Every method locks the session, so RPCs and streams touching the same board
+// are serialized while different boards run in parallel. Cells outside the
+// grid are ignored, also on the HashLife engine.
+class SimulationSession {
+public:
+    struct Snapshot {
+        uint32_t generation = 0;
+        int32_t width = 0;
+        int32_t height = 0;
+        std::vector<Position> cells;
+    };
+
+    struct StepResult {
+        uint32_t generation = 0;
+        uint32_t liveCells = 0;
+        size_t changedCells = 0; // Cells whose state differs from before the request
+    };
+
+    struct StreamUpdate {
+        uint32_t generation = 0;
+        uint32_t liveCells = 0;
+        std::vector<Position> born; // Alive now, dead in the client's copy (every live cell in a keyframe)
+        std::vector<Position> died;
+        bool keyframe = false;      // Replaces the client's copy instead of patching it
+        bool ended = false;         // The board is empty or stopped changing
+    };
+
+    // Pending changes a subscription may hold before it falls back to a keyframe
+    static constexpr size_t DEFAULT_MAX_PENDING_CELLS = 4096;
+
+    SimulationSession(std::string id, std::unique_ptr<LifeEngine> engine);
+
+    SimulationSession(const SimulationSession&) = delete;
+    SimulationSession& operator=(const SimulationSession&) = delete;
+
+    const std::string& getId() const { return id_; }
+
+    Snapshot snapshot() const;
+
+    // Sets the generation if given, and replaces the board with cells if given
+    Snapshot update(std::optional<uint32_t> generation, std::optional<std::span<const Position>> cells);
+
+    // Adds cells moved by offset; returns how many were not already alive
+    size_t addPattern(std::span<const Position> cells, Position offset);
+
+    // Runs steps generations in one go; intermediate boards are never reported.
+    // Throws EntityLimitError while the board is over its entity limit; one
+    // that reaches the limit part way stops early, at the generation returned.
+    StepResult step(uint32_t steps);
+
+    // A stream's view of the board. The session feeds it every change until
+    // the returned subscription is released; its first update is a keyframe.
+    std::shared_ptr<StreamSubscription> subscribe(size_t maxPendingCells = DEFAULT_MAX_PENDING_CELLS);
+
+    // Whether the board or generation moved on since the subscription's last update
+    bool hasUpdate(const StreamSubscription& subscription) const;
+
+    // Everything the subscription has collected since its last update, sorted
+    StreamUpdate takeUpdate(StreamSubscription& subscription);
+
+    // Step and board-read latencies, changes and lock waits of this board
+    const SimulationMetrics& getMetrics() const { return metrics_; }
+
+private:
+    Snapshot snapshotLocked() const;
+    std::vector<Position> sortedCells() const;
+    void publish(std::span<const Position> born, std::span<const Position> died);
+    void publishKeyframe();
+
+    mutable std::mutex mutex_;
+    mutable SimulationMetrics metrics_;
+    std::string id_;
+    std::unique_ptr<LifeEngine> engine_;
+    bool settled_ = false; // The last step changed nothing
+    std::vector<std::weak_ptr<StreamSubscription>> subscribers_;
+};
+
+// Sessions by id, created from a base configuration with the requested grid
+// size. Named initial patterns are read from <patternDirectory>/<name>.json
+// through the PatternCache, or else taken from the embedded patterns/ corpus
+// (see pattern_library.h), so a server needs no pattern files to start.
+class SimulationStore {
+public:
+    static constexpr int32_t MAX_GRID_DIMENSION = 1000; // Same limit as the Bevy server
+
+    explicit SimulationStore(GameConfig baseConfig, std::string patternDirectory = "patterns");
+
+    // Throws std::invalid_argument for a bad grid size or an unknown pattern
+    std::shared_ptr<SimulationSession> create(int32_t width, int32_t height, const std::string& initialPattern = "");
+
+    std::shared_ptr<SimulationSession> find(const std::string& id) const; // nullptr if unknown
+    bool erase(const std::string& id);
+    size_t size() const;
+
+    // Every session, in no particular order
+    std::vector<std::shared_ptr<SimulationSession>> list() const;
+
+    const GameConfig& getBaseConfig() const { return baseConfig_; }
+
+private:
+    std::vector<Position> readNamedPattern(const std::string& name) const;
+    std::string nextId();
+
+    GameConfig baseConfig_;
+    std::string patternDirectory_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<SimulationSession>> sessions_;
+    std::mt19937_64 idGenerator_;
+};
+
+} // namespace flecs_gol
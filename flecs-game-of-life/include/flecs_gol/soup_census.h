@@ -0,0 +1,115 @@
+#pragma once
+
+#include <flecs_gol/board_ensemble.h>
+#include <flecs_gol/components.h>
+#include <flecs_gol/life_rule.h>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace flecs_gol {
+
+// Soup census: seeded random soups run to stability on a BoardEnsemble per
+// worker, with the final ash split into objects and tallied by
+// shape, so a census of many soups shows which objects soups leave behind.
+
+// An object's canonical form: of its 8 rotations and reflections, each moved
+// so its cells start at (0, 0) and sorted, the lexicographically smallest.
+// Two objects have the same canonical form exactly when one is a rotated,
+// reflected or moved copy of the other.
+std::vector<Position> canonicalObjectCells(std::span<const Position> cells);
+
+// Hash of a canonical form, so equal shapes hash equally wherever they sit
+uint64_t objectHash(std::span<const Position> canonical);
+
+// Splits cells of a width x height board into objects. Cells at most two
+// apart in x and in y are grouped, then each group's touching pieces are kept
+// apart unless stepping two of them together for two generations differs
+// from stepping them apart under rule. So the phases of oscillators such as
+// the toad stay whole while nearby still lifes count separately. With
+// wrapEdges, distances run across the board edges, and an object spanning an
+// edge is returned in unwrapped coordinates continuing past it. Cells off the
+// board are ignored.
+std::vector<std::vector<Position>> splitObjects(std::span<const Position> cells, int32_t width,
+                                                int32_t height, bool wrapEdges, const LifeRule& rule = {});
+
+struct ObjectShapeHash {
+    size_t operator()(const std::vector<Position>& canonical) const {
+        return static_cast<size_t>(objectHash(canonical));
+    }
+};
+
+struct KnownObject {
+    std::string name;
+    std::vector<Position> cells; // Canonical form of the phase it was registered in
+};
+
+// Names of known objects, by canonical form. Oscillators and spaceships are
+// registered in every phase, so the ash is named whichever phase it ended in.
+class ObjectCatalog {
+public:
+    // Starts with the common still lifes, blinker and glider
+    explicit ObjectCatalog(const LifeRule& rule = {});
+
+    // Registers every phase of a pattern that returns to its own shape within
+    // period generations under the catalog's rule; false (and nothing
+    // registered) for one that does not, such as a methuselah or gun
+    bool addPattern(const std::string& name, std::span<const Position> cells, uint32_t period);
+
+    // Adds every *.json pattern in directory ({"name", "period", "cells"}),
+    // returning how many were registered. Throws std::runtime_error if the
+    // directory or a pattern file cannot be read.
+    size_t loadPatternDirectory(const std::string& directory);
+
+    // The known object with this canonical form in any phase, or nullptr
+    const KnownObject* find(const std::vector<Position>& canonical) const;
+
+    // Name of the object with this canonical form, or empty if unknown
+    std::string nameOf(const std::vector<Position>& canonical) const;
+
+    size_t getShapeCount() const { return names_.size(); }
+
+private:
+    LifeRule rule_;
+    std::unordered_map<std::vector<Position>, KnownObject, ObjectShapeHash> names_; // By every phase
+};
+
+struct SoupCensusConfig {
+    uint64_t soups = 1000;
+    uint32_t seed = 1;     // Soup i is makeSoup(soupSize, soupSize, density, seed + i)
+    int32_t soupSize = 16; // Placed in the middle of the board
+    double density = 0.5;
+    int32_t boardSize = BoardEnsemble::MAX_WIDTH; // Square
+    bool wrapEdges = true;
+    uint32_t generationLimit = 4000; // Soups still changing by then are tallied as they are
+    uint32_t threads = 0;            // 0 = one per hardware thread
+    uint32_t soupsPerEnsemble = 256;
+    LifeRule rule;
+};
+
+struct CensusObject {
+    std::vector<Position> cells; // Canonical form; known objects in their registered phase, whatever they ended in
+    std::string name;            // Empty if the catalog does not know it
+    uint64_t count{0};
+};
+
+struct SoupCensusResult {
+    uint64_t soups{0};
+    uint64_t diedOut{0};
+    uint64_t settled{0};   // Ended in a still life or period-2 oscillator
+    uint64_t unsettled{0}; // Still changing at the generation limit, e.g. with gliders in flight
+    uint64_t boardGenerations{0};
+    std::chrono::nanoseconds elapsed{0};
+    std::vector<CensusObject> objects; // Most common first, then by name and shape
+};
+
+// Runs the census across config.threads workers. The result does not depend
+// on the thread count. Throws std::invalid_argument for a soup larger than
+// the board, a board the ensemble cannot hold or a generation limit of 0.
+SoupCensusResult runSoupCensus(const SoupCensusConfig& config, const ObjectCatalog& catalog);
+
+} // namespace flecs_gol
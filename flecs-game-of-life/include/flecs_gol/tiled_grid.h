@@ -0,0 +1,136 @@
+#pragma once
+
+#include <flecs_gol/simulation_engine.h>
+#include <flecs_gol/game_config.h>
+#include <flecs_gol/dense_kernels.h>
+#include <flecs_gol/work_stealing_pool.h>
+#include <array>
+#include <span>
+#include <vector>
+
+namespace flecs_gol {
+
+// Bit-packed grid split into fixed 64x64 tiles that are stepped in parallel.
+// Covers exactly the configured grid boundaries; honours edge wrapping.
+//
+// Each tile is 64 rows of one 64-bit word. A tile step gathers a halo - the
+// row above and below plus the bordering word of each row on both sides -
+// from its neighbors into a private buffer, so workers only ever read the
+// current generation and write their own tile of the next one.
+//
+// Only active tiles are stepped: a tile is dirty when it changed in the last
+// step or was edited since, and a tile is active when it or one of its eight
+// neighbors is dirty. Skipped tiles need no copy, as the spare buffer still
+// holds the previous generation, which equals the current one.
+//
+// step(generations) blocks in time as well: each worker copies a whole row
+// of tiles plus BLOCK_GENERATIONS rows above and below into a buffer small
+// enough to stay in cache, advances it that many generations there, and
+// writes back only the tile rows. The halo shrinks by one row a generation,
+// so the tile rows come out exact, and board memory is swept once per block
+// instead of once per generation. A block is too short for a change to cross
+// a whole tile, so inactive tiles are still skipped.
+//
+// Tiles are owned in contiguous runs: the worker that steps a tile is the
+// one that zeroed it when the grid was built, and with NUMA placement on
+// (GameConfig::setNumaPlacement) the tile's pages are placed on that
+// worker's node, so workers read local memory except at the edges of their run.
+class TiledGrid : public SimulationEngine {
+public:
+    static constexpr uint32_t TILE_SIZE = 64;
+    static constexpr uint32_t BLOCK_GENERATIONS = 8; // Generations per pass of step(generations)
+
+    explicit TiledGrid(const GameConfig& config);
+    ~TiledGrid() override = default;
+
+    // SimulationEngine interface
+    bool setCell(int32_t x, int32_t y, bool alive) override;
+    bool isCellAlive(int32_t x, int32_t y) const override;
+    uint8_t getNeighborCount(int32_t x, int32_t y) const override;
+
+    void step() override;
+    void clear() override;
+
+    // Advances the given number of generations, BLOCK_GENERATIONS per pass
+    // over memory; the changes then cover all of them. Wrapped grids whose
+    // width is not a multiple of 64 step one generation at a time.
+    void step(uint32_t generations);
+
+    uint32_t getCellCount() const override { return population_; }
+    size_t getMemoryUsage() const override;
+    bool getActiveBounds(int32_t& minX, int32_t& maxX, int32_t& minY, int32_t& maxY) const override;
+    void collectChanges(std::vector<Position>& born, std::vector<Position>& died) const override;
+
+    void collectLiveCells(std::vector<Position>& out) const override;
+    void collectCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                              std::vector<Position>& out) const override;
+
+    // Whole rows as getTilesX() words each, counted from the top of the grid,
+    // bit (col & 63) of word (col >> 6): copyRows appends rows [row, row + rows)
+    // to out, setRows overwrites them from words and marks their tiles dirty.
+    // Used to move slab edges between PartitionedBoard ranks.
+    void copyRows(uint32_t row, uint32_t rows, std::vector<uint64_t>& out) const;
+    void setRows(uint32_t row, uint32_t rows, std::span<const uint64_t> words);
+
+    // Layout and threading queries
+    uint32_t getTilesX() const { return tilesX_; }
+    uint32_t getTilesY() const { return tilesY_; }
+    uint32_t getThreadCount() const { return pool_.getThreadCount(); }
+    uint32_t getNodeCount() const { return pool_.getTopology().getNodeCount(); }
+    uint64_t getStealCount() const { return pool_.getStealCount(); }
+    uint64_t getRemoteStealCount() const { return pool_.getRemoteStealCount(); }
+
+    // True if the tile changed in the last step or was edited since
+    bool tileChanged(uint32_t tileX, uint32_t tileY) const { return changed_[tileIndex(tileX, tileY)] != 0; }
+
+    // Tiles stepped by the last step; the rest were skipped as stable
+    size_t getActiveTileCount() const { return activeTiles_.size(); }
+
+private:
+    using Tile = std::array<uint64_t, TILE_SIZE>;
+    using TileBuffer = std::vector<Tile, PlacementAllocator<Tile>>;
+
+    size_t tileIndex(uint32_t tileX, uint32_t tileY) const { return static_cast<size_t>(tileY) * tilesX_ + tileX; }
+
+    // Word of the current generation holding columns [64 * word, 64 * word + 63] of a row.
+    // Rows outside the grid wrap or read as zero; words outside the grid read as zero.
+    uint64_t haloWord(int64_t word, int64_t row) const;
+
+    bool getBit(uint32_t col, uint32_t row) const;
+    uint8_t countNeighbors(int64_t col, int64_t row) const;
+    void collectActiveTiles();
+    void stepTile(size_t index);
+    void stepTileRow(uint32_t tileY, uint32_t generations);
+    void patchWrappedColumn(uint32_t col);
+    void recountPopulation();
+
+    // Sizes tiles to the grid, each tile placed on its owner's node and
+    // zeroed by its owner
+    void placeTiles(TileBuffer& tiles);
+
+    int32_t originX_;
+    int32_t originY_;
+    uint32_t width_;
+    uint32_t height_;
+    uint32_t tilesX_;
+    uint32_t tilesY_;
+    uint64_t lastWordMask_;  // Valid bits of the last tile column
+    bool wrapEdges_;
+    DenseKernel kernel_;
+    LifeRule rule_;
+    bool conwayRule_; // B3/S23 takes the kernel's dedicated stepRow
+
+    // Current and next generation, tiles in row-major order
+    TileBuffer cells_;
+    TileBuffer next_;
+    std::vector<uint8_t> changed_;      // Dirty flag per tile, written by its own worker
+    std::vector<uint8_t> active_;       // Per tile, set for tiles in activeTiles_
+    std::vector<size_t> activeTiles_;   // Tiles to step, in row-major order
+    std::vector<uint32_t> tileCounts_;  // Population per tile
+    TileBuffer passStart_;              // Board before a step(generations) of several passes
+    uint32_t population_ = 0;
+
+    WorkStealingPool pool_;
+};
+
+} // namespace flecs_gol
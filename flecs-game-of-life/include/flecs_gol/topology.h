@@ -0,0 +1,81 @@
+#pragma once
+
+#include <flecs_gol/components.h>
+#include <flecs_gol/game_config.h>
+#include <cstdint>
+
+namespace flecs_gol {
+
+// Grid topologies the per-cell neighbor loops are instantiated for. A loop
+// picks its topology once (withTopology()), then visits neighbors through
+// forEachNeighbor(): cells off the border take the eight offsets as they
+// are, with no bounds test or wrap, and only border cells pay for either.
+// Wrapping compares against the edges instead of using %, since a neighbor
+// is never more than one cell past them.
+//
+// Positions passed in must be inside the bounds. The unbounded planes
+// (HashLife, ChunkedPlane) never go through these loops.
+
+// Cells past the bounds are dead
+struct BoundedTopology {
+    int32_t minX;
+    int32_t maxX;
+    int32_t minY;
+    int32_t maxY;
+
+    // Neighbor of a border cell; false if it falls outside the bounds
+    bool borderNeighbor(int32_t x, int32_t y, Position& out) const {
+        if (x < minX || x > maxX || y < minY || y > maxY) {
+            return false;
+        }
+        out = Position(x, y);
+        return true;
+    }
+};
+
+// Opposite edges are joined
+struct TorusTopology {
+    int32_t minX;
+    int32_t maxX;
+    int32_t minY;
+    int32_t maxY;
+
+    bool borderNeighbor(int32_t x, int32_t y, Position& out) const {
+        const int32_t width = maxX - minX + 1;
+        const int32_t height = maxY - minY + 1;
+        out = Position(x < minX ? x + width : (x > maxX ? x - width : x),
+                       y < minY ? y + height : (y > maxY ? y - height : y));
+        return true;
+    }
+};
+
+// Calls fn with the topology of the configured grid
+template <typename Fn>
+decltype(auto) withTopology(const GameConfig& config, Fn&& fn) {
+    if (config.getWrapEdges()) {
+        return fn(TorusTopology{config.getGridMinX(), config.getGridMaxX(), config.getGridMinY(), config.getGridMaxY()});
+    }
+    return fn(BoundedTopology{config.getGridMinX(), config.getGridMaxX(), config.getGridMinY(), config.getGridMaxY()});
+}
+
+// Calls fn with each of the (up to) eight neighbors of an in-bounds position
+template <typename Topology, typename Fn>
+inline void forEachNeighbor(const Topology& topology, const Position& pos, Fn&& fn) {
+    constexpr int32_t OFFSETS[8][2] = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+
+    // Grids under three cells across have no interior; their border path wraps like % would
+    if (pos.x > topology.minX && pos.x < topology.maxX && pos.y > topology.minY && pos.y < topology.maxY) {
+        for (const auto& offset : OFFSETS) {
+            fn(Position(pos.x + offset[0], pos.y + offset[1]));
+        }
+        return;
+    }
+    for (const auto& offset : OFFSETS) {
+        Position neighbor;
+        if (topology.borderNeighbor(pos.x + offset[0], pos.y + offset[1], neighbor)) {
+            fn(neighbor);
+        }
+    }
+}
+
+} // namespace flecs_gol
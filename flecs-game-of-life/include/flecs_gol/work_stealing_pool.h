@@ -0,0 +1,120 @@
+#pragma once
+
+#include <flecs_gol/numa_topology.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace flecs_gol {
+
+// How a pool's workers are laid out over NUMA nodes
+struct WorkerPlacement {
+    NumaTopology topology;  // The default single node leaves placement to the OS
+    bool pinThreads = false; // Pin each spawned worker to one CPU of its node
+};
+
+// Fixed-size thread pool for data-parallel loops.
+//
+// parallelFor() deals the task indices in contiguous blocks, one queue per
+// worker, so a worker gets the same block every batch of the same size and
+// can own the memory behind it. Each worker drains its own queue from the
+// front and, once empty, steals from the back of the others, so uneven tiles
+// balance out without a shared queue. The calling thread takes part as
+// worker 0.
+//
+// Workers are spread over the placement's nodes in contiguous groups, so
+// each node owns one contiguous range of every batch. A worker steals from
+// the workers of its own node before it reaches across to another.
+class WorkStealingPool {
+public:
+    // threads counts the calling thread (0 = one per hardware thread).
+    // The calling thread is never pinned; the pool does not own it.
+    explicit WorkStealingPool(uint32_t threads = 0, WorkerPlacement placement = {});
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    uint32_t getThreadCount() const { return static_cast<uint32_t>(queues_.size()); }
+
+    // Runs task(i) for every i in [0, count) and returns when all are done.
+    // task must be safe to call concurrently for different indices.
+    void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+    // As above, but task i starts in the queue of worker owner(i), for
+    // batches whose indices do not line up with the memory they touch
+    void parallelFor(size_t count, const std::function<void(size_t)>& task,
+                     const std::function<uint32_t(size_t)>& owner);
+
+    // Runs task(worker) once on every worker's own thread; nothing is
+    // stolen. Used to first-touch the memory each worker owns.
+    void forEachWorker(const std::function<void(size_t)>& task);
+
+    // Queues task for the next free spawned worker and returns at once, for
+    // work the caller must not wait on (see SimulationHost). Tasks start in
+    // the order submitted; the destructor runs any still queued. A pool of
+    // one thread starts a worker for them on the first submit, so a task
+    // never runs inside its caller. A worker busy with one takes no part in
+    // batches until it returns, so forEachWorker() would wait for it. An
+    // exception a task lets out is written to std::cerr and dropped.
+    void submit(std::function<void()> task);
+
+    // Worker whose queue index starts in when parallelFor() deals count tasks
+    uint32_t getOwner(size_t index, size_t count) const {
+        return static_cast<uint32_t>(index * queues_.size() / count);
+    }
+
+    // Node (an index into getTopology()) a worker belongs to
+    uint32_t getWorkerNode(size_t worker) const { return workerNodes_[worker]; }
+    const NumaTopology& getTopology() const { return placement_.topology; }
+
+    // Tasks taken from another worker's queue since construction; the remote
+    // ones came from a worker on another node
+    uint64_t getStealCount() const { return steals_.load(std::memory_order_relaxed); }
+    uint64_t getRemoteStealCount() const { return remoteSteals_.load(std::memory_order_relaxed); }
+
+private:
+    // Pending tasks are items[head, size). The vector is cleared rather than
+    // shrunk once drained, so batches after the first allocate nothing.
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<size_t> items;
+        size_t head = 0;
+    };
+
+    void runBatch(size_t count, const std::function<void(size_t)>& task,
+                  const std::function<uint32_t(size_t)>* owner, bool stealing);
+    void workerLoop(size_t worker);
+    bool takeTask(size_t worker, size_t& index);
+    void runTasks(size_t worker);
+
+    WorkerPlacement placement_;
+    std::vector<uint32_t> workerNodes_;
+    std::vector<uint32_t> workerCpus_; // CPU each spawned worker is pinned to, if pinning
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    // Batch hand-off between parallelFor() and the workers
+    std::mutex batchMutex_;
+    std::condition_variable batchStarted_;
+    std::condition_variable batchFinished_;
+    const std::function<void(size_t)>* task_ = nullptr;
+    uint64_t batch_ = 0;
+    std::atomic<size_t> remaining_{0};
+    std::atomic<bool> stealing_{true};
+    std::deque<std::function<void()>> submitted_;  // Queued by submit()
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> steals_{0};
+    std::atomic<uint64_t> remoteSteals_{0};
+};
+
+} // namespace flecs_gol
@@ -1,9 +1,30 @@
 #include <flecs_gol/game_config.h>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 
 namespace flecs_gol {
 
+const char* engineTypeToString(EngineType type) {
+    switch (type) {
+        case EngineType::Sparse: return "sparse";
+        case EngineType::Dense: return "dense";
+        case EngineType::Tiled: return "tiled";
+        case EngineType::HashLife: return "hashlife";
+        case EngineType::Chunked: return "chunked";
+    }
+    return "sparse";
+}
+
+std::optional<EngineType> engineTypeFromString(const std::string& name) {
+    if (name == "sparse") return EngineType::Sparse;
+    if (name == "dense") return EngineType::Dense;
+    if (name == "tiled") return EngineType::Tiled;
+    if (name == "hashlife") return EngineType::HashLife;
+    if (name == "chunked") return EngineType::Chunked;
+    return std::nullopt;
+}
+
 GameConfig::GameConfig() {
     // Default values are set in header
 }
@@ -30,10 +51,27 @@ bool GameConfig::validate() const {
         return false;
     }
     
+    if (generationsPerFrame_ == 0) {
+        return false;
+    }
+    
     if (maxEntities_ == 0) {
         return false;
     }
     
+    if (checkpointInterval_ > 0 && checkpointPath_.empty()) {
+        return false;
+    }
+    
+    if (hashLifeStepLog2_ > 48) {
+        return false;
+    }
+    
+    if (sparseDensityThreshold_ < 0.0 || sparseDensityThreshold_ >= denseDensityThreshold_ ||
+        denseDensityThreshold_ > 1.0) {
+        return false;
+    }
+    
     return true;
 }
 
@@ -49,11 +87,27 @@ nlohmann::json GameConfig::toJson() const {
     
     // Simulation configuration
     json["simulation"]["targetFPS"] = targetFPS_;
+    json["simulation"]["generationsPerFrame"] = generationsPerFrame_;
+    json["simulation"]["frameStepBudgetMs"] = frameStepBudgetMs_;
     json["simulation"]["maxGenerations"] = maxGenerations_;
+    json["simulation"]["rule"] = rule_.toString();
+    json["simulation"]["checkpointPath"] = checkpointPath_;
+    json["simulation"]["checkpointInterval"] = checkpointInterval_;
     
     // Performance configuration
     json["performance"]["maxEntities"] = maxEntities_;
     json["performance"]["enableProfiling"] = enableProfiling_;
+    json["performance"]["workerThreads"] = workerThreads_;
+    json["performance"]["numaPlacement"] = numaPlacement_;
+    json["performance"]["pinWorkerThreads"] = pinWorkerThreads_;
+    json["performance"]["numaNodeLimit"] = numaNodeLimit_;
+    json["performance"]["engine"] = engineTypeToString(engineType_);
+    json["performance"]["hashlifeStepLog2"] = hashLifeStepLog2_;
+    json["performance"]["adaptiveEngine"] = adaptiveEngine_;
+    json["performance"]["denseDensityThreshold"] = denseDensityThreshold_;
+    json["performance"]["sparseDensityThreshold"] = sparseDensityThreshold_;
+    json["performance"]["cellSortInterval"] = cellSortInterval_;
+    json["performance"]["historyBudgetMB"] = historyBudgetMB_;
     
     return json;
 }
@@ -78,7 +132,19 @@ GameConfig GameConfig::fromJson(const nlohmann::json& json) {
     if (json.contains("simulation")) {
         const auto& simulation = json["simulation"];
         if (simulation.contains("targetFPS")) config.targetFPS_ = simulation["targetFPS"];
+        if (simulation.contains("generationsPerFrame")) config.generationsPerFrame_ = simulation["generationsPerFrame"];
+        if (simulation.contains("frameStepBudgetMs")) config.frameStepBudgetMs_ = simulation["frameStepBudgetMs"];
         if (simulation.contains("maxGenerations")) config.maxGenerations_ = simulation["maxGenerations"];
+        if (simulation.contains("rule")) {
+            const std::string text = simulation["rule"].get<std::string>();
+            auto rule = LifeRule::parse(text);
+            if (!rule.has_value()) {
+                throw std::invalid_argument("Invalid rule: " + text);
+            }
+            config.rule_ = rule.value();
+        }
+        if (simulation.contains("checkpointPath")) config.checkpointPath_ = simulation["checkpointPath"];
+        if (simulation.contains("checkpointInterval")) config.checkpointInterval_ = simulation["checkpointInterval"];
     }
     
     // Performance settings
@@ -86,6 +152,24 @@ GameConfig GameConfig::fromJson(const nlohmann::json& json) {
         const auto& performance = json["performance"];
         if (performance.contains("maxEntities")) config.maxEntities_ = performance["maxEntities"];
         if (performance.contains("enableProfiling")) config.enableProfiling_ = performance["enableProfiling"];
+        if (performance.contains("workerThreads")) config.workerThreads_ = performance["workerThreads"];
+        if (performance.contains("numaPlacement")) config.numaPlacement_ = performance["numaPlacement"];
+        if (performance.contains("pinWorkerThreads")) config.pinWorkerThreads_ = performance["pinWorkerThreads"];
+        if (performance.contains("numaNodeLimit")) config.numaNodeLimit_ = performance["numaNodeLimit"];
+        if (performance.contains("engine")) {
+            auto engine = engineTypeFromString(performance["engine"].get<std::string>());
+            if (engine.has_value()) config.engineType_ = engine.value();
+        }
+        if (performance.contains("hashlifeStepLog2")) config.hashLifeStepLog2_ = performance["hashlifeStepLog2"];
+        if (performance.contains("adaptiveEngine")) config.adaptiveEngine_ = performance["adaptiveEngine"];
+        if (performance.contains("denseDensityThreshold")) {
+            config.denseDensityThreshold_ = performance["denseDensityThreshold"];
+        }
+        if (performance.contains("sparseDensityThreshold")) {
+            config.sparseDensityThreshold_ = performance["sparseDensityThreshold"];
+        }
+        if (performance.contains("cellSortInterval")) config.cellSortInterval_ = performance["cellSortInterval"];
+        if (performance.contains("historyBudgetMB")) config.historyBudgetMB_ = performance["historyBudgetMB"];
     }
     
     return config;
@@ -79,6 +79,7 @@ std::string ConsoleInput::getKeyDescription(InputEvent event) {
     switch (event) {
         case InputEvent::PAUSE_RESUME: return "SPACE - Pause/Resume simulation";
         case InputEvent::STEP: return ". or > - Single step";
+        case InputEvent::STEP_BACK: return ", or < - Step back";
         case InputEvent::RESET: return "R - Reset simulation";
         case InputEvent::QUIT: return "Q/ESC - Quit";
         case InputEvent::MOVE_UP: return "W - Move view up";
@@ -112,6 +113,7 @@ std::string ConsoleInput::getHelpText() {
 Simulation Control:
   SPACE    - Pause/Resume simulation
   . or >   - Single step (when paused)
+  , or <   - Step back through history
   R        - Reset simulation
   Q/ESC    - Quit application
 
@@ -295,6 +297,8 @@ InputEvent ConsoleInput::mapKeyToEvent(int key) {
         case KEY_SPACE: return InputEvent::PAUSE_RESUME;
         case '.':
         case '>': return InputEvent::STEP;
+        case ',':
+        case '<': return InputEvent::STEP_BACK;
         case 'r': return InputEvent::RESET;
         case 'q':
         case KEY_ESCAPE: return InputEvent::QUIT;
@@ -1,4 +1,5 @@
 #include <flecs_gol/console_renderer.h>
+#include <flecs_gol/trace.h>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -57,24 +58,33 @@ ConsoleRenderer::ConsoleRenderer(const ViewportConfig& config)
 }
 
 void ConsoleRenderer::render(const SimulationController& controller) {
+    FLECS_GOL_TRACE_SCOPE("ConsoleRenderer::render");
     auto renderStart = std::chrono::high_resolution_clock::now();
     
     // Get current state and cells
     auto state = controller.getState();
     
-    // Calculate viewport bounds
-    auto [minX, minY] = calculateBounds();
-    int32_t maxX = minX + static_cast<int32_t>(config_.width) - 1;
-    int32_t maxY = minY + static_cast<int32_t>(config_.height) - 1;
-    
-    // Get cells in viewport
-    auto cells = controller.getCellsInRegion(minX, maxX, minY, maxY);
-    
-    // Auto-center on activity if enabled
-    if (config_.autoCenter && !cells.empty()) {
-        auto [activityX, activityY] = findActivityCenter(cells);
-        config_.centerX = activityX;
-        config_.centerY = activityY;
+    // Zoomed out, the overview reads block counts from the latest snapshot
+    std::shared_ptr<const GridSnapshot> snapshot;
+    std::span<const Position> cells;
+    if (config_.scaleLog2 > 0) {
+        snapshot = controller.getSnapshot();
+    } else {
+        // Calculate viewport bounds
+        auto [minX, minY] = calculateBounds();
+        int32_t maxX = minX + static_cast<int32_t>(config_.width) - 1;
+        int32_t maxY = minY + static_cast<int32_t>(config_.height) - 1;
+        
+        // Get cells in viewport, reusing the buffer across frames
+        controller.getPositionsInRegion(minX, maxX, minY, maxY, viewportCells_);
+        cells = viewportCells_;
+        
+        // Auto-center on activity if enabled
+        if (config_.autoCenter && !cells.empty()) {
+            auto [activityX, activityY] = findActivityCenter(cells);
+            config_.centerX = activityX;
+            config_.centerY = activityY;
+        }
     }
     
     // Clear and render
@@ -84,7 +94,11 @@ void ConsoleRenderer::render(const SimulationController& controller) {
         renderBorder();
     }
     
-    renderGrid(cells);
+    if (snapshot) {
+        renderOverview(snapshot->cells);
+    } else {
+        renderGrid(cells);
+    }
     
     if (config_.showUI) {
         renderUI(state);
@@ -110,13 +124,15 @@ void ConsoleRenderer::setViewport(int32_t centerX, int32_t centerY) {
 }
 
 void ConsoleRenderer::moveViewport(int32_t deltaX, int32_t deltaY) {
-    config_.centerX += deltaX;
-    config_.centerY += deltaY;
+    config_.centerX += static_cast<int32_t>(int64_t{deltaX} << config_.scaleLog2);
+    config_.centerY += static_cast<int32_t>(int64_t{deltaY} << config_.scaleLog2);
     config_.autoCenter = false;
 }
 
 void ConsoleRenderer::zoomIn() {
-    if (config_.width > 20 && config_.height > 10) {
+    if (config_.scaleLog2 > 0) {
+        config_.scaleLog2--;
+    } else if (config_.width > 20 && config_.height > 10) {
         config_.width = static_cast<uint32_t>(config_.width * 0.8);
         config_.height = static_cast<uint32_t>(config_.height * 0.8);
     }
@@ -130,6 +146,8 @@ void ConsoleRenderer::zoomOut() {
         // Clamp to terminal size
         config_.width = std::min(config_.width, terminalWidth_ - 2);
         config_.height = std::min(config_.height, terminalHeight_ - 5);
+    } else if (config_.scaleLog2 < RegionIndex::MAX_SCALE_LOG2) {
+        config_.scaleLog2++;
     }
 }
 
@@ -138,6 +156,7 @@ void ConsoleRenderer::resetViewport() {
     config_.centerY = 0;
     config_.width = std::min(80u, terminalWidth_ - 2);
     config_.height = std::min(24u, terminalHeight_ - 5);
+    config_.scaleLog2 = 0;
     config_.autoCenter = true;
 }
 
@@ -181,7 +200,7 @@ void ConsoleRenderer::clearScreen() {
     }
 }
 
-void ConsoleRenderer::renderGrid(const std::vector<CellData>& cells) {
+void ConsoleRenderer::renderGrid(std::span<const Position> cells) {
     // First, fill grid area with dead chars
     auto [minX, minY] = calculateBounds();
     
@@ -208,6 +227,35 @@ void ConsoleRenderer::renderGrid(const std::vector<CellData>& cells) {
     }
 }
 
+void ConsoleRenderer::renderOverview(const RegionIndex& cells) {
+    FLECS_GOL_TRACE_SCOPE("ConsoleRenderer::renderOverview");
+    const uint32_t scale = config_.scaleLog2;
+    const uint64_t blockArea = uint64_t{1} << (2 * scale);
+    const int32_t minBlockX = (config_.centerX >> scale) - static_cast<int32_t>(config_.width / 2);
+    const int32_t minBlockY = (config_.centerY >> scale) - static_cast<int32_t>(config_.height / 2);
+    const uint64_t rampSize = std::char_traits<char>::length(DENSITY_RAMP);
+    
+    if (config_.useColors) {
+        setColor(COLOR_GREEN);
+    }
+    
+    for (uint32_t screenY = 0; screenY < config_.height; ++screenY) {
+        for (uint32_t screenX = 0; screenX < config_.width; ++screenX) {
+            const uint64_t count = cells.countBlock(scale, minBlockX + static_cast<int32_t>(screenX),
+                                                    minBlockY + static_cast<int32_t>(screenY));
+            char shade = config_.deadChar;
+            if (count > 0) {
+                shade = DENSITY_RAMP[std::min(rampSize - 1, count * 2 * rampSize / blockArea)];
+            }
+            writeToBuffer(screenX + 1, screenY + 1, shade);
+        }
+    }
+    
+    if (config_.useColors) {
+        resetColor();
+    }
+}
+
 void ConsoleRenderer::renderBorder() {
     if (config_.useColors) {
         setColor(COLOR_BLUE);
@@ -248,6 +296,9 @@ void ConsoleRenderer::renderUI(const SimulationState& state) {
     line1 << "Generation: " << state.generation 
           << " | Cells: " << state.liveCellCount
           << " | Memory: " << (state.memoryUsage / 1024) << "KB";
+    if (state.entityLimitReached) {
+        line1 << " | ENTITY LIMIT";
+    }
     writeToBuffer(0, uiStartY, line1.str());
     
     // Second line: FPS and timing
@@ -255,6 +306,9 @@ void ConsoleRenderer::renderUI(const SimulationState& state) {
     line2 << "FPS: " << std::fixed << std::setprecision(1) << state.actualFPS
           << " | Step: " << (state.lastStepTimeMicros / 1000.0) << "ms"
           << " | Avg: " << (state.averageStepTimeMicros / 1000.0) << "ms";
+    if (state.frameGenerations > 1) {
+        line2 << " | Gens/frame: " << state.frameGenerations;
+    }
     writeToBuffer(0, uiStartY + 1, line2.str());
     
     // Third line: Status and controls
@@ -270,6 +324,9 @@ void ConsoleRenderer::renderUI(const SimulationState& state) {
     }
     
     line3 << " | Viewport: (" << config_.centerX << "," << config_.centerY << ")";
+    if (config_.scaleLog2 > 0) {
+        line3 << " | Scale: 1:" << (uint64_t{1} << config_.scaleLog2);
+    }
     writeToBuffer(0, uiStartY + 2, line3.str());
     
     // Controls help
@@ -277,7 +334,7 @@ void ConsoleRenderer::renderUI(const SimulationState& state) {
         setColor(COLOR_YELLOW);
     }
     
-    writeToBuffer(0, uiStartY + 4, "Controls: SPACE=pause/resume, .>=step, R=reset, Q=quit, WASD=move, +/-=zoom");
+    writeToBuffer(0, uiStartY + 4, "Controls: SPACE=pause/resume, .>=step, ,<=back, R=reset, Q=quit, WASD=move, +/-=zoom");
     
     if (config_.useColors) {
         resetColor();
@@ -290,7 +347,7 @@ std::pair<int32_t, int32_t> ConsoleRenderer::calculateBounds() const {
     return {minX, minY};
 }
 
-std::pair<int32_t, int32_t> ConsoleRenderer::findActivityCenter(const std::vector<CellData>& cells) const {
+std::pair<int32_t, int32_t> ConsoleRenderer::findActivityCenter(std::span<const Position> cells) const {
     if (cells.empty()) {
         return {config_.centerX, config_.centerY};
     }
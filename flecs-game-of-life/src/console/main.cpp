@@ -2,6 +2,11 @@
 #include <flecs_gol/simulation_controller.h>
 #include <flecs_gol/console_renderer.h>
 #include <flecs_gol/console_input.h>
+#include <flecs_gol/trace.h>
+#include <flecs_gol/metrics.h>
+#include <flecs_gol/soup_census.h>
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <chrono>
 #include <csignal>
@@ -13,6 +18,10 @@
 
 using namespace flecs_gol;
 
+constexpr std::chrono::seconds METRICS_INTERVAL{5};
+constexpr const char* PATTERN_DIRECTORY = "../patterns";
+constexpr size_t CENSUS_ROWS = 40;
+
 // Global state for signal handling
 std::atomic<bool> g_shouldExit{false};
 
@@ -57,9 +66,35 @@ public:
                 headlessMode_ = true;
             } else if (arg == "--fps" && i + 1 < argc) {
                 targetFPS_ = std::stoi(argv[++i]);
+            } else if (arg == "--gens-per-frame" && i + 1 < argc) {
+                generationsPerFrame_ = static_cast<uint32_t>(std::stoul(argv[++i]));
+            } else if (arg == "--frame-budget" && i + 1 < argc) {
+                frameStepBudgetMs_ = static_cast<uint32_t>(std::stoul(argv[++i]));
+            } else if (arg == "--trace" && i + 1 < argc) {
+                traceFile_ = argv[++i];
+            } else if (arg == "--metrics" && i + 1 < argc) {
+                metricsFile_ = argv[++i];
+            } else if (arg == "--census" && i + 1 < argc) {
+                censusSoups_ = std::stoull(argv[++i]);
+                headlessMode_ = true;
+            } else if (arg == "--seed" && i + 1 < argc) {
+                censusSeed_ = static_cast<uint32_t>(std::stoul(argv[++i]));
+            } else if (arg == "--checkpoint" && i + 1 < argc) {
+                checkpointFile_ = argv[++i];
+            } else if (arg == "--checkpoint-every" && i + 1 < argc) {
+                checkpointInterval_ = static_cast<uint32_t>(std::stoul(argv[++i]));
+            } else if (arg == "--resume" && i + 1 < argc) {
+                resumeFile_ = argv[++i];
             }
         }
         
+        if (!traceFile_.empty()) {
+#ifndef FLECS_GOL_PROFILING_ENABLED
+            std::cout << "Tracing is compiled out; rebuild with -DENABLE_PROFILING=ON" << std::endl;
+#endif
+            Trace::setEnabled(true);
+        }
+        
         // Load configuration
         try {
             auto loadedConfig = GameConfig::loadFromFile(configFile);
@@ -73,6 +108,18 @@ public:
             if (targetFPS_ > 0) {
                 config_.setTargetFPS(targetFPS_);
             }
+            if (generationsPerFrame_ > 0) {
+                config_.setGenerationsPerFrame(generationsPerFrame_);
+            }
+            if (frameStepBudgetMs_ > 0) {
+                config_.setFrameStepBudgetMs(frameStepBudgetMs_);
+            }
+            if (!checkpointFile_.empty()) {
+                config_.setCheckpointPath(checkpointFile_);
+            }
+            if (checkpointInterval_ > 0) {
+                config_.setCheckpointInterval(checkpointInterval_);
+            }
             
             // Re-create controller with new config
             controller_ = std::make_unique<SimulationController>(config_);
@@ -83,8 +130,17 @@ public:
             return false;
         }
         
-        // Load initial pattern if specified
-        if (!patternFile.empty()) {
+        // A checkpoint picks the run up where it left off
+        if (!resumeFile_.empty()) {
+            try {
+                controller_->loadSnapshot(resumeFile_);
+                std::cout << "Resumed generation " << controller_->getState().generation << " from: " << resumeFile_
+                          << std::endl;
+            } catch (const std::exception& e) {
+                std::cerr << "Could not resume: " << e.what() << std::endl;
+                return false;
+            }
+        } else if (!patternFile.empty()) {
             try {
                 controller_->loadPattern(patternFile);
                 std::cout << "Loaded pattern from: " << patternFile << std::endl;
@@ -93,6 +149,19 @@ public:
             }
         }
         
+        if (!metricsFile_.empty()) {
+            const bool prometheus = MetricsFileWriter::isPrometheusPath(metricsFile_);
+            metricsWriter_ = std::make_unique<MetricsFileWriter>(
+                metricsFile_, METRICS_INTERVAL, [this, prometheus](std::ostream& out) {
+                    const LabelledMetrics simulations[] = {{"console", &controller_->getMetrics()}};
+                    if (prometheus) {
+                        writePrometheusMetrics(out, simulations);
+                    } else {
+                        out << metricsToJson(simulations).dump(2) << "\n";
+                    }
+                });
+        }
+        
         // Initialize input if not in headless mode
         if (!headlessMode_) {
             input_.start();
@@ -102,7 +171,9 @@ public:
     }
     
     void run() {
-        if (headlessMode_) {
+        if (censusSoups_ > 0) {
+            runCensus();
+        } else if (headlessMode_) {
             runHeadless();
         } else {
             runInteractive();
@@ -153,6 +224,7 @@ private:
             // Render at controlled rate
             if (now - lastRenderTime >= renderInterval) {
                 renderer_.render(*controller_);
+                controller_->recordRenderTime(std::chrono::high_resolution_clock::now() - now);
                 lastRenderTime = now;
             }
             
@@ -203,6 +275,52 @@ private:
         std::cout << "  Final cell count: " << state.liveCellCount << std::endl;
         std::cout << "  Average FPS: " << state.actualFPS << std::endl;
         std::cout << "  Memory usage: " << (state.memoryUsage / 1024) << "KB" << std::endl;
+        if (state.entityLimitReached) {
+            std::cout << "  Stopped at the entity limit of " << config_.getMaxEntities() << " cells" << std::endl;
+        }
+    }
+    
+    // Seeded soups run to stability on every core, with their ash tallied by object
+    void runCensus() {
+        ObjectCatalog catalog(config_.getRule());
+        try {
+            catalog.loadPatternDirectory(PATTERN_DIRECTORY);
+        } catch (const std::exception& e) {
+            std::cout << "Could not load patterns, naming the built-in objects only: " << e.what() << std::endl;
+        }
+        
+        SoupCensusConfig census;
+        census.soups = censusSoups_;
+        census.seed = censusSeed_;
+        census.rule = config_.getRule();
+        const auto result = runSoupCensus(census, catalog);
+        
+        const double seconds = std::chrono::duration<double>(result.elapsed).count();
+        std::cout << "Census of " << result.soups << " " << census.soupSize << "x" << census.soupSize
+                  << " soups from seed " << censusSeed_ << " in " << seconds << " s ("
+                  << static_cast<double>(result.soups) / seconds << " soups/s, "
+                  << static_cast<double>(result.boardGenerations) / seconds << " board-gen/s)" << std::endl;
+        std::cout << result.settled << " settled, " << result.diedOut << " died out, " << result.unsettled
+                  << " still changing after " << census.generationLimit << " generations" << std::endl;
+        
+        uint64_t objects = 0;
+        for (const auto& object : result.objects) {
+            objects += object.count;
+        }
+        std::cout << objects << " objects of " << result.objects.size() << " kinds:" << std::endl;
+        for (size_t i = 0; i < std::min(result.objects.size(), CENSUS_ROWS); ++i) {
+            const auto& object = result.objects[i];
+            std::cout << std::setw(12) << object.count << "  ";
+            if (object.name.empty()) {
+                std::cout << "unnamed " << object.cells.size() << "-cell object " << std::hex
+                          << objectHash(object.cells) << std::dec << std::endl;
+            } else {
+                std::cout << object.name << std::endl;
+            }
+        }
+        if (result.objects.size() > CENSUS_ROWS) {
+            std::cout << "  ... and " << result.objects.size() - CENSUS_ROWS << " rarer kinds" << std::endl;
+        }
     }
     
     void handleInputEvent(InputEvent event) {
@@ -223,7 +341,11 @@ private:
                 break;
                 
             case InputEvent::STEP:
-                controller_->step();
+                controller_->requestStep();
+                break;
+                
+            case InputEvent::STEP_BACK:
+                controller_->stepBack();
                 break;
                 
             case InputEvent::RESET:
@@ -335,26 +457,56 @@ private:
     void showUsage(const char* programName) {
         std::cout << "Usage: " << programName << " [options]\n"
                   << "\nOptions:\n"
-                  << "  --config FILE    Load configuration from FILE\n"
-                  << "  --pattern FILE   Load initial pattern from FILE\n"
-                  << "  --headless       Run without interactive display\n"
-                  << "  --fps FPS        Set target simulation FPS\n"
-                  << "  --help, -h       Show this help message\n"
+                  << "  --config FILE         Load configuration from FILE\n"
+                  << "  --pattern FILE        Load initial pattern from FILE\n"
+                  << "  --headless            Run without interactive display\n"
+                  << "  --fps FPS             Set target simulation FPS\n"
+                  << "  --gens-per-frame N    Advance N generations per frame, in one multi-generation step\n"
+                  << "  --frame-budget MS     Keep stepping each frame while it fits in MS milliseconds\n"
+                  << "  --trace FILE          Write Chrome trace JSON to FILE on exit\n"
+                  << "  --metrics FILE        Keep Prometheus text (*.prom) or JSON metrics in FILE\n"
+                  << "  --census SOUPS        Run a soup census of SOUPS seeded soups and print the ash tally\n"
+                  << "  --seed SEED           First census soup seed (default 1)\n"
+                  << "  --checkpoint FILE     Checkpoint the board to FILE in the background, and on exit\n"
+                  << "  --checkpoint-every N  Checkpoint every N generations\n"
+                  << "  --resume FILE         Start from a checkpoint (snapshot file) instead of a pattern\n"
+                  << "  --help, -h            Show this help message\n"
                   << "\nExamples:\n"
                   << "  " << programName << " --pattern examples/patterns/glider.json\n"
                   << "  " << programName << " --headless --fps 60\n"
                   << "  " << programName << " --config config/performance_test.json\n"
+                  << "  " << programName << " --census 100000 --seed 7\n"
+                  << "  " << programName << " --headless --checkpoint run.gols --checkpoint-every 10000\n"
                   << std::endl;
     }
     
     void cleanup() {
         input_.stop();
         controller_->stop();
+        metricsWriter_.reset();  // Writes the final numbers
+        
+        if (!config_.getCheckpointPath().empty()) {
+            controller_->checkpoint(config_.getCheckpointPath());
+        }
+        controller_->waitForCheckpoints();
+        const auto checkpoints = controller_->getCheckpointStats();
+        if (checkpoints.failed > 0) {
+            std::cerr << checkpoints.failed << " checkpoints failed: " << checkpoints.lastError << std::endl;
+        }
         
         // Restore terminal state
         renderer_.clearScreen();
         std::cout << "\033[?25h"; // Show cursor
         std::cout.flush();
+        
+        if (!traceFile_.empty()) {
+            try {
+                Trace::writeChromeTrace(traceFile_);
+                std::cout << "Wrote trace to " << traceFile_ << std::endl;
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+            }
+        }
     }
     
     GameConfig config_;
@@ -365,6 +517,16 @@ private:
     bool shouldExit_ = false;
     bool headlessMode_ = false;
     uint32_t targetFPS_ = 0;
+    uint32_t generationsPerFrame_ = 0;
+    uint32_t frameStepBudgetMs_ = 0;
+    uint64_t censusSoups_ = 0;
+    uint32_t censusSeed_ = 1;
+    std::string traceFile_;
+    std::string metricsFile_;
+    std::unique_ptr<MetricsFileWriter> metricsWriter_;
+    std::string checkpointFile_;
+    uint32_t checkpointInterval_ = 0;
+    std::string resumeFile_;
 };
 
 int main(int argc, char* argv[]) {
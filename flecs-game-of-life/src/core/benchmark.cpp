@@ -0,0 +1,187 @@
+#include <flecs_gol/benchmark.h>
+#include <flecs_gol/life_engine.h>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+namespace flecs_gol {
+
+namespace {
+
+// Board the corpus patterns run on, and how long
+constexpr int32_t PATTERN_BOARD_SIZE = 256;
+constexpr uint32_t PATTERN_GENERATIONS = 200;
+
+constexpr uint32_t SOUP_SEED = 42;
+constexpr double SOUP_DENSITIES[] = {0.1, 0.25, 0.5};
+
+struct SoupBoard {
+    int32_t size;
+    uint32_t generations; // Fewer on larger boards, so each board costs about the same
+};
+constexpr SoupBoard SOUP_BOARDS[] = {{64, 400}, {256, 100}, {1024, 25}};
+
+std::vector<Position> readPatternCells(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open pattern file: " + path.string());
+    }
+    const auto json = nlohmann::json::parse(file);
+    std::vector<Position> cells;
+    for (const auto& cell : json.value("cells", nlohmann::json::array())) {
+        cells.emplace_back(cell["x"].get<int32_t>(), cell["y"].get<int32_t>());
+    }
+    return cells;
+}
+
+std::string currentTimestamp() {
+    const std::time_t now = std::time(nullptr);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return text;
+}
+
+} // namespace
+
+std::vector<Position> makeSoup(int32_t width, int32_t height, double density, uint32_t seed) {
+    std::mt19937 rng(seed);
+    const auto threshold = static_cast<uint64_t>(std::clamp(density, 0.0, 1.0) * 4294967296.0);
+    std::vector<Position> cells;
+    for (int32_t y = 0; y < height; ++y) {
+        for (int32_t x = 0; x < width; ++x) {
+            if (rng() < threshold) {
+                cells.emplace_back(x, y);
+            }
+        }
+    }
+    return cells;
+}
+
+std::vector<BenchmarkWorkload> makeStandardWorkloads(const std::string& patternDirectory, bool quick) {
+    std::vector<BenchmarkWorkload> workloads;
+
+    std::vector<std::filesystem::path> patterns;
+    for (const auto& entry : std::filesystem::directory_iterator(patternDirectory)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") {
+            patterns.push_back(entry.path());
+        }
+    }
+    std::sort(patterns.begin(), patterns.end());
+
+    for (const auto& path : patterns) {
+        auto cells = readPatternCells(path);
+        if (cells.empty()) {
+            continue;
+        }
+        // Centred on the board, as SimulationStore places initial patterns
+        const auto [minX, maxX] = std::minmax_element(cells.begin(), cells.end(),
+            [](const Position& a, const Position& b) { return a.x < b.x; });
+        const auto [minY, maxY] = std::minmax_element(cells.begin(), cells.end(),
+            [](const Position& a, const Position& b) { return a.y < b.y; });
+        const int32_t dx = (PATTERN_BOARD_SIZE - (maxX->x - minX->x + 1)) / 2 - minX->x;
+        const int32_t dy = (PATTERN_BOARD_SIZE - (maxY->y - minY->y + 1)) / 2 - minY->y;
+        for (auto& cell : cells) {
+            cell = Position(cell.x + dx, cell.y + dy);
+        }
+        workloads.push_back({"pattern-" + path.stem().string(), PATTERN_BOARD_SIZE, PATTERN_BOARD_SIZE,
+                             std::move(cells), PATTERN_GENERATIONS});
+    }
+
+    for (const auto& board : SOUP_BOARDS) {
+        if (quick && board.size > PATTERN_BOARD_SIZE) {
+            continue;
+        }
+        for (double density : SOUP_DENSITIES) {
+            workloads.push_back({"soup-" + std::to_string(board.size) + "-d" +
+                                     std::to_string(static_cast<int>(density * 100 + 0.5)),
+                                 board.size, board.size, makeSoup(board.size, board.size, density, SOUP_SEED),
+                                 board.generations});
+        }
+    }
+    return workloads;
+}
+
+BenchmarkResult runBenchmark(const GameConfig& baseConfig, EngineType engine, const BenchmarkWorkload& workload,
+                             uint32_t repetitions) {
+    GameConfig config = baseConfig;
+    config.setGridBoundaries(0, workload.width - 1, 0, workload.height - 1);
+    config.setWrapEdges(false);
+    config.setEngineType(engine);
+    config.setHashLifeStepLog2(0);
+    config.setAdaptiveEngine(false);
+
+    BenchmarkResult result;
+    result.engine = engineTypeToString(engine);
+    result.workload = workload.name;
+    result.generations = workload.generations;
+
+    std::vector<uint64_t> nanosPerStep;
+    for (uint32_t run = 0; run < std::max(repetitions, 1u); ++run) {
+        auto simulation = createLifeEngine(config);
+        simulation->createCells(workload.cells);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t generation = 0; generation < workload.generations; ++generation) {
+            simulation->step();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        nanosPerStep.push_back(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+            std::max<uint64_t>(workload.generations, 1));
+
+        result.finalCells = simulation->getCellCount();
+        result.memoryBytes = simulation->getMemoryUsage();
+    }
+
+    std::sort(nanosPerStep.begin(), nanosPerStep.end());
+    result.medianNanosPerStep = nanosPerStep[nanosPerStep.size() / 2];
+    result.minNanosPerStep = nanosPerStep.front();
+    return result;
+}
+
+nlohmann::json benchmarkResultsToJson(std::span<const BenchmarkResult> results, const std::string& validator) {
+    nlohmann::json json;
+    json["timestamp"] = currentTimestamp();
+    json["baseline_type"] = "benchmark";
+    json["validator"] = validator;
+    json["benchmarks"] = nlohmann::json::object();
+    for (const auto& result : results) {
+        json["benchmarks"][result.engine + "/" + result.workload] = {
+            {"engine", result.engine},
+            {"workload", result.workload},
+            {"generations", result.generations},
+            {"median_ns_per_step", result.medianNanosPerStep},
+            {"min_ns_per_step", result.minNanosPerStep},
+            {"final_cells", result.finalCells},
+            {"memory_bytes", result.memoryBytes},
+        };
+    }
+    return json;
+}
+
+std::vector<BenchmarkRegression> findRegressions(const nlohmann::json& baseline, const nlohmann::json& current,
+                                                 double tolerance) {
+    std::vector<BenchmarkRegression> regressions;
+    if (!baseline.contains("benchmarks") || !current.contains("benchmarks")) {
+        return regressions;
+    }
+    const auto& before = baseline["benchmarks"];
+    for (const auto& [key, now] : current["benchmarks"].items()) {
+        if (!before.contains(key)) {
+            continue;
+        }
+        const auto baselineNanos = before[key].value("median_ns_per_step", uint64_t{0});
+        const auto currentNanos = now.value("median_ns_per_step", uint64_t{0});
+        if (baselineNanos > 0 &&
+            static_cast<double>(currentNanos) > static_cast<double>(baselineNanos) * (1.0 + tolerance)) {
+            regressions.push_back({key, baselineNanos, currentNanos});
+        }
+    }
+    return regressions;
+}
+
+} // namespace flecs_gol
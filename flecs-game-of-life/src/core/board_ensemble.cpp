@@ -0,0 +1,258 @@
+#include <flecs_gol/board_ensemble.h>
+#include <flecs_gol/trace.h>
+#include <algorithm>
+#include <bit>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace flecs_gol {
+
+BoardEnsemble::BoardEnsemble(int32_t width, int32_t height, bool wrapEdges, const LifeRule& rule)
+    : width_(width)
+    , height_(height)
+    , wrapEdges_(wrapEdges)
+    , cellMask_(width >= 1 && width <= MAX_WIDTH ? ((uint64_t{1} << width) - 1) << 1 : 0)
+    , kernel_(selectDenseKernel())
+    , rule_(rule)
+    , conwayRule_(rule == CONWAY_RULE) {
+    if (width < 1 || width > MAX_WIDTH || height < 1) {
+        throw std::invalid_argument("Ensemble boards must be 1 to " + std::to_string(MAX_WIDTH) +
+                                    " cells wide and at least 1 tall");
+    }
+    const auto words = static_cast<size_t>(height_ + 2) * stride_;
+    current_.assign(words, 0);
+    previous_.assign(words, 0);
+    older_.assign(words, 0);
+}
+
+uint64_t BoardEnsemble::addBoard(std::span<const Position> cells) {
+    const size_t lane = addLane();
+    for (const auto& pos : cells) {
+        if (pos.x >= 0 && pos.x < width_ && pos.y >= 0 && pos.y < height_) {
+            word(current_, pos.y + 1, lane) |= uint64_t{1} << (pos.x + 1);
+        }
+    }
+    lanes_[lane].initialCells = countCells(lane);
+    return lanes_[lane].id;
+}
+
+uint64_t BoardEnsemble::addRandomBoard(double density, uint32_t seed) {
+    const size_t lane = addLane();
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution alive(density);
+    for (int32_t y = 0; y < height_; ++y) {
+        uint64_t bits = 0;
+        for (int32_t x = 0; x < width_; ++x) {
+            if (alive(rng)) {
+                bits |= uint64_t{1} << (x + 1);
+            }
+        }
+        word(current_, y + 1, lane) = bits;
+    }
+    lanes_[lane].initialCells = countCells(lane);
+    return lanes_[lane].id;
+}
+
+bool BoardEnsemble::retireBoard(uint64_t id) {
+    const size_t lane = findLane(id);
+    if (lane == NO_LANE) {
+        return false;
+    }
+    endLane(lane, BoardOutcome::Retired);
+    return true;
+}
+
+void BoardEnsemble::step(uint32_t generations) {
+    FLECS_GOL_TRACE_SCOPE("BoardEnsemble::step");
+    for (uint32_t i = 0; i < generations && !lanes_.empty(); ++i) {
+        stepGeneration();
+    }
+}
+
+void BoardEnsemble::collectResults(std::vector<BoardResult>& out) {
+    out.insert(out.end(), results_.begin(), results_.end());
+    results_.clear();
+}
+
+void BoardEnsemble::collectBoardCells(uint64_t id, std::vector<Position>& out) const {
+    const size_t lane = findLane(id);
+    if (lane != NO_LANE) {
+        appendLaneCells(lane, out);
+    }
+}
+
+void BoardEnsemble::appendLaneCells(size_t lane, std::vector<Position>& out) const {
+    for (int32_t y = 0; y < height_; ++y) {
+        uint64_t bits = word(current_, y + 1, lane) & cellMask_;
+        while (bits != 0) {
+            const auto bit = static_cast<int32_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+            out.emplace_back(bit - 1, y);
+        }
+    }
+}
+
+size_t BoardEnsemble::getMemoryUsage() const {
+    return (current_.capacity() + previous_.capacity() + older_.capacity() + alive_.capacity() +
+            changed_.capacity() + changedTwo_.capacity()) * sizeof(uint64_t) +
+           lanes_.capacity() * sizeof(Lane) + results_.capacity() * sizeof(BoardResult);
+}
+
+size_t BoardEnsemble::findLane(uint64_t id) const {
+    // Ids are handed out in order, but lanes are reordered as boards end
+    for (size_t lane = 0; lane < lanes_.size(); ++lane) {
+        if (lanes_[lane].id == id) {
+            return lane;
+        }
+    }
+    return NO_LANE;
+}
+
+size_t BoardEnsemble::addLane() {
+    reserveLanes(lanes_.size() + 1);
+    const size_t lane = lanes_.size();
+    lanes_.push_back(Lane{nextId_++, 0, 0});
+
+    // Earlier boards may have left their words in the lane
+    for (int32_t row = 0; row < height_ + 2; ++row) {
+        word(current_, row, lane) = 0;
+        word(previous_, row, lane) = 0;
+        word(older_, row, lane) = 0;
+    }
+    return lane;
+}
+
+void BoardEnsemble::reserveLanes(size_t lanes) {
+    const size_t capacity = stride_ - 2;
+    if (lanes <= capacity) {
+        return;
+    }
+
+    // Growing changes the row stride, so the running lanes are copied row by row
+    const size_t newStride = std::max(lanes, 2 * capacity) + 2;
+    const auto rows = static_cast<size_t>(height_ + 2);
+    auto regrow = [&](std::vector<uint64_t>& buffer) {
+        std::vector<uint64_t> grown(rows * newStride, 0);
+        for (size_t row = 0; row < rows; ++row) {
+            std::copy_n(buffer.begin() + static_cast<std::ptrdiff_t>(row * stride_ + 1), lanes_.size(),
+                        grown.begin() + static_cast<std::ptrdiff_t>(row * newStride + 1));
+        }
+        buffer.swap(grown);
+    };
+    regrow(current_);
+    regrow(previous_);
+    regrow(older_);
+    stride_ = newStride;
+
+    alive_.resize(newStride - 2);
+    changed_.resize(newStride - 2);
+    changedTwo_.resize(newStride - 2);
+}
+
+void BoardEnsemble::stepGeneration() {
+    const size_t running = lanes_.size();
+    fillGhosts(current_);
+
+    // One kernel call steps a row of every running board; the guard words
+    // and the unused lanes past them only reach ghost bits
+    for (int32_t row = 1; row <= height_; ++row) {
+        const uint64_t* above = &word(current_, row - 1, 0);
+        const uint64_t* cells = &word(current_, row, 0);
+        const uint64_t* below = &word(current_, row + 1, 0);
+        uint64_t* out = &word(older_, row, 0);
+        if (conwayRule_) {
+            kernel_.stepRow(above, cells, below, out, running);
+        } else {
+            kernel_.stepRowRule(above, cells, below, out, running, rule_);
+        }
+    }
+
+    // Clear the ghost bits and gather the per-board flags, a row of lanes at a time
+    std::fill_n(alive_.begin(), running, uint64_t{0});
+    std::fill_n(changed_.begin(), running, uint64_t{0});
+    std::fill_n(changedTwo_.begin(), running, uint64_t{0});
+    for (int32_t row = 1; row <= height_; ++row) {
+        uint64_t* out = &word(older_, row, 0);
+        const uint64_t* last = &word(current_, row, 0);
+        const uint64_t* beforeLast = &word(previous_, row, 0);
+        for (size_t lane = 0; lane < running; ++lane) {
+            const uint64_t bits = out[lane] & cellMask_;
+            out[lane] = bits;
+            alive_[lane] |= bits;
+            changed_[lane] |= (bits ^ last[lane]) & cellMask_;
+            changedTwo_[lane] |= (bits ^ beforeLast[lane]) & cellMask_;
+        }
+    }
+
+    // The new generation took the oldest buffer's place
+    std::swap(older_, previous_);
+    std::swap(previous_, current_);
+
+    // From the last lane down, so a lane moved into an ended one has been checked
+    for (size_t lane = running; lane-- > 0;) {
+        const uint32_t generation = ++lanes_[lane].generation;
+        if (alive_[lane] == 0) {
+            endLane(lane, BoardOutcome::DiedOut);
+        } else if (changed_[lane] == 0) {
+            endLane(lane, BoardOutcome::StillLife);
+        } else if (generation >= 2 && changedTwo_[lane] == 0) {
+            endLane(lane, BoardOutcome::Oscillator);
+        } else if (generationLimit_ != 0 && generation >= generationLimit_) {
+            endLane(lane, BoardOutcome::GenerationLimit);
+        }
+    }
+}
+
+void BoardEnsemble::fillGhosts(std::vector<uint64_t>& buffer) {
+    if (!wrapEdges_) {
+        return; // Bounded boards keep their ghost bits and rows zero
+    }
+
+    // Column width - 1 (bit width) wraps to ghost bit 0, column 0 (bit 1) to bit width + 1
+    const size_t running = lanes_.size();
+    for (int32_t row = 1; row <= height_; ++row) {
+        uint64_t* cells = &word(buffer, row, 0);
+        for (size_t lane = 0; lane < running; ++lane) {
+            const uint64_t bits = cells[lane] & cellMask_;
+            cells[lane] = bits | ((bits >> width_) & 1u) | ((bits & 2u) << width_);
+        }
+    }
+    std::copy_n(&word(buffer, height_, 0), running, &word(buffer, 0, 0));
+    std::copy_n(&word(buffer, 1, 0), running, &word(buffer, height_ + 1, 0));
+}
+
+size_t BoardEnsemble::countCells(size_t lane) const {
+    size_t count = 0;
+    for (int32_t row = 1; row <= height_; ++row) {
+        count += static_cast<size_t>(std::popcount(word(current_, row, lane) & cellMask_));
+    }
+    return count;
+}
+
+void BoardEnsemble::endLane(size_t lane, BoardOutcome outcome) {
+    const Lane& ended = lanes_[lane];
+    BoardResult& result = results_.emplace_back();
+    result.id = ended.id;
+    result.outcome = outcome;
+    result.generations = ended.generation;
+    result.initialCells = ended.initialCells;
+    result.finalCells = countCells(lane);
+    if (recordFinalCells_) {
+        appendLaneCells(lane, result.cells);
+    }
+
+    // The last running board moves into the freed lane
+    const size_t last = lanes_.size() - 1;
+    if (lane != last) {
+        for (int32_t row = 0; row < height_ + 2; ++row) {
+            word(current_, row, lane) = word(current_, row, last);
+            word(previous_, row, lane) = word(previous_, row, last);
+            word(older_, row, lane) = word(older_, row, last);
+        }
+        lanes_[lane] = lanes_[last];
+    }
+    lanes_.pop_back();
+}
+
+} // namespace flecs_gol
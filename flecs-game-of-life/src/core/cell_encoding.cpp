@@ -0,0 +1,142 @@
+#include <flecs_gol/cell_encoding.h>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace flecs_gol {
+
+namespace {
+
+constexpr int32_t TILE_SHIFT = 3;
+constexpr int32_t TILE_MASK = (1 << TILE_SHIFT) - 1;
+
+// Tile rows and columns of the 32-bit plane
+constexpr int64_t MIN_TILE = std::numeric_limits<int32_t>::min() >> TILE_SHIFT;
+constexpr int64_t MAX_TILE = std::numeric_limits<int32_t>::max() >> TILE_SHIFT;
+
+uint64_t zigZag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unZigZag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(static_cast<uint8_t>(value | 0x80)));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(static_cast<uint8_t>(value)));
+}
+
+uint64_t getVarint(const uint8_t*& in, const uint8_t* end) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (in == end) {
+            throw std::runtime_error("Packed cells are truncated");
+        }
+        uint8_t byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Packed cells hold an oversized number");
+}
+
+int64_t checkedTile(int64_t previous, uint64_t encodedDelta) {
+    // previous is a valid tile, so the sum cannot overflow once the delta is in range
+    const int64_t delta = unZigZag(encodedDelta);
+    if (delta < MIN_TILE - MAX_TILE || delta > MAX_TILE - MIN_TILE || previous + delta < MIN_TILE ||
+        previous + delta > MAX_TILE) {
+        throw std::runtime_error("Packed cell lies outside the 32-bit plane");
+    }
+    return previous + delta;
+}
+
+} // namespace
+
+void encodeCellFlips(std::span<const Position> born, std::span<const Position> died, std::string& out) {
+    std::vector<Position> flips;
+    flips.reserve(born.size() + died.size());
+    flips.insert(flips.end(), born.begin(), born.end());
+    flips.insert(flips.end(), died.begin(), died.end());
+    std::sort(flips.begin(), flips.end(), [](const Position& a, const Position& b) {
+        const int32_t rowA = a.y >> TILE_SHIFT;
+        const int32_t rowB = b.y >> TILE_SHIFT;
+        return rowA != rowB ? rowA < rowB : (a.x >> TILE_SHIFT) < (b.x >> TILE_SHIFT);
+    });
+
+    int64_t previousRow = 0;
+    int64_t previousColumn = 0;
+    for (size_t i = 0; i < flips.size();) {
+        const int32_t row = flips[i].y >> TILE_SHIFT;
+        const int32_t column = flips[i].x >> TILE_SHIFT;
+
+        uint8_t rows[TILE_MASK + 1] = {};
+        for (; i < flips.size() && (flips[i].y >> TILE_SHIFT) == row && (flips[i].x >> TILE_SHIFT) == column; ++i) {
+            rows[flips[i].y & TILE_MASK] ^= static_cast<uint8_t>(1u << (flips[i].x & TILE_MASK));
+        }
+
+        uint8_t rowMask = 0;
+        for (int32_t r = 0; r <= TILE_MASK; ++r) {
+            if (rows[r] != 0) {
+                rowMask |= static_cast<uint8_t>(1u << r);
+            }
+        }
+        if (rowMask == 0) {
+            continue; // Every flip in the tile cancelled out
+        }
+
+        putVarint(out, zigZag(row - previousRow));
+        putVarint(out, zigZag(column - previousColumn));
+        previousRow = row;
+        previousColumn = column;
+        out.push_back(static_cast<char>(rowMask));
+        for (int32_t r = 0; r <= TILE_MASK; ++r) {
+            if (rows[r] != 0) {
+                out.push_back(static_cast<char>(rows[r]));
+            }
+        }
+    }
+}
+
+std::vector<Position> decodeCellFlips(std::string_view data) {
+    const auto* in = reinterpret_cast<const uint8_t*>(data.data());
+    const auto* end = in + data.size();
+
+    std::vector<Position> flips;
+    int64_t row = 0;
+    int64_t column = 0;
+    while (in != end) {
+        row = checkedTile(row, getVarint(in, end));
+        column = checkedTile(column, getVarint(in, end));
+        if (in == end) {
+            throw std::runtime_error("Packed cells are truncated");
+        }
+        const uint8_t rowMask = *in++;
+        if (rowMask == 0) {
+            throw std::runtime_error("Packed cells hold an empty tile");
+        }
+
+        for (int32_t r = 0; r <= TILE_MASK; ++r) {
+            if ((rowMask & (1u << r)) == 0) {
+                continue;
+            }
+            if (in == end) {
+                throw std::runtime_error("Packed cells are truncated");
+            }
+            const uint8_t columns = *in++;
+            for (int32_t c = 0; c <= TILE_MASK; ++c) {
+                if ((columns & (1u << c)) != 0) {
+                    flips.emplace_back(static_cast<int32_t>(column * (TILE_MASK + 1) + c),
+                                       static_cast<int32_t>(row * (TILE_MASK + 1) + r));
+                }
+            }
+        }
+    }
+    return flips;
+}
+
+} // namespace flecs_gol
@@ -0,0 +1,90 @@
+#include <flecs_gol/checkpoint_writer.h>
+#include <flecs_gol/trace.h>
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace flecs_gol {
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        wake_.notify_all();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void CheckpointWriter::submit(const std::string& path, const SnapshotInfo& info, CellSource cells) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto pending = std::find_if(queue_.begin(), queue_.end(), [&path](const Job& job) { return job.path == path; });
+    if (pending != queue_.end()) {
+        queue_.erase(pending);
+        stats_.superseded++;
+    }
+    queue_.push_back(Job{path, info, std::move(cells)});
+
+    if (!thread_.joinable()) {
+        thread_ = std::thread(&CheckpointWriter::writerLoop, this);
+    }
+    wake_.notify_all();
+}
+
+void CheckpointWriter::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return queue_.empty() && !writing_; });
+}
+
+CheckpointStats CheckpointWriter::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void CheckpointWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::vector<Position> cells;
+
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;  // Stopping, with everything written
+        }
+
+        Job job = std::move(queue_.front());
+        queue_.pop_front();
+        writing_ = true;
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        std::string error;
+        try {
+            FLECS_GOL_TRACE_SCOPE("CheckpointWriter::write");
+            cells.clear();
+            job.cells(cells);
+            job.cells = nullptr;  // Lets go of the frozen board before the disk wait
+            writeSnapshotFileSynced(job.path, job.info, cells);
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        lock.lock();
+        writing_ = false;
+        if (error.empty()) {
+            stats_.written++;
+            stats_.lastGeneration = job.info.generation;
+            stats_.lastWriteTime = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+        } else {
+            stats_.failed++;
+            stats_.lastError = std::move(error);
+        }
+        if (queue_.empty()) {
+            idle_.notify_all();
+        }
+    }
+}
+
+} // namespace flecs_gol
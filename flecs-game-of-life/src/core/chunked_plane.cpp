@@ -0,0 +1,300 @@
+#include <flecs_gol/chunked_plane.h>
+#include <flecs_gol/trace.h>
+#include <algorithm>
+#include <bit>
+
+namespace flecs_gol {
+
+ChunkedPlane::ChunkedPlane(const LifeRule& rule)
+    : kernel_(selectDenseKernel())
+    , rule_(rule)
+    , conwayRule_(rule == CONWAY_RULE) {
+}
+
+bool ChunkedPlane::setCell(int32_t x, int32_t y, bool alive) {
+    const Position coord = chunkOf(x, y);
+    uint32_t slot;
+    auto it = index_.find(coord);
+    if (it != index_.end()) {
+        slot = it->second;
+    } else if (alive) {
+        slot = static_cast<uint32_t>(chunks_.size());
+        index_[coord] = slot;
+        chunks_.push_back(Chunk{coord, Rows{}});
+    } else {
+        return true;
+    }
+
+    uint64_t& word = chunks_[slot].rows[static_cast<size_t>(y & 63)];
+    const uint64_t mask = uint64_t{1} << (x & 63);
+    const bool wasAlive = (word & mask) != 0;
+
+    // A chunk left empty here is dropped by the next step
+    if (alive != wasAlive) {
+        word ^= mask;
+        population_ = alive ? population_ + 1 : population_ - 1;
+        markChanged(coord);
+    }
+    return true;
+}
+
+bool ChunkedPlane::isCellAlive(int32_t x, int32_t y) const {
+    const Rows* rows = findRows(chunks_, index_, chunkOf(x, y));
+    return rows != nullptr && (((*rows)[static_cast<size_t>(y & 63)] >> (x & 63)) & 1u) != 0;
+}
+
+uint8_t ChunkedPlane::getNeighborCount(int32_t x, int32_t y) const {
+    uint8_t count = 0;
+
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            const int64_t neighborX = x + dx;
+            const int64_t neighborY = y + dy;
+            if ((dx == 0 && dy == 0) || neighborX < std::numeric_limits<int32_t>::min() ||
+                neighborX > std::numeric_limits<int32_t>::max() || neighborY < std::numeric_limits<int32_t>::min() ||
+                neighborY > std::numeric_limits<int32_t>::max()) {
+                continue;
+            }
+            if (isCellAlive(static_cast<int32_t>(neighborX), static_cast<int32_t>(neighborY))) {
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+void ChunkedPlane::step() {
+    FLECS_GOL_TRACE_SCOPE("ChunkedPlane::step");
+    candidates_.clear();
+    for (const auto& chunk : chunks_) {
+        addCandidates(chunk);
+    }
+    std::sort(candidates_.begin(), candidates_.end());
+    candidates_.erase(std::unique(candidates_.begin(), candidates_.end()), candidates_.end());
+
+    // The spare generation is overwritten; once the plane has shrunk to a
+    // quarter of what it held, let its buffers go rather than keep the peak
+    if (previous_.capacity() > 4 * candidates_.size()) {
+        previous_ = std::vector<Chunk>{};
+        previousIndex_ = CoordinateMap<uint32_t>{};
+    }
+    previous_.clear();
+    previousIndex_.clear();
+
+    anyChanged_ = false;
+    uint32_t population = 0;
+    for (const Position& coord : candidates_) {
+        if (stepChunk(coord, population)) {
+            markChanged(coord);
+        }
+    }
+
+    chunks_.swap(previous_);
+    std::swap(index_, previousIndex_);
+    population_ = population;
+}
+
+void ChunkedPlane::clear() {
+    chunks_.clear();
+    index_.clear();
+    previous_.clear();
+    previousIndex_.clear();
+    population_ = 0;
+    anyChanged_ = false;
+}
+
+size_t ChunkedPlane::getMemoryUsage() const {
+    return (chunks_.capacity() + previous_.capacity()) * sizeof(Chunk) + index_.getMemoryUsage() +
+           previousIndex_.getMemoryUsage() + candidates_.capacity() * sizeof(Position) + sizeof(*this);
+}
+
+bool ChunkedPlane::getActiveBounds(int32_t& minX, int32_t& maxX, int32_t& minY, int32_t& maxY) const {
+    if (!anyChanged_) {
+        return false;
+    }
+
+    // Chunk bounds; chunk coordinates keep every cell inside the 32-bit plane
+    minX = changedMin_.x * CHUNK_SIZE;
+    maxX = changedMax_.x * CHUNK_SIZE + (CHUNK_SIZE - 1);
+    minY = changedMin_.y * CHUNK_SIZE;
+    maxY = changedMax_.y * CHUNK_SIZE + (CHUNK_SIZE - 1);
+    return true;
+}
+
+void ChunkedPlane::collectChanges(std::vector<Position>& born, std::vector<Position>& died) const {
+    static const Rows EMPTY{};
+    auto compare = [&](Position coord, const Rows& current, const Rows& previous) {
+        for (int32_t r = 0; r < CHUNK_SIZE; ++r) {
+            const uint64_t now = current[static_cast<size_t>(r)];
+            uint64_t bits = now ^ previous[static_cast<size_t>(r)];
+            while (bits != 0) {
+                auto bit = static_cast<int32_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                auto& out = ((now >> bit) & 1u) != 0 ? born : died;
+                out.emplace_back(coord.x * CHUNK_SIZE + bit, coord.y * CHUNK_SIZE + r);
+            }
+        }
+    };
+
+    // Chunks the previous generation lacks were all dead, and every cell of
+    // a chunk freed by the step died
+    for (const auto& chunk : chunks_) {
+        const Rows* previous = findRows(previous_, previousIndex_, chunk.coord);
+        compare(chunk.coord, chunk.rows, previous != nullptr ? *previous : EMPTY);
+    }
+    for (const auto& chunk : previous_) {
+        if (!index_.contains(chunk.coord)) {
+            compare(chunk.coord, EMPTY, chunk.rows);
+        }
+    }
+}
+
+void ChunkedPlane::collectLiveCells(std::vector<Position>& out) const {
+    for (const auto& chunk : chunks_) {
+        for (int32_t r = 0; r < CHUNK_SIZE; ++r) {
+            uint64_t bits = chunk.rows[static_cast<size_t>(r)];
+            while (bits != 0) {
+                auto bit = static_cast<int32_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                out.emplace_back(chunk.coord.x * CHUNK_SIZE + bit, chunk.coord.y * CHUNK_SIZE + r);
+            }
+        }
+    }
+}
+
+void ChunkedPlane::collectCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                                        std::vector<Position>& out) const {
+    if (minX > maxX || minY > maxY) {
+        return;
+    }
+    const Position low = chunkOf(minX, minY);
+    const Position high = chunkOf(maxX, maxY);
+
+    for (const auto& chunk : chunks_) {
+        if (chunk.coord.x < low.x || chunk.coord.x > high.x || chunk.coord.y < low.y || chunk.coord.y > high.y) {
+            continue;
+        }
+
+        // Bits of the chunk's columns inside [minX, maxX]
+        uint64_t columns = ~uint64_t{0};
+        if (chunk.coord.x == low.x) {
+            columns &= ~uint64_t{0} << (minX & 63);
+        }
+        if (chunk.coord.x == high.x) {
+            columns &= ~uint64_t{0} >> (63 - (maxX & 63));
+        }
+
+        const int32_t firstRow = chunk.coord.y == low.y ? (minY & 63) : 0;
+        const int32_t lastRow = chunk.coord.y == high.y ? (maxY & 63) : CHUNK_SIZE - 1;
+        for (int32_t r = firstRow; r <= lastRow; ++r) {
+            uint64_t bits = chunk.rows[static_cast<size_t>(r)] & columns;
+            while (bits != 0) {
+                auto bit = static_cast<int32_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                out.emplace_back(chunk.coord.x * CHUNK_SIZE + bit, chunk.coord.y * CHUNK_SIZE + r);
+            }
+        }
+    }
+}
+
+const ChunkedPlane::Rows* ChunkedPlane::findRows(const std::vector<Chunk>& chunks, const CoordinateMap<uint32_t>& index,
+                                                 Position coord) {
+    auto it = index.find(coord);
+    return it != index.end() ? &chunks[it->second].rows : nullptr;
+}
+
+void ChunkedPlane::addCandidates(const Chunk& chunk) {
+    uint64_t any = 0;
+    for (uint64_t row : chunk.rows) {
+        any |= row;
+    }
+    if (any == 0) {
+        return; // Emptied by setCell(); nothing can be born around it
+    }
+    candidates_.push_back(chunk.coord);
+
+    // Neighbor chunks a border cell of this one touches: the top row reaches
+    // the chunk above, bit 0 of any row the chunk to the left, and so on
+    const uint64_t top = chunk.rows.front();
+    const uint64_t bottom = chunk.rows.back();
+    const bool reaches[3][3] = {
+        {(top & 1u) != 0, top != 0, (top >> 63) != 0},
+        {(any & 1u) != 0, false, (any >> 63) != 0},
+        {(bottom & 1u) != 0, bottom != 0, (bottom >> 63) != 0},
+    };
+    for (int32_t dy = -1; dy <= 1; ++dy) {
+        for (int32_t dx = -1; dx <= 1; ++dx) {
+            const int64_t x = int64_t{chunk.coord.x} + dx;
+            const int64_t y = int64_t{chunk.coord.y} + dy;
+            // Past the 32-bit coordinate range cells are always dead
+            if (!reaches[dy + 1][dx + 1] || x < MIN_CHUNK || x > MAX_CHUNK || y < MIN_CHUNK || y > MAX_CHUNK) {
+                continue;
+            }
+            candidates_.emplace_back(static_cast<int32_t>(x), static_cast<int32_t>(y));
+        }
+    }
+}
+
+bool ChunkedPlane::stepChunk(Position coord, uint32_t& population) {
+    // The up to nine chunks the halo reads, row-major around this one; missing ones are dead
+    const Rows* around[3][3];
+    for (int32_t dy = -1; dy <= 1; ++dy) {
+        for (int32_t dx = -1; dx <= 1; ++dx) {
+            const int64_t x = int64_t{coord.x} + dx;
+            const int64_t y = int64_t{coord.y} + dy;
+            around[dy + 1][dx + 1] = x < MIN_CHUNK || x > MAX_CHUNK || y < MIN_CHUNK || y > MAX_CHUNK
+                                         ? nullptr
+                                         : findRows(chunks_, index_,
+                                                    Position(static_cast<int32_t>(x), static_cast<int32_t>(y)));
+        }
+    }
+
+    // Halo exchange as in TiledGrid: this chunk's rows plus one row above and
+    // below, each with the bordering words of the chunks to either side
+    uint64_t halo[CHUNK_SIZE + 2][3];
+    for (int32_t r = -1; r <= CHUNK_SIZE; ++r) {
+        const int32_t band = r < 0 ? 0 : (r < CHUNK_SIZE ? 1 : 2);
+        const auto row = static_cast<size_t>((r + CHUNK_SIZE) % CHUNK_SIZE);
+        for (int32_t column = 0; column < 3; ++column) {
+            const Rows* rows = around[band][column];
+            halo[r + 1][column] = rows != nullptr ? (*rows)[row] : 0;
+        }
+    }
+
+    Rows out;
+    uint64_t any = 0;
+    for (int32_t r = 0; r < CHUNK_SIZE; ++r) {
+        uint64_t& word = out[static_cast<size_t>(r)];
+        if (conwayRule_) {
+            kernel_.stepRow(&halo[r][1], &halo[r + 1][1], &halo[r + 2][1], &word, 1);
+        } else {
+            kernel_.stepRowRule(&halo[r][1], &halo[r + 1][1], &halo[r + 2][1], &word, 1, rule_);
+        }
+        any |= word;
+    }
+
+    const Rows* current = around[1][1];
+    const bool changed = current != nullptr ? out != *current : any != 0;
+    if (any != 0) {
+        previousIndex_[coord] = static_cast<uint32_t>(previous_.size());
+        previous_.push_back(Chunk{coord, out});
+        for (uint64_t word : out) {
+            population += static_cast<uint32_t>(std::popcount(word));
+        }
+    }
+    return changed;
+}
+
+void ChunkedPlane::markChanged(Position coord) {
+    if (!anyChanged_) {
+        changedMin_ = coord;
+        changedMax_ = coord;
+        anyChanged_ = true;
+        return;
+    }
+    changedMin_ = Position(std::min(changedMin_.x, coord.x), std::min(changedMin_.y, coord.y));
+    changedMax_ = Position(std::max(changedMax_.x, coord.x), std::max(changedMax_.y, coord.y));
+}
+
+} // namespace flecs_gol
@@ -0,0 +1,137 @@
+#include <flecs_gol/cycle_detector.h>
+#include <array>
+
+namespace flecs_gol {
+
+namespace {
+
+// Odd, so both bases are invertible mod 2^64
+constexpr uint64_t BASE_X = 0x9E3779B97F4A7C15ull;
+constexpr uint64_t BASE_Y = 0xC2B2AE3D27D4EB4Full;
+
+// Mixed into the shape hash so sets of different sizes rarely share a slot
+constexpr uint64_t COUNT_MIX = 0x2545F4914F6CDD1Dull;
+
+constexpr uint64_t inverse(uint64_t odd) {
+    // Newton iteration; every round doubles the number of correct low bits
+    uint64_t x = odd;
+    for (int i = 0; i < 6; ++i) {
+        x *= 2 - odd * x;
+    }
+    return x;
+}
+
+// base^(2^k) and base^-(2^k), for exponents of up to 32 bits of magnitude
+struct PowerTable {
+    std::array<uint64_t, 32> up{};
+    std::array<uint64_t, 32> down{};
+
+    constexpr explicit PowerTable(uint64_t base) {
+        uint64_t forward = base;
+        uint64_t backward = inverse(base);
+        for (size_t k = 0; k < up.size(); ++k) {
+            up[k] = forward;
+            down[k] = backward;
+            forward *= forward;
+            backward *= backward;
+        }
+    }
+
+    constexpr uint64_t power(int64_t exponent) const {
+        const auto& table = exponent < 0 ? down : up;
+        auto magnitude = static_cast<uint64_t>(exponent < 0 ? -exponent : exponent);
+        uint64_t result = 1;
+        for (size_t k = 0; magnitude != 0 && k < table.size(); ++k, magnitude >>= 1) {
+            if (magnitude & 1u) {
+                result *= table[k];
+            }
+        }
+        return result;
+    }
+};
+
+constexpr PowerTable POWERS_X(BASE_X);
+constexpr PowerTable POWERS_Y(BASE_Y);
+
+static_assert(BASE_X * inverse(BASE_X) == 1, "inverse() must give the multiplicative inverse");
+
+int64_t floorDiv(int64_t value, uint64_t divisor) {
+    auto d = static_cast<int64_t>(divisor);
+    int64_t quotient = value / d;
+    return (value % d != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+} // namespace
+
+CycleDetector::CycleDetector(uint32_t maxPeriod)
+    : maxPeriod_(maxPeriod) {
+}
+
+uint64_t CycleDetector::cellHash(const Position& pos) {
+    return POWERS_X.power(pos.x) * POWERS_Y.power(pos.y);
+}
+
+void CycleDetector::add(const Position& pos) {
+    hash_ += cellHash(pos);
+    sumX_ += pos.x;
+    sumY_ += pos.y;
+    count_++;
+}
+
+void CycleDetector::remove(const Position& pos) {
+    hash_ -= cellHash(pos);
+    sumX_ -= pos.x;
+    sumY_ -= pos.y;
+    count_--;
+}
+
+void CycleDetector::clear() {
+    hash_ = 0;
+    sumX_ = 0;
+    sumY_ = 0;
+    count_ = 0;
+    seen_.clear();
+    history_.clear();
+}
+
+std::optional<CycleDetector::Cycle> CycleDetector::record(uint32_t generation) {
+    // Normalize to the floored centroid so translated copies hash alike
+    int64_t centroidX = 0;
+    int64_t centroidY = 0;
+    uint64_t shape = 0;
+    if (count_ > 0) {
+        centroidX = floorDiv(sumX_, count_);
+        centroidY = floorDiv(sumY_, count_);
+        shape = hash_ * POWERS_X.power(-centroidX) * POWERS_Y.power(-centroidY);
+    }
+    shape ^= count_ * COUNT_MIX;
+
+    // Drop sightings too old to form a cycle of at most maxPeriod_
+    while (!history_.empty() && generation - history_.front().second > maxPeriod_) {
+        auto it = seen_.find(history_.front().first);
+        if (it != seen_.end() && it->second.generation == history_.front().second) {
+            seen_.erase(it);
+        }
+        history_.pop_front();
+    }
+
+    std::optional<Cycle> cycle;
+    auto it = seen_.find(shape);
+    if (it != seen_.end() && it->second.count == count_ && it->second.generation < generation) {
+        const Seen& earlier = it->second;
+        cycle = Cycle{generation - earlier.generation, static_cast<int32_t>(centroidX - earlier.centroidX),
+                      static_cast<int32_t>(centroidY - earlier.centroidY), earlier.generation};
+    }
+
+    seen_[shape] = Seen{generation, centroidX, centroidY, count_};
+    history_.emplace_back(shape, generation);
+    return cycle;
+}
+
+size_t CycleDetector::getMemoryUsage() const {
+    return seen_.size() * (sizeof(std::pair<const uint64_t, Seen>) + sizeof(void*)) +
+           seen_.bucket_count() * sizeof(void*) + history_.size() * sizeof(std::pair<uint64_t, uint32_t>) +
+           sizeof(*this);
+}
+
+} // namespace flecs_gol
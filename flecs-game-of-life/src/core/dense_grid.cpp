@@ -0,0 +1,248 @@
+#include <flecs_gol/dense_grid.h>
+#include <flecs_gol/topology.h>
+#include <flecs_gol/trace.h>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace flecs_gol {
+
+DenseGrid::DenseGrid(const GameConfig& config)
+    : originX_(config.getGridMinX())
+    , originY_(config.getGridMinY())
+    , width_(static_cast<uint32_t>(config.getGridWidth()))
+    , height_(static_cast<uint32_t>(config.getGridHeight()))
+    , wordsPerRow_((static_cast<size_t>(width_) + 63) / 64)
+    , stride_(wordsPerRow_ + 2)
+    , lastWordMask_((width_ & 63) != 0 ? ~uint64_t{0} >> (64 - (width_ & 63)) : ~uint64_t{0})
+    , wrapEdges_(config.getWrapEdges())
+    , kernel_(selectDenseKernel())
+    , rule_(config.getRule())
+    , conwayRule_(rule_ == CONWAY_RULE) {
+
+    // Guard rows above and below the grid
+    cells_.assign(stride_ * (static_cast<size_t>(height_) + 2), 0);
+    next_.assign(stride_ * (static_cast<size_t>(height_) + 2), 0);
+}
+
+bool DenseGrid::setCell(int32_t x, int32_t y, bool alive) {
+    if (x < originX_ || y < originY_) {
+        return false;
+    }
+
+    auto col = static_cast<uint32_t>(x - originX_);
+    auto row = static_cast<uint32_t>(y - originY_);
+    if (col >= width_ || row >= height_) {
+        return false;
+    }
+
+    uint64_t& word = rowPtr(cells_, row)[col >> 6];
+    uint64_t mask = uint64_t{1} << (col & 63);
+    bool wasAlive = (word & mask) != 0;
+
+    if (alive && !wasAlive) {
+        word |= mask;
+        population_++;
+    } else if (!alive && wasAlive) {
+        word &= ~mask;
+        population_--;
+    }
+
+    return true;
+}
+
+bool DenseGrid::isCellAlive(int32_t x, int32_t y) const {
+    if (x < originX_ || y < originY_) {
+        return false;
+    }
+
+    auto col = static_cast<uint32_t>(x - originX_);
+    auto row = static_cast<uint32_t>(y - originY_);
+    return col < width_ && row < height_ && getBit(col, row);
+}
+
+uint8_t DenseGrid::getNeighborCount(int32_t x, int32_t y) const {
+    return countNeighbors(static_cast<int64_t>(x) - originX_, static_cast<int64_t>(y) - originY_);
+}
+
+uint8_t DenseGrid::countNeighbors(int64_t centerCol, int64_t centerRow) const {
+    uint8_t count = 0;
+
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) {
+                continue;
+            }
+
+            int64_t col = centerCol + dx;
+            int64_t row = centerRow + dy;
+
+            if (wrapEdges_) {
+                col = ((col % width_) + width_) % width_;
+                row = ((row % height_) + height_) % height_;
+            } else if (col < 0 || row < 0 || col >= width_ || row >= height_) {
+                continue;
+            }
+
+            if (getBit(static_cast<uint32_t>(col), static_cast<uint32_t>(row))) {
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+void DenseGrid::step() {
+    FLECS_GOL_TRACE_SCOPE("DenseGrid::step");
+    const size_t rowBytes = wordsPerRow_ * sizeof(uint64_t);
+
+    // Guard rows hold the wrapped neighbor rows, or stay zero for bounded grids
+    if (wrapEdges_) {
+        std::memcpy(rowPtr(cells_, -1), rowPtr(cells_, height_ - 1), rowBytes);
+        std::memcpy(rowPtr(cells_, height_), rowPtr(cells_, 0), rowBytes);
+    }
+
+    for (uint32_t row = 0; row < height_; ++row) {
+        uint64_t* out = rowPtr(next_, row);
+        if (conwayRule_) {
+            kernel_.stepRow(rowPtr(cells_, row - int64_t{1}), rowPtr(cells_, row), rowPtr(cells_, row + int64_t{1}),
+                            out, wordsPerRow_);
+        } else {
+            kernel_.stepRowRule(rowPtr(cells_, row - int64_t{1}), rowPtr(cells_, row),
+                                rowPtr(cells_, row + int64_t{1}), out, wordsPerRow_, rule_);
+        }
+
+        // Births just past the right edge would otherwise leak into the padding bits
+        out[wordsPerRow_ - 1] &= lastWordMask_;
+    }
+
+    // The kernel sees zeros beyond the first and last column; redo those with wrapping
+    if (wrapEdges_) {
+        patchWrappedColumn(0);
+        if (width_ > 1) {
+            patchWrappedColumn(width_ - 1);
+        }
+    }
+
+    cells_.swap(next_);
+    recountPopulation();
+}
+
+void DenseGrid::patchWrappedColumn(uint32_t col) {
+    const TorusTopology torus{0, static_cast<int32_t>(width_) - 1, 0, static_cast<int32_t>(height_) - 1};
+    uint64_t mask = uint64_t{1} << (col & 63);
+
+    for (uint32_t row = 0; row < height_; ++row) {
+        uint32_t count = 0;
+        forEachNeighbor(torus, Position(static_cast<int32_t>(col), static_cast<int32_t>(row)), [&](const Position& n) {
+            count += getBit(static_cast<uint32_t>(n.x), static_cast<uint32_t>(n.y)) ? 1u : 0u;
+        });
+        bool alive = getBit(col, row);
+        uint64_t& word = rowPtr(next_, row)[col >> 6];
+
+        if (rule_.nextState(alive, count)) {
+            word |= mask;
+        } else {
+            word &= ~mask;
+        }
+    }
+}
+
+void DenseGrid::clear() {
+    std::fill(cells_.begin(), cells_.end(), 0);
+    population_ = 0;
+}
+
+size_t DenseGrid::getMemoryUsage() const {
+    return (cells_.capacity() + next_.capacity()) * sizeof(uint64_t) + sizeof(*this);
+}
+
+bool DenseGrid::getActiveBounds(int32_t& minX, int32_t& maxX, int32_t& minY, int32_t& maxY) const {
+    // Every row is recomputed each step, so nothing narrower is known
+    minX = originX_;
+    maxX = originX_ + static_cast<int32_t>(width_) - 1;
+    minY = originY_;
+    maxY = originY_ + static_cast<int32_t>(height_) - 1;
+    return true;
+}
+
+void DenseGrid::collectChanges(std::vector<Position>& born, std::vector<Position>& died) const {
+    // After the swap the spare buffer holds the previous generation
+    for (uint32_t row = 0; row < height_; ++row) {
+        const uint64_t* current = rowPtr(cells_, row);
+        const uint64_t* previous = rowPtr(next_, row);
+
+        for (size_t w = 0; w < wordsPerRow_; ++w) {
+            uint64_t bits = current[w] ^ previous[w];
+            while (bits != 0) {
+                auto bit = static_cast<size_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                Position pos(originX_ + static_cast<int32_t>(w * 64 + bit), originY_ + static_cast<int32_t>(row));
+                if ((current[w] >> bit) & 1u) {
+                    born.push_back(pos);
+                } else {
+                    died.push_back(pos);
+                }
+            }
+        }
+    }
+}
+
+void DenseGrid::collectLiveCells(std::vector<Position>& out) const {
+    collectCellsInRegion(originX_, originX_ + static_cast<int32_t>(width_) - 1,
+                         originY_, originY_ + static_cast<int32_t>(height_) - 1, out);
+}
+
+void DenseGrid::collectCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                                     std::vector<Position>& out) const {
+    // Clip the region to the grid
+    int64_t colBegin = std::max<int64_t>(0, static_cast<int64_t>(minX) - originX_);
+    int64_t colEnd = std::min<int64_t>(width_, static_cast<int64_t>(maxX) - originX_ + 1);
+    int64_t rowBegin = std::max<int64_t>(0, static_cast<int64_t>(minY) - originY_);
+    int64_t rowEnd = std::min<int64_t>(height_, static_cast<int64_t>(maxY) - originY_ + 1);
+
+    if (colBegin >= colEnd || rowBegin >= rowEnd) {
+        return;
+    }
+
+    auto firstWord = static_cast<size_t>(colBegin >> 6);
+    auto lastWord = static_cast<size_t>((colEnd - 1) >> 6);
+
+    for (auto row = static_cast<size_t>(rowBegin); row < static_cast<size_t>(rowEnd); ++row) {
+        const uint64_t* words = rowPtr(cells_, static_cast<int64_t>(row));
+
+        for (size_t w = firstWord; w <= lastWord; ++w) {
+            uint64_t bits = words[w];
+
+            // Mask off columns outside the region in the first and last words
+            if (w == firstWord && (colBegin & 63) != 0) {
+                bits &= ~uint64_t{0} << (colBegin & 63);
+            }
+            if (w == lastWord && (colEnd & 63) != 0) {
+                bits &= ~uint64_t{0} >> (64 - (colEnd & 63));
+            }
+
+            while (bits != 0) {
+                auto bit = static_cast<size_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                out.emplace_back(originX_ + static_cast<int32_t>(w * 64 + bit),
+                                 originY_ + static_cast<int32_t>(row));
+            }
+        }
+    }
+}
+
+void DenseGrid::recountPopulation() {
+    // Guard rows may hold stale wrapped copies, so only count the grid rows
+    uint32_t count = 0;
+    for (uint32_t row = 0; row < height_; ++row) {
+        const uint64_t* words = rowPtr(cells_, row);
+        for (size_t w = 0; w < wordsPerRow_; ++w) {
+            count += static_cast<uint32_t>(std::popcount(words[w]));
+        }
+    }
+    population_ = count;
+}
+
+} // namespace flecs_gol
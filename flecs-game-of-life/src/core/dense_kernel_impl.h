@@ -0,0 +1,191 @@
+#pragma once
+
+// Shared bit-sliced row kernel, instantiated once per instruction set.
+// Included only by the dense_kernels*.cpp translation units so that each
+// instantiation is compiled with the matching target flags. Everything here
+// has internal linkage so the linker can never merge a scalar instantiation
+// compiled with AVX2 enabled into the baseline translation unit.
+
+#include <flecs_gol/life_rule.h>
+#include <cstdint>
+#include <cstddef>
+
+namespace flecs_gol::detail {
+namespace {
+
+struct ScalarOps {
+    using V = uint64_t;
+    static constexpr size_t LANES = 1;
+
+    static V load(const uint64_t* p) { return *p; }
+    static void store(uint64_t* p, V v) { *p = v; }
+    static V bitXor(V a, V b) { return a ^ b; }
+    static V bitAnd(V a, V b) { return a & b; }
+    static V bitOr(V a, V b) { return a | b; }
+    static V andNot(V a, V b) { return ~a & b; } // (!a) & b
+    static V shiftLeft1(V a) { return a << 1; }
+    static V shiftRight1(V a) { return a >> 1; }
+    static V shiftLeft63(V a) { return a << 63; }
+    static V shiftRight63(V a) { return a >> 63; }
+};
+
+// Neighbor count of every bit position of LANES words starting at index i,
+// summed from the eight neighbor bitboards with a tree of full adders. The
+// count is ones + 2 * twos + 4 * (foursA + foursB); the two weight-4 carries
+// are both set only for eight neighbors.
+template <typename Ops>
+struct NeighborSum {
+    typename Ops::V ones;
+    typename Ops::V twos;
+    typename Ops::V foursA;
+    typename Ops::V foursB;
+};
+
+template <typename Ops>
+inline NeighborSum<Ops> sumNeighbors(const uint64_t* above, const uint64_t* row, const uint64_t* below, size_t i) {
+    using V = typename Ops::V;
+
+    // West neighbor of bit j is bit j-1: shift left, pull bit 63 of the previous word
+    auto west = [](const uint64_t* p) {
+        return Ops::bitOr(Ops::shiftLeft1(Ops::load(p)), Ops::shiftRight63(Ops::load(p - 1)));
+    };
+    // East neighbor of bit j is bit j+1: shift right, pull bit 0 of the next word
+    auto east = [](const uint64_t* p) {
+        return Ops::bitOr(Ops::shiftRight1(Ops::load(p)), Ops::shiftLeft63(Ops::load(p + 1)));
+    };
+    auto fullAdd = [](V a, V b, V c, V& carry) {
+        V ab = Ops::bitXor(a, b);
+        carry = Ops::bitOr(Ops::bitAnd(a, b), Ops::bitAnd(c, ab));
+        return Ops::bitXor(ab, c);
+    };
+
+    V carryAbove, carryBelow;
+    V sumAbove = fullAdd(west(above + i), Ops::load(above + i), east(above + i), carryAbove);
+    V sumBelow = fullAdd(west(below + i), Ops::load(below + i), east(below + i), carryBelow);
+
+    V rowWest = west(row + i);
+    V rowEast = east(row + i);
+    V sumRow = Ops::bitXor(rowWest, rowEast);
+    V carryRow = Ops::bitAnd(rowWest, rowEast);
+
+    NeighborSum<Ops> sum;
+
+    // Weight-1 column
+    V carryOnes;
+    sum.ones = fullAdd(sumAbove, sumBelow, sumRow, carryOnes);
+
+    // Weight-2 column: three carries plus the carry out of the ones column
+    V partialTwos = fullAdd(carryAbove, carryBelow, carryRow, sum.foursA);
+    sum.twos = Ops::bitXor(partialTwos, carryOnes);
+    sum.foursB = Ops::bitAnd(partialTwos, carryOnes);
+    return sum;
+}
+
+// Next state of LANES words starting at index i under B3/S23
+template <typename Ops>
+inline typename Ops::V stepWords(const uint64_t* above, const uint64_t* row, const uint64_t* below, size_t i) {
+    using V = typename Ops::V;
+
+    const NeighborSum<Ops> sum = sumNeighbors<Ops>(above, row, below, i);
+    V center = Ops::load(row + i);
+
+    // Four or more neighbors kills or prevents birth
+    V fourOrMore = Ops::bitOr(sum.foursA, sum.foursB);
+
+    // Alive next: count is 2 or 3 (twos set, nothing above) and (count is 3 or cell alive)
+    return Ops::andNot(fourOrMore, Ops::bitAnd(sum.twos, Ops::bitOr(sum.ones, center)));
+}
+
+// Next state of LANES words starting at index i under any B/S rule. Rule is
+// either a FixedLifeRule, whose masks are constants so only the counts the
+// rule names are tested, or a LifeRule read at run time.
+template <typename Ops, typename Rule>
+inline typename Ops::V stepWordsRule(const uint64_t* above, const uint64_t* row, const uint64_t* below,
+                                     size_t i, const Rule& rule) {
+    using V = typename Ops::V;
+
+    const NeighborSum<Ops> sum = sumNeighbors<Ops>(above, row, below, i);
+    V center = Ops::load(row + i);
+    V fours = Ops::bitXor(sum.foursA, sum.foursB);
+    V eights = Ops::bitAnd(sum.foursA, sum.foursB);
+    const V planes[4] = {sum.ones, sum.twos, fours, eights};
+
+    // Bits whose count is exactly n, for n >= 1 (at least one plane is set)
+    auto countIs = [&planes](uint32_t n) {
+        uint32_t first = 0;
+        while (((n >> first) & 1u) == 0) {
+            ++first;
+        }
+        V match = planes[first];
+        for (uint32_t plane = first + 1; plane < 4; ++plane) {
+            match = ((n >> plane) & 1u) != 0 ? Ops::bitAnd(match, planes[plane]) : Ops::andNot(planes[plane], match);
+        }
+        for (uint32_t plane = 0; plane < first; ++plane) {
+            match = Ops::andNot(planes[plane], match);
+        }
+        return match;
+    };
+
+    V survive = Ops::bitXor(center, center);
+    V born = survive;
+    if ((rule.survival & 1u) != 0) {
+        // No neighbors: no plane is set
+        survive = Ops::andNot(Ops::bitOr(Ops::bitOr(sum.ones, sum.twos), Ops::bitOr(sum.foursA, sum.foursB)), center);
+    }
+    for (uint32_t n = 1; n <= 8; ++n) {
+        if (((rule.survival >> n) & 1u) != 0) {
+            survive = Ops::bitOr(survive, countIs(n));
+        }
+        if (((rule.birth >> n) & 1u) != 0) {
+            born = Ops::bitOr(born, countIs(n));
+        }
+    }
+    return Ops::bitOr(Ops::bitAnd(center, survive), Ops::andNot(center, born));
+}
+
+template <typename Ops>
+inline void stepRow(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, size_t words) {
+    size_t i = 0;
+    for (; i + Ops::LANES <= words; i += Ops::LANES) {
+        Ops::store(out + i, stepWords<Ops>(above, row, below, i));
+    }
+    for (; i < words; ++i) {
+        out[i] = stepWords<ScalarOps>(above, row, below, i);
+    }
+}
+
+template <typename Ops, typename Rule>
+inline void stepRowRule(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out,
+                        size_t words, const Rule& rule) {
+    size_t i = 0;
+    for (; i + Ops::LANES <= words; i += Ops::LANES) {
+        Ops::store(out + i, stepWordsRule<Ops>(above, row, below, i, rule));
+    }
+    for (; i < words; ++i) {
+        out[i] = stepWordsRule<ScalarOps>(above, row, below, i, rule);
+    }
+}
+
+// Row kernel for any rule: Conway's own kernel for B3/S23, an instantiation
+// per common rule, the run-time masks for the rest. The rule is compared by
+// its masks here rather than through LifeRule's operator== or withLifeRule,
+// which have external linkage and must not be emitted from the AVX2 unit.
+template <typename Ops>
+inline void stepRowAnyRule(const uint64_t* above, const uint64_t* row, const uint64_t* below,
+                           uint64_t* out, size_t words, const LifeRule& rule) {
+    auto is = [&rule](const LifeRule& known) { return rule.birth == known.birth && rule.survival == known.survival; };
+    if (is(CONWAY_RULE)) {
+        stepRow<Ops>(above, row, below, out, words);
+    } else if (is(HIGHLIFE_RULE)) {
+        stepRowRule<Ops>(above, row, below, out, words, FixedLifeRuleOf<HIGHLIFE_RULE>{});
+    } else if (is(DAY_AND_NIGHT_RULE)) {
+        stepRowRule<Ops>(above, row, below, out, words, FixedLifeRuleOf<DAY_AND_NIGHT_RULE>{});
+    } else if (is(SEEDS_RULE)) {
+        stepRowRule<Ops>(above, row, below, out, words, FixedLifeRuleOf<SEEDS_RULE>{});
+    } else {
+        stepRowRule<Ops>(above, row, below, out, words, rule);
+    }
+}
+
+} // namespace
+} // namespace flecs_gol::detail
@@ -0,0 +1,37 @@
+// AVX2 instantiation of the dense row kernel (compiled with AVX2 enabled;
+// only called after runtime detection confirms CPU support)
+#include "dense_kernel_impl.h"
+#include <immintrin.h>
+
+namespace flecs_gol {
+
+namespace {
+
+struct Avx2Ops {
+    using V = __m256i;
+    static constexpr size_t LANES = 4;
+
+    static V load(const uint64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(uint64_t* p, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static V bitXor(V a, V b) { return _mm256_xor_si256(a, b); }
+    static V bitAnd(V a, V b) { return _mm256_and_si256(a, b); }
+    static V bitOr(V a, V b) { return _mm256_or_si256(a, b); }
+    static V andNot(V a, V b) { return _mm256_andnot_si256(a, b); }
+    static V shiftLeft1(V a) { return _mm256_slli_epi64(a, 1); }
+    static V shiftRight1(V a) { return _mm256_srli_epi64(a, 1); }
+    static V shiftLeft63(V a) { return _mm256_slli_epi64(a, 63); }
+    static V shiftRight63(V a) { return _mm256_srli_epi64(a, 63); }
+};
+
+} // namespace
+
+void stepRowAvx2(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, size_t words) {
+    detail::stepRow<Avx2Ops>(above, row, below, out, words);
+}
+
+void stepRowRuleAvx2(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, size_t words,
+                     const LifeRule& rule) {
+    detail::stepRowAnyRule<Avx2Ops>(above, row, below, out, words, rule);
+}
+
+} // namespace flecs_gol
@@ -1,14 +1,35 @@
 #include <flecs_gol/game_of_life_simulation.h>
+#include <flecs_gol/chunked_plane.h>
+#include <flecs_gol/dense_grid.h>
+#include <flecs_gol/hashlife_engine.h>
+#include <flecs_gol/tiled_grid.h>
+#include <flecs_gol/topology.h>
+#include <flecs_gol/trace.h>
 #include <algorithm>
 #include <iostream>
-#include <set>
+#include <limits>
+#include <thread>
 
 namespace flecs_gol {
 
+namespace {
+
+int compareMorton(flecs::entity_t, const Position* a, flecs::entity_t, const Position* b) {
+    const uint64_t keyA = a->morton();
+    const uint64_t keyB = b->morton();
+    return (keyA > keyB) - (keyA < keyB);
+}
+
+} // namespace
+
 GameOfLifeSimulation::GameOfLifeSimulation(const GameConfig& config)
     : config_(config)
     , liveCellQuery_(world_.query<Position, Cell>())
-    , birthCandidateQuery_(world_.query<Position, BirthCandidate>()) {
+    , birthCandidateQuery_(world_.query<Position, BirthCandidate>())
+    , mortonOrderQuery_(world_.query_builder<const Position, const Cell>()
+                            .order_by<Position>(compareMorton)
+                            .cached()
+                            .build()) {
     
     // Register components
     world_.component<Position>();
@@ -16,15 +37,45 @@ GameOfLifeSimulation::GameOfLifeSimulation(const GameConfig& config)
     world_.component<BirthCandidate>();
     world_.component<GridState>();
     world_.component<PerformanceMetrics>();
+    world_.component<NeighborCountPhase>();
+    world_.component<RuleEvaluationPhase>();
+    world_.component<LifecyclePhase>();
     
     // Create singleton entities
     gridStateEntity_ = world_.entity().set<GridState>({});
     performanceEntity_ = world_.entity().set<PerformanceMetrics>({});
     
+    if (config_.getEngineType() == EngineType::Dense) {
+        engine_ = std::make_unique<DenseGrid>(config_);
+    } else if (config_.getEngineType() == EngineType::Tiled) {
+        auto tiled = std::make_unique<TiledGrid>(config_);
+        tiledGrid_ = tiled.get();
+        engine_ = std::move(tiled);
+    } else if (config_.getEngineType() == EngineType::HashLife) {
+        engine_ = std::make_unique<HashLifeEngine>(config_.getHashLifeStepLog2(), 0, config_.getRule());
+    } else if (config_.getEngineType() == EngineType::Chunked) {
+        engine_ = std::make_unique<ChunkedPlane>(config_.getRule());
+    } else {
+        uint32_t threads = config_.getWorkerThreads();
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        world_.set_threads(static_cast<int32_t>(threads));
+    }
+    
+    registerSystems();
+    
     lastStepTime_ = std::chrono::high_resolution_clock::now();
 }
 
 flecs::entity GameOfLifeSimulation::createCell(int32_t x, int32_t y) {
+    if (engine_) {
+        // Engine-backed cells have no entity representation; engines check their own bounds
+        engine_->setCell(x, y, true);
+        gridStateEntity_.get_mut<GridState>().liveCellCount = engine_->getCellCount();
+        return flecs::entity();
+    }
+    
     if (!isValidPosition(x, y)) {
         return flecs::entity(); // Return invalid entity
     }
@@ -43,6 +94,7 @@ flecs::entity GameOfLifeSimulation::createCell(int32_t x, int32_t y) {
         .set<Cell>({});
     
     spatialIndex_[pos] = entity;
+    regionIndex_.insert(pos);
     
     // Update grid state
     auto& gridState = gridStateEntity_.get_mut<GridState>();
@@ -51,12 +103,62 @@ flecs::entity GameOfLifeSimulation::createCell(int32_t x, int32_t y) {
     return entity;
 }
 
+void GameOfLifeSimulation::createCells(std::span<const Position> cells) {
+    if (engine_) {
+        for (const auto& pos : cells) {
+            engine_->setCell(pos.x, pos.y, true);
+        }
+        gridStateEntity_.get_mut<GridState>().liveCellCount = engine_->getCellCount();
+        return;
+    }
+    
+    // Keep each new position once
+    std::vector<Position> fresh;
+    fresh.reserve(cells.size());
+    for (const auto& pos : cells) {
+        if (isValidPosition(pos.x, pos.y) && spatialIndex_.find(pos) == spatialIndex_.end()) {
+            fresh.push_back(pos);
+        }
+    }
+    std::sort(fresh.begin(), fresh.end());
+    fresh.erase(std::unique(fresh.begin(), fresh.end()), fresh.end());
+    if (fresh.empty()) {
+        return;
+    }
+    
+    spatialIndex_.reserve(spatialIndex_.size() + fresh.size());
+    
+    // One bulk call creates every entity directly in the (Position, Cell) table
+    std::vector<Cell> cellData(fresh.size());
+    void* data[] = {fresh.data(), cellData.data()};
+    ecs_bulk_desc_t desc = {};
+    desc.count = static_cast<int32_t>(fresh.size());
+    desc.ids[0] = world_.id<Position>();
+    desc.ids[1] = world_.id<Cell>();
+    desc.data = data;
+    const ecs_entity_t* entities = ecs_bulk_init(world_, &desc);
+    
+    for (size_t i = 0; i < fresh.size(); ++i) {
+        spatialIndex_[fresh[i]] = flecs::entity(world_, entities[i]);
+        regionIndex_.insert(fresh[i]);
+    }
+    
+    gridStateEntity_.get_mut<GridState>().liveCellCount += static_cast<uint32_t>(fresh.size());
+}
+
 void GameOfLifeSimulation::destroyCell(int32_t x, int32_t y) {
+    if (engine_) {
+        engine_->setCell(x, y, false);
+        gridStateEntity_.get_mut<GridState>().liveCellCount = engine_->getCellCount();
+        return;
+    }
+    
     Position pos(x, y);
     auto it = spatialIndex_.find(pos);
     if (it != spatialIndex_.end()) {
         it->second.destruct();
         spatialIndex_.erase(it);
+        regionIndex_.erase(pos);
         
         // Update grid state
         auto& gridState = gridStateEntity_.get_mut<GridState>();
@@ -67,6 +169,10 @@ void GameOfLifeSimulation::destroyCell(int32_t x, int32_t y) {
 }
 
 bool GameOfLifeSimulation::isCellAlive(int32_t x, int32_t y) const {
+    if (engine_) {
+        return engine_->isCellAlive(x, y);
+    }
+    
     Position pos(x, y);
     auto it = spatialIndex_.find(pos);
     return it != spatialIndex_.end() && it->second.is_alive();
@@ -82,47 +188,22 @@ flecs::entity GameOfLifeSimulation::getCellAt(int32_t x, int32_t y) const {
 }
 
 void GameOfLifeSimulation::step() {
+    FLECS_GOL_TRACE_SCOPE("GameOfLifeSimulation::step");
     auto stepStart = std::chrono::high_resolution_clock::now();
-    
-    // Save current state before modifying
-    std::set<Position> currentlyAlive;
-    liveCellQuery_.each([&](flecs::entity, Position& pos, Cell&) {
-        currentlyAlive.insert(pos);
-    });
-    
-    // Count neighbors for all positions that could be affected
-    std::unordered_map<Position, int> neighborCounts;
-    for (const auto& cellPos : currentlyAlive) {
-        auto neighbors = getNeighborPositions(cellPos.x, cellPos.y);
-        for (const auto& neighborPos : neighbors) {
-            neighborCounts[neighborPos]++;
-        }
-    }
-    
-    // Apply Conway's rules to determine next generation
-    std::set<Position> nextGeneration;
-    for (const auto& [pos, count] : neighborCounts) {
-        bool isCurrentlyAlive = (currentlyAlive.find(pos) != currentlyAlive.end());
-        
-        if (isCurrentlyAlive) {
-            // Live cell survives with 2 or 3 neighbors
-            if (count == 2 || count == 3) {
-                nextGeneration.insert(pos);
-            }
-            // Otherwise it dies (underpopulation or overpopulation)
-        } else {
-            // Dead cell becomes alive with exactly 3 neighbors
-            if (count == 3 && isValidPosition(pos.x, pos.y)) {
-                nextGeneration.insert(pos);
-            }
-        }
+    bornCells_.clear();
+    diedCells_.clear();
+    
+    if (engine_) {
+        engine_->step();
+        publishEngineStep(static_cast<uint32_t>(engine_->getGenerationsPerStep()));
+        lastStepTime_ = stepStart;
+        return;
     }
     
-    // Update the grid atomically
-    clear();
-    for (const auto& pos : nextGeneration) {
-        createCell(pos.x, pos.y);
-    }
+    // Births and deaths are applied as a diff; surviving cells keep their entities
+    neighborCountSystem();
+    ruleEvaluationSystem();
+    lifecycleSystem();
     
     updatePerformanceMetrics();
     
@@ -130,9 +211,62 @@ void GameOfLifeSimulation::step() {
     auto& gridState = gridStateEntity_.get_mut<GridState>();
     gridState.generation++;
     
+    const uint32_t sortInterval = config_.getCellSortInterval();
+    if (sortInterval != 0 && gridState.generation % sortInterval == 0) {
+        sortCells();
+    }
+    
     lastStepTime_ = stepStart;
 }
 
+uint32_t GameOfLifeSimulation::advance(uint32_t steps) {
+    constexpr uint32_t BLOCK = TiledGrid::BLOCK_GENERATIONS;
+    if (!tiledGrid_ || steps < BLOCK) {
+        return LifeEngine::advance(steps);
+    }
+    
+    uint32_t taken = 0;
+    while (steps - taken >= BLOCK) {
+        auto stepStart = std::chrono::high_resolution_clock::now();
+        bornCells_.clear();
+        diedCells_.clear();
+        tiledGrid_->step(BLOCK);
+        publishEngineStep(BLOCK);
+        lastStepTime_ = stepStart;
+        taken += BLOCK;
+        if (!bornCells_.empty() || !diedCells_.empty() || taken == steps) {
+            continue;
+        }
+        
+        // Unchanged over a block: the board repeats with a period dividing it.
+        // A still life was one when the block began, so stop one step into
+        // it; an oscillator keeps its phase across any number of whole blocks.
+        step();
+        ++taken;
+        if (bornCells_.empty() && diedCells_.empty()) {
+            setGeneration(getGeneration() - BLOCK);
+            return taken - BLOCK;
+        }
+        const uint32_t skipped = (steps - taken) / BLOCK * BLOCK;
+        setGeneration(getGeneration() + skipped);
+        taken += skipped;
+        break;
+    }
+    return taken + LifeEngine::advance(steps - taken);
+}
+
+void GameOfLifeSimulation::publishEngineStep(uint32_t generations) {
+    engine_->collectChanges(bornCells_, diedCells_);
+    
+    auto& gridState = gridStateEntity_.get_mut<GridState>();
+    gridState.liveCellCount = engine_->getCellCount();
+    gridState.generation += generations;
+    gridState.hasActiveArea = engine_->getActiveBounds(gridState.minX, gridState.maxX,
+                                                       gridState.minY, gridState.maxY);
+    
+    updatePerformanceMetrics();
+}
+
 void GameOfLifeSimulation::reset() {
     clear();
     auto& gridState = gridStateEntity_.get_mut<GridState>();
@@ -151,9 +285,18 @@ void GameOfLifeSimulation::clear() {
     });
     
     spatialIndex_.clear();
+    regionIndex_.clear();
+    candidateIndex_.clear();
+    bornCells_.clear();
+    diedCells_.clear();
+    
+    if (engine_) {
+        engine_->clear();
+    }
     
     auto& gridState = gridStateEntity_.get_mut<GridState>();
     gridState.liveCellCount = 0;
+    gridState.hasActiveArea = false;
 }
 
 uint32_t GameOfLifeSimulation::getCellCount() const {
@@ -166,28 +309,78 @@ uint32_t GameOfLifeSimulation::getGeneration() const {
     return gridState.generation;
 }
 
+void GameOfLifeSimulation::setGeneration(uint32_t generation) {
+    auto& gridState = gridStateEntity_.get_mut<GridState>();
+    gridState.generation = generation;
+}
+
 size_t GameOfLifeSimulation::getMemoryUsage() const {
     const auto& metrics = performanceEntity_.get<PerformanceMetrics>();
     return metrics.memoryUsage;
 }
 
+PerformanceMetrics GameOfLifeSimulation::getPerformanceMetrics() const {
+    return performanceEntity_.get<PerformanceMetrics>();
+}
+
+GridState GameOfLifeSimulation::getGridState() const {
+    return gridStateEntity_.get<GridState>();
+}
+
 uint8_t GameOfLifeSimulation::getNeighborCount(int32_t x, int32_t y) const {
-    uint8_t count = 0;
-    auto neighborPositions = getNeighborPositions(x, y);
-    
-    for (const auto& neighborPos : neighborPositions) {
-        if (isCellAlive(neighborPos.x, neighborPos.y)) {
-            count++;
-        }
+    if (engine_) {
+        return engine_->getNeighborCount(x, y);
     }
     
-    return count;
+    return countLiveNeighbors(Position(x, y));
 }
 
 void GameOfLifeSimulation::updateNeighborCounts() {
     neighborCountSystem();
 }
 
+std::vector<Position> GameOfLifeSimulation::getLivePositions() const {
+    std::vector<Position> positions;
+    positions.reserve(getCellCount());
+    
+    if (engine_) {
+        engine_->collectLiveCells(positions);
+        return positions;
+    }
+    
+    liveCellQuery_.each([&](flecs::entity, Position& pos, Cell&) {
+        positions.push_back(pos);
+    });
+    return positions;
+}
+
+void GameOfLifeSimulation::copyLiveCells(RegionIndex& out) const {
+    if (!engine_) {
+        out = regionIndex_;
+        return;
+    }
+    
+    out.clear();
+    for (const auto& pos : getLivePositions()) {
+        out.insert(pos);
+    }
+}
+
+std::vector<Position> GameOfLifeSimulation::getPositionsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY) const {
+    std::vector<Position> positions;
+    collectPositionsInRegion(minX, maxX, minY, maxY, positions);
+    return positions;
+}
+
+void GameOfLifeSimulation::collectPositionsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                                                    std::vector<Position>& out) const {
+    if (engine_) {
+        engine_->collectCellsInRegion(minX, maxX, minY, maxY, out);
+    } else {
+        regionIndex_.collectRegion(minX, maxX, minY, maxY, out);
+    }
+}
+
 std::vector<flecs::entity> GameOfLifeSimulation::getAllCells() const {
     std::vector<flecs::entity> cells;
     liveCellQuery_.each([&](flecs::entity entity, Position&, Cell&) {
@@ -197,12 +390,14 @@ std::vector<flecs::entity> GameOfLifeSimulation::getAllCells() const {
 }
 
 std::vector<flecs::entity> GameOfLifeSimulation::getCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY) const {
+    std::vector<Position> positions;
+    regionIndex_.collectRegion(minX, maxX, minY, maxY, positions);
+    
     std::vector<flecs::entity> cells;
-    liveCellQuery_.each([&](flecs::entity entity, Position& pos, Cell&) {
-        if (pos.x >= minX && pos.x <= maxX && pos.y >= minY && pos.y <= maxY) {
-            cells.push_back(entity);
-        }
-    });
+    cells.reserve(positions.size());
+    for (const auto& pos : positions) {
+        cells.push_back(spatialIndex_.find(pos)->second);
+    }
     return cells;
 }
 
@@ -216,124 +411,229 @@ std::vector<flecs::entity> GameOfLifeSimulation::getCellsWithNeighborCount(uint8
     return cells;
 }
 
-void GameOfLifeSimulation::neighborCountSystem() {
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    // Reset neighbor counts for all live cells
-    liveCellQuery_.each([](flecs::entity, Position&, Cell& cell) {
-        cell.neighborCount = 0;
+uint8_t GameOfLifeSimulation::countLiveNeighbors(const Position& pos) const {
+    if (!isValidPosition(pos.x, pos.y)) {
+        // Outside the boundaries: wrap onto the grid, or count the in-bounds neighbors
+        if (config_.getWrapEdges()) {
+            return countLiveNeighbors(wrapPosition(pos.x, pos.y));
+        }
+        uint8_t count = 0;
+        for (const auto& [dx, dy] : NEIGHBOR_OFFSETS) {
+            if (isValidPosition(pos.x + dx, pos.y + dy) &&
+                spatialIndex_.find(Position(pos.x + dx, pos.y + dy)) != spatialIndex_.end()) {
+                count++;
+            }
+        }
+        return count;
+    }
+    return withTopology(config_, [&](const auto& topology) { return countLiveNeighbors(topology, pos); });
+}
+
+template <typename Topology>
+uint8_t GameOfLifeSimulation::countLiveNeighbors(const Topology& topology, const Position& pos) const {
+    // Reads only the spatial index, so it is safe from worker threads
+    uint8_t count = 0;
+    forEachNeighbor(topology, pos, [&](const Position& neighborPos) {
+        if (spatialIndex_.find(neighborPos) != spatialIndex_.end()) {
+            count++;
+        }
     });
-    
-    // Clear previous birth candidates
-    birthCandidateQuery_.each([](flecs::entity entity, Position&, BirthCandidate&) {
-        entity.destruct();
+    return count;
+}
+
+void GameOfLifeSimulation::markActive(const Position& pos) {
+    // Called from the single-threaded lifecycle systems only
+    if (!stepActivity_.hasActiveArea) {
+        stepActivity_.minX = stepActivity_.maxX = pos.x;
+        stepActivity_.minY = stepActivity_.maxY = pos.y;
+        stepActivity_.hasActiveArea = true;
+        return;
+    }
+    stepActivity_.minX = std::min(stepActivity_.minX, pos.x);
+    stepActivity_.maxX = std::max(stepActivity_.maxX, pos.x);
+    stepActivity_.minY = std::min(stepActivity_.minY, pos.y);
+    stepActivity_.maxY = std::max(stepActivity_.maxY, pos.y);
+}
+
+void GameOfLifeSimulation::sortCells() {
+    FLECS_GOL_TRACE_SCOPE("GameOfLifeSimulation::sortCells");
+    // Births append to the cell table and deaths move its last row into the
+    // gap, so row order drifts away from space. An ordered query sorts the
+    // table in place when iterated, which puts it back in Z-order for every
+    // system: the neighbors of a cell are then mostly its neighbors in
+    // Position and Cell storage too.
+    mortonOrderQuery_.each([](const Position&, const Cell&) {});
+}
+
+void GameOfLifeSimulation::registerSystems() {
+    // Neighbor counting: live cells count their own neighbors, then every empty
+    // position next to a live cell gets a BirthCandidate entity that does the
+    // same. The systems capture the grid's topology, so their neighbor loops
+    // have no wrap test per neighbor.
+    withTopology(config_, [this](const auto& topology) {
+        world_.system<const Position, Cell>("CountCellNeighbors")
+            .kind<NeighborCountPhase>()
+            .multi_threaded()
+            .each([this, topology](const Position& pos, Cell& cell) {
+                cell.neighborCount = countLiveNeighbors(topology, pos);
+            });
+        
+        world_.system<const Position, const Cell>("CollectBirthCandidates")
+            .kind<NeighborCountPhase>()
+            .write<Position>()
+            .write<BirthCandidate>()
+            .each([this, topology](flecs::entity entity, const Position& pos, const Cell&) {
+                forEachNeighbor(topology, pos, [&](const Position& neighborPos) {
+                    if (spatialIndex_.find(neighborPos) != spatialIndex_.end() ||
+                        candidateIndex_.find(neighborPos) != candidateIndex_.end()) {
+                        return;
+                    }
+                    candidateIndex_[neighborPos] = entity.world().entity()
+                        .set<Position>(neighborPos)
+                        .set<BirthCandidate>({});
+                });
+            });
+        
+        world_.system<const Position, BirthCandidate>("CountCandidateNeighbors")
+            .kind<NeighborCountPhase>()
+            .multi_threaded()
+            .each([this, topology](const Position& pos, BirthCandidate& candidate) {
+                candidate.neighborCount = countLiveNeighbors(topology, pos);
+            });
     });
     
-    // Count neighbors for each live cell and track potential birth positions
-    std::unordered_map<Position, uint8_t> potentialBirths;
-    
-    // For each live cell, count how many live neighbors it has
-    liveCellQuery_.each([&](flecs::entity entity, Position& pos, Cell& cell) {
-        auto neighborPositions = getNeighborPositions(pos.x, pos.y);
+    // Rule evaluation: pure per-entity decisions, safe to spread over workers.
+    // The systems capture the rule as a FixedLifeRule where there is one, so
+    // Conway's decisions compile to the same constant tests as before.
+    withLifeRule(config_.getRule(), [this](const auto& rule) {
+        world_.system<Cell>("EvaluateSurvival")
+            .kind<RuleEvaluationPhase>()
+            .multi_threaded()
+            .each([rule](Cell& cell) {
+                cell.willLive = rule.nextState(true, cell.neighborCount);
+            });
         
-        for (const auto& neighborPos : neighborPositions) {
-            if (isCellAlive(neighborPos.x, neighborPos.y)) {
-                // This neighbor position has a live cell
-                cell.neighborCount++;
-            }
-        }
+        world_.system<BirthCandidate>("EvaluateBirth")
+            .kind<RuleEvaluationPhase>()
+            .multi_threaded()
+            .each([rule](BirthCandidate& candidate) {
+                candidate.willBeBorn = rule.nextState(false, candidate.neighborCount);
+            });
     });
     
-    // For each live cell, contribute to potential births at empty neighbor positions
-    liveCellQuery_.each([&](flecs::entity, Position& pos, Cell&) {
-        auto neighborPositions = getNeighborPositions(pos.x, pos.y);
-        
-        for (const auto& neighborPos : neighborPositions) {
-            if (!isCellAlive(neighborPos.x, neighborPos.y) && isValidPosition(neighborPos.x, neighborPos.y)) {
-                // This neighbor position is empty, increment its potential birth count
-                potentialBirths[neighborPos]++;
+    // Lifecycle: structural changes, single-threaded. Deaths run first so
+    // newborn cells are never evaluated against last generation's rules.
+    world_.system<const Position, const Cell>("ApplyDeaths")
+        .kind<LifecyclePhase>()
+        .each([this](flecs::entity entity, const Position& pos, const Cell& cell) {
+            if (!cell.willLive) {
+                markActive(pos);
+                diedCells_.push_back(pos);
+                spatialIndex_.erase(pos);
+                regionIndex_.erase(pos);
+                entity.destruct();
             }
-        }
-    });
+        });
+    
+    world_.system<const Position, const BirthCandidate>("ApplyBirths")
+        .kind<LifecyclePhase>()
+        .each([this](flecs::entity entity, const Position& pos, const BirthCandidate& candidate) {
+            if (candidate.willBeBorn) {
+                // The candidate entity becomes the new cell
+                markActive(pos);
+                bornCells_.push_back(pos);
+                entity.remove<BirthCandidate>().set<Cell>({});
+                spatialIndex_[pos] = entity;
+                regionIndex_.insert(pos);
+            } else {
+                entity.destruct();
+            }
+        });
+    
+    neighborCountPipeline_ = world_.pipeline()
+        .with(flecs::System)
+        .with<NeighborCountPhase>()
+        .build();
+    ruleEvaluationPipeline_ = world_.pipeline()
+        .with(flecs::System)
+        .with<RuleEvaluationPhase>()
+        .build();
+    lifecyclePipeline_ = world_.pipeline()
+        .with(flecs::System)
+        .with<LifecyclePhase>()
+        .build();
+}
+
+void GameOfLifeSimulation::neighborCountSystem() {
+    FLECS_GOL_TRACE_SCOPE("GameOfLifeSimulation::neighborCountSystem");
+    auto start = std::chrono::high_resolution_clock::now();
     
-    // Create birth candidate entities for positions with exactly 3 neighbors
-    for (const auto& [pos, count] : potentialBirths) {
-        if (count == 3 && isValidPosition(pos.x, pos.y)) {
-            world_.entity()
-                .set<Position>(pos)
-                .set<BirthCandidate>(BirthCandidate(count));
-        }
+    // Drop candidates left over from a neighbor pass that was not followed by a step
+    for (auto& [pos, entity] : candidateIndex_) {
+        entity.destruct();
     }
+    candidateIndex_.clear();
+    
+    world_.run_pipeline(neighborCountPipeline_);
     
     auto end = std::chrono::high_resolution_clock::now();
     auto& metrics = performanceEntity_.get_mut<PerformanceMetrics>();
-    metrics.neighborCountTimeMicros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    metrics.neighborCountTimeMicros = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
 }
 
 void GameOfLifeSimulation::ruleEvaluationSystem() {
+    FLECS_GOL_TRACE_SCOPE("GameOfLifeSimulation::ruleEvaluationSystem");
     auto start = std::chrono::high_resolution_clock::now();
     
-    // Apply Conway's Game of Life rules to live cells
-    liveCellQuery_.each([](flecs::entity, Position&, Cell& cell) {
-        // Cell survives if it has 2 or 3 neighbors
-        cell.willLive = (cell.neighborCount == 2 || cell.neighborCount == 3);
-    });
+    world_.run_pipeline(ruleEvaluationPipeline_);
     
     auto end = std::chrono::high_resolution_clock::now();
     auto& metrics = performanceEntity_.get_mut<PerformanceMetrics>();
-    metrics.ruleEvalTimeMicros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    metrics.ruleEvalTimeMicros = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
 }
 
 void GameOfLifeSimulation::lifecycleSystem() {
+    FLECS_GOL_TRACE_SCOPE("GameOfLifeSimulation::lifecycleSystem");
     auto start = std::chrono::high_resolution_clock::now();
     
-    // Collect entities to destroy and positions for new births
-    std::vector<flecs::entity> entitiesToDestroy;
-    std::vector<Position> positionsToCreate;
-    
-    // Check which live cells should die
-    liveCellQuery_.each([&](flecs::entity entity, Position& pos, Cell& cell) {
-        if (!cell.willLive) {
-            entitiesToDestroy.push_back(entity);
-        }
-    });
-    
-    // Check birth candidates
-    birthCandidateQuery_.each([&](flecs::entity entity, Position& pos, BirthCandidate&) {
-        positionsToCreate.push_back(pos);
-        entity.destruct(); // Remove birth candidate entity
-    });
-    
-    // Destroy dying cells
-    for (auto entity : entitiesToDestroy) {
-        const auto& pos = entity.get<Position>();
-        spatialIndex_.erase(pos);
-        entity.destruct();
-    }
-    
-    // Create new cells
-    for (const auto& pos : positionsToCreate) {
-        auto entity = world_.entity()
-            .set<Position>(pos)
-            .set<Cell>({});
-        spatialIndex_[pos] = entity;
-    }
+    stepActivity_.hasActiveArea = false;
+    world_.run_pipeline(lifecyclePipeline_);
+    candidateIndex_.clear();
     
     // Update grid state
     auto& gridState = gridStateEntity_.get_mut<GridState>();
     gridState.liveCellCount = static_cast<uint32_t>(spatialIndex_.size());
+    gridState.hasActiveArea = stepActivity_.hasActiveArea;
+    if (stepActivity_.hasActiveArea) {
+        gridState.minX = stepActivity_.minX;
+        gridState.maxX = stepActivity_.maxX;
+        gridState.minY = stepActivity_.minY;
+        gridState.maxY = stepActivity_.maxY;
+    }
     
     auto end = std::chrono::high_resolution_clock::now();
     auto& metrics = performanceEntity_.get_mut<PerformanceMetrics>();
-    metrics.lifecycleTimeMicros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    metrics.lifecycleTimeMicros = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
 }
 
 void GameOfLifeSimulation::updatePerformanceMetrics() {
     auto& metrics = performanceEntity_.get_mut<PerformanceMetrics>();
     metrics.entityCount = static_cast<uint32_t>(spatialIndex_.size());
     
-    // Simple memory usage estimation
-    metrics.memoryUsage = spatialIndex_.size() * (sizeof(Position) + sizeof(Cell) + sizeof(flecs::entity) + 64);
+    if (engine_) {
+        metrics.memoryUsage = engine_->getMemoryUsage();
+    } else {
+        // flecs exposes no allocation counters, so the entities are estimated
+        // at their components plus an entity record; the indices and change
+        // buffers are counted by capacity.
+        metrics.memoryUsage = spatialIndex_.size() * (sizeof(Position) + sizeof(Cell) + sizeof(flecs::entity) + 64) +
+                              spatialIndex_.getMemoryUsage() + candidateIndex_.getMemoryUsage() +
+                              regionIndex_.getMemoryUsage() +
+                              (bornCells_.capacity() + diedCells_.capacity()) * sizeof(Position);
+    }
     
     auto currentTime = std::chrono::high_resolution_clock::now();
     metrics.lastUpdateTimeMicros = std::chrono::duration_cast<std::chrono::microseconds>(currentTime - lastStepTime_).count();
@@ -369,30 +669,33 @@ Position GameOfLifeSimulation::wrapPosition(int32_t x, int32_t y) const {
     return Position(wrappedX, wrappedY);
 }
 
-std::vector<Position> GameOfLifeSimulation::getNeighborPositions(int32_t x, int32_t y) const {
-    std::vector<Position> neighbors;
-    neighbors.reserve(8);
-    
-    for (const auto& [dx, dy] : NEIGHBOR_OFFSETS) {
-        int32_t neighborX = x + dx;
-        int32_t neighborY = y + dy;
-        
-        if (config_.getWrapEdges()) {
-            auto wrappedPos = wrapPosition(neighborX, neighborY);
-            neighbors.push_back(wrappedPos);
-        } else if (isValidPosition(neighborX, neighborY)) {
-            neighbors.emplace_back(neighborX, neighborY);
-        }
-    }
-    
-    return neighbors;
-}
-
 void GameOfLifeSimulation::rebuildSpatialIndex() {
     spatialIndex_.clear();
+    regionIndex_.clear();
     liveCellQuery_.each([&](flecs::entity entity, Position& pos, Cell&) {
         spatialIndex_[pos] = entity;
+        regionIndex_.insert(pos);
     });
 }
 
-} // namespace flecs_gol
\ No newline at end of file
+std::unique_ptr<LifeEngine> createLifeEngine(const GameConfig& config) {
+    // Every engine type lives behind GameOfLifeSimulation today
+    return std::make_unique<GameOfLifeSimulation>(config);
+}
+
+void skipSettledSteps(LifeEngine& engine, uint32_t startGeneration, uint32_t taken, uint32_t steps) {
+    if (taken == 0 || taken >= steps) {
+        return;
+    }
+    const uint32_t generation = engine.getGeneration();
+    const uint64_t perStep = static_cast<uint32_t>(generation - startGeneration) / taken;
+    const uint64_t skipped = uint64_t{steps - taken} * perStep;  // Both below 2^32, so no wrap
+    engine.setGeneration(static_cast<uint32_t>(
+        std::min<uint64_t>(generation + skipped, std::numeric_limits<uint32_t>::max())));
+}
+
+bool exceedsEntityLimit(const LifeEngine& engine) {
+    return engine.getCellCount() > engine.getConfig().getMaxEntities();
+}
+
+} // namespace flecs_gol
@@ -0,0 +1,407 @@
+#include <flecs_gol/hashlife_engine.h>
+#include <flecs_gol/trace.h>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace flecs_gol {
+
+namespace {
+
+// Roots beyond this level would overflow 64-bit coordinates
+constexpr uint32_t MAX_LEVEL = 62;
+
+} // namespace
+
+HashLifeEngine::HashLifeEngine(uint32_t stepLog2, size_t maxNodes, const LifeRule& rule)
+    : maxNodes_(maxNodes)
+    , rule_(rule) {
+    aliveLeaf_.population = 1;
+    setStepLog2(stepLog2);
+    clear();
+}
+
+bool HashLifeEngine::setCell(int32_t x, int32_t y, bool alive) {
+    if (!contains(x, y)) {
+        if (!alive) {
+            return true; // Already dead
+        }
+        while (!contains(x, y)) {
+            root_ = expand(root_);
+        }
+    }
+
+    int64_t half = int64_t{1} << (root_->level - 1);
+    root_ = setCell(root_, x + half, y + half, alive);
+    return true;
+}
+
+bool HashLifeEngine::isCellAlive(int32_t x, int32_t y) const {
+    return getCell(x, y);
+}
+
+uint8_t HashLifeEngine::getNeighborCount(int32_t x, int32_t y) const {
+    uint8_t count = 0;
+
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            if ((dx != 0 || dy != 0) && getCell(x + dx, y + dy)) {
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+void HashLifeEngine::step() {
+    FLECS_GOL_TRACE_SCOPE("HashLifeEngine::step");
+    if (maxNodes_ != 0 && nodes_.size() > maxNodes_) {
+        collectGarbage();
+    }
+
+    // The result is the centre half of the root, and the pattern can grow by
+    // one cell per generation, so it must start inside the centre quarter
+    while (root_->level < stepLog2_ + 3 || !patternIsCentred()) {
+        root_ = expand(root_);
+    }
+
+    const Node* before = root_;
+    root_ = nextGeneration(root_);
+
+    // Canonical nodes make equal regions the same pointer
+    const Node* after = expand(root_);
+    lastStepChanged_ = after != before;
+
+    if (!advancing_ || changesBefore_ == nullptr) {
+        changesBefore_ = before;
+    }
+    changesAfter_ = after;
+    while (changesBefore_->level < changesAfter_->level) {
+        changesBefore_ = expand(changesBefore_);
+    }
+    while (changesAfter_->level < changesBefore_->level) {
+        changesAfter_ = expand(changesAfter_);
+    }
+}
+
+void HashLifeEngine::clear() {
+    nodes_.clear();
+    canonical_.clear();
+    emptyNodes_.clear();
+    root_ = emptyNode(3);
+    changesBefore_ = nullptr;
+    changesAfter_ = nullptr;
+    lastStepChanged_ = false;
+}
+
+size_t HashLifeEngine::getMemoryUsage() const {
+    // Node storage plus one hash table entry per node
+    return nodes_.size() * (sizeof(Node) + sizeof(NodeKey) + 2 * sizeof(void*)) + sizeof(*this);
+}
+
+bool HashLifeEngine::getActiveBounds(int32_t& minX, int32_t& maxX, int32_t& minY, int32_t& maxY) const {
+    // Changes are only known per root, which usually exceeds the 32-bit plane
+    minX = std::numeric_limits<int32_t>::min();
+    maxX = std::numeric_limits<int32_t>::max();
+    minY = std::numeric_limits<int32_t>::min();
+    maxY = std::numeric_limits<int32_t>::max();
+    return lastStepChanged_;
+}
+
+void HashLifeEngine::collectChanges(std::vector<Position>& born, std::vector<Position>& died) const {
+    if (changesBefore_ == nullptr || changesBefore_ == changesAfter_) {
+        return;
+    }
+
+    int64_t half = int64_t{1} << (changesAfter_->level - 1);
+    collectChanges(changesBefore_, changesAfter_, -half, -half, born, died);
+}
+
+void HashLifeEngine::collectLiveCells(std::vector<Position>& out) const {
+    collectCellsInRegion(std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max(),
+                         std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max(), out);
+}
+
+void HashLifeEngine::collectCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                                          std::vector<Position>& out) const {
+    int64_t half = int64_t{1} << (root_->level - 1);
+    collectCells(root_, -half, -half, minX, maxX, minY, maxY, out);
+}
+
+void HashLifeEngine::setStepLog2(uint32_t stepLog2) {
+    if (stepLog2 > MAX_STEP_LOG2) {
+        throw std::out_of_range("HashLife step exponent must be at most " + std::to_string(MAX_STEP_LOG2));
+    }
+    // Memoized results record their own step size, so nothing is invalidated here
+    stepLog2_ = stepLog2;
+}
+
+void HashLifeEngine::advance(uint64_t generations) {
+    const uint32_t stepLog2 = stepLog2_;
+    bool changed = false;
+    changesBefore_ = nullptr;
+    changesAfter_ = nullptr;
+    advancing_ = true;
+
+    for (uint32_t bit = 0; generations != 0; ++bit, generations >>= 1) {
+        if (generations & 1) {
+            stepLog2_ = bit;
+            step();
+            changed = changed || lastStepChanged_;
+        }
+    }
+
+    stepLog2_ = stepLog2;
+    advancing_ = false;
+    lastStepChanged_ = changed;
+}
+
+const HashLifeEngine::Node* HashLifeEngine::makeNode(const Node* nw, const Node* ne,
+                                                     const Node* sw, const Node* se) {
+    NodeKey key{nw, ne, sw, se};
+    auto it = canonical_.find(key);
+    if (it != canonical_.end()) {
+        return it->second;
+    }
+
+    Node& node = nodes_.emplace_back();
+    node.nw = nw;
+    node.ne = ne;
+    node.sw = sw;
+    node.se = se;
+    node.population = nw->population + ne->population + sw->population + se->population;
+    node.level = nw->level + 1;
+
+    canonical_.emplace(key, &node);
+    return &node;
+}
+
+const HashLifeEngine::Node* HashLifeEngine::emptyNode(uint32_t level) {
+    while (emptyNodes_.size() <= level) {
+        if (emptyNodes_.empty()) {
+            emptyNodes_.push_back(&deadLeaf_);
+        } else {
+            const Node* child = emptyNodes_.back();
+            emptyNodes_.push_back(makeNode(child, child, child, child));
+        }
+    }
+    return emptyNodes_[level];
+}
+
+const HashLifeEngine::Node* HashLifeEngine::expand(const Node* node) {
+    if (node->level >= MAX_LEVEL) {
+        throw std::overflow_error("HashLife pattern outgrew the 64-bit coordinate range");
+    }
+
+    // Same centre, one level up, with the node's quadrants around the middle
+    const Node* empty = emptyNode(node->level - 1);
+    return makeNode(makeNode(empty, empty, empty, node->nw),
+                    makeNode(empty, empty, node->ne, empty),
+                    makeNode(empty, node->sw, empty, empty),
+                    makeNode(node->se, empty, empty, empty));
+}
+
+const HashLifeEngine::Node* HashLifeEngine::centre(const Node* node) {
+    return makeNode(node->nw->se, node->ne->sw, node->sw->ne, node->se->nw);
+}
+
+const HashLifeEngine::Node* HashLifeEngine::setCell(const Node* node, int64_t x, int64_t y, bool alive) {
+    if (node->level == 0) {
+        return alive ? &aliveLeaf_ : &deadLeaf_;
+    }
+
+    int64_t half = int64_t{1} << (node->level - 1);
+    bool east = x >= half;
+    bool south = y >= half;
+    x -= east ? half : 0;
+    y -= south ? half : 0;
+
+    if (south) {
+        return east ? makeNode(node->nw, node->ne, node->sw, setCell(node->se, x, y, alive))
+                    : makeNode(node->nw, node->ne, setCell(node->sw, x, y, alive), node->se);
+    }
+    return east ? makeNode(node->nw, setCell(node->ne, x, y, alive), node->sw, node->se)
+                : makeNode(setCell(node->nw, x, y, alive), node->ne, node->sw, node->se);
+}
+
+const HashLifeEngine::Node* HashLifeEngine::nextGeneration(const Node* node) {
+    // A level-n node can be advanced at most 2^(n-2) generations
+    const uint32_t stepLog2 = std::min(stepLog2_, node->level - 2);
+    if (node->next != nullptr && node->nextStepLog2 == stepLog2) {
+        return node->next;
+    }
+
+    const Node* result = nullptr;
+    if (node->population == 0) {
+        result = emptyNode(node->level - 1);
+    } else if (node->level == 2) {
+        result = stepLevel2(node);
+    } else {
+        // Two half-steps at full speed; otherwise only the second stage advances
+        const bool fullSpeed = stepLog2 == node->level - 2;
+        auto firstStage = [&](const Node* part) { return fullSpeed ? nextGeneration(part) : centre(part); };
+
+        // Nine overlapping sub-squares, one level down
+        const Node* n00 = firstStage(node->nw);
+        const Node* n01 = firstStage(makeNode(node->nw->ne, node->ne->nw, node->nw->se, node->ne->sw));
+        const Node* n02 = firstStage(node->ne);
+        const Node* n10 = firstStage(makeNode(node->nw->sw, node->nw->se, node->sw->nw, node->sw->ne));
+        const Node* n11 = firstStage(centre(node));
+        const Node* n12 = firstStage(makeNode(node->ne->sw, node->ne->se, node->se->nw, node->se->ne));
+        const Node* n20 = firstStage(node->sw);
+        const Node* n21 = firstStage(makeNode(node->sw->ne, node->se->nw, node->sw->se, node->se->sw));
+        const Node* n22 = firstStage(node->se);
+
+        result = makeNode(nextGeneration(makeNode(n00, n01, n10, n11)),
+                          nextGeneration(makeNode(n01, n02, n11, n12)),
+                          nextGeneration(makeNode(n10, n11, n20, n21)),
+                          nextGeneration(makeNode(n11, n12, n21, n22)));
+    }
+
+    node->next = result;
+    node->nextStepLog2 = stepLog2;
+    return result;
+}
+
+const HashLifeEngine::Node* HashLifeEngine::stepLevel2(const Node* node) {
+    // 4x4 cells in, the centre 2x2 one generation later out
+    auto cellAt = [node](int x, int y) -> int {
+        const Node* quadrant = y < 2 ? (x < 2 ? node->nw : node->ne) : (x < 2 ? node->sw : node->se);
+        const Node* leaf = (y & 1) == 0 ? ((x & 1) == 0 ? quadrant->nw : quadrant->ne)
+                                        : ((x & 1) == 0 ? quadrant->sw : quadrant->se);
+        return static_cast<int>(leaf->population);
+    };
+
+    auto nextCell = [&](int x, int y) -> const Node* {
+        int neighbors = 0;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (dx != 0 || dy != 0) {
+                    neighbors += cellAt(x + dx, y + dy);
+                }
+            }
+        }
+        bool alive = rule_.nextState(cellAt(x, y) != 0, static_cast<uint32_t>(neighbors));
+        return alive ? &aliveLeaf_ : &deadLeaf_;
+    };
+
+    return makeNode(nextCell(1, 1), nextCell(2, 1), nextCell(1, 2), nextCell(2, 2));
+}
+
+bool HashLifeEngine::patternIsCentred() const {
+    return root_->nw->population == root_->nw->se->se->population &&
+           root_->ne->population == root_->ne->sw->sw->population &&
+           root_->sw->population == root_->sw->ne->ne->population &&
+           root_->se->population == root_->se->nw->nw->population;
+}
+
+void HashLifeEngine::collectGarbage() {
+    FLECS_GOL_TRACE_SCOPE("HashLifeEngine::collectGarbage");
+    // Rebuild the store with only the nodes reachable from the root
+    std::deque<Node> previous;
+    previous.swap(nodes_);
+    canonical_.clear();
+    emptyNodes_.clear();
+
+    std::unordered_map<const Node*, const Node*> moved;
+    auto copy = [&](auto& self, const Node* node) -> const Node* {
+        if (node->level == 0) {
+            return node;
+        }
+        auto it = moved.find(node);
+        if (it != moved.end()) {
+            return it->second;
+        }
+        const Node* copied = makeNode(self(self, node->nw), self(self, node->ne),
+                                      self(self, node->sw), self(self, node->se));
+        moved.emplace(node, copied);
+        return copied;
+    };
+
+    root_ = copy(copy, root_);
+    if (advancing_ && changesBefore_ != nullptr) {
+        changesBefore_ = copy(copy, changesBefore_); // Still needed by the advance in progress
+        changesAfter_ = copy(copy, changesAfter_);
+    } else {
+        changesBefore_ = nullptr; // Replaced by the step about to run
+        changesAfter_ = nullptr;
+    }
+}
+
+bool HashLifeEngine::contains(int64_t x, int64_t y) const {
+    int64_t half = int64_t{1} << (root_->level - 1);
+    return x >= -half && x < half && y >= -half && y < half;
+}
+
+bool HashLifeEngine::getCell(int64_t x, int64_t y) const {
+    if (!contains(x, y)) {
+        return false;
+    }
+
+    int64_t half = int64_t{1} << (root_->level - 1);
+    x += half;
+    y += half;
+
+    const Node* node = root_;
+    while (node->level > 0 && node->population != 0) {
+        half = int64_t{1} << (node->level - 1);
+        bool east = x >= half;
+        bool south = y >= half;
+        node = south ? (east ? node->se : node->sw) : (east ? node->ne : node->nw);
+        x -= east ? half : 0;
+        y -= south ? half : 0;
+    }
+
+    return node->population != 0;
+}
+
+void HashLifeEngine::collectCells(const Node* node, int64_t x, int64_t y, int64_t minX, int64_t maxX,
+                                  int64_t minY, int64_t maxY, std::vector<Position>& out) const {
+    // Skip empty subtrees and subtrees outside the region
+    int64_t size = int64_t{1} << node->level;
+    if (node->population == 0 || x > maxX || y > maxY || x + size - 1 < minX || y + size - 1 < minY) {
+        return;
+    }
+
+    if (node->level == 0) {
+        out.emplace_back(static_cast<int32_t>(x), static_cast<int32_t>(y));
+        return;
+    }
+
+    int64_t half = size / 2;
+    collectCells(node->nw, x, y, minX, maxX, minY, maxY, out);
+    collectCells(node->ne, x + half, y, minX, maxX, minY, maxY, out);
+    collectCells(node->sw, x, y + half, minX, maxX, minY, maxY, out);
+    collectCells(node->se, x + half, y + half, minX, maxX, minY, maxY, out);
+}
+
+void HashLifeEngine::collectChanges(const Node* before, const Node* after, int64_t x, int64_t y,
+                                    std::vector<Position>& born, std::vector<Position>& died) const {
+    // Canonical nodes make unchanged subtrees the same pointer; skip those and
+    // subtrees outside the 32-bit plane
+    int64_t size = int64_t{1} << after->level;
+    if (before == after || x > std::numeric_limits<int32_t>::max() || y > std::numeric_limits<int32_t>::max() ||
+        x + size - 1 < std::numeric_limits<int32_t>::min() || y + size - 1 < std::numeric_limits<int32_t>::min()) {
+        return;
+    }
+
+    if (after->level == 0) {
+        Position pos(static_cast<int32_t>(x), static_cast<int32_t>(y));
+        if (after->population != 0) {
+            born.push_back(pos);
+        } else {
+            died.push_back(pos);
+        }
+        return;
+    }
+
+    int64_t half = size / 2;
+    collectChanges(before->nw, after->nw, x, y, born, died);
+    collectChanges(before->ne, after->ne, x + half, y, born, died);
+    collectChanges(before->sw, after->sw, x, y + half, born, died);
+    collectChanges(before->se, after->se, x + half, y + half, born, died);
+}
+
+} // namespace flecs_gol
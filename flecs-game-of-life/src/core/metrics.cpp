@@ -0,0 +1,268 @@
+#include <flecs_gol/metrics.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace flecs_gol {
+
+namespace {
+
+constexpr double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+void atomicMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+std::string escapeLabel(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string formatSeconds(uint64_t nanos) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.9g", static_cast<double>(nanos) / 1e9);
+    return text;
+}
+
+nlohmann::json histogramToJson(const LatencyHistogram& histogram) {
+    const uint64_t count = histogram.getCount();
+    return {
+        {"count", count},
+        {"mean_ns", count > 0 ? histogram.getSum() / count : 0},
+        {"p50_ns", histogram.getQuantile(0.5)},
+        {"p90_ns", histogram.getQuantile(0.9)},
+        {"p99_ns", histogram.getQuantile(0.99)},
+        {"p999_ns", histogram.getQuantile(0.999)},
+        {"max_ns", histogram.getMax()},
+    };
+}
+
+void writeSummary(std::ostream& out, const char* name, const char* help, std::span<const LabelledMetrics> simulations,
+                  LatencyHistogram SimulationMetrics::*histogram) {
+    out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << " summary\n";
+    for (const auto& [label, metrics] : simulations) {
+        const LatencyHistogram& values = metrics->*histogram;
+        const std::string simulation = "simulation=\"" + escapeLabel(label) + "\"";
+        for (double quantile : QUANTILES) {
+            out << name << '{' << simulation << ",quantile=\"" << quantile << "\"} "
+                << formatSeconds(values.getQuantile(quantile)) << '\n';
+        }
+        out << name << "_sum{" << simulation << "} " << formatSeconds(values.getSum()) << '\n';
+        out << name << "_count{" << simulation << "} " << values.getCount() << '\n';
+    }
+}
+
+void writeValues(std::ostream& out, const char* name, const char* type, const char* help,
+                 std::span<const LabelledMetrics> simulations, std::atomic<uint64_t> SimulationMetrics::*value) {
+    out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+    for (const auto& [label, metrics] : simulations) {
+        out << name << "{simulation=\"" << escapeLabel(label) << "\"} "
+            << (metrics->*value).load(std::memory_order_relaxed) << '\n';
+    }
+}
+
+} // namespace
+
+void LatencyHistogram::record(uint64_t nanos) noexcept {
+    counts_[bucketOf(nanos)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(nanos, std::memory_order_relaxed);
+    atomicMax(max_, nanos);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) noexcept {
+    record(static_cast<uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0)));
+}
+
+uint64_t LatencyHistogram::getQuantile(double quantile) const noexcept {
+    const uint64_t count = getCount();
+    if (count == 0) {
+        return 0;
+    }
+    const auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count))));
+
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        seen += counts_[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(bucket), getMax());
+        }
+    }
+    return getMax(); // Values recorded while counting
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (auto& bucket : counts_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+size_t LatencyHistogram::bucketOf(uint64_t value) noexcept {
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+    // The top SUB_BUCKET_BITS + 1 bits pick the bucket
+    const auto shift = static_cast<uint32_t>(std::bit_width(value)) - SUB_BUCKET_BITS - 1;
+    const uint64_t top = value >> shift; // In [SUB_BUCKETS, 2 * SUB_BUCKETS)
+    return (shift + 1) * SUB_BUCKETS + static_cast<size_t>(top - SUB_BUCKETS);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t bucket) noexcept {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    const auto shift = static_cast<uint32_t>(bucket / SUB_BUCKETS - 1);
+    const uint64_t top = bucket % SUB_BUCKETS + SUB_BUCKETS;
+    return ((top + 1) << shift) - 1; // Wraps to the maximum for the last bucket
+}
+
+nlohmann::json SimulationMetrics::toJson() const {
+    return {
+        {"step", histogramToJson(stepNanos)},
+        {"render", histogramToJson(renderNanos)},
+        {"query", histogramToJson(queryNanos)},
+        {"births", births.load(std::memory_order_relaxed)},
+        {"deaths", deaths.load(std::memory_order_relaxed)},
+        {"lock_waits", lockWaits.load(std::memory_order_relaxed)},
+        {"lock_wait_ns", lockWaitNanos.load(std::memory_order_relaxed)},
+        {"living_cells", livingCells.load(std::memory_order_relaxed)},
+    };
+}
+
+std::unique_lock<std::mutex> lockCounted(std::mutex& mutex, SimulationMetrics& metrics) {
+    std::unique_lock lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        const auto start = std::chrono::steady_clock::now();
+        lock.lock();
+        const auto waited = std::chrono::steady_clock::now() - start;
+        metrics.lockWaits.fetch_add(1, std::memory_order_relaxed);
+        metrics.lockWaitNanos.fetch_add(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count()),
+            std::memory_order_relaxed);
+    }
+    return lock;
+}
+
+uint64_t getResidentMemoryBytes() {
+#if defined(__linux__)
+    // Second field of statm: resident pages
+    std::ifstream statm("/proc/self/statm");
+    uint64_t totalPages = 0;
+    uint64_t residentPages = 0;
+    if (statm >> totalPages >> residentPages) {
+        return residentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+void writePrometheusMetrics(std::ostream& out, std::span<const LabelledMetrics> simulations) {
+    writeSummary(out, "gol_step_duration_seconds", "Time to step one generation.", simulations,
+                 &SimulationMetrics::stepNanos);
+    writeSummary(out, "gol_render_duration_seconds", "Time to draw one frame.", simulations,
+                 &SimulationMetrics::renderNanos);
+    writeSummary(out, "gol_query_duration_seconds", "Time to read the board for a view or client.", simulations,
+                 &SimulationMetrics::queryNanos);
+    writeValues(out, "gol_births_total", "counter", "Cells born.", simulations, &SimulationMetrics::births);
+    writeValues(out, "gol_deaths_total", "counter", "Cells died.", simulations, &SimulationMetrics::deaths);
+    writeValues(out, "gol_lock_waits_total", "counter", "Simulation lock acquisitions that had to wait.", simulations,
+                &SimulationMetrics::lockWaits);
+    out << "# HELP gol_lock_wait_seconds_total Time spent waiting for the simulation lock.\n"
+        << "# TYPE gol_lock_wait_seconds_total counter\n";
+    for (const auto& [label, metrics] : simulations) {
+        out << "gol_lock_wait_seconds_total{simulation=\"" << escapeLabel(label) << "\"} "
+            << formatSeconds(metrics->lockWaitNanos.load(std::memory_order_relaxed)) << '\n';
+    }
+    writeValues(out, "gol_living_cells", "gauge", "Cells alive now.", simulations, &SimulationMetrics::livingCells);
+    out << "# HELP process_resident_memory_bytes Resident memory size in bytes.\n"
+        << "# TYPE process_resident_memory_bytes gauge\n"
+        << "process_resident_memory_bytes " << getResidentMemoryBytes() << '\n';
+}
+
+nlohmann::json metricsToJson(std::span<const LabelledMetrics> simulations) {
+    nlohmann::json json;
+    json["process"]["resident_memory_bytes"] = getResidentMemoryBytes();
+    json["simulations"] = nlohmann::json::object();
+    for (const auto& [label, metrics] : simulations) {
+        json["simulations"][label] = metrics->toJson();
+    }
+    return json;
+}
+
+MetricsFileWriter::MetricsFileWriter(std::string path, std::chrono::milliseconds interval,
+                                     std::function<void(std::ostream&)> write)
+    : path_(std::move(path))
+    , interval_(interval)
+    , write_(std::move(write))
+    , thread_([this] { run(); }) {}
+
+MetricsFileWriter::~MetricsFileWriter() {
+    {
+        std::scoped_lock lock(mutex_);
+        stopping_ = true;
+    }
+    stopRequested_.notify_all();
+    thread_.join();
+    writeNow();
+}
+
+void MetricsFileWriter::writeNow() {
+    std::scoped_lock lock(writeMutex_);
+    const std::string temporary = path_ + ".tmp";
+    try {
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                throw std::runtime_error("Cannot open " + temporary);
+            }
+            write_(out);
+            if (!out) {
+                throw std::runtime_error("Failed writing " + temporary);
+            }
+        }
+        std::filesystem::rename(temporary, path_);
+    } catch (const std::exception& e) {
+        std::cerr << "Metrics not written: " << e.what() << "\n";
+    }
+}
+
+bool MetricsFileWriter::isPrometheusPath(const std::string& path) {
+    return std::filesystem::path(path).extension() == ".prom";
+}
+
+void MetricsFileWriter::run() {
+    std::unique_lock lock(mutex_);
+    while (!stopRequested_.wait_for(lock, interval_, [this] { return stopping_; })) {
+        lock.unlock();
+        writeNow();
+        lock.lock();
+    }
+}
+
+} // namespace flecs_gol
@@ -0,0 +1,295 @@
+#include <flecs_gol/partitioned_board.h>
+#include <flecs_gol/trace.h>
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace flecs_gol {
+
+namespace {
+
+constexpr int32_t SUMMARY_ROWS = static_cast<int32_t>(TiledGrid::TILE_SIZE); // Rows copied out per summary chunk
+
+SlabBounds checkedSlab(const GameConfig& config, const HaloTransport& transport, int32_t haloDepth) {
+    if (haloDepth < 1) {
+        throw std::invalid_argument("PartitionedBoard: halo depth must be at least 1");
+    }
+    const uint32_t ranks = transport.getRankCount();
+    if (ranks == 0 || transport.getRank() >= ranks || static_cast<int64_t>(ranks) > config.getGridHeight()) {
+        throw std::invalid_argument("PartitionedBoard: " + std::to_string(ranks) + " ranks for " +
+                                    std::to_string(config.getGridHeight()) + " rows");
+    }
+    const SlabBounds slab = slabBounds(config.getGridHeight(), ranks, transport.getRank());
+    if (ranks > 1 && slabBounds(config.getGridHeight(), ranks, ranks - 1).rows < haloDepth) {
+        throw std::invalid_argument("PartitionedBoard: slabs are thinner than the halo depth");
+    }
+    return slab;
+}
+
+// The neighbor's halo is needed across every slab edge except the grid's own bounded edges
+bool hasNeighborAbove(const GameConfig& config, const HaloTransport& transport) {
+    return transport.getRankCount() > 1 && (transport.getRank() > 0 || config.getWrapEdges());
+}
+
+bool hasNeighborBelow(const GameConfig& config, const HaloTransport& transport) {
+    return transport.getRankCount() > 1 && (transport.getRank() + 1 < transport.getRankCount() || config.getWrapEdges());
+}
+
+// The slab and its halos as a grid of their own: the columns of the global
+// one, rows from 0. It wraps with the global grid for the columns; its rows
+// wrapping from one halo into the other only touches rows gone stale.
+GameConfig localConfig(const GameConfig& config, int32_t rows) {
+    GameConfig local = config;
+    local.setGridBoundaries(config.getGridMinX(), config.getGridMaxX(), 0, rows - 1);
+    return local;
+}
+
+int32_t wrapInto(int32_t value, int32_t min, int32_t size) {
+    const int64_t offset = (static_cast<int64_t>(value) - min) % size;
+    return static_cast<int32_t>(min + (offset < 0 ? offset + size : offset));
+}
+
+} // namespace
+
+SlabBounds slabBounds(int32_t height, uint32_t ranks, uint32_t rank) {
+    const int64_t base = height / static_cast<int64_t>(ranks);
+    const int64_t extra = height % static_cast<int64_t>(ranks);
+    const int64_t first = base * rank + std::min<int64_t>(rank, extra);
+    return {static_cast<int32_t>(first), static_cast<int32_t>(base + (rank < extra ? 1 : 0))};
+}
+
+HaloMailbox::HaloMailbox(std::chrono::milliseconds timeout)
+    : timeout_(timeout) {}
+
+void HaloMailbox::deliver(HaloMessage message) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Key key{message.round, message.fromRank, message.downward};
+        messages_[key] = std::move(message);
+    }
+    arrived_.notify_all();
+}
+
+HaloMessage HaloMailbox::receive(uint32_t fromRank, bool downward, uint64_t round) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const Key key{round, fromRank, downward};
+    auto ready = [&] { return messages_.count(key) != 0; };
+    if (timeout_.count() == 0) {
+        arrived_.wait(lock, ready);
+    } else if (!arrived_.wait_for(lock, timeout_, ready)) {
+        throw std::runtime_error("No halo from rank " + std::to_string(fromRank) + " for round " +
+                                 std::to_string(round));
+    }
+    auto node = messages_.extract(key);
+    return std::move(node.mapped());
+}
+
+ReductionBarrier::ReductionBarrier(uint32_t ranks, std::chrono::milliseconds timeout)
+    : ranks_(ranks)
+    , timeout_(timeout) {}
+
+HaloReduction ReductionBarrier::contribute(uint64_t round, const HaloReduction& local) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Round& entry = rounds_[round];
+    entry.total.livingCells += local.livingCells;
+    entry.total.changed = entry.total.changed || local.changed;
+    if (++entry.arrived == ranks_) {
+        complete_.notify_all();
+    }
+
+    auto ready = [&] { return entry.arrived == ranks_; };
+    if (timeout_.count() == 0) {
+        complete_.wait(lock, ready);
+    } else if (!complete_.wait_for(lock, timeout_, ready)) {
+        throw std::runtime_error("Reduction round " + std::to_string(round) + " is missing ranks");
+    }
+
+    // map nodes stay put, so entry is still this round's; the last rank out removes it
+    const HaloReduction total = entry.total;
+    if (++entry.left == ranks_) {
+        rounds_.erase(round);
+    }
+    return total;
+}
+
+class InProcessHaloNetwork::Endpoint : public HaloTransport {
+public:
+    Endpoint(InProcessHaloNetwork& network, uint32_t rank)
+        : network_(network)
+        , rank_(rank) {}
+
+    uint32_t getRank() const override { return rank_; }
+    uint32_t getRankCount() const override { return static_cast<uint32_t>(network_.mailboxes_.size()); }
+
+    void send(uint32_t rank, HaloMessage message) override {
+        network_.mailboxes_.at(rank)->deliver(std::move(message));
+    }
+
+    HaloMessage receive(uint32_t fromRank, bool downward, uint64_t round) override {
+        return network_.mailboxes_[rank_]->receive(fromRank, downward, round);
+    }
+
+    HaloReduction allReduce(uint64_t round, const HaloReduction& local) override {
+        return network_.barrier_.contribute(round, local);
+    }
+
+private:
+    InProcessHaloNetwork& network_;
+    uint32_t rank_;
+};
+
+InProcessHaloNetwork::InProcessHaloNetwork(uint32_t ranks)
+    : barrier_(ranks) {
+    for (uint32_t rank = 0; rank < ranks; ++rank) {
+        mailboxes_.push_back(std::make_unique<HaloMailbox>());
+        endpoints_.push_back(std::make_unique<Endpoint>(*this, rank));
+    }
+}
+
+InProcessHaloNetwork::~InProcessHaloNetwork() = default;
+
+HaloTransport& InProcessHaloNetwork::getTransport(uint32_t rank) {
+    return *endpoints_.at(rank);
+}
+
+PartitionedBoard::PartitionedBoard(const GameConfig& config, HaloTransport& transport, int32_t haloDepth)
+    : config_(config)
+    , transport_(transport)
+    , slab_(checkedSlab(config, transport, haloDepth))
+    , haloDepth_(haloDepth)
+    , haloAbove_(hasNeighborAbove(config, transport) ? haloDepth : 0)
+    , haloBelow_(hasNeighborBelow(config, transport) ? haloDepth : 0)
+    , rankAbove_((transport.getRank() + transport.getRankCount() - 1) % transport.getRankCount())
+    , rankBelow_((transport.getRank() + 1) % transport.getRankCount())
+    , grid_(localConfig(config, haloAbove_ + slab_.rows + haloBelow_)) {}
+
+bool PartitionedBoard::toSlab(int32_t& x, int32_t& y) const {
+    if (config_.getWrapEdges()) {
+        x = wrapInto(x, config_.getGridMinX(), config_.getGridWidth());
+        y = wrapInto(y, config_.getGridMinY(), config_.getGridHeight());
+    }
+    const int64_t row = static_cast<int64_t>(y) - config_.getGridMinY() - slab_.firstRow;
+    if (x < config_.getGridMinX() || x > config_.getGridMaxX() || row < 0 || row >= slab_.rows) {
+        return false;
+    }
+    y = static_cast<int32_t>(row) + haloAbove_;
+    return true;
+}
+
+void PartitionedBoard::setCell(int32_t x, int32_t y, bool alive) {
+    if (toSlab(x, y)) {
+        grid_.setCell(x, y, alive);
+    }
+}
+
+void PartitionedBoard::createCells(std::span<const Position> cells) {
+    for (const auto& pos : cells) {
+        setCell(pos.x, pos.y, true);
+    }
+}
+
+bool PartitionedBoard::isCellAlive(int32_t x, int32_t y) const {
+    return toSlab(x, y) && grid_.isCellAlive(x, y);
+}
+
+void PartitionedBoard::exchangeHalos() {
+    const uint64_t round = round_++;
+    const uint32_t rank = transport_.getRank();
+    const auto depth = static_cast<uint32_t>(haloDepth_);
+    const size_t haloWords = static_cast<size_t>(depth) * grid_.getTilesX();
+
+    // Every send goes out before any receive, so no rank waits on one still waiting itself
+    if (haloAbove_ > 0) {
+        HaloMessage up{round, rank, false, {}};
+        grid_.copyRows(static_cast<uint32_t>(haloAbove_), depth, up.words);
+        transport_.send(rankAbove_, std::move(up));
+    }
+    if (haloBelow_ > 0) {
+        HaloMessage down{round, rank, true, {}};
+        grid_.copyRows(static_cast<uint32_t>(haloAbove_ + slab_.rows - haloDepth_), depth, down.words);
+        transport_.send(rankBelow_, std::move(down));
+    }
+
+    auto install = [&](const HaloMessage& message, int32_t firstRow) {
+        if (message.words.size() != haloWords) {
+            throw std::runtime_error("Halo from rank " + std::to_string(message.fromRank) + " has " +
+                                     std::to_string(message.words.size()) + " words, expected " +
+                                     std::to_string(haloWords));
+        }
+        grid_.setRows(static_cast<uint32_t>(firstRow), depth, message.words);
+    };
+    if (haloAbove_ > 0) {
+        install(transport_.receive(rankAbove_, true, round), 0);
+    }
+    if (haloBelow_ > 0) {
+        install(transport_.receive(rankBelow_, false, round), haloAbove_ + slab_.rows);
+    }
+}
+
+PartitionedBoard::SlabSummary PartitionedBoard::summarize() const {
+    // Each word mixed with its index, so moving cells changes the hash
+    SlabSummary summary;
+    uint64_t index = 0;
+    for (int32_t row = 0; row < slab_.rows; row += SUMMARY_ROWS) {
+        rows_.clear();
+        grid_.copyRows(static_cast<uint32_t>(haloAbove_ + row),
+                       static_cast<uint32_t>(std::min(SUMMARY_ROWS, slab_.rows - row)), rows_);
+        for (uint64_t word : rows_) {
+            summary.hash += mixCoordinateKey(word ^ (index++ * 0x9e3779b97f4a7c15ull));
+            summary.livingCells += static_cast<uint64_t>(std::popcount(word));
+        }
+    }
+    return summary;
+}
+
+PartitionStepResult PartitionedBoard::advance(uint64_t generations) {
+    FLECS_GOL_TRACE_SCOPE("PartitionedBoard::advance");
+    PartitionStepResult result;
+    SlabSummary before = summarize();
+    while (result.generations < generations) {
+        const auto block = static_cast<uint32_t>(
+            std::min<uint64_t>(generations - result.generations, static_cast<uint64_t>(haloDepth_)));
+        exchangeHalos();
+        grid_.step(block);
+        generation_ += block;
+        result.generations += block;
+
+        const SlabSummary after = summarize();
+        const HaloReduction total = transport_.allReduce(round_++, {after.livingCells, after.hash != before.hash});
+        before = after;
+        result.livingCells = total.livingCells;
+        result.changed = total.changed;
+        if (!total.changed) {
+            break;
+        }
+    }
+    return result;
+}
+
+uint32_t PartitionedBoard::getSlabCellCount() const {
+    return static_cast<uint32_t>(summarize().livingCells);
+}
+
+void PartitionedBoard::collectLiveCells(std::vector<Position>& out) const {
+    const size_t rowWords = grid_.getTilesX();
+    const int32_t top = config_.getGridMinY() + slab_.firstRow;
+    for (int32_t row = 0; row < slab_.rows; row += SUMMARY_ROWS) {
+        const int32_t rows = std::min(SUMMARY_ROWS, slab_.rows - row);
+        rows_.clear();
+        grid_.copyRows(static_cast<uint32_t>(haloAbove_ + row), static_cast<uint32_t>(rows), rows_);
+        for (size_t i = 0; i < rows_.size(); ++i) {
+            const int32_t y = top + row + static_cast<int32_t>(i / rowWords);
+            const int32_t baseX = config_.getGridMinX() + static_cast<int32_t>((i % rowWords) * 64);
+            for (uint64_t bits = rows_[i]; bits != 0; bits &= bits - 1) {
+                out.emplace_back(baseX + std::countr_zero(bits), y);
+            }
+        }
+    }
+}
+
+size_t PartitionedBoard::getMemoryUsage() const {
+    return grid_.getMemoryUsage() + rows_.capacity() * sizeof(uint64_t);
+}
+
+} // namespace flecs_gol
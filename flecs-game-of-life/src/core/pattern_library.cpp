@@ -0,0 +1,92 @@
+#include <flecs_gol/pattern_library.h>
+#include <flecs_gol/pattern_reader.h>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+
+namespace flecs_gol {
+
+const EmbeddedPattern* findEmbeddedPattern(std::string_view name) {
+    const auto patterns = embeddedPatterns();
+    auto it = std::find_if(patterns.begin(), patterns.end(),
+                           [name](const EmbeddedPattern& pattern) { return pattern.name == name; });
+    return it != patterns.end() ? &*it : nullptr;
+}
+
+std::vector<Position> readPatternFile(const std::string& path, const LifeRule& rule) {
+    const PatternFormat format = patternFormatFromPath(path);
+    std::ifstream file(path, format == PatternFormat::Json ? std::ios::in : std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open pattern file: " + path);
+    }
+
+    std::vector<Position> cells;
+    if (format == PatternFormat::Json) {
+        nlohmann::json patternJson;
+        file >> patternJson;
+        if (patternJson.contains("cells") && patternJson["cells"].is_array()) {
+            cells.reserve(patternJson["cells"].size());
+            for (const auto& cell : patternJson["cells"]) {
+                if (cell.contains("x") && cell.contains("y")) {
+                    cells.emplace_back(cell["x"].get<int32_t>(), cell["y"].get<int32_t>());
+                }
+            }
+        }
+        return cells;
+    }
+
+    // RLE and macrocell files are decoded run by run straight into a position list
+    auto addRun = [&cells](int32_t x, int32_t y, uint32_t length) {
+        for (uint32_t i = 0; i < length; ++i) {
+            cells.emplace_back(x + static_cast<int32_t>(i), y);
+        }
+    };
+    if (format == PatternFormat::Rle) {
+        readRlePattern(file, addRun, rule);
+    } else {
+        readMacrocellPattern(file, addRun, rule);
+    }
+    return cells;
+}
+
+PatternCache& PatternCache::instance() {
+    static PatternCache cache;
+    return cache;
+}
+
+std::shared_ptr<const std::vector<Position>> PatternCache::load(const std::string& path, const LifeRule& rule) {
+    std::error_code error;
+    const auto modified = std::filesystem::last_write_time(path, error);
+    const auto bytes = error ? 0 : std::filesystem::file_size(path, error);
+    if (error) {
+        throw std::runtime_error("Could not open pattern file: " + path);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(path);
+        if (it != entries_.end() && it->second.modified == modified && it->second.bytes == bytes &&
+            it->second.rule == rule) {
+            return it->second.cells;
+        }
+    }
+
+    // Two threads missing at once both parse; the later one's entry stands
+    auto cells = std::make_shared<const std::vector<Position>>(readPatternFile(path, rule));
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[path] = Entry{modified, bytes, rule, cells};
+    return cells;
+}
+
+void PatternCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+size_t PatternCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+} // namespace flecs_gol
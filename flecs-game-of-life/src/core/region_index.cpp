@@ -0,0 +1,220 @@
+#include <flecs_gol/region_index.h>
+#include <algorithm>
+#include <bit>
+
+namespace flecs_gol {
+
+static_assert(RegionIndex::CHUNK_SIZE == 64, "chunkOf() and the row words assume 64-cell chunks");
+
+RegionIndex::Pyramid::Pyramid(const Pyramid& other) {
+    *this = other;
+}
+
+RegionIndex::Pyramid& RegionIndex::Pyramid::operator=(const Pyramid& other) {
+    if (this == &other) {
+        return *this;
+    }
+    // The source may be a shared snapshot another thread is building
+    std::lock_guard<std::mutex> lock(other.mutex);
+    const bool current = other.built.load(std::memory_order_relaxed);
+    if (current) {
+        levels = other.levels;
+    }
+    built.store(current, std::memory_order_relaxed);
+    return *this;
+}
+
+bool RegionIndex::insert(const Position& pos) {
+    const Position chunkPos = chunkOf(pos);
+    auto it = chunkIndex_.find(chunkPos);
+
+    uint32_t slot = 0;
+    if (it != chunkIndex_.end()) {
+        slot = it->second;
+    } else {
+        if (freeChunks_.empty()) {
+            slot = static_cast<uint32_t>(chunks_.size());
+            chunks_.emplace_back();
+        } else {
+            slot = freeChunks_.back();
+            freeChunks_.pop_back();
+        }
+        chunks_[slot].origin = chunkPos;
+        chunks_[slot].rows.fill(0);
+        chunks_[slot].count = 0;
+        chunkIndex_.insert(chunkPos, slot);
+    }
+
+    Chunk& chunk = chunks_[slot];
+    uint64_t& row = chunk.rows[static_cast<size_t>(pos.y & 63)];
+    const uint64_t mask = uint64_t{1} << (pos.x & 63);
+    if ((row & mask) != 0) {
+        return false;
+    }
+
+    row |= mask;
+    chunk.count++;
+    size_++;
+    pyramid_.built.store(false, std::memory_order_relaxed);
+    return true;
+}
+
+bool RegionIndex::erase(const Position& pos) {
+    auto it = chunkIndex_.find(chunkOf(pos));
+    if (it == chunkIndex_.end()) {
+        return false;
+    }
+
+    Chunk& chunk = chunks_[it->second];
+    uint64_t& row = chunk.rows[static_cast<size_t>(pos.y & 63)];
+    const uint64_t mask = uint64_t{1} << (pos.x & 63);
+    if ((row & mask) == 0) {
+        return false;
+    }
+
+    row &= ~mask;
+    size_--;
+    pyramid_.built.store(false, std::memory_order_relaxed);
+    if (--chunk.count == 0) {
+        freeChunks_.push_back(it->second);
+        chunkIndex_.erase(it);
+    }
+    return true;
+}
+
+bool RegionIndex::contains(const Position& pos) const {
+    auto it = chunkIndex_.find(chunkOf(pos));
+    return it != chunkIndex_.end() &&
+           ((chunks_[it->second].rows[static_cast<size_t>(pos.y & 63)] >> (pos.x & 63)) & 1u) != 0;
+}
+
+void RegionIndex::clear() {
+    freeChunks_.clear();
+    for (uint32_t slot = 0; slot < chunks_.size(); ++slot) {
+        freeChunks_.push_back(slot);
+    }
+    chunkIndex_.clear();
+    pyramid_.built.store(false, std::memory_order_relaxed);
+    size_ = 0;
+}
+
+size_t RegionIndex::getMemoryUsage() const {
+    size_t bytes = chunks_.capacity() * sizeof(Chunk) + freeChunks_.capacity() * sizeof(uint32_t) +
+                   chunkIndex_.getMemoryUsage() + sizeof(*this);
+    for (const auto& level : pyramid_.levels) {
+        bytes += level.getMemoryUsage();
+    }
+    return bytes;
+}
+
+void RegionIndex::collectRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                                std::vector<Position>& out) const {
+    if (minX > maxX || minY > maxY || size_ == 0) {
+        return;
+    }
+
+    const Position first = chunkOf(Position(minX, minY));
+    const Position last = chunkOf(Position(maxX, maxY));
+    const uint64_t chunksInRegion = static_cast<uint64_t>(int64_t{last.x} - first.x + 1) *
+                                    static_cast<uint64_t>(int64_t{last.y} - first.y + 1);
+
+    // Large sparse regions: walking the occupied chunks is cheaper than probing every chunk
+    if (chunksInRegion > chunkIndex_.size()) {
+        for (const auto& [chunkPos, slot] : chunkIndex_) {
+            if (chunkPos.x >= first.x && chunkPos.x <= last.x && chunkPos.y >= first.y && chunkPos.y <= last.y) {
+                collectChunk(chunks_[slot], minX, maxX, minY, maxY, out);
+            }
+        }
+        return;
+    }
+
+    for (int64_t chunkY = first.y; chunkY <= last.y; ++chunkY) {
+        for (int64_t chunkX = first.x; chunkX <= last.x; ++chunkX) {
+            auto it = chunkIndex_.find(Position(static_cast<int32_t>(chunkX), static_cast<int32_t>(chunkY)));
+            if (it != chunkIndex_.end()) {
+                collectChunk(chunks_[it->second], minX, maxX, minY, maxY, out);
+            }
+        }
+    }
+}
+
+uint32_t RegionIndex::countBlock(uint32_t scaleLog2, int32_t blockX, int32_t blockY) const {
+    if (scaleLog2 > CHUNK_LOG2) {
+        if (scaleLog2 > MAX_SCALE_LOG2) {
+            return 0;
+        }
+        if (!pyramid_.built.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(pyramid_.mutex);
+            if (!pyramid_.built.load(std::memory_order_relaxed)) {
+                buildPyramid();
+                pyramid_.built.store(true, std::memory_order_release);
+            }
+        }
+        const auto& level = pyramid_.levels[scaleLog2 - CHUNK_LOG2 - 1];
+        auto it = level.find(Position(blockX, blockY));
+        return it != level.end() ? it->second : 0;
+    }
+
+    // Blocks up to a chunk wide are counted from its bits
+    const auto originX = static_cast<int32_t>(int64_t{blockX} << scaleLog2);
+    const auto originY = static_cast<int32_t>(int64_t{blockY} << scaleLog2);
+    auto it = chunkIndex_.find(chunkOf(Position(originX, originY)));
+    if (it == chunkIndex_.end()) {
+        return 0;
+    }
+    const Chunk& chunk = chunks_[it->second];
+    if (scaleLog2 == CHUNK_LOG2) {
+        return chunk.count;
+    }
+
+    const uint32_t side = 1u << scaleLog2;
+    const uint64_t mask = ((uint64_t{1} << side) - 1) << (originX & 63);
+    uint32_t count = 0;
+    for (uint32_t row = 0; row < side; ++row) {
+        count += static_cast<uint32_t>(std::popcount(chunk.rows[static_cast<size_t>((originY & 63) + row)] & mask));
+    }
+    return count;
+}
+
+void RegionIndex::buildPyramid() const {
+    // Each level sums the one below, so only the first pass visits every chunk
+    for (auto& level : pyramid_.levels) {
+        level.clear();
+    }
+    for (const auto& [chunkPos, slot] : chunkIndex_) {
+        pyramid_.levels[0][Position(chunkPos.x >> 1, chunkPos.y >> 1)] += chunks_[slot].count;
+    }
+    for (uint32_t level = 1; level < BLOCK_LEVELS; ++level) {
+        auto& above = pyramid_.levels[level];
+        for (const auto& [blockPos, count] : pyramid_.levels[level - 1]) {
+            above[Position(blockPos.x >> 1, blockPos.y >> 1)] += count;
+        }
+    }
+}
+
+void RegionIndex::collectChunk(const Chunk& chunk, int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                               std::vector<Position>& out) const {
+    // Clip the region to the chunk, in chunk-local coordinates
+    const int64_t baseX = int64_t{chunk.origin.x} * CHUNK_SIZE;
+    const int64_t baseY = int64_t{chunk.origin.y} * CHUNK_SIZE;
+    const int64_t colBegin = std::max<int64_t>(0, minX - baseX);
+    const int64_t colEnd = std::min<int64_t>(CHUNK_SIZE - 1, maxX - baseX);
+    const int64_t rowBegin = std::max<int64_t>(0, minY - baseY);
+    const int64_t rowEnd = std::min<int64_t>(CHUNK_SIZE - 1, maxY - baseY);
+
+    uint64_t mask = ~uint64_t{0} << colBegin;
+    if (colEnd < CHUNK_SIZE - 1) {
+        mask &= (uint64_t{1} << (colEnd + 1)) - 1;
+    }
+
+    for (int64_t row = rowBegin; row <= rowEnd; ++row) {
+        uint64_t bits = chunk.rows[static_cast<size_t>(row)] & mask;
+        while (bits != 0) {
+            auto bit = static_cast<int64_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+            out.emplace_back(static_cast<int32_t>(baseX + bit), static_cast<int32_t>(baseY + row));
+        }
+    }
+}
+
+} // namespace flecs_gol
@@ -1,23 +1,81 @@
 #include <flecs_gol/simulation_controller.h>
-#include <fstream>
+#include <flecs_gol/simulation_host.h>
+#include <flecs_gol/snapshot_file.h>
+#include <flecs_gol/pattern_library.h>
+#include <flecs_gol/trace.h>
 #include <thread>
 #include <algorithm>
+#include <exception>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <utility>
 
 namespace flecs_gol {
 
+namespace {
+
+std::chrono::nanoseconds frameTimeFor(uint32_t fps) {
+    return std::chrono::nanoseconds(1000000000 / std::max(fps, 1u));
+}
+
+// Times a cell query into metrics.queryNanos
+class QueryTimer {
+public:
+    explicit QueryTimer(SimulationMetrics& metrics)
+        : metrics_(metrics), start_(std::chrono::steady_clock::now()) {}
+    ~QueryTimer() { metrics_.queryNanos.record(std::chrono::steady_clock::now() - start_); }
+    
+    QueryTimer(const QueryTimer&) = delete;
+    QueryTimer& operator=(const QueryTimer&) = delete;
+
+private:
+    SimulationMetrics& metrics_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+size_t historyBudgetBytes(const GameConfig& config) {
+    return static_cast<size_t>(config.getHistoryBudgetMB()) << 20;
+}
+
+void notifyApplied(std::vector<std::promise<void>>& waiters) {
+    for (auto& waiter : waiters) {
+        waiter.set_value();
+    }
+}
+
+SnapshotInfo snapshotInfo(const GameConfig& config, uint32_t generation) {
+    SnapshotInfo info;
+    info.generation = generation;
+    info.gridMinX = config.getGridMinX();
+    info.gridMinY = config.getGridMinY();
+    info.gridWidth = static_cast<uint32_t>(config.getGridWidth());
+    info.gridHeight = static_cast<uint32_t>(config.getGridHeight());
+    info.wrapEdges = config.getWrapEdges();
+    return info;
+}
+
+} // namespace
+
 SimulationController::SimulationController(const GameConfig& config)
     : config_(config)
-    , targetFrameTime_(1000 / config.getTargetFPS())
-    , lastFrameTime_(std::chrono::high_resolution_clock::now())
-    , startTime_(lastFrameTime_) {
+    , targetFrameTime_(frameTimeFor(config.getTargetFPS()))
+    , lastFrameTime_(std::chrono::steady_clock::now())
+    , startTime_(lastFrameTime_)
+    , history_(historyBudgetBytes(config)) {
     
-    simulation_ = std::make_unique<GameOfLifeSimulation>(config_);
+    simulation_ = createLifeEngine(config_);
+    if (config_.getEnableProfiling()) {
+        Trace::setEnabled(true);
+    }
     
     // Initialize performance tracking
     stepTimes_.fill(0);
     
+    restartHistory();
     updateState();
+    publishSnapshot();
 }
 
 SimulationController::~SimulationController() {
@@ -38,42 +96,108 @@ void SimulationController::start() {
     }
 }
 
+void SimulationController::start(SimulationHost& host) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    
+    if (!currentState_.isRunning) {
+        currentState_.isRunning = true;
+        currentState_.isPaused = false;
+        shouldStop_ = false;
+        lastFrameTime_ = std::chrono::steady_clock::now();
+        
+        host_ = &host;
+        hostId_ = host.attach(*this);
+        notifyStateChange();
+    }
+}
+
 void SimulationController::pause() {
     std::lock_guard<std::mutex> lock(stateMutex_);
     
     if (currentState_.isRunning && !currentState_.isPaused) {
         currentState_.isPaused = true;
         notifyStateChange();
+        loopWake_.notify_all();
     }
 }
 
 void SimulationController::resume() {
-    std::lock_guard<std::mutex> lock(stateMutex_);
-    
-    if (currentState_.isRunning && currentState_.isPaused) {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        
+        if (!currentState_.isRunning || !currentState_.isPaused) {
+            return;
+        }
         currentState_.isPaused = false;
         notifyStateChange();
+        loopWake_.notify_all();
     }
+    wakeHost();
 }
 
 void SimulationController::stop() {
+    SimulationHost* host = nullptr;
     {
         std::lock_guard<std::mutex> lock(stateMutex_);
         shouldStop_ = true;
         currentState_.isRunning = false;
         currentState_.isPaused = false;
+        host = std::exchange(host_, nullptr);
+        loopWake_.notify_all();
     }
     
     if (simulationThread_.joinable()) {
         simulationThread_.join();
     }
+    if (host) {
+        host->detach(hostId_);  // Waits for a step in progress
+    }
+    
+    // Commands left queued are carried out here, so no future waits forever
+    while (true) {
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        if (requestedSteps_.empty()) {
+            break;
+        }
+        StepRequest request = std::move(requestedSteps_.front());
+        requestedSteps_.pop_front();
+        lock.unlock();
+        runStepRequest(request);
+    }
+    applyQueuedEdits();
     
     threadRunning_ = false;
     notifyStateChange();
 }
 
 void SimulationController::step() {
-    std::lock_guard<std::mutex> lock(simulationMutex_);
+    FLECS_GOL_TRACE_SCOPE("SimulationController::step");
+    auto lock = lockCounted(simulationMutex_, metrics_);
+    auto editWaiters = applyEdits();  // Queued edits go in before the generation
+    
+    // Past the entity limit the board stays as it is until it is edited or reset
+    if (exceedsEntityLimit(*simulation_)) {
+        updateState();
+        if (!editWaiters.empty()) {
+            publishSnapshot();
+        }
+        lock.unlock();
+        notifyApplied(editWaiters);
+        pause();
+        return;
+    }
+    
+    adaptEngine();
+    
+    // The detector must hold the pre-step live set for the births and deaths to apply
+    if (patternDetectionEnabled_ && cycleDetectorStale_) {
+        cycleDetector_.clear();
+        for (const auto& pos : simulation_->getLivePositions()) {
+            cycleDetector_.add(pos);
+        }
+        cycleDetector_.record(simulation_->getGeneration());
+        cycleDetectorStale_ = false;
+    }
     
     auto stepStart = std::chrono::high_resolution_clock::now();
     
@@ -83,10 +207,16 @@ void SimulationController::step() {
     auto stepTime = std::chrono::duration_cast<std::chrono::microseconds>(stepEnd - stepStart).count();
     
     // Update performance tracking
+    metrics_.stepNanos.record(stepEnd - stepStart);
+    metrics_.recordChanges(simulation_->getBornCells().size(), simulation_->getDiedCells().size());
+    metrics_.livingCells.store(simulation_->getCellCount(), std::memory_order_relaxed);
     stepTimes_[stepTimeIndex_] = stepTime;
     stepTimeIndex_ = (stepTimeIndex_ + 1) % PERFORMANCE_HISTORY_SIZE;
     
+    recordHistory(simulation_->getBornCells(), simulation_->getDiedCells());
     updateState();
+    publishStep(simulation_->getBornCells(), simulation_->getDiedCells(), editWaiters.empty());
+    checkpointIfDue();
     
     if (generationCallback_) {
         generationCallback_(currentState_.generation);
@@ -95,49 +225,173 @@ void SimulationController::step() {
     if (patternDetectionEnabled_) {
         detectPatterns();
     }
+    notifyApplied(editWaiters);
+}
+
+void SimulationController::step(uint32_t generations) {
+    if (generations <= 1) {
+        if (generations == 1) {
+            step();
+        }
+        return;
+    }
+    FLECS_GOL_TRACE_SCOPE("SimulationController::stepGenerations");
+    auto lock = lockCounted(simulationMutex_, metrics_);
+    auto editWaiters = applyEdits();
+    
+    if (exceedsEntityLimit(*simulation_)) {
+        updateState();
+        if (!editWaiters.empty()) {
+            publishSnapshot();
+        }
+        lock.unlock();
+        notifyApplied(editWaiters);
+        pause();
+        return;
+    }
+    
+    adaptEngine();
+    
+    // The engine's changes only cover its last step, so compare whole boards
+    auto before = simulation_->getLivePositions();
+    std::sort(before.begin(), before.end());
+    const uint32_t startGeneration = simulation_->getGeneration();
+    
+    auto stepStart = std::chrono::high_resolution_clock::now();
+    
+    const uint32_t taken = simulation_->advance(generations);
+    // A settled board stops advance() early; the generation still moves on
+    skipSettledSteps(*simulation_, startGeneration, taken, generations);
+    
+    auto stepEnd = std::chrono::high_resolution_clock::now();
+    auto stepTime = std::chrono::duration_cast<std::chrono::microseconds>(stepEnd - stepStart).count();
+    
+    auto after = simulation_->getLivePositions();
+    std::sort(after.begin(), after.end());
+    std::vector<Position> born;
+    std::vector<Position> died;
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(born));
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(died));
+    
+    // Recorded as one step of the mean time per generation
+    metrics_.stepNanos.record((stepEnd - stepStart) / generations);
+    metrics_.recordChanges(born.size(), died.size());
+    metrics_.livingCells.store(simulation_->getCellCount(), std::memory_order_relaxed);
+    stepTimes_[stepTimeIndex_] = static_cast<uint64_t>(stepTime) / generations;
+    stepTimeIndex_ = (stepTimeIndex_ + 1) % PERFORMANCE_HISTORY_SIZE;
+    
+    // The detector never saw the generations in between
+    resetCycleDetection();
+    
+    recordHistory(born, died);
+    updateState();
+    publishStep(born, died, editWaiters.empty());
+    checkpointIfDue();
+    
+    if (generationCallback_) {
+        generationCallback_(currentState_.generation);
+    }
+    notifyApplied(editWaiters);
 }
 
 void SimulationController::reset() {
-    std::lock_guard<std::mutex> lock(simulationMutex_);
+    auto lock = lockCounted(simulationMutex_, metrics_);
     
     simulation_->reset();
     
-    // Restore initial pattern if we have one
-    if (hasInitialPattern_) {
-        // Load cells from initial pattern
-        if (initialPattern_.contains("cells") && initialPattern_["cells"].is_array()) {
-            for (const auto& cell : initialPattern_["cells"]) {
-                if (cell.contains("x") && cell.contains("y")) {
-                    int32_t x = cell["x"];
-                    int32_t y = cell["y"];
-                    simulation_->createCell(x, y);
-                }
-            }
-        }
-    }
+    // Restore the cells of the last loaded pattern or snapshot
+    simulation_->createCells(initialCells_);
     
+    restartHistory();
+    lastCheckpointGeneration_ = simulation_->getGeneration();
     updateState();
+    publishSnapshot();
     
     // Reset performance tracking
     stepTimes_.fill(0);
     stepTimeIndex_ = 0;
-    generationHistory_.clear();
+    resetCycleDetection();
     detectedPatterns_.clear();
     
     notifyStateChange();
 }
 
-void SimulationController::loadPattern(const std::string& patternFile) {
-    try {
-        std::ifstream file(patternFile);
-        if (!file.is_open()) {
-            throw std::runtime_error("Could not open pattern file: " + patternFile);
+bool SimulationController::stepBack() {
+    {
+        auto lock = lockCounted(simulationMutex_, metrics_);
+        if (history_.getCurrentGeneration() == history_.getOldestGeneration()) {
+            return false;
+        }
+    }
+    pause();
+    
+    auto lock = lockCounted(simulationMutex_, metrics_);
+    const auto move = history_.stepBack();
+    if (!move) {
+        return false;
+    }
+    applyHistoryMove(*move);
+    return true;
+}
+
+uint32_t SimulationController::seek(uint32_t generation) {
+    pause();
+    
+    uint32_t remaining = 0;
+    {
+        auto lock = lockCounted(simulationMutex_, metrics_);
+        if (const auto move = history_.seek(generation)) {
+            applyHistoryMove(*move);
         }
         
-        nlohmann::json patternJson;
-        file >> patternJson;
-        
-        loadPatternFromJson(patternJson);
+        // Only past the newest step is there anything left to simulate
+        const uint32_t current = simulation_->getGeneration();
+        if (generation > current && !history_.isRewound()) {
+            remaining = generation - current;
+        }
+    }
+    step(remaining);
+    
+    auto lock = lockCounted(simulationMutex_, metrics_);
+    return simulation_->getGeneration();
+}
+
+void SimulationController::applyHistoryMove(const HistoryMove& move) {
+    // Called with simulationMutex_ held
+    std::vector<Position> born;
+    std::vector<Position> died;
+    if (move.fromEmpty) {
+        auto before = simulation_->getLivePositions();
+        std::sort(before.begin(), before.end());
+        std::set_difference(move.flips.begin(), move.flips.end(), before.begin(), before.end(),
+                            std::back_inserter(born));
+        std::set_difference(before.begin(), before.end(), move.flips.begin(), move.flips.end(),
+                            std::back_inserter(died));
+        simulation_->clear();
+        simulation_->createCells(move.flips);
+    } else {
+        for (const auto& pos : move.flips) {
+            if (simulation_->isCellAlive(pos.x, pos.y)) {
+                simulation_->destroyCell(pos.x, pos.y);
+                died.push_back(pos);
+            } else {
+                born.push_back(pos);
+            }
+        }
+        simulation_->createCells(born);
+    }
+    simulation_->setGeneration(move.generation);
+    
+    resetCycleDetection();
+    updateState();
+    publishSnapshot(born, died);
+    notifyStateChange();
+}
+
+void SimulationController::loadPattern(const std::string& patternFile) {
+    try {
+        // Parsed once per version of the file, process-wide; loading copies the cells
+        loadCells(*PatternCache::instance().load(patternFile, getConfig().getRule()));
     } catch (const std::exception& e) {
         std::cerr << "Error loading pattern: " << e.what() << std::endl;
         throw;
@@ -145,40 +399,217 @@ void SimulationController::loadPattern(const std::string& patternFile) {
 }
 
 void SimulationController::loadPatternFromJson(const nlohmann::json& patternJson) {
-    std::lock_guard<std::mutex> lock(simulationMutex_);
-    
-    // Store the initial pattern for reset functionality
-    initialPattern_ = patternJson;
-    hasInitialPattern_ = true;
-    
-    // Clear existing cells
-    simulation_->clear();
-    
-    // Load cells from pattern
+    std::vector<Position> cells;
     if (patternJson.contains("cells") && patternJson["cells"].is_array()) {
+        cells.reserve(patternJson["cells"].size());
         for (const auto& cell : patternJson["cells"]) {
             if (cell.contains("x") && cell.contains("y")) {
-                int32_t x = cell["x"];
-                int32_t y = cell["y"];
-                simulation_->createCell(x, y);
+                cells.emplace_back(cell["x"].get<int32_t>(), cell["y"].get<int32_t>());
             }
         }
     }
     
+    loadCells(std::move(cells));
+}
+
+void SimulationController::loadCells(std::vector<Position> cells) {
+    auto lock = lockCounted(simulationMutex_, metrics_);
+    
+    // Replace the existing cells, keeping the new ones for reset
+    simulation_->clear();
+    simulation_->createCells(cells);
+    initialCells_ = std::move(cells);
+    
+    restartHistory();
+    lastCheckpointGeneration_ = simulation_->getGeneration();
+    resetCycleDetection();
+    updateState();
+    publishSnapshot();
+    notifyStateChange();
+}
+
+void SimulationController::saveSnapshot(const std::string& path) const {
+    SnapshotInfo info;
+    std::vector<Position> cells;
+    {
+        auto lock = lockCounted(simulationMutex_, metrics_);
+        info = snapshotInfo(config_, simulation_->getGeneration());
+        cells = simulation_->getLivePositions();
+    }
+    
+    writeSnapshotFile(path, info, cells);
+}
+
+void SimulationController::loadSnapshot(const std::string& path) {
+    SnapshotReader reader(path);
+    const SnapshotInfo& info = reader.getInfo();
+    
+    const int64_t maxX = int64_t{info.gridMinX} + info.gridWidth - 1;
+    const int64_t maxY = int64_t{info.gridMinY} + info.gridHeight - 1;
+    if (info.gridWidth == 0 || info.gridHeight == 0 ||
+        maxX > std::numeric_limits<int32_t>::max() || maxY > std::numeric_limits<int32_t>::max() ||
+        info.generation > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Snapshot holds an unsupported grid: " + path);
+    }
+    
+    // Decode before touching the simulation so a corrupt file leaves it as it was
+    std::vector<Position> cells;
+    cells.reserve(static_cast<size_t>(std::min<uint64_t>(info.cellCount, uint64_t{1} << 24)));
+    reader.readRuns([&cells](int32_t x, int32_t y, uint32_t length) {
+        for (uint32_t i = 0; i < length; ++i) {
+            cells.emplace_back(x + static_cast<int32_t>(i), y);
+        }
+    });
+    
+    auto lock = lockCounted(simulationMutex_, metrics_);
+    
+    // The snapshot brings its own plane; the engine choice stays with this controller
+    {
+        std::lock_guard<std::mutex> stateLock(stateMutex_);
+        config_.setGridBoundaries(info.gridMinX, static_cast<int32_t>(maxX), info.gridMinY, static_cast<int32_t>(maxY));
+        config_.setWrapEdges(info.wrapEdges);
+    }
+    simulation_ = createLifeEngine(config_);
+    simulation_->createCells(cells);
+    simulation_->setGeneration(static_cast<uint32_t>(info.generation));
+    initialCells_ = std::move(cells);
+    
+    restartHistory();
+    lastCheckpointGeneration_ = simulation_->getGeneration();
+    resetCycleDetection();
+    detectedPatterns_.clear();
     updateState();
+    publishSnapshot();
     notifyStateChange();
 }
 
+void SimulationController::checkpoint(const std::string& path) {
+    auto lock = lockCounted(simulationMutex_, metrics_);
+    submitCheckpoint(path);
+}
+
+void SimulationController::waitForCheckpoints() {
+    checkpointWriter_.waitIdle();
+}
+
+void SimulationController::submitCheckpoint(const std::string& path) {
+    // Called with simulationMutex_ held, so the published grid is the board
+    // as it stands. Holding it keeps publishSnapshot() from refilling it.
+    std::shared_ptr<const GridSnapshot> frozen = publishedSnapshot_;
+    checkpointWriter_.submit(path, snapshotInfo(config_, frozen->generation), [frozen](std::vector<Position>& out) {
+        frozen->cells.collectRegion(std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max(),
+                                    std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max(), out);
+    });
+    lastCheckpointGeneration_ = frozen->generation;
+}
+
+void SimulationController::checkpointIfDue() {
+    // Called with simulationMutex_ held, after a step is published
+    const uint32_t interval = config_.getCheckpointInterval();
+    if (interval == 0 || config_.getCheckpointPath().empty()) {
+        return;
+    }
+    const uint32_t generation = simulation_->getGeneration();
+    if (generation / interval != lastCheckpointGeneration_ / interval) {
+        submitCheckpoint(config_.getCheckpointPath());
+    }
+}
+
 void SimulationController::setTargetFPS(uint32_t fps) {
+    {
+        auto simulationLock = lockCounted(simulationMutex_, metrics_);
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        config_.setTargetFPS(fps);
+        targetFrameTime_ = frameTimeFor(fps);
+        loopWake_.notify_all();
+    }
+    wakeHost();  // Brings a longer wait forward to the new frame rate
+}
+
+void SimulationController::setGenerationsPerFrame(uint32_t generations) {
+    auto simulationLock = lockCounted(simulationMutex_, metrics_);
     std::lock_guard<std::mutex> lock(stateMutex_);
-    
-    config_.setTargetFPS(fps);
-    targetFrameTime_ = std::chrono::milliseconds(1000 / fps);
+    config_.setGenerationsPerFrame(std::max(generations, 1u));
 }
 
-void SimulationController::setAutoStep(bool enabled) {
+void SimulationController::setFrameStepBudgetMs(uint32_t budgetMs) {
+    auto simulationLock = lockCounted(simulationMutex_, metrics_);
     std::lock_guard<std::mutex> lock(stateMutex_);
-    autoStep_ = enabled;
+    config_.setFrameStepBudgetMs(budgetMs);
+}
+
+void SimulationController::setAutoStep(bool enabled) {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        autoStep_ = enabled;
+        loopWake_.notify_all();
+    }
+    if (enabled) {
+        wakeHost();
+    }
+}
+
+void SimulationController::switchEngine(const GameConfig& config) {
+    setEngine(createLifeEngine(config));
+}
+
+void SimulationController::setEngine(std::unique_ptr<LifeEngine> engine) {
+    auto lock = lockCounted(simulationMutex_, metrics_);
+    const uint32_t cellCount = simulation_->getCellCount();
+    installEngine(std::move(engine));
+    history_.setByteBudget(historyBudgetBytes(config_));
+    if (simulation_->getCellCount() != cellCount) {
+        restartHistory();  // Cells outside the new grid are gone from every generation
+    }
+    
+    // Step times and the last step's changes belong to the old engine
+    stepTimes_.fill(0);
+    stepTimeIndex_ = 0;
+    resetCycleDetection();
+    updateState();
+    publishSnapshot();
+    notifyStateChange();
+}
+
+void SimulationController::installEngine(std::unique_ptr<LifeEngine> engine) {
+    // Called with simulationMutex_ held
+    auto cells = simulation_->getLivePositions();
+    engine->clear();
+    engine->createCells(cells);
+    engine->setGeneration(simulation_->getGeneration());
+    simulation_ = std::move(engine);
+    
+    {
+        std::lock_guard<std::mutex> stateLock(stateMutex_);
+        config_ = simulation_->getConfig();
+        targetFrameTime_ = frameTimeFor(config_.getTargetFPS());
+    }
+}
+
+void SimulationController::adaptEngine() {
+    // Called with simulationMutex_ held, before a step
+    const EngineType engine = config_.getEngineType();
+    if (!config_.getAdaptiveEngine() || (engine != EngineType::Sparse && engine != EngineType::Dense)) {
+        return;
+    }
+    
+    // Sparse steps cost per live cell, dense steps per grid cell
+    const double area = static_cast<double>(config_.getGridWidth()) * static_cast<double>(config_.getGridHeight());
+    const double density = static_cast<double>(simulation_->getCellCount()) / area;
+    EngineType target = engine;
+    if (engine == EngineType::Sparse && density >= config_.getDenseDensityThreshold()) {
+        target = EngineType::Dense;
+    } else if (engine == EngineType::Dense && density <= config_.getSparseDensityThreshold()) {
+        target = EngineType::Sparse;
+    }
+    if (target == engine) {
+        return;
+    }
+    
+    // Same grid, same cells, so the cycle history and step timings still hold
+    GameConfig next = config_;
+    next.setEngineType(target);
+    installEngine(createLifeEngine(next));
 }
 
 SimulationState SimulationController::getState() const {
@@ -186,37 +617,74 @@ SimulationState SimulationController::getState() const {
     return currentState_;
 }
 
+std::shared_ptr<const GridSnapshot> SimulationController::getSnapshot() const {
+    return snapshot_.load(std::memory_order_acquire);
+}
+
 std::vector<CellData> SimulationController::getCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY) const {
-    std::lock_guard<std::mutex> lock(simulationMutex_);
+    const QueryTimer timer(metrics_);
+    auto snapshot = getSnapshot();
     
     std::vector<CellData> cells;
-    auto entities = simulation_->getCellsInRegion(minX, maxX, minY, maxY);
+    std::vector<Position> positions;
+    snapshot->cells.collectRegion(minX, maxX, minY, maxY, positions);
+    cells.reserve(positions.size());
     
-    for (const auto& entity : entities) {
-        if (true) { const auto& pos = entity.get<Position>();
-            cells.emplace_back(pos.x, pos.y);
-        }
+    for (const auto& pos : positions) {
+        cells.emplace_back(pos.x, pos.y);
     }
     
     return cells;
 }
 
+void SimulationController::getPositionsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                                                std::vector<Position>& out) const {
+    const QueryTimer timer(metrics_);
+    auto snapshot = getSnapshot();
+    
+    out.clear();
+    snapshot->cells.collectRegion(minX, maxX, minY, maxY, out);
+}
+
 std::vector<CellData> SimulationController::getAllCells() const {
-    std::lock_guard<std::mutex> lock(simulationMutex_);
+    const QueryTimer timer(metrics_);
+    auto snapshot = getSnapshot();
     
     std::vector<CellData> cells;
-    auto entities = simulation_->getAllCells();
+    std::vector<Position> positions;
+    positions.reserve(snapshot->cells.size());
+    snapshot->cells.collectRegion(std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max(),
+                                  std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max(),
+                                  positions);
+    cells.reserve(positions.size());
     
-    for (const auto& entity : entities) {
-        if (true) { const auto& pos = entity.get<Position>();
-            cells.emplace_back(pos.x, pos.y);
-        }
+    for (const auto& pos : positions) {
+        cells.emplace_back(pos.x, pos.y);
     }
     
     return cells;
 }
 
-const GameConfig& SimulationController::getConfig() const {
+uint32_t SimulationController::getChangedCells(std::vector<CellData>& out) const {
+    auto snapshot = getSnapshot();
+    
+    out.clear();
+    out.reserve(snapshot->born.size() + snapshot->died.size());
+    
+    for (const auto& pos : snapshot->born) {
+        out.emplace_back(pos.x, pos.y).isNewBorn = true;
+    }
+    for (const auto& pos : snapshot->died) {
+        auto& cell = out.emplace_back(pos.x, pos.y);
+        cell.isAlive = false;
+        cell.isDying = true;
+    }
+    
+    return snapshot->generation;
+}
+
+GameConfig SimulationController::getConfig() const {
+    std::lock_guard<std::mutex> lock(stateMutex_);
     return config_;
 }
 
@@ -233,34 +701,102 @@ void SimulationController::setPatternDetectedCallback(PatternDetectedCallback ca
 }
 
 bool SimulationController::isValidPosition(int32_t x, int32_t y) const {
+    std::lock_guard<std::mutex> lock(stateMutex_);
     return config_.isPointInBounds(x, y);
 }
 
 void SimulationController::addCell(int32_t x, int32_t y) {
-    std::lock_guard<std::mutex> lock(simulationMutex_);
-    simulation_->createCell(x, y);
+    auto lock = lockCounted(simulationMutex_, metrics_);
+    if (!simulation_->isCellAlive(x, y)) {
+        simulation_->addCell(x, y);
+        if (simulation_->isCellAlive(x, y)) {  // Engines refuse cells outside their grid
+            const Position pos(x, y);
+            history_.recordEdit({&pos, 1});
+        }
+    }
+    resetCycleDetection();
     updateState();
+    publishSnapshot();
 }
 
 void SimulationController::removeCell(int32_t x, int32_t y) {
-    std::lock_guard<std::mutex> lock(simulationMutex_);
-    simulation_->destroyCell(x, y);
+    auto lock = lockCounted(simulationMutex_, metrics_);
+    if (simulation_->isCellAlive(x, y)) {
+        simulation_->destroyCell(x, y);
+        const Position pos(x, y);
+        history_.recordEdit({&pos, 1});
+    }
+    resetCycleDetection();
     updateState();
+    publishSnapshot();
 }
 
 void SimulationController::clearGrid() {
-    std::lock_guard<std::mutex> lock(simulationMutex_);
+    auto lock = lockCounted(simulationMutex_, metrics_);
+    history_.recordEdit(simulation_->getLivePositions());
     simulation_->clear();
+    resetCycleDetection();
     updateState();
+    publishSnapshot();
     notifyStateChange();
 }
 
+std::future<void> SimulationController::addCellAsync(int32_t x, int32_t y) {
+    const CellEdit edit{x, y, true};
+    return editCellsAsync({&edit, 1});
+}
+
+std::future<void> SimulationController::removeCellAsync(int32_t x, int32_t y) {
+    const CellEdit edit{x, y, false};
+    return editCellsAsync({&edit, 1});
+}
+
+std::future<void> SimulationController::editCellsAsync(std::span<const CellEdit> edits) {
+    std::promise<void> done;
+    auto future = done.get_future();
+    {
+        std::lock_guard<std::mutex> lock(editMutex_);
+        queuedEdits_.insert(queuedEdits_.end(), edits.begin(), edits.end());
+        editWaiters_.push_back(std::move(done));
+        editsQueued_.store(true, std::memory_order_relaxed);
+    }
+    dispatchEdits();
+    return future;
+}
+
+std::future<uint32_t> SimulationController::stepAsync(uint32_t generations) {
+    StepRequest request;
+    request.generations = generations;
+    auto future = request.done.get_future();
+    bool onHost = false;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (!shouldStop_ && (simulationThread_.joinable() || host_)) {
+            requestedSteps_.push_back(std::move(request));
+            loopWake_.notify_all();
+            if (!host_) {
+                return future;
+            }
+            onHost = true;
+        }
+    }
+    if (onHost) {
+        wakeHost();
+    } else {
+        runStepRequest(request);
+    }
+    return future;
+}
+
 void SimulationController::enablePatternDetection(bool enabled) {
-    std::lock_guard<std::mutex> lock(stateMutex_);
-    patternDetectionEnabled_ = enabled;
+    std::lock_guard<std::mutex> lock(simulationMutex_);
+    {
+        std::lock_guard<std::mutex> stateLock(stateMutex_);
+        patternDetectionEnabled_ = enabled;
+    }
+    resetCycleDetection();
     
     if (!enabled) {
-        generationHistory_.clear();
         detectedPatterns_.clear();
     }
 }
@@ -270,44 +806,269 @@ bool SimulationController::isPatternDetectionEnabled() const {
     return patternDetectionEnabled_;
 }
 
+void SimulationController::requestStep() {
+    stepAsync(1);  // Its future is ready or abandoned; neither blocks
+}
+
 void SimulationController::simulationLoop() {
+    // Frames fall due at fixed steps of targetFrameTime_ from a steady
+    // deadline, so wake-up latency does not add up into a lower frame rate.
+    // A step that overruns runs the late frame at once but drops any further
+    // frames it covered rather than stepping in a burst to catch up.
+    using Clock = std::chrono::steady_clock;
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    auto due = Clock::now();
+    auto lastFrame = Clock::time_point{};  // None since the run (re)started
+    
     while (!shouldStop_) {
-        auto frameStart = std::chrono::high_resolution_clock::now();
-        
-        {
-            std::lock_guard<std::mutex> lock(stateMutex_);
+        if (requestedSteps_.empty()) {
             if (currentState_.isPaused || !autoStep_) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                // No step is coming to take queued edits along, so apply them now
+                if (editsQueued_.load(std::memory_order_relaxed)) {
+                    lock.unlock();
+                    applyQueuedEdits();
+                    lock.lock();
+                    continue;
+                }
+                loopWake_.wait(lock, [this] {
+                    return shouldStop_ || !requestedSteps_.empty() || editsQueued_.load(std::memory_order_relaxed) ||
+                           (!currentState_.isPaused && autoStep_);
+                });
+                due = Clock::now();
+                lastFrame = Clock::time_point{};
+                continue;
+            }
+            if (Clock::now() < due) {
+                loopWake_.wait_until(lock, due);  // Commands wake it early
                 continue;
             }
         }
         
-        // Perform simulation step
-        step();
-        
-        // Frame rate limiting
-        auto frameEnd = std::chrono::high_resolution_clock::now();
-        auto frameDuration = std::chrono::duration_cast<std::chrono::milliseconds>(frameEnd - frameStart);
-        
-        if (frameDuration < targetFrameTime_) {
-            std::this_thread::sleep_for(targetFrameTime_ - frameDuration);
+        std::optional<StepRequest> request;
+        if (!requestedSteps_.empty()) {
+            request = std::move(requestedSteps_.front());
+            requestedSteps_.pop_front();
         }
+        const bool requested = request.has_value();
+        lock.unlock();
+        if (requested) {
+            runStepRequest(*request);
+        } else {
+            stepFrame();
+        }
+        const auto now = Clock::now();
+        lock.lock();
         
-        // Update FPS calculation
-        auto actualFrameDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::high_resolution_clock::now() - frameStart);
-        
-        if (actualFrameDuration.count() > 0) {
+        // Requested steps run outside the frame schedule
+        if (requested) {
+            continue;
+        }
+        if (lastFrame != Clock::time_point{}) {
+            currentState_.actualFPS = 1e9 / static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastFrame).count());
+        }
+        lastFrame = now;
+        due += targetFrameTime_;
+        if (due <= now) {
+            const auto missed = (now - due) / targetFrameTime_;
+            currentState_.skippedFrames += static_cast<uint64_t>(missed);
+            due += missed * targetFrameTime_;
+        }
+    }
+}
+
+bool SimulationController::hostedStep(std::chrono::nanoseconds& interval) {
+    // Called by the host; stands in for one pass of simulationLoop(). Queued
+    // commands go first, and are all it does while paused.
+    bool idle = false;
+    while (true) {
+        std::optional<StepRequest> request;
+        {
             std::lock_guard<std::mutex> lock(stateMutex_);
-            currentState_.actualFPS = 1000.0 / actualFrameDuration.count();
+            if (shouldStop_) {
+                return false;
+            }
+            idle = currentState_.isPaused || !autoStep_;
+            if (requestedSteps_.empty()) {
+                break;
+            }
+            request = std::move(requestedSteps_.front());
+            requestedSteps_.pop_front();
         }
+        runStepRequest(*request);
+    }
+    if (idle) {
+        applyQueuedEdits();
+        return false;
+    }
+    
+    stepFrame();
+    
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    auto frameDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastFrameTime_);
+    if (frameDuration.count() > 0) {
+        currentState_.actualFPS = 1e9 / static_cast<double>(frameDuration.count());
     }
+    lastFrameTime_ = now;
+    interval = targetFrameTime_;
+    return true;
+}
+
+void SimulationController::stepFrame() {
+    // Batches of generationsPerFrame go through step(n). Under a budget the
+    // frame takes another while the last one would still fit in what is left,
+    // stopping early for a pause, a stop or a requested step.
+    using Clock = std::chrono::steady_clock;
+    uint32_t batch = 1;
+    std::chrono::nanoseconds budget{0};
+    uint32_t startGeneration = 0;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        batch = std::max(config_.getGenerationsPerFrame(), 1u);
+        budget = std::chrono::milliseconds(config_.getFrameStepBudgetMs());
+        startGeneration = currentState_.generation;
+    }
+    
+    const auto frameStart = Clock::now();
+    auto batchStart = frameStart;
+    while (true) {
+        step(batch);
+        const auto now = Clock::now();
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (budget.count() == 0 || (now - frameStart) + (now - batchStart) > budget || shouldStop_ ||
+            currentState_.isPaused || currentState_.entityLimitReached || !requestedSteps_.empty()) {
+            currentState_.frameGenerations = currentState_.generation - startGeneration;
+            return;
+        }
+        batchStart = now;
+    }
+}
+
+void SimulationController::wakeHost() {
+    // The host is called without stateMutex_ held; it calls back into hostedStep()
+    SimulationHost* host = nullptr;
+    uint64_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        host = host_;
+        id = hostId_;
+    }
+    if (host) {
+        host->wake(id);
+    }
+}
+
+void SimulationController::runStepRequest(StepRequest& request) {
+    try {
+        step(request.generations);
+    } catch (...) {
+        request.done.set_exception(std::current_exception());
+        throw;
+    }
+    request.done.set_value(getState().generation);
+}
+
+void SimulationController::dispatchEdits() {
+    // A running simulation takes queued edits along with its next step; an
+    // idle one is woken for them, and without either they go in here
+    bool onHost = false;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (!shouldStop_ && (simulationThread_.joinable() || host_)) {
+            if (!currentState_.isPaused && autoStep_) {
+                return;
+            }
+            loopWake_.notify_all();
+            if (!host_) {
+                return;
+            }
+            onHost = true;
+        }
+    }
+    if (onHost) {
+        wakeHost();
+    } else {
+        applyQueuedEdits();
+    }
+}
+
+void SimulationController::applyQueuedEdits() {
+    std::vector<std::promise<void>> waiters;
+    {
+        auto lock = lockCounted(simulationMutex_, metrics_);
+        waiters = applyEdits();
+        if (waiters.empty()) {
+            return;
+        }
+        updateState();
+        publishSnapshot();
+    }
+    notifyApplied(waiters);
+}
+
+std::vector<std::promise<void>> SimulationController::applyEdits() {
+    std::vector<std::promise<void>> waiters;
+    {
+        std::lock_guard<std::mutex> lock(editMutex_);
+        if (!editsQueued_.load(std::memory_order_relaxed)) {
+            return waiters;
+        }
+        applyingEdits_.swap(queuedEdits_);
+        waiters.swap(editWaiters_);
+        editsQueued_.store(false, std::memory_order_relaxed);
+    }
+    
+    editFlips_.clear();
+    for (const CellEdit& edit : applyingEdits_) {
+        if (simulation_->isCellAlive(edit.x, edit.y) == edit.alive) {
+            continue;
+        }
+        if (edit.alive) {
+            simulation_->addCell(edit.x, edit.y);
+            if (!simulation_->isCellAlive(edit.x, edit.y)) {  // Engines refuse cells outside their grid
+                continue;
+            }
+        } else {
+            simulation_->destroyCell(edit.x, edit.y);
+        }
+        editFlips_.emplace_back(edit.x, edit.y);
+    }
+    applyingEdits_.clear();
+    
+    // A cell flipped twice in one batch ends where it started
+    std::sort(editFlips_.begin(), editFlips_.end());
+    size_t kept = 0;
+    for (size_t i = 0; i < editFlips_.size();) {
+        size_t run = i + 1;
+        while (run < editFlips_.size() && editFlips_[run] == editFlips_[i]) {
+            ++run;
+        }
+        if ((run - i) % 2 == 1) {
+            editFlips_[kept++] = editFlips_[i];
+        }
+        i = run;
+    }
+    editFlips_.resize(kept);
+    history_.recordEdit(editFlips_);
+    
+    resetCycleDetection();
+    return waiters;
 }
 
 void SimulationController::updateState() {
-    currentState_.generation = simulation_->getGeneration();
-    currentState_.liveCellCount = simulation_->getCellCount();
-    currentState_.memoryUsage = simulation_->getMemoryUsage();
+    // Called with simulationMutex_ held. currentState_ is also read under
+    // stateMutex_ alone, so it is written under both, stateMutex_ taken second.
+    const uint32_t generation = simulation_->getGeneration();
+    const uint32_t liveCellCount = simulation_->getCellCount();
+    const size_t memoryUsage = simulation_->getMemoryUsage();
+    const bool entityLimitReached = exceedsEntityLimit(*simulation_);
+    
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    currentState_.generation = generation;
+    currentState_.liveCellCount = liveCellCount;
+    currentState_.memoryUsage = memoryUsage;
+    currentState_.entityLimitReached = entityLimitReached;
     
     // Calculate average step time
     uint64_t totalTime = 0;
@@ -329,55 +1090,141 @@ void SimulationController::updateState() {
     }
 }
 
+void SimulationController::publishSnapshot() {
+    publishSnapshot(simulation_->getBornCells(), simulation_->getDiedCells());
+}
+
+void SimulationController::publishSnapshot(const std::vector<Position>& born, const std::vector<Position>& died) {
+    // Called with simulationMutex_ held
+    std::shared_ptr<GridSnapshot> next = takeSpareSnapshot();
+    next->generation = simulation_->getGeneration();
+    simulation_->copyLiveCells(next->cells);
+    next->born = born;
+    next->died = died;
+    
+    spareFollows_ = false;
+    swapInSnapshot(std::move(next));
+}
+
+void SimulationController::publishStep(const std::vector<Position>& born, const std::vector<Position>& died,
+                                       bool fromPublished) {
+    // Called with simulationMutex_ held. fromPublished says the step started
+    // from the published board, so born and died lead from it to this one.
+    // When the spare is also one step behind that, catching it up by two
+    // steps' changes is far cheaper than copying every live cell.
+    const bool catchUp = fromPublished && spareFollows_ && spareSnapshot_ && spareSnapshot_.use_count() == 1;
+    std::shared_ptr<GridSnapshot> next = takeSpareSnapshot();
+    if (catchUp) {
+        for (const auto& pos : publishedSnapshot_->died) {
+            next->cells.erase(pos);
+        }
+        for (const auto& pos : publishedSnapshot_->born) {
+            next->cells.insert(pos);
+        }
+        for (const auto& pos : died) {
+            next->cells.erase(pos);
+        }
+        for (const auto& pos : born) {
+            next->cells.insert(pos);
+        }
+    } else {
+        simulation_->copyLiveCells(next->cells);
+    }
+    next->generation = simulation_->getGeneration();
+    next->born = born;
+    next->died = died;
+    
+    spareFollows_ = fromPublished;
+    swapInSnapshot(std::move(next));
+}
+
+std::shared_ptr<GridSnapshot> SimulationController::takeSpareSnapshot() {
+    // Once a snapshot has been replaced no reader can pick it up again, so a
+    // use count of one means it is ours
+    if (spareSnapshot_ && spareSnapshot_.use_count() == 1) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return std::move(spareSnapshot_);
+    }
+    return std::make_shared<GridSnapshot>();
+}
+
+void SimulationController::swapInSnapshot(std::shared_ptr<GridSnapshot> next) {
+    spareSnapshot_ = std::move(publishedSnapshot_);
+    publishedSnapshot_ = next;
+    snapshot_.store(std::move(next), std::memory_order_release);
+}
+
 void SimulationController::notifyStateChange() {
     if (stateChangeCallback_) {
         stateChangeCallback_(currentState_);
     }
 }
 
+void SimulationController::restartHistory() {
+    // Called with simulationMutex_ held
+    history_.restart(simulation_->getGeneration(), simulation_->getLivePositions());
+}
+
+void SimulationController::recordHistory(std::span<const Position> born, std::span<const Position> died) {
+    history_.recordStep(simulation_->getGeneration(), born, died);
+    if (history_.keyframeDue()) {
+        history_.recordKeyframe(simulation_->getLivePositions());
+    }
+}
+
+void SimulationController::resetCycleDetection() {
+    // Called with simulationMutex_ held, as for updateState()
+    cycleDetectorStale_ = true;
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    currentState_.cyclePeriod = 0;
+    currentState_.cycleDx = 0;
+    currentState_.cycleDy = 0;
+}
+
 void SimulationController::detectPatterns() {
-    // Simple pattern detection based on cell count periodicity
-    generationHistory_.push_back(currentState_.liveCellCount);
-    
-    // Keep only recent history
-    constexpr size_t MAX_HISTORY = 200;
-    if (generationHistory_.size() > MAX_HISTORY) {
-        generationHistory_.erase(generationHistory_.begin());
-    }
-    
-    // Look for periodic patterns
-    if (generationHistory_.size() > 20) {
-        for (uint32_t period = 1; period <= 50 && period < generationHistory_.size() / 2; ++period) {
-            bool isPeriodic = true;
-            size_t checkLength = std::min(static_cast<size_t>(period * 3), generationHistory_.size() - period);
-            
-            for (size_t i = 0; i < checkLength; ++i) {
-                if (generationHistory_[generationHistory_.size() - 1 - i] != 
-                    generationHistory_[generationHistory_.size() - 1 - i - period]) {
-                    isPeriodic = false;
-                    break;
-                }
-            }
-            
-            if (isPeriodic) {
-                std::string patternKey = "period_" + std::to_string(period);
-                if (detectedPatterns_.find(patternKey) == detectedPatterns_.end()) {
-                    detectedPatterns_[patternKey] = currentState_.generation;
-                    
-                    if (patternDetectedCallback_) {
-                        std::string patternName;
-                        switch (period) {
-                            case 1: patternName = "Still Life"; break;
-                            case 2: patternName = "Blinker"; break;
-                            case 3: patternName = "Period-3 Oscillator"; break;
-                            default: patternName = "Period-" + std::to_string(period) + " Oscillator"; break;
-                        }
-                        patternDetectedCallback_(patternName, period);
-                    }
-                }
-                break;
+    for (const auto& pos : simulation_->getBornCells()) {
+        cycleDetector_.add(pos);
+    }
+    for (const auto& pos : simulation_->getDiedCells()) {
+        cycleDetector_.remove(pos);
+    }
+    
+    auto cycle = cycleDetector_.record(currentState_.generation);
+    if (!cycle) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        currentState_.cyclePeriod = cycle->period;
+        currentState_.cycleDx = cycle->dx;
+        currentState_.cycleDy = cycle->dy;
+    }
+    
+    bool moving = cycle->dx != 0 || cycle->dy != 0;
+    std::string patternKey = "period_" + std::to_string(cycle->period);
+    if (moving) {
+        patternKey += "_" + std::to_string(cycle->dx) + "_" + std::to_string(cycle->dy);
+    }
+    
+    if (detectedPatterns_.find(patternKey) != detectedPatterns_.end()) {
+        return;
+    }
+    detectedPatterns_[patternKey] = currentState_.generation;
+    
+    if (patternDetectedCallback_) {
+        std::string patternName;
+        if (moving) {
+            patternName = "Period-" + std::to_string(cycle->period) + " Spaceship";
+        } else {
+            switch (cycle->period) {
+                case 1: patternName = "Still Life"; break;
+                case 2: patternName = "Blinker"; break;
+                case 3: patternName = "Period-3 Oscillator"; break;
+                default: patternName = "Period-" + std::to_string(cycle->period) + " Oscillator"; break;
             }
         }
+        patternDetectedCallback_(patternName, cycle->period);
     }
 }
 
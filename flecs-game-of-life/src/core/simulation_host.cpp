@@ -0,0 +1,185 @@
+#include <flecs_gol/simulation_host.h>
+#include <flecs_gol/simulation_controller.h>
+#include <flecs_gol/trace.h>
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace flecs_gol {
+
+SimulationHost::SimulationHost(uint32_t threads)
+    : pool_(threads) {
+    scheduler_ = std::thread(&SimulationHost::schedulerLoop, this);
+}
+
+SimulationHost::~SimulationHost() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    queueChanged_.notify_all();
+
+    if (scheduler_.joinable()) {
+        scheduler_.join();
+    }
+
+    // Pool tasks still finishing touch mutex_ and stepFinished_
+    std::unique_lock<std::mutex> lock(mutex_);
+    stepFinished_.wait(lock, [this] { return inFlight_ == 0; });
+}
+
+size_t SimulationHost::getSimulationCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_.size();
+}
+
+size_t SimulationHost::getScheduledCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(std::count_if(slots_.begin(), slots_.end(),
+        [](const auto& entry) { return entry.second.scheduled; }));
+}
+
+size_t SimulationHost::getFailedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(std::count_if(slots_.begin(), slots_.end(),
+        [](const auto& entry) { return entry.second.failed; }));
+}
+
+uint64_t SimulationHost::getStepCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return steps_;
+}
+
+uint64_t SimulationHost::attach(SimulationController& controller) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t id = nextId_++;
+    Slot& slot = slots_[id];
+    slot.controller = &controller;
+    schedule(id, slot, Clock::now());
+    return id;
+}
+
+void SimulationHost::detach(uint64_t id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stepFinished_.wait(lock, [this, id] {
+        auto it = slots_.find(id);
+        return it == slots_.end() || !it->second.stepping;
+    });
+    // Its queue entry, if any, is skipped once it comes due
+    slots_.erase(id);
+}
+
+void SimulationHost::wake(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = slots_.find(id);
+    if (it == slots_.end()) {
+        return;
+    }
+
+    Slot& slot = it->second;
+    const auto now = Clock::now();
+    if (slot.failed) {
+        return;
+    }
+    if (slot.stepping) {
+        slot.wakeRequested = true; // Rescheduled once its step returns
+    } else if (!slot.scheduled || now < slot.due) {
+        schedule(id, slot, now);
+    }
+}
+
+void SimulationHost::schedule(uint64_t id, Slot& slot, Clock::time_point due) {
+    // Called with mutex_ held. An earlier entry for the slot stays in the queue
+    // and is told apart by its due time.
+    slot.scheduled = true;
+    slot.due = due;
+    queue_.push({due, id});
+    queueChanged_.notify_one();
+}
+
+void SimulationHost::schedulerLoop() {
+    FLECS_GOL_TRACE_THREAD_NAME("simulation scheduler");
+    struct Task {
+        uint64_t id;
+        SimulationController* controller;
+        Clock::time_point due;
+    };
+    std::vector<Task> due;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (queue_.empty()) {
+            queueChanged_.wait(lock);
+            continue;
+        }
+        const auto next = queue_.top().due;
+        if (Clock::now() < next) {
+            queueChanged_.wait_until(lock, next);
+            continue;
+        }
+
+        // Everything due now, most overdue first
+        due.clear();
+        const auto now = Clock::now();
+        while (!queue_.empty() && queue_.top().due <= now) {
+            const Due entry = queue_.top();
+            queue_.pop();
+
+            auto it = slots_.find(entry.id);
+            if (it == slots_.end() || !it->second.scheduled || it->second.due != entry.due) {
+                continue; // Detached or rescheduled
+            }
+            Slot& slot = it->second;
+            slot.scheduled = false;
+            slot.stepping = true;
+            slot.wakeRequested = false;
+            ++inFlight_;
+            due.push_back({entry.id, slot.controller, entry.due});
+        }
+        if (due.empty()) {
+            continue;
+        }
+
+        // Each step is a pool task of its own and nothing waits for it, so a
+        // slow one holds up no other simulation
+        lock.unlock();
+        for (const Task& task : due) {
+            pool_.submit([this, task] { runStep(task.id, task.controller, task.due); });
+        }
+        lock.lock();
+    }
+}
+
+void SimulationHost::runStep(uint64_t id, SimulationController* controller, Clock::time_point due) {
+    // Controllers take their own locks while stepping, so none of ours is held.
+    // A stepping slot cannot be detached, which keeps the controller alive.
+    std::chrono::nanoseconds interval{0};
+    bool stepped = false;
+    bool failed = false;
+    try {
+        stepped = controller->hostedStep(interval);
+    } catch (const std::exception& e) {
+        std::cerr << "Hosted simulation " << id << " stopped stepping: " << e.what() << std::endl;
+        failed = true;
+    }
+    const auto finished = Clock::now();
+
+    // Notified under the lock: once inFlight_ drops the host may be destroyed
+    std::lock_guard<std::mutex> lock(mutex_);
+    Slot& slot = slots_.at(id);
+    slot.stepping = false;
+    if (failed) {
+        slot.failed = true;
+    } else if (stepped) {
+        ++steps_;
+        // Keep to the frame rate, but never bank frames a slow step missed
+        schedule(id, slot, std::max<Clock::time_point>(due + interval, finished));
+    } else if (slot.wakeRequested) {
+        schedule(id, slot, finished);
+    }
+    // Otherwise paused, stopped or not auto-stepping: idle until woken
+    --inFlight_;
+    stepFinished_.notify_all();
+}
+
+} // namespace flecs_gol
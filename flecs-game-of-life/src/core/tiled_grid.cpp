@@ -0,0 +1,597 @@
+#include <flecs_gol/tiled_grid.h>
+#include <flecs_gol/topology.h>
+#include <flecs_gol/trace.h>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+namespace flecs_gol {
+
+namespace {
+
+WorkerPlacement workerPlacement(const GameConfig& config) {
+    WorkerPlacement placement;
+    if (config.getNumaPlacement()) {
+        placement.topology = NumaTopology::detect().limitedTo(config.getNumaNodeLimit());
+    }
+    placement.pinThreads = config.getPinWorkerThreads();
+    return placement;
+}
+
+} // namespace
+
+TiledGrid::TiledGrid(const GameConfig& config)
+    : originX_(config.getGridMinX())
+    , originY_(config.getGridMinY())
+    , width_(static_cast<uint32_t>(config.getGridWidth()))
+    , height_(static_cast<uint32_t>(config.getGridHeight()))
+    , tilesX_((width_ + TILE_SIZE - 1) / TILE_SIZE)
+    , tilesY_((height_ + TILE_SIZE - 1) / TILE_SIZE)
+    , lastWordMask_((width_ & 63) != 0 ? ~uint64_t{0} >> (64 - (width_ & 63)) : ~uint64_t{0})
+    , wrapEdges_(config.getWrapEdges())
+    , kernel_(selectDenseKernel())
+    , rule_(config.getRule())
+    , conwayRule_(rule_ == CONWAY_RULE)
+    , pool_(config.getWorkerThreads(), workerPlacement(config)) {
+
+    size_t tiles = static_cast<size_t>(tilesX_) * tilesY_;
+    placeTiles(cells_);
+    placeTiles(next_);
+    changed_.assign(tiles, 0);
+    active_.assign(tiles, 0);
+    tileCounts_.assign(tiles, 0);
+}
+
+bool TiledGrid::setCell(int32_t x, int32_t y, bool alive) {
+    if (x < originX_ || y < originY_) {
+        return false;
+    }
+
+    auto col = static_cast<uint32_t>(x - originX_);
+    auto row = static_cast<uint32_t>(y - originY_);
+    if (col >= width_ || row >= height_) {
+        return false;
+    }
+
+    size_t index = tileIndex(col / TILE_SIZE, row / TILE_SIZE);
+    uint64_t& word = cells_[index][row % TILE_SIZE];
+    uint64_t mask = uint64_t{1} << (col % TILE_SIZE);
+    bool wasAlive = (word & mask) != 0;
+
+    if (alive != wasAlive) {
+        word ^= mask;
+        changed_[index] = 1; // Wakes the tile and its neighbors for the next step
+
+        // Keep the per-tile count in step with the edit in case the tile is skipped
+        tileCounts_[index] = alive ? tileCounts_[index] + 1 : tileCounts_[index] - 1;
+        population_ = alive ? population_ + 1 : population_ - 1;
+    }
+    return true;
+}
+
+bool TiledGrid::isCellAlive(int32_t x, int32_t y) const {
+    if (x < originX_ || y < originY_) {
+        return false;
+    }
+
+    auto col = static_cast<uint32_t>(x - originX_);
+    auto row = static_cast<uint32_t>(y - originY_);
+    return col < width_ && row < height_ && getBit(col, row);
+}
+
+void TiledGrid::copyRows(uint32_t row, uint32_t rows, std::vector<uint64_t>& out) const {
+    out.reserve(out.size() + static_cast<size_t>(rows) * tilesX_);
+    for (uint32_t y = row; y < row + rows; ++y) {
+        for (uint32_t word = 0; word < tilesX_; ++word) {
+            out.push_back(cells_[tileIndex(word, y / TILE_SIZE)][y % TILE_SIZE]);
+        }
+    }
+}
+
+void TiledGrid::setRows(uint32_t row, uint32_t rows, std::span<const uint64_t> words) {
+    size_t next = 0;
+    for (uint32_t y = row; y < row + rows; ++y) {
+        for (uint32_t word = 0; word < tilesX_; ++word) {
+            size_t index = tileIndex(word, y / TILE_SIZE);
+            uint64_t& cell = cells_[index][y % TILE_SIZE];
+            uint64_t value = words[next++] & (word + 1 == tilesX_ ? lastWordMask_ : ~uint64_t{0});
+            if (value != cell) {
+                changed_[index] = 1;
+                auto before = static_cast<uint32_t>(std::popcount(cell));
+                auto after = static_cast<uint32_t>(std::popcount(value));
+                tileCounts_[index] = tileCounts_[index] - before + after;
+                population_ = population_ - before + after;
+                cell = value;
+            }
+        }
+    }
+}
+
+uint8_t TiledGrid::getNeighborCount(int32_t x, int32_t y) const {
+    return countNeighbors(static_cast<int64_t>(x) - originX_, static_cast<int64_t>(y) - originY_);
+}
+
+void TiledGrid::step() {
+    FLECS_GOL_TRACE_SCOPE("TiledGrid::step");
+    collectActiveTiles();
+
+    // Stable tiles keep their dirty flag cleared; active ones set their own
+    for (size_t index = 0; index < changed_.size(); ++index) {
+        if (active_[index] == 0) {
+            changed_[index] = 0;
+        }
+    }
+
+    // Each active tile starts with the worker that owns its memory
+    pool_.parallelFor(
+        activeTiles_.size(), [this](size_t i) { stepTile(activeTiles_[i]); },
+        [this](size_t i) { return pool_.getOwner(activeTiles_[i], cells_.size()); });
+
+    // Halo words beyond the first and last column read as zero; redo those with wrapping
+    if (wrapEdges_) {
+        patchWrappedColumn(0);
+        if (width_ > 1) {
+            patchWrappedColumn(width_ - 1);
+        }
+    }
+
+    cells_.swap(next_);
+    recountPopulation();
+}
+
+void TiledGrid::step(uint32_t generations) {
+    FLECS_GOL_TRACE_SCOPE("TiledGrid::stepGenerations");
+    if (generations <= 1) {
+        if (generations == 1) {
+            step();
+        }
+        return;
+    }
+
+    // Blocking needs whole words across a wrapped edge; other wrapped widths
+    // rely on the bit-by-bit column patch of step()
+    const bool blocked = !wrapEdges_ || width_ % TILE_SIZE == 0;
+    const bool severalPasses = !blocked || generations > BLOCK_GENERATIONS;
+    if (severalPasses) {
+        if (passStart_.size() != cells_.size()) {
+            placeTiles(passStart_);
+        }
+        std::copy(cells_.begin(), cells_.end(), passStart_.begin());
+    }
+
+    for (uint32_t done = 0; done < generations;) {
+        if (!blocked) {
+            step();
+            ++done;
+            continue;
+        }
+        const uint32_t pass = std::min(generations - done, BLOCK_GENERATIONS);
+        collectActiveTiles();
+        for (size_t index = 0; index < changed_.size(); ++index) {
+            if (active_[index] == 0) {
+                changed_[index] = 0;
+            }
+        }
+
+        // A row of tiles goes to the owner of its first tile
+        pool_.parallelFor(
+            tilesY_,
+            [this, pass](size_t tileY) {
+                const auto row = active_.begin() + static_cast<std::ptrdiff_t>(tileY * tilesX_);
+                if (std::find(row, row + tilesX_, uint8_t{1}) != row + tilesX_) {
+                    stepTileRow(static_cast<uint32_t>(tileY), pass);
+                }
+            },
+            [this](size_t tileY) { return pool_.getOwner(tileY * tilesX_, cells_.size()); });
+        cells_.swap(next_);
+        recountPopulation();
+        done += pass;
+    }
+    if (!severalPasses) {
+        return;
+    }
+
+    // The spare buffer goes back to the board before the first pass, so the
+    // changes span every generation; a tile stays dirty if it changed in the last one
+    next_.swap(passStart_);
+    for (size_t index = 0; index < cells_.size(); ++index) {
+        changed_[index] = changed_[index] != 0 || cells_[index] != next_[index] ? 1 : 0;
+    }
+}
+
+void TiledGrid::clear() {
+    std::fill(cells_.begin(), cells_.end(), Tile{});
+    std::fill(next_.begin(), next_.end(), Tile{});
+    std::fill(changed_.begin(), changed_.end(), uint8_t{0});
+    std::fill(tileCounts_.begin(), tileCounts_.end(), uint32_t{0});
+    population_ = 0;
+}
+
+size_t TiledGrid::getMemoryUsage() const {
+    return (cells_.capacity() + next_.capacity() + passStart_.capacity()) * sizeof(Tile) + changed_.capacity() + active_.capacity() +
+           activeTiles_.capacity() * sizeof(size_t) + tileCounts_.capacity() * sizeof(uint32_t) + sizeof(*this);
+}
+
+bool TiledGrid::getActiveBounds(int32_t& minX, int32_t& maxX, int32_t& minY, int32_t& maxY) const {
+    uint32_t minTileX = tilesX_;
+    uint32_t maxTileX = 0;
+    uint32_t minTileY = tilesY_;
+    uint32_t maxTileY = 0;
+
+    for (uint32_t tileY = 0; tileY < tilesY_; ++tileY) {
+        for (uint32_t tileX = 0; tileX < tilesX_; ++tileX) {
+            if (changed_[tileIndex(tileX, tileY)] != 0) {
+                minTileX = std::min(minTileX, tileX);
+                maxTileX = std::max(maxTileX, tileX);
+                minTileY = std::min(minTileY, tileY);
+                maxTileY = std::max(maxTileY, tileY);
+            }
+        }
+    }
+
+    if (minTileX > maxTileX) {
+        return false;
+    }
+
+    // Tile bounds, clipped to the grid
+    minX = originX_ + static_cast<int32_t>(minTileX * TILE_SIZE);
+    maxX = originX_ + static_cast<int32_t>(std::min((maxTileX + 1) * TILE_SIZE, width_) - 1);
+    minY = originY_ + static_cast<int32_t>(minTileY * TILE_SIZE);
+    maxY = originY_ + static_cast<int32_t>(std::min((maxTileY + 1) * TILE_SIZE, height_) - 1);
+    return true;
+}
+
+void TiledGrid::collectChanges(std::vector<Position>& born, std::vector<Position>& died) const {
+    // Only dirty tiles can differ from the previous generation held in the spare buffer
+    for (size_t index = 0; index < cells_.size(); ++index) {
+        if (changed_[index] == 0) {
+            continue;
+        }
+
+        const auto tileX = static_cast<int64_t>(index % tilesX_);
+        const auto firstRow = static_cast<int64_t>(index / tilesX_) * TILE_SIZE;
+        for (size_t r = 0; r < TILE_SIZE; ++r) {
+            uint64_t bits = cells_[index][r] ^ next_[index][r];
+            while (bits != 0) {
+                auto bit = static_cast<int64_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                Position pos(static_cast<int32_t>(originX_ + tileX * TILE_SIZE + bit),
+                             static_cast<int32_t>(originY_ + firstRow + static_cast<int64_t>(r)));
+                if ((cells_[index][r] >> bit) & 1u) {
+                    born.push_back(pos);
+                } else {
+                    died.push_back(pos);
+                }
+            }
+        }
+    }
+}
+
+void TiledGrid::collectLiveCells(std::vector<Position>& out) const {
+    collectCellsInRegion(originX_, originX_ + static_cast<int32_t>(width_) - 1,
+                         originY_, originY_ + static_cast<int32_t>(height_) - 1, out);
+}
+
+void TiledGrid::collectCellsInRegion(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY,
+                                     std::vector<Position>& out) const {
+    // Clip the region to the grid
+    int64_t colBegin = std::max<int64_t>(0, static_cast<int64_t>(minX) - originX_);
+    int64_t colEnd = std::min<int64_t>(width_, static_cast<int64_t>(maxX) - originX_ + 1);
+    int64_t rowBegin = std::max<int64_t>(0, static_cast<int64_t>(minY) - originY_);
+    int64_t rowEnd = std::min<int64_t>(height_, static_cast<int64_t>(maxY) - originY_ + 1);
+
+    if (colBegin >= colEnd || rowBegin >= rowEnd) {
+        return;
+    }
+
+    for (int64_t row = rowBegin; row < rowEnd; ++row) {
+        for (int64_t word = colBegin / TILE_SIZE; word <= (colEnd - 1) / TILE_SIZE; ++word) {
+            uint64_t bits = haloWord(word, row);
+
+            // Mask off columns outside the region
+            int64_t first = std::max<int64_t>(colBegin - word * TILE_SIZE, 0);
+            int64_t last = std::min<int64_t>(colEnd - word * TILE_SIZE, TILE_SIZE);
+            bits &= ~uint64_t{0} << first;
+            if (last < TILE_SIZE) {
+                bits &= (uint64_t{1} << last) - 1;
+            }
+
+            while (bits != 0) {
+                auto bit = static_cast<int64_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                out.emplace_back(static_cast<int32_t>(originX_ + word * TILE_SIZE + bit),
+                                 static_cast<int32_t>(originY_ + row));
+            }
+        }
+    }
+}
+
+uint64_t TiledGrid::haloWord(int64_t word, int64_t row) const {
+    if (row < 0 || row >= height_) {
+        if (!wrapEdges_) {
+            return 0;
+        }
+        row = ((row % height_) + height_) % height_;
+    }
+    if (word < 0 || word >= tilesX_) {
+        return 0;
+    }
+
+    return cells_[tileIndex(static_cast<uint32_t>(word), static_cast<uint32_t>(row / TILE_SIZE))]
+                 [static_cast<size_t>(row % TILE_SIZE)];
+}
+
+bool TiledGrid::getBit(uint32_t col, uint32_t row) const {
+    return (cells_[tileIndex(col / TILE_SIZE, row / TILE_SIZE)][row % TILE_SIZE] >> (col % TILE_SIZE)) & 1u;
+}
+
+uint8_t TiledGrid::countNeighbors(int64_t centerCol, int64_t centerRow) const {
+    uint8_t count = 0;
+
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) {
+                continue;
+            }
+
+            int64_t col = centerCol + dx;
+            int64_t row = centerRow + dy;
+
+            if (wrapEdges_) {
+                col = ((col % width_) + width_) % width_;
+                row = ((row % height_) + height_) % height_;
+            } else if (col < 0 || row < 0 || col >= width_ || row >= height_) {
+                continue;
+            }
+
+            if (getBit(static_cast<uint32_t>(col), static_cast<uint32_t>(row))) {
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+void TiledGrid::collectActiveTiles() {
+    std::fill(active_.begin(), active_.end(), uint8_t{0});
+
+    for (uint32_t tileY = 0; tileY < tilesY_; ++tileY) {
+        for (uint32_t tileX = 0; tileX < tilesX_; ++tileX) {
+            if (changed_[tileIndex(tileX, tileY)] == 0) {
+                continue;
+            }
+
+            // A dirty tile wakes its 3x3 neighborhood, across the seams when wrapping
+            for (int64_t dy = -1; dy <= 1; ++dy) {
+                for (int64_t dx = -1; dx <= 1; ++dx) {
+                    int64_t x = static_cast<int64_t>(tileX) + dx;
+                    int64_t y = static_cast<int64_t>(tileY) + dy;
+
+                    if (wrapEdges_) {
+                        x = (x + tilesX_) % tilesX_;
+                        y = (y + tilesY_) % tilesY_;
+                    } else if (x < 0 || y < 0 || x >= tilesX_ || y >= tilesY_) {
+                        continue;
+                    }
+
+                    active_[tileIndex(static_cast<uint32_t>(x), static_cast<uint32_t>(y))] = 1;
+                }
+            }
+        }
+    }
+
+    activeTiles_.clear();
+    for (size_t index = 0; index < active_.size(); ++index) {
+        if (active_[index] != 0) {
+            activeTiles_.push_back(index);
+        }
+    }
+}
+
+void TiledGrid::stepTile(size_t index) {
+    FLECS_GOL_TRACE_SCOPE("TiledGrid::stepTile");
+    const auto tileX = static_cast<int64_t>(index % tilesX_);
+    const auto firstRow = static_cast<int64_t>(index / tilesX_) * TILE_SIZE;
+
+    // Halo exchange: this tile's rows plus one row above and below, each with
+    // the bordering words of the left and right neighbors as kernel guard words.
+    // Rows past the bottom of the grid wrap like any other neighbor row.
+    uint64_t halo[TILE_SIZE + 2][3];
+    for (int64_t r = -1; r <= static_cast<int64_t>(TILE_SIZE); ++r) {
+        auto& haloRow = halo[r + 1];
+        haloRow[0] = haloWord(tileX - 1, firstRow + r);
+        haloRow[1] = haloWord(tileX, firstRow + r);
+        haloRow[2] = haloWord(tileX + 1, firstRow + r);
+    }
+
+    const uint64_t mask = tileX == tilesX_ - 1 ? lastWordMask_ : ~uint64_t{0};
+    Tile& out = next_[index];
+    uint32_t count = 0;
+
+    for (size_t r = 0; r < TILE_SIZE; ++r) {
+        if (firstRow + static_cast<int64_t>(r) >= height_) {
+            out[r] = 0; // Padding rows of the last tile row
+            continue;
+        }
+        if (conwayRule_) {
+            kernel_.stepRow(&halo[r][1], &halo[r + 1][1], &halo[r + 2][1], &out[r], 1);
+        } else {
+            kernel_.stepRowRule(&halo[r][1], &halo[r + 1][1], &halo[r + 2][1], &out[r], 1, rule_);
+        }
+        out[r] &= mask;
+        count += static_cast<uint32_t>(std::popcount(out[r]));
+    }
+
+    changed_[index] = out != cells_[index] ? 1 : 0;
+    tileCounts_[index] = count;
+}
+
+void TiledGrid::stepTileRow(uint32_t tileY, uint32_t generations) {
+    FLECS_GOL_TRACE_SCOPE("TiledGrid::stepTileRow");
+    static_assert(BLOCK_GENERATIONS <= TILE_SIZE, "A block must not reach past the neighboring tiles");
+    const int64_t firstRow = static_cast<int64_t>(tileY) * TILE_SIZE;
+    const int64_t halo = generations;
+    const size_t rows = TILE_SIZE + 2 * generations;
+    const size_t words = tilesX_;
+    const size_t stride = words + 2; // A guard word on either side
+
+    // Per worker thread, so a warmed-up pass allocates nothing. Two
+    // generations of a 4096-cell-wide row of tiles take about 80 KB.
+    thread_local std::vector<uint64_t> buffers;
+    buffers.resize(2 * rows * stride);
+    uint64_t* current = buffers.data();
+    uint64_t* next = current + rows * stride;
+
+    // Row i of the buffer is board row firstRow - halo + i; rows outside the
+    // grid wrap or stay dead like every other halo row
+    auto rowAt = [stride](uint64_t* buffer, size_t i) { return buffer + i * stride; };
+    auto outside = [&](size_t i) {
+        const int64_t row = firstRow - halo + static_cast<int64_t>(i);
+        return !wrapEdges_ && (row < 0 || row >= height_);
+    };
+    auto setGuards = [&](uint64_t* row) {
+        // Wrapped grids are a whole number of words wide here
+        row[0] = wrapEdges_ ? row[words] : 0;
+        row[words + 1] = wrapEdges_ ? row[1] : 0;
+    };
+
+    for (size_t i = 0; i < rows; ++i) {
+        uint64_t* row = rowAt(current, i);
+        for (size_t word = 0; word < words; ++word) {
+            row[word + 1] = haloWord(static_cast<int64_t>(word), firstRow - halo + static_cast<int64_t>(i));
+        }
+        setGuards(row);
+    }
+
+    // Generation g is exact on rows [g, rows - g)
+    for (size_t g = 1; g <= generations; ++g) {
+        for (size_t i = g; i < rows - g; ++i) {
+            uint64_t* out = rowAt(next, i);
+            if (outside(i)) {
+                std::fill(out, out + stride, uint64_t{0});
+                continue;
+            }
+            const uint64_t* above = rowAt(current, i - 1) + 1;
+            const uint64_t* row = rowAt(current, i) + 1;
+            const uint64_t* below = rowAt(current, i + 1) + 1;
+            if (conwayRule_) {
+                kernel_.stepRow(above, row, below, out + 1, words);
+            } else {
+                kernel_.stepRowRule(above, row, below, out + 1, words, rule_);
+            }
+            out[words] &= lastWordMask_;
+            setGuards(out);
+        }
+        std::swap(current, next);
+    }
+
+    // Inactive tiles are unchanged, and the spare buffer already holds them
+    for (uint32_t tileX = 0; tileX < tilesX_; ++tileX) {
+        const size_t index = tileIndex(tileX, tileY);
+        if (active_[index] == 0) {
+            continue;
+        }
+
+        Tile& out = next_[index];
+        uint32_t count = 0;
+        bool lastChanged = false;
+        for (size_t r = 0; r < TILE_SIZE; ++r) {
+            if (firstRow + static_cast<int64_t>(r) >= height_) {
+                out[r] = 0; // Padding rows of the last tile row
+                continue;
+            }
+            // The other buffer still holds the generation before the last
+            const size_t i = static_cast<size_t>(halo) + r;
+            out[r] = rowAt(current, i)[tileX + 1];
+            lastChanged = lastChanged || out[r] != rowAt(next, i)[tileX + 1];
+            count += static_cast<uint32_t>(std::popcount(out[r]));
+        }
+
+        // Dirty if the block moved it, or it was still changing at the end,
+        // which the activity check for the next step needs
+        changed_[index] = lastChanged || out != cells_[index] ? 1 : 0;
+        tileCounts_[index] = count;
+    }
+}
+
+void TiledGrid::patchWrappedColumn(uint32_t col) {
+    const TorusTopology torus{0, static_cast<int32_t>(width_) - 1, 0, static_cast<int32_t>(height_) - 1};
+    const uint64_t mask = uint64_t{1} << (col % TILE_SIZE);
+    const uint32_t tileX = col / TILE_SIZE;
+
+    for (uint32_t row = 0; row < height_; ++row) {
+        size_t index = tileIndex(tileX, row / TILE_SIZE);
+        if (active_[index] == 0) {
+            continue; // Stable neighborhood: the column cannot change either
+        }
+
+        uint32_t count = 0;
+        forEachNeighbor(torus, Position(static_cast<int32_t>(col), static_cast<int32_t>(row)), [&](const Position& n) {
+            count += getBit(static_cast<uint32_t>(n.x), static_cast<uint32_t>(n.y)) ? 1u : 0u;
+        });
+        bool alive = getBit(col, row);
+        uint64_t& word = next_[index][row % TILE_SIZE];
+        bool wasAlive = (word & mask) != 0;
+        bool nowAlive = rule_.nextState(alive, count);
+
+        if (nowAlive != wasAlive) {
+            word ^= mask;
+            tileCounts_[index] = nowAlive ? tileCounts_[index] + 1 : tileCounts_[index] - 1;
+        }
+    }
+
+    for (uint32_t tileY = 0; tileY < tilesY_; ++tileY) {
+        size_t index = tileIndex(tileX, tileY);
+        if (active_[index] != 0) {
+            changed_[index] = next_[index] != cells_[index] ? 1 : 0;
+        }
+    }
+}
+
+void TiledGrid::recountPopulation() {
+    uint32_t count = 0;
+    for (uint32_t tileCount : tileCounts_) {
+        count += tileCount;
+    }
+    population_ = count;
+}
+
+void TiledGrid::placeTiles(TileBuffer& tiles) {
+    const size_t count = static_cast<size_t>(tilesX_) * tilesY_;
+    tiles.resize(count); // Default-initialized, so no page is touched yet
+
+    // Tiles [firstTile(w), firstTile(w + 1)) are worker w's, the ones
+    // parallelFor() deals it, and each node's workers own one run of them.
+    // A page straddling two nodes' runs goes to the later node.
+    const uint32_t threads = pool_.getThreadCount();
+    auto firstTile = [&](size_t worker) { return (worker * count + threads - 1) / threads; };
+    const NumaTopology& topology = pool_.getTopology();
+    const size_t page = getMemoryPageSize();
+    auto* base = reinterpret_cast<std::byte*>(tiles.data());
+    if (topology.getNodeCount() > 1 && reinterpret_cast<uintptr_t>(base) % page == 0) {
+        size_t runStart = 0;
+        for (uint32_t worker = 1; worker <= threads; ++worker) {
+            const uint32_t node = pool_.getWorkerNode(worker - 1);
+            if (worker < threads && pool_.getWorkerNode(worker) == node) {
+                continue;
+            }
+            const size_t runEnd = firstTile(worker);
+            const size_t begin = runStart * sizeof(Tile) / page * page;
+            const size_t end = runEnd * sizeof(Tile) / page * page;
+            if (end > begin) {
+                placeMemoryOnNode(base + begin, end - begin, topology.getNode(node).id);
+            }
+            runStart = runEnd;
+        }
+    }
+
+    // First touch by the owner puts the pages on its node even where they
+    // could not be placed above
+    pool_.forEachWorker([&](size_t worker) {
+        std::fill(tiles.begin() + static_cast<std::ptrdiff_t>(firstTile(worker)),
+                  tiles.begin() + static_cast<std::ptrdiff_t>(firstTile(worker + 1)), Tile{});
+    });
+}
+
+} // namespace flecs_gol
@@ -0,0 +1,223 @@
+#include <flecs_gol/trace.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace flecs_gol {
+
+namespace {
+
+// One spare slot, since a dump skips the one a write may be in the middle of
+constexpr size_t SLOTS = Trace::EVENTS_PER_THREAD + 1;
+
+// Slots are atomics so a dump may read a buffer its thread is still writing
+struct Slot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> start{0};
+    std::atomic<uint64_t> duration{0};
+};
+
+// Written only by its thread; spans [floor, head) are kept, at most the last
+// EVENTS_PER_THREAD of them
+struct ThreadBuffer {
+    explicit ThreadBuffer(uint32_t id) : id(id), slots(new Slot[SLOTS]) {}
+
+    const uint32_t id;
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> floor{0};
+    std::atomic<bool> exited{false};
+    std::string name; // Guarded by Registry::mutex
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint32_t nextId{1};
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+std::atomic<bool> enabled{false};
+
+// Keeps the buffer in the registry once its thread exits, so the thread's
+// spans still show up in dumps until the next clear()
+struct ThreadBufferHandle {
+    ThreadBufferHandle() {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffer = std::make_shared<ThreadBuffer>(reg.nextId++);
+        reg.buffers.push_back(buffer);
+    }
+    ~ThreadBufferHandle() { buffer->exited.store(true, std::memory_order_relaxed); }
+
+    std::shared_ptr<ThreadBuffer> buffer;
+};
+
+ThreadBuffer& threadBuffer() {
+    thread_local ThreadBufferHandle handle;
+    return *handle.buffer;
+}
+
+struct Span {
+    const char* name;
+    uint64_t start;
+    uint64_t duration;
+};
+
+// Copies the buffer's kept spans, dropping any its thread overwrote meanwhile
+std::vector<Span> readSpans(const ThreadBuffer& buffer) {
+    const uint64_t head = buffer.head.load(std::memory_order_acquire);
+    const uint64_t oldest = head > Trace::EVENTS_PER_THREAD ? head - Trace::EVENTS_PER_THREAD : 0;
+    const uint64_t first = std::max(buffer.floor.load(std::memory_order_relaxed), oldest);
+
+    std::vector<Span> spans;
+    spans.reserve(static_cast<size_t>(head - first));
+    for (uint64_t i = first; i < head; ++i) {
+        const Slot& slot = buffer.slots[i % SLOTS];
+        spans.push_back({slot.name.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed),
+                         slot.duration.load(std::memory_order_relaxed)});
+    }
+
+    // A write in progress may be touching the slot of index newHead - SLOTS
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t newHead = buffer.head.load(std::memory_order_relaxed);
+    if (newHead + 1 > first + SLOTS) {
+        const auto stale =
+            static_cast<size_t>(std::min<uint64_t>(newHead + 1 - SLOTS - first, spans.size()));
+        spans.erase(spans.begin(), spans.begin() + static_cast<ptrdiff_t>(stale));
+    }
+    return spans;
+}
+
+void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(*c)));
+            out << escaped;
+        } else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+// Chrome trace timestamps are microseconds; keep nanosecond precision
+void writeMicros(std::ostream& out, uint64_t nanos) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03u", static_cast<unsigned long long>(nanos / 1000),
+                  static_cast<unsigned>(nanos % 1000));
+    out << text;
+}
+
+} // namespace
+
+void Trace::setEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool Trace::isEnabled() noexcept {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t Trace::now() noexcept {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Trace::record(const char* name, uint64_t startNs, uint64_t endNs) noexcept {
+    ThreadBuffer* buffer;
+    try {
+        buffer = &threadBuffer();
+    } catch (...) {
+        return; // No buffer for this thread; the span is lost
+    }
+    const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    Slot& slot = buffer->slots[head % SLOTS];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(startNs, std::memory_order_relaxed);
+    slot.duration.store(endNs - startNs, std::memory_order_relaxed);
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Trace::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name = name;
+}
+
+void Trace::clear() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::erase_if(reg.buffers, [](const auto& buffer) { return buffer->exited.load(std::memory_order_relaxed); });
+    for (auto& buffer : reg.buffers) {
+        buffer->floor.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+void Trace::writeChromeTrace(std::ostream& out) {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::vector<std::string> names;
+    {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffers = reg.buffers;
+        for (const auto& buffer : buffers) {
+            names.push_back(buffer->name.empty() ? "thread " + std::to_string(buffer->id) : buffer->name);
+        }
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separate = [&] {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+    for (size_t b = 0; b < buffers.size(); ++b) {
+        const auto& buffer = *buffers[b];
+        separate();
+        out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer.id << ",\"args\":{\"name\":";
+        writeJsonString(out, names[b].c_str());
+        out << "}}";
+
+        for (const Span& span : readSpans(buffer)) {
+            separate();
+            out << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.id << ",\"name\":";
+            writeJsonString(out, span.name);
+            out << ",\"ts\":";
+            writeMicros(out, span.start);
+            out << ",\"dur\":";
+            writeMicros(out, span.duration);
+            out << "}";
+        }
+    }
+    out << "\n]}\n";
+}
+
+void Trace::writeChromeTrace(const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Cannot open trace file: " + path);
+    }
+    writeChromeTrace(out);
+    if (!out) {
+        throw std::runtime_error("Failed writing trace file: " + path);
+    }
+}
+
+} // namespace flecs_gol
@@ -0,0 +1,211 @@
+#include <flecs_gol/work_stealing_pool.h>
+#include <flecs_gol/trace.h>
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <utility>
+
+namespace flecs_gol {
+
+WorkStealingPool::WorkStealingPool(uint32_t threads, WorkerPlacement placement)
+    : placement_(std::move(placement)) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Workers in contiguous groups per node, each group cycling through its node's CPUs
+    const uint32_t nodes = placement_.topology.getNodeCount();
+    std::vector<uint32_t> placed(nodes, 0);
+    for (uint32_t i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+        const auto node = static_cast<uint32_t>(static_cast<uint64_t>(i) * nodes / threads);
+        const auto& cpus = placement_.topology.getNode(node).cpus;
+        workerNodes_.push_back(node);
+        workerCpus_.push_back(cpus[placed[node]++ % cpus.size()]);
+    }
+
+    // Worker 0 is whichever thread calls parallelFor()
+    for (size_t worker = 1; worker < threads; ++worker) {
+        threads_.emplace_back([this, worker] { workerLoop(worker); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        stopping_ = true;
+    }
+    batchStarted_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::parallelFor(size_t count, const std::function<void(size_t)>& task) {
+    runBatch(count, task, nullptr, true);
+}
+
+void WorkStealingPool::parallelFor(size_t count, const std::function<void(size_t)>& task,
+                                   const std::function<uint32_t(size_t)>& owner) {
+    runBatch(count, task, &owner, true);
+}
+
+void WorkStealingPool::forEachWorker(const std::function<void(size_t)>& task) {
+    // One task per worker lands in its own queue, and with stealing off it stays there
+    runBatch(queues_.size(), task, nullptr, false);
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        submitted_.push_back(std::move(task));
+        if (threads_.empty()) {
+            // Batches of a one-thread pool never leave the caller, so this
+            // worker only ever serves submitted tasks
+            threads_.emplace_back([this] { workerLoop(0); });
+        }
+    }
+    batchStarted_.notify_one();
+}
+
+void WorkStealingPool::runBatch(size_t count, const std::function<void(size_t)>& task,
+                                const std::function<uint32_t(size_t)>* owner, bool stealing) {
+    if (count == 0) {
+        return;
+    }
+
+    // Nothing to share: skip the hand-off entirely
+    if (queues_.size() == 1 || count == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    // Publish the task before any index is queued: a worker still draining
+    // the previous batch may pick up new indices straight away
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        task_ = &task;
+        remaining_.store(count, std::memory_order_relaxed);
+        stealing_.store(stealing, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t worker = owner != nullptr ? (*owner)(i) : getOwner(i, count);
+        WorkQueue& queue = *queues_[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.items.push_back(i);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        ++batch_;
+    }
+    batchStarted_.notify_all();
+
+    runTasks(0);
+
+    std::unique_lock<std::mutex> lock(batchMutex_);
+    batchFinished_.wait(lock, [this] { return remaining_.load(std::memory_order_acquire) == 0; });
+    task_ = nullptr;
+}
+
+void WorkStealingPool::workerLoop(size_t worker) {
+    FLECS_GOL_TRACE_THREAD_NAME("pool worker " + std::to_string(worker));
+    if (placement_.pinThreads) {
+        pinCurrentThread(workerCpus_[worker]);
+    }
+    uint64_t seenBatch = 0;
+
+    while (true) {
+        // A new batch comes before submitted tasks, which run to the end once taken
+        std::function<void()> submitted;
+        {
+            std::unique_lock<std::mutex> lock(batchMutex_);
+            batchStarted_.wait(lock, [&] { return stopping_ || batch_ != seenBatch || !submitted_.empty(); });
+            if (batch_ != seenBatch) {
+                seenBatch = batch_;
+            } else if (!submitted_.empty()) {
+                submitted = std::move(submitted_.front());
+                submitted_.pop_front();
+            } else {
+                return;  // Stopping, with nothing left queued
+            }
+        }
+
+        if (submitted) {
+            try {
+                submitted();
+            } catch (const std::exception& e) {
+                std::cerr << "Submitted task failed: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "Submitted task failed" << std::endl;
+            }
+        } else {
+            runTasks(worker);
+        }
+    }
+}
+
+bool WorkStealingPool::takeTask(size_t worker, size_t& index) {
+    // Own queue first, oldest task first
+    {
+        WorkQueue& own = *queues_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.head < own.items.size()) {
+            index = own.items[own.head++];
+            if (own.head == own.items.size()) {
+                own.items.clear();
+                own.head = 0;
+            }
+            return true;
+        }
+    }
+
+    // Then steal the newest task from the next non-empty queue, trying the
+    // workers of this one's node before the rest
+    for (const bool remote : {false, true}) {
+        for (size_t offset = 1; offset < queues_.size(); ++offset) {
+            const size_t victimWorker = (worker + offset) % queues_.size();
+            if ((workerNodes_[victimWorker] != workerNodes_[worker]) != remote) {
+                continue;
+            }
+            WorkQueue& victim = *queues_[victimWorker];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            // Read under the lock: the items seen were queued after the flag was set
+            if (victim.head < victim.items.size() && stealing_.load(std::memory_order_relaxed)) {
+                index = victim.items.back();
+                victim.items.pop_back();
+                if (victim.head == victim.items.size()) {
+                    victim.items.clear();
+                    victim.head = 0;
+                }
+                steals_.fetch_add(1, std::memory_order_relaxed);
+                if (remote) {
+                    remoteSteals_.fetch_add(1, std::memory_order_relaxed);
+                }
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingPool::runTasks(size_t worker) {
+    size_t index = 0;
+    while (takeTask(worker, index)) {
+        // The batch cannot finish while this task is outstanding, so task_ stays valid
+        (*task_)(index);
+
+        if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(batchMutex_);
+            batchFinished_.notify_all();
+        }
+    }
+}
+
+} // namespace flecs_gol
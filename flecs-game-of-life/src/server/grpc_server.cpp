@@ -0,0 +1,520 @@
+#include <flecs_gol/grpc_server.h>
+#include <flecs_gol/cell_encoding.h>
+#include <flecs_gol/trace.h>
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+namespace flecs_gol {
+
+namespace {
+
+using Service = game_of_life::GameOfLifeService::AsyncService;
+
+// Outstanding RPCs get this long to finish before shutdown cancels them
+constexpr auto SHUTDOWN_GRACE = std::chrono::seconds(2);
+
+grpc::Status notFound() {
+    return {grpc::StatusCode::NOT_FOUND, "Simulation not found"};
+}
+
+void addCell(google::protobuf::RepeatedPtrField<game_of_life::Cell>& cells, const Position& pos, bool alive) {
+    auto* cell = cells.Add();
+    cell->set_x(pos.x);
+    cell->set_y(pos.y);
+    cell->set_alive(alive);
+}
+
+void fillSimulation(const std::string& id, const SimulationSession::Snapshot& snapshot,
+                    game_of_life::SimulationResponse& response) {
+    response.set_id(id);
+    response.set_generation(static_cast<int64_t>(snapshot.generation));
+    response.set_live_cells(static_cast<int64_t>(snapshot.cells.size()));
+    response.mutable_grid()->set_width(snapshot.width);
+    response.mutable_grid()->set_height(snapshot.height);
+    response.mutable_cells()->Reserve(static_cast<int>(snapshot.cells.size()));
+    for (const auto& pos : snapshot.cells) {
+        addCell(*response.mutable_cells(), pos, true);
+    }
+}
+
+} // namespace
+
+// A call owns itself: it is created waiting for a request, handed its
+// completion events one at a time, and deletes itself once finished
+class GrpcServer::Call {
+public:
+    virtual ~Call() = default;
+    virtual void proceed(bool ok) = 0;
+
+    // Takes the place of proceed() once the server is shutting down
+    virtual void drop() { delete this; }
+};
+
+template <typename Request, typename Response>
+class GrpcServer::UnaryCall final : public GrpcServer::Call {
+public:
+    using RequestMethod = void (Service::*)(grpc::ServerContext*, Request*, grpc::ServerAsyncResponseWriter<Response>*,
+                                            grpc::CompletionQueue*, grpc::ServerCompletionQueue*, void*);
+    using Handler = grpc::Status (GrpcServer::*)(const Request&, Response&);
+
+    UnaryCall(GrpcServer& server, RequestMethod requestMethod, Handler handler)
+        : server_(server)
+        , requestMethod_(requestMethod)
+        , handler_(handler)
+        , responder_(&context_) {
+        (server_.service_.*requestMethod_)(&context_, &request_, &responder_, server_.queue_.get(),
+                                           server_.queue_.get(), this);
+    }
+
+    void proceed(bool ok) override {
+        if (finished_ || !ok) {
+            delete this;
+            return;
+        }
+
+        // Keep one call of this kind waiting for the next request
+        new UnaryCall(server_, requestMethod_, handler_);
+
+        grpc::Status status;
+        try {
+            status = (server_.*handler_)(request_, response_);
+        } catch (const std::exception& e) {
+            status = grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+        }
+        finished_ = true;
+        if (status.ok()) {
+            responder_.Finish(response_, status, this);
+        } else {
+            responder_.FinishWithError(status, this);
+        }
+    }
+
+private:
+    GrpcServer& server_;
+    RequestMethod requestMethod_;
+    Handler handler_;
+
+    grpc::ServerContext context_;
+    Request request_;
+    Response response_;
+    grpc::ServerAsyncResponseWriter<Response> responder_;
+    bool finished_ = false;
+};
+
+// StreamSimulation: the first update is a keyframe with the whole board,
+// later ones carry the cells that changed. Ticks are alarms on the completion
+// queue and keep their schedule whether or not the client has taken the last
+// update: an auto-stepping stream steps its board on every tick, and while a
+// write is still in flight the changes collect, coalesced, in the stream's
+// subscription and go out as one update when the write completes. A slow
+// client therefore never holds the board back or builds up a queue.
+class GrpcServer::StreamCall final : public GrpcServer::Call {
+public:
+    explicit StreamCall(GrpcServer& server)
+        : server_(server)
+        , writer_(&context_)
+        , tick_(*this) {
+        server_.service_.RequestStreamSimulation(&context_, &request_, &writer_, server_.queue_.get(),
+                                                 server_.queue_.get(), this);
+    }
+
+    ~StreamCall() override {
+        std::lock_guard<std::mutex> lock(server_.streamsMutex_);
+        server_.streams_.erase(this);
+    }
+
+    void cancelAlarm() { alarm_.Cancel(); }
+
+    // The request, writes and the finish complete on this tag, ticks on tick_
+    void proceed(bool ok) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        --outstanding_;
+        if (!started_) {
+            started_ = true;
+            if (ok) {
+                begin();
+            }
+        } else if (writing_) {
+            writing_ = false;
+            written(ok);
+        }
+        releaseIfDone(lock);
+    }
+
+    void drop() override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        --outstanding_;
+        releaseIfDone(lock);
+    }
+
+private:
+    // Alarm completions need a tag of their own while a write is in flight
+    class Tick final : public GrpcServer::Call {
+    public:
+        explicit Tick(StreamCall& stream) : stream_(stream) {}
+        void proceed(bool ok) override { stream_.tick(ok); }
+        void drop() override { stream_.drop(); }
+
+    private:
+        StreamCall& stream_;
+    };
+
+    // All of these run with mutex_ held
+    void begin() {
+        new StreamCall(server_);
+        session_ = server_.store_.find(request_.id());
+        if (!session_) {
+            finish(notFound());
+            return;
+        }
+        subscription_ = session_->subscribe();
+        interval_ = std::chrono::milliseconds(
+            request_.step_interval_ms() > 0 ? request_.step_interval_ms() : DEFAULT_STREAM_INTERVAL_MS);
+        {
+            std::lock_guard<std::mutex> lock(server_.streamsMutex_);
+            server_.streams_.insert(this);
+        }
+        write();
+        setAlarm();
+    }
+
+    void written(bool ok) {
+        if (finishing_) {
+            return;
+        }
+        if (!ok) {
+            finish(grpc::Status::CANCELLED); // The client went away
+        } else if (deferredStatus_) {
+            finish(*deferredStatus_);
+        } else if (ended_) {
+            finish(grpc::Status::OK);
+        } else if (session_->hasUpdate(*subscription_)) {
+            write(); // Whatever piled up during the last write
+        }
+    }
+
+    void tick(bool ok) {
+        FLECS_GOL_TRACE_SCOPE("StreamCall::tick");
+        std::unique_lock<std::mutex> lock(mutex_);
+        --outstanding_;
+        alarmSet_ = false;
+        if (finishing_) {
+            // Nothing more to send
+        } else if (!ok) {
+            // A cancelled alarm means the server is shutting down
+            end(grpc::Status(grpc::StatusCode::UNAVAILABLE, "Server shutting down"));
+        } else if (server_.store_.find(request_.id()) != session_) {
+            end(notFound()); // A deleted simulation ends the stream, as on the Bevy server
+        } else {
+            try {
+                if (request_.auto_step()) {
+                    session_->step(1);
+                }
+                if (!writing_) {
+                    write();
+                }
+                setAlarm();
+            } catch (const EntityLimitError& e) {
+                end(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, e.what()));
+            }
+        }
+        releaseIfDone(lock);
+    }
+
+    void write() {
+        FLECS_GOL_TRACE_SCOPE("StreamCall::write");
+        const auto update = session_->takeUpdate(*subscription_);
+        game_of_life::SimulationUpdate message;
+        message.set_generation(static_cast<int64_t>(update.generation));
+        message.set_live_cells(static_cast<int64_t>(update.liveCells));
+        message.set_simulation_ended(update.ended);
+        message.set_keyframe(update.keyframe);
+        if (request_.cell_encoding() == game_of_life::CELL_ENCODING_PACKED) {
+            // Straight from the cell lists, without building Cell messages
+            encodeCellFlips(update.born, update.died, *message.mutable_packed_cells());
+        } else {
+            message.mutable_changed_cells()->Reserve(static_cast<int>(update.born.size() + update.died.size()));
+            for (const auto& pos : update.born) {
+                addCell(*message.mutable_changed_cells(), pos, true);
+            }
+            for (const auto& pos : update.died) {
+                addCell(*message.mutable_changed_cells(), pos, false);
+            }
+        }
+
+        ended_ = update.ended;
+        writing_ = true;
+        ++outstanding_;
+        writer_.Write(message, this);
+    }
+
+    void setAlarm() {
+        alarmSet_ = true;
+        ++outstanding_;
+        alarm_.Set(server_.queue_.get(), std::chrono::system_clock::now() + interval_, &tick_);
+    }
+
+    // Finishes now, or once the write in flight completes
+    void end(const grpc::Status& status) {
+        if (writing_) {
+            deferredStatus_ = status;
+        } else {
+            finish(status);
+        }
+    }
+
+    void finish(const grpc::Status& status) {
+        finishing_ = true;
+        ++outstanding_;
+        writer_.Finish(status, this);
+        if (alarmSet_) {
+            alarm_.Cancel();
+        }
+    }
+
+    // Deletes the call once no operation of it is left on the queue
+    void releaseIfDone(std::unique_lock<std::mutex>& lock) {
+        if (outstanding_ == 0) {
+            lock.unlock();
+            delete this;
+        }
+    }
+
+    GrpcServer& server_;
+    grpc::ServerContext context_;
+    game_of_life::StreamRequest request_;
+    grpc::ServerAsyncWriter<game_of_life::SimulationUpdate> writer_;
+    grpc::Alarm alarm_;
+    Tick tick_;
+
+    // A tick and a write can complete at the same time on different workers
+    std::mutex mutex_;
+    int outstanding_ = 1; // Operations on the queue; the request to start with
+    bool started_ = false;
+    bool writing_ = false;
+    bool alarmSet_ = false;
+    bool finishing_ = false;
+    bool ended_ = false;
+    std::optional<grpc::Status> deferredStatus_;
+
+    std::shared_ptr<SimulationSession> session_;
+    std::shared_ptr<StreamSubscription> subscription_;
+    std::chrono::milliseconds interval_{DEFAULT_STREAM_INTERVAL_MS};
+};
+
+GrpcServer::GrpcServer(GameConfig baseConfig, std::string patternDirectory)
+    : store_(std::move(baseConfig), std::move(patternDirectory))
+    , startTime_(std::chrono::steady_clock::now()) {
+}
+
+GrpcServer::~GrpcServer() {
+    shutdown();
+}
+
+void GrpcServer::start(const std::string& address, unsigned workerThreads) {
+    if (server_) {
+        throw std::runtime_error("gRPC server already started");
+    }
+
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(address, grpc::InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    queue_ = builder.AddCompletionQueue();
+    server_ = builder.BuildAndStart();
+    if (!server_) {
+        throw std::runtime_error("Could not start gRPC server on " + address);
+    }
+
+    listen();
+    if (workerThreads == 0) {
+        workerThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < workerThreads; ++i) {
+        workers_.emplace_back([this] { serve(); });
+    }
+}
+
+void GrpcServer::shutdown() {
+    if (!server_) {
+        return;
+    }
+    std::call_once(shutdownOnce_, [this] {
+        // Waiting streams finish now rather than at their next tick; workers
+        // keep draining the queue while the server cancels what is left
+        {
+            std::lock_guard<std::mutex> lock(streamsMutex_);
+            for (auto* stream : streams_) {
+                stream->cancelAlarm();
+            }
+        }
+        server_->Shutdown(std::chrono::system_clock::now() + SHUTDOWN_GRACE);
+        {
+            std::unique_lock<std::shared_mutex> lock(shutdownMutex_);
+            shuttingDown_ = true;
+        }
+        queue_->Shutdown();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        workers_.clear();
+    });
+}
+
+void GrpcServer::serve() {
+    FLECS_GOL_TRACE_THREAD_NAME("grpc worker");
+    void* tag = nullptr;
+    bool ok = false;
+    while (queue_->Next(&tag, &ok)) {
+        auto* call = static_cast<Call*>(tag);
+        std::shared_lock<std::shared_mutex> lock(shutdownMutex_);
+        if (shuttingDown_) {
+            // The queue no longer accepts operations; every call is cancelled
+            call->drop();
+        } else {
+            call->proceed(ok);
+        }
+    }
+}
+
+void GrpcServer::listen() {
+    using namespace game_of_life;
+    new UnaryCall<StatusRequest, StatusResponse>(*this, &Service::RequestGetStatus, &GrpcServer::getStatus);
+    new UnaryCall<CreateSimulationRequest, SimulationResponse>(*this, &Service::RequestCreateSimulation,
+                                                               &GrpcServer::createSimulation);
+    new UnaryCall<GetSimulationRequest, SimulationResponse>(*this, &Service::RequestGetSimulation,
+                                                            &GrpcServer::getSimulation);
+    new UnaryCall<UpdateSimulationRequest, SimulationResponse>(*this, &Service::RequestUpdateSimulation,
+                                                               &GrpcServer::updateSimulation);
+    new UnaryCall<DeleteSimulationRequest, DeleteResponse>(*this, &Service::RequestDeleteSimulation,
+                                                           &GrpcServer::deleteSimulation);
+    new UnaryCall<StepSimulationRequest, StepResponse>(*this, &Service::RequestStepSimulation,
+                                                       &GrpcServer::stepSimulation);
+    new UnaryCall<LoadPatternRequest, LoadPatternResponse>(*this, &Service::RequestLoadPattern,
+                                                           &GrpcServer::loadPattern);
+    new StreamCall(*this);
+}
+
+grpc::Status GrpcServer::getStatus(const game_of_life::StatusRequest&, game_of_life::StatusResponse& response) {
+    FLECS_GOL_TRACE_SCOPE("GrpcServer::getStatus");
+    response.set_status("healthy");
+    response.set_version("1.0.0");
+    response.set_implementation("flecs");
+    response.set_uptime_seconds(
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - startTime_).count());
+    return grpc::Status::OK;
+}
+
+grpc::Status GrpcServer::createSimulation(const game_of_life::CreateSimulationRequest& request,
+                                                game_of_life::SimulationResponse& response) {
+    FLECS_GOL_TRACE_SCOPE("GrpcServer::createSimulation");
+    std::shared_ptr<SimulationSession> session;
+    try {
+        session = store_.create(request.width(), request.height(), request.initial_pattern());
+    } catch (const std::invalid_argument& e) {
+        return {grpc::StatusCode::INVALID_ARGUMENT, e.what()};
+    }
+    fillSimulation(session->getId(), session->snapshot(), response);
+    return grpc::Status::OK;
+}
+
+grpc::Status GrpcServer::getSimulation(const game_of_life::GetSimulationRequest& request,
+                                             game_of_life::SimulationResponse& response) {
+    FLECS_GOL_TRACE_SCOPE("GrpcServer::getSimulation");
+    auto session = store_.find(request.id());
+    if (!session) {
+        return notFound();
+    }
+    fillSimulation(session->getId(), session->snapshot(), response);
+    return grpc::Status::OK;
+}
+
+grpc::Status GrpcServer::updateSimulation(const game_of_life::UpdateSimulationRequest& request,
+                                                game_of_life::SimulationResponse& response) {
+    FLECS_GOL_TRACE_SCOPE("GrpcServer::updateSimulation");
+    auto session = store_.find(request.id());
+    if (!session) {
+        return notFound();
+    }
+
+    // Zero and empty mean "leave as is", as proto3 cannot tell them from unset
+    std::optional<uint32_t> generation;
+    if (request.generation() > 0) {
+        generation = static_cast<uint32_t>(
+            std::min<int64_t>(request.generation(), std::numeric_limits<uint32_t>::max()));
+    }
+    std::vector<Position> cells;
+    for (const auto& cell : request.cells()) {
+        if (cell.alive()) {
+            cells.emplace_back(cell.x(), cell.y());
+        }
+    }
+    std::optional<std::span<const Position>> board;
+    if (request.cells_size() > 0) {
+        board = cells;
+    }
+
+    fillSimulation(session->getId(), session->update(generation, board), response);
+    return grpc::Status::OK;
+}
+
+grpc::Status GrpcServer::deleteSimulation(const game_of_life::DeleteSimulationRequest& request,
+                                                game_of_life::DeleteResponse& response) {
+    FLECS_GOL_TRACE_SCOPE("GrpcServer::deleteSimulation");
+    const bool deleted = store_.erase(request.id());
+    response.set_success(deleted);
+    response.set_message(deleted ? "Simulation deleted successfully" : "Simulation not found");
+    return grpc::Status::OK;
+}
+
+grpc::Status GrpcServer::stepSimulation(const game_of_life::StepSimulationRequest& request,
+                                              game_of_life::StepResponse& response) {
+    FLECS_GOL_TRACE_SCOPE("GrpcServer::stepSimulation");
+    auto session = store_.find(request.id());
+    if (!session) {
+        return notFound();
+    }
+
+    // Every step runs here; only the final state goes back to the client
+    SimulationSession::StepResult result;
+    try {
+        result = session->step(request.steps() > 0 ? static_cast<uint32_t>(request.steps()) : 1u);
+    } catch (const EntityLimitError& e) {
+        return {grpc::StatusCode::RESOURCE_EXHAUSTED, e.what()};
+    }
+    response.set_generation(static_cast<int64_t>(result.generation));
+    response.set_live_cells(static_cast<int64_t>(result.liveCells));
+    response.set_changed_cells(static_cast<int64_t>(result.changedCells));
+    return grpc::Status::OK;
+}
+
+grpc::Status GrpcServer::loadPattern(const game_of_life::LoadPatternRequest& request,
+                                           game_of_life::LoadPatternResponse& response) {
+    FLECS_GOL_TRACE_SCOPE("GrpcServer::loadPattern");
+    auto session = store_.find(request.id());
+    if (!session) {
+        return notFound();
+    }
+    if (!request.has_pattern()) {
+        return {grpc::StatusCode::INVALID_ARGUMENT, "Pattern is required"};
+    }
+    if (!request.has_position()) {
+        return {grpc::StatusCode::INVALID_ARGUMENT, "Position is required"};
+    }
+
+    std::vector<Position> cells;
+    cells.reserve(static_cast<size_t>(request.pattern().cells_size()));
+    for (const auto& pos : request.pattern().cells()) {
+        cells.emplace_back(pos.x(), pos.y());
+    }
+    const auto added = session->addPattern(cells, Position(request.position().x(), request.position().y()));
+
+    response.set_success(added > 0);
+    response.set_cells_added(static_cast<int32_t>(added));
+    response.set_message(added > 0 ? "Pattern '" + request.pattern().name() + "' loaded successfully"
+                                   : "No cells were added (pattern outside grid or cells already exist)");
+    return grpc::Status::OK;
+}
+
+} // namespace flecs_gol
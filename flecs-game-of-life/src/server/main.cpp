@@ -0,0 +1,149 @@
+#include <flecs_gol/grpc_server.h>
+#include <flecs_gol/game_config.h>
+#include <flecs_gol/trace.h>
+#include <flecs_gol/metrics.h>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace flecs_gol;
+
+constexpr std::chrono::seconds METRICS_INTERVAL{5};
+
+// Global state for signal handling
+std::atomic<bool> g_shouldExit{false};
+std::atomic<bool> g_traceRequested{false};
+
+void signalHandler(int signal) {
+    if (signal == SIGINT || signal == SIGTERM) {
+        g_shouldExit = true;
+    }
+#ifdef SIGUSR1
+    if (signal == SIGUSR1) {
+        g_traceRequested = true;
+    }
+#endif
+}
+
+void writeTrace(const std::string& traceFile) {
+    try {
+        Trace::writeChromeTrace(traceFile);
+        std::cout << "Wrote trace to " << traceFile << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+// Every live simulation, labelled by its id
+void writeMetrics(std::ostream& out, const SimulationStore& store, bool prometheus) {
+    const auto sessions = store.list();
+    std::vector<LabelledMetrics> simulations;
+    simulations.reserve(sessions.size());
+    for (const auto& session : sessions) {
+        simulations.emplace_back(session->getId(), &session->getMetrics());
+    }
+    if (prometheus) {
+        writePrometheusMetrics(out, simulations);
+    } else {
+        out << metricsToJson(simulations).dump(2) << "\n";
+    }
+}
+
+void showUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --address <host:port>  Listening address (default " << GrpcServer::DEFAULT_ADDRESS << ")\n"
+              << "  --config <file>        Engine and edge settings (default config/default.json)\n"
+              << "  --patterns <dir>       Named patterns for CreateSimulation (default ../patterns)\n"
+              << "  --threads <n>          Completion queue workers (default: one per hardware thread)\n"
+              << "  --trace <file>         Write Chrome trace JSON on SIGUSR1 and at exit (needs -DENABLE_PROFILING=ON)\n"
+              << "  --metrics <file>       Rewrite Prometheus text (*.prom) or JSON metrics there every few seconds\n";
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        std::string address = GrpcServer::DEFAULT_ADDRESS;
+        std::string configFile = "config/default.json";
+        std::string patternDirectory = "../patterns";
+        unsigned threads = 0;
+        std::string traceFile;
+        std::string metricsFile;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg == "--address" && i + 1 < argc) {
+                address = argv[++i];
+            } else if (arg == "--config" && i + 1 < argc) {
+                configFile = argv[++i];
+            } else if (arg == "--patterns" && i + 1 < argc) {
+                patternDirectory = argv[++i];
+            } else if (arg == "--threads" && i + 1 < argc) {
+                threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            } else if (arg == "--trace" && i + 1 < argc) {
+                traceFile = argv[++i];
+            } else if (arg == "--metrics" && i + 1 < argc) {
+                metricsFile = argv[++i];
+            } else {
+                showUsage(argv[0]);
+                return arg == "--help" || arg == "-h" ? 0 : 1;
+            }
+        }
+
+        // Grid size comes from each CreateSimulation; the rest from the config
+        GameConfig config;
+        auto loadedConfig = GameConfig::loadFromFile(configFile);
+        if (loadedConfig.has_value()) {
+            config = loadedConfig.value();
+        } else {
+            std::cout << "Using default configuration (could not load: " << configFile << ")" << std::endl;
+        }
+
+        if (!traceFile.empty()) {
+#ifndef FLECS_GOL_PROFILING_ENABLED
+            std::cout << "Tracing is compiled out; rebuild with -DENABLE_PROFILING=ON" << std::endl;
+#endif
+            Trace::setEnabled(true);
+        }
+
+        GrpcServer server(config, patternDirectory);
+        server.start(address, threads);
+        std::cout << "Game of Life gRPC server (FLECS) listening on " << address << std::endl;
+
+        std::unique_ptr<MetricsFileWriter> metrics;
+        if (!metricsFile.empty()) {
+            const bool prometheus = MetricsFileWriter::isPrometheusPath(metricsFile);
+            metrics = std::make_unique<MetricsFileWriter>(
+                metricsFile, METRICS_INTERVAL,
+                [&server, prometheus](std::ostream& out) { writeMetrics(out, server.getStore(), prometheus); });
+        }
+
+        signal(SIGINT, signalHandler);
+        signal(SIGTERM, signalHandler);
+#ifdef SIGUSR1
+        signal(SIGUSR1, signalHandler);
+#endif
+        while (!g_shouldExit) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            if (g_traceRequested.exchange(false) && !traceFile.empty()) {
+                writeTrace(traceFile);
+            }
+        }
+
+        std::cout << "Shutting down" << std::endl;
+        server.shutdown();
+        metrics.reset();
+        if (!traceFile.empty()) {
+            writeTrace(traceFile);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
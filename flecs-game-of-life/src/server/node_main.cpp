@@ -0,0 +1,140 @@
+#include <flecs_gol/grpc_halo_transport.h>
+#include <flecs_gol/game_config.h>
+#include <flecs_gol/partitioned_board.h>
+#include <flecs_gol/pattern_reader.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// One rank of a board too large for one host: start a node per rank, each
+// with the same config, pattern and peer list
+
+using namespace flecs_gol;
+
+void showUsage(const char* program) {
+    std::cout << "Usage: " << program << " --rank <r> --peers <host:port,...> [options]\n"
+              << "  --rank <r>             This node's rank\n"
+              << "  --peers <list>         Every rank's address in rank order\n"
+              << "  --listen <host:port>   Address to bind instead of this rank's peer address\n"
+              << "  --config <file>        Grid boundaries of the whole board, wrap and rule (default config/default.json)\n"
+              << "  --pattern <file>       RLE (.rle) or macrocell (.mc) pattern; each node keeps its own slab's cells\n"
+              << "  --generations <n>      Generations to run (default 100)\n"
+              << "  --halo <k>             Rows swapped with each neighbor every k generations (default 1)\n"
+              << "  --timeout-ms <ms>      How long to wait for a peer per message (default "
+              << GrpcHaloTransport::DEFAULT_TIMEOUT.count() << ")\n";
+}
+
+std::vector<std::string> splitPeers(const std::string& list) {
+    std::vector<std::string> peers;
+    std::stringstream stream(list);
+    std::string peer;
+    while (std::getline(stream, peer, ',')) {
+        if (!peer.empty()) {
+            peers.push_back(peer);
+        }
+    }
+    return peers;
+}
+
+void loadPattern(const std::string& patternFile, PartitionedBoard& board) {
+    const PatternFormat format = patternFormatFromPath(patternFile);
+    if (format == PatternFormat::Json) {
+        throw std::runtime_error("Nodes read RLE (.rle) or macrocell (.mc) patterns: " + patternFile);
+    }
+    std::ifstream file(patternFile, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open pattern file: " + patternFile);
+    }
+
+    // Runs outside this slab are dropped as they are read
+    auto addRun = [&board](int32_t x, int32_t y, uint32_t length) {
+        for (uint32_t i = 0; i < length; ++i) {
+            board.setCell(x + static_cast<int32_t>(i), y, true);
+        }
+    };
+    if (format == PatternFormat::Rle) {
+        readRlePattern(file, addRun, board.getConfig().getRule());
+    } else {
+        readMacrocellPattern(file, addRun, board.getConfig().getRule());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        int64_t rank = -1;
+        std::vector<std::string> peers;
+        std::string listenAddress;
+        std::string configFile = "config/default.json";
+        std::string patternFile;
+        uint64_t generations = 100;
+        int32_t haloDepth = 1;
+        auto timeout = GrpcHaloTransport::DEFAULT_TIMEOUT;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg == "--rank" && i + 1 < argc) {
+                rank = std::stoll(argv[++i]);
+            } else if (arg == "--peers" && i + 1 < argc) {
+                peers = splitPeers(argv[++i]);
+            } else if (arg == "--listen" && i + 1 < argc) {
+                listenAddress = argv[++i];
+            } else if (arg == "--config" && i + 1 < argc) {
+                configFile = argv[++i];
+            } else if (arg == "--pattern" && i + 1 < argc) {
+                patternFile = argv[++i];
+            } else if (arg == "--generations" && i + 1 < argc) {
+                generations = std::stoull(argv[++i]);
+            } else if (arg == "--halo" && i + 1 < argc) {
+                haloDepth = std::stoi(argv[++i]);
+            } else if (arg == "--timeout-ms" && i + 1 < argc) {
+                timeout = std::chrono::milliseconds{std::stoll(argv[++i])};
+            } else {
+                showUsage(argv[0]);
+                return arg == "--help" || arg == "-h" ? 0 : 1;
+            }
+        }
+        if (rank < 0 || peers.empty()) {
+            showUsage(argv[0]);
+            return 1;
+        }
+
+        GameConfig config;
+        auto loadedConfig = GameConfig::loadFromFile(configFile);
+        if (loadedConfig.has_value()) {
+            config = loadedConfig.value();
+        } else {
+            std::cout << "Using default configuration (could not load: " << configFile << ")" << std::endl;
+        }
+
+        GrpcHaloTransport transport(static_cast<uint32_t>(rank), peers, timeout, listenAddress);
+        PartitionedBoard board(config, transport, haloDepth);
+        if (!patternFile.empty()) {
+            loadPattern(patternFile, board);
+        }
+        const auto slab = board.getSlab();
+        std::cout << "Rank " << rank << " of " << peers.size() << ": rows "
+                  << config.getGridMinY() + slab.firstRow << ".." << config.getGridMinY() + slab.firstRow + slab.rows - 1
+                  << " of " << config.getGridWidth() << "x" << config.getGridHeight() << ", "
+                  << board.getSlabCellCount() << " cells, " << board.getMemoryUsage() / 1024 << " KB" << std::endl;
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto result = board.advance(generations);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (rank == 0) {
+            std::cout << "Generations: " << result.generations << (result.changed ? "" : " (settled)") << "\n"
+                      << "Living cells: " << result.livingCells << "\n"
+                      << "Elapsed: " << seconds << " s ("
+                      << (seconds > 0.0 ? static_cast<double>(result.generations) / seconds : 0.0) << " gen/s)"
+                      << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+}
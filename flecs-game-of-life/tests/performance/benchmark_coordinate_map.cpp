@@ -0,0 +1,174 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <flecs_gol/coordinate_map.h>
+#include <flecs_gol/game_of_life_simulation.h>
+#include <flecs_gol/game_config.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+// The hash Position used before CoordinateMap, kept here as the baseline.
+// A negative y sign-extends over x, so every cell of such a row shares a hash.
+struct LegacyPositionHash {
+    size_t operator()(const Position& pos) const {
+        return (static_cast<size_t>(pos.x) << 32) | static_cast<size_t>(pos.y);
+    }
+};
+
+struct Workload {
+    std::string name;
+    std::vector<Position> cells;   // Keys stored in the map
+    std::vector<Position> lookups; // 3x3 neighborhood of every key, as neighbor counting probes
+};
+
+Workload makeWorkload(std::string name, std::vector<Position> cells) {
+    Workload workload{std::move(name), std::move(cells), {}};
+    workload.lookups.reserve(workload.cells.size() * 9);
+    for (const auto& cell : workload.cells) {
+        for (int32_t dy = -1; dy <= 1; ++dy) {
+            for (int32_t dx = -1; dx <= 1; ++dx) {
+                workload.lookups.emplace_back(cell.x + dx, cell.y + dy);
+            }
+        }
+    }
+    return workload;
+}
+
+Workload gliderGunWorkload() {
+    // Gosper gun run until its glider stream forms a long diagonal
+    GameConfig config;
+    config.setGridBoundaries(-100, 2000, -100, 2000);
+    config.setEngineType(EngineType::Dense); // Only the resulting cells matter
+    GameOfLifeSimulation sim(config);
+
+    const std::vector<std::pair<int32_t, int32_t>> gun = {
+        {0, 4}, {0, 5}, {1, 4}, {1, 5},
+        {10, 4}, {10, 5}, {10, 6}, {11, 3}, {11, 7},
+        {12, 2}, {12, 8}, {13, 2}, {13, 8}, {14, 5},
+        {15, 3}, {15, 7}, {16, 4}, {16, 5}, {16, 6}, {17, 5},
+        {20, 2}, {20, 3}, {20, 4}, {21, 2}, {21, 3}, {21, 4},
+        {22, 1}, {22, 5}, {24, 0}, {24, 1}, {24, 5}, {24, 6},
+        {34, 2}, {34, 3}, {35, 2}, {35, 3}
+    };
+    for (const auto& [x, y] : gun) {
+        sim.createCell(x, y);
+    }
+    for (int generation = 0; generation < 3000; ++generation) {
+        sim.step();
+    }
+
+    return makeWorkload("glider gun", sim.getLivePositions());
+}
+
+Workload randomSoupWorkload() {
+    // 30% density soup around the origin, negative coordinates included
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32_t> coord(-200, 199);
+    std::vector<Position> cells;
+    std::unordered_map<Position, bool> seen;
+    while (cells.size() < 48000) {
+        Position pos(coord(rng), coord(rng));
+        if (seen.emplace(pos, true).second) {
+            cells.push_back(pos);
+        }
+    }
+    return makeWorkload("random soup", std::move(cells));
+}
+
+template <typename Map>
+Map buildMap(const Workload& workload) {
+    Map map;
+    for (const auto& cell : workload.cells) {
+        map[cell] = flecs::entity();
+    }
+    return map;
+}
+
+template <typename Map>
+size_t countHits(const Map& map, const Workload& workload) {
+    size_t hits = 0;
+    for (const auto& pos : workload.lookups) {
+        if (map.find(pos) != map.end()) {
+            hits++;
+        }
+    }
+    return hits;
+}
+
+template <typename Map>
+double lookupRate(const Workload& workload) {
+    Map map = buildMap<Map>(workload);
+    const int rounds = 10;
+
+    // Volatile accesses keep the rounds inside the timed region and unfolded
+    const Map* volatile mapPtr = &map;
+    volatile size_t hits = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        hits = countHits(*mapPtr, workload);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(workload.lookups.size()) * rounds / seconds;
+}
+
+using LegacyMap = std::unordered_map<Position, flecs::entity, LegacyPositionHash>;
+using StdMap = std::unordered_map<Position, flecs::entity>;
+using FlatMap = CoordinateMap<flecs::entity>;
+
+} // namespace
+
+TEST_CASE("Benchmark Spatial Index Lookups", "[benchmark][coordinate_map]") {
+    const std::vector<Workload> workloads = {gliderGunWorkload(), randomSoupWorkload()};
+
+    for (const auto& workload : workloads) {
+        auto legacy = buildMap<LegacyMap>(workload);
+        auto standard = buildMap<StdMap>(workload);
+        auto flat = buildMap<FlatMap>(workload);
+
+        // All three maps must agree before their speed means anything
+        REQUIRE(countHits(flat, workload) == countHits(legacy, workload));
+        REQUIRE(countHits(flat, workload) == countHits(standard, workload));
+
+        BENCHMARK("unordered_map, legacy hash - " + workload.name) {
+            return countHits(legacy, workload);
+        };
+        BENCHMARK("unordered_map, mixed hash - " + workload.name) {
+            return countHits(standard, workload);
+        };
+        BENCHMARK("CoordinateMap - " + workload.name) {
+            return countHits(flat, workload);
+        };
+        BENCHMARK("CoordinateMap build - " + workload.name) {
+            return buildMap<FlatMap>(workload).size();
+        };
+    }
+
+    // Lookup rate table, relative to the legacy unordered_map
+    std::cout << "\nSpatial index lookups (3x3 neighborhood of every live cell)\n";
+    std::cout << std::setw(14) << "workload" << std::setw(10) << "cells" << std::setw(30) << "map"
+              << std::setw(14) << "Mlookups/s" << std::setw(10) << "speedup" << "\n";
+
+    for (const auto& workload : workloads) {
+        double legacyRate = lookupRate<LegacyMap>(workload);
+
+        auto printRow = [&](const char* map, double rate) {
+            std::cout << std::setw(14) << workload.name << std::setw(10) << workload.cells.size()
+                      << std::setw(30) << map << std::setw(14) << std::fixed << std::setprecision(1)
+                      << rate / 1e6 << std::setw(9) << std::setprecision(2) << rate / legacyRate << "x\n";
+        };
+
+        printRow("unordered_map, legacy hash", legacyRate);
+        printRow("unordered_map, mixed hash", lookupRate<StdMap>(workload));
+        printRow("CoordinateMap", lookupRate<FlatMap>(workload));
+    }
+}
@@ -0,0 +1,145 @@
+#include <flecs_gol/benchmark.h>
+#include <flecs_gol/game_config.h>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Runs every engine over the standard workloads (flecs_gol/benchmark.h),
+// prints a table, optionally writes the results as JSON and compares them
+// with a stored baseline. Exits with 2 when a benchmark regressed.
+
+using namespace flecs_gol;
+
+namespace {
+
+constexpr EngineType ENGINES[] = {EngineType::Sparse, EngineType::Dense, EngineType::Tiled, EngineType::HashLife,
+                                  EngineType::Chunked};
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program
+              << " [--patterns dir] [--engines a,b] [--repetitions n] [--quick] [--out file]"
+                 " [--baseline file] [--tolerance fraction] [--cell-sort-interval n]\n"
+              << "  --engines picks from sparse, dense, tiled, hashlife, chunked (default all)\n"
+              << "  --quick skips the 1024x1024 soups\n"
+              << "  --baseline compares median step times; --tolerance 0.1 allows 10% slower\n"
+              << "  --cell-sort-interval sets how often sparse cells are Z-order sorted (0 = never)\n";
+}
+
+std::vector<EngineType> parseEngines(const std::string& list) {
+    std::vector<EngineType> engines;
+    std::istringstream in(list);
+    std::string name;
+    while (std::getline(in, name, ',')) {
+        const auto engine = engineTypeFromString(name);
+        if (!engine) {
+            throw std::invalid_argument("Unknown engine: " + name);
+        }
+        engines.push_back(*engine);
+    }
+    return engines;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        std::string patternDirectory = "../patterns";
+        std::vector<EngineType> engines(std::begin(ENGINES), std::end(ENGINES));
+        uint32_t repetitions = 3;
+        bool quick = false;
+        std::string outFile;
+        std::string baselineFile;
+        double tolerance = 0.1;
+        GameConfig baseConfig;
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            }
+            if (arg == "--quick") {
+                quick = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            if (arg == "--patterns") {
+                patternDirectory = argv[++i];
+            } else if (arg == "--engines") {
+                engines = parseEngines(argv[++i]);
+            } else if (arg == "--repetitions") {
+                repetitions = static_cast<uint32_t>(std::stoul(argv[++i]));
+            } else if (arg == "--out") {
+                outFile = argv[++i];
+            } else if (arg == "--baseline") {
+                baselineFile = argv[++i];
+            } else if (arg == "--tolerance") {
+                tolerance = std::stod(argv[++i]);
+            } else if (arg == "--cell-sort-interval") {
+                baseConfig.setCellSortInterval(static_cast<uint32_t>(std::stoul(argv[++i])));
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+
+        const auto workloads = makeStandardWorkloads(patternDirectory, quick);
+        std::vector<BenchmarkResult> results;
+        std::printf("%-10s %-28s %8s %14s %14s %10s %12s\n", "engine", "workload", "gens", "median ns/gen",
+                    "min ns/gen", "cells", "memory KB");
+        for (EngineType engine : engines) {
+            for (const auto& workload : workloads) {
+                const auto& result = results.emplace_back(runBenchmark(baseConfig, engine, workload, repetitions));
+                std::printf("%-10s %-28s %8u %14llu %14llu %10zu %12zu\n", result.engine.c_str(),
+                            result.workload.c_str(), result.generations,
+                            static_cast<unsigned long long>(result.medianNanosPerStep),
+                            static_cast<unsigned long long>(result.minNanosPerStep), result.finalCells,
+                            result.memoryBytes / 1024);
+                std::fflush(stdout);
+            }
+        }
+
+        const auto json = benchmarkResultsToJson(results, "flecs");
+        if (!outFile.empty()) {
+            std::ofstream out(outFile);
+            if (!out) {
+                throw std::runtime_error("Cannot open " + outFile);
+            }
+            out << json.dump(2) << "\n";
+            std::cout << "Wrote " << results.size() << " results to " << outFile << "\n";
+        }
+
+        if (!baselineFile.empty()) {
+            std::ifstream in(baselineFile);
+            if (!in) {
+                throw std::runtime_error("Cannot open " + baselineFile);
+            }
+            const auto regressions = findRegressions(nlohmann::json::parse(in), json, tolerance);
+            for (const auto& regression : regressions) {
+                std::printf("REGRESSION %-40s %12llu -> %12llu ns/gen (%+.1f%%)\n", regression.key.c_str(),
+                            static_cast<unsigned long long>(regression.baselineNanosPerStep),
+                            static_cast<unsigned long long>(regression.currentNanosPerStep),
+                            100.0 * (static_cast<double>(regression.currentNanosPerStep) /
+                                     static_cast<double>(regression.baselineNanosPerStep) - 1.0));
+            }
+            std::cout << regressions.size() << " regression(s) against " << baselineFile << "\n";
+            if (!regressions.empty()) {
+                return 2;
+            }
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
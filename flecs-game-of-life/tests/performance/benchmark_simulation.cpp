@@ -2,7 +2,13 @@
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <flecs_gol/game_of_life_simulation.h>
 #include <flecs_gol/game_config.h>
+#include <flecs_gol/numa_topology.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
 #include <random>
+#include <string>
+#include <thread>
 
 using namespace flecs_gol;
 
@@ -143,6 +149,34 @@ TEST_CASE_METHOD(BenchmarkFixture, "Benchmark Query Operations", "[benchmark][qu
     };
 }
 
+TEST_CASE("Benchmark Viewport Query", "[benchmark][queries]") {
+    // The console renderer's per-frame query: a 120x40 viewport over a 1M-cell world
+    GameConfig config;
+    config.setGridBoundaries(-1000, 999, -1000, 999);
+    GameOfLifeSimulation sim(config);
+
+    std::mt19937 rng(42);
+    std::bernoulli_distribution alive(0.25);
+    for (int32_t y = -1000; y < 1000; ++y) {
+        for (int32_t x = -1000; x < 1000; ++x) {
+            if (alive(rng)) {
+                sim.createCell(x, y);
+            }
+        }
+    }
+
+    std::vector<Position> buffer;
+    BENCHMARK("Viewport positions - 120x40 region from " + std::to_string(sim.getCellCount()) + " cells") {
+        buffer.clear();
+        sim.collectPositionsInRegion(-60, 59, -20, 19, buffer);
+        return buffer.size();
+    };
+
+    BENCHMARK("Viewport entities - 120x40 region") {
+        return sim.getCellsInRegion(-60, 59, -20, 19).size();
+    };
+}
+
 TEST_CASE_METHOD(BenchmarkFixture, "Benchmark Memory Operations", "[benchmark][memory]") {
     BENCHMARK("Memory usage - 1000 entities") {
         GameOfLifeSimulation sim(config);
@@ -196,6 +230,79 @@ TEST_CASE_METHOD(BenchmarkFixture, "Benchmark Complex Patterns", "[benchmark][pa
     };
 }
 
+TEST_CASE_METHOD(BenchmarkFixture, "Benchmark Tiled Thread Scaling", "[benchmark][tiled][scaling]") {
+    // Thread counts 1, 2, 4, ... up to the hardware thread count
+    std::vector<uint32_t> threadCounts;
+    uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (uint32_t threads = 1; threads < hardwareThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+    
+    GameConfig tiledConfig = config;
+    tiledConfig.setEngineType(EngineType::Tiled);
+    
+    for (uint32_t threads : threadCounts) {
+        tiledConfig.setWorkerThreads(threads);
+        GameOfLifeSimulation sim(tiledConfig);
+        createRandomPattern(sim, 200000);
+        
+        BENCHMARK("Tiled step - 1001x1001 soup, " + std::to_string(threads) + " threads") {
+            sim.step();
+            return sim.getCellCount();
+        };
+    }
+    
+    // Throughput table: cell updates per second and speedup over one thread,
+    // for the default layout, NUMA placement kept on one socket, and NUMA
+    // placement across every node. On a single-node host the last two match.
+    struct Layout {
+        const char* name;
+        bool numaPlacement;
+        uint32_t nodeLimit;
+    };
+    const Layout layouts[] = {{"default", false, 0}, {"1 socket", true, 1}, {"all sockets", true, 0}};
+    const int steps = 50;
+    const double cellsPerStep = static_cast<double>(config.getGridWidth()) * config.getGridHeight();
+    double singleThreadRate = 0.0;
+    
+    std::cout << "\nTiled engine scaling (" << steps << " steps, 1001x1001 random soup, "
+              << NumaTopology::detect().getNodeCount() << " NUMA node(s), Mcell-updates/s and speedup)\n";
+    std::cout << std::setw(8) << "threads";
+    for (const auto& layout : layouts) {
+        std::cout << std::setw(22) << layout.name;
+    }
+    std::cout << "\n";
+    
+    for (uint32_t threads : threadCounts) {
+        std::cout << std::setw(8) << threads;
+        for (const auto& layout : layouts) {
+            tiledConfig.setWorkerThreads(threads);
+            tiledConfig.setNumaPlacement(layout.numaPlacement);
+            tiledConfig.setPinWorkerThreads(layout.numaPlacement);
+            tiledConfig.setNumaNodeLimit(layout.nodeLimit);
+            GameOfLifeSimulation sim(tiledConfig);
+            createRandomPattern(sim, 200000);
+            
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < steps; ++i) {
+                sim.step();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            
+            double seconds = std::chrono::duration<double>(end - start).count();
+            double rate = cellsPerStep * steps / seconds;
+            if (singleThreadRate == 0.0) {
+                singleThreadRate = rate; // One thread, default layout
+            }
+            
+            std::cout << std::setw(13) << std::fixed << std::setprecision(1) << rate / 1e6 << std::setw(8)
+                      << std::setprecision(2) << rate / singleThreadRate << "x";
+        }
+        std::cout << "\n";
+    }
+}
+
 // Performance validation tests (not benchmarks, but performance requirements)
 TEST_CASE_METHOD(BenchmarkFixture, "Performance Requirements Validation", "[performance][validation]") {
     SECTION("Single step should complete in under 16ms for 1000 cells (60 FPS)") {
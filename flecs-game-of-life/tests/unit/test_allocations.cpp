@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/game_of_life_simulation.h>
+#include <flecs_gol/game_config.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts every operator new in the test binary
+namespace {
+std::atomic<uint64_t> allocationCount{0};
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size != 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+using namespace flecs_gol;
+
+// Two engines are left out. Sparse births and deaths are structural changes
+// to the FLECS world, which owns that memory; HashLife nodes are its memo and
+// grow with every new pattern state by design.
+TEST_CASE("Steps Allocate Nothing After Warm-Up", "[allocations]") {
+    const EngineType engines[] = {EngineType::Dense, EngineType::Tiled};
+
+    for (EngineType engine : engines) {
+        INFO("engine " << engineTypeToString(engine));
+        GameConfig config;
+        config.setGridBoundaries(0, 191, 0, 63); // Three tiles across
+        config.setWrapEdges(true);
+        config.setEngineType(engine);
+        config.setWorkerThreads(2); // Tiled steps go through the worker pool
+        GameOfLifeSimulation sim(config);
+
+        // A glider keeps births and deaths moving across the grid; the
+        // blinkers, clear of its diagonal, keep a steady churn in one place
+        for (const auto& pos : {Position(1, 0), Position(2, 1), Position(0, 2), Position(1, 2), Position(2, 2)}) {
+            sim.createCell(pos.x, pos.y);
+        }
+        for (int32_t i = 0; i < 4; ++i) {
+            sim.createCell(30 + 6 * i, 10);
+            sim.createCell(31 + 6 * i, 10);
+            sim.createCell(32 + 6 * i, 10);
+        }
+
+        // Long enough for the glider to cross into the next tile
+        for (int i = 0; i < 300; ++i) {
+            sim.step();
+        }
+
+        auto before = allocationCount.load();
+        for (int i = 0; i < 100; ++i) {
+            sim.step();
+        }
+        REQUIRE(allocationCount.load() - before == 0);
+        REQUIRE(sim.getCellCount() == 17);
+    }
+}
@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/benchmark.h>
+#include <flecs_gol/game_config.h>
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace flecs_gol;
+
+TEST_CASE("Benchmark Soups Are Seeded And Stay On The Board", "[benchmark]") {
+    const auto soup = makeSoup(64, 32, 0.25, 42);
+    REQUIRE(soup == makeSoup(64, 32, 0.25, 42));
+    REQUIRE(soup != makeSoup(64, 32, 0.25, 43));
+
+    // About a quarter of the 2048 cells
+    REQUIRE(soup.size() > 400);
+    REQUIRE(soup.size() < 620);
+    for (const auto& cell : soup) {
+        REQUIRE(cell.x >= 0);
+        REQUIRE(cell.x < 64);
+        REQUIRE(cell.y >= 0);
+        REQUIRE(cell.y < 32);
+    }
+    REQUIRE(makeSoup(8, 8, 0.0, 1).empty());
+    REQUIRE(makeSoup(8, 8, 1.0, 1).size() == 64);
+}
+
+TEST_CASE("Standard Workloads Centre The Corpus And Add The Soups", "[benchmark]") {
+    const auto directory = std::filesystem::temp_directory_path() / "flecs_gol_benchmark_patterns";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::ofstream(directory / "blinker.json") << R"({"cells": [{"x": 0, "y": 0}, {"x": 1, "y": 0}, {"x": 2, "y": 0}]})";
+    std::ofstream(directory / "notes.txt") << "not a pattern";
+
+    const auto workloads = makeStandardWorkloads(directory.string(), true);
+    REQUIRE(workloads.size() == 1 + 2 * 3);
+    REQUIRE(workloads[0].name == "pattern-blinker");
+    REQUIRE(workloads[0].cells == std::vector<Position>{{126, 127}, {127, 127}, {128, 127}});
+    REQUIRE(workloads[1].name == "soup-64-d10");
+    REQUIRE(workloads.back().name == "soup-256-d50");
+    REQUIRE(makeStandardWorkloads(directory.string()).size() == 1 + 3 * 3);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Every Engine Runs A Workload To The Same Board", "[benchmark]") {
+    // A glider far from the edges, so the unbounded HashLife plane agrees too
+    const BenchmarkWorkload workload{"glider", 64, 64, {{31, 30}, {32, 31}, {30, 32}, {31, 32}, {32, 32}}, 20};
+    for (EngineType engine : {EngineType::Sparse, EngineType::Dense, EngineType::Tiled, EngineType::HashLife}) {
+        INFO(engineTypeToString(engine));
+        const auto result = runBenchmark(GameConfig{}, engine, workload, 2);
+        REQUIRE(result.engine == engineTypeToString(engine));
+        REQUIRE(result.generations == 20);
+        REQUIRE(result.finalCells == 5);
+        REQUIRE(result.minNanosPerStep <= result.medianNanosPerStep);
+        REQUIRE(result.memoryBytes > 0);
+    }
+}
+
+TEST_CASE("Benchmark Results Diff Against A Baseline", "[benchmark]") {
+    std::vector<BenchmarkResult> before(2);
+    before[0] = {"dense", "soup-64-d25", 400, 1000, 900, 10, 1024};
+    before[1] = {"sparse", "soup-64-d25", 400, 5000, 4000, 10, 2048};
+    const auto baseline = benchmarkResultsToJson(before, "flecs");
+    REQUIRE(baseline["baseline_type"] == "benchmark");
+    REQUIRE(baseline["benchmarks"]["dense/soup-64-d25"]["median_ns_per_step"] == 1000);
+
+    auto after = before;
+    after[0].medianNanosPerStep = 1200; // 20% slower
+    after[1].medianNanosPerStep = 5200; // 4% slower
+    after.push_back({"tiled", "soup-64-d25", 400, 100, 90, 10, 512}); // Not in the baseline
+    const auto regressions = findRegressions(baseline, benchmarkResultsToJson(after, "flecs"), 0.1);
+    REQUIRE(regressions.size() == 1);
+    REQUIRE(regressions[0].key == "dense/soup-64-d25");
+    REQUIRE(regressions[0].baselineNanosPerStep == 1000);
+    REQUIRE(regressions[0].currentNanosPerStep == 1200);
+
+    REQUIRE(findRegressions(baseline, benchmarkResultsToJson(after, "flecs"), 0.25).empty());
+    REQUIRE(findRegressions(nlohmann::json::object(), baseline, 0.1).empty());
+}
@@ -0,0 +1,166 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/board_ensemble.h>
+#include <flecs_gol/game_config.h>
+#include <flecs_gol/game_of_life_simulation.h>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> boardCells(const BoardEnsemble& ensemble, uint64_t id) {
+    std::vector<Position> cells;
+    ensemble.collectBoardCells(id, cells);
+    return sorted(cells);
+}
+
+const BoardResult& resultOf(const std::vector<BoardResult>& results, uint64_t id) {
+    return *std::find_if(results.begin(), results.end(), [id](const BoardResult& r) { return r.id == id; });
+}
+
+} // namespace
+
+TEST_CASE("Ensemble Boards Match The Dense Engine", "[board_ensemble]") {
+    struct Scenario {
+        int32_t width;
+        int32_t height;
+        bool wrap;
+        LifeRule rule;
+    };
+
+    // The widest board fills the word up to its last ghost bit
+    const std::vector<Scenario> scenarios{{32, 24, false, CONWAY_RULE}, {32, 24, true, CONWAY_RULE},
+                                          {62, 9, true, CONWAY_RULE},   {7, 40, false, CONWAY_RULE},
+                                          {20, 20, true, HIGHLIFE_RULE}};
+
+    for (const auto& scenario : scenarios) {
+        INFO("board " << scenario.width << "x" << scenario.height << " wrap " << scenario.wrap << " rule "
+                      << scenario.rule.toString());
+        BoardEnsemble ensemble(scenario.width, scenario.height, scenario.wrap, scenario.rule);
+
+        GameConfig config;
+        config.setGridBoundaries(0, scenario.width - 1, 0, scenario.height - 1);
+        config.setWrapEdges(scenario.wrap);
+        config.setEngineType(EngineType::Dense);
+        config.setRule(scenario.rule);
+
+        // Enough boards to use every SIMD width and leave a scalar tail
+        std::vector<std::pair<uint64_t, std::unique_ptr<GameOfLifeSimulation>>> boards;
+        for (uint32_t seed = 0; seed < 37; ++seed) {
+            const auto id = ensemble.addRandomBoard(0.35, seed);
+            auto reference = std::make_unique<GameOfLifeSimulation>(config);
+            for (const auto& pos : boardCells(ensemble, id)) {
+                reference->createCell(pos.x, pos.y);
+            }
+            boards.emplace_back(id, std::move(reference));
+        }
+
+        for (int generation = 0; generation < 60; ++generation) {
+            ensemble.step();
+            for (auto& [id, reference] : boards) {
+                if (!reference) {
+                    continue;
+                }
+                reference->step();
+                if (!ensemble.isRunning(id)) {
+                    reference.reset(); // Ended; its outcome is checked below
+                    continue;
+                }
+                REQUIRE(boardCells(ensemble, id) == sorted(reference->getLivePositions()));
+            }
+        }
+
+        std::vector<BoardResult> results;
+        ensemble.collectResults(results);
+        REQUIRE(results.size() + ensemble.getRunningCount() == boards.size());
+        for (const auto& result : results) {
+            REQUIRE(result.generations <= 60);
+            REQUIRE((result.outcome == BoardOutcome::DiedOut) == (result.finalCells == 0));
+        }
+    }
+}
+
+TEST_CASE("Ensemble Boards End With Their Outcome", "[board_ensemble]") {
+    BoardEnsemble ensemble(16, 16, true);
+    ensemble.setGenerationLimit(10);
+
+    const auto blinker = ensemble.addBoard(std::vector<Position>{{5, 4}, {5, 5}, {5, 6}});
+    const auto block = ensemble.addBoard(std::vector<Position>{{2, 2}, {3, 2}, {2, 3}, {3, 3}});
+    const auto lone = ensemble.addBoard(std::vector<Position>{{8, 8}, {-1, 3}, {16, 0}}); // Two are off the board
+    const auto glider = ensemble.addBoard(std::vector<Position>{{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}});
+    const auto retired = ensemble.addBoard(std::vector<Position>{{0, 0}, {1, 0}, {2, 0}});
+    REQUIRE(ensemble.getRunningCount() == 5);
+
+    SECTION("Each board reports how it ended") {
+        REQUIRE(ensemble.retireBoard(retired));
+        REQUIRE_FALSE(ensemble.retireBoard(retired));
+
+        ensemble.setRecordFinalCells(true);
+        ensemble.step(20);
+        REQUIRE(ensemble.getRunningCount() == 0);
+
+        std::vector<BoardResult> results;
+        ensemble.collectResults(results);
+        REQUIRE(results.size() == 5);
+
+        REQUIRE(resultOf(results, retired).outcome == BoardOutcome::Retired);
+        REQUIRE(resultOf(results, retired).generations == 0);
+
+        REQUIRE(resultOf(results, block).outcome == BoardOutcome::StillLife);
+        REQUIRE(resultOf(results, block).generations == 1);
+        REQUIRE(resultOf(results, block).finalCells == 4);
+        REQUIRE(sorted(resultOf(results, block).cells) == sorted({{2, 2}, {3, 2}, {2, 3}, {3, 3}}));
+        REQUIRE(resultOf(results, retired).cells.empty()); // Retired before recording was turned on
+
+        REQUIRE(resultOf(results, lone).outcome == BoardOutcome::DiedOut);
+        REQUIRE(resultOf(results, lone).initialCells == 1);
+        REQUIRE(resultOf(results, lone).finalCells == 0);
+
+        REQUIRE(resultOf(results, blinker).outcome == BoardOutcome::Oscillator);
+        REQUIRE(resultOf(results, blinker).generations == 2);
+
+        REQUIRE(resultOf(results, glider).outcome == BoardOutcome::GenerationLimit);
+        REQUIRE(resultOf(results, glider).generations == 10);
+        REQUIRE(resultOf(results, glider).finalCells == 5);
+
+        // Results are handed out once
+        results.clear();
+        ensemble.collectResults(results);
+        REQUIRE(results.empty());
+    }
+
+    SECTION("Boards moved into freed lanes keep their cells") {
+        ensemble.setGenerationLimit(0);
+        ensemble.step(3);
+        REQUIRE(ensemble.getRunningCount() == 1);
+        REQUIRE(ensemble.isRunning(glider));
+
+        // A glider moves one cell diagonally every four generations, across the wrapped edges
+        ensemble.step(4 * 16 - 3);
+        REQUIRE(boardCells(ensemble, glider) == sorted({{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}}));
+
+        // Lanes freed by ended boards are reused, and start empty
+        const auto added = ensemble.addBoard(std::vector<Position>{{5, 4}, {5, 5}, {5, 6}});
+        REQUIRE(ensemble.getRunningCount() == 2);
+        ensemble.step();
+        REQUIRE(boardCells(ensemble, added) == sorted({{4, 5}, {5, 5}, {6, 5}}));
+        ensemble.step();
+        REQUIRE_FALSE(ensemble.isRunning(added)); // Period 2 is seen once it has run two generations
+        REQUIRE(ensemble.isRunning(glider));
+    }
+}
+
+TEST_CASE("Ensemble Board Sizes Are Checked", "[board_ensemble]") {
+    REQUIRE_THROWS_AS(BoardEnsemble(0, 8, false), std::invalid_argument);
+    REQUIRE_THROWS_AS(BoardEnsemble(BoardEnsemble::MAX_WIDTH + 1, 8, false), std::invalid_argument);
+    REQUIRE_THROWS_AS(BoardEnsemble(8, 0, true), std::invalid_argument);
+    REQUIRE_NOTHROW(BoardEnsemble(BoardEnsemble::MAX_WIDTH, 1, true));
+}
@@ -0,0 +1,167 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/checkpoint_writer.h>
+#include <flecs_gol/simulation_controller.h>
+#include <flecs_gol/snapshot_file.h>
+#include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> readCells(const std::string& path) {
+    SnapshotReader reader(path);
+    std::vector<Position> cells;
+    reader.readRuns([&cells](int32_t x, int32_t y, uint32_t length) {
+        for (uint32_t i = 0; i < length; ++i) {
+            cells.emplace_back(x + static_cast<int32_t>(i), y);
+        }
+    });
+    return sorted(cells);
+}
+
+std::vector<Position> snapshotCells(const GridSnapshot& snapshot) {
+    std::vector<Position> cells;
+    snapshot.cells.collectRegion(-1000, 1000, -1000, 1000, cells);
+    return sorted(cells);
+}
+
+} // namespace
+
+TEST_CASE("Checkpoint Writer Writes In The Background", "[checkpoint]") {
+    const std::string path = tempPath("flecs_gol_checkpoint_writer.gols");
+    CheckpointWriter writer;
+
+    // The first job holds the writer thread until released, so the next ones queue up
+    std::atomic<bool> release{false};
+    SnapshotInfo info;
+    info.gridWidth = 32;
+    info.gridHeight = 32;
+    writer.submit(path, info, [&release](std::vector<Position>& out) {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        out.emplace_back(1, 1);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));  // Taken up by the writer
+
+    for (uint64_t generation = 1; generation <= 3; ++generation) {
+        info.generation = generation;
+        writer.submit(path, info, [generation](std::vector<Position>& out) {
+            out.emplace_back(static_cast<int32_t>(generation), 2);
+        });
+    }
+    REQUIRE(writer.getStats().written == 0);
+    release = true;
+    writer.waitIdle();
+
+    // Only the newest of the queued three was written after the first
+    auto stats = writer.getStats();
+    REQUIRE(stats.written == 2);
+    REQUIRE(stats.superseded == 2);
+    REQUIRE(stats.failed == 0);
+    REQUIRE(stats.lastGeneration == 3);
+    REQUIRE(SnapshotReader(path).getInfo().generation == 3);
+    REQUIRE(readCells(path) == std::vector<Position>{Position(3, 2)});
+
+    // Failures are counted and the writer carries on
+    writer.submit(tempPath("flecs_gol_missing_dir/board.gols"), info, [](std::vector<Position>&) {});
+    writer.submit(path, info, [](std::vector<Position>& out) { out.emplace_back(0, 0); });
+    writer.waitIdle();
+    stats = writer.getStats();
+    REQUIRE(stats.failed == 1);
+    REQUIRE_FALSE(stats.lastError.empty());
+    REQUIRE(stats.written == 3);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Controller Checkpoints Every Interval", "[checkpoint][simulation_controller]") {
+    const std::string path = tempPath("flecs_gol_controller_checkpoint.gols");
+    std::filesystem::remove(path);
+
+    GameConfig config;
+    config.setGridBoundaries(-20, 19, -20, 19);
+    config.setWrapEdges(true);
+    config.setCheckpointPath(path);
+    config.setCheckpointInterval(10);
+    SimulationController controller(config);
+    for (const auto& pos : {Position(1, 0), Position(2, 1), Position(0, 2), Position(1, 2), Position(2, 2)}) {
+        controller.addCell(pos.x, pos.y);
+    }
+
+    std::vector<std::vector<Position>> boards;
+    for (int generation = 1; generation <= 25; ++generation) {
+        controller.step();
+        boards.push_back(snapshotCells(*controller.getSnapshot()));
+    }
+    controller.waitForCheckpoints();
+    auto stats = controller.getCheckpointStats();
+    REQUIRE(stats.written + stats.superseded == 2);  // At 10 and 20
+    REQUIRE(stats.lastGeneration == 20);
+    REQUIRE(readCells(path) == boards[19]);
+
+    // A multi-step call crossing a multiple checkpoints where it lands
+    controller.step(7);
+    controller.waitForCheckpoints();
+    REQUIRE(controller.getCheckpointStats().lastGeneration == 32);
+
+    // On demand, to another file, and the run resumes from it
+    const std::string manual = tempPath("flecs_gol_controller_manual.gols");
+    controller.checkpoint(manual);
+    const auto expected = snapshotCells(*controller.getSnapshot());
+    controller.step();
+    controller.waitForCheckpoints();
+
+    SimulationController resumed(GameConfig{});
+    resumed.loadSnapshot(manual);
+    REQUIRE(resumed.getState().generation == 32);
+    REQUIRE(snapshotCells(*resumed.getSnapshot()) == expected);
+    REQUIRE(resumed.getConfig().getWrapEdges());
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(manual);
+}
+
+TEST_CASE("Checkpoints Keep The Board They Were Asked For", "[checkpoint][simulation_controller]") {
+    const std::string path = tempPath("flecs_gol_checkpoint_stall.gols");
+    GameConfig config;
+    config.setGridBoundaries(-256, 255, -256, 255);
+    config.setEngineType(EngineType::Tiled);
+    config.setWorkerThreads(1);
+    SimulationController controller(config);
+    for (int32_t y = -200; y < 200; y += 3) {
+        for (int32_t x = -200; x < 200; x += 2) {
+            controller.addCell(x, y);
+            controller.addCell(x + 1, y + 1);
+        }
+    }
+
+    // The board is frozen when the checkpoint is asked for, whatever steps follow
+    controller.checkpoint(path);
+    const auto frozen = snapshotCells(*controller.getSnapshot());
+    for (int i = 0; i < 5; ++i) {
+        controller.step();
+    }
+    controller.waitForCheckpoints();
+    REQUIRE(controller.getCheckpointStats().written == 1);
+    REQUIRE(SnapshotReader(path).getInfo().generation == 0);
+    REQUIRE(readCells(path) == frozen);
+
+    std::filesystem::remove(path);
+}
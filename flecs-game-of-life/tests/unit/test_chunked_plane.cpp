@@ -0,0 +1,175 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/chunked_plane.h>
+#include <flecs_gol/game_config.h>
+#include <flecs_gol/life_engine.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using namespace flecs_gol;
+
+namespace {
+
+const std::vector<Position> GLIDER = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+
+constexpr int32_t INT_MIN_32 = std::numeric_limits<int32_t>::min();
+constexpr int32_t INT_MAX_32 = std::numeric_limits<int32_t>::max();
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> liveCells(const ChunkedPlane& plane) {
+    std::vector<Position> cells;
+    plane.collectLiveCells(cells);
+    return sorted(cells);
+}
+
+} // namespace
+
+TEST_CASE("Chunked Engine Configuration", "[chunked_plane]") {
+    REQUIRE(engineTypeFromString("chunked") == EngineType::Chunked);
+    REQUIRE(std::string(engineTypeToString(EngineType::Chunked)) == "chunked");
+
+    GameConfig config;
+    config.setEngineType(EngineType::Chunked);
+    auto restored = GameConfig::fromJson(config.toJson());
+    REQUIRE(restored.getEngineType() == EngineType::Chunked);
+}
+
+TEST_CASE("Chunked Plane Cell Storage", "[chunked_plane]") {
+    ChunkedPlane plane;
+
+    SECTION("Cells anywhere on the 32-bit plane are accepted") {
+        REQUIRE(plane.setCell(0, 0, true));
+        REQUIRE(plane.setCell(-1, -1, true));
+        REQUIRE(plane.setCell(-2000000000, 2000000000, true));
+        REQUIRE(plane.setCell(0, 0, true)); // Setting twice keeps one cell
+
+        REQUIRE(plane.getCellCount() == 3);
+        REQUIRE(plane.getChunkCount() == 3);
+        REQUIRE(plane.isCellAlive(-2000000000, 2000000000));
+        REQUIRE_FALSE(plane.isCellAlive(1, 0));
+        REQUIRE(plane.getNeighborCount(0, -1) == 2);
+
+        REQUIRE(plane.setCell(-1, -1, false));
+        REQUIRE(liveCells(plane) == sorted({{0, 0}, {-2000000000, 2000000000}}));
+    }
+
+    SECTION("Region query clips to the region") {
+        for (const auto& pos : std::vector<Position>{{0, 0}, {63, 64}, {64, 63}, {-65, 2}}) {
+            plane.setCell(pos.x, pos.y, true);
+        }
+        std::vector<Position> region;
+        plane.collectCellsInRegion(-65, 63, 0, 64, region);
+        REQUIRE(sorted(region) == sorted({{0, 0}, {63, 64}, {-65, 2}}));
+    }
+}
+
+TEST_CASE("Chunked Plane Matches HashLife Across Chunk Borders", "[chunked_plane]") {
+    // A soup straddling the origin covers negative chunks and every chunk edge
+    std::mt19937 rng(34);
+    std::vector<Position> soup;
+    for (int32_t y = -70; y < 70; ++y) {
+        for (int32_t x = -70; x < 70; ++x) {
+            if (rng() % 3 == 0) {
+                soup.emplace_back(x, y);
+            }
+        }
+    }
+
+    for (const auto& rule : {CONWAY_RULE, HIGHLIFE_RULE, *LifeRule::parse("B36/S125")}) {
+        GameConfig config;
+        config.setRule(rule);
+        config.setEngineType(EngineType::Chunked);
+        auto chunked = createLifeEngine(config);
+        config.setEngineType(EngineType::HashLife);
+        auto reference = createLifeEngine(config);
+        chunked->createCells(soup);
+        reference->createCells(soup);
+
+        for (int generation = 0; generation < 30; ++generation) {
+            INFO(rule.toString() << " generation " << generation);
+            chunked->step();
+            reference->step();
+            REQUIRE(sorted(chunked->getLivePositions()) == sorted(reference->getLivePositions()));
+            REQUIRE(sorted(chunked->getBornCells()) == sorted(reference->getBornCells()));
+            REQUIRE(sorted(chunked->getDiedCells()) == sorted(reference->getDiedCells()));
+            REQUIRE(chunked->getCellCount() == reference->getCellCount());
+        }
+    }
+}
+
+TEST_CASE("Chunked Plane Gliders Leave The Grid Boundaries", "[chunked_plane]") {
+    // The default [-500, 500] box would stop the glider; the chunked plane ignores it
+    GameConfig config;
+    config.setEngineType(EngineType::Chunked);
+    auto engine = createLifeEngine(config);
+    engine->createCells(GLIDER);
+    for (int generation = 0; generation < 4000; ++generation) {
+        engine->step();
+    }
+
+    // A glider moves one cell diagonally every four generations
+    std::vector<Position> expected;
+    for (const auto& pos : GLIDER) {
+        expected.emplace_back(pos.x + 1000, pos.y + 1000);
+    }
+    REQUIRE(sorted(engine->getLivePositions()) == sorted(expected));
+
+    // Only the chunks around the glider are held, never the path behind it
+    ChunkedPlane plane;
+    for (const auto& pos : GLIDER) {
+        plane.setCell(-pos.x, -pos.y, true);
+    }
+    for (int generation = 0; generation < 4000; ++generation) {
+        plane.step();
+        REQUIRE(plane.getChunkCount() <= 4);
+    }
+    REQUIRE(plane.getCellCount() == 5);
+    REQUIRE(plane.isCellAlive(-1001, -1000));
+}
+
+TEST_CASE("Chunked Plane Frees Empty Chunks", "[chunked_plane]") {
+    ChunkedPlane plane;
+    // Lone cells in the middle of 64 chunks: all die, and nothing spills over
+    for (int32_t chunk = 0; chunk < 64; ++chunk) {
+        plane.setCell(chunk * 64 + 32, 32, true);
+    }
+    REQUIRE(plane.getChunkCount() == 64);
+    const size_t peak = plane.getMemoryUsage();
+
+    plane.step();
+    REQUIRE(plane.getChunkCount() == 0);
+    std::vector<Position> born;
+    std::vector<Position> died;
+    plane.collectChanges(born, died);
+    REQUIRE(born.empty());
+    REQUIRE(died.size() == 64);
+
+    int32_t minX, maxX, minY, maxY;
+    REQUIRE(plane.getActiveBounds(minX, maxX, minY, maxY));
+    REQUIRE(minX == 0);
+    REQUIRE(maxX == 64 * 64 - 1);
+
+    // The next step lets go of the generation buffers that held them
+    plane.step();
+    REQUIRE_FALSE(plane.getActiveBounds(minX, maxX, minY, maxY));
+    REQUIRE(plane.getMemoryUsage() < peak / 4);
+}
+
+TEST_CASE("Chunked Plane Cells Past The 32-bit Range Stay Dead", "[chunked_plane]") {
+    ChunkedPlane plane;
+    // Vertical blinker on the last column: the cell it would put past it is never born
+    for (int32_t y = 0; y < 3; ++y) {
+        plane.setCell(INT_MAX_32, y, true);
+    }
+    plane.step();
+    REQUIRE(liveCells(plane) == std::vector<Position>{{INT_MAX_32 - 1, 1}, {INT_MAX_32, 1}});
+
+    for (int32_t x = 0; x < 3; ++x) {
+        plane.setCell(INT_MIN_32 + x, INT_MIN_32, true);
+    }
+    REQUIRE(plane.getNeighborCount(INT_MIN_32, INT_MIN_32) == 1);
+}
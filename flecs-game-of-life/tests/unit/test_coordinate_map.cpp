@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/coordinate_map.h>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+
+using namespace flecs_gol;
+
+TEST_CASE("Coordinate Map Basic Operations", "[coordinate_map]") {
+    CoordinateMap<int> map;
+    REQUIRE(map.empty());
+    REQUIRE(map.find(Position(0, 0)) == map.end());
+
+    SECTION("Insert, find and overwrite") {
+        map[Position(1, 2)] = 10;
+        map[Position(-1, -2)] = 20;
+        REQUIRE(map.size() == 2);
+        REQUIRE(map.find(Position(1, 2))->second == 10);
+        REQUIRE(map.find(Position(-1, -2))->second == 20);
+        REQUIRE_FALSE(map.contains(Position(2, 1)));
+
+        map[Position(1, 2)] = 30;
+        REQUIRE(map.size() == 2);
+        REQUIRE(map.find(Position(1, 2))->second == 30);
+
+        REQUIRE_FALSE(map.insert(Position(1, 2), 40));
+        REQUIRE(map.insert(Position(5, 5), 50));
+        REQUIRE(map.find(Position(1, 2))->second == 30);
+    }
+
+    SECTION("Extreme coordinates stay distinct") {
+        map[Position(INT32_MIN, INT32_MAX)] = 1;
+        map[Position(INT32_MAX, INT32_MIN)] = 2;
+        map[Position(-1, 0)] = 3;
+        map[Position(0, -1)] = 4;
+        REQUIRE(map.size() == 4);
+        REQUIRE(map.find(Position(INT32_MIN, INT32_MAX))->second == 1);
+        REQUIRE(map.find(Position(INT32_MAX, INT32_MIN))->second == 2);
+        REQUIRE(map.find(Position(-1, 0))->second == 3);
+        REQUIRE(map.find(Position(0, -1))->second == 4);
+    }
+
+    SECTION("Erase by key and by iterator") {
+        map[Position(3, 3)] = 1;
+        map[Position(4, 4)] = 2;
+        REQUIRE(map.erase(Position(3, 3)) == 1);
+        REQUIRE(map.erase(Position(3, 3)) == 0);
+
+        map.erase(map.find(Position(4, 4)));
+        REQUIRE(map.empty());
+    }
+
+    SECTION("Clear keeps the slot array") {
+        for (int32_t i = 0; i < 100; ++i) {
+            map[Position(i, -i)] = i;
+        }
+        size_t capacity = map.capacity();
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(map.capacity() == capacity);
+        REQUIRE_FALSE(map.contains(Position(5, -5)));
+    }
+}
+
+TEST_CASE("Coordinate Map Matches Ordered Map", "[coordinate_map]") {
+    // Random inserts and erases in a small window force long probe runs and
+    // many backward shifts
+    CoordinateMap<int> map;
+    std::map<Position, int> reference;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int32_t> coord(-40, 40);
+
+    for (int op = 0; op < 20000; ++op) {
+        Position pos(coord(rng), coord(rng));
+        if (rng() % 3 == 0) {
+            REQUIRE(map.erase(pos) == reference.erase(pos));
+        } else {
+            map[pos] = op;
+            reference[pos] = op;
+        }
+    }
+
+    REQUIRE(map.size() == reference.size());
+    for (const auto& [pos, value] : reference) {
+        auto it = map.find(pos);
+        REQUIRE(it != map.end());
+        REQUIRE(it->second == value);
+    }
+
+    // Iteration visits every entry exactly once
+    std::set<Position> visited;
+    for (const auto& [pos, value] : map) {
+        REQUIRE(visited.insert(pos).second);
+        REQUIRE(reference.at(pos) == value);
+    }
+    REQUIRE(visited.size() == reference.size());
+}
+
+TEST_CASE("Position Hash Spreads Diagonal Patterns", "[coordinate_map]") {
+    // A long diagonal, as left by a glider stream, must not pile onto a few buckets
+    constexpr size_t BUCKETS = 1024;
+    std::set<size_t> buckets;
+    for (int32_t i = -512; i < 512; ++i) {
+        buckets.insert(std::hash<Position>{}(Position(i, i)) % BUCKETS);
+    }
+    REQUIRE(buckets.size() > BUCKETS / 2);
+}
+
+TEST_CASE("Position Morton Key Follows Z-Order", "[coordinate_map]") {
+    // Each 2x2 block is visited x-first, then the blocks in the same Z
+    const std::vector<Position> zOrder = {{0, 0}, {1, 0}, {0, 1}, {1, 1}, {2, 0}, {3, 0}, {2, 1}, {3, 1},
+                                          {0, 2}, {1, 2}, {0, 3}, {1, 3}, {2, 2}, {3, 2}, {2, 3}, {3, 3}};
+    for (size_t i = 1; i < zOrder.size(); ++i) {
+        REQUIRE(zOrder[i - 1].morton() < zOrder[i].morton());
+    }
+
+    // Negative coordinates come first, and the extremes stay distinct
+    REQUIRE(Position(-1, -1).morton() < Position(0, 0).morton());
+    REQUIRE(Position(-1, 0).morton() < Position(0, 0).morton());
+    constexpr int32_t MIN = std::numeric_limits<int32_t>::min();
+    constexpr int32_t MAX = std::numeric_limits<int32_t>::max();
+    REQUIRE(Position(MIN, MIN).morton() == 0);
+    REQUIRE(Position(MAX, MAX).morton() == ~uint64_t{0});
+}
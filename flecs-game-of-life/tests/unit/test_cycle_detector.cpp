@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/cycle_detector.h>
+#include <flecs_gol/game_of_life_simulation.h>
+#include <flecs_gol/game_config.h>
+#include <optional>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+// Steps the simulation, feeding its changes to the detector, until a cycle is found
+std::optional<CycleDetector::Cycle> runUntilCycle(GameOfLifeSimulation& sim, CycleDetector& detector,
+                                                  uint32_t maxGenerations) {
+    for (const auto& pos : sim.getLivePositions()) {
+        detector.add(pos);
+    }
+    detector.record(sim.getGeneration());
+
+    for (uint32_t i = 0; i < maxGenerations; ++i) {
+        sim.step();
+        for (const auto& pos : sim.getBornCells()) {
+            detector.add(pos);
+        }
+        for (const auto& pos : sim.getDiedCells()) {
+            detector.remove(pos);
+        }
+        if (auto cycle = detector.record(sim.getGeneration())) {
+            return cycle;
+        }
+    }
+    return std::nullopt;
+}
+
+GameConfig makeConfig(EngineType engine) {
+    GameConfig config;
+    config.setGridBoundaries(-50, 50, -50, 50);
+    config.setEngineType(engine);
+    return config;
+}
+
+} // namespace
+
+TEST_CASE("Cycle Detector Hashes Shapes Independently Of Position", "[cycle_detector]") {
+    const std::vector<Position> glider = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+
+    CycleDetector detector;
+    for (const auto& pos : glider) {
+        detector.add(pos);
+    }
+    REQUIRE_FALSE(detector.record(0).has_value());
+
+    // Same shape moved by (-7, 12)
+    for (const auto& pos : glider) {
+        detector.remove(pos);
+    }
+    for (const auto& pos : glider) {
+        detector.add(Position(pos.x - 7, pos.y + 12));
+    }
+    auto cycle = detector.record(3);
+    REQUIRE(cycle.has_value());
+    REQUIRE(cycle->period == 3);
+    REQUIRE(cycle->dx == -7);
+    REQUIRE(cycle->dy == 12);
+    REQUIRE(cycle->startGeneration == 0);
+
+    // One cell more is a different shape
+    detector.add(Position(40, 40));
+    REQUIRE_FALSE(detector.record(4).has_value());
+    REQUIRE(detector.size() == glider.size() + 1);
+
+    detector.clear();
+    REQUIRE(detector.size() == 0);
+    REQUIRE_FALSE(detector.record(5).has_value());
+}
+
+TEST_CASE("Cycle Detector Finds Exact Cycles", "[cycle_detector]") {
+    struct Case {
+        const char* name;
+        std::vector<Position> cells;
+        uint32_t period;
+        int32_t dx;
+        int32_t dy;
+    };
+    const std::vector<Case> cases = {
+        {"block", {{0, 0}, {1, 0}, {0, 1}, {1, 1}}, 1, 0, 0},
+        {"blinker", {{-1, 0}, {0, 0}, {1, 0}}, 2, 0, 0},
+        {"glider", {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}}, 4, 1, 1},
+    };
+    const EngineType engines[] = {EngineType::Sparse, EngineType::Dense, EngineType::Tiled, EngineType::HashLife};
+
+    for (EngineType engine : engines) {
+        for (const auto& pattern : cases) {
+            INFO("engine " << engineTypeToString(engine) << ", " << pattern.name);
+            GameOfLifeSimulation sim(makeConfig(engine));
+            for (const auto& pos : pattern.cells) {
+                sim.createCell(pos.x, pos.y);
+            }
+
+            CycleDetector detector;
+            auto cycle = runUntilCycle(sim, detector, 10);
+            REQUIRE(cycle.has_value());
+            REQUIRE(cycle->period == pattern.period);
+            REQUIRE(cycle->dx == pattern.dx);
+            REQUIRE(cycle->dy == pattern.dy);
+
+            // Found the first time the state repeats
+            REQUIRE(sim.getGeneration() == pattern.period);
+        }
+
+        // The R-pentomino keeps a steady population at times but takes over a
+        // thousand generations to settle
+        INFO("engine " << engineTypeToString(engine) << ", R-pentomino");
+        GameOfLifeSimulation sim(makeConfig(engine));
+        for (const auto& pos : {Position(1, 0), Position(2, 0), Position(0, 1), Position(1, 1), Position(1, 2)}) {
+            sim.createCell(pos.x, pos.y);
+        }
+        CycleDetector detector;
+        REQUIRE_FALSE(runUntilCycle(sim, detector, 40).has_value());
+    }
+}
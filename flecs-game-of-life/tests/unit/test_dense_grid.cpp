@@ -0,0 +1,160 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/game_of_life_simulation.h>
+#include <flecs_gol/dense_grid.h>
+#include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <random>
+
+using namespace flecs_gol;
+
+namespace {
+
+GameConfig makeConfig(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY, bool wrap, EngineType engine) {
+    GameConfig config;
+    config.setGridBoundaries(minX, maxX, minY, maxY);
+    config.setWrapEdges(wrap);
+    config.setEngineType(engine);
+    return config;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+void seedRandom(GameOfLifeSimulation& sim, const GameConfig& config, double density, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution alive(density);
+    for (int32_t y = config.getGridMinY(); y <= config.getGridMaxY(); ++y) {
+        for (int32_t x = config.getGridMinX(); x <= config.getGridMaxX(); ++x) {
+            if (alive(rng)) {
+                sim.createCell(x, y);
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Dense Grid Cell Storage", "[dense]") {
+    auto config = makeConfig(-10, 10, -5, 5, false, EngineType::Dense);
+    DenseGrid grid(config);
+
+    SECTION("Set and clear cells inside boundaries") {
+        REQUIRE(grid.setCell(-10, -5, true));
+        REQUIRE(grid.setCell(10, 5, true));
+        REQUIRE(grid.setCell(0, 0, true));
+        REQUIRE(grid.setCell(0, 0, true)); // Setting twice keeps one cell
+        REQUIRE(grid.getCellCount() == 3);
+        REQUIRE(grid.isCellAlive(-10, -5));
+        REQUIRE(grid.isCellAlive(10, 5));
+
+        REQUIRE(grid.setCell(0, 0, false));
+        REQUIRE(grid.getCellCount() == 2);
+        REQUIRE_FALSE(grid.isCellAlive(0, 0));
+    }
+
+    SECTION("Reject cells outside boundaries") {
+        REQUIRE_FALSE(grid.setCell(-11, 0, true));
+        REQUIRE_FALSE(grid.setCell(11, 0, true));
+        REQUIRE_FALSE(grid.setCell(0, 6, true));
+        REQUIRE(grid.getCellCount() == 0);
+        REQUIRE_FALSE(grid.isCellAlive(11, 0));
+    }
+
+    SECTION("Region query clips to region and grid") {
+        grid.setCell(0, 0, true);
+        grid.setCell(5, 5, true);
+        grid.setCell(-10, 2, true);
+
+        std::vector<Position> cells;
+        grid.collectCellsInRegion(-1, 10, -1, 10, cells);
+        REQUIRE(sorted(cells) == std::vector<Position>{Position(0, 0), Position(5, 5)});
+
+        cells.clear();
+        grid.collectLiveCells(cells);
+        REQUIRE(cells.size() == 3);
+    }
+}
+
+TEST_CASE("Dense Grid Rules", "[dense][rules]") {
+    auto config = makeConfig(-500, 500, -500, 500, false, EngineType::Dense);
+    GameOfLifeSimulation simulation(config);
+    REQUIRE_FALSE(simulation.usesEntityStorage());
+
+    SECTION("Blinker oscillates") {
+        simulation.createCell(-1, 0);
+        simulation.createCell(0, 0);
+        simulation.createCell(1, 0);
+
+        simulation.step();
+        REQUIRE(simulation.getCellCount() == 3);
+        REQUIRE(simulation.isCellAlive(0, -1));
+        REQUIRE(simulation.isCellAlive(0, 1));
+        REQUIRE_FALSE(simulation.isCellAlive(-1, 0));
+
+        simulation.step();
+        REQUIRE(simulation.isCellAlive(-1, 0));
+        REQUIRE(simulation.isCellAlive(1, 0));
+        REQUIRE(simulation.getGeneration() == 2);
+    }
+
+    SECTION("Block is stable") {
+        simulation.createCell(0, 0);
+        simulation.createCell(1, 0);
+        simulation.createCell(0, 1);
+        simulation.createCell(1, 1);
+
+        simulation.step();
+        simulation.step();
+        REQUIRE(simulation.getCellCount() == 4);
+        REQUIRE(simulation.getNeighborCount(0, 0) == 3);
+    }
+
+    SECTION("Word boundaries do not break neighbor counting") {
+        // Columns 63 and 64 of the grid straddle two 64-bit words
+        int32_t x = -500 + 63;
+        simulation.createCell(x, 0);
+        simulation.createCell(x + 1, 0);
+        simulation.createCell(x + 2, 0);
+
+        simulation.step();
+        REQUIRE(simulation.isCellAlive(x + 1, -1));
+        REQUIRE(simulation.isCellAlive(x + 1, 1));
+        REQUIRE(simulation.getCellCount() == 3);
+    }
+}
+
+TEST_CASE("Dense Grid Matches Sparse Engine", "[dense][equivalence]") {
+    struct Scenario {
+        int32_t minX, maxX, minY, maxY;
+        bool wrap;
+    };
+
+    const std::vector<Scenario> scenarios = {
+        {-20, 20, -20, 20, false},
+        {-20, 20, -20, 20, true},
+        {0, 69, 0, 9, true},     // Width not a multiple of 64, wrapping across word boundary
+        {0, 127, -3, 3, false},  // Exactly two words per row
+    };
+
+    for (const auto& scenario : scenarios) {
+        auto sparseConfig = makeConfig(scenario.minX, scenario.maxX, scenario.minY, scenario.maxY,
+                                       scenario.wrap, EngineType::Sparse);
+        auto denseConfig = makeConfig(scenario.minX, scenario.maxX, scenario.minY, scenario.maxY,
+                                      scenario.wrap, EngineType::Dense);
+
+        GameOfLifeSimulation sparse(sparseConfig);
+        GameOfLifeSimulation dense(denseConfig);
+        seedRandom(sparse, sparseConfig, 0.35, 7);
+        seedRandom(dense, denseConfig, 0.35, 7);
+
+        for (int generation = 0; generation < 20; ++generation) {
+            REQUIRE(sorted(dense.getLivePositions()) == sorted(sparse.getLivePositions()));
+            sparse.step();
+            dense.step();
+        }
+
+        REQUIRE(dense.getCellCount() == sparse.getCellCount());
+    }
+}
@@ -0,0 +1,194 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/game_of_life_simulation.h>
+#include <flecs_gol/dense_grid.h>
+#include <flecs_gol/dense_kernels.h>
+#include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <random>
+
+using namespace flecs_gol;
+
+namespace {
+
+bool bitAt(const std::vector<uint64_t>& row, int64_t col) {
+    // Guard word at index 0, data from index 1
+    return (row[static_cast<size_t>(col >> 6) + 1] >> (col & 63)) & 1u;
+}
+
+// Per-cell reference for one row of padded words
+std::vector<uint64_t> referenceRow(const std::vector<uint64_t>& above, const std::vector<uint64_t>& row,
+                                   const std::vector<uint64_t>& below, size_t words) {
+    std::vector<uint64_t> out(words, 0);
+    const std::vector<uint64_t>* rows[3] = {&above, &row, &below};
+
+    for (int64_t col = 0; col < static_cast<int64_t>(words * 64); ++col) {
+        int count = 0;
+        for (int r = 0; r < 3; ++r) {
+            for (int64_t dx = -1; dx <= 1; ++dx) {
+                if (r == 1 && dx == 0) continue;
+                count += bitAt(*rows[r], col + dx) ? 1 : 0;
+            }
+        }
+        bool alive = bitAt(row, col);
+        if (count == 3 || (alive && count == 2)) {
+            out[static_cast<size_t>(col >> 6)] |= uint64_t{1} << (col & 63);
+        }
+    }
+    return out;
+}
+
+GameConfig makeConfig(int32_t width, int32_t height, bool wrap, EngineType engine) {
+    GameConfig config;
+    config.setGridBoundaries(0, width - 1, 0, height - 1);
+    config.setWrapEdges(wrap);
+    config.setEngineType(engine);
+    return config;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+// Runs the same pattern through the sparse engine and a dense grid forced onto `kernel`
+void requireMatchesSparse(const DenseKernel& kernel, int32_t width, int32_t height, bool wrap,
+                          const std::vector<Position>& pattern, int generations) {
+    auto sparseConfig = makeConfig(width, height, wrap, EngineType::Sparse);
+    GameOfLifeSimulation sparse(sparseConfig);
+
+    DenseGrid dense(makeConfig(width, height, wrap, EngineType::Dense));
+    dense.setKernel(kernel);
+
+    for (const auto& pos : pattern) {
+        sparse.createCell(pos.x, pos.y);
+        dense.setCell(pos.x, pos.y, true);
+    }
+
+    for (int gen = 0; gen < generations; ++gen) {
+        sparse.step();
+        dense.step();
+
+        std::vector<Position> denseCells;
+        dense.collectLiveCells(denseCells);
+        REQUIRE(sorted(denseCells) == sorted(sparse.getLivePositions()));
+        REQUIRE(dense.getCellCount() == sparse.getCellCount());
+    }
+}
+
+} // namespace
+
+TEST_CASE("Dense Kernel Dispatch", "[dense][kernel]") {
+    auto kernels = availableDenseKernels();
+
+    SECTION("Scalar kernel is always available") {
+        REQUIRE_FALSE(kernels.empty());
+        REQUIRE(std::string(kernels.front().name) == "scalar");
+        REQUIRE(findDenseKernel("scalar") != nullptr);
+        REQUIRE(findDenseKernel("no-such-kernel") == nullptr);
+    }
+
+    SECTION("Selected kernel is the most capable available one") {
+        REQUIRE(std::string(selectDenseKernel().name) == kernels.back().name);
+
+        DenseGrid grid(makeConfig(8, 8, false, EngineType::Dense));
+        REQUIRE(std::string(grid.getKernelName()) == selectDenseKernel().name);
+    }
+}
+
+TEST_CASE("Dense Kernel Row Results", "[dense][kernel]") {
+    std::mt19937_64 rng(2024);
+
+    for (const auto& kernel : availableDenseKernels()) {
+        SECTION(std::string("Kernel ") + kernel.name + " matches per-cell reference") {
+            // Word counts cover the vector body, the scalar tail, and both together
+            for (size_t words : {1u, 2u, 3u, 4u, 5u, 7u, 8u, 13u}) {
+                for (int trial = 0; trial < 20; ++trial) {
+                    std::vector<uint64_t> rows[3];
+                    for (auto& row : rows) {
+                        row.assign(words + 2, 0);
+                        for (size_t w = 1; w <= words; ++w) {
+                            // Mix sparse and dense words
+                            row[w] = (trial % 2 == 0) ? rng() : (rng() & rng() & rng());
+                        }
+                    }
+
+                    std::vector<uint64_t> out(words, 0);
+                    kernel.stepRow(rows[0].data() + 1, rows[1].data() + 1, rows[2].data() + 1, out.data(), words);
+
+                    REQUIRE(out == referenceRow(rows[0], rows[1], rows[2], words));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Dense Kernel Rule Equivalence", "[dense][kernel]") {
+    for (const auto& kernel : availableDenseKernels()) {
+        SECTION(std::string("Kernel ") + kernel.name) {
+            // Blinker, block, and glider on bounded and wrapped grids
+            std::vector<Position> blinker = {{4, 5}, {5, 5}, {6, 5}};
+            std::vector<Position> block = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+            std::vector<Position> glider = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+
+            requireMatchesSparse(kernel, 10, 10, false, blinker, 4);
+            requireMatchesSparse(kernel, 10, 10, false, block, 3);
+            requireMatchesSparse(kernel, 10, 10, true, block, 3);
+            requireMatchesSparse(kernel, 10, 10, true, glider, 40);
+
+            // Patterns straddling word boundaries and the wrapped right edge
+            std::vector<Position> edge = {{62, 3}, {63, 3}, {64, 3}, {65, 4}, {129, 7}, {0, 7}, {1, 7}};
+            requireMatchesSparse(kernel, 130, 12, true, edge, 8);
+            requireMatchesSparse(kernel, 130, 12, false, edge, 8);
+
+            // Death by isolation and overcrowding, birth from three neighbors
+            std::vector<Position> mixed = {{2, 2}, {7, 7}, {7, 8}, {8, 7}, {8, 8}, {6, 7}, {20, 2}, {21, 2}, {22, 3}};
+            requireMatchesSparse(kernel, 64, 16, false, mixed, 5);
+        }
+    }
+}
+
+TEST_CASE("Dense Kernel Large Bounded Board", "[dense][kernel]") {
+    const int32_t size = 1000;
+    std::mt19937 rng(7);
+    std::bernoulli_distribution alive(0.3);
+
+    std::vector<Position> seed;
+    for (int32_t y = 0; y < size; ++y) {
+        for (int32_t x = 0; x < size; ++x) {
+            if (alive(rng)) {
+                seed.emplace_back(x, y);
+            }
+        }
+    }
+
+    // The scalar kernel is the reference for every vector kernel
+    const DenseKernel* scalar = findDenseKernel("scalar");
+    REQUIRE(scalar != nullptr);
+
+    DenseGrid reference(makeConfig(size, size, false, EngineType::Dense));
+    reference.setKernel(*scalar);
+    for (const auto& pos : seed) {
+        reference.setCell(pos.x, pos.y, true);
+    }
+    for (int gen = 0; gen < 5; ++gen) {
+        reference.step();
+    }
+    std::vector<Position> expected;
+    reference.collectLiveCells(expected);
+
+    for (const auto& kernel : availableDenseKernels()) {
+        DenseGrid grid(makeConfig(size, size, false, EngineType::Dense));
+        grid.setKernel(kernel);
+        for (const auto& pos : seed) {
+            grid.setCell(pos.x, pos.y, true);
+        }
+        for (int gen = 0; gen < 5; ++gen) {
+            grid.step();
+        }
+
+        std::vector<Position> actual;
+        grid.collectLiveCells(actual);
+        INFO("Kernel " << kernel.name);
+        REQUIRE(actual == expected);
+    }
+}
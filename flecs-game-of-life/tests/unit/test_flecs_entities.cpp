@@ -2,6 +2,7 @@
 #include <flecs_gol/game_of_life_simulation.h>
 #include <flecs_gol/components.h>
 #include <flecs_gol/game_config.h>
+#include <vector>
 
 using namespace flecs_gol;
 
@@ -60,6 +61,32 @@ TEST_CASE("FLECS Entity Creation and Destruction", "[flecs][entities]") {
         // Second creation should return same entity or invalid entity
         REQUIRE((cell2 == cell1 || !cell2.is_alive()));
     }
+    
+    SECTION("Bulk creation skips duplicates, live cells and invalid positions") {
+        GameConfig bounded;
+        bounded.setGridBoundaries(-10, 10, -10, 10);
+        GameOfLifeSimulation bulk(bounded);
+        bulk.createCell(0, 0);
+        
+        const std::vector<Position> cells = {{0, 0}, {1, 0}, {2, 0}, {1, 0}, {-10, 10}, {50, 0}, {2, 0}};
+        bulk.createCells(cells);
+        
+        REQUIRE(bulk.getCellCount() == 4);
+        REQUIRE(bulk.getAllCells().size() == 4);
+        for (const auto& pos : {Position(0, 0), Position(1, 0), Position(2, 0), Position(-10, 10)}) {
+            auto entity = bulk.getCellAt(pos.x, pos.y);
+            REQUIRE(entity.is_alive());
+            REQUIRE(entity.get<Position>() == pos);
+            REQUIRE(entity.has<Cell>());
+        }
+        REQUIRE_FALSE(bulk.isCellAlive(50, 0));
+        
+        // Bulk-created cells step like any others
+        bulk.step();
+        REQUIRE(bulk.isCellAlive(1, -1));
+        REQUIRE(bulk.isCellAlive(1, 1));
+        REQUIRE_FALSE(bulk.isCellAlive(-10, 10));
+    }
 }
 
 TEST_CASE("FLECS Component Management", "[flecs][components]") {
@@ -270,4 +297,93 @@ TEST_CASE("FLECS World State Management", "[flecs][state]") {
         REQUIRE(simulation.getGeneration() == 0);
         REQUIRE(simulation.getCellCount() == 0);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("FLECS Incremental Step", "[flecs][state]") {
+    GameConfig config;
+    GameOfLifeSimulation simulation(config);
+    
+    SECTION("Still life keeps its entities") {
+        auto a = simulation.createCell(0, 0);
+        auto b = simulation.createCell(1, 0);
+        auto c = simulation.createCell(0, 1);
+        auto d = simulation.createCell(1, 1);
+        
+        simulation.step();
+        simulation.step();
+        
+        REQUIRE(simulation.getCellCount() == 4);
+        REQUIRE(simulation.getCellAt(0, 0) == a);
+        REQUIRE(simulation.getCellAt(1, 0) == b);
+        REQUIRE(simulation.getCellAt(0, 1) == c);
+        REQUIRE(simulation.getCellAt(1, 1) == d);
+        REQUIRE(a.is_alive());
+    }
+    
+    SECTION("Only births and deaths change entities") {
+        // Horizontal blinker: the center survives, the ends die, two cells are born
+        auto left = simulation.createCell(-1, 0);
+        auto center = simulation.createCell(0, 0);
+        auto right = simulation.createCell(1, 0);
+        
+        simulation.step();
+        
+        REQUIRE(simulation.getCellCount() == 3);
+        REQUIRE(simulation.getCellAt(0, 0) == center);
+        REQUIRE(center.is_alive());
+        REQUIRE_FALSE(left.is_alive());
+        REQUIRE_FALSE(right.is_alive());
+        REQUIRE(simulation.isCellAlive(0, -1));
+        REQUIRE(simulation.isCellAlive(0, 1));
+        
+        auto top = simulation.getCellAt(0, -1);
+        simulation.step();
+        
+        REQUIRE(simulation.getCellAt(0, 0) == center);
+        REQUIRE_FALSE(top.is_alive());
+        REQUIRE(simulation.isCellAlive(-1, 0));
+        REQUIRE(simulation.isCellAlive(1, 0));
+    }
+}
+
+TEST_CASE("FLECS Pipeline Phases", "[flecs][systems]") {
+    GameConfig config;
+    config.setWorkerThreads(2);
+    GameOfLifeSimulation simulation(config);
+    
+    SECTION("Neighbor phase creates birth candidate entities") {
+        // L-tromino: (1,1) has exactly three live neighbors
+        simulation.createCell(0, 0);
+        simulation.createCell(1, 0);
+        simulation.createCell(0, 1);
+        
+        simulation.updateNeighborCounts();
+        
+        REQUIRE(simulation.getCellAt(0, 0).get<Cell>().neighborCount == 2);
+        REQUIRE(simulation.getCellCount() == 3);
+        
+        // Repeated passes replace candidates rather than accumulating them
+        simulation.updateNeighborCounts();
+        simulation.step();
+        
+        REQUIRE(simulation.getCellCount() == 4);
+        REQUIRE(simulation.isCellAlive(1, 1));
+        REQUIRE(simulation.getCellAt(1, 1).has<Cell>());
+        REQUIRE_FALSE(simulation.getCellAt(1, 1).has<BirthCandidate>());
+    }
+    
+    SECTION("Phases record timings for a populated grid") {
+        for (int32_t y = 0; y < 60; ++y) {
+            for (int32_t x = 0; x < 60; ++x) {
+                if ((x * 7 + y * 13) % 3 == 0) {
+                    simulation.createCell(x, y);
+                }
+            }
+        }
+        
+        simulation.step();
+        
+        auto metrics = simulation.getPerformanceMetrics();
+        REQUIRE(metrics.neighborCountTimeMicros > 0);
+        REQUIRE(metrics.lifecycleTimeMicros > 0);
+    }
+}
@@ -57,7 +57,9 @@ TEST_CASE("GameConfig JSON Deserialization", "[config]") {
         },
         "simulation": {
             "targetFPS": 30,
-            "maxGenerations": 1000
+            "maxGenerations": 1000,
+            "generationsPerFrame": 16,
+            "frameStepBudgetMs": 12
         },
         "performance": {
             "maxEntities": 750000,
@@ -75,6 +77,8 @@ TEST_CASE("GameConfig JSON Deserialization", "[config]") {
         REQUIRE(config.getWrapEdges() == true);
         REQUIRE(config.getTargetFPS() == 30);
         REQUIRE(config.getMaxGenerations() == 1000);
+        REQUIRE(config.getGenerationsPerFrame() == 16);
+        REQUIRE(config.getFrameStepBudgetMs() == 12);
         REQUIRE(config.getMaxEntities() == 750000);
         REQUIRE_FALSE(config.getEnableProfiling());
     }
@@ -138,6 +142,13 @@ TEST_CASE("GameConfig Validation", "[config]") {
         REQUIRE_FALSE(config.validate());
     }
     
+    SECTION("Frames must advance at least one generation") {
+        GameConfig config;
+        config.setGenerationsPerFrame(0);
+        
+        REQUIRE_FALSE(config.validate());
+    }
+    
     SECTION("Invalid max entities fails validation") {
         GameConfig config;
         config.setMaxEntities(0);
@@ -164,4 +175,115 @@ TEST_CASE("GameConfig Boundary Calculations", "[config]") {
         REQUIRE_FALSE(config.isPointInBounds(151, 0));
         REQUIRE_FALSE(config.isPointInBounds(0, 26));
     }
-}
\ No newline at end of file
+}
+TEST_CASE("GameConfig Engine Selection", "[config]") {
+    SECTION("Defaults to sparse entity storage") {
+        GameConfig config;
+        REQUIRE(config.getEngineType() == EngineType::Sparse);
+    }
+    
+    SECTION("Engine type round-trips through JSON") {
+        GameConfig config;
+        config.setEngineType(EngineType::Dense);
+        
+        json j = config.toJson();
+        REQUIRE(j["performance"]["engine"] == "dense");
+        
+        GameConfig loaded = GameConfig::fromJson(j);
+        REQUIRE(loaded.getEngineType() == EngineType::Dense);
+    }
+    
+    SECTION("Unknown engine names keep the default") {
+        json j = R"({"performance": {"engine": "quantum"}})"_json;
+        REQUIRE(GameConfig::fromJson(j).getEngineType() == EngineType::Sparse);
+    }
+}
+
+TEST_CASE("GameConfig Worker Threads", "[config]") {
+    GameConfig config;
+    REQUIRE(config.getWorkerThreads() == 0);
+    
+    config.setWorkerThreads(4);
+    json j = config.toJson();
+    REQUIRE(j["performance"]["workerThreads"] == 4);
+    REQUIRE(GameConfig::fromJson(j).getWorkerThreads() == 4);
+}
+
+TEST_CASE("GameConfig NUMA Placement", "[config]") {
+    GameConfig config;
+    REQUIRE_FALSE(config.getNumaPlacement());
+    REQUIRE_FALSE(config.getPinWorkerThreads());
+    REQUIRE(config.getNumaNodeLimit() == 0);
+    
+    config.setNumaPlacement(true);
+    config.setPinWorkerThreads(true);
+    config.setNumaNodeLimit(1);
+    json j = config.toJson();
+    REQUIRE(j["performance"]["numaPlacement"] == true);
+    auto restored = GameConfig::fromJson(j);
+    REQUIRE(restored.getNumaPlacement());
+    REQUIRE(restored.getPinWorkerThreads());
+    REQUIRE(restored.getNumaNodeLimit() == 1);
+}
+
+TEST_CASE("GameConfig HashLife Step Size", "[config]") {
+    GameConfig config;
+    REQUIRE(config.getHashLifeStepLog2() == 0);
+    
+    config.setEngineType(EngineType::HashLife);
+    config.setHashLifeStepLog2(10);
+    json j = config.toJson();
+    REQUIRE(j["performance"]["engine"] == "hashlife");
+    REQUIRE(j["performance"]["hashlifeStepLog2"] == 10);
+    
+    GameConfig loaded = GameConfig::fromJson(j);
+    REQUIRE(loaded.getEngineType() == EngineType::HashLife);
+    REQUIRE(loaded.getHashLifeStepLog2() == 10);
+    
+    config.setHashLifeStepLog2(49);
+    REQUIRE_FALSE(config.validate());
+}
+
+TEST_CASE("GameConfig Adaptive Engine", "[config]") {
+    GameConfig config;
+    REQUIRE_FALSE(config.getAdaptiveEngine());
+    REQUIRE(config.getSparseDensityThreshold() < config.getDenseDensityThreshold());
+    
+    config.setAdaptiveEngine(true);
+    config.setDenseDensityThreshold(0.25);
+    config.setSparseDensityThreshold(0.125);
+    json j = config.toJson();
+    REQUIRE(j["performance"]["adaptiveEngine"] == true);
+    
+    GameConfig loaded = GameConfig::fromJson(j);
+    REQUIRE(loaded.getAdaptiveEngine());
+    REQUIRE(loaded.getDenseDensityThreshold() == 0.25);
+    REQUIRE(loaded.getSparseDensityThreshold() == 0.125);
+    REQUIRE(loaded.validate());
+    
+    // The sparse threshold must sit below the dense one
+    config.setSparseDensityThreshold(0.25);
+    REQUIRE_FALSE(config.validate());
+    config.setSparseDensityThreshold(-0.1);
+    REQUIRE_FALSE(config.validate());
+}
+
+TEST_CASE("GameConfig Cell Sort Interval", "[config]") {
+    GameConfig config;
+    REQUIRE(config.getCellSortInterval() == 64);
+    
+    config.setCellSortInterval(0);
+    json j = config.toJson();
+    REQUIRE(j["performance"]["cellSortInterval"] == 0);
+    REQUIRE(GameConfig::fromJson(j).getCellSortInterval() == 0);
+}
+
+TEST_CASE("GameConfig History Budget", "[config]") {
+    GameConfig config;
+    REQUIRE(config.getHistoryBudgetMB() == 16);
+    
+    config.setHistoryBudgetMB(0);
+    json j = config.toJson();
+    REQUIRE(j["performance"]["historyBudgetMB"] == 0);
+    REQUIRE(GameConfig::fromJson(j).getHistoryBudgetMB() == 0);
+}
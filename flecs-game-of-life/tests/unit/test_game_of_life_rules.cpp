@@ -2,6 +2,9 @@
 #include <flecs_gol/game_of_life_simulation.h>
 #include <flecs_gol/components.h>
 #include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <random>
+#include <vector>
 
 using namespace flecs_gol;
 
@@ -245,4 +248,38 @@ TEST_CASE("Neighbor Counting Accuracy", "[rules]") {
         // Position (0,0) has no cell but should count 3 neighbors
         REQUIRE(simulation.getNeighborCount(0, 0) == 3);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Sorting Cells Into Z-Order Leaves The Board Unchanged", "[rules]") {
+    GameConfig sortedConfig;
+    sortedConfig.setCellSortInterval(1); // Sort after every step
+    GameConfig unsortedConfig;
+    unsortedConfig.setCellSortInterval(0);
+    GameOfLifeSimulation sorted(sortedConfig);
+    GameOfLifeSimulation unsorted(unsortedConfig);
+    
+    std::mt19937 rng(36);
+    std::vector<Position> soup;
+    for (int32_t y = -30; y < 30; ++y) {
+        for (int32_t x = -30; x < 30; ++x) {
+            if (rng() % 3 == 0) {
+                soup.emplace_back(x, y);
+            }
+        }
+    }
+    sorted.createCells(soup);
+    unsorted.createCells(soup);
+    
+    auto positions = [](const GameOfLifeSimulation& simulation) {
+        auto cells = simulation.getLivePositions();
+        std::sort(cells.begin(), cells.end());
+        return cells;
+    };
+    for (int generation = 0; generation < 50; ++generation) {
+        INFO("generation " << generation);
+        sorted.step();
+        unsorted.step();
+        REQUIRE(positions(sorted) == positions(unsorted));
+        REQUIRE(sorted.getBornCells().size() == unsorted.getBornCells().size());
+    }
+}
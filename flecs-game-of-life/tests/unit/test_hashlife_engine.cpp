@@ -0,0 +1,199 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/game_of_life_simulation.h>
+#include <flecs_gol/hashlife_engine.h>
+#include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <iterator>
+#include <random>
+
+using namespace flecs_gol;
+
+namespace {
+
+// entts-game-of-life/config/gosper_gun.json
+const std::vector<Position> GOSPER_GUN = {
+    {5, 6}, {5, 7}, {6, 6}, {6, 7},
+    {15, 6}, {15, 7}, {15, 8}, {16, 5}, {16, 9}, {17, 4}, {17, 10}, {18, 4}, {18, 10},
+    {19, 7}, {20, 5}, {20, 9}, {21, 6}, {21, 7}, {21, 8}, {22, 7},
+    {25, 4}, {25, 5}, {25, 6}, {26, 4}, {26, 5}, {26, 6}, {27, 3}, {27, 7},
+    {29, 2}, {29, 3}, {29, 7}, {29, 8},
+    {39, 4}, {39, 5}, {40, 4}, {40, 5}};
+
+// patterns/acorn.json
+const std::vector<Position> ACORN = {{1, 0}, {3, 1}, {0, 2}, {1, 2}, {4, 2}, {5, 2}, {6, 2}};
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> liveCells(const HashLifeEngine& engine) {
+    std::vector<Position> cells;
+    engine.collectLiveCells(cells);
+    return sorted(cells);
+}
+
+void place(HashLifeEngine& engine, const std::vector<Position>& cells) {
+    for (const auto& pos : cells) {
+        engine.setCell(pos.x, pos.y, true);
+    }
+}
+
+} // namespace
+
+TEST_CASE("HashLife Cell Storage", "[hashlife]") {
+    HashLifeEngine engine;
+
+    SECTION("Cells anywhere on the plane are accepted") {
+        REQUIRE(engine.setCell(0, 0, true));
+        REQUIRE(engine.setCell(-1, -1, true));
+        REQUIRE(engine.setCell(-2000000000, 2000000000, true));
+        REQUIRE(engine.setCell(0, 0, true)); // Setting twice keeps one cell
+
+        REQUIRE(engine.getCellCount() == 3);
+        REQUIRE(engine.isCellAlive(-2000000000, 2000000000));
+        REQUIRE(engine.getNeighborCount(0, -1) == 2);
+    }
+
+    SECTION("Region query clips to the region") {
+        place(engine, {{0, 0}, {5, 5}, {-10, 2}});
+
+        std::vector<Position> cells;
+        engine.collectCellsInRegion(-1, 10, -1, 10, cells);
+        REQUIRE(sorted(cells) == std::vector<Position>{Position(0, 0), Position(5, 5)});
+    }
+}
+
+TEST_CASE("HashLife Matches Sparse Engine", "[hashlife]") {
+    GameConfig config;
+    config.setGridBoundaries(-100, 100, -100, 100);
+    GameOfLifeSimulation sparse(config);
+
+    config.setEngineType(EngineType::HashLife);
+    GameOfLifeSimulation hashLife(config);
+    REQUIRE_FALSE(hashLife.usesEntityStorage());
+
+    // A soup at the origin never reaches the boundaries in 40 generations
+    std::mt19937 rng(5);
+    std::bernoulli_distribution alive(0.4);
+    for (int32_t y = -10; y < 10; ++y) {
+        for (int32_t x = -10; x < 10; ++x) {
+            if (alive(rng)) {
+                sparse.createCell(x, y);
+                hashLife.createCell(x, y);
+            }
+        }
+    }
+
+    for (int generation = 0; generation < 40; ++generation) {
+        sparse.step();
+        hashLife.step();
+        REQUIRE(hashLife.getCellCount() == sparse.getCellCount());
+        REQUIRE(sorted(hashLife.getLivePositions()) == sorted(sparse.getLivePositions()));
+    }
+}
+
+TEST_CASE("HashLife Step Size", "[hashlife]") {
+    SECTION("One step of 2^k generations equals 2^k single steps") {
+        HashLifeEngine single;
+        HashLifeEngine batched(8);
+        place(single, ACORN);
+        place(batched, ACORN);
+
+        for (int generation = 0; generation < 256; ++generation) {
+            single.step();
+        }
+        batched.step();
+
+        REQUIRE(liveCells(batched) == liveCells(single));
+    }
+
+    SECTION("Simulation generations advance by the step size") {
+        GameConfig config;
+        config.setEngineType(EngineType::HashLife);
+        config.setHashLifeStepLog2(4);
+        GameOfLifeSimulation sim(config);
+
+        sim.createCell(0, 1);
+        sim.createCell(1, 1);
+        sim.createCell(2, 1);
+        sim.step();
+
+        REQUIRE(sim.getGeneration() == 16);
+        // A blinker is back in its starting phase after an even number of generations
+        REQUIRE(sim.isCellAlive(0, 1));
+        REQUIRE_FALSE(sim.isCellAlive(1, 0));
+        REQUIRE(sim.getCellCount() == 3);
+    }
+
+    SECTION("Step exponents above the maximum are rejected") {
+        HashLifeEngine engine;
+        REQUIRE_THROWS_AS(engine.setStepLog2(HashLifeEngine::MAX_STEP_LOG2 + 1), std::out_of_range);
+    }
+}
+
+TEST_CASE("HashLife Long Runs", "[hashlife]") {
+    SECTION("Acorn stabilizes at generation 5206 with 633 cells") {
+        HashLifeEngine engine;
+        place(engine, ACORN);
+
+        engine.advance(5206);
+        REQUIRE(engine.getCellCount() == 633);
+    }
+
+    SECTION("The Gosper gun keeps firing after a million generations") {
+        HashLifeEngine engine(20);
+        place(engine, GOSPER_GUN);
+        engine.step();
+        REQUIRE(engine.lastStepChanged());
+
+        // One five-cell glider every 30 generations
+        uint32_t population = engine.getCellCount();
+        engine.advance(30);
+        REQUIRE(engine.getCellCount() == population + 5);
+    }
+
+    SECTION("A small node limit rebuilds the store without changing the result") {
+        HashLifeEngine reference;
+        HashLifeEngine limited(0, 2000);
+        place(reference, ACORN);
+        place(limited, ACORN);
+
+        for (int generation = 0; generation < 300; ++generation) {
+            reference.step();
+            limited.step();
+        }
+
+        REQUIRE(limited.getNodeCount() < reference.getNodeCount());
+        REQUIRE(liveCells(limited) == liveCells(reference));
+    }
+}
+
+TEST_CASE("HashLife Step Changes", "[hashlife][changes]") {
+    // An advance spans several steps and, with a small node limit, several rebuilds
+    HashLifeEngine engine(0, 2000);
+    place(engine, ACORN);
+    auto before = liveCells(engine);
+
+    engine.advance(1000);
+    auto after = liveCells(engine);
+
+    std::vector<Position> born;
+    std::vector<Position> died;
+    engine.collectChanges(born, died);
+
+    std::vector<Position> expectedBorn;
+    std::vector<Position> expectedDied;
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(expectedBorn));
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(expectedDied));
+    REQUIRE(sorted(born) == expectedBorn);
+    REQUIRE(sorted(died) == expectedDied);
+
+    // A cleared engine has no changes to report
+    engine.clear();
+    born.clear();
+    died.clear();
+    engine.collectChanges(born, died);
+    REQUIRE(born.empty());
+    REQUIRE(died.empty());
+}
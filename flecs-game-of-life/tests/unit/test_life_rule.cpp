@@ -0,0 +1,181 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/dense_kernels.h>
+#include <flecs_gol/game_config.h>
+#include <flecs_gol/life_engine.h>
+#include <flecs_gol/life_rule.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+bool bitAt(const std::vector<uint64_t>& row, int64_t x) {
+    // Guard word at index 0, data from index 1
+    return (row[static_cast<size_t>(x >> 6) + 1] >> (x & 63)) & 1u;
+}
+
+// Per-cell reference for one row of guarded words under any rule
+std::vector<uint64_t> referenceRow(const std::vector<uint64_t>& above, const std::vector<uint64_t>& row,
+                                        const std::vector<uint64_t>& below, size_t words,
+                                        const LifeRule& rule) {
+    std::vector<uint64_t> out(words, 0);
+    const std::vector<uint64_t>* rows[3] = {&above, &row, &below};
+
+    for (int64_t x = 0; x < static_cast<int64_t>(words * 64); ++x) {
+        uint32_t neighbors = 0;
+        for (int r = 0; r < 3; ++r) {
+            for (int64_t dx = -1; dx <= 1; ++dx) {
+                if (r == 1 && dx == 0) continue;
+                neighbors += bitAt(*rows[r], x + dx) ? 1 : 0;
+            }
+        }
+        if (rule.nextState(bitAt(row, x), neighbors)) {
+            out[static_cast<size_t>(x >> 6)] |= uint64_t{1} << (x & 63);
+        }
+    }
+    return out;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+// Specialized rules, and two only the run-time masks handle (one with S0)
+const std::vector<LifeRule> TEST_RULES = {CONWAY_RULE, HIGHLIFE_RULE, DAY_AND_NIGHT_RULE, SEEDS_RULE,
+                                          *LifeRule::parse("B36/S125"), *LifeRule::parse("B3/S012345678")};
+
+} // namespace
+
+TEST_CASE("Rulestrings Parse In B/S And S/B Notation", "[life_rule]") {
+    REQUIRE(LifeRule::parse("B3/S23") == CONWAY_RULE);
+    REQUIRE(LifeRule::parse("b3/s23") == CONWAY_RULE);
+    REQUIRE(LifeRule::parse("S23/B3") == CONWAY_RULE);
+    REQUIRE(LifeRule::parse("23/3") == CONWAY_RULE);
+    REQUIRE(LifeRule::parse(" B36/S23 ") == HIGHLIFE_RULE);
+    REQUIRE(LifeRule::parse("B3678/S34678") == DAY_AND_NIGHT_RULE);
+    REQUIRE(LifeRule::parse("B2/S") == SEEDS_RULE);
+
+    REQUIRE(HIGHLIFE_RULE.toString() == "B36/S23");
+    REQUIRE(SEEDS_RULE.toString() == "B2/S");
+    REQUIRE(LifeRule::parse("S8/B1")->toString() == "B1/S8");
+
+    REQUIRE_FALSE(LifeRule::parse(""));
+    REQUIRE_FALSE(LifeRule::parse("B3S23"));
+    REQUIRE_FALSE(LifeRule::parse("B9/S23"));
+    REQUIRE_FALSE(LifeRule::parse("B3/S2x"));
+    REQUIRE_FALSE(LifeRule::parse("B03/S23")); // B0 is unsupported
+}
+
+TEST_CASE("Config Files Carry The Rule", "[life_rule]") {
+    GameConfig config;
+    REQUIRE(config.getRule() == CONWAY_RULE);
+
+    config.setRule(HIGHLIFE_RULE);
+    REQUIRE(config.toJson()["simulation"]["rule"] == "B36/S23");
+
+    REQUIRE(GameConfig::fromJson(config.toJson()).getRule() == HIGHLIFE_RULE);
+
+    auto json = config.toJson();
+    json["simulation"]["rule"] = "B0/S";
+    REQUIRE_THROWS_AS(GameConfig::fromJson(json), std::invalid_argument);
+}
+
+TEST_CASE("Dense Rule Kernels Match A Per-Cell Reference", "[life_rule]") {
+    std::mt19937_64 rng(2024);
+
+    for (const auto& kernel : availableDenseKernels()) {
+        for (const auto& rule : TEST_RULES) {
+            INFO(kernel.name << " " << rule.toString());
+            // Word counts cover the vector body, the scalar tail, and both together
+            for (size_t words : {1u, 3u, 4u, 5u}) {
+                for (int trial = 0; trial < 10; ++trial) {
+                    std::vector<uint64_t> rows[3];
+                    for (auto& row : rows) {
+                        row.assign(words + 2, 0);
+                        for (size_t w = 1; w <= words; ++w) {
+                            row[w] = (trial % 2 == 0) ? rng() : (rng() & rng() & rng());
+                        }
+                    }
+
+                    std::vector<uint64_t> out(words, 0);
+                    kernel.stepRowRule(rows[0].data() + 1, rows[1].data() + 1, rows[2].data() + 1, out.data(), words,
+                                       rule);
+                    REQUIRE(out == referenceRow(rows[0], rows[1], rows[2], words, rule));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Every Engine Follows The Configured Rule", "[life_rule]") {
+    std::mt19937 rng(7);
+    std::vector<Position> soup;
+    for (int32_t y = 40; y < 60; ++y) {
+        for (int32_t x = 40; x < 60; ++x) {
+            if (rng() % 3 == 0) {
+                soup.emplace_back(x, y);
+            }
+        }
+    }
+
+    for (const auto& rule : TEST_RULES) {
+        for (bool wrap : {false, true}) {
+            GameConfig config;
+            config.setGridBoundaries(0, 99, 0, 89);
+            config.setWrapEdges(wrap);
+            config.setRule(rule);
+
+            auto reference = createLifeEngine(config);
+            reference->createCells(soup);
+
+            std::vector<std::unique_ptr<LifeEngine>> engines;
+            // HashLife's and the chunked plane are unbounded, so they only join while nothing reaches an edge
+            for (EngineType engine : {EngineType::Dense, EngineType::Tiled, EngineType::HashLife,
+                                      EngineType::Chunked}) {
+                config.setEngineType(engine);
+                engines.push_back(createLifeEngine(config));
+                engines.back()->createCells(soup);
+            }
+
+            for (int generation = 0; generation < 8; ++generation) {
+                reference->step();
+                const auto expected = sorted(reference->getLivePositions());
+                for (const auto& engine : engines) {
+                    INFO(rule.toString() << " wrap " << wrap << " "
+                                         << engineTypeToString(engine->getConfig().getEngineType()));
+                    engine->step();
+                    REQUIRE(sorted(engine->getLivePositions()) == expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Seeds And HighLife Differ From Conway", "[life_rule]") {
+    GameConfig config;
+    config.setRule(SEEDS_RULE);
+
+    // Under Seeds a domino dies and gives birth above and below itself
+    auto seeds = createLifeEngine(config);
+    seeds->createCells(std::vector<Position>{{10, 10}, {11, 10}});
+    seeds->step();
+    REQUIRE(sorted(seeds->getLivePositions()) == std::vector<Position>{{10, 9}, {10, 11}, {11, 9}, {11, 11}});
+
+    // Six neighbors: a birth under HighLife only
+    const std::vector<Position> six = {{9, 9}, {10, 9}, {11, 9}, {9, 11}, {10, 11}, {11, 11}};
+    config.setRule(HIGHLIFE_RULE);
+    auto highLife = createLifeEngine(config);
+    highLife->createCells(six);
+    highLife->step();
+    REQUIRE(highLife->isCellAlive(10, 10));
+
+    config.setRule(CONWAY_RULE);
+    auto conway = createLifeEngine(config);
+    conway->createCells(six);
+    conway->step();
+    REQUIRE_FALSE(conway->isCellAlive(10, 10));
+}
@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/metrics.h>
+#include <flecs_gol/simulation_controller.h>
+#include <flecs_gol/simulation_store.h>
+#include <flecs_gol/game_config.h>
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace flecs_gol;
+
+TEST_CASE("Latency Histogram Quantiles Stay Within A Bucket Of The Truth", "[metrics]") {
+    LatencyHistogram histogram;
+    REQUIRE(histogram.getQuantile(0.99) == 0);
+
+    // 1us .. 1ms in 1us steps; the true p-quantile is p * 1000us
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        histogram.record(i * 1000);
+    }
+    REQUIRE(histogram.getCount() == 1000);
+    REQUIRE(histogram.getMax() == 1'000'000);
+    REQUIRE(histogram.getSum() == 500'500'000);
+
+    for (double quantile : {0.5, 0.9, 0.99, 0.999}) {
+        const double truth = quantile * 1'000'000;
+        const auto value = static_cast<double>(histogram.getQuantile(quantile));
+        REQUIRE(value >= truth);
+        REQUIRE(value <= truth * (1.0 + 1.0 / LatencyHistogram::SUB_BUCKETS));
+    }
+    REQUIRE(histogram.getQuantile(1.0) == 1'000'000);
+
+    // Small values are exact
+    histogram.reset();
+    histogram.record(std::chrono::nanoseconds(7));
+    REQUIRE(histogram.getQuantile(0.5) == 7);
+    REQUIRE(histogram.getCount() == 1);
+}
+
+TEST_CASE("Metrics Export As Prometheus Text And JSON", "[metrics]") {
+    SimulationMetrics metrics;
+    metrics.stepNanos.record(std::chrono::microseconds(250));
+    metrics.recordChanges(5, 3);
+    metrics.livingCells = 42;
+
+    const LabelledMetrics simulations[] = {{"board \"a\"", &metrics}};
+    std::ostringstream out;
+    writePrometheusMetrics(out, simulations);
+    const std::string text = out.str();
+    REQUIRE(text.find("# TYPE gol_step_duration_seconds summary\n") != std::string::npos);
+    REQUIRE(text.find("gol_step_duration_seconds{simulation=\"board \\\"a\\\"\",quantile=\"0.999\"} 0.00025") !=
+            std::string::npos);
+    REQUIRE(text.find("gol_step_duration_seconds_count{simulation=\"board \\\"a\\\"\"} 1\n") != std::string::npos);
+    REQUIRE(text.find("gol_births_total{simulation=\"board \\\"a\\\"\"} 5\n") != std::string::npos);
+    REQUIRE(text.find("gol_deaths_total{simulation=\"board \\\"a\\\"\"} 3\n") != std::string::npos);
+    REQUIRE(text.find("gol_living_cells{simulation=\"board \\\"a\\\"\"} 42\n") != std::string::npos);
+    REQUIRE(text.find("process_resident_memory_bytes ") != std::string::npos);
+
+    const auto json = metricsToJson(simulations);
+    const auto& board = json["simulations"]["board \"a\""];
+    REQUIRE(board["step"]["count"] == 1);
+    REQUIRE(board["step"]["p99_ns"] == 250'000);
+    REQUIRE(board["births"] == 5);
+    REQUIRE(board["living_cells"] == 42);
+#if defined(__linux__)
+    REQUIRE(json["process"]["resident_memory_bytes"].get<uint64_t>() > 0);
+#endif
+}
+
+TEST_CASE("Counted Locks Count Only Contended Acquisitions", "[metrics]") {
+    std::mutex mutex;
+    SimulationMetrics metrics;
+    { auto lock = lockCounted(mutex, metrics); }
+    REQUIRE(metrics.lockWaits == 0);
+
+    std::unique_lock held(mutex);
+    std::thread waiter([&] { auto lock = lockCounted(mutex, metrics); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    held.unlock();
+    waiter.join();
+    REQUIRE(metrics.lockWaits == 1);
+    REQUIRE(metrics.lockWaitNanos > 0);
+}
+
+TEST_CASE("Sessions Record Steps, Changes And Reads", "[metrics]") {
+    SimulationStore store(GameConfig{}, ".");
+    auto session = store.create(16, 16, "");
+    const std::vector<Position> blinker{{1, 2}, {2, 2}, {3, 2}};
+    session->addPattern(blinker, Position(0, 0));
+
+    session->step(1);
+    session->step(3);
+    session->snapshot();
+
+    const auto& metrics = session->getMetrics();
+    REQUIRE(metrics.stepNanos.getCount() == 4);
+    REQUIRE(metrics.queryNanos.getCount() == 1);
+    // Each blinker flip is two births and two deaths; three flips net out to one
+    REQUIRE(metrics.births == 4);
+    REQUIRE(metrics.deaths == 4);
+    REQUIRE(metrics.livingCells == 3);
+    REQUIRE(store.list().size() == 1);
+}
+
+TEST_CASE("Controller Records Steps, Queries And Renders", "[metrics]") {
+    GameConfig config;
+    SimulationController controller(config);
+    controller.addCell(5, 6);
+    controller.addCell(6, 6);
+    controller.addCell(7, 6);
+
+    controller.step();
+    controller.step();
+    std::vector<Position> cells;
+    controller.getPositionsInRegion(0, 20, 0, 20, cells);
+    controller.recordRenderTime(std::chrono::milliseconds(2));
+
+    const auto& metrics = controller.getMetrics();
+    REQUIRE(metrics.stepNanos.getCount() == 2);
+    REQUIRE(metrics.queryNanos.getCount() == 1);
+    REQUIRE(metrics.renderNanos.getQuantile(0.5) >= 2'000'000);
+    REQUIRE(metrics.births == 4);
+    REQUIRE(metrics.deaths == 4);
+    REQUIRE(metrics.livingCells == 3);
+}
+
+TEST_CASE("Metrics File Writer Replaces The File On Each Write", "[metrics]") {
+    const auto path = (std::filesystem::temp_directory_path() / "flecs_gol_metrics.prom").string();
+    std::filesystem::remove(path);
+    REQUIRE(MetricsFileWriter::isPrometheusPath(path));
+    REQUIRE_FALSE(MetricsFileWriter::isPrometheusPath("metrics.json"));
+
+    int writes = 0;
+    {
+        MetricsFileWriter writer(path, std::chrono::hours(1), [&writes](std::ostream& out) {
+            out << "gol_writes " << ++writes << "\n";
+        });
+        writer.writeNow();
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        REQUIRE(line == "gol_writes 1");
+    }
+    // Written once more on destruction
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    REQUIRE(line == "gol_writes 2");
+    REQUIRE_FALSE(std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,220 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/partitioned_board.h>
+#include <flecs_gol/game_of_life_simulation.h>
+#include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+GameConfig makeConfig(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY, bool wrap,
+                      const LifeRule& rule = CONWAY_RULE) {
+    GameConfig config;
+    config.setGridBoundaries(minX, maxX, minY, maxY);
+    config.setWrapEdges(wrap);
+    config.setEngineType(EngineType::Dense);
+    config.setWorkerThreads(1);
+    config.setRule(rule);
+    return config;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> randomCells(const GameConfig& config, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution alive(0.35);
+    std::vector<Position> cells;
+    for (int32_t y = config.getGridMinY(); y <= config.getGridMaxY(); ++y) {
+        for (int32_t x = config.getGridMinX(); x <= config.getGridMaxX(); ++x) {
+            if (alive(rng)) {
+                cells.emplace_back(x, y);
+            }
+        }
+    }
+    return cells;
+}
+
+std::vector<Position> reference(const GameConfig& config, const std::vector<Position>& cells, int generations) {
+    GameOfLifeSimulation simulation(config);
+    for (const auto& cell : cells) {
+        simulation.createCell(cell.x, cell.y);
+    }
+    for (int generation = 0; generation < generations; ++generation) {
+        simulation.step();
+    }
+    return sorted(simulation.getLivePositions());
+}
+
+// Runs every rank on a thread of its own, each with its own board
+std::vector<PartitionStepResult> runRanks(const GameConfig& config, uint32_t ranks, int32_t haloDepth,
+                                          const std::vector<Position>& cells, uint64_t generations,
+                                          std::vector<Position>& living) {
+    InProcessHaloNetwork network(ranks);
+    std::vector<std::unique_ptr<PartitionedBoard>> boards;
+    for (uint32_t rank = 0; rank < ranks; ++rank) {
+        boards.push_back(std::make_unique<PartitionedBoard>(config, network.getTransport(rank), haloDepth));
+        boards.back()->createCells(cells);
+    }
+
+    std::vector<PartitionStepResult> results(ranks);
+    std::vector<std::thread> threads;
+    for (uint32_t rank = 0; rank < ranks; ++rank) {
+        threads.emplace_back([&, rank] { results[rank] = boards[rank]->advance(generations); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    living.clear();
+    for (const auto& board : boards) {
+        board->collectLiveCells(living);
+    }
+    return results;
+}
+
+} // namespace
+
+TEST_CASE("Partitioned Board Slab Split", "[partitioned]") {
+    REQUIRE(slabBounds(10, 1, 0).firstRow == 0);
+    REQUIRE(slabBounds(10, 1, 0).rows == 10);
+
+    // 10 rows over 4 ranks: 3, 3, 2, 2
+    int32_t next = 0;
+    for (uint32_t rank = 0; rank < 4; ++rank) {
+        const auto slab = slabBounds(10, 4, rank);
+        REQUIRE(slab.firstRow == next);
+        REQUIRE(slab.rows == (rank < 2 ? 3 : 2));
+        next += slab.rows;
+    }
+    REQUIRE(next == 10);
+}
+
+TEST_CASE("Partitioned Board Matches One Board", "[partitioned]") {
+    struct Scenario {
+        int32_t minX, maxX, minY, maxY;
+        bool wrap;
+        LifeRule rule;
+    };
+
+    // Whole-word and ragged widths, off-origin boundaries; the ragged wrapped
+    // grid steps one generation at a time locally
+    const std::vector<Scenario> scenarios{{0, 127, 0, 59, true, CONWAY_RULE},
+                                          {-64, 63, -30, 29, false, CONWAY_RULE},
+                                          {-50, 49, 10, 54, true, CONWAY_RULE},
+                                          {0, 69, -20, 19, false, HIGHLIFE_RULE}};
+
+    for (const auto& scenario : scenarios) {
+        const auto config =
+            makeConfig(scenario.minX, scenario.maxX, scenario.minY, scenario.maxY, scenario.wrap, scenario.rule);
+        const auto cells = randomCells(config, 3);
+        const auto expected = reference(config, cells, 30);
+
+        for (uint32_t ranks : {1u, 2u, 3u, 5u}) {
+            for (int32_t haloDepth : {1, 4, 8}) {
+                INFO("grid " << scenario.minX << ".." << scenario.maxX << " x " << scenario.minY << ".."
+                             << scenario.maxY << " wrap " << scenario.wrap << ", " << ranks << " ranks, halo "
+                             << haloDepth);
+                std::vector<Position> living;
+                const auto results = runRanks(config, ranks, haloDepth, cells, 30, living);
+                REQUIRE(sorted(living) == expected);
+                for (const auto& result : results) {
+                    REQUIRE(result.generations == 30);
+                    REQUIRE(result.livingCells == expected.size());
+                    REQUIRE(result.changed);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Partitioned Board Wakes Tiles Under New Halos", "[partitioned]") {
+    // Gliders crossing slab edges on boards of mostly stable tiles, so each
+    // rank skips tiles until a halo brings the glider in
+    const auto config = makeConfig(0, 199, 0, 179, true);
+    const std::vector<Position> cells{{60, 40}, {61, 41}, {59, 42}, {60, 42}, {61, 42},
+                                      {150, 120}, {151, 121}, {149, 122}, {150, 122}, {151, 122}};
+    const auto expected = reference(config, cells, 120);
+
+    for (uint32_t ranks : {2u, 4u}) {
+        for (int32_t haloDepth : {1, 5, 12}) {
+            INFO(ranks << " ranks, halo " << haloDepth);
+            std::vector<Position> living;
+            runRanks(config, ranks, haloDepth, cells, 120, living);
+            REQUIRE(sorted(living) == expected);
+        }
+    }
+}
+
+TEST_CASE("Partitioned Board Stops Together Once Settled", "[partitioned]") {
+    const auto config = makeConfig(0, 63, 0, 47, false);
+
+    // A block straddling the first slab edge and a blinker on the last slab
+    const std::vector<Position> cells{{10, 15}, {11, 15}, {10, 16}, {11, 16}, {30, 40}, {31, 40}, {32, 40}};
+    std::vector<Position> living;
+
+    // Period 2 divides a block of 2 generations, so the first block changes nothing
+    auto results = runRanks(config, 3, 2, cells, 1000, living);
+    for (const auto& result : results) {
+        REQUIRE(result.generations == 2);
+        REQUIRE_FALSE(result.changed);
+        REQUIRE(result.livingCells == 7);
+    }
+    REQUIRE(sorted(living) == sorted(cells));
+
+    // With odd blocks the blinker keeps every rank going
+    results = runRanks(config, 3, 3, cells, 31, living);
+    for (const auto& result : results) {
+        REQUIRE(result.generations == 31);
+        REQUIRE(result.changed);
+    }
+    REQUIRE(sorted(living) == sorted({{10, 15}, {11, 15}, {10, 16}, {11, 16}, {31, 39}, {31, 40}, {31, 41}}));
+}
+
+TEST_CASE("Partitioned Board Holds Only Its Slab", "[partitioned]") {
+    const auto config = makeConfig(0, 63, -10, 9, true);
+    InProcessHaloNetwork network(2);
+    PartitionedBoard top(config, network.getTransport(0), 3);
+    PartitionedBoard bottom(config, network.getTransport(1), 3);
+    REQUIRE(top.getSlab().firstRow == 0);
+    REQUIRE(bottom.getSlab().firstRow == 10);
+
+    for (auto* board : {&top, &bottom}) {
+        board->setCell(5, -8, true);
+        board->setCell(-1, 15, true); // Wraps to (63, -5)
+        board->setCell(7, 2, true);
+    }
+    REQUIRE(top.getSlabCellCount() == 2);
+    REQUIRE(top.isCellAlive(63, -5));
+    REQUIRE_FALSE(top.isCellAlive(7, 2));
+    REQUIRE(bottom.getSlabCellCount() == 1);
+    REQUIRE(bottom.isCellAlive(7, 2));
+
+    bottom.setCell(7, 22, false); // Wraps to (7, 2)
+    REQUIRE(bottom.getSlabCellCount() == 0);
+
+    // Slabs thinner than the halo, or more ranks than rows, are refused
+    InProcessHaloNetwork crowded(8);
+    REQUIRE_THROWS_AS(PartitionedBoard(config, crowded.getTransport(0), 3), std::invalid_argument);
+    REQUIRE_THROWS_AS(PartitionedBoard(config, network.getTransport(0), 0), std::invalid_argument);
+    InProcessHaloNetwork tooMany(21);
+    REQUIRE_THROWS_AS(PartitionedBoard(config, tooMany.getTransport(0), 1), std::invalid_argument);
+}
+
+TEST_CASE("Halo Mailboxes Give Up After Their Timeout", "[partitioned]") {
+    HaloMailbox mailbox(std::chrono::milliseconds{20});
+    mailbox.deliver({4, 1, true, {7, 8}});
+    REQUIRE(mailbox.receive(1, true, 4).words == std::vector<uint64_t>{7, 8});
+    REQUIRE_THROWS_AS(mailbox.receive(1, true, 4), std::runtime_error); // Received once
+    REQUIRE_THROWS_AS(mailbox.receive(2, false, 5), std::runtime_error);
+
+    ReductionBarrier barrier(2, std::chrono::milliseconds{20});
+    REQUIRE_THROWS_AS(barrier.contribute(0, {5, false}), std::runtime_error);
+}
@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/pattern_library.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+} // namespace
+
+TEST_CASE("The Pattern Corpus Is Compiled In", "[pattern_library]") {
+    REQUIRE_FALSE(embeddedPatterns().empty());
+    REQUIRE(findEmbeddedPattern("no-such-pattern") == nullptr);
+
+    const EmbeddedPattern* glider = findEmbeddedPattern("glider");
+    REQUIRE(glider != nullptr);
+    REQUIRE(glider->name == "glider");
+    REQUIRE(sorted({glider->cells.begin(), glider->cells.end()}) ==
+            sorted({{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}}));
+
+    // Every pattern matches its source file, where the corpus is at hand
+    const std::filesystem::path corpus(FLECS_GOL_PATTERN_DIR);
+    for (const auto& pattern : embeddedPatterns()) {
+        INFO("pattern " << pattern.name);
+        REQUIRE_FALSE(pattern.cells.empty());
+        const auto file = corpus / (std::string(pattern.name) + ".json");
+        if (std::filesystem::exists(file)) {
+            REQUIRE(readPatternFile(file.string()) == std::vector<Position>(pattern.cells.begin(), pattern.cells.end()));
+        }
+    }
+}
+
+TEST_CASE("Parsed Patterns Are Cached Until The File Changes", "[pattern_library]") {
+    const auto path = (std::filesystem::temp_directory_path() / "flecs_gol_cached_pattern.rle").string();
+    {
+        std::ofstream file(path);
+        file << "x = 3, y = 1\n3o!\n";
+    }
+    auto& cache = PatternCache::instance();
+    const auto first = cache.load(path);
+    REQUIRE(*first == std::vector<Position>{{0, 0}, {1, 0}, {2, 0}});
+    REQUIRE(cache.load(path) == first);  // The same parse, shared
+
+    // Rewritten with a later time, it is parsed again; the old list stays valid
+    {
+        std::ofstream file(path);
+        file << "x = 1, y = 2\no$o!\n";
+    }
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(2));
+    const auto second = cache.load(path);
+    REQUIRE(second != first);
+    REQUIRE(*second == std::vector<Position>{{0, 0}, {0, 1}});
+    REQUIRE(first->size() == 3);
+
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(cache.load(path), std::runtime_error);
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+}
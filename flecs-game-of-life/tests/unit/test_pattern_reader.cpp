@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/pattern_reader.h>
+#include <flecs_gol/simulation_controller.h>
+#include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+using PatternReaderFn = void (*)(std::istream&, const PatternRunCallback&, const LifeRule&);
+
+std::vector<Position> readCells(PatternReaderFn reader, const std::string& text, const LifeRule& rule = CONWAY_RULE) {
+    std::istringstream in(text);
+    std::vector<Position> cells;
+    reader(in, [&cells](int32_t x, int32_t y, uint32_t length) {
+        for (uint32_t i = 0; i < length; ++i) {
+            cells.emplace_back(x + static_cast<int32_t>(i), y);
+        }
+    }, rule);
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+const std::vector<Position> GLIDER = sorted({{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}});
+
+} // namespace
+
+TEST_CASE("Pattern Formats Follow The File Extension", "[pattern_reader]") {
+    REQUIRE(patternFormatFromPath("patterns/glider.json") == PatternFormat::Json);
+    REQUIRE(patternFormatFromPath("breeder.rle") == PatternFormat::Rle);
+    REQUIRE(patternFormatFromPath("BREEDER.RLE") == PatternFormat::Rle);
+    REQUIRE(patternFormatFromPath("metapixel.mc") == PatternFormat::Macrocell);
+    REQUIRE(patternFormatFromPath("notes.txt") == PatternFormat::Json);
+}
+
+TEST_CASE("RLE Patterns Decode", "[pattern_reader]") {
+    REQUIRE(readCells(readRlePattern, "#N Glider\n#C A comment\nx = 3, y = 3, rule = B3/S23\nbob$2bo$3o!\n") == GLIDER);
+
+    // CRLF line ends, items split across lines, blank rows and a trailing comment
+    REQUIRE(readCells(readRlePattern, "x = 4, y = 4\r\n2o\r\n2b2o2$\r\n3o!ignored") ==
+            sorted({{0, 0}, {1, 0}, {4, 0}, {5, 0}, {0, 2}, {1, 2}, {2, 2}}));
+
+    // #P moves the top-left corner
+    REQUIRE(readCells(readRlePattern, "#P -10 20\nx = 3, y = 1, rule = 23/3\n3o!") ==
+            sorted({{-10, 20}, {-9, 20}, {-8, 20}}));
+
+    // Long runs come through as one run
+    std::istringstream in("x = 1000, y = 1\n600o400o!");
+    std::vector<uint32_t> lengths;
+    readRlePattern(in, [&lengths](int32_t, int32_t, uint32_t length) { lengths.push_back(length); });
+    REQUIRE(lengths == std::vector<uint32_t>{1000});
+
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "bob$2bo$3o!"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "x = 3, y = 3, rule = B36/S23\n3o!"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "x = 3, y = 3\n3o%!"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "x = 1, y = 1\n2147483648o!"), std::runtime_error);
+}
+
+TEST_CASE("Macrocell Patterns Decode", "[pattern_reader]") {
+    // An 8x8 leaf holding a glider in the south-east quadrant of a 16x16 root
+    REQUIRE(readCells(readMacrocellPattern, "[M2] (golly 4.2)\n#R B3/S23\n.*$..*$***$\n4 0 0 0 1\n") == GLIDER);
+
+    // Shared subtrees are expanded at every reference
+    REQUIRE(readCells(readMacrocellPattern, "[M2]\n*$\n4 1 0 0 1\n5 0 2 2 0\n") ==
+            sorted({{0, -16}, {8, -8}, {-16, 0}, {-8, 8}}));
+
+    // Level-1 nodes hold cell states
+    REQUIRE(readCells(readMacrocellPattern, "[M2]\n1 1 0 0 1\n2 1 0 0 1\n") ==
+            sorted({{-2, -2}, {-1, -1}, {0, 0}, {1, 1}}));
+
+    REQUIRE(readCells(readMacrocellPattern, "[M2]\n").empty());
+
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, "x = 3, y = 3\n3o!"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, "[M2]\n*$\n4 2 0 0 0\n"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, "[M2]\n*$\n5 1 0 0 0\n"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, "[M2]\n*********$\n"), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, "[M2]\n#R B36/S23\n*$\n"), std::runtime_error);
+}
+
+TEST_CASE("Patterns Are Read For The Simulation's Rule", "[pattern_reader]") {
+    const std::string highLifeRle = "x = 3, y = 1, rule = b36/s23\n3o!";
+    const std::string highLifeMc = "[M2]\n#R 23/36\n1 1 1 0 0\n";
+    REQUIRE(readCells(readRlePattern, highLifeRle, HIGHLIFE_RULE) == sorted({{0, 0}, {1, 0}, {2, 0}}));
+    REQUIRE(readCells(readMacrocellPattern, highLifeMc, HIGHLIFE_RULE) == sorted({{-1, -1}, {0, -1}}));
+    REQUIRE_THROWS_AS(readCells(readRlePattern, highLifeRle), std::runtime_error);
+    REQUIRE_THROWS_AS(readCells(readMacrocellPattern, highLifeMc), std::runtime_error);
+
+    // Conway files do not run under another rule; files without one run under any
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "x = 3, y = 1, rule = B3/S23\n3o!", HIGHLIFE_RULE),
+                      std::runtime_error);
+    REQUIRE(readCells(readRlePattern, "x = 3, y = 1\n3o!", SEEDS_RULE).size() == 3);
+    REQUIRE_THROWS_AS(readCells(readRlePattern, "x = 3, y = 1, rule = B3/S23/G4\n3o!"), std::runtime_error);
+
+    // The controller reads pattern files for its configured rule, and the
+    // cache checks a file again when asked for another rule
+    const std::string path = (std::filesystem::temp_directory_path() / "flecs_gol_highlife.rle").string();
+    std::ofstream(path) << highLifeRle;
+    GameConfig config;
+    config.setGridBoundaries(-20, 20, -20, 20);
+    config.setRule(HIGHLIFE_RULE);
+    SimulationController highLife(config);
+    highLife.loadPattern(path);
+    REQUIRE(highLife.getState().liveCellCount == 3);
+
+    config.setRule(CONWAY_RULE);
+    SimulationController conway(config);
+    REQUIRE_THROWS_AS(conway.loadPattern(path), std::runtime_error);
+    REQUIRE(conway.getState().liveCellCount == 0);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Controller Loads RLE And Macrocell Files", "[pattern_reader]") {
+    const auto directory = std::filesystem::temp_directory_path();
+    const std::string rlePath = (directory / "flecs_gol_glider.rle").string();
+    const std::string mcPath = (directory / "flecs_gol_glider.mc").string();
+    std::ofstream(rlePath) << "#N Glider\nx = 3, y = 3, rule = B3/S23\nbob$2bo$3o!\n";
+    std::ofstream(mcPath) << "[M2] (golly 4.2)\n.*$..*$***$\n4 0 0 0 1\n";
+
+    const EngineType engines[] = {EngineType::Sparse, EngineType::Dense, EngineType::Tiled, EngineType::HashLife};
+    for (EngineType engine : engines) {
+        for (const auto& path : {rlePath, mcPath}) {
+            INFO("engine " << engineTypeToString(engine) << ", file " << path);
+            GameConfig config;
+            config.setGridBoundaries(-20, 20, -20, 20);
+            config.setEngineType(engine);
+            SimulationController controller(config);
+            controller.loadPattern(path);
+
+            std::vector<Position> cells;
+            controller.getPositionsInRegion(-20, 20, -20, 20, cells);
+            REQUIRE(sorted(cells) == GLIDER);
+
+            controller.step();
+            controller.reset();
+            controller.getPositionsInRegion(-20, 20, -20, 20, cells);
+            REQUIRE(sorted(cells) == GLIDER);
+        }
+    }
+
+    std::filesystem::remove(rlePath);
+    std::filesystem::remove(mcPath);
+}
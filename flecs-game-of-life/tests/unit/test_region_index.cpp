@@ -0,0 +1,217 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/region_index.h>
+#include <flecs_gol/game_of_life_simulation.h>
+#include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <random>
+#include <set>
+#include <thread>
+
+using namespace flecs_gol;
+
+namespace {
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> filterRegion(const std::set<Position>& cells, int32_t minX, int32_t maxX,
+                                   int32_t minY, int32_t maxY) {
+    std::vector<Position> inside;
+    for (const auto& pos : cells) {
+        if (pos.x >= minX && pos.x <= maxX && pos.y >= minY && pos.y <= maxY) {
+            inside.push_back(pos);
+        }
+    }
+    return inside;
+}
+
+} // namespace
+
+TEST_CASE("Region Index Basic Operations", "[region_index]") {
+    RegionIndex index;
+    REQUIRE(index.empty());
+
+    REQUIRE(index.insert(Position(0, 0)));
+    REQUIRE(index.insert(Position(-1, -1)));
+    REQUIRE(index.insert(Position(63, 64)));
+    REQUIRE_FALSE(index.insert(Position(0, 0)));
+    REQUIRE(index.size() == 3);
+    REQUIRE(index.getChunkCount() == 3);
+    REQUIRE(index.contains(Position(-1, -1)));
+    REQUIRE_FALSE(index.contains(Position(1, 0)));
+
+    SECTION("Erasing the last cell of a chunk frees it") {
+        REQUIRE(index.erase(Position(-1, -1)));
+        REQUIRE_FALSE(index.erase(Position(-1, -1)));
+        REQUIRE(index.getChunkCount() == 2);
+        REQUIRE(index.size() == 2);
+
+        // The freed chunk is reused, cleared, for the next new chunk
+        REQUIRE(index.insert(Position(1000, 1000)));
+        REQUIRE(index.getChunkCount() == 3);
+        REQUIRE_FALSE(index.contains(Position(1001, 1000)));
+    }
+
+    SECTION("Extreme coordinates") {
+        REQUIRE(index.insert(Position(INT32_MIN, INT32_MIN)));
+        REQUIRE(index.insert(Position(INT32_MAX, INT32_MAX)));
+        std::vector<Position> out;
+        index.collectRegion(INT32_MIN, INT32_MAX, INT32_MIN, INT32_MAX, out);
+        REQUIRE(out.size() == 5);
+    }
+
+    SECTION("Clear empties every chunk") {
+        index.clear();
+        REQUIRE(index.empty());
+        REQUIRE(index.getChunkCount() == 0);
+        std::vector<Position> out;
+        index.collectRegion(-100, 100, -100, 100, out);
+        REQUIRE(out.empty());
+    }
+}
+
+TEST_CASE("Region Index Matches Filtered Scan", "[region_index]") {
+    RegionIndex index;
+    std::set<Position> reference;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int32_t> coord(-300, 300);
+
+    for (int op = 0; op < 20000; ++op) {
+        Position pos(coord(rng), coord(rng));
+        if (rng() % 4 == 0) {
+            REQUIRE(index.erase(pos) == (reference.erase(pos) == 1));
+        } else {
+            REQUIRE(index.insert(pos) == reference.insert(pos).second);
+        }
+    }
+    REQUIRE(index.size() == reference.size());
+
+    // Regions inside one chunk, across chunk borders, past the cells, and
+    // large enough to walk the occupied chunks instead
+    struct Region {
+        int32_t minX, maxX, minY, maxY;
+    };
+    const std::vector<Region> regions = {
+        {0, 63, 0, 63}, {-1, 0, -1, 0}, {-60, 59, -20, 19}, {-5, 200, 17, 18},
+        {250, 400, 250, 400}, {-1000, 1000, -1000, 1000}, {10, 5, 0, 10}};
+
+    for (const auto& region : regions) {
+        INFO("region " << region.minX << ".." << region.maxX << " x " << region.minY << ".." << region.maxY);
+        std::vector<Position> out;
+        index.collectRegion(region.minX, region.maxX, region.minY, region.maxY, out);
+        REQUIRE(sorted(out) == filterRegion(reference, region.minX, region.maxX, region.minY, region.maxY));
+    }
+}
+
+TEST_CASE("Region Index Counts Blocks At Every Scale", "[region_index]") {
+    RegionIndex index;
+    std::set<Position> reference;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int32_t> coord(-5000, 5000);
+
+    // Clusters, so blocks fill and empty at every level
+    for (int op = 0; op < 40000; ++op) {
+        Position pos(coord(rng) / 16 * 16 + static_cast<int32_t>(rng() % 8),
+                     coord(rng) / 16 * 16 + static_cast<int32_t>(rng() % 8));
+        if (rng() % 3 == 0) {
+            index.erase(pos);
+            reference.erase(pos);
+        } else {
+            index.insert(pos);
+            reference.insert(pos);
+        }
+    }
+    for (const auto& pos : {Position(INT32_MIN, INT32_MIN), Position(INT32_MAX, INT32_MAX), Position(INT32_MIN, 7)}) {
+        index.insert(pos);
+        reference.insert(pos);
+    }
+
+    const RegionIndex copy = index;  // Copies carry the pyramid with them
+    for (uint32_t scale = 0; scale <= RegionIndex::MAX_SCALE_LOG2; ++scale) {
+        INFO("scale " << scale);
+        std::map<Position, uint32_t> expected;
+        for (const auto& pos : reference) {
+            expected[Position(pos.x >> scale, pos.y >> scale)]++;
+        }
+        for (const auto& [block, count] : expected) {
+            REQUIRE(index.countBlock(scale, block.x, block.y) == count);
+            REQUIRE(copy.countBlock(scale, block.x, block.y) == count);
+            if (expected.count(Position(block.x, block.y + 1)) == 0 && block.y < (INT32_MAX >> scale)) {
+                REQUIRE(index.countBlock(scale, block.x, block.y + 1) == 0);
+            }
+        }
+    }
+
+    // The pyramid follows changes made after it was built
+    for (const auto& pos : reference) {
+        index.erase(pos);
+    }
+    REQUIRE(index.countBlock(RegionIndex::MAX_SCALE_LOG2, 0, 0) == 0);
+    REQUIRE(index.countBlock(RegionIndex::MAX_SCALE_LOG2, -1, -1) == 0);
+    index.insert(Position(300, -300));
+    REQUIRE(index.countBlock(8, 1, -2) == 1);
+    REQUIRE(index.countBlock(RegionIndex::MAX_SCALE_LOG2, 0, -1) == 1);
+    index.clear();
+    REQUIRE(index.countBlock(8, 1, -2) == 0);
+}
+
+TEST_CASE("Region Index Builds Its Pyramid Once For Concurrent Readers", "[region_index]") {
+    RegionIndex index;
+    for (int32_t i = 0; i < 5000; ++i) {
+        index.insert(Position(i * 37 % 4096 - 2048, i * 53 % 4096 - 2048));
+    }
+
+    // Readers sharing a finished index all ask for blocks straight away
+    std::vector<std::thread> readers;
+    std::atomic<uint32_t> wrong{0};
+    for (int reader = 0; reader < 4; ++reader) {
+        readers.emplace_back([&] {
+            uint32_t total = 0;
+            for (int32_t y = -1; y <= 0; ++y) {
+                for (int32_t x = -1; x <= 0; ++x) {
+                    total += index.countBlock(12, x, y);
+                }
+            }
+            if (total != index.size()) {
+                wrong.fetch_add(1);
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    REQUIRE(wrong.load() == 0);
+}
+
+TEST_CASE("Sparse Region Queries Follow The Simulation", "[region_index]") {
+    GameConfig config;
+    config.setGridBoundaries(-100, 100, -100, 100);
+    GameOfLifeSimulation sim(config);
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int32_t> coord(-100, 100);
+    for (int i = 0; i < 4000; ++i) {
+        sim.createCell(coord(rng), coord(rng));
+    }
+    sim.destroyCell(0, 0);
+
+    for (int generation = 0; generation < 10; ++generation) {
+        sim.step();
+
+        auto live = sim.getLivePositions();
+        std::set<Position> reference(live.begin(), live.end());
+        REQUIRE(sorted(sim.getPositionsInRegion(-30, 45, -64, 3)) == filterRegion(reference, -30, 45, -64, 3));
+
+        // Entity queries go through the same index
+        auto entities = sim.getCellsInRegion(-30, 45, -64, 3);
+        std::vector<Position> entityPositions;
+        for (auto entity : entities) {
+            entityPositions.push_back(entity.get<Position>());
+        }
+        REQUIRE(sorted(entityPositions) == filterRegion(reference, -30, 45, -64, 3));
+    }
+}
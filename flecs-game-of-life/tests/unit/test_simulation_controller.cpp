@@ -0,0 +1,657 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/simulation_controller.h>
+#include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <future>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace flecs_gol;
+
+namespace {
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> snapshotCells(const GridSnapshot& snapshot) {
+    std::vector<Position> cells;
+    snapshot.cells.collectRegion(-1000, 1000, -1000, 1000, cells);
+    return sorted(cells);
+}
+
+bool waitFor(const std::function<bool()>& condition, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+std::unique_ptr<SimulationController> makeBlinker(uint32_t fps) {
+    GameConfig config;
+    config.setGridBoundaries(-8, 8, -8, 8);
+    config.setTargetFPS(fps);
+    auto controller = std::make_unique<SimulationController>(config);
+    controller->addCell(-1, 0);
+    controller->addCell(0, 0);
+    controller->addCell(1, 0);
+    return controller;
+}
+
+} // namespace
+
+TEST_CASE("Controller Snapshots Follow Each Step", "[simulation_controller]") {
+    const EngineType engines[] = {EngineType::Sparse, EngineType::Dense, EngineType::Tiled, EngineType::HashLife};
+
+    for (EngineType engine : engines) {
+        INFO("engine " << engineTypeToString(engine));
+        GameConfig config;
+        config.setGridBoundaries(-20, 20, -20, 20);
+        config.setEngineType(engine);
+        SimulationController controller(config);
+
+        // Horizontal blinker
+        controller.addCell(-1, 0);
+        controller.addCell(0, 0);
+        controller.addCell(1, 0);
+
+        auto before = controller.getSnapshot();
+        REQUIRE(before->generation == 0);
+        REQUIRE(snapshotCells(*before) == std::vector<Position>{{-1, 0}, {0, 0}, {1, 0}});
+
+        controller.step();
+
+        // A held snapshot is not touched by later steps
+        REQUIRE(snapshotCells(*before) == std::vector<Position>{{-1, 0}, {0, 0}, {1, 0}});
+
+        auto after = controller.getSnapshot();
+        REQUIRE(after->generation == 1);
+        REQUIRE(snapshotCells(*after) == std::vector<Position>{{0, -1}, {0, 0}, {0, 1}});
+        REQUIRE(sorted(after->born) == std::vector<Position>{{0, -1}, {0, 1}});
+        REQUIRE(sorted(after->died) == std::vector<Position>{{-1, 0}, {1, 0}});
+
+        std::vector<Position> viewport;
+        controller.getPositionsInRegion(-5, 5, 1, 5, viewport);
+        REQUIRE(viewport == std::vector<Position>{{0, 1}});
+        REQUIRE(controller.getAllCells().size() == 3);
+
+        // Released snapshots are recycled; the contents must still be current
+        before.reset();
+        after.reset();
+        for (uint32_t generation = 2; generation <= 5; ++generation) {
+            controller.step();
+            auto snapshot = controller.getSnapshot();
+            REQUIRE(snapshot->generation == generation);
+            REQUIRE(snapshotCells(*snapshot) == (generation % 2 == 0
+                ? std::vector<Position>{{-1, 0}, {0, 0}, {1, 0}}
+                : std::vector<Position>{{0, -1}, {0, 0}, {0, 1}}));
+        }
+
+        controller.clearGrid();
+        REQUIRE(controller.getSnapshot()->cells.empty());
+    }
+}
+
+TEST_CASE("Recycled Snapshots Stay Exact Across Edits And Held Readers", "[simulation_controller]") {
+    GameConfig config;
+    config.setGridBoundaries(-100, 100, -100, 100);
+    SimulationController controller(config);
+    SimulationController reference(config);  // Holds every snapshot, so each is copied whole
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int32_t> coordinate(-12, 12);
+    for (int i = 0; i < 200; ++i) {
+        const int32_t x = coordinate(rng);
+        const int32_t y = coordinate(rng);
+        controller.addCell(x, y);
+        reference.addCell(x, y);
+    }
+
+    std::shared_ptr<const GridSnapshot> held;
+    std::shared_ptr<const GridSnapshot> referenceHeld;
+    for (int round = 0; round < 40; ++round) {
+        // Single steps catch the recycled snapshot up; edits, multi-steps and
+        // a reader keeping a snapshot send the others through a full copy
+        if (round % 7 == 3) {
+            const std::vector<CellEdit> edits{{coordinate(rng), coordinate(rng), true},
+                                              {coordinate(rng), coordinate(rng), false}};
+            controller.editCellsAsync(edits);
+            reference.editCellsAsync(edits);
+        }
+        if (round % 11 == 5) {
+            held = controller.getSnapshot();
+        } else if (round % 11 == 8) {
+            held.reset();
+        }
+        const uint32_t generations = round % 5 == 4 ? 3 : 1;
+        controller.step(generations);
+        reference.step(generations);
+
+        referenceHeld = reference.getSnapshot();
+        auto snapshot = controller.getSnapshot();
+        REQUIRE(snapshot->generation == referenceHeld->generation);
+        REQUIRE(snapshotCells(*snapshot) == snapshotCells(*referenceHeld));
+        REQUIRE(sorted(snapshot->born) == sorted(referenceHeld->born));
+        REQUIRE(sorted(snapshot->died) == sorted(referenceHeld->died));
+    }
+}
+
+TEST_CASE("Controller Reports Exact Cycles", "[simulation_controller]") {
+    GameConfig config;
+    config.setGridBoundaries(-50, 50, -50, 50);
+    SimulationController controller(config);
+    controller.enablePatternDetection(true);
+
+    std::vector<std::pair<std::string, uint32_t>> detected;
+    controller.setPatternDetectedCallback([&detected](const std::string& name, uint32_t period) {
+        detected.emplace_back(name, period);
+    });
+
+    // Glider
+    for (const auto& pos : {Position(1, 0), Position(2, 1), Position(0, 2), Position(1, 2), Position(2, 2)}) {
+        controller.addCell(pos.x, pos.y);
+    }
+    for (int i = 0; i < 3; ++i) {
+        controller.step();
+    }
+    REQUIRE(controller.getState().cyclePeriod == 0);
+    REQUIRE(detected.empty());
+
+    controller.step();
+    auto state = controller.getState();
+    REQUIRE(state.cyclePeriod == 4);
+    REQUIRE(state.cycleDx == 1);
+    REQUIRE(state.cycleDy == 1);
+    REQUIRE(detected == std::vector<std::pair<std::string, uint32_t>>{{"Period-4 Spaceship", 4}});
+
+    // Reported once, while the state keeps tracking the cycle
+    for (int i = 0; i < 8; ++i) {
+        controller.step();
+    }
+    REQUIRE(detected.size() == 1);
+    REQUIRE(controller.getState().cyclePeriod == 4);
+
+    // An edit starts detection over from the new live set
+    controller.clearGrid();
+    REQUIRE(controller.getState().cyclePeriod == 0);
+    for (const auto& pos : {Position(0, 0), Position(1, 0), Position(0, 1), Position(1, 1)}) {
+        controller.addCell(pos.x, pos.y);
+    }
+    controller.step();
+    REQUIRE(controller.getState().cyclePeriod == 1);
+    REQUIRE(detected.back() == std::pair<std::string, uint32_t>{"Still Life", 1});
+}
+
+TEST_CASE("Controller Swaps Engines Without Losing The Board", "[simulation_controller]") {
+    GameConfig config;
+    config.setGridBoundaries(-30, 30, -30, 30);
+    SimulationController reference(config);
+    SimulationController controller(config);
+
+    // Glider and blinker, worked on by a different engine every step
+    for (const auto& pos : {Position(1, 0), Position(2, 1), Position(0, 2), Position(1, 2), Position(2, 2),
+                            Position(-10, -10), Position(-9, -10), Position(-8, -10)}) {
+        reference.addCell(pos.x, pos.y);
+        controller.addCell(pos.x, pos.y);
+    }
+
+    const EngineType engines[] = {EngineType::Dense, EngineType::Tiled, EngineType::HashLife, EngineType::Sparse};
+    for (int round = 0; round < 3; ++round) {
+        for (EngineType engine : engines) {
+            INFO("round " << round << ", engine " << engineTypeToString(engine));
+            GameConfig next = config;
+            next.setEngineType(engine);
+            controller.switchEngine(next);
+            REQUIRE(controller.getConfig().getEngineType() == engine);
+            REQUIRE(snapshotCells(*controller.getSnapshot()) == snapshotCells(*reference.getSnapshot()));
+
+            reference.step();
+            controller.step();
+            REQUIRE(controller.getState().generation == reference.getState().generation);
+            REQUIRE(snapshotCells(*controller.getSnapshot()) == snapshotCells(*reference.getSnapshot()));
+        }
+    }
+
+    // Any LifeEngine plugs in, and reset still restores the reset state
+    struct CountingEngine : GameOfLifeSimulation {
+        CountingEngine(const GameConfig& config, int& steps) : GameOfLifeSimulation(config), steps_(steps) {}
+        void step() override {
+            ++steps_;
+            GameOfLifeSimulation::step();
+        }
+        int& steps_;
+    };
+
+    int steps = 0;
+    controller.setEngine(std::make_unique<CountingEngine>(config, steps));
+    controller.step();
+    controller.step();
+    REQUIRE(steps == 2);
+    REQUIRE(controller.getState().generation == reference.getState().generation + 2);
+
+    controller.reset();
+    REQUIRE(controller.getState().generation == 0);
+    REQUIRE(controller.getSnapshot()->cells.empty());
+}
+
+TEST_CASE("Engines Advance Several Steps At Once", "[simulation_controller]") {
+    GameConfig config;
+    config.setGridBoundaries(-10, 10, -10, 10);
+
+    const EngineType engines[] = {EngineType::Sparse, EngineType::Dense, EngineType::Tiled, EngineType::HashLife};
+    for (EngineType engine : engines) {
+        INFO("engine " << engineTypeToString(engine));
+        config.setEngineType(engine);
+        auto simulation = createLifeEngine(config);
+
+        // Blinker keeps changing for every step asked for
+        for (const auto& pos : {Position(-1, 0), Position(0, 0), Position(1, 0)}) {
+            simulation->addCell(pos.x, pos.y);
+        }
+        REQUIRE(simulation->advance(5) == 5);
+        REQUIRE(simulation->getGeneration() == 5);
+        REQUIRE(sorted(simulation->getLivePositions()) == std::vector<Position>{{0, -1}, {0, 0}, {0, 1}});
+
+        // A block stops the run after its first step
+        simulation->clear();
+        for (const auto& pos : {Position(0, 0), Position(1, 0), Position(0, 1), Position(1, 1)}) {
+            simulation->addCell(pos.x, pos.y);
+        }
+        REQUIRE(simulation->advance(10) == 1);
+        REQUIRE(simulation->getCellCount() == 4);
+
+        // The skipped steps still count, up to the last generation there is
+        const uint32_t settled = simulation->getGeneration();
+        skipSettledSteps(*simulation, settled - 1, 1, 10);
+        REQUIRE(simulation->getGeneration() == settled + 9);
+        const uint32_t nearEnd = std::numeric_limits<uint32_t>::max() - 5;
+        simulation->setGeneration(nearEnd);
+        skipSettledSteps(*simulation, nearEnd, simulation->advance(10), 10);
+        REQUIRE(simulation->getGeneration() == std::numeric_limits<uint32_t>::max());
+    }
+}
+
+TEST_CASE("Controller Steps Several Generations In One Call", "[simulation_controller]") {
+    const EngineType engines[] = {EngineType::Sparse, EngineType::Tiled};
+    for (EngineType engine : engines) {
+        INFO("engine " << engineTypeToString(engine));
+        GameConfig config;
+        config.setGridBoundaries(-32, 31, -32, 31);
+        config.setEngineType(engine);
+        SimulationController controller(config);
+
+        // Changes span the whole call: after an odd count the blinker is turned
+        controller.addCell(-1, 0);
+        controller.addCell(0, 0);
+        controller.addCell(1, 0);
+        controller.step(9);
+
+        auto snapshot = controller.getSnapshot();
+        REQUIRE(snapshot->generation == 9);
+        REQUIRE(snapshotCells(*snapshot) == std::vector<Position>{{0, -1}, {0, 0}, {0, 1}});
+        REQUIRE(sorted(snapshot->born) == std::vector<Position>{{0, -1}, {0, 1}});
+        REQUIRE(sorted(snapshot->died) == std::vector<Position>{{-1, 0}, {1, 0}});
+
+        // A still life settles the call early; the generation still moves on
+        controller.clearGrid();
+        for (const auto& pos : {Position(0, 0), Position(1, 0), Position(0, 1), Position(1, 1)}) {
+            controller.addCell(pos.x, pos.y);
+        }
+        controller.step(20);
+        REQUIRE(controller.getSnapshot()->generation == 29);
+        REQUIRE(controller.getSnapshot()->born.empty());
+        REQUIRE(controller.getState().liveCellCount == 4);
+    }
+}
+
+TEST_CASE("Controller Adapts The Engine To Live Density", "[simulation_controller]") {
+    GameConfig config;
+    config.setGridBoundaries(0, 119, 0, 119);
+    config.setWrapEdges(true);
+    config.setEngineType(EngineType::Dense);
+    SimulationController reference(config);
+    
+    // A 30% soup starts dense and thins out below 7% within a few hundred generations
+    config.setEngineType(EngineType::Sparse);
+    config.setAdaptiveEngine(true);
+    config.setDenseDensityThreshold(0.15);
+    config.setSparseDensityThreshold(0.07);
+    SimulationController controller(config);
+    
+    std::mt19937 rng(5);
+    std::bernoulli_distribution alive(0.3);
+    std::vector<Position> soup;
+    for (int32_t y = 0; y < 120; ++y) {
+        for (int32_t x = 0; x < 120; ++x) {
+            if (alive(rng)) {
+                soup.emplace_back(x, y);
+            }
+        }
+    }
+    nlohmann::json pattern;
+    for (const auto& pos : soup) {
+        pattern["cells"].push_back({{"x", pos.x}, {"y", pos.y}});
+    }
+    reference.loadPatternFromJson(pattern);
+    controller.loadPatternFromJson(pattern);
+    
+    std::vector<EngineType> engines;
+    for (int generation = 0; generation < 400; ++generation) {
+        reference.step();
+        controller.step();
+        
+        const EngineType engine = controller.getConfig().getEngineType();
+        if (engines.empty() || engines.back() != engine) {
+            engines.push_back(engine);
+        }
+        REQUIRE(controller.getState().liveCellCount == reference.getState().liveCellCount);
+        REQUIRE(controller.getSnapshot()->born.size() == reference.getSnapshot()->born.size());
+    }
+    
+    // One move each way; the threshold gap keeps it from flapping
+    REQUIRE(engines == std::vector<EngineType>{EngineType::Dense, EngineType::Sparse});
+    REQUIRE(snapshotCells(*controller.getSnapshot()) == snapshotCells(*reference.getSnapshot()));
+    
+    // After a reset the pattern's density picks the engine again
+    controller.reset();
+    controller.step();
+    REQUIRE(controller.getConfig().getEngineType() == EngineType::Dense);
+}
+
+TEST_CASE("Controller Stops Stepping At The Entity Limit", "[simulation_controller]") {
+    GameConfig config;
+    config.setGridBoundaries(-100, 100, -100, 100);
+    config.setMaxEntities(20);
+    SimulationController controller(config);
+
+    // The R-pentomino grows past 20 cells within a few dozen generations
+    for (const auto& [x, y] : {std::pair{1, 0}, {2, 0}, {0, 1}, {1, 1}, {1, 2}}) {
+        controller.addCell(x, y);
+    }
+    for (int i = 0; i < 200 && !controller.getState().entityLimitReached; ++i) {
+        controller.step();
+    }
+    const auto state = controller.getState();
+    REQUIRE(state.entityLimitReached);
+    REQUIRE(state.liveCellCount > 20);
+
+    controller.step();
+    REQUIRE(controller.getState().generation == state.generation);
+
+    controller.clearGrid();
+    REQUIRE_FALSE(controller.getState().entityLimitReached);
+    controller.step();
+    REQUIRE(controller.getState().generation == state.generation + 1);
+}
+
+TEST_CASE("Controller Steps Back And Seeks Through History", "[simulation_controller][history]") {
+    const EngineType engines[] = {EngineType::Sparse, EngineType::Dense, EngineType::Tiled};
+
+    for (EngineType engine : engines) {
+        INFO("engine " << engineTypeToString(engine));
+        GameConfig config;
+        config.setGridBoundaries(-20, 19, -20, 19);
+        config.setWrapEdges(true);
+        config.setEngineType(engine);
+        config.setWorkerThreads(1);
+        SimulationController controller(config);
+
+        std::mt19937 rng(9);
+        std::bernoulli_distribution alive(0.3);
+        for (int32_t y = -20; y < 20; ++y) {
+            for (int32_t x = -20; x < 20; ++x) {
+                if (alive(rng)) {
+                    controller.addCell(x, y);
+                }
+            }
+        }
+
+        std::vector<std::vector<Position>> boards{snapshotCells(*controller.getSnapshot())};
+        for (int generation = 1; generation <= 200; ++generation) {
+            controller.step();
+            boards.push_back(snapshotCells(*controller.getSnapshot()));
+        }
+        controller.step(10);  // One entry for all ten
+        boards.resize(211);
+        boards[210] = snapshotCells(*controller.getSnapshot());
+
+        REQUIRE(controller.stepBack());
+        REQUIRE(controller.getState().generation == 200);
+        REQUIRE(snapshotCells(*controller.getSnapshot()) == boards[200]);
+        REQUIRE(controller.getState().liveCellCount == boards[200].size());
+        for (uint32_t target : {199u, 3u, 150u, 0u, 210u, 130u}) {
+            REQUIRE(controller.seek(target) == target);
+            REQUIRE(snapshotCells(*controller.getSnapshot()) == boards[target]);
+            REQUIRE(controller.getSnapshot()->generation == target);
+        }
+        REQUIRE(controller.seek(205) == 200);  // Inside the ten-step entry
+
+        // Seeking past the newest entry simulates the rest
+        controller.seek(210);
+        REQUIRE(controller.seek(215) == 215);
+        REQUIRE(controller.getHistory().getNewestGeneration() == 215);
+
+        // An edit after going back drops the generations after it
+        controller.seek(100);
+        auto edited = boards[100];
+        const bool wasAlive = std::binary_search(edited.begin(), edited.end(), Position(0, 0));
+        if (wasAlive) {
+            controller.removeCell(0, 0);
+            edited.erase(std::lower_bound(edited.begin(), edited.end(), Position(0, 0)));
+        } else {
+            controller.addCell(0, 0);
+            edited.insert(std::lower_bound(edited.begin(), edited.end(), Position(0, 0)), Position(0, 0));
+        }
+        REQUIRE(controller.getHistory().getNewestGeneration() == 100);
+        controller.step();
+        REQUIRE(controller.stepBack());
+        REQUIRE(snapshotCells(*controller.getSnapshot()) == edited);
+        REQUIRE(controller.seek(0) == 0);
+        REQUIRE(snapshotCells(*controller.getSnapshot()) == boards[0]);
+
+        // A reset starts the history over
+        controller.reset();
+        REQUIRE_FALSE(controller.stepBack());
+    }
+}
+
+TEST_CASE("Controller Keeps No History Without A Budget", "[simulation_controller][history]") {
+    GameConfig config;
+    config.setGridBoundaries(-8, 8, -8, 8);
+    config.setHistoryBudgetMB(0);
+    SimulationController controller(config);
+    controller.addCell(-1, 0);
+    controller.addCell(0, 0);
+    controller.addCell(1, 0);
+    controller.step();
+    controller.step();
+    REQUIRE_FALSE(controller.stepBack());
+    REQUIRE(controller.getHistory().empty());
+    REQUIRE(controller.seek(0) == 2);  // Already past it
+    REQUIRE(controller.seek(5) == 5);
+}
+
+TEST_CASE("Simulation Thread Keeps To Its Frame Rate", "[simulation_controller][pacing]") {
+    // 2.5 ms frames, which whole-millisecond pacing would round down to 2 ms
+    auto controller = makeBlinker(400);
+    controller->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    const auto state = controller->getState();
+    controller->stop();
+
+    // About 200 frames and never more; the lower bound leaves room for a loaded machine
+    REQUIRE(state.generation <= 205);
+    REQUIRE(state.generation >= 100);
+    REQUIRE(state.actualFPS > 0.0);
+    REQUIRE(state.skippedFrames < 100);
+}
+
+TEST_CASE("Requested Steps Wake A Paused Simulation", "[simulation_controller][pacing]") {
+    auto controller = makeBlinker(1);
+    controller->start();
+    controller->pause();
+    REQUIRE(waitFor([&] { return controller->getState().isPaused; }));
+    const uint32_t generation = controller->getState().generation;
+
+    controller->requestStep();
+    controller->requestStep();
+    REQUIRE(waitFor([&] { return controller->getState().generation == generation + 2; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(controller->getState().generation == generation + 2); // Still paused
+
+    // Resuming does not wait out a poll interval or the old frame
+    controller->setTargetFPS(1000);
+    controller->resume();
+    REQUIRE(waitFor([&] { return controller->getState().generation > generation + 10; }, std::chrono::seconds(1)));
+    controller->stop();
+
+    // Without a simulation thread the step runs in the caller
+    const uint32_t stopped = controller->getState().generation;
+    controller->requestStep();
+    REQUIRE(controller->getState().generation == stopped + 1);
+}
+
+TEST_CASE("Overrunning Steps Drop Frames Instead Of Bursting", "[simulation_controller][pacing]") {
+    GameConfig config;
+    config.setGridBoundaries(0, 255, 0, 255);
+    config.setTargetFPS(1000);
+    SimulationController controller(config);
+    std::mt19937 rng(3);
+    for (int32_t y = 0; y < 256; ++y) {
+        for (int32_t x = 0; x < 256; ++x) {
+            if (rng() % 2 == 0) {
+                controller.addCell(x, y);
+            }
+        }
+    }
+
+    // Each step of tens of thousands of cells takes far longer than a 1 ms frame
+    controller.start();
+    REQUIRE(waitFor([&] { return controller.getState().generation >= 3; }));
+    controller.stop();
+    const auto state = controller.getState();
+    REQUIRE(state.skippedFrames >= state.generation);
+}
+
+TEST_CASE("Frames Advance Several Generations At A Fixed Frame Rate", "[simulation_controller][pacing]") {
+    auto controller = makeBlinker(100);
+    controller->setGenerationsPerFrame(8);
+    controller->start();
+    REQUIRE(waitFor([&] { return controller->getState().generation >= 8; }));
+    controller->stop();
+    auto state = controller->getState();
+    REQUIRE(state.frameGenerations == 8);
+    REQUIRE(state.generation % 8 == 0);
+
+    // A budgeted frame keeps taking batches of a cheap board until it is spent
+    auto budgeted = makeBlinker(50);
+    budgeted->setGenerationsPerFrame(2);
+    budgeted->setFrameStepBudgetMs(10);
+    budgeted->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    budgeted->stop();
+    state = budgeted->getState();
+    REQUIRE(state.frameGenerations > 2);
+    REQUIRE(state.frameGenerations % 2 == 0);
+    REQUIRE(state.generation > 10 * 2);  // About 10 frames, each past a single batch
+
+    // Requested steps stay single generations
+    const uint32_t stopped = state.generation;
+    budgeted->requestStep();
+    REQUIRE(budgeted->getState().generation == stopped + 1);
+}
+
+TEST_CASE("Frame Settings Change While The Simulation Runs", "[simulation_controller][pacing]") {
+    auto controller = makeBlinker(1000);
+    controller->start();
+
+    // The running frames read the settings while they are changed and copied
+    std::thread tuner([&] {
+        for (uint32_t i = 1; i <= 200; ++i) {
+            controller->setGenerationsPerFrame(i % 4 + 1);
+            controller->setFrameStepBudgetMs(i % 3);
+            controller->setTargetFPS(500 + i);
+        }
+    });
+    uint32_t lastFPS = 0;
+    for (int i = 0; i < 200; ++i) {
+        lastFPS = std::max(lastFPS, controller->getConfig().getTargetFPS());
+        REQUIRE(controller->isValidPosition(0, 0));
+    }
+    tuner.join();
+    REQUIRE(waitFor([&] { return controller->getState().generation >= 3; }));
+    controller->stop();
+
+    const GameConfig config = controller->getConfig();
+    REQUIRE(config.getTargetFPS() == 700);
+    REQUIRE(config.getGenerationsPerFrame() == 1);
+    REQUIRE(config.getFrameStepBudgetMs() == 2);
+    REQUIRE(lastFPS <= 700);
+}
+
+TEST_CASE("Async Edits Are Applied Together Between Generations", "[simulation_controller][async]") {
+    // A block beside the blinker: a still life, so it outlasts any step
+    const std::vector<CellEdit> block = {{5, 5}, {6, 5}, {5, 6}, {6, 6}};
+
+    // Without a simulation thread they go in before the call returns
+    auto controller = makeBlinker(1);
+    auto added = controller->editCellsAsync(block);
+    REQUIRE(added.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    REQUIRE(controller->getState().liveCellCount == 7);
+
+    // A paused thread is woken for them; the future waits for the snapshot
+    controller->start();
+    REQUIRE(waitFor([&] { return controller->getState().generation >= 1; }));
+    controller->pause();
+    std::vector<CellEdit> clear = block;
+    for (CellEdit& edit : clear) {
+        edit.alive = false;
+    }
+    auto removed = controller->editCellsAsync(clear);
+    REQUIRE(removed.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(controller->getSnapshot()->cells.size() == 3);
+
+    // A running one takes them along with its next step
+    controller->resume();
+    REQUIRE(waitFor([&] { return controller->getState().generation >= 1; }));
+    const uint32_t queuedAt = controller->getSnapshot()->generation;
+    auto addedWhileRunning = controller->editCellsAsync(block);
+    REQUIRE(addedWhileRunning.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    const auto snapshot = controller->getSnapshot();
+    REQUIRE(snapshot->generation > queuedAt);
+    REQUIRE(snapshot->cells.size() == 7);
+    controller->stop();
+
+    // A cell added and removed in one batch ends where it started
+    controller->addCellAsync(-6, -6);
+    controller->removeCellAsync(-6, -6).get();
+    REQUIRE_FALSE(controller->getSnapshot()->cells.contains(Position(-6, -6)));
+    REQUIRE(controller->getState().liveCellCount == 7);
+}
+
+TEST_CASE("Async Steps Resolve With The Generation Reached", "[simulation_controller][async]") {
+    auto controller = makeBlinker(1);
+    REQUIRE(controller->stepAsync(3).get() == 3);
+
+    controller->start();
+    REQUIRE(waitFor([&] { return controller->getState().generation >= 4; }));  // Next frame a second off
+    controller->pause();
+    const uint32_t paused = controller->getState().generation;
+    auto first = controller->stepAsync(2);
+    auto second = controller->stepAsync();
+    REQUIRE(first.get() == paused + 2);
+    REQUIRE(second.get() == paused + 3);
+    REQUIRE(controller->getSnapshot()->generation == paused + 3);
+    controller->stop();
+}
@@ -0,0 +1,181 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/simulation_host.h>
+#include <flecs_gol/simulation_controller.h>
+#include <flecs_gol/game_config.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+// Blinker on a small grid, stepping as fast as the host lets it
+std::unique_ptr<SimulationController> makeBlinker(uint32_t fps) {
+    GameConfig config;
+    config.setGridBoundaries(-8, 8, -8, 8);
+    config.setTargetFPS(fps);
+    auto controller = std::make_unique<SimulationController>(config);
+    controller->addCell(-1, 0);
+    controller->addCell(0, 0);
+    controller->addCell(1, 0);
+    return controller;
+}
+
+bool waitFor(const std::function<bool()>& condition, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("Host Steps Many Simulations On A Fixed Pool", "[simulation_host]") {
+    SimulationHost host(4);
+    REQUIRE(host.getThreadCount() == 4);
+
+    std::vector<std::unique_ptr<SimulationController>> controllers;
+    for (int i = 0; i < 200; ++i) {
+        controllers.push_back(makeBlinker(1000));
+        controllers.back()->start(host);
+    }
+    REQUIRE(host.getSimulationCount() == 200);
+
+    REQUIRE(waitFor([&] {
+        for (const auto& controller : controllers) {
+            if (controller->getState().generation < 5) {
+                return false;
+            }
+        }
+        return true;
+    }));
+
+    for (auto& controller : controllers) {
+        controller->stop();
+        // A blinker stays a blinker, however its steps were spread over the pool
+        REQUIRE(controller->getState().liveCellCount == 3);
+    }
+    REQUIRE(host.getSimulationCount() == 0);
+    REQUIRE(host.getStepCount() >= 200 * 5);
+}
+
+TEST_CASE("Paused Simulations Cost The Host Nothing", "[simulation_host]") {
+    SimulationHost host(2);
+    auto controller = makeBlinker(1000);
+    controller->start(host);
+    REQUIRE(waitFor([&] { return controller->getState().generation >= 3; }));
+
+    controller->pause();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // Lets a step already under way finish
+    REQUIRE(host.getScheduledCount() == 0);
+    const uint64_t steps = host.getStepCount();
+    const uint32_t generation = controller->getState().generation;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE(host.getStepCount() == steps);
+    REQUIRE(controller->getState().generation == generation);
+
+    controller->resume();
+    REQUIRE(waitFor([&] { return controller->getState().generation >= generation + 3; }));
+
+    // Auto-step off parks it the same way
+    controller->setAutoStep(false);
+    REQUIRE(waitFor([&] { return host.getScheduledCount() == 0; }));
+    controller->setAutoStep(true);
+    REQUIRE(waitFor([&] { return host.getScheduledCount() == 1; }));
+
+    controller->stop();
+    REQUIRE(host.getSimulationCount() == 0);
+}
+
+TEST_CASE("Host Keeps To Each Simulation's Frame Rate", "[simulation_host]") {
+    SimulationHost host(2);
+    auto slow = makeBlinker(20);
+    auto fast = makeBlinker(1000);
+    slow->start(host);
+    fast->start(host);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    const uint32_t slowGenerations = slow->getState().generation;
+    const uint32_t fastGenerations = fast->getState().generation;
+    slow->stop();
+    fast->stop();
+
+    // 20 fps for half a second, with room for a loaded machine
+    REQUIRE(slowGenerations >= 5);
+    REQUIRE(slowGenerations <= 13);
+    REQUIRE(fastGenerations > slowGenerations * 4);
+}
+
+TEST_CASE("A Costly Step Holds Up No Other Simulation", "[simulation_host]") {
+    SimulationHost host(3);
+    auto costly = makeBlinker(1000);
+    auto cheap = makeBlinker(200);
+    std::atomic<bool> stepping{false};
+    costly->setGenerationCallback([&](uint32_t) {
+        stepping = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    });
+    costly->start(host);
+    REQUIRE(waitFor([&] { return stepping.load(); }));
+
+    // The cheap board keeps its frame rate while the costly step runs
+    cheap->start(host);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    const uint32_t cheapGenerations = cheap->getState().generation;
+    cheap->stop();
+    costly->stop();
+
+    REQUIRE(cheapGenerations >= 10);
+}
+
+TEST_CASE("Host Serves Async Commands Of A Paused Simulation", "[simulation_host]") {
+    SimulationHost host(2);
+    auto controller = makeBlinker(1);
+    controller->start(host);
+    REQUIRE(waitFor([&] { return controller->getState().generation >= 1; }));  // Next frame a second off
+    controller->pause();
+
+    const uint32_t paused = controller->getState().generation;
+    auto added = controller->addCellAsync(5, 5);
+    REQUIRE(added.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(controller->getSnapshot()->cells.contains(Position(5, 5)));
+
+    REQUIRE(controller->stepAsync(2).get() == paused + 2);
+    REQUIRE(controller->getState().isPaused);
+    controller->stop();
+}
+
+TEST_CASE("A Failing Step Stops Only Its Simulation", "[simulation_host]") {
+    // One thread is the scheduler alone, so every step goes to the pool's worker
+    SimulationHost host(1);
+    auto failing = makeBlinker(1000);
+    auto healthy = makeBlinker(1000);
+    failing->setGenerationCallback([](uint32_t generation) {
+        if (generation == 3) {
+            throw std::runtime_error("generation callback failed");
+        }
+    });
+    failing->start(host);
+    healthy->start(host);
+
+    REQUIRE(waitFor([&] { return host.getFailedCount() == 1; }));
+    const uint32_t stopped = failing->getState().generation;
+    const uint32_t generation = healthy->getState().generation;
+    REQUIRE(waitFor([&] { return healthy->getState().generation >= generation + 5; }));
+    REQUIRE(failing->getState().generation == stopped);
+    REQUIRE(host.getScheduledCount() == 1);
+
+    failing->stop();
+    healthy->stop();
+    REQUIRE(host.getSimulationCount() == 0);
+}
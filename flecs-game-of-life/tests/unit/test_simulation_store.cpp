@@ -0,0 +1,242 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/simulation_store.h>
+#include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+GameConfig makeConfig(bool wrap) {
+    GameConfig config;
+    config.setWrapEdges(wrap);
+    return config;
+}
+
+void applyUpdate(std::set<Position>& board, const SimulationSession::StreamUpdate& update) {
+    if (update.keyframe) {
+        board.clear();
+    }
+    for (const auto& pos : update.died) {
+        REQUIRE(board.erase(pos) == 1);
+    }
+    for (const auto& pos : update.born) {
+        REQUIRE(board.insert(pos).second);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Simulation Store Creates And Removes Sessions", "[simulation_store]") {
+    const auto directory = std::filesystem::temp_directory_path() / "flecs_gol_store_patterns";
+    std::filesystem::create_directories(directory);
+    {
+        std::ofstream file(directory / "blinker.json");
+        file << R"({"name": "Blinker", "cells": [{"x": 0, "y": 0}, {"x": 1, "y": 0}, {"x": 2, "y": 0}]})";
+    }
+    SimulationStore store(makeConfig(false), directory.string());
+
+    REQUIRE_THROWS_AS(store.create(0, 10), std::invalid_argument);
+    REQUIRE_THROWS_AS(store.create(10, SimulationStore::MAX_GRID_DIMENSION + 1), std::invalid_argument);
+    REQUIRE_THROWS_AS(store.create(10, 10, "missing"), std::invalid_argument);
+    REQUIRE_THROWS_AS(store.create(10, 10, "../blinker"), std::invalid_argument);
+    REQUIRE(store.size() == 0);
+
+    auto empty = store.create(30, 20);
+    auto blinker = store.create(11, 11, "blinker");
+    REQUIRE(store.size() == 2);
+    REQUIRE(empty->getId().size() == 36);
+    REQUIRE(empty->getId() != blinker->getId());
+    REQUIRE(store.find(blinker->getId()) == blinker);
+    REQUIRE(store.find("no-such-id") == nullptr);
+
+    // Named patterns are centred on the grid
+    const auto snapshot = blinker->snapshot();
+    REQUIRE(snapshot.width == 11);
+    REQUIRE(snapshot.cells == std::vector<Position>{{4, 5}, {5, 5}, {6, 5}});
+
+    REQUIRE(store.erase(empty->getId()));
+    REQUIRE_FALSE(store.erase(empty->getId()));
+    REQUIRE(store.size() == 1);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Named Patterns Fall Back To The Embedded Corpus", "[simulation_store]") {
+    SimulationStore store(makeConfig(false), "no-such-pattern-directory");
+
+    // Five cells of the compiled-in glider, with no file read
+    auto glider = store.create(20, 20, "glider");
+    REQUIRE(glider->snapshot().cells.size() == 5);
+    REQUIRE_THROWS_AS(store.create(20, 20, "no-such-pattern"), std::invalid_argument);
+}
+
+TEST_CASE("Sessions Step Several Generations In One Request", "[simulation_store]") {
+    SimulationStore store(makeConfig(false));
+    auto session = store.create(10, 10);
+
+    // Off-grid and duplicate cells are not added
+    const std::vector<Position> blinker{{4, 5}, {5, 5}, {6, 5}, {5, 5}, {-1, 5}, {10, 5}};
+    REQUIRE(session->addPattern(blinker, {0, 0}) == 3);
+    REQUIRE(session->addPattern(blinker, {0, 0}) == 0);
+
+    auto result = session->step(1);
+    REQUIRE(result.generation == 1);
+    REQUIRE(result.liveCells == 3);
+    REQUIRE(result.changedCells == 4);
+
+    // Two steps bring the blinker back, so nothing changed overall
+    result = session->step(2);
+    REQUIRE(result.generation == 3);
+    REQUIRE(result.changedCells == 0);
+
+    result = session->step(3);
+    REQUIRE(result.generation == 6);
+    REQUIRE(result.changedCells == 4);
+
+    // A still life stops the engine early; the generation still advances
+    const std::vector<Position> block{{1, 1}, {1, 2}, {2, 1}, {2, 2}};
+    auto snapshot = session->update(100, std::span<const Position>(block));
+    REQUIRE(snapshot.generation == 100);
+    REQUIRE(snapshot.cells == block);
+    result = session->step(50);
+    REQUIRE(result.generation == 150);
+    REQUIRE(result.liveCells == 4);
+    REQUIRE(result.changedCells == 0);
+
+    snapshot = session->update(std::nullopt, std::span<const Position>());
+    REQUIRE(snapshot.generation == 150);
+    REQUIRE(snapshot.cells.empty());
+}
+
+TEST_CASE("Streams Send Only The Cells That Changed", "[simulation_store]") {
+    SimulationStore store(makeConfig(true));
+    auto session = store.create(16, 16);
+    const std::vector<Position> glider{{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    session->addPattern(glider, {3, 3});
+
+    // The first update is a keyframe with the whole board
+    auto subscription = session->subscribe();
+    std::set<Position> client;
+    auto update = session->takeUpdate(*subscription);
+    REQUIRE(update.keyframe);
+    REQUIRE(update.generation == 0);
+    REQUIRE(update.born.size() == 5);
+    REQUIRE(update.died.empty());
+    applyUpdate(client, update);
+    REQUIRE_FALSE(session->hasUpdate(*subscription));
+
+    for (int tick = 0; tick < 40; ++tick) {
+        session->step(1);
+        REQUIRE(session->hasUpdate(*subscription));
+        update = session->takeUpdate(*subscription);
+        REQUIRE_FALSE(update.keyframe);
+        REQUIRE(update.generation == static_cast<uint32_t>(tick + 1));
+        REQUIRE(update.born.size() + update.died.size() <= 8);
+        REQUIRE_FALSE(update.ended);
+        applyUpdate(client, update);
+        const auto cells = session->snapshot().cells;
+        REQUIRE(std::vector<Position>(client.begin(), client.end()) == cells);
+    }
+
+    // Several steps between reads arrive as one delta
+    session->step(7);
+    auto idle = session->subscribe();
+    session->takeUpdate(*idle);
+    update = session->takeUpdate(*subscription);
+    REQUIRE(update.generation == 47);
+    applyUpdate(client, update);
+    REQUIRE(std::vector<Position>(client.begin(), client.end()) == session->snapshot().cells);
+
+    REQUIRE_FALSE(session->hasUpdate(*idle));
+    update = session->takeUpdate(*idle);
+    REQUIRE(update.born.empty());
+    REQUIRE(update.died.empty());
+
+    // Replacing the board sends a keyframe, and a board that stops changing ends the stream
+    const std::vector<Position> block{{1, 1}, {1, 2}, {2, 1}, {2, 2}};
+    session->update(std::nullopt, std::span<const Position>(block));
+    session->step(1);
+    update = session->takeUpdate(*subscription);
+    REQUIRE(update.keyframe);
+    applyUpdate(client, update);
+    REQUIRE(update.ended);
+    REQUIRE(std::vector<Position>(client.begin(), client.end()) == block);
+}
+
+TEST_CASE("Slow Streams Get A Net Delta Or A Keyframe", "[simulation_store]") {
+    SimulationStore store(makeConfig(true));
+    auto session = store.create(64, 64);
+
+    // Changes that cancel out cost nothing: the blinker is back after two steps
+    const std::vector<Position> blinker{{10, 10}, {11, 10}, {12, 10}};
+    session->addPattern(blinker, {0, 0});
+    auto subscription = session->subscribe();
+    session->takeUpdate(*subscription);
+    session->step(1);
+    session->step(1);
+    auto update = session->takeUpdate(*subscription);
+    REQUIRE(update.generation == 2);
+    REQUIRE(update.born.empty());
+    REQUIRE(update.died.empty());
+
+    // Ten more blinkers outgrow a small limit and that client gets the board
+    // instead; the blocks keep the board larger than the delta
+    std::vector<Position> busy;
+    for (int32_t i = 0; i < 10; ++i) {
+        busy.insert(busy.end(), {{4 + 5 * i, 30}, {5 + 5 * i, 30}, {6 + 5 * i, 30}});
+        busy.insert(busy.end(), {{4 + 5 * i, 40}, {5 + 5 * i, 40}, {4 + 5 * i, 41}, {5 + 5 * i, 41}});
+        busy.insert(busy.end(), {{4 + 5 * i, 50}, {5 + 5 * i, 50}, {4 + 5 * i, 51}, {5 + 5 * i, 51}});
+    }
+    session->addPattern(busy, {0, 0});
+
+    auto limited = session->subscribe(16);
+    auto unlimited = session->subscribe(64 * 64);
+    std::set<Position> limitedClient;
+    std::set<Position> unlimitedClient;
+    applyUpdate(limitedClient, session->takeUpdate(*limited));
+    applyUpdate(unlimitedClient, session->takeUpdate(*unlimited));
+
+    for (int i = 0; i < 21; ++i) {
+        session->step(1);
+    }
+    const auto cells = session->snapshot().cells;
+
+    update = session->takeUpdate(*limited);
+    REQUIRE(update.keyframe);
+    REQUIRE(update.born == cells);
+    applyUpdate(limitedClient, update);
+
+    update = session->takeUpdate(*unlimited);
+    REQUIRE_FALSE(update.keyframe);
+    applyUpdate(unlimitedClient, update);
+    REQUIRE(std::vector<Position>(unlimitedClient.begin(), unlimitedClient.end()) == cells);
+    REQUIRE(std::vector<Position>(limitedClient.begin(), limitedClient.end()) == cells);
+}
+
+TEST_CASE("Simulation Session Stops At The Entity Limit", "[simulation_store]") {
+    GameConfig config = makeConfig(false);
+    config.setMaxEntities(20);
+    SimulationStore store(config, ".");
+    auto session = store.create(200, 200);
+
+    // The R-pentomino grows for over a thousand generations
+    const std::vector<Position> rPentomino{{1, 0}, {2, 0}, {0, 1}, {1, 1}, {1, 2}};
+    session->addPattern(rPentomino, {100, 100});
+
+    // A long request stops at the first check past the limit
+    const auto result = session->step(1000);
+    REQUIRE(result.generation < 1000);
+    REQUIRE(result.liveCells > 20);
+    REQUIRE_THROWS_AS(session->step(1), EntityLimitError);
+    REQUIRE(session->snapshot().generation == result.generation);
+
+    // Shrinking the board lets it step again
+    const std::vector<Position> blinker{{1, 2}, {2, 2}, {3, 2}};
+    session->update(std::nullopt, std::span<const Position>(blinker));
+    REQUIRE(session->step(10).generation == result.generation + 10);
+}
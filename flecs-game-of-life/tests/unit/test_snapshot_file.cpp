@@ -0,0 +1,228 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/snapshot_file.h>
+#include <flecs_gol/simulation_controller.h>
+#include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<Position> readCells(const SnapshotReader& reader) {
+    std::vector<Position> cells;
+    reader.readRuns([&cells](int32_t x, int32_t y, uint32_t length) {
+        for (uint32_t i = 0; i < length; ++i) {
+            cells.emplace_back(x + static_cast<int32_t>(i), y);
+        }
+    });
+    return sorted(cells);
+}
+
+std::vector<char> readBytes(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void writeBytes(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+std::vector<Position> controllerCells(const SimulationController& controller) {
+    std::vector<Position> cells;
+    for (const auto& cell : controller.getAllCells()) {
+        cells.emplace_back(cell.x, cell.y);
+    }
+    return sorted(cells);
+}
+
+} // namespace
+
+TEST_CASE("Snapshot Files Round Trip", "[snapshot_file]") {
+    const std::string path = tempPath("flecs_gol_round_trip.gols");
+
+    // Runs, gaps, negative coordinates and a far-away cell
+    std::vector<Position> cells = {
+        {-3, -2}, {-2, -2}, {-1, -2}, {5, -2},
+        {0, 0},
+        {-100000, 7}, {-99999, 7}, {40, 7}, {41, 7}, {42, 7},
+        {2000000000, -2000000000},
+    };
+    const auto expected = sorted(cells);
+
+    SnapshotInfo info;
+    info.generation = 12345678901ull;
+    info.gridMinX = -50;
+    info.gridMinY = -60;
+    info.gridWidth = 101;
+    info.gridHeight = 121;
+    info.wrapEdges = true;
+
+    std::vector<Position> shuffled(cells.rbegin(), cells.rend());
+    writeSnapshotFile(path, info, shuffled);
+
+    SnapshotReader reader(path);
+    const auto& read = reader.getInfo();
+    REQUIRE(read.generation == info.generation);
+    REQUIRE(read.gridMinX == -50);
+    REQUIRE(read.gridMinY == -60);
+    REQUIRE(read.gridWidth == 101);
+    REQUIRE(read.gridHeight == 121);
+    REQUIRE(read.wrapEdges);
+    REQUIRE(read.cellCount == cells.size());
+    REQUIRE(readCells(reader) == expected);
+
+    // Runs come back whole
+    std::vector<uint32_t> lengths;
+    reader.readRuns([&lengths](int32_t, int32_t, uint32_t length) { lengths.push_back(length); });
+    REQUIRE(lengths == std::vector<uint32_t>{1, 3, 1, 1, 2, 3});
+
+    // An empty board
+    std::vector<Position> none;
+    writeSnapshotFile(path, SnapshotInfo{}, none);
+    SnapshotReader empty(path);
+    REQUIRE(empty.getInfo().cellCount == 0);
+    REQUIRE(readCells(empty).empty());
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Snapshot Files Reject Damaged Input", "[snapshot_file]") {
+    const std::string path = tempPath("flecs_gol_damaged.gols");
+
+    REQUIRE_THROWS_AS(SnapshotReader(tempPath("flecs_gol_missing.gols")), std::runtime_error);
+
+    std::vector<Position> cells = {{0, 0}, {1, 0}, {2, 0}, {0, 4}, {9, 4}};
+    writeSnapshotFile(path, SnapshotInfo{}, cells);
+    const auto bytes = readBytes(path);
+    REQUIRE(bytes.size() > 64);
+
+    SECTION("short header") {
+        writeBytes(path, std::vector<char>(bytes.begin(), bytes.begin() + 40));
+        REQUIRE_THROWS_AS(SnapshotReader(path), std::runtime_error);
+    }
+
+    SECTION("wrong magic") {
+        auto damaged = bytes;
+        damaged[0] = 'X';
+        writeBytes(path, damaged);
+        REQUIRE_THROWS_AS(SnapshotReader(path), std::runtime_error);
+    }
+
+    SECTION("unknown version") {
+        auto damaged = bytes;
+        damaged[4] = 99;
+        writeBytes(path, damaged);
+        REQUIRE_THROWS_AS(SnapshotReader(path), std::runtime_error);
+    }
+
+    SECTION("truncated payload") {
+        writeBytes(path, std::vector<char>(bytes.begin(), bytes.end() - 1));
+        REQUIRE_THROWS_AS(SnapshotReader(path), std::runtime_error);
+    }
+
+    SECTION("cell count disagrees with the payload") {
+        auto damaged = bytes;
+        damaged[48] = 6;
+        writeBytes(path, damaged);
+        SnapshotReader reader(path);
+        REQUIRE_THROWS_AS(readCells(reader), std::runtime_error);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Controller Snapshots Load Into Any Engine", "[snapshot_file]") {
+    const std::string path = tempPath("flecs_gol_controller.gols");
+
+    GameConfig config;
+    config.setGridBoundaries(-30, 30, -20, 20);
+    config.setWrapEdges(true);
+    config.setEngineType(EngineType::Sparse);
+    SimulationController source(config);
+
+    // Glider and blinker
+    for (const auto& pos : {Position(1, 0), Position(2, 1), Position(0, 2), Position(1, 2), Position(2, 2),
+                            Position(-10, -5), Position(-9, -5), Position(-8, -5)}) {
+        source.addCell(pos.x, pos.y);
+    }
+    for (int i = 0; i < 7; ++i) {
+        source.step();
+    }
+    source.saveSnapshot(path);
+    const auto saved = controllerCells(source);
+
+    const EngineType engines[] = {EngineType::Sparse, EngineType::Dense, EngineType::Tiled, EngineType::HashLife};
+    for (EngineType engine : engines) {
+        INFO("engine " << engineTypeToString(engine));
+        GameConfig other;
+        other.setEngineType(engine);
+        SimulationController target(other);
+        target.loadSnapshot(path);
+
+        REQUIRE(target.getConfig().getEngineType() == engine);
+        REQUIRE(target.getConfig().getGridMinX() == -30);
+        REQUIRE(target.getConfig().getGridMaxX() == 30);
+        REQUIRE(target.getConfig().getGridMinY() == -20);
+        REQUIRE(target.getConfig().getGridMaxY() == 20);
+        REQUIRE(target.getConfig().getWrapEdges());
+        REQUIRE(target.getState().generation == 7);
+        REQUIRE(controllerCells(target) == saved);
+
+        // The loaded board is the reset state
+        target.step();
+        REQUIRE(target.getState().generation == 8);
+        target.reset();
+        REQUIRE(controllerCells(target) == saved);
+    }
+
+    // A damaged file leaves the controller untouched
+    writeBytes(path, std::vector<char>(8, 'X'));
+    REQUIRE_THROWS_AS(source.loadSnapshot(path), std::runtime_error);
+    REQUIRE(controllerCells(source) == saved);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Synced Snapshot Files Replace The Old One Whole", "[snapshot_file]") {
+    const std::string path = tempPath("flecs_gol_synced.gols");
+    std::vector<Position> first = {Position(0, 0), Position(1, 0)};
+    std::vector<Position> second = {Position(5, -3), Position(6, -3), Position(-2, 4)};
+    SnapshotInfo info;
+    info.gridWidth = 16;
+    info.gridHeight = 16;
+
+    // Byte for byte the file writeSnapshotFile makes, with nothing left beside it
+    writeSnapshotFile(path, info, first);
+    const auto plain = readBytes(path);
+    writeSnapshotFileSynced(path, info, first);
+    REQUIRE(readBytes(path) == plain);
+    REQUIRE_FALSE(std::filesystem::exists(path + ".partial"));
+
+    info.generation = 9;
+    writeSnapshotFileSynced(path, info, second);
+    SnapshotReader reader(path);
+    REQUIRE(reader.getInfo().generation == 9);
+    REQUIRE(readCells(reader) == sorted(second));
+
+    // A directory that does not exist fails before the old file is touched
+    REQUIRE_THROWS_AS(writeSnapshotFileSynced(tempPath("flecs_gol_missing_dir/board.gols"), info, second),
+                      std::runtime_error);
+
+    std::filesystem::remove(path);
+}
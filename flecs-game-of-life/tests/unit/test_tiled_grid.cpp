@@ -0,0 +1,535 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/game_of_life_simulation.h>
+#include <flecs_gol/tiled_grid.h>
+#include <flecs_gol/work_stealing_pool.h>
+#include <flecs_gol/game_config.h>
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+using namespace flecs_gol;
+
+namespace {
+
+GameConfig makeConfig(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY, bool wrap, EngineType engine,
+                      uint32_t threads = 4) {
+    GameConfig config;
+    config.setGridBoundaries(minX, maxX, minY, maxY);
+    config.setWrapEdges(wrap);
+    config.setEngineType(engine);
+    config.setWorkerThreads(threads);
+    return config;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+void seedRandom(GameOfLifeSimulation& sim, const GameConfig& config, double density, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution alive(density);
+    for (int32_t y = config.getGridMinY(); y <= config.getGridMaxY(); ++y) {
+        for (int32_t x = config.getGridMinX(); x <= config.getGridMaxX(); ++x) {
+            if (alive(rng)) {
+                sim.createCell(x, y);
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Work Stealing Pool", "[tiled][pool]") {
+    SECTION("Every index runs exactly once") {
+        WorkStealingPool pool(4);
+        REQUIRE(pool.getThreadCount() == 4);
+
+        std::vector<std::atomic<int>> hits(1000);
+        for (int batch = 0; batch < 20; ++batch) {
+            pool.parallelFor(hits.size(), [&](size_t i) { hits[i].fetch_add(1); });
+        }
+
+        REQUIRE(std::all_of(hits.begin(), hits.end(), [](const std::atomic<int>& h) { return h.load() == 20; }));
+    }
+
+    SECTION("Idle workers steal from a busy queue") {
+        WorkStealingPool pool(4);
+
+        // Index 0 blocks worker 0 until the others have drained everything else
+        std::atomic<size_t> done{0};
+        pool.parallelFor(64, [&](size_t i) {
+            if (i == 0) {
+                while (done.load() < 63) {
+                    std::this_thread::yield();
+                }
+            }
+            done.fetch_add(1);
+        });
+
+        REQUIRE(done.load() == 64);
+        REQUIRE(pool.getStealCount() > 0);
+    }
+
+    SECTION("Workers steal within their node first") {
+        // Two nodes of two workers; every worker may run on CPU 0
+        WorkerPlacement placement;
+        placement.topology = NumaTopology({NumaNode{0, {0}}, NumaNode{1, {0}}});
+        WorkStealingPool pool(4, placement);
+        REQUIRE(pool.getWorkerNode(1) == 0);
+        REQUIRE(pool.getWorkerNode(2) == 1);
+        REQUIRE(pool.getOwner(7, 16) == 1);
+
+        std::vector<std::thread::id> threads(4);
+        pool.forEachWorker([&](size_t worker) { threads[worker] = std::this_thread::get_id(); });
+        REQUIRE(threads[0] == std::this_thread::get_id());
+        REQUIRE(std::set<std::thread::id>(threads.begin(), threads.end()).size() == 4);
+        REQUIRE(pool.getStealCount() == 0);
+
+        // Indices 0-9 start on worker 0 and 10-19 on worker 3, whose first
+        // indices hold them up, so workers 1 and 2 have to steal. Each thief's
+        // first index waits for the other's, so neither can empty both queues.
+        std::atomic<int> done{0};
+        std::atomic<int> thieves{0};
+        std::vector<size_t> firstStolen(4, 0);
+        pool.parallelFor(
+            20,
+            [&](size_t i) {
+                if (i == 0 || i == 10) {
+                    while (done.load() < 18) {
+                        std::this_thread::yield();
+                    }
+                    return;
+                }
+                const auto worker = static_cast<size_t>(
+                    std::find(threads.begin(), threads.end(), std::this_thread::get_id()) - threads.begin());
+                if ((worker == 1 || worker == 2) && firstStolen[worker] == 0) {
+                    firstStolen[worker] = i;
+                    thieves.fetch_add(1);
+                    while (thieves.load() < 2) {
+                        std::this_thread::yield();
+                    }
+                }
+                done.fetch_add(1);
+            },
+            [](size_t i) { return i < 10 ? 0u : 3u; });
+
+        REQUIRE(done.load() == 18);
+        REQUIRE(firstStolen[1] < 10);  // From worker 0, on node 0
+        REQUIRE(firstStolen[2] >= 10); // From worker 3, on node 1
+        REQUIRE(pool.getRemoteStealCount() <= pool.getStealCount());
+    }
+
+    SECTION("Submitted tasks run without the caller waiting") {
+        std::atomic<bool> release{false};
+        std::atomic<int> finished{0};
+        {
+            WorkStealingPool pool(3);
+            pool.submit([&] {
+                while (!release.load()) {
+                    std::this_thread::yield();
+                }
+                finished.fetch_add(1);
+            });
+            // The blocked task holds one worker; the other still takes submissions
+            std::atomic<bool> ran{false};
+            pool.submit([&] { ran = true; });
+            while (!ran.load()) {
+                std::this_thread::yield();
+            }
+            REQUIRE(finished.load() == 0);
+
+            // Batches still complete, with the caller taking the busy worker's share
+            std::atomic<int> hits{0};
+            pool.parallelFor(32, [&](size_t) { hits.fetch_add(1); });
+            REQUIRE(hits.load() == 32);
+
+            pool.submit([&] { finished.fetch_add(1); });
+            release = true;
+        }
+        REQUIRE(finished.load() == 2);  // The destructor ran whatever was still queued
+
+        // A one-thread pool starts a worker for them rather than running them
+        // here, and a task that throws leaves that worker serving the rest
+        WorkStealingPool single(1);
+        std::atomic<bool> ran{false};
+        std::thread::id ranOn;
+        single.submit([] { throw std::runtime_error("submitted task failed"); });
+        single.submit([&] {
+            ranOn = std::this_thread::get_id();
+            ran = true;
+        });
+        while (!ran.load()) {
+            std::this_thread::yield();
+        }
+        REQUIRE(ranOn != std::this_thread::get_id());
+        REQUIRE(single.getThreadCount() == 1);
+    }
+
+    SECTION("Zero threads means one per hardware thread") {
+        WorkStealingPool pool(0);
+        REQUIRE(pool.getThreadCount() >= 1);
+    }
+}
+
+TEST_CASE("Tiled Grid Layout", "[tiled]") {
+    auto config = makeConfig(-100, 99, -10, 69, false, EngineType::Tiled, 3);
+    TiledGrid grid(config);
+
+    REQUIRE(grid.getTilesX() == 4); // 200 columns
+    REQUIRE(grid.getTilesY() == 2); // 80 rows
+    REQUIRE(grid.getThreadCount() == 3);
+
+    SECTION("Cells outside the boundaries are rejected") {
+        REQUIRE(grid.setCell(-100, -10, true));
+        REQUIRE(grid.setCell(99, 69, true));
+        REQUIRE_FALSE(grid.setCell(100, 0, true));
+        REQUIRE_FALSE(grid.setCell(0, 70, true));
+        REQUIRE(grid.getCellCount() == 2);
+    }
+
+    SECTION("Only tiles that changed are flagged") {
+        // Blinker inside tile (1, 0), block inside tile (3, 1)
+        grid.setCell(-30, 0, true);
+        grid.setCell(-29, 0, true);
+        grid.setCell(-28, 0, true);
+        grid.setCell(90, 60, true);
+        grid.setCell(91, 60, true);
+        grid.setCell(90, 61, true);
+        grid.setCell(91, 61, true);
+
+        grid.step();
+        REQUIRE(grid.tileChanged(1, 0));
+        REQUIRE_FALSE(grid.tileChanged(3, 1));
+        REQUIRE_FALSE(grid.tileChanged(0, 0));
+        REQUIRE(grid.getCellCount() == 7);
+    }
+}
+
+TEST_CASE("Tiled Grid Matches Dense Grid", "[tiled][equivalence]") {
+    struct Scenario {
+        int32_t minX, maxX, minY, maxY;
+        bool wrap;
+    };
+
+    const std::vector<Scenario> scenarios = {
+        {-100, 100, -100, 100, false}, // Partial tiles on both axes
+        {-100, 100, -100, 100, true},
+        {0, 127, 0, 127, true},        // Exactly two tiles per axis
+        {0, 69, 0, 9, true},           // Smaller than one tile vertically
+        {0, 191, -40, 40, false},
+    };
+
+    for (const auto& scenario : scenarios) {
+        for (uint32_t threads : {1u, 2u, 5u}) {
+            auto denseConfig = makeConfig(scenario.minX, scenario.maxX, scenario.minY, scenario.maxY,
+                                          scenario.wrap, EngineType::Dense);
+            auto tiledConfig = makeConfig(scenario.minX, scenario.maxX, scenario.minY, scenario.maxY,
+                                          scenario.wrap, EngineType::Tiled, threads);
+
+            GameOfLifeSimulation dense(denseConfig);
+            GameOfLifeSimulation tiled(tiledConfig);
+            seedRandom(dense, denseConfig, 0.35, 11);
+            seedRandom(tiled, tiledConfig, 0.35, 11);
+
+            for (int generation = 0; generation < 20; ++generation) {
+                dense.step();
+                tiled.step();
+                REQUIRE(tiled.getCellCount() == dense.getCellCount());
+                REQUIRE(sorted(tiled.getLivePositions()) == sorted(dense.getLivePositions()));
+            }
+
+            REQUIRE(sorted(tiled.getPositionsInRegion(0, 30, -5, 5)) ==
+                    sorted(dense.getPositionsInRegion(0, 30, -5, 5)));
+        }
+    }
+}
+
+TEST_CASE("Tiled Grid Steps The Same With NUMA Placement", "[tiled][numa]") {
+    // Whatever nodes this host has, placed and pinned workers must not change the result
+    auto plainConfig = makeConfig(-150, 149, -160, 169, true, EngineType::Tiled, 1);
+    auto placedConfig = makeConfig(-150, 149, -160, 169, true, EngineType::Tiled, 5);
+    placedConfig.setNumaPlacement(true);
+    placedConfig.setPinWorkerThreads(true);
+
+    for (uint32_t nodeLimit : {0u, 1u}) {
+        placedConfig.setNumaNodeLimit(nodeLimit);
+        TiledGrid placed(placedConfig);
+        TiledGrid plain(plainConfig);
+        REQUIRE(placed.getNodeCount() >= 1);
+        REQUIRE((nodeLimit == 0 || placed.getNodeCount() == 1));
+
+        std::mt19937 rng(5);
+        std::bernoulli_distribution alive(0.3);
+        for (int32_t y = -160; y <= 169; ++y) {
+            for (int32_t x = -150; x <= 149; ++x) {
+                if (alive(rng)) {
+                    placed.setCell(x, y, true);
+                    plain.setCell(x, y, true);
+                }
+            }
+        }
+
+        for (uint32_t generations : {1u, 3u, 1u, 20u}) {
+            placed.step(generations);
+            plain.step(generations);
+            std::vector<Position> placedCells;
+            std::vector<Position> plainCells;
+            placed.collectLiveCells(placedCells);
+            plain.collectLiveCells(plainCells);
+            REQUIRE(sorted(placedCells) == sorted(plainCells));
+        }
+    }
+}
+
+TEST_CASE("Tiled Grid Skips Stable Tiles", "[tiled][active]") {
+    // 8x8 tiles; a block and a blinker far apart, a glider crossing the wrapped seams
+    auto denseConfig = makeConfig(0, 511, 0, 511, true, EngineType::Dense);
+    auto tiledConfig = makeConfig(0, 511, 0, 511, true, EngineType::Tiled, 2);
+    GameOfLifeSimulation dense(denseConfig);
+    GameOfLifeSimulation tiled(tiledConfig);
+
+    const std::vector<Position> cells = {
+        {300, 300}, {301, 300}, {300, 301}, {301, 301},    // Block
+        {100, 400}, {101, 400}, {102, 400},                // Blinker
+        {501, 500}, {502, 501}, {500, 502}, {501, 502}, {502, 502}, // Glider heading down-right
+    };
+    for (const auto& cell : cells) {
+        dense.createCell(cell.x, cell.y);
+        tiled.createCell(cell.x, cell.y);
+    }
+
+    TiledGrid grid(tiledConfig);
+    for (const auto& cell : cells) {
+        grid.setCell(cell.x, cell.y, true);
+    }
+
+    SECTION("Results match the dense grid while tiles wake and sleep") {
+        for (int generation = 0; generation < 200; ++generation) {
+            dense.step();
+            tiled.step();
+            REQUIRE(sorted(tiled.getLivePositions()) == sorted(dense.getLivePositions()));
+        }
+    }
+
+    SECTION("Only tiles around activity are stepped") {
+        grid.step(); // Every tile with an edit wakes its neighborhood once
+        grid.step();
+
+        // The block settles, leaving the blinker's and the glider's neighborhoods
+        REQUIRE(grid.getActiveTileCount() < 30);
+        REQUIRE_FALSE(grid.tileChanged(4, 4));
+        REQUIRE(grid.tileChanged(1, 6));
+    }
+
+    SECTION("Active bounds cover the tiles that changed") {
+        grid.clear();
+        grid.setCell(10, 10, true);
+        grid.setCell(11, 10, true);
+        grid.setCell(12, 10, true);
+        grid.step();
+
+        int32_t minX = 0, maxX = 0, minY = 0, maxY = 0;
+        REQUIRE(grid.getActiveBounds(minX, maxX, minY, maxY));
+        REQUIRE(minX == 0);
+        REQUIRE(maxX == 63);
+        REQUIRE(minY == 0);
+        REQUIRE(maxY == 63);
+
+        grid.clear();
+        grid.step();
+        REQUIRE_FALSE(grid.getActiveBounds(minX, maxX, minY, maxY));
+        REQUIRE(grid.getActiveTileCount() == 0);
+    }
+}
+
+TEST_CASE("Grid State Tracks The Active Area", "[tiled][active]") {
+    auto config = makeConfig(-50, 50, -50, 50, false, EngineType::Sparse);
+    GameOfLifeSimulation sim(config);
+
+    // Horizontal blinker: flips to vertical, so (9, -1), (9, 1) are born and (8, 0), (10, 0) die
+    sim.createCell(8, 0);
+    sim.createCell(9, 0);
+    sim.createCell(10, 0);
+    sim.step();
+
+    GridState state = sim.getGridState();
+    REQUIRE(state.hasActiveArea);
+    REQUIRE(state.minX == 8);
+    REQUIRE(state.maxX == 10);
+    REQUIRE(state.minY == -1);
+    REQUIRE(state.maxY == 1);
+
+    // A block alone never changes
+    sim.clear();
+    sim.createCell(0, 0);
+    sim.createCell(1, 0);
+    sim.createCell(0, 1);
+    sim.createCell(1, 1);
+    sim.step();
+    REQUIRE_FALSE(sim.getGridState().hasActiveArea);
+}
+
+TEST_CASE("Step Changes Match The Population Diff", "[tiled][changes]") {
+    auto config = makeConfig(-40, 87, -30, 69, true, EngineType::Sparse);
+
+    for (EngineType engine : {EngineType::Sparse, EngineType::Dense, EngineType::Tiled, EngineType::HashLife}) {
+        INFO("engine " << static_cast<int>(engine));
+        config.setEngineType(engine);
+        GameOfLifeSimulation sim(config);
+        seedRandom(sim, config, 0.3, 11);
+
+        for (int generation = 0; generation < 20; ++generation) {
+            auto before = sorted(sim.getLivePositions());
+            sim.step();
+            auto after = sorted(sim.getLivePositions());
+
+            std::vector<Position> born;
+            std::vector<Position> died;
+            std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(born));
+            std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(died));
+
+            REQUIRE(sorted(sim.getBornCells()) == born);
+            REQUIRE(sorted(sim.getDiedCells()) == died);
+        }
+    }
+
+    // A still life reports nothing
+    config.setEngineType(EngineType::Sparse);
+    GameOfLifeSimulation sim(config);
+    sim.createCell(0, 0);
+    sim.createCell(1, 0);
+    sim.createCell(0, 1);
+    sim.createCell(1, 1);
+    sim.step();
+    REQUIRE(sim.getBornCells().empty());
+    REQUIRE(sim.getDiedCells().empty());
+}
+
+TEST_CASE("Tiled Grid Multi-Generation Steps Match Single Steps", "[tiled][blocking]") {
+    struct Scenario {
+        int32_t minX;
+        int32_t maxX;
+        int32_t minY;
+        int32_t maxY;
+        bool wrap;
+    };
+
+    // Word-aligned and ragged widths; the ragged wrapped grid takes the single-step path
+    const std::vector<Scenario> scenarios{
+        {-64, 63, -50, 49, true}, {0, 199, 0, 149, false}, {0, 129, 0, 69, true}, {0, 63, 0, 19, true},
+        {-48, 48, 0, 2, false}};
+
+    for (const auto& scenario : scenarios) {
+        for (const auto& rule : {CONWAY_RULE, HIGHLIFE_RULE}) {
+            for (uint32_t generations : {2u, 8u, 21u}) {
+                INFO("grid " << scenario.minX << ".." << scenario.maxX << " x " << scenario.minY << ".."
+                             << scenario.maxY << " wrap " << scenario.wrap << " rule " << rule.toString()
+                             << " generations " << generations);
+                auto config = makeConfig(scenario.minX, scenario.maxX, scenario.minY, scenario.maxY, scenario.wrap,
+                                         EngineType::Tiled, 3);
+                config.setRule(rule);
+                TiledGrid blocked(config);
+                TiledGrid single(config);
+
+                std::mt19937 rng(7);
+                std::bernoulli_distribution alive(0.35);
+                for (int32_t y = scenario.minY; y <= scenario.maxY; ++y) {
+                    for (int32_t x = scenario.minX; x <= scenario.maxX; ++x) {
+                        const bool cell = alive(rng);
+                        blocked.setCell(x, y, cell);
+                        single.setCell(x, y, cell);
+                    }
+                }
+
+                // Single steps in between rely on the tiles a block left dirty
+                for (int round = 0; round < 3; ++round) {
+                    std::vector<Position> before;
+                    single.collectLiveCells(before);
+                    before = sorted(before);
+                    for (uint32_t i = 0; i < generations; ++i) {
+                        single.step();
+                    }
+                    std::vector<Position> after;
+                    single.collectLiveCells(after);
+                    after = sorted(after);
+
+                    blocked.step(generations);
+                    std::vector<Position> cells;
+                    blocked.collectLiveCells(cells);
+                    REQUIRE(sorted(cells) == after);
+                    REQUIRE(blocked.getCellCount() == single.getCellCount());
+
+                    // Changes run from the board before the call to the one after it
+                    std::vector<Position> born;
+                    std::vector<Position> died;
+                    blocked.collectChanges(born, died);
+                    std::vector<Position> expectedBorn;
+                    std::vector<Position> expectedDied;
+                    std::set_difference(after.begin(), after.end(), before.begin(), before.end(),
+                                        std::back_inserter(expectedBorn));
+                    std::set_difference(before.begin(), before.end(), after.begin(), after.end(),
+                                        std::back_inserter(expectedDied));
+                    REQUIRE(sorted(born) == expectedBorn);
+                    REQUIRE(sorted(died) == expectedDied);
+
+                    single.step();
+                    blocked.step();
+                    std::vector<Position> singleCells;
+                    single.collectLiveCells(singleCells);
+                    cells.clear();
+                    blocked.collectLiveCells(cells);
+                    REQUIRE(sorted(cells) == sorted(singleCells));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Tiled Engine Advances In Blocks", "[tiled][blocking]") {
+    auto tiledConfig = makeConfig(0, 511, 0, 511, true, EngineType::Tiled, 2);
+    auto denseConfig = makeConfig(0, 511, 0, 511, true, EngineType::Dense);
+    GameOfLifeSimulation tiled(tiledConfig);
+    GameOfLifeSimulation dense(denseConfig);
+
+    SECTION("Sleeping tiles wake for activity that reaches them") {
+        // A glider crossing the wrapped seams next to a block and a blinker
+        const std::vector<Position> cells = {
+            {300, 300}, {301, 300}, {300, 301}, {301, 301},
+            {100, 400}, {101, 400}, {102, 400},
+            {501, 500}, {502, 501}, {500, 502}, {501, 502}, {502, 502},
+        };
+        for (const auto& cell : cells) {
+            tiled.createCell(cell.x, cell.y);
+            dense.createCell(cell.x, cell.y);
+        }
+        for (int call = 0; call < 20; ++call) {
+            REQUIRE(tiled.advance(13) == dense.advance(13));
+            REQUIRE(tiled.getGeneration() == dense.getGeneration());
+            REQUIRE(sorted(tiled.getLivePositions()) == sorted(dense.getLivePositions()));
+        }
+    }
+
+    SECTION("An oscillator skips the remaining blocks in phase") {
+        // Odd step count: a blinker ends turned
+        for (const auto& cell : std::vector<Position>{{10, 10}, {11, 10}, {12, 10}}) {
+            tiled.createCell(cell.x, cell.y);
+        }
+        REQUIRE(tiled.advance(1001) == 1001);
+        REQUIRE(tiled.getGeneration() == 1001);
+        REQUIRE(sorted(tiled.getLivePositions()) == sorted({{11, 9}, {11, 10}, {11, 11}}));
+    }
+
+    SECTION("A still life stops one step in") {
+        for (const auto& cell : std::vector<Position>{{10, 10}, {11, 10}, {10, 11}, {11, 11}}) {
+            tiled.createCell(cell.x, cell.y);
+        }
+        REQUIRE(tiled.advance(20) == 1);
+        REQUIRE(tiled.getGeneration() == 1);
+        REQUIRE(tiled.getCellCount() == 4);
+    }
+}
@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/life_engine.h>
+#include <flecs_gol/topology.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+template <typename Topology>
+std::vector<Position> neighborsOf(const Topology& topology, Position pos) {
+    std::vector<Position> out;
+    forEachNeighbor(topology, pos, [&](Position neighbor) { out.push_back(neighbor); });
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+std::vector<Position> sorted(std::vector<Position> cells) {
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+} // namespace
+
+TEST_CASE("Topologies Visit The Neighbors The Grid Edges Allow", "[topology]") {
+    const BoundedTopology bounded{0, 9, 0, 7};
+    const TorusTopology torus{0, 9, 0, 7};
+
+    // Interior cells take the same eight offsets either way
+    const std::vector<Position> interior = {{4, 3}, {4, 5}, {5, 3}, {5, 5}, {6, 3}, {6, 4}, {6, 5}, {4, 4}};
+    REQUIRE(neighborsOf(bounded, {5, 4}) == sorted(interior));
+    REQUIRE(neighborsOf(torus, {5, 4}) == sorted(interior));
+
+    REQUIRE(neighborsOf(bounded, {0, 0}) == std::vector<Position>{{0, 1}, {1, 0}, {1, 1}});
+    REQUIRE(neighborsOf(torus, {0, 0}) ==
+            sorted({{9, 7}, {9, 0}, {9, 1}, {0, 7}, {0, 1}, {1, 7}, {1, 0}, {1, 1}}));
+    REQUIRE(neighborsOf(bounded, {9, 4}).size() == 5);
+    REQUIRE(neighborsOf(torus, {9, 4}).front() == Position(0, 3));
+
+    // A one-cell torus is its own neighbor eight times, as with modulo wrapping
+    REQUIRE(neighborsOf(TorusTopology{0, 0, 0, 0}, {0, 0}) == std::vector<Position>(8, Position(0, 0)));
+}
+
+TEST_CASE("Sparse Steps Agree With The Dense Grid On Every Topology", "[topology]") {
+    std::mt19937 rng(11);
+    // Tiny boards have no interior at all; larger ones mix both paths
+    for (const auto& [width, height] : {std::pair{1, 1}, {2, 3}, {3, 3}, {17, 9}, {64, 40}}) {
+        std::vector<Position> cells;
+        for (int32_t y = 0; y < height; ++y) {
+            for (int32_t x = 0; x < width; ++x) {
+                if (rng() % 3 == 0) {
+                    cells.emplace_back(x, y);
+                }
+            }
+        }
+
+        for (bool wrap : {false, true}) {
+            GameConfig config;
+            config.setGridBoundaries(0, width - 1, 0, height - 1);
+            config.setWrapEdges(wrap);
+
+            config.setEngineType(EngineType::Dense);
+            auto reference = createLifeEngine(config);
+            reference->createCells(cells);
+            config.setEngineType(EngineType::Sparse);
+            auto sparse = createLifeEngine(config);
+            sparse->createCells(cells);
+
+            for (int generation = 0; generation < 12; ++generation) {
+                INFO(width << "x" << height << " wrap " << wrap);
+                reference->step();
+                sparse->step();
+                REQUIRE(sorted(sparse->getLivePositions()) == sorted(reference->getLivePositions()));
+            }
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include <flecs_gol/trace.h>
+#include <flecs_gol/simulation_controller.h>
+#include <flecs_gol/game_config.h>
+#include <nlohmann/json.hpp>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace flecs_gol;
+
+namespace {
+
+nlohmann::json dump() {
+    std::ostringstream out;
+    Trace::writeChromeTrace(out);
+    return nlohmann::json::parse(out.str());
+}
+
+// Complete events per span name
+std::map<std::string, int> spanCounts(const nlohmann::json& trace) {
+    std::map<std::string, int> counts;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "X") {
+            ++counts[event["name"].get<std::string>()];
+        }
+    }
+    return counts;
+}
+
+} // namespace
+
+TEST_CASE("Trace Records Scopes Only While Enabled", "[trace]") {
+    Trace::clear();
+    Trace::setEnabled(false);
+    { TraceScope scope("trace test idle"); }
+
+    Trace::setEnabled(true);
+    {
+        TraceScope outer("trace test outer");
+        TraceScope inner("trace test \"inner\"");
+    }
+    Trace::setEnabled(false);
+
+    const auto trace = dump();
+    auto counts = spanCounts(trace);
+    REQUIRE(counts.count("trace test idle") == 0);
+    REQUIRE(counts["trace test outer"] == 1);
+    REQUIRE(counts["trace test \"inner\""] == 1);
+
+    // The inner span nests inside the outer one on the same thread
+    const nlohmann::json* outer = nullptr;
+    const nlohmann::json* inner = nullptr;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["name"] == "trace test outer") {
+            outer = &event;
+        } else if (event["name"] == "trace test \"inner\"") {
+            inner = &event;
+        }
+    }
+    REQUIRE(outer != nullptr);
+    REQUIRE(inner != nullptr);
+    REQUIRE((*inner)["tid"] == (*outer)["tid"]);
+    REQUIRE((*inner)["ts"].get<double>() >= (*outer)["ts"].get<double>());
+    REQUIRE((*inner)["ts"].get<double>() + (*inner)["dur"].get<double>() <=
+            (*outer)["ts"].get<double>() + (*outer)["dur"].get<double>());
+
+    Trace::clear();
+    REQUIRE(spanCounts(dump()).empty());
+}
+
+TEST_CASE("Trace Keeps Each Thread's Spans Apart", "[trace]") {
+    Trace::clear();
+    Trace::setEnabled(true);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t] {
+            Trace::setThreadName("trace test thread " + std::to_string(t));
+            for (int i = 0; i < 100; ++i) {
+                TraceScope scope("trace test work");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Trace::setEnabled(false);
+
+    // Spans of exited threads stay until the next clear()
+    const auto trace = dump();
+    REQUIRE(spanCounts(trace)["trace test work"] == 400);
+    std::map<std::string, int> perThread;
+    std::map<int, std::string> names;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "M") {
+            names[event["tid"].get<int>()] = event["args"]["name"].get<std::string>();
+        }
+    }
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "X") {
+            ++perThread[names[event["tid"].get<int>()]];
+        }
+    }
+    for (int t = 0; t < 4; ++t) {
+        REQUIRE(perThread["trace test thread " + std::to_string(t)] == 100);
+    }
+
+    Trace::clear();
+    REQUIRE(spanCounts(dump()).empty());
+}
+
+TEST_CASE("Trace Ring Buffers Keep The Newest Spans", "[trace]") {
+    Trace::clear();
+    Trace::setEnabled(true);
+    for (size_t i = 0; i < Trace::EVENTS_PER_THREAD; ++i) {
+        Trace::record("trace test old", i, i + 1);
+    }
+    for (size_t i = 0; i < 10; ++i) {
+        Trace::record("trace test new", i, i + 1);
+    }
+    Trace::setEnabled(false);
+
+    auto counts = spanCounts(dump());
+    REQUIRE(counts["trace test new"] == 10);
+    REQUIRE(counts["trace test old"] == static_cast<int>(Trace::EVENTS_PER_THREAD) - 10);
+    Trace::clear();
+}
+
+TEST_CASE("Profiling Config Enables Tracing", "[trace]") {
+    Trace::setEnabled(false);
+    GameConfig config;
+    SimulationController plain(config);
+    REQUIRE_FALSE(Trace::isEnabled());
+
+    config.setEnableProfiling(true);
+    SimulationController profiled(config);
+    REQUIRE(Trace::isEnabled());
+    Trace::setEnabled(false);
+}
@@ -358,6 +358,8 @@ impl game_of_life_service_server::GameOfLifeService for GameOfLifeServiceImpl {
                     live_cells,
                     changed_cells,
                     simulation_ended: live_cells == 0,
+                    keyframe: true,
+                    packed_cells: Vec::new(),
                 });
                 
                 if live_cells == 0 {
@@ -14,7 +14,7 @@ use game_of_life::{
     GetSimulationRequest, UpdateSimulationRequest, DeleteSimulationRequest, DeleteResponse,
     StepSimulationRequest, StepResponse,
     LoadPatternRequest, LoadPatternResponse,
-    StreamRequest, SimulationUpdate,
+    StreamRequest, SimulationUpdate, CellEncoding,
     Cell, Position, Pattern, GridInfo,
 };
 
@@ -146,6 +146,7 @@ impl GameOfLifeClient {
             id,
             auto_step,
             step_interval_ms,
+            cell_encoding: CellEncoding::Cells as i32,
         });
         
         let response = client.stream_simulation(request).await?;